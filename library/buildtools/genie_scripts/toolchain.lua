@@ -682,7 +682,7 @@ function toolchain(_buildDir, _libDir)
 
 	configuration { "linux-gcc* or linux-clang*" }
 		buildoptions {
-			"-msse2",
+			"-msse4.1", -- baseline of the simd backend. avx2 kernels are selected at runtime.
 			"-Wunused-value",
 			"-Wundef",
 		}
@@ -49,6 +49,8 @@ use_vulkan	= false;
 
 use_sdl		= false;
 
+use_engine_allocator	= false;
+
 if _ACTION == "vs2010" or _ACTION == "vs2012" or _ACTION == "vs2013" or _ACTION == "vs2015" then
 	module:set_define( "WIN_NT" );
 	module:set_define( "WIN32" );
@@ -109,6 +111,7 @@ module:set_define( "TIKI_BUILD_32BIT", "TIKI_OFF", nil, "x64" );
 module:set_define( "TIKI_BUILD_64BIT", "TIKI_ON", nil, "x64" );
 
 module:set_define( "TIKI_SDL", iff( use_sdl, "TIKI_ON", "TIKI_OFF" ) );
+module:set_define( "TIKI_USE_ENGINE_ALLOCATOR", iff( use_engine_allocator, "TIKI_ON", "TIKI_OFF" ) );
 
 module:set_define( "TIKI_BUILD_MSVC", iff( use_msvc, "TIKI_ON", "TIKI_OFF" ) );
 module:set_define( "TIKI_BUILD_GCC", iff( use_gcc, "TIKI_ON", "TIKI_OFF" ) );
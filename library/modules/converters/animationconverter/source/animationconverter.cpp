@@ -13,7 +13,7 @@
 
 namespace tiki
 {
-	static const crc32 s_typeCrc = crcString( "animation" );
+	static const crc32 s_typeCrc = crcLiteral( "animation" );
 
 	AnimationConverter::AnimationConverter()
 	{
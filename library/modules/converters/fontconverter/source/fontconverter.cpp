@@ -20,7 +20,7 @@
 
 namespace tiki
 {
-	static const crc32 s_typeCrc = crcString( "font" );
+	static const crc32 s_typeCrc = crcLiteral( "font" );
 
 	uint32 FontConverter::getConverterRevision( crc32 typeCrc ) const
 	{
@@ -171,6 +171,7 @@ namespace tiki
 			writerParameters.targetFormat	= PixelFormat_R8;
 			writerParameters.targetType		= (mode3D ? TextureType_3d : TextureType_2d );
 			writerParameters.mipMapCount	= 1u;
+			writerParameters.pTaskSystem	= getTaskSystem();
 			writerParameters.data.texture3d.sliceWidth	= fontSize;
 			writerParameters.data.texture3d.sliceHeight	= imageHeight;
 
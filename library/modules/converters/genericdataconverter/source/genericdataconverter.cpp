@@ -11,6 +11,8 @@
 
 namespace tiki
 {
+	static const crc32 s_typeCrc = crcLiteral( "genericdata" );
+
 	GenericDataConverter::GenericDataConverter()
 	{
 	}
@@ -42,7 +44,7 @@ namespace tiki
 
 	crc32 GenericDataConverter::getOutputType() const
 	{
-		return crcString( "genericdata" );
+		return s_typeCrc;
 	}
 
 	void GenericDataConverter::getDependingType( List< crc32 >& types ) const
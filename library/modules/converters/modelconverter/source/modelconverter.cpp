@@ -2,8 +2,9 @@
 #include "tiki/modelconverter/modelconverter.hpp"
 
 #include "tiki/base/crc32.hpp"
-#include "tiki/base/float16.hpp"
 #include "tiki/base/fourcc.hpp"
+#include "tiki/base/memory.hpp"
+#include "tiki/base/simdkernels.hpp"
 #include "tiki/base/stringparse.hpp"
 #include "tiki/converterbase/conversionparameters.hpp"
 #include "tiki/converterbase/converterhelper.hpp"
@@ -12,7 +13,7 @@
 
 namespace tiki
 {
-	static const crc32 s_typeCrc = crcString( "model" );
+	static const crc32 s_typeCrc = crcLiteral( "model" );
 
 	ModelConverter::ModelConverter()
 	{
@@ -24,7 +25,7 @@ namespace tiki
 
 	uint32 ModelConverter::getConverterRevision( crc32 typeCrc ) const
 	{
-		return 6u;
+		return 7u;
 	}
 
 	bool ModelConverter::canConvertType( crc32 typeCrc ) const 
@@ -39,7 +40,7 @@ namespace tiki
 
 	void ModelConverter::getDependingType( List< crc32 >& types ) const
 	{
-		types.add( crcString( "material" ) );
+		types.add( crcLiteral( "material" ) );
 	}
 
 	bool ModelConverter::initializeConverter()
@@ -208,89 +209,123 @@ namespace tiki
 		return refKey;
 	}
 
-	static void writeVertexAttribute( ResourceWriter& fileWriter, const uint8* pSource, VertexAttributeFormat targetFormat, bool isFloatFormat )
+	// returns false for semantics without source data
+	static bool getVertexAttributeSourceOffset( uint& offset, VertexSementic semantic )
 	{
-		const uint elementCount = getVertexAttributeFormatElementCount( targetFormat );
+		switch ( semantic )
+		{
+		case VertexSementic_Position:
+			offset = TIKI_OFFSETOF( ToolModelVertex, position );
+			return true;
+		case VertexSementic_Normal:
+			offset = TIKI_OFFSETOF( ToolModelVertex, normal );
+			return true;
+		case VertexSementic_TangentFlip:
+			offset = TIKI_OFFSETOF( ToolModelVertex, tangent );
+			return true;
+		case VertexSementic_Binormal:
+			offset = TIKI_OFFSETOF( ToolModelVertex, binormal );
+			return true;
+		case VertexSementic_TexCoord:
+			offset = TIKI_OFFSETOF( ToolModelVertex, texcoord );
+			return true;
+		case VertexSementic_Color:
+			offset = TIKI_OFFSETOF( ToolModelVertex, color );
+			return true;
+		case VertexSementic_JointIndex:
+			offset = TIKI_OFFSETOF( ToolModelVertex, jointIndices );
+			return true;
+		case VertexSementic_JointWeight:
+			offset = TIKI_OFFSETOF( ToolModelVertex, jointWeights );
+			return true;
+		default:
+			break;
+		}
 
-		if ( isFloatFormat )
+		return false;
+	}
+
+	// converts one attribute of all vertices at once and writes it into the interleaved vertex data
+	static void writeVertexAttribute( uint8* pVertexData, uint vertexStride, const ToolModelGeometrie& geometry, VertexSementic semantic, uint sourceOffset, VertexAttributeFormat targetFormat )
+	{
+		const uint vertexCount		= geometry.getVertexCount();
+		const uint elementCount		= getVertexAttributeFormatElementCount( targetFormat );
+		const uint attributeSize	= getVertexAttributeFormatSize( targetFormat );
+
+		Array< uint8 > targetValues;
+		targetValues.create( vertexCount * attributeSize, TIKI_DEFAULT_ALIGNMENT, false );
+		memory::zero( targetValues.getBegin(), targetValues.getCount() );
+
+		if ( semantic == VertexSementic_JointIndex )
 		{
-			const float* pSourceData = (const float*)pSource;
+			if ( targetFormat == VertexAttributeFormat_x8y8z8w8 )
+			{
+				for (uint k = 0u; k < vertexCount; ++k)
+				{
+					const uint32* pSourceData = (const uint32*)( (const uint8*)&geometry.getVertexByIndex( k ) + sourceOffset );
+					for (uint i = 0u; i < elementCount; ++i)
+					{
+						TIKI_ASSERT( pSourceData[ i ] < 256u );
+						targetValues[ k * attributeSize + i ] = (uint8)pSourceData[ i ];
+					}
+				}
+			}
+		}
+		else
+		{
+			const uint valueCount = vertexCount * elementCount;
+
+			Array< float > sourceValues;
+			sourceValues.create( valueCount, TIKI_DEFAULT_ALIGNMENT, false );
+			for (uint k = 0u; k < vertexCount; ++k)
+			{
+				memory::copy( &sourceValues[ k * elementCount ], (const uint8*)&geometry.getVertexByIndex( k ) + sourceOffset, elementCount * sizeof( float ) );
+			}
 
+			// the normalized formats are clamped and rounded to nearest
+			const SimdKernels& kernels = simd::getKernels();
 			switch ( targetFormat )
 			{
 			case VertexAttributeFormat_x32y32z32w32_float:
 			case VertexAttributeFormat_x32y32z32_float:
 			case VertexAttributeFormat_x32y32_float:
 			case VertexAttributeFormat_x32_float:
-				{
-					for (uint i = 0u; i < elementCount; ++i)
-					{
-						fileWriter.writeFloat( pSourceData[ i ] );
-					}
-				}
+				memory::copy( targetValues.getBegin(), sourceValues.getBegin(), valueCount * sizeof( float ) );
 				break;
 			case VertexAttributeFormat_x16y16z16w16_float:
 			case VertexAttributeFormat_x16y16_float:
 			case VertexAttributeFormat_x16_float:
-				{
-					for (uint i = 0u; i < elementCount; ++i)
-					{
-						fileWriter.writeUInt16( f16::convertFloat32to16( pSourceData[ i ] ) );
-					}
-				}
+				kernels.pConvertFloat32ToFloat16( (float16*)targetValues.getBegin(), sourceValues.getBegin(), valueCount );
 				break;
 			case VertexAttributeFormat_x16y16z16w16_snorm:
 			case VertexAttributeFormat_x16y16_snorm:
 			case VertexAttributeFormat_x16_snorm:
-				{
-					for (uint i = 0u; i < elementCount; ++i)
-					{
-						TIKI_ASSERT( pSourceData[ i ] >= -1.0f && pSourceData[ i ] <= 1.0f );
-						fileWriter.writeSInt16( (sint16)( pSourceData[ i ] * 32667.0f ) );
-					}
-				}
+				kernels.pPackSnorm16( (sint16*)targetValues.getBegin(), sourceValues.getBegin(), valueCount );
 				break;
 			case VertexAttributeFormat_x16y16z16w16_unorm:
 			case VertexAttributeFormat_x16y16_unorm:
 			case VertexAttributeFormat_x16_unorm:
-				{
-					for (uint i = 0u; i < elementCount; ++i)
-					{
-						TIKI_ASSERT( pSourceData[ i ] >= 0.0f && pSourceData[ i ] <= 1.0f );
-						fileWriter.writeUInt16( (uint16)( pSourceData[ i ] * 65535.0f ) );
-					}
-				}
+				kernels.pPackUnorm16( (uint16*)targetValues.getBegin(), sourceValues.getBegin(), valueCount );
 				break;
 			case VertexAttributeFormat_x8y8z8w8_snorm:
-				{
-					for (uint i = 0u; i < elementCount; ++i)
-					{
-						TIKI_ASSERT( pSourceData[ i ] >= -1.0f && pSourceData[ i ] <= 1.0f );
-						fileWriter.writeUInt8( (sint8)( pSourceData[ i ] * 127.0f ) );
-					}
-				}
+				kernels.pPackSnorm8( (sint8*)targetValues.getBegin(), sourceValues.getBegin(), valueCount );
 				break;
 			case VertexAttributeFormat_x8y8z8w8_unorm:
-				{
-					for (uint i = 0u; i < elementCount; ++i)
-					{
-						TIKI_ASSERT( pSourceData[ i ] >= 0.0f && pSourceData[ i ] <= 1.0f );
-						fileWriter.writeUInt8( (uint8)( pSourceData[ i ] * 255.0f ) );
-					}
-				}
+				kernels.pPackUnorm8( targetValues.getBegin(), sourceValues.getBegin(), valueCount );
+				break;
+			default:
 				break;
 			}
+
+			sourceValues.dispose();
 		}
-		else if ( targetFormat == VertexAttributeFormat_x8y8z8w8 )
-		{
-			const uint32* pSourceData = (const uint32*)pSource;
 
-			for (uint i = 0u; i < elementCount; ++i)
-			{
-				TIKI_ASSERT( pSourceData[ i ] < 256u );
-				fileWriter.writeUInt8( (uint8)pSourceData[ i ] );
-			}
+		for (uint k = 0u; k < vertexCount; ++k)
+		{
+			memory::copy( pVertexData + k * vertexStride, &targetValues[ k * attributeSize ], attributeSize );
 		}
+
+		targetValues.dispose();
 	}
 
 	ReferenceKey ModelConverter::writeGeometry( ResourceWriter& writer, const ToolModelGeometrie& geometry ) const
@@ -309,53 +344,39 @@ namespace tiki
 		writer.writeAlignment( 16u );
 		const ReferenceKey vertexDataKey = writer.addDataPoint();
 		const VertexAttribute* pAttributes = vertexFormat.getAttributes();
-		for (uint k = 0u; k < geometry.getVertexCount(); ++k)
-		{
-			const ToolModelVertex& vertex = geometry.getVertexByIndex( k );
 
-			for (uint j = 0u; j < vertexFormat.getAttributeCount(); ++j)
+		// attributes without source data are skipped
+		uint vertexStride = 0u;
+		for (uint j = 0u; j < vertexFormat.getAttributeCount(); ++j)
+		{
+			uint sourceOffset;
+			if ( getVertexAttributeSourceOffset( sourceOffset, pAttributes[ j ].semantic ) )
 			{
-				const VertexAttribute& att = pAttributes[ j ];
+				vertexStride += getVertexAttributeFormatSize( pAttributes[ j ].format );
+			}
+		}
 
-				bool isFloat			= true;
-				const uint8* pSource	= nullptr;
+		Array< uint8 > vertexData;
+		vertexData.create( geometry.getVertexCount() * vertexStride, TIKI_DEFAULT_ALIGNMENT, false );
 
-				switch ( att.semantic )
-				{
-				case VertexSementic_Position:
-					pSource = (uint8*)&vertex.position.x;
-					break;
-				case VertexSementic_Normal:
-					pSource = (uint8*)&vertex.normal.x;
-					break;
-				case VertexSementic_TangentFlip:
-					pSource = (uint8*)&vertex.tangent.x;
-					break;
-				case VertexSementic_Binormal:
-					pSource = (uint8*)&vertex.binormal.x;
-					break;
-				case VertexSementic_TexCoord:
-					pSource = (uint8*)&vertex.texcoord.x;
-					break;
-				case VertexSementic_Color:
-					pSource = (uint8*)&vertex.color.x;
-					break;
-				case VertexSementic_JointIndex:
-					isFloat = false;
-					pSource = (uint8*)&vertex.jointIndices.x;
-					break;
-				case VertexSementic_JointWeight:
-					pSource = (uint8*)&vertex.jointWeights.x;
-					break;
-				}
+		uint attributeOffset = 0u;
+		for (uint j = 0u; j < vertexFormat.getAttributeCount(); ++j)
+		{
+			const VertexAttribute& att = pAttributes[ j ];
 
-				if ( pSource != nullptr )
-				{
-					writeVertexAttribute( writer, pSource, att.format, isFloat );
-				}
+			uint sourceOffset;
+			if ( !getVertexAttributeSourceOffset( sourceOffset, att.semantic ) )
+			{
+				continue;
 			}
+
+			writeVertexAttribute( vertexData.getBegin() + attributeOffset, vertexStride, geometry, att.semantic, sourceOffset, att.format );
+			attributeOffset += getVertexAttributeFormatSize( att.format );
 		}
 
+		writer.writeData( vertexData.getBegin(), vertexData.getCount() );
+		vertexData.dispose();
+
 		writer.writeAlignment( 4u );
 		const ReferenceKey indexDataKey = writer.addDataPoint();
 		for (uint k = 0u; k < geometry.getIndexCount(); ++k)
@@ -24,7 +24,7 @@
 
 namespace tiki
 {
-	static const crc32 s_typeCrc = crcString( "shader" );
+	static const crc32 s_typeCrc = crcLiteral( "shader" );
 
 	struct ShaderVariantData
 	{
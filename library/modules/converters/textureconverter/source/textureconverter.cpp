@@ -15,11 +15,11 @@
 
 namespace tiki
 {
-	static const crc32 s_typeCrc = crcString( "texture" );
+	static const crc32 s_typeCrc = crcLiteral( "texture" );
 
 	uint32 TextureConverter::getConverterRevision( crc32 typeCrc ) const
 	{
-		return 5u;
+		return 6u;
 	}
 
 	bool TextureConverter::canConvertType( crc32 typeCrc ) const
@@ -121,12 +121,13 @@ namespace tiki
 
 				if ( scale.x != image.getWidth() || scale.y != image.getHeight() )
 				{
-					image.resizeImage( scale );
+					image.resizeImage( scale, getTaskSystem() );
 				}
 			}
 
 			TextureWriterParameters writerParameters;
 			writerParameters.targetFormat	= PixelFormat_R8G8B8A8;
+			writerParameters.pTaskSystem	= getTaskSystem();
 							
 			writerParameters.mipMapCount = 1u;
 			if ( params.arguments.getOptionalBool( "generate_mipmaps", true ) )
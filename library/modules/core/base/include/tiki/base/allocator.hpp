@@ -0,0 +1,45 @@
+#pragma once
+#ifndef TIKI_ALLOCATOR_HPP_INCLUDED
+#define TIKI_ALLOCATOR_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	// memory source for containers. arena allocators may ignore free and release everything at once.
+	class Allocator
+	{
+	public:
+
+		virtual			~Allocator() { }
+
+		// TIKI_DEFAULT_ALIGNMENT selects the default alignment of the allocator
+		virtual void*	allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT ) = 0;
+		virtual void	free( void* pMemory ) = 0;
+
+		// grows or shrinks an allocation without moving it. returns false when the allocator can't do that.
+		virtual bool	resize( void* /*pMemory*/, uint /*newSizeInBytes*/ ) { return false; }
+
+		// true when the allocator can only hold one allocation, so a container can't move to a new array
+		virtual bool	isSingleAllocation() const { return false; }
+
+	};
+
+	namespace memory
+	{
+		// without an allocator the array comes from the global heap like TIKI_MEMORY_NEW_ARRAY_ALIGNED
+		template<typename T>
+		TIKI_FORCE_INLINE T*	newArray( Allocator* pAllocator, uint count, uint alignment = TIKI_DEFAULT_ALIGNMENT, bool constructElements = false );
+
+		// grows the array in place and constructs the new elements. returns false when the array has to be moved.
+		template<typename T>
+		TIKI_FORCE_INLINE bool	growArray( Allocator* pAllocator, T* pArray, uint count, uint newCount, bool constructElements = false );
+
+		template<typename T>
+		TIKI_FORCE_INLINE void	deleteArray( Allocator* pAllocator, T* pArray, uint count );
+	}
+}
+
+#include "../../../source/allocator.inl"
+
+#endif // TIKI_ALLOCATOR_HPP_INCLUDED
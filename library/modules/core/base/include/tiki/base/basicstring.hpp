@@ -89,13 +89,24 @@ namespace tiki
 
 	private:
 
+		enum
+		{
+			// strings up to this size including the terminator are stored in the object itself
+			LocalDataSize = 24u
+		};
+
 		char*						m_pData;
 		uint						m_dataSize;
 		uint						m_stringSize;
 		//uint						m_stringLength; // TODO
 
+		char						m_aLocalData[ LocalDataSize ];
+
 		static const char			whiteSpaces[ 4u ];
 
+		TIKI_FORCE_INLINE bool		isLocalData() const { return m_pData == m_aLocalData; }
+
+		TIKI_FORCE_INLINE void		initializeData();
 		TIKI_FORCE_INLINE void		allocateData( sint length );
 		TIKI_FORCE_INLINE void		reallocateData( sint length );
 		TIKI_FORCE_INLINE void		allocateDataForString( const char* pString, sint length = -1 );
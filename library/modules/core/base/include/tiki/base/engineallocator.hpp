@@ -0,0 +1,22 @@
+#pragma once
+#ifndef TIKI_ENGINEALLOCATOR_HPP_INCLUDED
+#define TIKI_ENGINEALLOCATOR_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	// general purpose allocator with size classes from 16 bytes to 32 kb. small blocks are served from per thread
+	// caches which are refilled from slabs. larger blocks come directly from the system. memory::allocAligned uses it
+	// when TIKI_USE_ENGINE_ALLOCATOR is enabled.
+	namespace engineallocator
+	{
+		void*	allocate( uint sizeInBytes, uint alignment );
+		void	free( void* pMemory );
+
+		// moves the cached blocks of the current thread back to the shared slabs. has to be called before a thread exits.
+		void	flushThreadCache();
+	}
+}
+
+#endif // TIKI_ENGINEALLOCATOR_HPP_INCLUDED
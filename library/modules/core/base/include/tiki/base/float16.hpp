@@ -8,6 +8,7 @@ namespace tiki
 {
 	namespace f16
 	{
+		// rounded to nearest even. use the simd kernels to convert arrays.
 		float16 convertFloat32to16( float value );
 		float convertFloat16to32( float16 value );
 	}
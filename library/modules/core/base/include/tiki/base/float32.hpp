@@ -70,16 +70,23 @@ namespace tiki
 			return ( value < min ? min : ( value > max ? max : value ) );
 		}
 
-		// approximated 1.0f / sqrt( x )
-		TIKI_FORCE_INLINE float approximatedInverseSquareRoot( float x )
-		{
-			float xhalf = x * 0.5f;
-			int i = *(int*) &x;
-			i = 0x5f3759df - ( i >> 1 );
-			x = *(float*) &i;
-			x = x * ( 1.5f - xhalf * x * x );
-			return x;
-		}
+		// polynomial approximations, several times faster than the crt. the errors are measured against the double
+		// precision crt, the batched simd versions are in SimdKernels.
+
+		// max absolute error 1e-7 for |x| <= 8192, the precision decreases with larger values
+		TIKI_FORCE_INLINE float	approximatedSin( float x );
+		TIKI_FORCE_INLINE float	approximatedCos( float x );
+		TIKI_FORCE_INLINE void	approximatedSinCos( float& sinValue, float& cosValue, float x );
+		// max absolute error 3e-7 radians. returns 0 for x = y = 0
+		TIKI_FORCE_INLINE float	approximatedAtan2( float y, float x );
+		// max relative error 1.5e-7. x is clamped to [-87.3, 88.3], so the result is always a normalized float
+		TIKI_FORCE_INLINE float	approximatedExp( float x );
+		// max absolute error 5e-8 for x in [0.5, 2], max relative error 1e-7 elsewhere. x has to be a positive
+		// normalized float
+		TIKI_FORCE_INLINE float	approximatedLog( float x );
+
+		// approximated 1.0f / sqrt( x ) with two newton steps, max relative error 5e-6
+		TIKI_FORCE_INLINE float	approximatedInverseSquareRoot( float x );
 
 		TIKI_FORCE_INLINE float rsqrt( float x )
 		{
@@ -119,4 +126,6 @@ namespace tiki
 	}
 }
 
+#include "../../../source/float32.inl"
+
 #endif // TIKI_FLOAT_HPP
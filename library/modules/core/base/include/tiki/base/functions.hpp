@@ -2,10 +2,11 @@
 #ifndef TIKI_BASE_FUNCTIONS_HPP
 #define TIKI_BASE_FUNCTIONS_HPP
 
-#include "tiki/base/types.hpp"
+#include "tiki/base/assert.hpp"
 #include "tiki/base/numberlimits.hpp"
+#include "tiki/base/types.hpp"
 
-#if TIKI_ENABLED( TIKI_BUILD_MSVC ) && TIKI_ENABLED( TIKI_BUILD_64BIT )
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
 #	include <intrin.h>
 #endif
 
@@ -103,6 +104,8 @@ namespace tiki
 		{
 			return 64u;
 		}
+#elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+		return ( value != 0u ? uint( __builtin_clzll( value ) ) : 64u );
 #else
 		register uint64 x = value;
 		x |= (x >> 1);
@@ -115,6 +118,21 @@ namespace tiki
 #endif
 	}
 
+	// value must not be zero
+	TIKI_FORCE_INLINE uint countTrailingZeros32( uint32 value )
+	{
+		TIKI_ASSERT( value != 0u );
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+		unsigned long result = 0u;
+		_BitScanForward( &result, value );
+		return result;
+#elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+		return uint( __builtin_ctz( value ) );
+#else
+		return countPopulation64( uint64( ( value & ( 0u - value ) ) - 1u ) );
+#endif
+	}
+
 	TIKI_FORCE_INLINE uint clamp( uint value, uint min, uint max )
 	{
 		return ( value < min ? min : value > max ? max : value );
@@ -7,6 +7,17 @@
 
 #define TIKI_MINIMUM_ALIGNMENT TIKI_SIZE_T_BYTES
 
+// selects the thread caching engine allocator instead of the system allocator
+#ifndef TIKI_USE_ENGINE_ALLOCATOR
+#	define TIKI_USE_ENGINE_ALLOCATOR TIKI_OFF
+#endif
+
+#if TIKI_DISABLED( TIKI_BUILD_MASTER )
+#	define TIKI_USE_MEMORY_TRACKING TIKI_ON
+#else
+#	define TIKI_USE_MEMORY_TRACKING TIKI_OFF
+#endif
+
 #if TIKI_ENABLED( TIKI_BUILD_MSVC ) && 0
 #	define TIKI_DECLARE_STACKANDZERO( type, name ) type name = { }
 #else
@@ -32,7 +43,7 @@
 #	define TIKI_MEMORY_NEW_OBJECT( type )										::new ( ::tiki::memory::newObjectAligned< type >() ) type
 #	define TIKI_MEMORY_NEW_OBJECT_ALIGNED( type, alignment )					::new ( ::tiki::memory::newObjectAligned< type >( alignment ) ) type
 
-#	define TIKI_MEMORY_NEW_ARRAY( type, count, construct )						::tiki::memory::newArrayAligned< type >( count, construct )
+#	define TIKI_MEMORY_NEW_ARRAY( type, count, construct )						::tiki::memory::newArrayAligned< type >( count, TIKI_DEFAULT_ALIGNMENT, construct )
 #	define TIKI_MEMORY_NEW_ARRAY_ALIGNED( type, count, alignment, construct )	::tiki::memory::newArrayAligned< type >( count, alignment, construct )
 
 #endif
@@ -43,6 +54,48 @@
 
 namespace tiki
 {
+	enum MemoryTag
+	{
+		MemoryTag_Default,
+		MemoryTag_TaskSystem,
+		MemoryTag_Resource,
+		MemoryTag_Graphics,
+		MemoryTag_Entity,
+		MemoryTag_Converter,
+
+		MemoryTag_Count
+	};
+
+	struct MemoryTagStatistics
+	{
+		uint64	liveSizeInBytes;
+		uint64	liveAllocationCount;
+		uint64	peakSizeInBytes;
+		uint64	totalAllocationCount;
+
+		// allocations with an alignment above the natural alignment of the system allocator take a slower path
+		uint64	overAlignedAllocationCount;
+
+		// 0 means no budget
+		uint64	budgetInBytes;
+	};
+
+	// all allocations of the current thread inside of the scope are assigned to the tag
+	class MemoryTagScope
+	{
+		TIKI_NONCOPYABLE_CLASS( MemoryTagScope );
+
+	public:
+
+		explicit	MemoryTagScope( MemoryTag tag );
+					~MemoryTagScope();
+
+	private:
+
+		MemoryTag	m_previousTag;
+
+	};
+
 	namespace memory
 	{
 #if TIKI_ENABLED( TIKI_BUILD_DEBUG )
@@ -72,6 +125,15 @@ namespace tiki
 		template<typename T>
 		void					deleteArrayAligned( T* pArray, uint count );
 
+		MemoryTag				getCurrentTag();
+		void					setCurrentTag( MemoryTag tag );
+		const char*				getTagName( MemoryTag tag );
+
+		// statistics and budgets are only available with TIKI_USE_MEMORY_TRACKING. a warning is traced when a tag
+		// exceeds its budget.
+		void					setTagBudget( MemoryTag tag, uint64 budgetInBytes );
+		void					getTagStatistics( MemoryTag tag, MemoryTagStatistics& statistics );
+
 		int						compare ( const void* pData1, const void* pData2, uint sizeInBytes );
 		void					copy( void* pTargetData, const void* pSourceData, uint sizeInBytes );
 		
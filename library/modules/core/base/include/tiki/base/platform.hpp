@@ -5,6 +5,12 @@
 #include "tiki/base/types.hpp"
 #include "tiki/container/staticarray.hpp"
 
+#if TIKI_ENABLED( TIKI_BUILD_MSVC ) || defined( __i386__ ) || defined( __x86_64__ )
+#	define TIKI_CPU_X86 TIKI_ON
+#else
+#	define TIKI_CPU_X86 TIKI_OFF
+#endif
+
 namespace tiki
 {
 	TIKI_DEFINE_HANLE( InstanceHandle );
@@ -32,6 +38,19 @@ namespace tiki
 		GraphicsApi_Count,
 	};
 
+	enum CpuFeature
+	{
+		CpuFeature_Sse41,
+		CpuFeature_Sse42,
+		CpuFeature_Pclmul,
+		CpuFeature_Avx,
+		CpuFeature_Avx2,
+		CpuFeature_Fma,
+		CpuFeature_F16c,
+
+		CpuFeature_Count
+	};
+
 	namespace platform
 	{
 		PlatformType							getHostPlatform();
@@ -39,6 +58,9 @@ namespace tiki
 
 		uint									getProcessorCount();
 
+		// checks the cpu and the os support. always false for non x86 cpus.
+		bool									hasCpuFeature( CpuFeature feature );
+
 		void									getUserName( char* pBuffer, uint bufferSize );
 
 #if TIKI_DISABLED( TIKI_BUILD_LIBRARY )
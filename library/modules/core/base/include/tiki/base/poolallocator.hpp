@@ -3,10 +3,17 @@
 #define __TIKI_POOLALLOCATOR_HPP_INCLUDED__
 
 #include "tiki/base/types.hpp"
-#include "tiki/base/inline.hpp"
 
 namespace tiki
 {
+	enum PoolAllocatorType
+	{
+		// free slots are linked through their own memory. allocate and free are O(1).
+		PoolAllocatorType_FreeList,
+		// one bit per slot. allocate searches the first free bit, so it gets slower the fuller the pool is.
+		PoolAllocatorType_Bitmask
+	};
+
 	template<typename T>
 	class PoolAllocator
 	{
@@ -17,20 +24,39 @@ namespace tiki
 		TIKI_FORCE_INLINE		PoolAllocator();
 		TIKI_FORCE_INLINE		~PoolAllocator();
 
-		TIKI_FORCE_INLINE bool	create( uint count, uint alignment = TIKI_DEFAULT_ALIGNMENT );
+		TIKI_FORCE_INLINE bool	create( uint count, uint alignment = TIKI_DEFAULT_ALIGNMENT, PoolAllocatorType type = PoolAllocatorType_FreeList );
 		TIKI_FORCE_INLINE void	dispose();
 
 		TIKI_FORCE_INLINE bool	isCreated() const { return m_pPool != nullptr; }
 
+		TIKI_FORCE_INLINE uint	getCount() const { return m_usedCount; }
+		TIKI_FORCE_INLINE uint	getCapacity() const { return m_count; }
+
+		// returns nullptr when the pool is full
 		TIKI_FORCE_INLINE T*	allocate();
 		TIKI_FORCE_INLINE void	free( T* pObject );
 
 	private:
 
-		T*		m_pPool;
-		uint	m_count;
+		struct FreeSlot
+		{
+			FreeSlot*	pNext;
+		};
+
+		PoolAllocatorType	m_type;
+
+		uint8*				m_pPool;
+		uint				m_slotSize;
+		uint				m_count;
+		uint				m_usedCount;
+
+		FreeSlot*			m_pFirstFree;
+
+		uint64*				m_pUsageBitmask;
+		uint				m_usageCount;
 
-		uint64*	m_pUsageBitmask;
+		TIKI_FORCE_INLINE T*	allocateFromBitmask();
+		TIKI_FORCE_INLINE void	freeToBitmask( uint index );
 
 	};
 }
@@ -4,14 +4,43 @@
 
 #include "tiki/base/types.hpp"
 
-#if TIKI_ENABLED( TIKI_BUILD_MSVC ) || (defined( __MMX__ ) && defined( __SSE__ ))
+// gcc and clang get the sse backend when the target supports sse 4.1 (-msse4.1 in the linux toolchain)
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+#	define TIKI_SIMD_WIN				TIKI_ON
+#	define TIKI_SIMD_SSE				TIKI_OFF
+#	define TIKI_SIMD_FLOATEMULATION	TIKI_OFF
+#elif defined( __SSE4_1__ )
+#	define TIKI_SIMD_WIN				TIKI_OFF
+#	define TIKI_SIMD_SSE				TIKI_ON
+#	define TIKI_SIMD_FLOATEMULATION	TIKI_OFF
+#else
+#	define TIKI_SIMD_WIN				TIKI_OFF
+#	define TIKI_SIMD_SSE				TIKI_OFF
+#	define TIKI_SIMD_FLOATEMULATION	TIKI_ON
+#endif
+
+// vf32x8 maps to one register when the compiler is allowed to use avx
+#if TIKI_DISABLED( TIKI_SIMD_FLOATEMULATION ) && defined( __AVX__ )
+#	define TIKI_SIMD_AVX				TIKI_ON
+#else
+#	define TIKI_SIMD_AVX				TIKI_OFF
+#endif
+
+#if TIKI_ENABLED( TIKI_SIMD_WIN )
 #	include "../../../source/win/simd_types_win.hpp"
+#elif TIKI_ENABLED( TIKI_SIMD_SSE )
+#	include "../../../source/simd_sse_types.hpp"
 #else
 #	include "../../../source/simd_floatemulation_types.hpp"
 #endif
 
+#if TIKI_ENABLED( TIKI_SIMD_AVX )
+#	include <immintrin.h>
+#endif
+
 #define TIKI_USE_SIMDINLINE TIKI_ON
 #define TIKI_SIMD_ALIGNMENT 16u
+#define TIKI_SIMD_X8_ALIGNMENT 32u
 
 #if TIKI_ENABLED( TIKI_USE_SIMDINLINE )
 #	define TIKI_SIMD_INLINE TIKI_FORCE_INLINE
@@ -21,6 +50,17 @@
 
 namespace tiki
 {
+#if TIKI_ENABLED( TIKI_SIMD_AVX )
+	typedef __m256 vf32x8;
+#else
+	// two 4 wide vectors without avx
+	struct vf32x8
+	{
+		vf32	low;
+		vf32	high;
+	};
+#endif
+
 	namespace simd
 	{
 		//////////////////////////////////////////////////////////////////////////
@@ -126,6 +166,9 @@ namespace tiki
 		TIKI_SIMD_INLINE vf32	div_f32( const vf32 v1, const vf32 v2 );				
 		TIKI_SIMD_INLINE vf32	muladd_f32( const vf32 v1, const vf32 v2, const vf32 v3 );	// v1 * v2 + v3		
 		TIKI_SIMD_INLINE vf32	mulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 );	// v1 * v2 - v3
+		TIKI_SIMD_INLINE vf32	min_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE vf32	max_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE vf32	sqrt_f32( const vf32 value );
 
 		TIKI_SIMD_INLINE vi32	add_i32( const vi32 v1, const vi32 v2 );
 		TIKI_SIMD_INLINE vi32	sub_i32( const vi32 v1, const vi32 v2 );
@@ -172,6 +215,17 @@ namespace tiki
 
 		//////////////////////////////////////////////////////////////////////////
 		// compare
+		// the results are masks with all bits set in the lanes where the condition is true
+
+		TIKI_SIMD_INLINE vf32	cmplt_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE vf32	cmple_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE vf32	cmpgt_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE vf32	cmpge_f32( const vf32 v1, const vf32 v2 );
+
+		TIKI_SIMD_INLINE vf32	and_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE vf32	or_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE vf32	select_f32( const vf32 mask, const vf32 v1, const vf32 v2 );	// mask ? v1 : v2
+		TIKI_SIMD_INLINE uint32	mask_f32( const vf32 mask );										// one bit per lane, x is bit 0
 
 		//////////////////////////////////////////////////////////////////////////
 		// convert
@@ -194,14 +248,50 @@ namespace tiki
 		TIKI_SIMD_INLINE vf32	rsqrt_f32( const vf32 value ); // 1.0f / sqrt( value )
 		TIKI_SIMD_INLINE vf32	negmulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 );
 		TIKI_SIMD_INLINE vf32	dot4_f32( const vf32 v1, const vf32 v2 );
+		TIKI_SIMD_INLINE void	transpose_f32( vf32& x, vf32& y, vf32& z, vf32& w );			// rows to columns
+
+		//////////////////////////////////////////////////////////////////////////
+		// 8 wide
+
+		TIKI_SIMD_INLINE vf32x8	set_f32x8( const float value );
+		TIKI_SIMD_INLINE vf32x8	set_f32x8( const float* pValues );	// aligned to TIKI_SIMD_X8_ALIGNMENT
+		TIKI_SIMD_INLINE vf32x8	set_f32x8u( const float* pValues );
+		TIKI_SIMD_INLINE void	get_f32x8( float* pTarget, const vf32x8 value );
+		TIKI_SIMD_INLINE void	get_f32x8u( float* pTarget, const vf32x8 value );
+
+		TIKI_SIMD_INLINE vf32x8	add_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	sub_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	mul_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	div_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	muladd_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 );	// v1 * v2 + v3
+		TIKI_SIMD_INLINE vf32x8	mulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 );	// v1 * v2 - v3
+		TIKI_SIMD_INLINE vf32x8	negmulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 );	// v3 - v1 * v2
+		TIKI_SIMD_INLINE vf32x8	min_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	max_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	sqrt_f32x8( const vf32x8 value );
+		TIKI_SIMD_INLINE vf32x8	rsqrt_f32x8( const vf32x8 value );
+
+		TIKI_SIMD_INLINE vf32x8	cmplt_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	cmple_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	cmpgt_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	cmpge_f32x8( const vf32x8 v1, const vf32x8 v2 );
+
+		TIKI_SIMD_INLINE vf32x8	and_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	or_f32x8( const vf32x8 v1, const vf32x8 v2 );
+		TIKI_SIMD_INLINE vf32x8	select_f32x8( const vf32x8 mask, const vf32x8 v1, const vf32x8 v2 );	// mask ? v1 : v2
+		TIKI_SIMD_INLINE uint32	mask_f32x8( const vf32x8 mask );
 
 	}
 }
 
-#if TIKI_ENABLED( TIKI_BUILD_MSVC ) || (defined( __MMX__ ) && defined( __SSE__ ))
+#if TIKI_ENABLED( TIKI_SIMD_WIN )
 #	include "../../../source/win/simd_win.inl"
+#elif TIKI_ENABLED( TIKI_SIMD_SSE )
+#	include "../../../source/simd_sse.inl"
 #else
 #	include "../../../source/simd_floatemulation.inl"
 #endif
 
+#include "../../../source/simd_x8.inl"
+
 #endif // TIKI_SIMD_HPP
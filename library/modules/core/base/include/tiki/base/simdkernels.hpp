@@ -0,0 +1,65 @@
+#pragma once
+#ifndef TIKI_SIMDKERNELS_HPP_INCLUDED
+#define TIKI_SIMDKERNELS_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	enum SimdKernelLevel
+	{
+		SimdKernelLevel_Scalar,
+		SimdKernelLevel_Sse41,
+		SimdKernelLevel_Avx2,
+
+		SimdKernelLevel_Count
+	};
+
+	// batch kernels over float streams. the arrays don't need to be aligned and the count doesn't need to be a
+	// multiple of the lane count. all levels return the same results except for fma rounding.
+	struct SimdKernels
+	{
+		// target[ i ] = source[ i ] * factor
+		void	(*pConvertInt16ToFloat)( float* pTarget, const sint16* pSource, float factor, uint count );
+		// target[ i ] = a[ i ] * b[ i ] + c[ i ]
+		void	(*pMultiplyAdd)( float* pTarget, const float* pA, const float* pB, const float* pC, uint count );
+		// cubic hermite spline from p0 to p1 with the tangents t0 and t1 at time[ i ] between 0 and 1
+		void	(*pHermite)( float* pTarget, const float* pP0, const float* pT0, const float* pP1, const float* pT1, const float* pTime, uint count );
+
+		// the approximations have the error bounds and input ranges of the scalar versions in f32
+		void	(*pSin)( float* pTarget, const float* pSource, uint count );
+		void	(*pCos)( float* pTarget, const float* pSource, uint count );
+		void	(*pSinCos)( float* pSinTarget, float* pCosTarget, const float* pSource, uint count );
+		// target[ i ] = atan2( y[ i ], x[ i ] )
+		void	(*pAtan2)( float* pTarget, const float* pY, const float* pX, uint count );
+		void	(*pExp)( float* pTarget, const float* pSource, uint count );
+		void	(*pLog)( float* pTarget, const float* pSource, uint count );
+		// hardware estimate with one newton step, max relative error 5e-7. the scalar level is exact.
+		void	(*pInverseSquareRoot)( float* pTarget, const float* pSource, uint count );
+
+		// rounded to nearest even with subnormals, infinity and nan like f16c. the same results as the functions in f16.
+		void	(*pConvertFloat32ToFloat16)( float16* pTarget, const float* pSource, uint count );
+		void	(*pConvertFloat16ToFloat32)( float* pTarget, const float16* pSource, uint count );
+
+		// the sources are clamped to [0, 1] or [-1, 1], nan to 0, scaled by the max value and rounded to nearest even
+		void	(*pPackUnorm8)( uint8* pTarget, const float* pSource, uint count );
+		void	(*pPackSnorm8)( sint8* pTarget, const float* pSource, uint count );
+		void	(*pPackUnorm16)( uint16* pTarget, const float* pSource, uint count );
+		void	(*pPackSnorm16)( sint16* pTarget, const float* pSource, uint count );
+		// xyzw float quadruples to 10:10:10:2 unorm with x in the low bits. count is the number of packed values.
+		void	(*pPackUnorm1010102)( uint32* pTarget, const float* pSource, uint count );
+	};
+
+	namespace simd
+	{
+		// the fastest kernels the cpu supports. selected on the first call.
+		const SimdKernels&	getKernels();
+		SimdKernelLevel		getKernelLevel();
+
+		// returns nullptr when the cpu or the build doesn't support the level
+		const SimdKernels*	getKernels( SimdKernelLevel level );
+		const char*			getKernelLevelName( SimdKernelLevel level );
+	}
+}
+
+#endif // TIKI_SIMDKERNELS_HPP_INCLUDED
@@ -7,63 +7,38 @@
 namespace tiki
 {
 	template<typename T>
-	void quickSort( T* pData, uint capacity )
+	struct SortLess
 	{
-		quickSortRange( pData, 0u, capacity - 1u );
-	}
+		TIKI_FORCE_INLINE bool operator()( const T& lhs, const T& rhs ) const { return lhs < rhs; }
+	};
 
+	// introsort: quicksort with median of three pivots, heapsort when the recursion gets too deep and insertion
+	// sort for small ranges. O(n log n) in every case, not stable.
 	template<typename T>
-	void quickSortRange( T* pData, uint left, uint right )
-	{
-		uint i = left;
-		uint j = right;
-
-		while ( right > left )
-		{
-			i = left;
-			j = right - 1u;
-			uint p = right;
-			T value = pData[ p ];
-
-			do
-			{
-				while ( pData[ i ] < value && i < right )
-				{
-					i++;
-				}
+	void quickSort( T* pData, uint count );
+	// left and right are inclusive
+	template<typename T>
+	void quickSortRange( T* pData, uint left, uint right );
 
-				while ( pData[ j ] >= value && j > left )
-				{
-					j--;
-				}
+	template<typename T, typename TLess>
+	void introSort( T* pData, uint count, TLess isLess );
 
-				if (i < j)
-				{
-					T valueTemp = pData[ i ];
-					pData[ i ] = pData[ j ];
-					pData[ j ] = valueTemp;
-				}
-			} while ( i < j );
+	template<typename T, typename TLess>
+	void insertionSort( T* pData, uint count, TLess isLess );
+	template<typename T, typename TLess>
+	void heapSort( T* pData, uint count, TLess isLess );
 
-			if ( pData[ i ] > value )
-			{
-				T valueTemp		= pData[ i ];
-				pData[ i ]		= pData[ right ];
-				pData[ right ]	= valueTemp;
-			}
+	// stable lsd radix sort with 8 bit digits. getKey returns an uint32 or uint64 key for an element and decides the
+	// count of passes. passes where all keys have the same digit are skipped. pScratch needs space for count elements,
+	// the sorted elements are in pData afterwards.
+	template<typename T, typename TKeyExtractor>
+	void radixSort( T* pData, T* pScratch, uint count, TKeyExtractor getKey );
 
-			if ( j > i )
-			{
-				quickSortRange( pData, left, i - 1 );
-				left = i + 1;
-			}
-			else
-			{
-				quickSortRange( pData, i + 1, right );
-				right = i - 1;
-			}
-		}
-	}
+	// keys which keep the order of signed and floating point values
+	TIKI_FORCE_INLINE uint32 getRadixSortKey( sint32 value );
+	TIKI_FORCE_INLINE uint32 getRadixSortKey( float value );
 }
 
+#include "../../../source/sort.inl"
+
 #endif // __TIKI_SORT_HPP_INCLUDED__
@@ -0,0 +1,60 @@
+#pragma once
+#ifndef TIKI_STRINGID_HPP_INCLUDED
+#define TIKI_STRINGID_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	class BasicString;
+
+	// interned string. equal strings share one entry in a global table, so comparing two ids is a pointer compare
+	// and the crc is computed only once. entries are never freed, so don't intern strings with a short lifetime.
+	class StringId
+	{
+	public:
+
+		struct Entry
+		{
+			const Entry*	pNext;
+			crc32			crc;
+			uint32			length;
+			// followed by the characters and the terminator
+		};
+
+		TIKI_FORCE_INLINE				StringId() : m_pEntry( nullptr ) { }
+		explicit						StringId( const char* pString );
+										StringId( const char* pString, uint length );
+		explicit						StringId( const BasicString& string );
+
+		// the empty string is the same as the default id
+		TIKI_FORCE_INLINE bool			isEmpty() const { return m_pEntry == nullptr; }
+
+		TIKI_FORCE_INLINE const char*	getString() const { return ( m_pEntry != nullptr ? (const char*)( m_pEntry + 1u ) : "" ); }
+		TIKI_FORCE_INLINE uint			getLength() const { return ( m_pEntry != nullptr ? m_pEntry->length : 0u ); }
+		// same value as crcString
+		TIKI_FORCE_INLINE crc32			getCrc() const { return ( m_pEntry != nullptr ? m_pEntry->crc : 0u ); }
+
+		TIKI_FORCE_INLINE const char*	cStr() const { return getString(); }
+
+		TIKI_FORCE_INLINE bool			operator==( const StringId& rhs ) const { return m_pEntry == rhs.m_pEntry; }
+		TIKI_FORCE_INLINE bool			operator!=( const StringId& rhs ) const { return m_pEntry != rhs.m_pEntry; }
+		// the order is stable while the program runs but it is not alphabetical
+		TIKI_FORCE_INLINE bool			operator<( const StringId& rhs ) const { return m_pEntry < rhs.m_pEntry; }
+		TIKI_FORCE_INLINE bool			operator>( const StringId& rhs ) const { return m_pEntry > rhs.m_pEntry; }
+
+		// returns an empty id when the string was never interned. doesn't add it to the table.
+		static StringId					find( const char* pString );
+
+		static uint						getInternedCount();
+
+	private:
+
+		const Entry*					m_pEntry;
+
+		void							intern( const char* pString, uint length );
+
+	};
+}
+
+#endif // TIKI_STRINGID_HPP_INCLUDED
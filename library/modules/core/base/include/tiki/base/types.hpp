@@ -90,6 +90,7 @@ namespace tiki
 #define TIKI_DEFAULT_ALIGNMENT			0u
 #define TIKI_INVALID_CRC32				0xffffffffu
 #define TIKI_MAX_PATH					512u
+#define TIKI_CACHE_LINE_SIZE			64u
 #define TIKI_TIME_OUT_INFINITY			0x7fffffffffffffff
 
 #define TIKI_CONCAT( x1, x2 )			TIKI_CONCAT_HELPER( x1, x2 )
@@ -181,6 +182,21 @@ namespace tiki
 
 #endif
 
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+#	define TIKI_THREAD_LOCAL				__declspec( thread )
+#elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+#	define TIKI_THREAD_LOCAL				__thread
+#else
+#	error Platform not implemented
+#endif
+
+// visual studio supports constexpr since 2015. with older compilers the functions are evaluated at runtime.
+#if TIKI_ENABLED( TIKI_BUILD_MSVC ) && _MSC_VER < 1900
+#	define TIKI_CONSTEXPR
+#else
+#	define TIKI_CONSTEXPR					constexpr
+#endif
+
 #define TIKI_NONCOPYABLE_CLASS( class_name )		\
 	private:										\
 		class_name ( const class_name & );			\
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef TIKI_VIRTUALMEMORYALLOCATOR_HPP_INCLUDED
+#define TIKI_VIRTUALMEMORYALLOCATOR_HPP_INCLUDED
+
+#include "tiki/base/allocator.hpp"
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	// reserves an address range and commits pages when the allocation grows. the allocation never moves, so a
+	// List or Map on top of it grows without copying and keeps the element addresses stable. there can only be one
+	// allocation at a time, so every container needs an own allocator.
+	class VirtualMemoryAllocator : public Allocator
+	{
+		TIKI_NONCOPYABLE_CLASS( VirtualMemoryAllocator );
+
+	public:
+
+							VirtualMemoryAllocator();
+		virtual				~VirtualMemoryAllocator();
+
+		// only address space is reserved. physical memory is used for committed pages only.
+		bool				create( uint reservedSizeInBytes );
+		void				dispose();
+
+		bool				isCreated() const { return m_pBase != nullptr; }
+
+		// alignment up to the page size
+		virtual void*		allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT ) TIKI_OVERRIDE;
+		virtual void		free( void* pMemory ) TIKI_OVERRIDE;
+		// fails when the new size doesn't fit into the reserved range
+		virtual bool		resize( void* pMemory, uint newSizeInBytes ) TIKI_OVERRIDE;
+		virtual bool		isSingleAllocation() const TIKI_OVERRIDE { return true; }
+
+		uint				getReservedSize() const { return m_reservedSize; }
+		uint				getCommittedSize() const { return m_committedSize; }
+
+	private:
+
+		uint8*				m_pBase;
+		uint				m_reservedSize;
+		uint				m_committedSize;
+		uint				m_pageSize;
+
+		bool				m_isAllocated;
+
+		bool				commitSize( uint sizeInBytes );
+
+	};
+}
+
+#endif // TIKI_VIRTUALMEMORYALLOCATOR_HPP_INCLUDED
@@ -2,40 +2,119 @@
 #ifndef __TIKI_ZONEALLOCATOR_HPP_INCLUDED__
 #define __TIKI_ZONEALLOCATOR_HPP_INCLUDED__
 
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/memory.hpp"
 #include "tiki/base/types.hpp"
 
 namespace tiki
 {
-	class ZoneAllocator
+	struct ZoneAllocatorPage;
+
+	// bump allocator which chains a new page when the current page is full. everything allocated after a marker is
+	// released with freeToMarker. clear merges all pages into a single page, so a zone which grew once doesn't need to
+	// chain pages again.
+	class ZoneAllocator : public Allocator
 	{
 		TIKI_NONCOPYABLE_CLASS( ZoneAllocator );
 
 	public:
 
-		ZoneAllocator();
-		~ZoneAllocator();
+		struct Marker
+		{
+			ZoneAllocatorPage*	pPage;
+			uint8*				pCurrent;
+		};
+
+							ZoneAllocator();
+		virtual				~ZoneAllocator();
+
+		bool				create( uint pageSizeInBytes, uint alignment = TIKI_MINIMUM_ALIGNMENT );
+		void				dispose();
+
+		bool				isCreated() const { return m_pFirstPage != nullptr; }
+
+		virtual void*		allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT ) TIKI_OVERRIDE;
+		// only the last allocation can be released
+		virtual void		free( void* pMemory ) TIKI_OVERRIDE;
+
+		template< typename T >
+		T*					allocateArray( uint count ) { return static_cast< T* >( allocate( sizeof( T ) * count, TIKI_ALIGNOF( T ) ) ); }
+
+		Marker				getMarker() const;
+		void				freeToMarker( const Marker& marker );
+
+		void				clear();
+
+		uint				getCurrentAllocationSize() const;
+		uint				getCapacity() const;
+		uint				getPageCount() const;
+
+	private:
+
+		ZoneAllocatorPage*	m_pFirstPage;
+		ZoneAllocatorPage*	m_pCurrentPage;
+		uint				m_baseAlignment;
+
+		void*				m_pPrev;
+		void*				m_pPrevBase;
+
+		uint8*				m_pCurrent;
+		uint8*				m_pEnd;
+
+		ZoneAllocatorPage*	allocatePage( uint sizeInBytes );
+		void				freePage( ZoneAllocatorPage* pPage );
+
+		void				setCurrentPage( ZoneAllocatorPage* pPage, uint8* pCurrent );
+		bool				switchToNextPage( uint sizeInBytes, uint alignment );
 
-		bool		create( uint sizeInBytes, uint alignment = TIKI_MINIMUM_ALIGNMENT );
-		void		dispose();
+	};
 
-		void*		allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT );
-		void		free( void* pMemory );
+	// releases everything allocated in the scope
+	class ZoneAllocatorScope
+	{
+		TIKI_NONCOPYABLE_CLASS( ZoneAllocatorScope );
 
-		void		clear();
+	public:
 
-		uint		getCurrentAllocationSize() const { return m_pCurrent - m_pMemory; }
+		explicit			ZoneAllocatorScope( ZoneAllocator& allocator ) : m_allocator( allocator ), m_marker( allocator.getMarker() ) { }
+							~ZoneAllocatorScope() { m_allocator.freeToMarker( m_marker ); }
 
 	private:
 
-		uint8*		m_pMemory;
-		uint		m_size;
-		uint		m_baseAlignment;
+		ZoneAllocator&			m_allocator;
+		ZoneAllocator::Marker	m_marker;
+
+	};
+
+	// two zones which are used in turns. frame N+1 fills the current zone while the data of frame N in the previous
+	// zone stays valid until the next swap.
+	class DoubleBufferedZoneAllocator
+	{
+		TIKI_NONCOPYABLE_CLASS( DoubleBufferedZoneAllocator );
+
+	public:
+
+							DoubleBufferedZoneAllocator();
+							~DoubleBufferedZoneAllocator();
+
+		bool				create( uint pageSizeInBytes, uint alignment = TIKI_MINIMUM_ALIGNMENT );
+		void				dispose();
+
+		void*				allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT ) { return m_aZones[ m_currentIndex ].allocate( sizeInBytes, alignment ); }
 
-		void*		m_pPrev;
-		void*		m_pPrevBase;
+		template< typename T >
+		T*					allocateArray( uint count ) { return m_aZones[ m_currentIndex ].allocateArray< T >( count ); }
+
+		// the current zone becomes the previous one. the new current zone is cleared.
+		void				swap();
+
+		ZoneAllocator&			getCurrentZone() { return m_aZones[ m_currentIndex ]; }
+		const ZoneAllocator&	getPreviousZone() const { return m_aZones[ m_currentIndex ^ 1u ]; }
+
+	private:
 
-		uint8*		m_pCurrent;
+		ZoneAllocator		m_aZones[ 2u ];
+		uint				m_currentIndex;
 
 	};
 }
@@ -0,0 +1,74 @@
+#pragma once
+#ifndef TIKI_ALLOCATOR_INL_INCLUDED
+#define TIKI_ALLOCATOR_INL_INCLUDED
+
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	template<typename T>
+	TIKI_FORCE_INLINE T* memory::newArray( Allocator* pAllocator, uint count, uint alignment /* = TIKI_DEFAULT_ALIGNMENT */, bool constructElements /* = false */ )
+	{
+		if ( pAllocator == nullptr )
+		{
+			return TIKI_MEMORY_NEW_ARRAY_ALIGNED( T, count, alignment, constructElements );
+		}
+
+		if ( alignment == TIKI_DEFAULT_ALIGNMENT )
+		{
+			alignment = TIKI_ALIGNOF( T );
+		}
+
+		T* pArray = static_cast< T* >( pAllocator->allocate( sizeof( T ) * count, alignment ) );
+		if ( pArray != nullptr && constructElements )
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				::new( &pArray[ i ] ) T;
+			}
+		}
+
+		return pArray;
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE bool memory::growArray( Allocator* pAllocator, T* pArray, uint count, uint newCount, bool constructElements /* = false */ )
+	{
+		TIKI_ASSERT( newCount >= count );
+
+		if ( pAllocator == nullptr || !pAllocator->resize( pArray, sizeof( T ) * newCount ) )
+		{
+			return false;
+		}
+
+		if ( constructElements )
+		{
+			for (uint i = count; i < newCount; ++i)
+			{
+				::new( &pArray[ i ] ) T;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE void memory::deleteArray( Allocator* pAllocator, T* pArray, uint count )
+	{
+		if ( pAllocator == nullptr )
+		{
+			TIKI_MEMORY_DELETE_ARRAY( pArray, count );
+			return;
+		}
+
+		TIKI_ASSERT( pArray != nullptr );
+		for (uint i = 0u; i < count; ++i)
+		{
+			pArray[ i ].~T();
+		}
+
+		pAllocator->free( pArray );
+	}
+}
+
+#endif // TIKI_ALLOCATOR_INL_INCLUDED
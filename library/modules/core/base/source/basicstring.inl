@@ -10,39 +10,37 @@ namespace tiki
 {
 	TIKI_FORCE_INLINE BasicString::BasicString()
 	{
-		m_pData			= nullptr;
-		m_dataSize		= 0u;
-		m_stringSize	= 0u;
+		initializeData();
 	}
 
 	TIKI_FORCE_INLINE BasicString::BasicString( uint length )
 	{
-		m_pData = nullptr;
+		initializeData();
 
 		allocateData( length );
 		m_stringSize = length;
+		m_pData[ length ] = '\0';
 	}
 
 	TIKI_FORCE_INLINE BasicString::BasicString( const char* pString )
 	{
-		m_pData = nullptr;
+		initializeData();
 
 		allocateDataForString( pString );
 	}
 
 	TIKI_FORCE_INLINE BasicString::BasicString( const char* pString, sint length )
 	{
-		m_pData = nullptr;
+		initializeData();
 
 		allocateDataForString( pString, length );
-		m_stringSize = length;
 	}
 
 	TIKI_FORCE_INLINE BasicString::BasicString( const BasicString& copy )
 	{
-		m_pData = nullptr;
-		
-		allocateDataForString( copy.m_pData );
+		initializeData();
+
+		allocateDataForString( copy.m_pData, sint( copy.m_stringSize ) );
 	}
 
 	TIKI_FORCE_INLINE BasicString::~BasicString()
@@ -519,8 +517,23 @@ namespace tiki
 
 	TIKI_FORCE_INLINE BasicString& BasicString::operator=( const BasicString& rhs )
 	{
+		if( this == &rhs )
+		{
+			return *this;
+		}
+
+		// reuse the current buffer when the new string fits
+		if( rhs.m_stringSize < m_dataSize )
+		{
+			memory::copy( m_pData, rhs.m_pData, rhs.m_stringSize );
+			m_pData[ rhs.m_stringSize ] = '\0';
+			m_stringSize = rhs.m_stringSize;
+
+			return *this;
+		}
+
 		freeData();
-		allocateDataForString( rhs.m_pData );
+		allocateDataForString( rhs.m_pData, sint( rhs.m_stringSize ) );
 
 		return *this;
 	}
@@ -593,27 +606,43 @@ namespace tiki
 		return string( str1 ) + str2;
 	}
 
+	TIKI_FORCE_INLINE void BasicString::initializeData()
+	{
+		m_pData				= m_aLocalData;
+		m_dataSize			= LocalDataSize;
+		m_stringSize		= 0u;
+		m_aLocalData[ 0u ]	= '\0';
+	}
+
 	TIKI_FORCE_INLINE void BasicString::allocateData( sint length )
 	{
-		TIKI_ASSERT( m_pData == nullptr );
+		TIKI_ASSERT( isLocalData() );
+
+		m_stringSize = 0u;
 
-		m_dataSize		= calculateLength( length );
-		m_stringSize	= 0u;
+		if( uint( length ) < LocalDataSize )
+		{
+			return;
+		}
 
-		m_pData			= (char*)TIKI_MEMORY_ALLOC( m_dataSize );
+		m_dataSize	= calculateLength( length );
+		m_pData		= (char*)TIKI_MEMORY_ALLOC( m_dataSize );
 	}
-	
+
 	TIKI_FORCE_INLINE void BasicString::reallocateData( sint length )
 	{
 		char* pOldData = m_pData;
-		
+
 		m_dataSize	= calculateLength( length );
 		m_pData		= (char*)TIKI_MEMORY_ALLOC( m_dataSize );
 
 		memory::copy( m_pData, pOldData, m_stringSize );
 		m_pData[ m_stringSize ] = '\0';
 
-		TIKI_MEMORY_FREE( pOldData );
+		if( pOldData != m_aLocalData )
+		{
+			TIKI_MEMORY_FREE( pOldData );
+		}
 	}
 
 	TIKI_FORCE_INLINE void BasicString::allocateDataForString( const char* pString, sint length /* = -1 */ )
@@ -624,13 +653,21 @@ namespace tiki
 		}
 		else
 		{
-			uint stringSize = getStringSize( pString );
-			stringSize = TIKI_MIN( stringSize, (uint)length );
-			TIKI_ASSERT( length == -1 || stringSize <= (uint)length );
-
-			const uint dataSize = (length == -1 ? stringSize : (uint)length);
+			uint stringSize = 0u;
+			if( length == -1 )
+			{
+				stringSize = getStringSize( pString );
+			}
+			else
+			{
+				// only scan the given range
+				while( stringSize < (uint)length && pString[ stringSize ] != '\0' )
+				{
+					stringSize++;
+				}
+			}
 
-			allocateData( dataSize );
+			allocateData( stringSize );
 			memory::copy( m_pData, pString, stringSize );
 			m_pData[ stringSize ] = '\0';
 
@@ -640,10 +677,12 @@ namespace tiki
 
 	TIKI_FORCE_INLINE void BasicString::freeData()
 	{
-		TIKI_MEMORY_FREE( m_pData );
-		m_pData			= nullptr;
-		m_dataSize		= 0u;
-		m_stringSize	= 0u;
+		if( !isLocalData() )
+		{
+			TIKI_MEMORY_FREE( m_pData );
+		}
+
+		initializeData();
 	}
 
 	TIKI_FORCE_INLINE uint BasicString::calculateLength( uint neededLength ) const
@@ -0,0 +1,362 @@
+
+#include "tiki/base/engineallocator.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+
+#include "engineallocator_internal.hpp"
+#include "spinlock_internal.hpp"
+
+namespace tiki
+{
+	enum
+	{
+		EngineAllocatorSlabSize				= 256u * 1024u,
+		EngineAllocatorSlabHeaderSize		= 64u,
+		EngineAllocatorSystemGranularity	= 64u * 1024u,
+
+		EngineAllocatorMinObjectSize		= 16u,
+		EngineAllocatorMaxObjectSize		= 32u * 1024u,
+
+		// 16 byte steps up to 128 bytes and four steps per power of two above
+		EngineAllocatorSizeClassCount		= 40u,
+		EngineAllocatorLargeSizeClass		= 0xffffffffu,
+
+		// freed large blocks are kept to avoid mapping the same sizes again and again
+		EngineAllocatorLargeCacheCount		= 32u,
+		EngineAllocatorLargeCacheMaxSize	= 4u * 1024u * 1024u
+	};
+
+	// lies at the start of every slab and every large block. all blocks are aligned to the slab size.
+	struct EngineAllocatorBlockHeader
+	{
+		uint32	sizeClass;
+		uint32	objectSize;
+		uint	mappedSize;
+	};
+
+	struct EngineAllocatorFreeObject
+	{
+		EngineAllocatorFreeObject*	pNext;
+	};
+
+	struct EngineAllocatorSizeClass
+	{
+		volatile uint32				lock;
+		EngineAllocatorFreeObject*	pFreeList;
+
+		uint8*						pSlabCurrent;
+		uint8*						pSlabEnd;
+
+		uint8						padding[ TIKI_CACHE_LINE_SIZE - sizeof( uint32 ) - 3u * sizeof( void* ) ];
+	};
+
+	struct EngineAllocatorThreadCache
+	{
+		EngineAllocatorFreeObject*	apFreeLists[ EngineAllocatorSizeClassCount ];
+		uint32						aCounts[ EngineAllocatorSizeClassCount ];
+	};
+
+	struct EngineAllocatorLargeCache
+	{
+		volatile uint32		lock;
+		uint				blockCount;
+		void*				apBlocks[ EngineAllocatorLargeCacheCount ];
+		uint				aBlockSizes[ EngineAllocatorLargeCacheCount ];
+	};
+
+	static EngineAllocatorSizeClass						s_aEngineAllocatorSizeClasses[ EngineAllocatorSizeClassCount ];
+	static EngineAllocatorLargeCache					s_engineAllocatorLargeCache;
+	static TIKI_THREAD_LOCAL EngineAllocatorThreadCache	s_engineAllocatorThreadCache;
+
+	static TIKI_FORCE_INLINE uint getEngineAllocatorSizeClass( uint sizeInBytes )
+	{
+		const uint size = TIKI_MAX( sizeInBytes, 1u ) - 1u;
+		if ( size < 128u )
+		{
+			return size >> 4u;
+		}
+
+		const uint shift = 63u - countLeadingZeros64( size );
+		return 8u + ( ( shift - 7u ) << 2u ) + ( ( size - ( uint( 1u ) << shift ) ) >> ( shift - 2u ) );
+	}
+
+	static TIKI_FORCE_INLINE uint getEngineAllocatorObjectSize( uint sizeClass )
+	{
+		if ( sizeClass < 8u )
+		{
+			return ( sizeClass + 1u ) * EngineAllocatorMinObjectSize;
+		}
+
+		const uint rangeSize = 128u << ( ( sizeClass - 8u ) >> 2u );
+		return rangeSize + ( ( ( sizeClass - 8u ) & 3u ) + 1u ) * ( rangeSize >> 2u );
+	}
+
+	static TIKI_FORCE_INLINE uint getEngineAllocatorBatchSize( uint objectSize )
+	{
+		return clamp( 16u * 1024u / objectSize, 4u, 64u );
+	}
+
+	static EngineAllocatorBlockHeader* getEngineAllocatorBlockHeader( const void* pMemory )
+	{
+		return (EngineAllocatorBlockHeader*)( uint( pMemory ) & ~uint( EngineAllocatorSlabSize - 1u ) );
+	}
+
+	// takes up to one batch from the shared free list and carves the rest from the current slab
+	static bool refillEngineAllocatorThreadCache( EngineAllocatorThreadCache& cache, uint sizeClassIndex, uint objectSize )
+	{
+		EngineAllocatorSizeClass& sizeClass = s_aEngineAllocatorSizeClasses[ sizeClassIndex ];
+		const uint batchSize = getEngineAllocatorBatchSize( objectSize );
+
+		EngineAllocatorFreeObject* pList = cache.apFreeLists[ sizeClassIndex ];
+		uint count = 0u;
+
+		spinlock::lock( sizeClass.lock );
+		while ( count < batchSize && sizeClass.pFreeList != nullptr )
+		{
+			EngineAllocatorFreeObject* pObject = sizeClass.pFreeList;
+			sizeClass.pFreeList = pObject->pNext;
+
+			pObject->pNext = pList;
+			pList = pObject;
+			count++;
+		}
+
+		while ( count < batchSize )
+		{
+			if ( sizeClass.pSlabCurrent + objectSize > sizeClass.pSlabEnd )
+			{
+				if ( count > 0u )
+				{
+					break;
+				}
+
+				uint8* pSlab = static_cast< uint8* >( engineallocator::allocateSystemMemory( EngineAllocatorSlabSize, EngineAllocatorSlabSize ) );
+				if ( pSlab == nullptr )
+				{
+					break;
+				}
+
+				EngineAllocatorBlockHeader* pHeader = reinterpret_cast< EngineAllocatorBlockHeader* >( pSlab );
+				pHeader->sizeClass	= uint32( sizeClassIndex );
+				pHeader->objectSize	= uint32( objectSize );
+				pHeader->mappedSize	= EngineAllocatorSlabSize;
+
+				sizeClass.pSlabCurrent	= pSlab + EngineAllocatorSlabHeaderSize;
+				sizeClass.pSlabEnd		= pSlab + EngineAllocatorSlabSize;
+			}
+
+			EngineAllocatorFreeObject* pObject = reinterpret_cast< EngineAllocatorFreeObject* >( sizeClass.pSlabCurrent );
+			sizeClass.pSlabCurrent += objectSize;
+
+			pObject->pNext = pList;
+			pList = pObject;
+			count++;
+		}
+		spinlock::unlock( sizeClass.lock );
+
+		cache.apFreeLists[ sizeClassIndex ] = pList;
+		cache.aCounts[ sizeClassIndex ] += uint32( count );
+
+		return count > 0u;
+	}
+
+	static void releaseEngineAllocatorObjects( uint sizeClassIndex, EngineAllocatorFreeObject* pFirst, EngineAllocatorFreeObject* pLast )
+	{
+		EngineAllocatorSizeClass& sizeClass = s_aEngineAllocatorSizeClasses[ sizeClassIndex ];
+
+		spinlock::lock( sizeClass.lock );
+		pLast->pNext = sizeClass.pFreeList;
+		sizeClass.pFreeList = pFirst;
+		spinlock::unlock( sizeClass.lock );
+	}
+
+	// returns the smallest cached block which doesn't waste more than a quarter
+	static uint8* popEngineAllocatorLargeBlock( uint& mappedSize )
+	{
+		EngineAllocatorLargeCache& cache = s_engineAllocatorLargeCache;
+
+		uint8* pBlock = nullptr;
+		spinlock::lock( cache.lock );
+		uint bestIndex = TIKI_SIZE_T_MAX;
+		for (uint i = 0u; i < cache.blockCount; ++i)
+		{
+			const uint blockSize = cache.aBlockSizes[ i ];
+			if ( blockSize >= mappedSize && blockSize <= mappedSize + mappedSize / 4u &&
+				( bestIndex == TIKI_SIZE_T_MAX || blockSize < cache.aBlockSizes[ bestIndex ] ) )
+			{
+				bestIndex = i;
+			}
+		}
+
+		if ( bestIndex != TIKI_SIZE_T_MAX )
+		{
+			pBlock		= static_cast< uint8* >( cache.apBlocks[ bestIndex ] );
+			mappedSize	= cache.aBlockSizes[ bestIndex ];
+
+			cache.blockCount--;
+			cache.apBlocks[ bestIndex ]		= cache.apBlocks[ cache.blockCount ];
+			cache.aBlockSizes[ bestIndex ]	= cache.aBlockSizes[ cache.blockCount ];
+		}
+		spinlock::unlock( cache.lock );
+
+		return pBlock;
+	}
+
+	static bool pushEngineAllocatorLargeBlock( void* pBlock, uint mappedSize )
+	{
+		if ( mappedSize > EngineAllocatorLargeCacheMaxSize )
+		{
+			return false;
+		}
+
+		EngineAllocatorLargeCache& cache = s_engineAllocatorLargeCache;
+
+		bool result = false;
+		spinlock::lock( cache.lock );
+		if ( cache.blockCount < EngineAllocatorLargeCacheCount )
+		{
+			cache.apBlocks[ cache.blockCount ]		= pBlock;
+			cache.aBlockSizes[ cache.blockCount ]	= mappedSize;
+			cache.blockCount++;
+
+			result = true;
+		}
+		spinlock::unlock( cache.lock );
+
+		return result;
+	}
+
+	static void* allocateEngineAllocatorLargeBlock( uint sizeInBytes, uint alignment )
+	{
+		// the header has to stay in the first slab sized range to be found again
+		TIKI_ASSERT( alignment <= EngineAllocatorSlabSize / 2u );
+
+		const uint offset	= TIKI_MAX( (uint)EngineAllocatorSlabHeaderSize, alignment );
+		uint mappedSize		= alignValue( sizeInBytes + offset, (uint)EngineAllocatorSystemGranularity );
+
+		uint8* pBlock = popEngineAllocatorLargeBlock( mappedSize );
+		if ( pBlock == nullptr )
+		{
+			pBlock = static_cast< uint8* >( engineallocator::allocateSystemMemory( mappedSize, EngineAllocatorSlabSize ) );
+			if ( pBlock == nullptr )
+			{
+				return nullptr;
+			}
+		}
+
+		EngineAllocatorBlockHeader* pHeader = reinterpret_cast< EngineAllocatorBlockHeader* >( pBlock );
+		pHeader->sizeClass	= EngineAllocatorLargeSizeClass;
+		pHeader->objectSize	= 0u;
+		pHeader->mappedSize	= mappedSize;
+
+		return pBlock + offset;
+	}
+
+	void* engineallocator::allocate( uint sizeInBytes, uint alignment )
+	{
+		// objects are aligned to 16 bytes. higher alignments reserve space to align inside of the object.
+		const uint requiredSize = ( alignment <= EngineAllocatorMinObjectSize ? sizeInBytes : sizeInBytes + alignment - EngineAllocatorMinObjectSize );
+		if ( requiredSize > EngineAllocatorMaxObjectSize )
+		{
+			return allocateEngineAllocatorLargeBlock( sizeInBytes, alignment );
+		}
+
+		const uint sizeClassIndex = getEngineAllocatorSizeClass( requiredSize );
+
+		EngineAllocatorThreadCache& cache = s_engineAllocatorThreadCache;
+		EngineAllocatorFreeObject* pObject = cache.apFreeLists[ sizeClassIndex ];
+		if ( pObject == nullptr )
+		{
+			if ( !refillEngineAllocatorThreadCache( cache, sizeClassIndex, getEngineAllocatorObjectSize( sizeClassIndex ) ) )
+			{
+				return nullptr;
+			}
+
+			pObject = cache.apFreeLists[ sizeClassIndex ];
+		}
+
+		cache.apFreeLists[ sizeClassIndex ] = pObject->pNext;
+		cache.aCounts[ sizeClassIndex ]--;
+
+		if ( alignment <= EngineAllocatorMinObjectSize )
+		{
+			return pObject;
+		}
+
+		return alignPointer( reinterpret_cast< uint8* >( pObject ), alignment );
+	}
+
+	void engineallocator::free( void* pMemory )
+	{
+		if ( pMemory == nullptr )
+		{
+			return;
+		}
+
+		EngineAllocatorBlockHeader* pHeader = getEngineAllocatorBlockHeader( pMemory );
+		if ( pHeader->sizeClass == EngineAllocatorLargeSizeClass )
+		{
+			if ( !pushEngineAllocatorLargeBlock( pHeader, pHeader->mappedSize ) )
+			{
+				freeSystemMemory( pHeader, pHeader->mappedSize );
+			}
+			return;
+		}
+
+		// aligned allocations point into the object
+		const uint sizeClassIndex	= pHeader->sizeClass;
+		const uint objectSize		= pHeader->objectSize;
+		uint8* pData				= reinterpret_cast< uint8* >( pHeader ) + EngineAllocatorSlabHeaderSize;
+		const uint offset			= uint( static_cast< uint8* >( pMemory ) - pData );
+
+		EngineAllocatorFreeObject* pObject = reinterpret_cast< EngineAllocatorFreeObject* >( pData + offset - ( offset % objectSize ) );
+
+		EngineAllocatorThreadCache& cache = s_engineAllocatorThreadCache;
+		pObject->pNext = cache.apFreeLists[ sizeClassIndex ];
+		cache.apFreeLists[ sizeClassIndex ] = pObject;
+		cache.aCounts[ sizeClassIndex ]++;
+
+		// give a batch back when the cache grows too large. memory freed by an other thread than the allocating one ends
+		// up here.
+		const uint batchSize = getEngineAllocatorBatchSize( objectSize );
+		if ( cache.aCounts[ sizeClassIndex ] > 2u * batchSize )
+		{
+			EngineAllocatorFreeObject* pFirst = cache.apFreeLists[ sizeClassIndex ];
+			EngineAllocatorFreeObject* pLast = pFirst;
+			for (uint i = 1u; i < batchSize; ++i)
+			{
+				pLast = pLast->pNext;
+			}
+
+			cache.apFreeLists[ sizeClassIndex ] = pLast->pNext;
+			cache.aCounts[ sizeClassIndex ] -= uint32( batchSize );
+
+			releaseEngineAllocatorObjects( sizeClassIndex, pFirst, pLast );
+		}
+	}
+
+	void engineallocator::flushThreadCache()
+	{
+		EngineAllocatorThreadCache& cache = s_engineAllocatorThreadCache;
+		for (uint i = 0u; i < EngineAllocatorSizeClassCount; ++i)
+		{
+			EngineAllocatorFreeObject* pFirst = cache.apFreeLists[ i ];
+			if ( pFirst == nullptr )
+			{
+				continue;
+			}
+
+			EngineAllocatorFreeObject* pLast = pFirst;
+			while ( pLast->pNext != nullptr )
+			{
+				pLast = pLast->pNext;
+			}
+
+			releaseEngineAllocatorObjects( i, pFirst, pLast );
+
+			cache.apFreeLists[ i ]	= nullptr;
+			cache.aCounts[ i ]		= 0u;
+		}
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+#ifndef TIKI_ENGINEALLOCATOR_INTERNAL_HPP_INCLUDED__
+#define TIKI_ENGINEALLOCATOR_INTERNAL_HPP_INCLUDED__
+
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	namespace engineallocator
+	{
+		// size must be a multiple of 64 kb. alignment must be a power of two.
+		void*	allocateSystemMemory( uint sizeInBytes, uint alignment );
+		void	freeSystemMemory( void* pMemory, uint sizeInBytes );
+
+		void	yieldThread();
+	}
+}
+
+#endif // TIKI_ENGINEALLOCATOR_INTERNAL_HPP_INCLUDED__
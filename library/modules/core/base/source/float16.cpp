@@ -10,63 +10,79 @@ namespace tiki
 		uint32 ui;
 	};
 
-	static int const shift = 13;
-	static int const shiftSign = 16;
+	static const uint32 signN		= 0x80000000u;	// flt32 sign bit
+	static const uint32 infN		= 0x7f800000u;	// flt32 infinity
+	static const uint32 overflowN	= 0x47800000u;	// 2^16, everything above rounds to flt16 infinity
+	static const uint32 minN		= 0x38800000u;	// min flt16 normal as a flt32
 
-	static const sint32 infN = 0x7F800000; // flt32 infinity
-	static const sint32 maxN = 0x477FE000; // max flt16 normal as a flt32
-	static const sint32 minN = 0x38800000; // min flt16 normal as a flt32
-	static const sint32 signN = 0x80000000; // flt32 sign bit
+	static const uint32 denormN		= 0x3f000000u;	// 0.5, adding it moves the flt16 subnormal bits to the bottom
+	static const uint32 rebiasN		= 0xc8000fffu;	// ( 15 - 127 ) << 23 plus the rounding bias without the odd bit
 
-	static const sint32 infC = infN >> shift;
-	static const sint32 nanN = (infC + 1) << shift; // minimum flt16 nan as a flt32
-	static const sint32 maxC = maxN >> shift;
-	static const sint32 minC = minN >> shift;
-	static const sint32 signC = signN >> shiftSign; // flt16 sign bit
-
-	static const sint32 mulN = 0x52000000; // (1 << 23) / minN
-	static const sint32 mulC = 0x33800000; // minN / (1 << (23 - shift))
-
-	static const sint32 subC = 0x003FF; // max flt32 subnormal down shifted
-	static const sint32 norC = 0x00400; // min flt32 normal down shifted
-
-	static const sint32 maxD = infC - maxC - 1;
-	static const sint32 minD = minC - subC - 1;
+	static const uint32 infC		= 0x7c00u;		// flt16 infinity
+	static const uint32 quietC		= 0x0200u;		// flt16 quiet nan bit
 
 	float16 f16::convertFloat32to16( float value )
 	{
-		Bits v, s;
+		Bits v;
 		v.f = value;
-		uint32 sign = v.si & signN;
-		v.si ^= sign;
-		sign >>= shiftSign; // logical shift
-		s.si = mulN;
-		s.si = (sint32)( s.f * v.f ); // correct subnormals
-		v.si ^= (s.si ^ v.si) & -(minN > v.si);
-		v.si ^= (infN ^ v.si) & -((infN > v.si) & (v.si > maxN));
-		v.si ^= (nanN ^ v.si) & -((nanN > v.si) & (v.si > infN));
-		v.ui >>= shift; // logical shift
-		v.si ^= ((v.si - maxD) ^ v.si) & -(v.si > maxC);
-		v.si ^= ((v.si - minD) ^ v.si) & -(v.si > subC);
-		return v.ui | sign;
+		const uint32 sign = v.ui & signN;
+		v.ui ^= sign;
+
+		uint32 result;
+		if ( v.ui >= overflowN )
+		{
+			// nan keeps the upper payload bits and gets quiet like f16c does it
+			result = infC;
+			if ( v.ui > infN )
+			{
+				result |= quietC | ( ( v.ui >> 13u ) & 0x3ffu );
+			}
+		}
+		else if ( v.ui < minN )
+		{
+			// the float addition rounds to nearest even at the flt16 subnormal precision
+			Bits denorm;
+			denorm.ui = denormN;
+			v.f += denorm.f;
+			result = v.ui - denormN;
+		}
+		else
+		{
+			// round to nearest even, a carry out of the mantissa increments the exponent
+			const uint32 mantissaOdd = ( v.ui >> 13u ) & 1u;
+			v.ui += rebiasN + mantissaOdd;
+			result = v.ui >> 13u;
+		}
+
+		return float16( result | ( sign >> 16u ) );
 	}
 
 	float f16::convertFloat16to32( float16 value )
 	{
 		Bits v;
-		v.ui = value;
-		sint32 sign = v.si & signC;
-		v.si ^= sign;
-		sign <<= shiftSign;
-		v.si ^= ((v.si + minD) ^ v.si) & -(v.si > subC);
-		v.si ^= ((v.si + maxD) ^ v.si) & -(v.si > maxC);
-		Bits s;
-		s.si = mulC;
-		s.f *= v.si;
-		sint32 mask = -(norC > v.si);
-		v.si <<= shift;
-		v.si ^= (s.si ^ v.si) & mask;
-		v.si |= sign;
+		v.ui = uint32( value & 0x7fffu ) << 13u;
+
+		const uint32 exponent = v.ui & ( infC << 13u );
+		v.ui += ( 127u - 15u ) << 23u;
+		if ( exponent == ( infC << 13u ) )
+		{
+			// infinity and nan, nan gets quiet like f16c does it
+			v.ui += ( 128u - 16u ) << 23u;
+			if ( v.ui & 0x007fffffu )
+			{
+				v.ui |= 0x00400000u;
+			}
+		}
+		else if ( exponent == 0u )
+		{
+			// zero and subnormals are normalized by a float subtraction
+			Bits magic;
+			magic.ui = 113u << 23u;
+			v.ui += 1u << 23u;
+			v.f -= magic.f;
+		}
+
+		v.ui |= uint32( value & 0x8000u ) << 16u;
 		return v.f;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,159 @@
+#pragma once
+#ifndef TIKI_FLOAT32_INL_INCLUDED
+#define TIKI_FLOAT32_INL_INCLUDED
+
+namespace tiki
+{
+	// the coefficients are the minimax polynomials from cephes. the simd kernels use the same reductions and
+	// constants.
+	union Float32Bits
+	{
+		float	f;
+		sint32	i;
+		uint32	u;
+	};
+
+	TIKI_FORCE_INLINE float f32::approximatedSin( float x )
+	{
+		float sinValue;
+		float cosValue;
+		approximatedSinCos( sinValue, cosValue, x );
+		return sinValue;
+	}
+
+	TIKI_FORCE_INLINE float f32::approximatedCos( float x )
+	{
+		float sinValue;
+		float cosValue;
+		approximatedSinCos( sinValue, cosValue, x );
+		return cosValue;
+	}
+
+	TIKI_FORCE_INLINE void f32::approximatedSinCos( float& sinValue, float& cosValue, float x )
+	{
+		// reduce to [-pi/4, pi/4] with pi/4 split in three parts, so the subtraction is exact for |x| <= 8192. the
+		// octant is clamped before the conversion, so inf, nan and huge inputs give garbage or nan but are defined.
+		const float absX		= f32::abs( x );
+		const float scaledX		= absX * 1.27323954473516f;
+		const uint32 octant		= ( uint32( scaledX < 16777216.0f ? scaledX : 16777216.0f ) + 1u ) & ~1u;
+		const float y			= float( octant );
+		const float r			= ( ( absX - y * 0.78515625f ) - y * 2.4187564849853515625e-4f ) - y * 3.77489497744594108e-8f;
+		const float r2			= r * r;
+
+		const float polySin	= r + r * r2 * ( -1.6666654611e-1f + r2 * ( 8.3321608736e-3f + r2 * -1.9515295891e-4f ) );
+		const float polyCos	= 1.0f - 0.5f * r2 + r2 * r2 * ( 4.166664568298827e-2f + r2 * ( -1.388731625493765e-3f + r2 * 2.443315711809948e-5f ) );
+
+		// quadrant 0: sin, cos 1: cos, -sin 2: -sin, -cos 3: -cos, sin. without branches, the quadrants are random
+		// for most inputs.
+		const uint32 swapMask	= 0u - ( ( octant >> 1u ) & 1u );
+		Float32Bits sinBits;
+		Float32Bits cosBits;
+		Float32Bits xBits;
+		sinBits.f	= polySin;
+		cosBits.f	= polyCos;
+		xBits.f		= x;
+
+		const uint32 swapBits = ( sinBits.u ^ cosBits.u ) & swapMask;
+		sinBits.u ^= swapBits ^ ( ( octant & 4u ) << 29u ) ^ ( xBits.u & 0x80000000u );
+		cosBits.u ^= swapBits ^ ( ( ( octant + 2u ) & 4u ) << 29u );
+
+		sinValue = sinBits.f;
+		cosValue = cosBits.f;
+	}
+
+	TIKI_FORCE_INLINE float f32::approximatedAtan2( float y, float x )
+	{
+		const float absX	= f32::abs( x );
+		const float absY	= f32::abs( y );
+		const float minXY	= absY < absX ? absY : absX;
+		const float maxXY	= absY < absX ? absX : absY;
+
+		// atan( t ) for t in [0, 1], reduced to [-tan( pi/8 ), tan( pi/8 )] with atan( t ) = pi/4 + atan( ( t - 1 ) / ( t + 1 ) )
+		float t = ( maxXY > 0.0f ? minXY / maxXY : 0.0f );
+		float offset = 0.0f;
+		if( t > 0.4142135623730950f )
+		{
+			t		= ( t - 1.0f ) / ( t + 1.0f );
+			offset	= f32::piOver4;
+		}
+
+		const float t2 = t * t;
+		float result = offset + t + t * t2 * ( -3.33329491539e-1f + t2 * ( 1.99777106478e-1f + t2 * ( -1.38776856032e-1f + t2 * 8.05374449538e-2f ) ) );
+
+		if( absY > absX )
+		{
+			result = f32::piOver2 - result;
+		}
+		if( x < 0.0f )
+		{
+			result = f32::pi - result;
+		}
+
+		return y < 0.0f ? -result : result;
+	}
+
+	TIKI_FORCE_INLINE float f32::approximatedExp( float x )
+	{
+		x = f32::clamp( x, -87.33654f, 88.37626f );
+
+		// exp( x ) = 2^n * exp( r ) with n = round( x / ln2 ) and r in [-ln2/2, ln2/2]
+		const float fn	= x * 1.44269504088896341f + 0.5f;
+		sint32 n		= sint32( fn );
+		n -= ( float( n ) > fn );
+
+		const float y	= float( n );
+		const float r	= ( x - y * 0.693359375f ) - y * -2.12194440e-4f;
+		const float r2	= r * r;
+
+		const float poly = 1.0f + r + r2 * ( 5.0000001201e-1f + r * ( 1.6666665459e-1f + r * ( 4.1665795894e-2f + r * ( 8.3334519073e-3f + r * ( 1.3981999507e-3f + r * 1.9875691500e-4f ) ) ) ) );
+
+		Float32Bits scale;
+		scale.i = ( n + 127 ) << 23;
+		return poly * scale.f;
+	}
+
+	TIKI_FORCE_INLINE float f32::approximatedLog( float x )
+	{
+		// x = m * 2^e with m in [sqrt( 0.5 ), sqrt( 2 )]
+		Float32Bits bits;
+		bits.f = x;
+
+		sint32 exponent	= ( ( bits.i >> 23 ) & 0xff ) - 126;
+		bits.i			= ( bits.i & 0x007fffff ) | 0x3f000000;
+
+		float m = bits.f;
+		if( m < 0.707106781186547524f )
+		{
+			exponent--;
+			m = m + m - 1.0f;
+		}
+		else
+		{
+			m = m - 1.0f;
+		}
+
+		const float e	= float( exponent );
+		const float m2	= m * m;
+
+		float result = m * m2 * ( 3.3333331174e-1f + m * ( -2.4999993993e-1f + m * ( 2.0000714765e-1f + m * ( -1.6668057665e-1f + m * ( 1.4249322787e-1f + m * ( -1.2420140846e-1f + m * ( 1.1676998740e-1f + m * ( -1.1514610310e-1f + m * 7.0376836292e-2f ) ) ) ) ) ) ) );
+		result += e * -2.12194440e-4f;
+		result -= 0.5f * m2;
+		return m + result + e * 0.693359375f;
+	}
+
+	TIKI_FORCE_INLINE float f32::approximatedInverseSquareRoot( float x )
+	{
+		const float halfX = x * 0.5f;
+
+		Float32Bits bits;
+		bits.f = x;
+		bits.i = 0x5f375a86 - ( bits.i >> 1 );
+
+		float y = bits.f;
+		y = y * ( 1.5f - halfX * y * y );
+		y = y * ( 1.5f - halfX * y * y );
+		return y;
+	}
+}
+
+#endif // TIKI_FLOAT32_INL_INCLUDED
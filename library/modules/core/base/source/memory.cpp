@@ -1,11 +1,16 @@
 
 #include "tiki/base/memory.hpp"
 
+#include "tiki/base/engineallocator.hpp"
+#include "tiki/base/functions.hpp"
+
 #include <malloc.h>
 
 #if TIKI_ENABLED( TIKI_BUILD_MSVC )
 #	include <memory.h>
+#	include <intrin.h>
 #elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+#	include <stdlib.h>
 #	include <string.h>
 #endif
 
@@ -15,6 +20,118 @@
 
 namespace tiki
 {
+	enum
+	{
+		// malloc returns memory with this alignment. everything above needs posix_memalign.
+		MemorySystemAlignment = 2u * TIKI_SIZE_T_BYTES
+	};
+
+	static const char* s_apMemoryTagNames[] =
+	{
+		"Default",
+		"TaskSystem",
+		"Resource",
+		"Graphics",
+		"Entity",
+		"Converter"
+	};
+	TIKI_COMPILETIME_ASSERT( TIKI_COUNT( s_apMemoryTagNames ) == MemoryTag_Count );
+
+	static TIKI_THREAD_LOCAL MemoryTag s_currentMemoryTag = MemoryTag_Default;
+
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+	// lies directly in front of every allocation
+	struct MemoryAllocationHeader
+	{
+		uint64	sizeInBytes;
+		uint32	offset;
+		uint32	tag;
+	};
+
+	struct MemoryTagState
+	{
+		volatile uint64	liveSizeInBytes;
+		volatile uint64	liveAllocationCount;
+		volatile uint64	peakSizeInBytes;
+		volatile uint64	totalAllocationCount;
+		volatile uint64	overAlignedAllocationCount;
+		volatile uint64	budgetInBytes;
+	};
+
+	static MemoryTagState s_aMemoryTagStates[ MemoryTag_Count ];
+
+	static TIKI_FORCE_INLINE uint64 memoryAtomicAdd( volatile uint64* pValue, uint64 value )
+	{
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+		return uint64( _InterlockedExchangeAdd64( (volatile __int64*)pValue, (__int64)value ) ) + value;
+#else
+		return __atomic_add_fetch( pValue, value, __ATOMIC_RELAXED );
+#endif
+	}
+
+	static TIKI_FORCE_INLINE void memoryAtomicMax( volatile uint64* pValue, uint64 value )
+	{
+		uint64 currentValue = *pValue;
+		while ( currentValue < value )
+		{
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+			const uint64 previousValue = uint64( _InterlockedCompareExchange64( (volatile __int64*)pValue, (__int64)value, (__int64)currentValue ) );
+			if ( previousValue == currentValue )
+			{
+				break;
+			}
+			currentValue = previousValue;
+#else
+			if ( __atomic_compare_exchange_n( pValue, &currentValue, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+			{
+				break;
+			}
+#endif
+		}
+	}
+
+	static void trackAllocation( MemoryTag tag, uint64 sizeInBytes, uint alignment )
+	{
+		MemoryTagState& state = s_aMemoryTagStates[ tag ];
+
+		const uint64 liveSize = memoryAtomicAdd( &state.liveSizeInBytes, sizeInBytes );
+		memoryAtomicAdd( &state.liveAllocationCount, 1u );
+		memoryAtomicAdd( &state.totalAllocationCount, 1u );
+		memoryAtomicMax( &state.peakSizeInBytes, liveSize );
+
+		if ( alignment > MemorySystemAlignment )
+		{
+			memoryAtomicAdd( &state.overAlignedAllocationCount, 1u );
+		}
+
+		// only the allocation which crosses the budget reports it
+		const uint64 budget = state.budgetInBytes;
+		if ( budget != 0u && liveSize > budget && liveSize - sizeInBytes <= budget )
+		{
+			TIKI_TRACE_WARNING( "[memory] Tag '%s' exceeds its budget. %llu of %llu bytes in use.\n", s_apMemoryTagNames[ tag ], liveSize, budget );
+		}
+	}
+
+	static void trackFree( MemoryTag tag, uint64 sizeInBytes )
+	{
+		MemoryTagState& state = s_aMemoryTagStates[ tag ];
+
+		memoryAtomicAdd( &state.liveSizeInBytes, uint64( 0u ) - sizeInBytes );
+		memoryAtomicAdd( &state.liveAllocationCount, uint64( 0u ) - 1u );
+	}
+#endif
+
+	MemoryTagScope::MemoryTagScope( MemoryTag tag )
+	{
+		m_previousTag = memory::getCurrentTag();
+		memory::setCurrentTag( tag );
+	}
+
+	MemoryTagScope::~MemoryTagScope()
+	{
+		memory::setCurrentTag( m_previousTag );
+	}
+
 #if TIKI_ENABLED( TIKI_BUILD_DEBUG )
 	void* memory::allocAligned( size_t size, const char* pFileName, int lineNumber, size_t alignment /*= TIKI_MINIMUM_ALIGNMENT*/ )
 #else
@@ -22,36 +139,129 @@ namespace tiki
 #endif
 	{
 		TIKI_ASSERT( alignment != TIKI_DEFAULT_ALIGNMENT );
+		TIKI_ASSERT( isPowerOfTwo( alignment ) );
+
+		alignment = TIKI_MAX( alignment, (uint)TIKI_MINIMUM_ALIGNMENT );
 
-		void* pMemory = nullptr;
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+		const uint headerOffset = alignValue( (uint)sizeof( MemoryAllocationHeader ), alignment );
+#else
+		const uint headerOffset = 0u;
+#endif
+		const uint blockSize = size + headerOffset;
 
-#if TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
-		pMemory = malloc( size );
+		void* pBlock = nullptr;
+#if TIKI_ENABLED( TIKI_USE_ENGINE_ALLOCATOR )
+		pBlock = engineallocator::allocate( blockSize, alignment );
+#elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+		if ( alignment <= MemorySystemAlignment )
+		{
+			pBlock = malloc( blockSize );
+		}
+		else if ( posix_memalign( &pBlock, alignment, blockSize ) != 0 )
+		{
+			pBlock = nullptr;
+		}
 #elif TIKI_ENABLED( TIKI_BUILD_MSVC )
 #	if TIKI_ENABLED( TIKI_BUILD_DEBUG )
-		pMemory = _aligned_malloc_dbg( size, alignment, pFileName, lineNumber );
+		pBlock = _aligned_malloc_dbg( blockSize, alignment, pFileName, lineNumber );
 #	else
-		pMemory = _aligned_malloc( size, alignment );
+		pBlock = _aligned_malloc( blockSize, alignment );
 #	endif
 #endif
 
-		TIKI_ASSERT( (uint)pMemory % alignment == 0u );
+		if ( pBlock == nullptr )
+		{
+			return nullptr;
+		}
+
+		uint8* pMemory = static_cast< uint8* >( pBlock ) + headerOffset;
+
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+		MemoryAllocationHeader* pHeader = reinterpret_cast< MemoryAllocationHeader* >( pMemory ) - 1u;
+		pHeader->sizeInBytes	= size;
+		pHeader->offset			= uint32( headerOffset );
+		pHeader->tag			= uint32( s_currentMemoryTag );
+
+		trackAllocation( s_currentMemoryTag, size, alignment );
+#endif
+
+		TIKI_ASSERT( isPointerAligned( pMemory, alignment ) );
 		return pMemory;
 	}
 
 	void memory::freeAligned( void* pPtr )
 	{
-#if TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
-		return free( pPtr );
+		if ( pPtr == nullptr )
+		{
+			return;
+		}
+
+		void* pBlock = pPtr;
+
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+		const MemoryAllocationHeader* pHeader = static_cast< const MemoryAllocationHeader* >( pPtr ) - 1u;
+		trackFree( (MemoryTag)pHeader->tag, pHeader->sizeInBytes );
+
+		pBlock = static_cast< uint8* >( pPtr ) - pHeader->offset;
+#endif
+
+#if TIKI_ENABLED( TIKI_USE_ENGINE_ALLOCATOR )
+		engineallocator::free( pBlock );
+#elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+		free( pBlock );
 #elif TIKI_ENABLED( TIKI_BUILD_MSVC )
-#	if TIKI_ENABLED( TIKI_BUILD_DEBUG )		
-		_aligned_free_dbg( pPtr );
+#	if TIKI_ENABLED( TIKI_BUILD_DEBUG )
+		_aligned_free_dbg( pBlock );
 #	else
-		_aligned_free( pPtr );
+		_aligned_free( pBlock );
 #	endif
 #endif
 	}
 
+	MemoryTag memory::getCurrentTag()
+	{
+		return s_currentMemoryTag;
+	}
+
+	void memory::setCurrentTag( MemoryTag tag )
+	{
+		TIKI_ASSERT( tag < MemoryTag_Count );
+		s_currentMemoryTag = tag;
+	}
+
+	const char* memory::getTagName( MemoryTag tag )
+	{
+		TIKI_ASSERT( tag < MemoryTag_Count );
+		return s_apMemoryTagNames[ tag ];
+	}
+
+	void memory::setTagBudget( MemoryTag tag, uint64 budgetInBytes )
+	{
+		TIKI_ASSERT( tag < MemoryTag_Count );
+
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+		s_aMemoryTagStates[ tag ].budgetInBytes = budgetInBytes;
+#endif
+	}
+
+	void memory::getTagStatistics( MemoryTag tag, MemoryTagStatistics& statistics )
+	{
+		TIKI_ASSERT( tag < MemoryTag_Count );
+
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+		const MemoryTagState& state = s_aMemoryTagStates[ tag ];
+		statistics.liveSizeInBytes				= state.liveSizeInBytes;
+		statistics.liveAllocationCount			= state.liveAllocationCount;
+		statistics.peakSizeInBytes				= state.peakSizeInBytes;
+		statistics.totalAllocationCount			= state.totalAllocationCount;
+		statistics.overAlignedAllocationCount	= state.overAlignedAllocationCount;
+		statistics.budgetInBytes				= state.budgetInBytes;
+#else
+		zero( statistics );
+#endif
+	}
+
 	int	memory::compare( const void* pData1, const void* pData2, uint sizeInBytes )
 	{
 		return memcmp( pData1, pData2, sizeInBytes );
@@ -1,8 +1,95 @@
 
 #include "tiki/base/platform.hpp"
 
+#include "tiki/base/assert.hpp"
+
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+#	include <intrin.h>
+#elif TIKI_ENABLED( TIKI_CPU_X86 )
+#	include <cpuid.h>
+#endif
+
 namespace tiki
 {
+	enum
+	{
+		CpuFeatureDetectedFlag = 1u << 31u
+	};
+
+	static uint32 s_cpuFeatures = 0u;
+
+	static uint32 detectCpuFeatures()
+	{
+		uint32 features = CpuFeatureDetectedFlag;
+
+#if TIKI_ENABLED( TIKI_CPU_X86 )
+		uint32 aRegisters[ 4u ];
+#	if TIKI_ENABLED( TIKI_BUILD_MSVC )
+		__cpuid( (int*)aRegisters, 0 );
+		const uint32 maxLeaf = aRegisters[ 0u ];
+		__cpuid( (int*)aRegisters, 1 );
+#	else
+		__cpuid( 0, aRegisters[ 0u ], aRegisters[ 1u ], aRegisters[ 2u ], aRegisters[ 3u ] );
+		const uint32 maxLeaf = aRegisters[ 0u ];
+		__cpuid( 1, aRegisters[ 0u ], aRegisters[ 1u ], aRegisters[ 2u ], aRegisters[ 3u ] );
+#	endif
+
+		const uint32 ecx = aRegisters[ 2u ];
+		if ( ecx & ( 1u << 19u ) )	features |= 1u << CpuFeature_Sse41;
+		if ( ecx & ( 1u << 20u ) )	features |= 1u << CpuFeature_Sse42;
+		if ( ecx & ( 1u << 1u ) )	features |= 1u << CpuFeature_Pclmul;
+
+		// avx needs the os to save the ymm registers
+		bool isAvxEnabled = false;
+		if ( ( ecx & ( 1u << 27u ) ) && ( ecx & ( 1u << 28u ) ) )
+		{
+#	if TIKI_ENABLED( TIKI_BUILD_MSVC )
+			const uint64 xcr0 = _xgetbv( 0 );
+#	else
+			uint32 xcr0Low;
+			uint32 xcr0High;
+			__asm__ volatile( "xgetbv" : "=a"( xcr0Low ), "=d"( xcr0High ) : "c"( 0 ) );
+			const uint64 xcr0 = ( uint64( xcr0High ) << 32u ) | xcr0Low;
+#	endif
+			isAvxEnabled = ( xcr0 & 6u ) == 6u;
+		}
+
+		if ( isAvxEnabled )
+		{
+			features |= 1u << CpuFeature_Avx;
+			if ( ecx & ( 1u << 12u ) )	features |= 1u << CpuFeature_Fma;
+			if ( ecx & ( 1u << 29u ) )	features |= 1u << CpuFeature_F16c;
+
+			if ( maxLeaf >= 7u )
+			{
+#	if TIKI_ENABLED( TIKI_BUILD_MSVC )
+				__cpuidex( (int*)aRegisters, 7, 0 );
+#	else
+				__cpuid_count( 7, 0, aRegisters[ 0u ], aRegisters[ 1u ], aRegisters[ 2u ], aRegisters[ 3u ] );
+#	endif
+				if ( aRegisters[ 1u ] & ( 1u << 5u ) )	features |= 1u << CpuFeature_Avx2;
+			}
+		}
+#endif
+
+		return features;
+	}
+
+	bool platform::hasCpuFeature( CpuFeature feature )
+	{
+		TIKI_ASSERT( feature < CpuFeature_Count );
+
+		// detecting twice from different threads gives the same result
+		uint32 features = s_cpuFeatures;
+		if ( features == 0u )
+		{
+			features = detectCpuFeatures();
+			s_cpuFeatures = features;
+		}
+
+		return ( features & ( 1u << feature ) ) != 0u;
+	}
+
 	PlatformType platform::getHostPlatform()
 	{
 #if TIKI_ENABLED( TIKI_PLATFORM_WIN )
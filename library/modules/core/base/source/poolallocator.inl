@@ -3,16 +3,25 @@
 #define __TIKI_POOLALLOCATOR_INL_INCLUDED__
 
 #include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
 
 namespace tiki
 {
 	template<typename T>
 	TIKI_FORCE_INLINE PoolAllocator< T >::PoolAllocator()
 	{
+		m_type			= PoolAllocatorType_FreeList;
+
 		m_pPool			= nullptr;
+		m_slotSize		= 0u;
 		m_count			= 0u;
+		m_usedCount		= 0u;
+
+		m_pFirstFree	= nullptr;
 
 		m_pUsageBitmask	= nullptr;
+		m_usageCount	= 0u;
 	}
 
 	template<typename T>
@@ -22,22 +31,60 @@ namespace tiki
 	}
 
 	template<typename T>
-	TIKI_FORCE_INLINE bool PoolAllocator< T >::create( uint count, uint alignment /* = TIKI_DEFAULT_ALIGNMENT */ )
+	TIKI_FORCE_INLINE bool PoolAllocator< T >::create( uint count, uint alignment /* = TIKI_DEFAULT_ALIGNMENT */, PoolAllocatorType type /* = PoolAllocatorType_FreeList */ )
 	{
-		const uint usageCount = alignValue( count, 64u ) / 64u;
+		TIKI_ASSERT( m_pPool == nullptr );
+		TIKI_ASSERT( count > 0u );
+
+		if ( alignment == TIKI_DEFAULT_ALIGNMENT )
+		{
+			alignment = TIKI_MAX( (uint)TIKI_ALIGNOF( T ), (uint)TIKI_ALIGNOF( FreeSlot ) );
+		}
+		TIKI_ASSERT( isPowerOfTwo( alignment ) );
 
-		m_pPool			= static_cast< T* >( memory::allocAlign( count * sizeof( T ), alignment ) );
-		m_pUsageBitmask	= static_cast< uint64* >( memory::allocAlign( usageCount * sizeof( uint64 ), sizeof( uint64 ) ) );
-		m_count	= count;
+		m_type		= type;
+		m_slotSize	= alignValue( TIKI_MAX( (uint)sizeof( T ), (uint)sizeof( FreeSlot ) ), alignment );
+		m_count		= count;
+		m_usedCount	= 0u;
 
-		if ( m_pPool == nullptr || m_pUsageBitmask == nullptr )
+		m_pPool = static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( count * m_slotSize, alignment ) );
+		if ( m_pPool == nullptr )
 		{
 			dispose();
 			TIKI_TRACE_ERROR( "[PoolAllocator] Could not allocator Memory.\n" );
 			return false;
 		}
 
-		memory::zero( m_pUsageBitmask, usageCount * sizeof( uint64 ) );
+		if ( type == PoolAllocatorType_FreeList )
+		{
+			// link the slots in order, so a new pool hands out consecutive slots
+			for (uint i = 0u; i < count; ++i)
+			{
+				FreeSlot* pSlot = reinterpret_cast< FreeSlot* >( m_pPool + ( i * m_slotSize ) );
+				pSlot->pNext = ( i + 1u < count ? reinterpret_cast< FreeSlot* >( m_pPool + ( ( i + 1u ) * m_slotSize ) ) : nullptr );
+			}
+			m_pFirstFree = reinterpret_cast< FreeSlot* >( m_pPool );
+		}
+		else
+		{
+			m_usageCount	= alignValue( count, (uint)64u ) / 64u;
+			m_pUsageBitmask	= static_cast< uint64* >( TIKI_MEMORY_ALLOC_ALIGNED( m_usageCount * sizeof( uint64 ), sizeof( uint64 ) ) );
+			if ( m_pUsageBitmask == nullptr )
+			{
+				dispose();
+				TIKI_TRACE_ERROR( "[PoolAllocator] Could not allocator Memory.\n" );
+				return false;
+			}
+
+			memory::zero( m_pUsageBitmask, m_usageCount * sizeof( uint64 ) );
+
+			// mark the bits behind the last slot as used
+			const uint tailCount = ( m_usageCount * 64u ) - count;
+			if ( tailCount > 0u )
+			{
+				m_pUsageBitmask[ m_usageCount - 1u ] = ~0ull << ( 64u - tailCount );
+			}
+		}
 
 		return true;
 	}
@@ -45,19 +92,25 @@ namespace tiki
 	template<typename T>
 	TIKI_FORCE_INLINE void PoolAllocator< T >::dispose()
 	{
+		TIKI_ASSERT( m_usedCount == 0u );
+
 		if ( m_pPool != nullptr )
 		{
-			memory::freeAlign( m_pPool );
+			TIKI_MEMORY_FREE( m_pPool );
 			m_pPool = nullptr;
 		}
 
 		if ( m_pUsageBitmask != nullptr )
 		{
-			memory::freeAlign( m_pUsageBitmask );
+			TIKI_MEMORY_FREE( m_pUsageBitmask );
 			m_pUsageBitmask = nullptr;
 		}
 
-		m_count = 0u;
+		m_pFirstFree	= nullptr;
+		m_slotSize		= 0u;
+		m_count			= 0u;
+		m_usedCount		= 0u;
+		m_usageCount	= 0u;
 	}
 
 	template<typename T>
@@ -65,39 +118,83 @@ namespace tiki
 	{
 		TIKI_ASSERT( m_pPool != nullptr );
 
-		uint usageIndex = 0u;
-		while ( countLeadingZeros64( m_pUsageBitmask[ usageIndex ] ) == 0u )
+		if ( m_type == PoolAllocatorType_Bitmask )
 		{
-			usageIndex++;
+			return allocateFromBitmask();
 		}
-		const uint maskIndex = 64u - countLeadingZeros64( m_pUsageBitmask[ usageIndex ] );
-		const uint finalIndex = ( usageIndex * 64u ) + maskIndex;
 
-		if ( finalIndex >= m_count )
+		FreeSlot* pSlot = m_pFirstFree;
+		if ( pSlot == nullptr )
 		{
 			return nullptr;
 		}
-		
-		m_pUsageBitmask[ usageIndex ] |= 1ull << maskIndex;
 
-		return ::new( &m_pPool[ finalIndex ] ) T();
+		m_pFirstFree = pSlot->pNext;
+		m_usedCount++;
+
+		return ::new( pSlot ) T();
 	}
 
 	template<typename T>
 	TIKI_FORCE_INLINE void PoolAllocator< T >::free( T* pObject )
 	{
 		TIKI_ASSERT( m_pPool != nullptr );
+		TIKI_ASSERT( pObject != nullptr );
+
+		const uint offset = uint( reinterpret_cast< uint8* >( pObject ) - m_pPool );
+		TIKI_ASSERT( offset < m_count * m_slotSize );
+		TIKI_ASSERT( offset % m_slotSize == 0u );
 
 		pObject->~T();
+		m_usedCount--;
 
-		const uint index = pObject - m_pPool;
-		TIKI_ASSERT( index < m_count );
+		if ( m_type == PoolAllocatorType_Bitmask )
+		{
+			freeToBitmask( offset / m_slotSize );
+			return;
+		}
 
+		FreeSlot* pSlot = reinterpret_cast< FreeSlot* >( pObject );
+		pSlot->pNext = m_pFirstFree;
+		m_pFirstFree = pSlot;
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE T* PoolAllocator< T >::allocateFromBitmask()
+	{
+		uint usageIndex = 0u;
+		while ( usageIndex < m_usageCount && m_pUsageBitmask[ usageIndex ] == ~0ull )
+		{
+			usageIndex++;
+		}
+
+		if ( usageIndex == m_usageCount )
+		{
+			return nullptr;
+		}
+
+		// isolate the lowest zero bit
+		const uint64 mask = m_pUsageBitmask[ usageIndex ];
+		const uint64 freeBit = ~mask & ( mask + 1u );
+		const uint maskIndex = 63u - countLeadingZeros64( freeBit );
+		const uint finalIndex = ( usageIndex * 64u ) + maskIndex;
+		TIKI_ASSERT( finalIndex < m_count );
+
+		m_pUsageBitmask[ usageIndex ] |= freeBit;
+		m_usedCount++;
+
+		return ::new( m_pPool + ( finalIndex * m_slotSize ) ) T();
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE void PoolAllocator< T >::freeToBitmask( uint index )
+	{
 		const uint usageIndex = index / 64u;
 		const uint maskIndex = index - ( usageIndex * 64u );
+		TIKI_ASSERT( ( m_pUsageBitmask[ usageIndex ] & ( 1ull << maskIndex ) ) != 0u );
 
 		m_pUsageBitmask[ usageIndex ] &= ~( 1ull << maskIndex );
 	}
 }
 
-#endif // __TIKI_POOLALLOCATOR_INL_INCLUDED__
\ No newline at end of file
+#endif // __TIKI_POOLALLOCATOR_INL_INCLUDED__
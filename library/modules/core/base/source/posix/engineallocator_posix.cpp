@@ -0,0 +1,51 @@
+
+#include "tiki/base/engineallocator.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+
+#include "../engineallocator_internal.hpp"
+
+#include <sched.h>
+#include <sys/mman.h>
+
+namespace tiki
+{
+	void* engineallocator::allocateSystemMemory( uint sizeInBytes, uint alignment )
+	{
+		// map more than needed and cut off the unaligned head and the tail
+		const uint mappedSize = sizeInBytes + alignment;
+		void* pMapped = mmap( nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+		if ( pMapped == MAP_FAILED )
+		{
+			return nullptr;
+		}
+
+		uint8* pBase = static_cast< uint8* >( pMapped );
+		uint8* pAligned = alignPointer( pBase, alignment );
+
+		const uint headSize = uint( pAligned - pBase );
+		const uint tailSize = mappedSize - headSize - sizeInBytes;
+		if ( headSize > 0u )
+		{
+			munmap( pBase, headSize );
+		}
+
+		if ( tailSize > 0u )
+		{
+			munmap( pAligned + sizeInBytes, tailSize );
+		}
+
+		return pAligned;
+	}
+
+	void engineallocator::freeSystemMemory( void* pMemory, uint sizeInBytes )
+	{
+		munmap( pMemory, sizeInBytes );
+	}
+
+	void engineallocator::yieldThread()
+	{
+		sched_yield();
+	}
+}
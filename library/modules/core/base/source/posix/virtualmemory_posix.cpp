@@ -0,0 +1,41 @@
+#include "../virtualmemory_internal.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace tiki
+{
+	uint virtualmemory::getPageSize()
+	{
+		return (uint)sysconf( _SC_PAGESIZE );
+	}
+
+	void* virtualmemory::reserve( uint sizeInBytes )
+	{
+		// no access and no swap reservation until pages get committed
+		void* pMemory = mmap( nullptr, sizeInBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+		if ( pMemory == MAP_FAILED )
+		{
+			return nullptr;
+		}
+
+		return pMemory;
+	}
+
+	void virtualmemory::release( void* pMemory, uint sizeInBytes )
+	{
+		munmap( pMemory, sizeInBytes );
+	}
+
+	bool virtualmemory::commit( void* pMemory, uint sizeInBytes )
+	{
+		return mprotect( pMemory, sizeInBytes, PROT_READ | PROT_WRITE ) == 0;
+	}
+
+	void virtualmemory::decommit( void* pMemory, uint sizeInBytes )
+	{
+		// gives the physical pages back. they read as zero when committed again.
+		madvise( pMemory, sizeInBytes, MADV_DONTNEED );
+		mprotect( pMemory, sizeInBytes, PROT_NONE );
+	}
+}
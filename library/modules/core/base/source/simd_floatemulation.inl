@@ -2,90 +2,123 @@
 #ifndef __TIKI_SIMD_FLOATEMULATION_INL_INCLUDED__
 #define __TIKI_SIMD_FLOATEMULATION_INL_INCLUDED__
 
+#include <math.h>
+
 namespace tiki
 {
-#warning not implemented
+	namespace simd
+	{
+		TIKI_SIMD_INLINE vf32	createVector_f32( const float x, const float y, const float z, const float w )		{ SimdVector result; result.f32s.x = x; result.f32s.y = y; result.f32s.z = z; result.f32s.w = w; return result; }
+		TIKI_SIMD_INLINE vi32	createVector_i32( const sint32 x, const sint32 y, const sint32 z, const sint32 w )	{ SimdVector result; result.s32s.x = x; result.s32s.y = y; result.s32s.z = z; result.s32s.w = w; return result; }
+		TIKI_SIMD_INLINE vf32	createMask_f32( const bool x, const bool y, const bool z, const bool w )			{ SimdVector result; result.u32s.x = x ? 0xffffffffu : 0u; result.u32s.y = y ? 0xffffffffu : 0u; result.u32s.z = z ? 0xffffffffu : 0u; result.u32s.w = w ? 0xffffffffu : 0u; return result; }
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// load
 
-	TIKI_SIMD_INLINE vf32	simd::set_f32( const float value )												{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::set_f32( const float x, const float y, const float z, const float w )		{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::set_f32( const float* pValues )											{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::set_f32( const float* pValues, const size_t offset )						{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::set_f32u( const float* pValues )											{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::set_f32u( const float* pValues, const size_t offset )						{ return SimdVector(); }
-
-	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32 value )												{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32 x, const sint32 y, const sint32 z, const sint32 w )	{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32* pValues )											{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32* pValues, const size_t offset )						{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi32	simd::set_i32u( const sint32* pValues )											{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi32	simd::set_i32u( const sint32* pValues, const size_t offset )					{ return SimdVector(); }
-
-	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16 value )												{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16 a, const sint16 b, const sint16 c, const sint16 d, const sint16 e, const sint16 f, const sint16 g, const sint16 h )	{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16* pValues )											{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16* pValues, const size_t offset )						{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi16	simd::set_i16u( const sint16* pValues )											{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi16	simd::set_i16u( const sint16* pValues, const size_t offset )					{ return SimdVector(); }
+	TIKI_SIMD_INLINE vf32	simd::set_f32( const float value )												{ return createVector_f32( value, value, value, value ); }
+	TIKI_SIMD_INLINE vf32	simd::set_f32( const float x, const float y, const float z, const float w )		{ return createVector_f32( x, y, z, w ); }
+	TIKI_SIMD_INLINE vf32	simd::set_f32( const float* pValues )											{ return createVector_f32( pValues[ 0u ], pValues[ 1u ], pValues[ 2u ], pValues[ 3u ] ); }
+	TIKI_SIMD_INLINE vf32	simd::set_f32( const float* pValues, const size_t offset )						{ return set_f32( pValues + offset ); }
+	TIKI_SIMD_INLINE vf32	simd::set_f32u( const float* pValues )											{ return set_f32( pValues ); }
+	TIKI_SIMD_INLINE vf32	simd::set_f32u( const float* pValues, const size_t offset )						{ return set_f32( pValues + offset ); }
+
+	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32 value )												{ return createVector_i32( value, value, value, value ); }
+	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32 x, const sint32 y, const sint32 z, const sint32 w )	{ return createVector_i32( x, y, z, w ); }
+	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32* pValues )											{ return createVector_i32( pValues[ 0u ], pValues[ 1u ], pValues[ 2u ], pValues[ 3u ] ); }
+	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32* pValues, const size_t offset )						{ return set_i32( pValues + offset ); }
+	TIKI_SIMD_INLINE vi32	simd::set_i32u( const sint32* pValues )											{ return set_i32( pValues ); }
+	TIKI_SIMD_INLINE vi32	simd::set_i32u( const sint32* pValues, const size_t offset )					{ return set_i32( pValues + offset ); }
+
+	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16 value )												{ SimdVector result; for (uint i = 0u; i < 8u; ++i) { result.s16a[ i ] = value; } return result; }
+	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16 a, const sint16 b, const sint16 c, const sint16 d, const sint16 e, const sint16 f, const sint16 g, const sint16 h )	{ SimdVector result; result.s16s.a = a; result.s16s.b = b; result.s16s.c = c; result.s16s.d = d; result.s16s.e = e; result.s16s.f = f; result.s16s.g = g; result.s16s.h = h; return result; }
+	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16* pValues )											{ SimdVector result; for (uint i = 0u; i < 8u; ++i) { result.s16a[ i ] = pValues[ i ]; } return result; }
+	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16* pValues, const size_t offset )						{ return set_i16( pValues + offset ); }
+	TIKI_SIMD_INLINE vi16	simd::set_i16u( const sint16* pValues )											{ return set_i16( pValues ); }
+	TIKI_SIMD_INLINE vi16	simd::set_i16u( const sint16* pValues, const size_t offset )					{ return set_i16( pValues + offset ); }
 
 	//////////////////////////////////////////////////////////////////////////
 	// store
 
-	TIKI_SIMD_INLINE void	simd::get_f32( float* pTarget, const vf32 value)								{ }
-	TIKI_SIMD_INLINE void	simd::get_f32( float* pTarget, const size_t offset, const vf32 value)			{ }
+	TIKI_SIMD_INLINE void	simd::get_f32( float* pTarget, const vf32 value )								{ for (uint i = 0u; i < 4u; ++i) { pTarget[ i ] = value.f32a[ i ]; } }
+	TIKI_SIMD_INLINE void	simd::get_f32( float* pTarget, const size_t offset, const vf32 value )			{ get_f32( pTarget + offset, value ); }
 	TIKI_SIMD_INLINE float	simd::get_f32_x( const vf32 value )												{ return value.f32s.x; }
 	TIKI_SIMD_INLINE float	simd::get_f32_y( const vf32 value )												{ return value.f32s.y; }
 	TIKI_SIMD_INLINE float	simd::get_f32_z( const vf32 value )												{ return value.f32s.z; }
 	TIKI_SIMD_INLINE float	simd::get_f32_w( const vf32 value )												{ return value.f32s.w; }
 
-	TIKI_SIMD_INLINE void	simd::get_i32( sint32* pTarget, const vi32 value )								{ }
-	TIKI_SIMD_INLINE void	simd::get_i32( sint32* pTarget, const size_t offset, const vi32 value )			{ }
+	TIKI_SIMD_INLINE void	simd::get_i32( sint32* pTarget, const vi32 value )								{ for (uint i = 0u; i < 4u; ++i) { pTarget[ i ] = value.s32a[ i ]; } }
+	TIKI_SIMD_INLINE void	simd::get_i32( sint32* pTarget, const size_t offset, const vi32 value )			{ get_i32( pTarget + offset, value ); }
 	TIKI_SIMD_INLINE sint32	simd::get_i32_x( const vi32 value )												{ return value.s32s.x; }
 	TIKI_SIMD_INLINE sint32	simd::get_i32_y( const vi32 value )												{ return value.s32s.y; }
 	TIKI_SIMD_INLINE sint32	simd::get_i32_z( const vi32 value )												{ return value.s32s.z; }
 	TIKI_SIMD_INLINE sint32	simd::get_i32_w( const vi32 value )												{ return value.s32s.w; }
 
+	TIKI_SIMD_INLINE void	simd::get_i16( sint16* pTarget, const vi16 value )								{ for (uint i = 0u; i < 8u; ++i) { pTarget[ i ] = value.s16a[ i ]; } }
+	TIKI_SIMD_INLINE void	simd::get_i16( sint16* pTarget, const size_t offset, const vi16 value )			{ get_i16( pTarget + offset, value ); }
+	TIKI_SIMD_INLINE sint16	simd::get_i16_x( const vi16 value )												{ return value.s16s.a; }
+	TIKI_SIMD_INLINE sint16	simd::get_i16_y( const vi16 value )												{ return value.s16s.b; }
+	TIKI_SIMD_INLINE sint16	simd::get_i16_z( const vi16 value )												{ return value.s16s.c; }
+	TIKI_SIMD_INLINE sint16	simd::get_i16_w( const vi16 value )												{ return value.s16s.d; }
+
 
 	//////////////////////////////////////////////////////////////////////////
 	// arithmetic
 
-	TIKI_SIMD_INLINE vf32	simd::add_f32( const vf32 v1, const vf32 v2 )									{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::sub_f32( const vf32 v1, const vf32 v2 )									{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::mul_f32( const vf32 v1, const vf32 v2 )									{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::div_f32( const vf32 v1, const vf32 v2 )									{ return SimdVector(); }
-	TIKI_SIMD_INLINE vf32	simd::muladd_f32( const vf32 v1, const vf32 v2, const vf32 v3 )					{ return SimdVector(); } // r = v1 * v2 + v3
-	TIKI_SIMD_INLINE vf32	simd::mulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 )					{ return SimdVector(); } // r = v1 * v2 - v3
-	TIKI_SIMD_INLINE vf32	simd::negmulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 )				{ return SimdVector(); } // r = v3 - v1 * v1
+	TIKI_SIMD_INLINE vf32	simd::add_f32( const vf32 v1, const vf32 v2 )									{ return createVector_f32( v1.f32s.x + v2.f32s.x, v1.f32s.y + v2.f32s.y, v1.f32s.z + v2.f32s.z, v1.f32s.w + v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::sub_f32( const vf32 v1, const vf32 v2 )									{ return createVector_f32( v1.f32s.x - v2.f32s.x, v1.f32s.y - v2.f32s.y, v1.f32s.z - v2.f32s.z, v1.f32s.w - v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::mul_f32( const vf32 v1, const vf32 v2 )									{ return createVector_f32( v1.f32s.x * v2.f32s.x, v1.f32s.y * v2.f32s.y, v1.f32s.z * v2.f32s.z, v1.f32s.w * v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::div_f32( const vf32 v1, const vf32 v2 )									{ return createVector_f32( v1.f32s.x / v2.f32s.x, v1.f32s.y / v2.f32s.y, v1.f32s.z / v2.f32s.z, v1.f32s.w / v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::muladd_f32( const vf32 v1, const vf32 v2, const vf32 v3 )					{ return add_f32( mul_f32( v1, v2 ), v3 ); } // r = v1 * v2 + v3
+	TIKI_SIMD_INLINE vf32	simd::mulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 )					{ return sub_f32( mul_f32( v1, v2 ), v3 ); } // r = v1 * v2 - v3
+	TIKI_SIMD_INLINE vf32	simd::negmulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 )				{ return sub_f32( v3, mul_f32( v1, v2 ) ); } // r = v3 - v1 * v2
+	TIKI_SIMD_INLINE vf32	simd::min_f32( const vf32 v1, const vf32 v2 )									{ return createVector_f32( v1.f32s.x < v2.f32s.x ? v1.f32s.x : v2.f32s.x, v1.f32s.y < v2.f32s.y ? v1.f32s.y : v2.f32s.y, v1.f32s.z < v2.f32s.z ? v1.f32s.z : v2.f32s.z, v1.f32s.w < v2.f32s.w ? v1.f32s.w : v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::max_f32( const vf32 v1, const vf32 v2 )									{ return createVector_f32( v1.f32s.x > v2.f32s.x ? v1.f32s.x : v2.f32s.x, v1.f32s.y > v2.f32s.y ? v1.f32s.y : v2.f32s.y, v1.f32s.z > v2.f32s.z ? v1.f32s.z : v2.f32s.z, v1.f32s.w > v2.f32s.w ? v1.f32s.w : v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::sqrt_f32( const vf32 value )												{ return createVector_f32( sqrtf( value.f32s.x ), sqrtf( value.f32s.y ), sqrtf( value.f32s.z ), sqrtf( value.f32s.w ) ); }
+
+	TIKI_SIMD_INLINE vi32	simd::add_i32( const vi32 v1, const vi32 v2 )									{ return createVector_i32( v1.s32s.x + v2.s32s.x, v1.s32s.y + v2.s32s.y, v1.s32s.z + v2.s32s.z, v1.s32s.w + v2.s32s.w ); }
+	TIKI_SIMD_INLINE vi32	simd::sub_i32( const vi32 v1, const vi32 v2 )									{ return createVector_i32( v1.s32s.x - v2.s32s.x, v1.s32s.y - v2.s32s.y, v1.s32s.z - v2.s32s.z, v1.s32s.w - v2.s32s.w ); }
+	TIKI_SIMD_INLINE vi32	simd::mul_i32( const vi32 v1, const vi32 v2 )									{ return createVector_i32( v1.s32s.x * v2.s32s.x, v1.s32s.y * v2.s32s.y, v1.s32s.z * v2.s32s.z, v1.s32s.w * v2.s32s.w ); }
+	TIKI_SIMD_INLINE vi32	simd::div_i32( const vi32 v1, const vi32 v2 )									{ return createVector_i32( v1.s32s.x / v2.s32s.x, v1.s32s.y / v2.s32s.y, v1.s32s.z / v2.s32s.z, v1.s32s.w / v2.s32s.w ); }
+	TIKI_SIMD_INLINE vi32	simd::muladd_i32( const vi32 v1, const vi32 v2, const vi32 v3 )					{ return add_i32( mul_i32( v1, v2 ), v3 ); }
+	TIKI_SIMD_INLINE vi32	simd::mulsub_i32( const vi32 v1, const vi32 v2, const vi32 v3 )					{ return sub_i32( mul_i32( v1, v2 ), v3 ); }
+
 
-	TIKI_SIMD_INLINE vi32	simd::add_i32( const vi32 v1, const vi32 v2 )									{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi32	simd::sub_i32( const vi32 v1, const vi32 v2 )									{ return SimdVector(); }
-	//TIKI_SIMD_INLINE vi32	simd::mul_i32( const vi32 v1, const vi32 v2 )									{ return _mm_mul_epi32( v1, v2 ); }
-	//TIKI_SIMD_INLINE vi32	simd::div_i32( const vi32 v1, const vi32 v2 )									{ return _mm_div_si32( v1, v2 ); }
-	//TIKI_SIMD_INLINE vi32	simd::muladd_i32( const vi32 v1, const vi32 v2, const vi32 v3 )					{ return _mm_add_epi32( _mm_mul_epi32( v1, v2 ), v3 ); }
-	//TIKI_SIMD_INLINE vi32	simd::mulsub_i32( const vi32 v1, const vi32 v2, const vi32 v3 )					{ return _mm_sub_epi32( _mm_mul_epi32( v1, v2 ), v3 ); }
+	//////////////////////////////////////////////////////////////////////////
+	// compare
+
+	TIKI_SIMD_INLINE vf32	simd::cmplt_f32( const vf32 v1, const vf32 v2 )									{ return createMask_f32( v1.f32s.x < v2.f32s.x, v1.f32s.y < v2.f32s.y, v1.f32s.z < v2.f32s.z, v1.f32s.w < v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::cmple_f32( const vf32 v1, const vf32 v2 )									{ return createMask_f32( v1.f32s.x <= v2.f32s.x, v1.f32s.y <= v2.f32s.y, v1.f32s.z <= v2.f32s.z, v1.f32s.w <= v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::cmpgt_f32( const vf32 v1, const vf32 v2 )									{ return createMask_f32( v1.f32s.x > v2.f32s.x, v1.f32s.y > v2.f32s.y, v1.f32s.z > v2.f32s.z, v1.f32s.w > v2.f32s.w ); }
+	TIKI_SIMD_INLINE vf32	simd::cmpge_f32( const vf32 v1, const vf32 v2 )									{ return createMask_f32( v1.f32s.x >= v2.f32s.x, v1.f32s.y >= v2.f32s.y, v1.f32s.z >= v2.f32s.z, v1.f32s.w >= v2.f32s.w ); }
+
+	TIKI_SIMD_INLINE vf32	simd::and_f32( const vf32 v1, const vf32 v2 )									{ SimdVector result; for (uint i = 0u; i < 4u; ++i) { result.u32a[ i ] = v1.u32a[ i ] & v2.u32a[ i ]; } return result; }
+	TIKI_SIMD_INLINE vf32	simd::or_f32( const vf32 v1, const vf32 v2 )									{ SimdVector result; for (uint i = 0u; i < 4u; ++i) { result.u32a[ i ] = v1.u32a[ i ] | v2.u32a[ i ]; } return result; }
+	TIKI_SIMD_INLINE vf32	simd::select_f32( const vf32 mask, const vf32 v1, const vf32 v2 )				{ SimdVector result; for (uint i = 0u; i < 4u; ++i) { result.u32a[ i ] = ( mask.u32a[ i ] & v1.u32a[ i ] ) | ( ~mask.u32a[ i ] & v2.u32a[ i ] ); } return result; }
+	TIKI_SIMD_INLINE uint32	simd::mask_f32( const vf32 mask )												{ return ( mask.u32s.x >> 31u ) | ( ( mask.u32s.y >> 31u ) << 1u ) | ( ( mask.u32s.z >> 31u ) << 2u ) | ( ( mask.u32s.w >> 31u ) << 3u ); }
 
 
 	//////////////////////////////////////////////////////////////////////////
 	// convert
 
-	TIKI_SIMD_INLINE vf32	simd::convert_i32_to_f32( const vi32 value )									{ return SimdVector(); }
+	TIKI_SIMD_INLINE vf32	simd::convert_i32_to_f32( const vi32 value )									{ return createVector_f32( float( value.s32s.x ), float( value.s32s.y ), float( value.s32s.z ), float( value.s32s.w ) ); }
 
-	TIKI_SIMD_INLINE vi32	simd::convert_i16l_to_i32( const vi16 value )									{ return SimdVector(); }
-	TIKI_SIMD_INLINE vi32	simd::convert_i16h_to_i32( const vi16 value )									{ return SimdVector(); }
+	TIKI_SIMD_INLINE vi32	simd::convert_i16l_to_i32( const vi16 value )									{ return createVector_i32( value.s16s.a, value.s16s.b, value.s16s.c, value.s16s.d ); }
+	TIKI_SIMD_INLINE vi32	simd::convert_i16h_to_i32( const vi16 value )									{ return createVector_i32( value.s16s.e, value.s16s.f, value.s16s.g, value.s16s.h ); }
 
 
 	//////////////////////////////////////////////////////////////////////////
 	// special
 
-	TIKI_SIMD_INLINE vf32	simd::splat_x_f32( const vf32 value )											{ const SimdVector result = { value.f32s.x, value.f32s.x, value.f32s.x, value.f32s.x }; return result; }
-	TIKI_SIMD_INLINE vf32	simd::splat_y_f32( const vf32 value )											{ const SimdVector result = { value.f32s.y, value.f32s.y, value.f32s.y, value.f32s.y }; return result; }
-	TIKI_SIMD_INLINE vf32	simd::splat_z_f32( const vf32 value )											{ const SimdVector result = { value.f32s.z, value.f32s.z, value.f32s.z, value.f32s.z }; return result; }
-	TIKI_SIMD_INLINE vf32	simd::splat_w_f32( const vf32 value )											{ const SimdVector result = { value.f32s.w, value.f32s.w, value.f32s.w, value.f32s.w }; return result; }
+	TIKI_SIMD_INLINE vf32	simd::splat_x_f32( const vf32 value )											{ return set_f32( value.f32s.x ); }
+	TIKI_SIMD_INLINE vf32	simd::splat_y_f32( const vf32 value )											{ return set_f32( value.f32s.y ); }
+	TIKI_SIMD_INLINE vf32	simd::splat_z_f32( const vf32 value )											{ return set_f32( value.f32s.z ); }
+	TIKI_SIMD_INLINE vf32	simd::splat_w_f32( const vf32 value )											{ return set_f32( value.f32s.w ); }
+
+	TIKI_SIMD_INLINE vf32	simd::rsqrt_f32( const vf32 value )												{ return createVector_f32( 1.0f / sqrtf( value.f32s.x ), 1.0f / sqrtf( value.f32s.y ), 1.0f / sqrtf( value.f32s.z ), 1.0f / sqrtf( value.f32s.w ) ); } // r = 1.0f / sqrt( value )
+	TIKI_SIMD_INLINE vf32	simd::dot4_f32( const vf32 v1, const vf32 v2 )									{ const float dot = (v1.f32s.x * v2.f32s.x) + (v1.f32s.y * v2.f32s.y) + (v1.f32s.z * v2.f32s.z) + (v1.f32s.w * v2.f32s.w); return set_f32( dot ); }
+	TIKI_SIMD_INLINE void	simd::transpose_f32( vf32& x, vf32& y, vf32& z, vf32& w )					{ const vf32 rows[] = { x, y, z, w }; vf32* apColumns[] = { &x, &y, &z, &w }; for (uint i = 0u; i < 4u; ++i) { for (uint j = 0u; j < 4u; ++j) { apColumns[ i ]->f32a[ j ] = rows[ j ].f32a[ i ]; } } }
 
-	TIKI_SIMD_INLINE vf32	simd::rsqrt_f32( const vf32 value )												{ return SimdVector(); } // r = 1.0f / sqrt( value )
-	TIKI_SIMD_INLINE vf32	simd::dot4_f32( const vf32 v1, const vf32 v2 )									{ const float dot = (v1.f32s.x * v2.f32s.x) + (v1.f32s.y * v2.f32s.y) + (v1.f32s.z * v2.f32s.z) + (v1.f32s.w * v2.f32s.w); const SimdVector result = { dot, dot, dot, dot }; return result; }
-	
 }
 
 #endif // __TIKI_SIMD_FLOATEMULATION_INL_INCLUDED__
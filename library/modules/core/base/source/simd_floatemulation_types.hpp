@@ -4,7 +4,7 @@
 
 namespace tiki
 {
-	TIKI_PRE_ALIGN( 16 ) union SimdVector
+	TIKI_ALIGN_PREFIX( 16 ) union SimdVector
 	{
 		float																f32a[ 4u ];
 		struct { float x, y, z, w; }										f32s;
@@ -20,7 +20,7 @@ namespace tiki
 		struct { sint8 a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p; }	s8s;
 		uint8																u8a[ 16u ];
 		struct { uint8 a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p; }	u8s;
-	} TIKI_POST_ALIGN( 16 ) ;
+	} TIKI_ALIGN_POSTFIX( 16 );
 
 	typedef SimdVector	vf32;
 	typedef SimdVector	vi8;
@@ -0,0 +1,18 @@
+#pragma once
+#ifndef __TIKI_SIMD_SSE_TYPES_HPP_INCLUDED__
+#define __TIKI_SIMD_SSE_TYPES_HPP_INCLUDED__
+
+#include <smmintrin.h>
+
+namespace tiki
+{
+	typedef __m128	vf32;
+	typedef __m128i	vi8;
+	typedef __m128i	vi16;
+	typedef __m128i	vi32;
+	typedef __m128i	vu8;
+	typedef __m128i	vu16;
+	typedef __m128i	vu32;
+}
+
+#endif // __TIKI_SIMD_SSE_TYPES_HPP_INCLUDED__
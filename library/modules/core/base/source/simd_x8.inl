@@ -0,0 +1,81 @@
+#pragma once
+#ifndef __TIKI_SIMD_X8_INL_INCLUDED__
+#define __TIKI_SIMD_X8_INL_INCLUDED__
+
+namespace tiki
+{
+#if TIKI_ENABLED( TIKI_SIMD_AVX )
+
+	TIKI_SIMD_INLINE vf32x8	simd::set_f32x8( const float value )											{ return _mm256_set1_ps( value ); }
+	TIKI_SIMD_INLINE vf32x8	simd::set_f32x8( const float* pValues )											{ return _mm256_load_ps( pValues ); }
+	TIKI_SIMD_INLINE vf32x8	simd::set_f32x8u( const float* pValues )										{ return _mm256_loadu_ps( pValues ); }
+	TIKI_SIMD_INLINE void	simd::get_f32x8( float* pTarget, const vf32x8 value )							{ _mm256_store_ps( pTarget, value ); }
+	TIKI_SIMD_INLINE void	simd::get_f32x8u( float* pTarget, const vf32x8 value )							{ _mm256_storeu_ps( pTarget, value ); }
+
+	TIKI_SIMD_INLINE vf32x8	simd::add_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_add_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::sub_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_sub_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::mul_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_mul_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::div_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_div_ps( v1, v2 ); }
+#	if defined( __FMA__ )
+	TIKI_SIMD_INLINE vf32x8	simd::muladd_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )			{ return _mm256_fmadd_ps( v1, v2, v3 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::mulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )			{ return _mm256_fmsub_ps( v1, v2, v3 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::negmulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )		{ return _mm256_fnmadd_ps( v1, v2, v3 ); }
+#	else
+	TIKI_SIMD_INLINE vf32x8	simd::muladd_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )			{ return _mm256_add_ps( _mm256_mul_ps( v1, v2 ), v3 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::mulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )			{ return _mm256_sub_ps( _mm256_mul_ps( v1, v2 ), v3 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::negmulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )		{ return _mm256_sub_ps( v3, _mm256_mul_ps( v1, v2 ) ); }
+#	endif
+	TIKI_SIMD_INLINE vf32x8	simd::min_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_min_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::max_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_max_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::sqrt_f32x8( const vf32x8 value )											{ return _mm256_sqrt_ps( value ); }
+	TIKI_SIMD_INLINE vf32x8	simd::rsqrt_f32x8( const vf32x8 value )											{ return _mm256_rsqrt_ps( value ); }
+
+	TIKI_SIMD_INLINE vf32x8	simd::cmplt_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return _mm256_cmp_ps( v1, v2, _CMP_LT_OQ ); }
+	TIKI_SIMD_INLINE vf32x8	simd::cmple_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return _mm256_cmp_ps( v1, v2, _CMP_LE_OQ ); }
+	TIKI_SIMD_INLINE vf32x8	simd::cmpgt_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return _mm256_cmp_ps( v1, v2, _CMP_GT_OQ ); }
+	TIKI_SIMD_INLINE vf32x8	simd::cmpge_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return _mm256_cmp_ps( v1, v2, _CMP_GE_OQ ); }
+
+	TIKI_SIMD_INLINE vf32x8	simd::and_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_and_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::or_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return _mm256_or_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32x8	simd::select_f32x8( const vf32x8 mask, const vf32x8 v1, const vf32x8 v2 )		{ return _mm256_blendv_ps( v2, v1, mask ); }
+	TIKI_SIMD_INLINE uint32	simd::mask_f32x8( const vf32x8 mask )											{ return (uint32)_mm256_movemask_ps( mask ); }
+
+#else
+
+	namespace simd
+	{
+		TIKI_SIMD_INLINE vf32x8	createVector_f32x8( const vf32 low, const vf32 high )						{ vf32x8 result; result.low = low; result.high = high; return result; }
+	}
+
+	TIKI_SIMD_INLINE vf32x8	simd::set_f32x8( const float value )											{ const vf32 vector = set_f32( value ); return createVector_f32x8( vector, vector ); }
+	TIKI_SIMD_INLINE vf32x8	simd::set_f32x8( const float* pValues )											{ return createVector_f32x8( set_f32( pValues ), set_f32( pValues + 4u ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::set_f32x8u( const float* pValues )										{ return createVector_f32x8( set_f32u( pValues ), set_f32u( pValues + 4u ) ); }
+	TIKI_SIMD_INLINE void	simd::get_f32x8( float* pTarget, const vf32x8 value )							{ get_f32( pTarget, value.low ); get_f32( pTarget + 4u, value.high ); }
+	TIKI_SIMD_INLINE void	simd::get_f32x8u( float* pTarget, const vf32x8 value )							{ TIKI_ALIGN_PREFIX( 16 ) float aValues[ 8u ] TIKI_ALIGN_POSTFIX( 16 ); get_f32x8( aValues, value ); for (uint i = 0u; i < 8u; ++i) { pTarget[ i ] = aValues[ i ]; } }
+
+	TIKI_SIMD_INLINE vf32x8	simd::add_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( add_f32( v1.low, v2.low ), add_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::sub_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( sub_f32( v1.low, v2.low ), sub_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::mul_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( mul_f32( v1.low, v2.low ), mul_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::div_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( div_f32( v1.low, v2.low ), div_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::muladd_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )			{ return createVector_f32x8( muladd_f32( v1.low, v2.low, v3.low ), muladd_f32( v1.high, v2.high, v3.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::mulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )			{ return createVector_f32x8( mulsub_f32( v1.low, v2.low, v3.low ), mulsub_f32( v1.high, v2.high, v3.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::negmulsub_f32x8( const vf32x8 v1, const vf32x8 v2, const vf32x8 v3 )		{ return createVector_f32x8( negmulsub_f32( v1.low, v2.low, v3.low ), negmulsub_f32( v1.high, v2.high, v3.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::min_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( min_f32( v1.low, v2.low ), min_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::max_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( max_f32( v1.low, v2.low ), max_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::sqrt_f32x8( const vf32x8 value )											{ return createVector_f32x8( sqrt_f32( value.low ), sqrt_f32( value.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::rsqrt_f32x8( const vf32x8 value )											{ return createVector_f32x8( rsqrt_f32( value.low ), rsqrt_f32( value.high ) ); }
+
+	TIKI_SIMD_INLINE vf32x8	simd::cmplt_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return createVector_f32x8( cmplt_f32( v1.low, v2.low ), cmplt_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::cmple_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return createVector_f32x8( cmple_f32( v1.low, v2.low ), cmple_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::cmpgt_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return createVector_f32x8( cmpgt_f32( v1.low, v2.low ), cmpgt_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::cmpge_f32x8( const vf32x8 v1, const vf32x8 v2 )							{ return createVector_f32x8( cmpge_f32( v1.low, v2.low ), cmpge_f32( v1.high, v2.high ) ); }
+
+	TIKI_SIMD_INLINE vf32x8	simd::and_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( and_f32( v1.low, v2.low ), and_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::or_f32x8( const vf32x8 v1, const vf32x8 v2 )								{ return createVector_f32x8( or_f32( v1.low, v2.low ), or_f32( v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE vf32x8	simd::select_f32x8( const vf32x8 mask, const vf32x8 v1, const vf32x8 v2 )		{ return createVector_f32x8( select_f32( mask.low, v1.low, v2.low ), select_f32( mask.high, v1.high, v2.high ) ); }
+	TIKI_SIMD_INLINE uint32	simd::mask_f32x8( const vf32x8 mask )											{ return mask_f32( mask.low ) | ( mask_f32( mask.high ) << 4u ); }
+
+#endif
+}
+
+#endif // __TIKI_SIMD_X8_INL_INCLUDED__
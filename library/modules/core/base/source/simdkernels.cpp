@@ -0,0 +1,1124 @@
+#include "tiki/base/simdkernels.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/float16.hpp"
+#include "tiki/base/float32.hpp"
+#include "tiki/base/platform.hpp"
+
+#if TIKI_ENABLED( TIKI_CPU_X86 )
+#	define TIKI_SIMDKERNELS_X86 TIKI_ON
+#	include <immintrin.h>
+#	if TIKI_ENABLED( TIKI_BUILD_MSVC )
+#		define TIKI_SIMDKERNELS_SSE41_FUNCTION
+#		define TIKI_SIMDKERNELS_AVX2_FUNCTION
+#	else
+#		define TIKI_SIMDKERNELS_SSE41_FUNCTION __attribute__( ( target( "sse4.1" ) ) )
+#		define TIKI_SIMDKERNELS_AVX2_FUNCTION __attribute__( ( target( "avx,avx2,fma,f16c" ) ) )
+#	endif
+#else
+#	define TIKI_SIMDKERNELS_X86 TIKI_OFF
+#endif
+
+namespace tiki
+{
+	//////////////////////////////////////////////////////////////////////////
+	// scalar. also used for the remaining elements of the vector kernels.
+
+	static void convertInt16ToFloatScalar( float* pTarget, const sint16* pSource, float factor, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = float( pSource[ i ] ) * factor;
+		}
+	}
+
+	static void multiplyAddScalar( float* pTarget, const float* pA, const float* pB, const float* pC, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = pA[ i ] * pB[ i ] + pC[ i ];
+		}
+	}
+
+	// p0 + t * ( t0 + t * ( c2 + t * c3 ) ) with c2 = 3 * ( p1 - p0 ) - 2 * t0 - t1 and c3 = 2 * ( p0 - p1 ) + t0 + t1
+	static void hermiteScalar( float* pTarget, const float* pP0, const float* pT0, const float* pP1, const float* pT1, const float* pTime, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			const float delta	= pP1[ i ] - pP0[ i ];
+			const float c2		= 3.0f * delta - 2.0f * pT0[ i ] - pT1[ i ];
+			const float c3		= pT0[ i ] + pT1[ i ] - 2.0f * delta;
+			const float time	= pTime[ i ];
+
+			pTarget[ i ] = pP0[ i ] + time * ( pT0[ i ] + time * ( c2 + time * c3 ) );
+		}
+	}
+
+	static void sinScalar( float* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f32::approximatedSin( pSource[ i ] );
+		}
+	}
+
+	static void cosScalar( float* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f32::approximatedCos( pSource[ i ] );
+		}
+	}
+
+	static void sinCosScalar( float* pSinTarget, float* pCosTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			f32::approximatedSinCos( pSinTarget[ i ], pCosTarget[ i ], pSource[ i ] );
+		}
+	}
+
+	static void atan2Scalar( float* pTarget, const float* pY, const float* pX, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f32::approximatedAtan2( pY[ i ], pX[ i ] );
+		}
+	}
+
+	static void expScalar( float* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f32::approximatedExp( pSource[ i ] );
+		}
+	}
+
+	static void logScalar( float* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f32::approximatedLog( pSource[ i ] );
+		}
+	}
+
+	static void inverseSquareRootScalar( float* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f32::rsqrt( pSource[ i ] );
+		}
+	}
+
+	static void convertFloat32ToFloat16Scalar( float16* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f16::convertFloat32to16( pSource[ i ] );
+		}
+	}
+
+	static void convertFloat16ToFloat32Scalar( float* pTarget, const float16* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = f16::convertFloat16to32( pSource[ i ] );
+		}
+	}
+
+	// rounds to nearest even like cvtps2dq in the default rounding mode, valid for |x| < 2^23. integer math on the
+	// bits, a magic number addition could be contracted with the scale to a fma and round differently.
+	static TIKI_FORCE_INLINE sint32 roundToIntScalar( float x )
+	{
+		Float32Bits bits;
+		bits.f = x;
+
+		const sint32 exponent	= ( bits.i >> 23 ) & 0xff;
+		const uint32 mantissa	= uint32( bits.i & 0x007fffff ) | ( exponent != 0 ? 0x00800000u : 0u );
+		const sint32 shift		= ( 150 - exponent < 31 ? 150 - exponent : 31 );
+
+		const uint32 half		= 1u << ( shift - 1 );
+		const uint32 remainder	= mantissa & ( ( half << 1u ) - 1u );
+		uint32 result			= mantissa >> shift;
+		result += uint32( remainder > half ) | ( uint32( remainder == half ) & result );
+
+		return ( bits.i < 0 ? -sint32( result ) : sint32( result ) );
+	}
+
+	// min( max( x, 0 ), 1 ) of the vector kernels, nan gives 0
+	static TIKI_FORCE_INLINE float clampUnormScalar( float x )
+	{
+		const float result = ( x > 0.0f ? x : 0.0f );
+		return ( result < 1.0f ? result : 1.0f );
+	}
+
+	static TIKI_FORCE_INLINE float clampSnormScalar( float x )
+	{
+		const float result = ( x > -1.0f ? x : ( x == x ? -1.0f : 0.0f ) );
+		return ( result < 1.0f ? result : 1.0f );
+	}
+
+	static void packUnorm8Scalar( uint8* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = uint8( roundToIntScalar( clampUnormScalar( pSource[ i ] ) * 255.0f ) );
+		}
+	}
+
+	static void packSnorm8Scalar( sint8* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = sint8( roundToIntScalar( clampSnormScalar( pSource[ i ] ) * 127.0f ) );
+		}
+	}
+
+	static void packUnorm16Scalar( uint16* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = uint16( roundToIntScalar( clampUnormScalar( pSource[ i ] ) * 65535.0f ) );
+		}
+	}
+
+	static void packSnorm16Scalar( sint16* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			pTarget[ i ] = sint16( roundToIntScalar( clampSnormScalar( pSource[ i ] ) * 32767.0f ) );
+		}
+	}
+
+	static void packUnorm1010102Scalar( uint32* pTarget, const float* pSource, uint count )
+	{
+		for (uint i = 0u; i < count; ++i)
+		{
+			const float* pValue = pSource + i * 4u;
+			const uint32 x = uint32( roundToIntScalar( clampUnormScalar( pValue[ 0u ] ) * 1023.0f ) );
+			const uint32 y = uint32( roundToIntScalar( clampUnormScalar( pValue[ 1u ] ) * 1023.0f ) );
+			const uint32 z = uint32( roundToIntScalar( clampUnormScalar( pValue[ 2u ] ) * 1023.0f ) );
+			const uint32 w = uint32( roundToIntScalar( clampUnormScalar( pValue[ 3u ] ) * 3.0f ) );
+
+			pTarget[ i ] = x | ( y << 10u ) | ( z << 20u ) | ( w << 30u );
+		}
+	}
+
+#if TIKI_ENABLED( TIKI_SIMDKERNELS_X86 )
+	//////////////////////////////////////////////////////////////////////////
+	// sse 4.1
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void convertInt16ToFloatSse41( float* pTarget, const sint16* pSource, float factor, uint count )
+	{
+		const __m128 simdFactor = _mm_set1_ps( factor );
+
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m128i source = _mm_loadu_si128( (const __m128i*)( pSource + i ) );
+			const __m128 low	= _mm_cvtepi32_ps( _mm_cvtepi16_epi32( source ) );
+			const __m128 high	= _mm_cvtepi32_ps( _mm_cvtepi16_epi32( _mm_unpackhi_epi64( source, source ) ) );
+
+			_mm_storeu_ps( pTarget + i, _mm_mul_ps( low, simdFactor ) );
+			_mm_storeu_ps( pTarget + i + 4u, _mm_mul_ps( high, simdFactor ) );
+		}
+
+		convertInt16ToFloatScalar( pTarget + i, pSource + i, factor, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void multiplyAddSse41( float* pTarget, const float* pA, const float* pB, const float* pC, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			const __m128 result = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( pA + i ), _mm_loadu_ps( pB + i ) ), _mm_loadu_ps( pC + i ) );
+			_mm_storeu_ps( pTarget + i, result );
+		}
+
+		multiplyAddScalar( pTarget + i, pA + i, pB + i, pC + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void hermiteSse41( float* pTarget, const float* pP0, const float* pT0, const float* pP1, const float* pT1, const float* pTime, uint count )
+	{
+		const __m128 two	= _mm_set1_ps( 2.0f );
+		const __m128 three	= _mm_set1_ps( 3.0f );
+
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			const __m128 p0		= _mm_loadu_ps( pP0 + i );
+			const __m128 t0		= _mm_loadu_ps( pT0 + i );
+			const __m128 t1		= _mm_loadu_ps( pT1 + i );
+			const __m128 time	= _mm_loadu_ps( pTime + i );
+			const __m128 delta	= _mm_sub_ps( _mm_loadu_ps( pP1 + i ), p0 );
+
+			const __m128 c2 = _mm_sub_ps( _mm_sub_ps( _mm_mul_ps( three, delta ), _mm_mul_ps( two, t0 ) ), t1 );
+			const __m128 c3 = _mm_sub_ps( _mm_add_ps( t0, t1 ), _mm_mul_ps( two, delta ) );
+
+			__m128 result = _mm_add_ps( c2, _mm_mul_ps( time, c3 ) );
+			result = _mm_add_ps( t0, _mm_mul_ps( time, result ) );
+			result = _mm_add_ps( p0, _mm_mul_ps( time, result ) );
+
+			_mm_storeu_ps( pTarget + i, result );
+		}
+
+		hermiteScalar( pTarget + i, pP0 + i, pT0 + i, pP1 + i, pT1 + i, pTime + i, count - i );
+	}
+
+	// the same steps as f32::approximatedSinCos, the signs are set with the sign bit
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION inline void computeSinCosSse41( __m128& sinValue, __m128& cosValue, const __m128 x )
+	{
+		const __m128 signMask	= _mm_set1_ps( -0.0f );
+		const __m128 absX		= _mm_andnot_ps( signMask, x );
+
+		// min returns the limit for nan like the scalar version
+		const __m128 scaledX	= _mm_min_ps( _mm_mul_ps( absX, _mm_set1_ps( 1.27323954473516f ) ), _mm_set1_ps( 16777216.0f ) );
+		const __m128i octant	= _mm_and_si128( _mm_add_epi32( _mm_cvttps_epi32( scaledX ), _mm_set1_epi32( 1 ) ), _mm_set1_epi32( ~1 ) );
+		const __m128 y			= _mm_cvtepi32_ps( octant );
+
+		__m128 r = _mm_sub_ps( absX, _mm_mul_ps( y, _mm_set1_ps( 0.78515625f ) ) );
+		r = _mm_sub_ps( r, _mm_mul_ps( y, _mm_set1_ps( 2.4187564849853515625e-4f ) ) );
+		r = _mm_sub_ps( r, _mm_mul_ps( y, _mm_set1_ps( 3.77489497744594108e-8f ) ) );
+		const __m128 r2 = _mm_mul_ps( r, r );
+
+		__m128 polySin = _mm_add_ps( _mm_set1_ps( 8.3321608736e-3f ), _mm_mul_ps( r2, _mm_set1_ps( -1.9515295891e-4f ) ) );
+		polySin = _mm_add_ps( _mm_set1_ps( -1.6666654611e-1f ), _mm_mul_ps( r2, polySin ) );
+		polySin = _mm_add_ps( r, _mm_mul_ps( _mm_mul_ps( r, r2 ), polySin ) );
+
+		__m128 polyCos = _mm_add_ps( _mm_set1_ps( -1.388731625493765e-3f ), _mm_mul_ps( r2, _mm_set1_ps( 2.443315711809948e-5f ) ) );
+		polyCos = _mm_add_ps( _mm_set1_ps( 4.166664568298827e-2f ), _mm_mul_ps( r2, polyCos ) );
+		polyCos = _mm_add_ps( _mm_sub_ps( _mm_set1_ps( 1.0f ), _mm_mul_ps( _mm_set1_ps( 0.5f ), r2 ) ), _mm_mul_ps( _mm_mul_ps( r2, r2 ), polyCos ) );
+
+		const __m128 swap		= _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( octant, _mm_set1_epi32( 2 ) ), _mm_set1_epi32( 2 ) ) );
+		const __m128 sinSign	= _mm_xor_ps( _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( octant, _mm_set1_epi32( 4 ) ), 29 ) ), _mm_and_ps( x, signMask ) );
+		const __m128 cosSign	= _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( _mm_add_epi32( octant, _mm_set1_epi32( 2 ) ), _mm_set1_epi32( 4 ) ), 29 ) );
+
+		sinValue = _mm_xor_ps( _mm_blendv_ps( polySin, polyCos, swap ), sinSign );
+		cosValue = _mm_xor_ps( _mm_blendv_ps( polyCos, polySin, swap ), cosSign );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void sinSse41( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			__m128 sinValue;
+			__m128 cosValue;
+			computeSinCosSse41( sinValue, cosValue, _mm_loadu_ps( pSource + i ) );
+			_mm_storeu_ps( pTarget + i, sinValue );
+		}
+
+		sinScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void cosSse41( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			__m128 sinValue;
+			__m128 cosValue;
+			computeSinCosSse41( sinValue, cosValue, _mm_loadu_ps( pSource + i ) );
+			_mm_storeu_ps( pTarget + i, cosValue );
+		}
+
+		cosScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void sinCosSse41( float* pSinTarget, float* pCosTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			__m128 sinValue;
+			__m128 cosValue;
+			computeSinCosSse41( sinValue, cosValue, _mm_loadu_ps( pSource + i ) );
+			_mm_storeu_ps( pSinTarget + i, sinValue );
+			_mm_storeu_ps( pCosTarget + i, cosValue );
+		}
+
+		sinCosScalar( pSinTarget + i, pCosTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void atan2Sse41( float* pTarget, const float* pY, const float* pX, uint count )
+	{
+		const __m128 signMask	= _mm_set1_ps( -0.0f );
+		const __m128 zero		= _mm_setzero_ps();
+		const __m128 one		= _mm_set1_ps( 1.0f );
+
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			const __m128 y		= _mm_loadu_ps( pY + i );
+			const __m128 x		= _mm_loadu_ps( pX + i );
+			const __m128 absY	= _mm_andnot_ps( signMask, y );
+			const __m128 absX	= _mm_andnot_ps( signMask, x );
+			const __m128 maxXY	= _mm_max_ps( absX, absY );
+
+			// 0 / 0 gives nan, the mask clears it
+			__m128 t = _mm_and_ps( _mm_div_ps( _mm_min_ps( absX, absY ), maxXY ), _mm_cmpgt_ps( maxXY, zero ) );
+
+			const __m128 reduce	= _mm_cmpgt_ps( t, _mm_set1_ps( 0.4142135623730950f ) );
+			t = _mm_blendv_ps( t, _mm_div_ps( _mm_sub_ps( t, one ), _mm_add_ps( t, one ) ), reduce );
+			const __m128 t2		= _mm_mul_ps( t, t );
+
+			__m128 result = _mm_add_ps( _mm_set1_ps( -1.38776856032e-1f ), _mm_mul_ps( t2, _mm_set1_ps( 8.05374449538e-2f ) ) );
+			result = _mm_add_ps( _mm_set1_ps( 1.99777106478e-1f ), _mm_mul_ps( t2, result ) );
+			result = _mm_add_ps( _mm_set1_ps( -3.33329491539e-1f ), _mm_mul_ps( t2, result ) );
+			result = _mm_add_ps( _mm_add_ps( _mm_and_ps( reduce, _mm_set1_ps( f32::piOver4 ) ), t ), _mm_mul_ps( _mm_mul_ps( t, t2 ), result ) );
+
+			result = _mm_blendv_ps( result, _mm_sub_ps( _mm_set1_ps( f32::piOver2 ), result ), _mm_cmpgt_ps( absY, absX ) );
+			result = _mm_blendv_ps( result, _mm_sub_ps( _mm_set1_ps( f32::pi ), result ), _mm_cmplt_ps( x, zero ) );
+			result = _mm_xor_ps( result, _mm_and_ps( _mm_cmplt_ps( y, zero ), signMask ) );
+
+			_mm_storeu_ps( pTarget + i, result );
+		}
+
+		atan2Scalar( pTarget + i, pY + i, pX + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void expSse41( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			const __m128 x = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( pSource + i ), _mm_set1_ps( -87.33654f ) ), _mm_set1_ps( 88.37626f ) );
+
+			// floor with truncation, the compare mask is -1 where the truncation rounded up
+			const __m128 fn	= _mm_add_ps( _mm_mul_ps( x, _mm_set1_ps( 1.44269504088896341f ) ), _mm_set1_ps( 0.5f ) );
+			__m128i n		= _mm_cvttps_epi32( fn );
+			n = _mm_add_epi32( n, _mm_castps_si128( _mm_cmpgt_ps( _mm_cvtepi32_ps( n ), fn ) ) );
+
+			const __m128 y	= _mm_cvtepi32_ps( n );
+			const __m128 r	= _mm_sub_ps( _mm_sub_ps( x, _mm_mul_ps( y, _mm_set1_ps( 0.693359375f ) ) ), _mm_mul_ps( y, _mm_set1_ps( -2.12194440e-4f ) ) );
+
+			__m128 poly = _mm_add_ps( _mm_set1_ps( 1.3981999507e-3f ), _mm_mul_ps( r, _mm_set1_ps( 1.9875691500e-4f ) ) );
+			poly = _mm_add_ps( _mm_set1_ps( 8.3334519073e-3f ), _mm_mul_ps( r, poly ) );
+			poly = _mm_add_ps( _mm_set1_ps( 4.1665795894e-2f ), _mm_mul_ps( r, poly ) );
+			poly = _mm_add_ps( _mm_set1_ps( 1.6666665459e-1f ), _mm_mul_ps( r, poly ) );
+			poly = _mm_add_ps( _mm_set1_ps( 5.0000001201e-1f ), _mm_mul_ps( r, poly ) );
+			poly = _mm_add_ps( _mm_add_ps( _mm_set1_ps( 1.0f ), r ), _mm_mul_ps( _mm_mul_ps( r, r ), poly ) );
+
+			const __m128 scale = _mm_castsi128_ps( _mm_slli_epi32( _mm_add_epi32( n, _mm_set1_epi32( 127 ) ), 23 ) );
+			_mm_storeu_ps( pTarget + i, _mm_mul_ps( poly, scale ) );
+		}
+
+		expScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void logSse41( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			const __m128i bits = _mm_castps_si128( _mm_loadu_ps( pSource + i ) );
+
+			__m128i exponent	= _mm_sub_epi32( _mm_and_si128( _mm_srli_epi32( bits, 23 ), _mm_set1_epi32( 0xff ) ), _mm_set1_epi32( 126 ) );
+			__m128 m			= _mm_castsi128_ps( _mm_or_si128( _mm_and_si128( bits, _mm_set1_epi32( 0x007fffff ) ), _mm_set1_epi32( 0x3f000000 ) ) );
+
+			const __m128 small = _mm_cmplt_ps( m, _mm_set1_ps( 0.707106781186547524f ) );
+			exponent	= _mm_add_epi32( exponent, _mm_castps_si128( small ) );
+			m			= _mm_sub_ps( _mm_add_ps( m, _mm_and_ps( small, m ) ), _mm_set1_ps( 1.0f ) );
+
+			const __m128 e	= _mm_cvtepi32_ps( exponent );
+			const __m128 m2	= _mm_mul_ps( m, m );
+
+			__m128 result = _mm_add_ps( _mm_set1_ps( -1.1514610310e-1f ), _mm_mul_ps( m, _mm_set1_ps( 7.0376836292e-2f ) ) );
+			result = _mm_add_ps( _mm_set1_ps( 1.1676998740e-1f ), _mm_mul_ps( m, result ) );
+			result = _mm_add_ps( _mm_set1_ps( -1.2420140846e-1f ), _mm_mul_ps( m, result ) );
+			result = _mm_add_ps( _mm_set1_ps( 1.4249322787e-1f ), _mm_mul_ps( m, result ) );
+			result = _mm_add_ps( _mm_set1_ps( -1.6668057665e-1f ), _mm_mul_ps( m, result ) );
+			result = _mm_add_ps( _mm_set1_ps( 2.0000714765e-1f ), _mm_mul_ps( m, result ) );
+			result = _mm_add_ps( _mm_set1_ps( -2.4999993993e-1f ), _mm_mul_ps( m, result ) );
+			result = _mm_add_ps( _mm_set1_ps( 3.3333331174e-1f ), _mm_mul_ps( m, result ) );
+			result = _mm_mul_ps( _mm_mul_ps( m, m2 ), result );
+
+			result = _mm_add_ps( result, _mm_mul_ps( e, _mm_set1_ps( -2.12194440e-4f ) ) );
+			result = _mm_sub_ps( result, _mm_mul_ps( _mm_set1_ps( 0.5f ), m2 ) );
+			result = _mm_add_ps( _mm_add_ps( m, result ), _mm_mul_ps( e, _mm_set1_ps( 0.693359375f ) ) );
+
+			_mm_storeu_ps( pTarget + i, result );
+		}
+
+		logScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void inverseSquareRootSse41( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			// y * ( 3 - x * y * y ) / 2
+			const __m128 x = _mm_loadu_ps( pSource + i );
+			const __m128 y = _mm_rsqrt_ps( x );
+			const __m128 result = _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 0.5f ), y ), _mm_sub_ps( _mm_set1_ps( 3.0f ), _mm_mul_ps( _mm_mul_ps( x, y ), y ) ) );
+			_mm_storeu_ps( pTarget + i, result );
+		}
+
+		inverseSquareRootScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	// the same steps as f16::convertFloat32to16 for the lanes of each case, the result is in the low 16 bits
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION inline __m128i computeFloat16Sse41( const __m128 value )
+	{
+		const __m128i bits	= _mm_castps_si128( value );
+		const __m128i sign	= _mm_and_si128( bits, _mm_set1_epi32( sint32( 0x80000000u ) ) );
+		const __m128i x		= _mm_xor_si128( bits, sign );
+
+		const __m128i isNan		= _mm_cmpgt_epi32( x, _mm_set1_epi32( 0x7f800000 ) );
+		const __m128i nanBits	= _mm_or_si128( _mm_set1_epi32( 0x0200 ), _mm_and_si128( _mm_srli_epi32( x, 13 ), _mm_set1_epi32( 0x03ff ) ) );
+		const __m128i infNan	= _mm_or_si128( _mm_set1_epi32( 0x7c00 ), _mm_and_si128( isNan, nanBits ) );
+
+		const __m128i denormMagic	= _mm_set1_epi32( 0x3f000000 );
+		const __m128i denorm		= _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( _mm_castsi128_ps( x ), _mm_castsi128_ps( denormMagic ) ) ), denormMagic );
+
+		const __m128i mantissaOdd	= _mm_and_si128( _mm_srli_epi32( x, 13 ), _mm_set1_epi32( 1 ) );
+		const __m128i normal		= _mm_srli_epi32( _mm_add_epi32( _mm_add_epi32( x, _mm_set1_epi32( sint32( 0xc8000fffu ) ) ), mantissaOdd ), 13 );
+
+		__m128i result = _mm_blendv_epi8( normal, denorm, _mm_cmplt_epi32( x, _mm_set1_epi32( 0x38800000 ) ) );
+		result = _mm_blendv_epi8( result, infNan, _mm_cmpgt_epi32( x, _mm_set1_epi32( 0x477fffff ) ) );
+		return _mm_or_si128( result, _mm_srli_epi32( sign, 16 ) );
+	}
+
+	// the float16 bits in the low 16 bits of each lane
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION inline __m128 computeFloat32Sse41( const __m128i value )
+	{
+		const __m128i absValue = _mm_and_si128( value, _mm_set1_epi32( 0x7fff ) );
+		__m128i bits = _mm_add_epi32( _mm_slli_epi32( absValue, 13 ), _mm_set1_epi32( ( 127 - 15 ) << 23 ) );
+
+		// infinity and nan get the max exponent, nan gets quiet
+		const __m128i isInfNan	= _mm_cmpgt_epi32( absValue, _mm_set1_epi32( 0x7bff ) );
+		const __m128i isNan		= _mm_cmpgt_epi32( absValue, _mm_set1_epi32( 0x7c00 ) );
+		bits = _mm_add_epi32( bits, _mm_and_si128( isInfNan, _mm_set1_epi32( ( 128 - 16 ) << 23 ) ) );
+		bits = _mm_or_si128( bits, _mm_and_si128( isNan, _mm_set1_epi32( 0x00400000 ) ) );
+
+		const __m128i isDenorm	= _mm_cmplt_epi32( absValue, _mm_set1_epi32( 0x0400 ) );
+		const __m128 denorm		= _mm_sub_ps( _mm_castsi128_ps( _mm_add_epi32( bits, _mm_set1_epi32( 1 << 23 ) ) ), _mm_castsi128_ps( _mm_set1_epi32( 113 << 23 ) ) );
+
+		const __m128 result = _mm_blendv_ps( _mm_castsi128_ps( bits ), denorm, _mm_castsi128_ps( isDenorm ) );
+		return _mm_or_ps( result, _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( value, _mm_set1_epi32( 0x8000 ) ), 16 ) ) );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void convertFloat32ToFloat16Sse41( float16* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m128i low	= computeFloat16Sse41( _mm_loadu_ps( pSource + i ) );
+			const __m128i high	= computeFloat16Sse41( _mm_loadu_ps( pSource + i + 4u ) );
+			_mm_storeu_si128( (__m128i*)( pTarget + i ), _mm_packus_epi32( low, high ) );
+		}
+
+		convertFloat32ToFloat16Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void convertFloat16ToFloat32Sse41( float* pTarget, const float16* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m128i source = _mm_loadu_si128( (const __m128i*)( pSource + i ) );
+			_mm_storeu_ps( pTarget + i, computeFloat32Sse41( _mm_cvtepu16_epi32( source ) ) );
+			_mm_storeu_ps( pTarget + i + 4u, computeFloat32Sse41( _mm_cvtepu16_epi32( _mm_unpackhi_epi64( source, source ) ) ) );
+		}
+
+		convertFloat16ToFloat32Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION inline __m128i computeUnormSse41( const __m128 value, const __m128 scale )
+	{
+		const __m128 clamped = _mm_min_ps( _mm_max_ps( value, _mm_setzero_ps() ), _mm_set1_ps( 1.0f ) );
+		return _mm_cvtps_epi32( _mm_mul_ps( clamped, scale ) );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION inline __m128i computeSnormSse41( const __m128 value, const __m128 scale )
+	{
+		const __m128 ordered = _mm_and_ps( value, _mm_cmpord_ps( value, value ) );
+		const __m128 clamped = _mm_min_ps( _mm_max_ps( ordered, _mm_set1_ps( -1.0f ) ), _mm_set1_ps( 1.0f ) );
+		return _mm_cvtps_epi32( _mm_mul_ps( clamped, scale ) );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void packUnorm8Sse41( uint8* pTarget, const float* pSource, uint count )
+	{
+		const __m128 scale = _mm_set1_ps( 255.0f );
+
+		uint i = 0u;
+		for ( ; i + 16u <= count; i += 16u )
+		{
+			const __m128i low	= _mm_packus_epi32( computeUnormSse41( _mm_loadu_ps( pSource + i ), scale ), computeUnormSse41( _mm_loadu_ps( pSource + i + 4u ), scale ) );
+			const __m128i high	= _mm_packus_epi32( computeUnormSse41( _mm_loadu_ps( pSource + i + 8u ), scale ), computeUnormSse41( _mm_loadu_ps( pSource + i + 12u ), scale ) );
+			_mm_storeu_si128( (__m128i*)( pTarget + i ), _mm_packus_epi16( low, high ) );
+		}
+
+		packUnorm8Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void packSnorm8Sse41( sint8* pTarget, const float* pSource, uint count )
+	{
+		const __m128 scale = _mm_set1_ps( 127.0f );
+
+		uint i = 0u;
+		for ( ; i + 16u <= count; i += 16u )
+		{
+			const __m128i low	= _mm_packs_epi32( computeSnormSse41( _mm_loadu_ps( pSource + i ), scale ), computeSnormSse41( _mm_loadu_ps( pSource + i + 4u ), scale ) );
+			const __m128i high	= _mm_packs_epi32( computeSnormSse41( _mm_loadu_ps( pSource + i + 8u ), scale ), computeSnormSse41( _mm_loadu_ps( pSource + i + 12u ), scale ) );
+			_mm_storeu_si128( (__m128i*)( pTarget + i ), _mm_packs_epi16( low, high ) );
+		}
+
+		packSnorm8Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void packUnorm16Sse41( uint16* pTarget, const float* pSource, uint count )
+	{
+		const __m128 scale = _mm_set1_ps( 65535.0f );
+
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m128i result = _mm_packus_epi32( computeUnormSse41( _mm_loadu_ps( pSource + i ), scale ), computeUnormSse41( _mm_loadu_ps( pSource + i + 4u ), scale ) );
+			_mm_storeu_si128( (__m128i*)( pTarget + i ), result );
+		}
+
+		packUnorm16Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void packSnorm16Sse41( sint16* pTarget, const float* pSource, uint count )
+	{
+		const __m128 scale = _mm_set1_ps( 32767.0f );
+
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m128i result = _mm_packs_epi32( computeSnormSse41( _mm_loadu_ps( pSource + i ), scale ), computeSnormSse41( _mm_loadu_ps( pSource + i + 4u ), scale ) );
+			_mm_storeu_si128( (__m128i*)( pTarget + i ), result );
+		}
+
+		packSnorm16Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_SSE41_FUNCTION void packUnorm1010102Sse41( uint32* pTarget, const float* pSource, uint count )
+	{
+		const __m128 scale10	= _mm_set1_ps( 1023.0f );
+		const __m128 scale2		= _mm_set1_ps( 3.0f );
+
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			// four quadruples to one vector per component
+			const float* pValues = pSource + i * 4u;
+			__m128 x = _mm_loadu_ps( pValues );
+			__m128 y = _mm_loadu_ps( pValues + 4u );
+			__m128 z = _mm_loadu_ps( pValues + 8u );
+			__m128 w = _mm_loadu_ps( pValues + 12u );
+			_MM_TRANSPOSE4_PS( x, y, z, w );
+
+			__m128i result = computeUnormSse41( x, scale10 );
+			result = _mm_or_si128( result, _mm_slli_epi32( computeUnormSse41( y, scale10 ), 10 ) );
+			result = _mm_or_si128( result, _mm_slli_epi32( computeUnormSse41( z, scale10 ), 20 ) );
+			result = _mm_or_si128( result, _mm_slli_epi32( computeUnormSse41( w, scale2 ), 30 ) );
+			_mm_storeu_si128( (__m128i*)( pTarget + i ), result );
+		}
+
+		packUnorm1010102Scalar( pTarget + i, pSource + i * 4u, count - i );
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// avx2 + fma + f16c
+
+	// the scalar remainder is sse code. the compiler doesn't clear the upper halves before a tail call, so every
+	// kernel does it before the remainder to avoid the avx to sse transition penalty.
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION inline void leaveAvx2()
+	{
+		_mm256_zeroupper();
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void convertInt16ToFloatAvx2( float* pTarget, const sint16* pSource, float factor, uint count )
+	{
+		const __m256 simdFactor = _mm256_set1_ps( factor );
+
+		uint i = 0u;
+		for ( ; i + 16u <= count; i += 16u )
+		{
+			const __m128i source1 = _mm_loadu_si128( (const __m128i*)( pSource + i ) );
+			const __m128i source2 = _mm_loadu_si128( (const __m128i*)( pSource + i + 8u ) );
+
+			_mm256_storeu_ps( pTarget + i, _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32( source1 ) ), simdFactor ) );
+			_mm256_storeu_ps( pTarget + i + 8u, _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32( source2 ) ), simdFactor ) );
+		}
+
+		leaveAvx2();
+		convertInt16ToFloatScalar( pTarget + i, pSource + i, factor, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void multiplyAddAvx2( float* pTarget, const float* pA, const float* pB, const float* pC, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m256 result = _mm256_fmadd_ps( _mm256_loadu_ps( pA + i ), _mm256_loadu_ps( pB + i ), _mm256_loadu_ps( pC + i ) );
+			_mm256_storeu_ps( pTarget + i, result );
+		}
+
+		leaveAvx2();
+		multiplyAddScalar( pTarget + i, pA + i, pB + i, pC + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void hermiteAvx2( float* pTarget, const float* pP0, const float* pT0, const float* pP1, const float* pT1, const float* pTime, uint count )
+	{
+		const __m256 two	= _mm256_set1_ps( 2.0f );
+		const __m256 three	= _mm256_set1_ps( 3.0f );
+
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m256 p0		= _mm256_loadu_ps( pP0 + i );
+			const __m256 t0		= _mm256_loadu_ps( pT0 + i );
+			const __m256 t1		= _mm256_loadu_ps( pT1 + i );
+			const __m256 time	= _mm256_loadu_ps( pTime + i );
+			const __m256 delta	= _mm256_sub_ps( _mm256_loadu_ps( pP1 + i ), p0 );
+
+			const __m256 c2 = _mm256_sub_ps( _mm256_fmsub_ps( three, delta, _mm256_mul_ps( two, t0 ) ), t1 );
+			const __m256 c3 = _mm256_fnmadd_ps( two, delta, _mm256_add_ps( t0, t1 ) );
+
+			__m256 result = _mm256_fmadd_ps( time, c3, c2 );
+			result = _mm256_fmadd_ps( time, result, t0 );
+			result = _mm256_fmadd_ps( time, result, p0 );
+
+			_mm256_storeu_ps( pTarget + i, result );
+		}
+
+		leaveAvx2();
+		hermiteScalar( pTarget + i, pP0 + i, pT0 + i, pP1 + i, pT1 + i, pTime + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION inline void computeSinCosAvx2( __m256& sinValue, __m256& cosValue, const __m256 x )
+	{
+		const __m256 signMask	= _mm256_set1_ps( -0.0f );
+		const __m256 absX		= _mm256_andnot_ps( signMask, x );
+
+		const __m256 scaledX	= _mm256_min_ps( _mm256_mul_ps( absX, _mm256_set1_ps( 1.27323954473516f ) ), _mm256_set1_ps( 16777216.0f ) );
+		const __m256i octant	= _mm256_and_si256( _mm256_add_epi32( _mm256_cvttps_epi32( scaledX ), _mm256_set1_epi32( 1 ) ), _mm256_set1_epi32( ~1 ) );
+		const __m256 y			= _mm256_cvtepi32_ps( octant );
+
+		__m256 r = _mm256_fnmadd_ps( y, _mm256_set1_ps( 0.78515625f ), absX );
+		r = _mm256_fnmadd_ps( y, _mm256_set1_ps( 2.4187564849853515625e-4f ), r );
+		r = _mm256_fnmadd_ps( y, _mm256_set1_ps( 3.77489497744594108e-8f ), r );
+		const __m256 r2 = _mm256_mul_ps( r, r );
+
+		__m256 polySin = _mm256_fmadd_ps( r2, _mm256_set1_ps( -1.9515295891e-4f ), _mm256_set1_ps( 8.3321608736e-3f ) );
+		polySin = _mm256_fmadd_ps( r2, polySin, _mm256_set1_ps( -1.6666654611e-1f ) );
+		polySin = _mm256_fmadd_ps( _mm256_mul_ps( r, r2 ), polySin, r );
+
+		__m256 polyCos = _mm256_fmadd_ps( r2, _mm256_set1_ps( 2.443315711809948e-5f ), _mm256_set1_ps( -1.388731625493765e-3f ) );
+		polyCos = _mm256_fmadd_ps( r2, polyCos, _mm256_set1_ps( 4.166664568298827e-2f ) );
+		polyCos = _mm256_fmadd_ps( _mm256_mul_ps( r2, r2 ), polyCos, _mm256_fnmadd_ps( _mm256_set1_ps( 0.5f ), r2, _mm256_set1_ps( 1.0f ) ) );
+
+		const __m256 swap		= _mm256_castsi256_ps( _mm256_cmpeq_epi32( _mm256_and_si256( octant, _mm256_set1_epi32( 2 ) ), _mm256_set1_epi32( 2 ) ) );
+		const __m256 sinSign	= _mm256_xor_ps( _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_and_si256( octant, _mm256_set1_epi32( 4 ) ), 29 ) ), _mm256_and_ps( x, signMask ) );
+		const __m256 cosSign	= _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_and_si256( _mm256_add_epi32( octant, _mm256_set1_epi32( 2 ) ), _mm256_set1_epi32( 4 ) ), 29 ) );
+
+		sinValue = _mm256_xor_ps( _mm256_blendv_ps( polySin, polyCos, swap ), sinSign );
+		cosValue = _mm256_xor_ps( _mm256_blendv_ps( polyCos, polySin, swap ), cosSign );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void sinAvx2( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			__m256 sinValue;
+			__m256 cosValue;
+			computeSinCosAvx2( sinValue, cosValue, _mm256_loadu_ps( pSource + i ) );
+			_mm256_storeu_ps( pTarget + i, sinValue );
+		}
+
+		leaveAvx2();
+		sinScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void cosAvx2( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			__m256 sinValue;
+			__m256 cosValue;
+			computeSinCosAvx2( sinValue, cosValue, _mm256_loadu_ps( pSource + i ) );
+			_mm256_storeu_ps( pTarget + i, cosValue );
+		}
+
+		leaveAvx2();
+		cosScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void sinCosAvx2( float* pSinTarget, float* pCosTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			__m256 sinValue;
+			__m256 cosValue;
+			computeSinCosAvx2( sinValue, cosValue, _mm256_loadu_ps( pSource + i ) );
+			_mm256_storeu_ps( pSinTarget + i, sinValue );
+			_mm256_storeu_ps( pCosTarget + i, cosValue );
+		}
+
+		leaveAvx2();
+		sinCosScalar( pSinTarget + i, pCosTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void atan2Avx2( float* pTarget, const float* pY, const float* pX, uint count )
+	{
+		const __m256 signMask	= _mm256_set1_ps( -0.0f );
+		const __m256 zero		= _mm256_setzero_ps();
+		const __m256 one		= _mm256_set1_ps( 1.0f );
+
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m256 y		= _mm256_loadu_ps( pY + i );
+			const __m256 x		= _mm256_loadu_ps( pX + i );
+			const __m256 absY	= _mm256_andnot_ps( signMask, y );
+			const __m256 absX	= _mm256_andnot_ps( signMask, x );
+			const __m256 maxXY	= _mm256_max_ps( absX, absY );
+
+			__m256 t = _mm256_and_ps( _mm256_div_ps( _mm256_min_ps( absX, absY ), maxXY ), _mm256_cmp_ps( maxXY, zero, _CMP_GT_OQ ) );
+
+			const __m256 reduce	= _mm256_cmp_ps( t, _mm256_set1_ps( 0.4142135623730950f ), _CMP_GT_OQ );
+			t = _mm256_blendv_ps( t, _mm256_div_ps( _mm256_sub_ps( t, one ), _mm256_add_ps( t, one ) ), reduce );
+			const __m256 t2		= _mm256_mul_ps( t, t );
+
+			__m256 result = _mm256_fmadd_ps( t2, _mm256_set1_ps( 8.05374449538e-2f ), _mm256_set1_ps( -1.38776856032e-1f ) );
+			result = _mm256_fmadd_ps( t2, result, _mm256_set1_ps( 1.99777106478e-1f ) );
+			result = _mm256_fmadd_ps( t2, result, _mm256_set1_ps( -3.33329491539e-1f ) );
+			result = _mm256_fmadd_ps( _mm256_mul_ps( t, t2 ), result, _mm256_add_ps( _mm256_and_ps( reduce, _mm256_set1_ps( f32::piOver4 ) ), t ) );
+
+			result = _mm256_blendv_ps( result, _mm256_sub_ps( _mm256_set1_ps( f32::piOver2 ), result ), _mm256_cmp_ps( absY, absX, _CMP_GT_OQ ) );
+			result = _mm256_blendv_ps( result, _mm256_sub_ps( _mm256_set1_ps( f32::pi ), result ), _mm256_cmp_ps( x, zero, _CMP_LT_OQ ) );
+			result = _mm256_xor_ps( result, _mm256_and_ps( _mm256_cmp_ps( y, zero, _CMP_LT_OQ ), signMask ) );
+
+			_mm256_storeu_ps( pTarget + i, result );
+		}
+
+		leaveAvx2();
+		atan2Scalar( pTarget + i, pY + i, pX + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void expAvx2( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m256 x = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( pSource + i ), _mm256_set1_ps( -87.33654f ) ), _mm256_set1_ps( 88.37626f ) );
+
+			const __m256 fn	= _mm256_fmadd_ps( x, _mm256_set1_ps( 1.44269504088896341f ), _mm256_set1_ps( 0.5f ) );
+			__m256i n		= _mm256_cvttps_epi32( fn );
+			n = _mm256_add_epi32( n, _mm256_castps_si256( _mm256_cmp_ps( _mm256_cvtepi32_ps( n ), fn, _CMP_GT_OQ ) ) );
+
+			const __m256 y	= _mm256_cvtepi32_ps( n );
+			const __m256 r	= _mm256_fnmadd_ps( y, _mm256_set1_ps( -2.12194440e-4f ), _mm256_fnmadd_ps( y, _mm256_set1_ps( 0.693359375f ), x ) );
+
+			__m256 poly = _mm256_fmadd_ps( r, _mm256_set1_ps( 1.9875691500e-4f ), _mm256_set1_ps( 1.3981999507e-3f ) );
+			poly = _mm256_fmadd_ps( r, poly, _mm256_set1_ps( 8.3334519073e-3f ) );
+			poly = _mm256_fmadd_ps( r, poly, _mm256_set1_ps( 4.1665795894e-2f ) );
+			poly = _mm256_fmadd_ps( r, poly, _mm256_set1_ps( 1.6666665459e-1f ) );
+			poly = _mm256_fmadd_ps( r, poly, _mm256_set1_ps( 5.0000001201e-1f ) );
+			poly = _mm256_fmadd_ps( _mm256_mul_ps( r, r ), poly, _mm256_add_ps( _mm256_set1_ps( 1.0f ), r ) );
+
+			const __m256 scale = _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_add_epi32( n, _mm256_set1_epi32( 127 ) ), 23 ) );
+			_mm256_storeu_ps( pTarget + i, _mm256_mul_ps( poly, scale ) );
+		}
+
+		leaveAvx2();
+		expScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void logAvx2( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m256i bits = _mm256_castps_si256( _mm256_loadu_ps( pSource + i ) );
+
+			__m256i exponent	= _mm256_sub_epi32( _mm256_and_si256( _mm256_srli_epi32( bits, 23 ), _mm256_set1_epi32( 0xff ) ), _mm256_set1_epi32( 126 ) );
+			__m256 m			= _mm256_castsi256_ps( _mm256_or_si256( _mm256_and_si256( bits, _mm256_set1_epi32( 0x007fffff ) ), _mm256_set1_epi32( 0x3f000000 ) ) );
+
+			const __m256 small = _mm256_cmp_ps( m, _mm256_set1_ps( 0.707106781186547524f ), _CMP_LT_OQ );
+			exponent	= _mm256_add_epi32( exponent, _mm256_castps_si256( small ) );
+			m			= _mm256_sub_ps( _mm256_add_ps( m, _mm256_and_ps( small, m ) ), _mm256_set1_ps( 1.0f ) );
+
+			const __m256 e	= _mm256_cvtepi32_ps( exponent );
+			const __m256 m2	= _mm256_mul_ps( m, m );
+
+			__m256 result = _mm256_fmadd_ps( m, _mm256_set1_ps( 7.0376836292e-2f ), _mm256_set1_ps( -1.1514610310e-1f ) );
+			result = _mm256_fmadd_ps( m, result, _mm256_set1_ps( 1.1676998740e-1f ) );
+			result = _mm256_fmadd_ps( m, result, _mm256_set1_ps( -1.2420140846e-1f ) );
+			result = _mm256_fmadd_ps( m, result, _mm256_set1_ps( 1.4249322787e-1f ) );
+			result = _mm256_fmadd_ps( m, result, _mm256_set1_ps( -1.6668057665e-1f ) );
+			result = _mm256_fmadd_ps( m, result, _mm256_set1_ps( 2.0000714765e-1f ) );
+			result = _mm256_fmadd_ps( m, result, _mm256_set1_ps( -2.4999993993e-1f ) );
+			result = _mm256_fmadd_ps( m, result, _mm256_set1_ps( 3.3333331174e-1f ) );
+			result = _mm256_mul_ps( _mm256_mul_ps( m, m2 ), result );
+
+			result = _mm256_fmadd_ps( e, _mm256_set1_ps( -2.12194440e-4f ), result );
+			result = _mm256_fnmadd_ps( _mm256_set1_ps( 0.5f ), m2, result );
+			result = _mm256_fmadd_ps( e, _mm256_set1_ps( 0.693359375f ), _mm256_add_ps( m, result ) );
+
+			_mm256_storeu_ps( pTarget + i, result );
+		}
+
+		leaveAvx2();
+		logScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void inverseSquareRootAvx2( float* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			const __m256 x = _mm256_loadu_ps( pSource + i );
+			const __m256 y = _mm256_rsqrt_ps( x );
+			const __m256 result = _mm256_mul_ps( _mm256_mul_ps( _mm256_set1_ps( 0.5f ), y ), _mm256_fnmadd_ps( _mm256_mul_ps( x, y ), y, _mm256_set1_ps( 3.0f ) ) );
+			_mm256_storeu_ps( pTarget + i, result );
+		}
+
+		leaveAvx2();
+		inverseSquareRootScalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void convertFloat32ToFloat16Avx2( float16* pTarget, const float* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 16u <= count; i += 16u )
+		{
+			_mm_storeu_si128( (__m128i*)( pTarget + i ), _mm256_cvtps_ph( _mm256_loadu_ps( pSource + i ), _MM_FROUND_TO_NEAREST_INT ) );
+			_mm_storeu_si128( (__m128i*)( pTarget + i + 8u ), _mm256_cvtps_ph( _mm256_loadu_ps( pSource + i + 8u ), _MM_FROUND_TO_NEAREST_INT ) );
+		}
+
+		leaveAvx2();
+		convertFloat32ToFloat16Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void convertFloat16ToFloat32Avx2( float* pTarget, const float16* pSource, uint count )
+	{
+		uint i = 0u;
+		for ( ; i + 16u <= count; i += 16u )
+		{
+			_mm256_storeu_ps( pTarget + i, _mm256_cvtph_ps( _mm_loadu_si128( (const __m128i*)( pSource + i ) ) ) );
+			_mm256_storeu_ps( pTarget + i + 8u, _mm256_cvtph_ps( _mm_loadu_si128( (const __m128i*)( pSource + i + 8u ) ) ) );
+		}
+
+		leaveAvx2();
+		convertFloat16ToFloat32Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION inline __m256i computeUnormAvx2( const __m256 value, const __m256 scale )
+	{
+		const __m256 clamped = _mm256_min_ps( _mm256_max_ps( value, _mm256_setzero_ps() ), _mm256_set1_ps( 1.0f ) );
+		return _mm256_cvtps_epi32( _mm256_mul_ps( clamped, scale ) );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION inline __m256i computeSnormAvx2( const __m256 value, const __m256 scale )
+	{
+		const __m256 ordered = _mm256_and_ps( value, _mm256_cmp_ps( value, value, _CMP_ORD_Q ) );
+		const __m256 clamped = _mm256_min_ps( _mm256_max_ps( ordered, _mm256_set1_ps( -1.0f ) ), _mm256_set1_ps( 1.0f ) );
+		return _mm256_cvtps_epi32( _mm256_mul_ps( clamped, scale ) );
+	}
+
+	// the packs work per 128 bit lane, the permutes restore the order
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void packUnorm8Avx2( uint8* pTarget, const float* pSource, uint count )
+	{
+		const __m256 scale		= _mm256_set1_ps( 255.0f );
+		const __m256i order		= _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+		uint i = 0u;
+		for ( ; i + 32u <= count; i += 32u )
+		{
+			const __m256i low	= _mm256_packus_epi32( computeUnormAvx2( _mm256_loadu_ps( pSource + i ), scale ), computeUnormAvx2( _mm256_loadu_ps( pSource + i + 8u ), scale ) );
+			const __m256i high	= _mm256_packus_epi32( computeUnormAvx2( _mm256_loadu_ps( pSource + i + 16u ), scale ), computeUnormAvx2( _mm256_loadu_ps( pSource + i + 24u ), scale ) );
+			_mm256_storeu_si256( (__m256i*)( pTarget + i ), _mm256_permutevar8x32_epi32( _mm256_packus_epi16( low, high ), order ) );
+		}
+
+		leaveAvx2();
+		packUnorm8Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void packSnorm8Avx2( sint8* pTarget, const float* pSource, uint count )
+	{
+		const __m256 scale		= _mm256_set1_ps( 127.0f );
+		const __m256i order		= _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+		uint i = 0u;
+		for ( ; i + 32u <= count; i += 32u )
+		{
+			const __m256i low	= _mm256_packs_epi32( computeSnormAvx2( _mm256_loadu_ps( pSource + i ), scale ), computeSnormAvx2( _mm256_loadu_ps( pSource + i + 8u ), scale ) );
+			const __m256i high	= _mm256_packs_epi32( computeSnormAvx2( _mm256_loadu_ps( pSource + i + 16u ), scale ), computeSnormAvx2( _mm256_loadu_ps( pSource + i + 24u ), scale ) );
+			_mm256_storeu_si256( (__m256i*)( pTarget + i ), _mm256_permutevar8x32_epi32( _mm256_packs_epi16( low, high ), order ) );
+		}
+
+		leaveAvx2();
+		packSnorm8Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void packUnorm16Avx2( uint16* pTarget, const float* pSource, uint count )
+	{
+		const __m256 scale = _mm256_set1_ps( 65535.0f );
+
+		uint i = 0u;
+		for ( ; i + 16u <= count; i += 16u )
+		{
+			const __m256i result = _mm256_packus_epi32( computeUnormAvx2( _mm256_loadu_ps( pSource + i ), scale ), computeUnormAvx2( _mm256_loadu_ps( pSource + i + 8u ), scale ) );
+			_mm256_storeu_si256( (__m256i*)( pTarget + i ), _mm256_permute4x64_epi64( result, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+		}
+
+		leaveAvx2();
+		packUnorm16Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void packSnorm16Avx2( sint16* pTarget, const float* pSource, uint count )
+	{
+		const __m256 scale = _mm256_set1_ps( 32767.0f );
+
+		uint i = 0u;
+		for ( ; i + 16u <= count; i += 16u )
+		{
+			const __m256i result = _mm256_packs_epi32( computeSnormAvx2( _mm256_loadu_ps( pSource + i ), scale ), computeSnormAvx2( _mm256_loadu_ps( pSource + i + 8u ), scale ) );
+			_mm256_storeu_si256( (__m256i*)( pTarget + i ), _mm256_permute4x64_epi64( result, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+		}
+
+		leaveAvx2();
+		packSnorm16Scalar( pTarget + i, pSource + i, count - i );
+	}
+
+	static TIKI_SIMDKERNELS_AVX2_FUNCTION void packUnorm1010102Avx2( uint32* pTarget, const float* pSource, uint count )
+	{
+		const __m256 scale10	= _mm256_set1_ps( 1023.0f );
+		const __m256 scale2		= _mm256_set1_ps( 3.0f );
+
+		uint i = 0u;
+		for ( ; i + 8u <= count; i += 8u )
+		{
+			// quadruple n in the low and n + 4 in the high lane, so the transpose per lane keeps the order
+			const float* pValues = pSource + i * 4u;
+			const __m256 row0 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( pValues ) ), _mm_loadu_ps( pValues + 16u ), 1 );
+			const __m256 row1 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( pValues + 4u ) ), _mm_loadu_ps( pValues + 20u ), 1 );
+			const __m256 row2 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( pValues + 8u ) ), _mm_loadu_ps( pValues + 24u ), 1 );
+			const __m256 row3 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( pValues + 12u ) ), _mm_loadu_ps( pValues + 28u ), 1 );
+
+			const __m256 xy01 = _mm256_unpacklo_ps( row0, row1 );
+			const __m256 zw01 = _mm256_unpackhi_ps( row0, row1 );
+			const __m256 xy23 = _mm256_unpacklo_ps( row2, row3 );
+			const __m256 zw23 = _mm256_unpackhi_ps( row2, row3 );
+
+			const __m256 x = _mm256_shuffle_ps( xy01, xy23, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+			const __m256 y = _mm256_shuffle_ps( xy01, xy23, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+			const __m256 z = _mm256_shuffle_ps( zw01, zw23, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+			const __m256 w = _mm256_shuffle_ps( zw01, zw23, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+
+			__m256i result = computeUnormAvx2( x, scale10 );
+			result = _mm256_or_si256( result, _mm256_slli_epi32( computeUnormAvx2( y, scale10 ), 10 ) );
+			result = _mm256_or_si256( result, _mm256_slli_epi32( computeUnormAvx2( z, scale10 ), 20 ) );
+			result = _mm256_or_si256( result, _mm256_slli_epi32( computeUnormAvx2( w, scale2 ), 30 ) );
+			_mm256_storeu_si256( (__m256i*)( pTarget + i ), result );
+		}
+
+		leaveAvx2();
+		packUnorm1010102Scalar( pTarget + i, pSource + i * 4u, count - i );
+	}
+#endif
+
+	static const SimdKernels s_aKernels[] =
+	{
+		{
+			&convertInt16ToFloatScalar, &multiplyAddScalar, &hermiteScalar, &sinScalar, &cosScalar, &sinCosScalar, &atan2Scalar, &expScalar, &logScalar, &inverseSquareRootScalar,
+			&convertFloat32ToFloat16Scalar, &convertFloat16ToFloat32Scalar, &packUnorm8Scalar, &packSnorm8Scalar, &packUnorm16Scalar, &packSnorm16Scalar, &packUnorm1010102Scalar
+		},
+#if TIKI_ENABLED( TIKI_SIMDKERNELS_X86 )
+		{
+			&convertInt16ToFloatSse41, &multiplyAddSse41, &hermiteSse41, &sinSse41, &cosSse41, &sinCosSse41, &atan2Sse41, &expSse41, &logSse41, &inverseSquareRootSse41,
+			&convertFloat32ToFloat16Sse41, &convertFloat16ToFloat32Sse41, &packUnorm8Sse41, &packSnorm8Sse41, &packUnorm16Sse41, &packSnorm16Sse41, &packUnorm1010102Sse41
+		},
+		{
+			&convertInt16ToFloatAvx2, &multiplyAddAvx2, &hermiteAvx2, &sinAvx2, &cosAvx2, &sinCosAvx2, &atan2Avx2, &expAvx2, &logAvx2, &inverseSquareRootAvx2,
+			&convertFloat32ToFloat16Avx2, &convertFloat16ToFloat32Avx2, &packUnorm8Avx2, &packSnorm8Avx2, &packUnorm16Avx2, &packSnorm16Avx2, &packUnorm1010102Avx2
+		},
+#endif
+	};
+
+	static const char* s_apKernelLevelNames[] =
+	{
+		"scalar",
+		"sse41",
+		"avx2"
+	};
+	TIKI_COMPILETIME_ASSERT( TIKI_COUNT( s_apKernelLevelNames ) == SimdKernelLevel_Count );
+
+	static bool isKernelLevelSupported( SimdKernelLevel level )
+	{
+		switch ( level )
+		{
+		case SimdKernelLevel_Scalar:
+			return true;
+
+#if TIKI_ENABLED( TIKI_SIMDKERNELS_X86 )
+		case SimdKernelLevel_Sse41:
+			return platform::hasCpuFeature( CpuFeature_Sse41 );
+
+		case SimdKernelLevel_Avx2:
+			return platform::hasCpuFeature( CpuFeature_Avx2 ) && platform::hasCpuFeature( CpuFeature_Fma ) && platform::hasCpuFeature( CpuFeature_F16c );
+#endif
+
+		default:
+			break;
+		}
+
+		return false;
+	}
+
+	// constant initialized. the detection writes the same value from every thread.
+	static SimdKernelLevel s_kernelLevel = SimdKernelLevel_Count;
+
+	SimdKernelLevel simd::getKernelLevel()
+	{
+		SimdKernelLevel level = s_kernelLevel;
+		if ( level == SimdKernelLevel_Count )
+		{
+			level = SimdKernelLevel_Scalar;
+			for (uint i = SimdKernelLevel_Count - 1u; i > SimdKernelLevel_Scalar; --i)
+			{
+				if ( isKernelLevelSupported( (SimdKernelLevel)i ) )
+				{
+					level = (SimdKernelLevel)i;
+					break;
+				}
+			}
+
+			s_kernelLevel = level;
+		}
+
+		return level;
+	}
+
+	const SimdKernels& simd::getKernels()
+	{
+		return s_aKernels[ getKernelLevel() ];
+	}
+
+	const SimdKernels* simd::getKernels( SimdKernelLevel level )
+	{
+		TIKI_ASSERT( level < SimdKernelLevel_Count );
+
+		if ( !isKernelLevelSupported( level ) )
+		{
+			return nullptr;
+		}
+
+		return &s_aKernels[ level ];
+	}
+
+	const char* simd::getKernelLevelName( SimdKernelLevel level )
+	{
+		TIKI_ASSERT( level < SimdKernelLevel_Count );
+		return s_apKernelLevelNames[ level ];
+	}
+}
@@ -0,0 +1,284 @@
+#pragma once
+#ifndef __TIKI_SORT_INL_INCLUDED__
+#define __TIKI_SORT_INL_INCLUDED__
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	namespace sort
+	{
+		enum
+		{
+			// ranges up to this size are finished with insertion sort
+			InsertionSortThreshold	= 16u,
+
+			RadixDigitBits			= 8u,
+			RadixDigitCount			= 1u << RadixDigitBits
+		};
+
+		template<typename T, typename TLess>
+		TIKI_FORCE_INLINE void siftDown( T* pData, uint index, uint count, TLess& isLess )
+		{
+			T value = pData[ index ];
+			while ( true )
+			{
+				uint child = ( index * 2u ) + 1u;
+				if ( child >= count )
+				{
+					break;
+				}
+
+				if ( child + 1u < count && isLess( pData[ child ], pData[ child + 1u ] ) )
+				{
+					child++;
+				}
+
+				if ( !isLess( value, pData[ child ] ) )
+				{
+					break;
+				}
+
+				pData[ index ] = pData[ child ];
+				index = child;
+			}
+			pData[ index ] = value;
+		}
+
+		// moves the median of first, middle and last to the first element
+		template<typename T, typename TLess>
+		TIKI_FORCE_INLINE void selectPivot( T* pData, uint count, TLess& isLess )
+		{
+			T* pFirst	= pData;
+			T* pMiddle	= pData + ( count / 2u );
+			T* pLast	= pData + count - 1u;
+
+			if ( isLess( *pMiddle, *pFirst ) )	swap( *pMiddle, *pFirst );
+			if ( isLess( *pLast, *pMiddle ) )	swap( *pLast, *pMiddle );
+			if ( isLess( *pMiddle, *pFirst ) )	swap( *pMiddle, *pFirst );
+
+			swap( *pFirst, *pMiddle );
+		}
+
+		// hoare partition around the first element. equal elements are spread over both sides, so many equal keys
+		// don't degenerate to O(n^2).
+		template<typename T, typename TLess>
+		TIKI_FORCE_INLINE uint partition( T* pData, uint count, TLess& isLess )
+		{
+			const T pivot = pData[ 0u ];
+
+			uint left	= 0u;
+			uint right	= count;
+			while ( true )
+			{
+				do { left++; } while ( left < count && isLess( pData[ left ], pivot ) );
+				do { right--; } while ( isLess( pivot, pData[ right ] ) );
+
+				if ( left >= right )
+				{
+					break;
+				}
+
+				swap( pData[ left ], pData[ right ] );
+			}
+
+			swap( pData[ 0u ], pData[ right ] );
+			return right;
+		}
+
+		template<typename T, typename TLess>
+		void introSortLoop( T* pData, uint count, uint depthLimit, TLess& isLess )
+		{
+			while ( count > InsertionSortThreshold )
+			{
+				if ( depthLimit == 0u )
+				{
+					heapSort( pData, count, isLess );
+					return;
+				}
+				depthLimit--;
+
+				selectPivot( pData, count, isLess );
+				const uint pivotIndex = partition( pData, count, isLess );
+
+				// recursion into the smaller part, so the stack depth is O(log n)
+				const uint leftCount	= pivotIndex;
+				const uint rightCount	= count - pivotIndex - 1u;
+				if ( leftCount < rightCount )
+				{
+					introSortLoop( pData, leftCount, depthLimit, isLess );
+					pData	+= pivotIndex + 1u;
+					count	= rightCount;
+				}
+				else
+				{
+					introSortLoop( pData + pivotIndex + 1u, rightCount, depthLimit, isLess );
+					count	= leftCount;
+				}
+			}
+
+			insertionSort( pData, count, isLess );
+		}
+	}
+
+	template<typename T>
+	void quickSort( T* pData, uint count )
+	{
+		introSort( pData, count, SortLess< T >() );
+	}
+
+	template<typename T>
+	void quickSortRange( T* pData, uint left, uint right )
+	{
+		if ( right <= left )
+		{
+			return;
+		}
+
+		introSort( pData + left, right - left + 1u, SortLess< T >() );
+	}
+
+	template<typename T, typename TLess>
+	void introSort( T* pData, uint count, TLess isLess )
+	{
+		if ( count < 2u )
+		{
+			return;
+		}
+
+		const uint depthLimit = 2u * ( 64u - countLeadingZeros64( count ) );
+		sort::introSortLoop( pData, count, depthLimit, isLess );
+	}
+
+	template<typename T, typename TLess>
+	void insertionSort( T* pData, uint count, TLess isLess )
+	{
+		for (uint i = 1u; i < count; ++i)
+		{
+			if ( !isLess( pData[ i ], pData[ i - 1u ] ) )
+			{
+				continue;
+			}
+
+			T value = pData[ i ];
+			uint j = i;
+			do
+			{
+				pData[ j ] = pData[ j - 1u ];
+				j--;
+			}
+			while ( j > 0u && isLess( value, pData[ j - 1u ] ) );
+
+			pData[ j ] = value;
+		}
+	}
+
+	template<typename T, typename TLess>
+	void heapSort( T* pData, uint count, TLess isLess )
+	{
+		if ( count < 2u )
+		{
+			return;
+		}
+
+		for (uint i = count / 2u; i > 0u; --i)
+		{
+			sort::siftDown( pData, i - 1u, count, isLess );
+		}
+
+		for (uint i = count - 1u; i > 0u; --i)
+		{
+			swap( pData[ 0u ], pData[ i ] );
+			sort::siftDown( pData, 0u, i, isLess );
+		}
+	}
+
+	template<typename T, typename TKeyExtractor>
+	void radixSort( T* pData, T* pScratch, uint count, TKeyExtractor getKey )
+	{
+		TIKI_ASSERT( pScratch != nullptr || count < 2u );
+		if ( count < 2u )
+		{
+			return;
+		}
+
+		// sizeof doesn't call getKey
+		const uint keySize = sizeof( getKey( pData[ 0u ] ) );
+		TIKI_COMPILETIME_ASSERT( sizeof( getKey( pData[ 0u ] ) ) == 4u || sizeof( getKey( pData[ 0u ] ) ) == 8u );
+
+		// all histograms in one pass over the data
+		uint aaHistograms[ 8u ][ sort::RadixDigitCount ];
+		memory::zero( aaHistograms, sizeof( aaHistograms[ 0u ] ) * keySize );
+
+		for (uint i = 0u; i < count; ++i)
+		{
+			const uint64 key = uint64( getKey( pData[ i ] ) );
+			for (uint digit = 0u; digit < keySize; ++digit)
+			{
+				aaHistograms[ digit ][ ( key >> ( digit * sort::RadixDigitBits ) ) & ( sort::RadixDigitCount - 1u ) ]++;
+			}
+		}
+
+		T* pSource = pData;
+		T* pTarget = pScratch;
+		for (uint digit = 0u; digit < keySize; ++digit)
+		{
+			uint* pHistogram = aaHistograms[ digit ];
+			const uint shift = digit * sort::RadixDigitBits;
+
+			// all elements have the same digit
+			if ( pHistogram[ ( uint64( getKey( pSource[ 0u ] ) ) >> shift ) & ( sort::RadixDigitCount - 1u ) ] == count )
+			{
+				continue;
+			}
+
+			uint offset = 0u;
+			for (uint i = 0u; i < sort::RadixDigitCount; ++i)
+			{
+				const uint digitCount = pHistogram[ i ];
+				pHistogram[ i ] = offset;
+				offset += digitCount;
+			}
+
+			for (uint i = 0u; i < count; ++i)
+			{
+				const uint index = uint( ( uint64( getKey( pSource[ i ] ) ) >> shift ) & ( sort::RadixDigitCount - 1u ) );
+				pTarget[ pHistogram[ index ]++ ] = pSource[ i ];
+			}
+
+			swap( pSource, pTarget );
+		}
+
+		if ( pSource != pData )
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pData[ i ] = pSource[ i ];
+			}
+		}
+	}
+
+	TIKI_FORCE_INLINE uint32 getRadixSortKey( sint32 value )
+	{
+		return uint32( value ) ^ 0x80000000u;
+	}
+
+	TIKI_FORCE_INLINE uint32 getRadixSortKey( float value )
+	{
+		union
+		{
+			float	floatValue;
+			uint32	bits;
+		} converter;
+		converter.floatValue = value;
+		const uint32 bits = converter.bits;
+
+		// negative values are reversed, positive values get the sign bit
+		const uint32 mask = uint32( -sint32( bits >> 31u ) ) | 0x80000000u;
+		return bits ^ mask;
+	}
+}
+
+#endif // __TIKI_SORT_INL_INCLUDED__
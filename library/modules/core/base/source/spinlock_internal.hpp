@@ -0,0 +1,65 @@
+#pragma once
+#ifndef TIKI_SPINLOCK_INTERNAL_HPP_INCLUDED
+#define TIKI_SPINLOCK_INTERNAL_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+#include "engineallocator_internal.hpp"
+
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+#	include <intrin.h>
+#endif
+
+namespace tiki
+{
+	// lock for the short critical sections of the base module. base can't use the SpinLock of the threading module,
+	// because threading depends on base. zero is unlocked.
+	namespace spinlock
+	{
+		enum
+		{
+			YieldSpinCount	= 64u
+		};
+
+		TIKI_FORCE_INLINE bool	tryLock( volatile uint32& lockState )
+		{
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+			return _InterlockedExchange( (volatile long*)&lockState, 1 ) == 0;
+#else
+			return __atomic_exchange_n( &lockState, 1u, __ATOMIC_ACQUIRE ) == 0u;
+#endif
+		}
+
+		TIKI_FORCE_INLINE void	lock( volatile uint32& lockState )
+		{
+			uint spinCount = 0u;
+			while ( !tryLock( lockState ) )
+			{
+				// spin on a load, the exchange would take the cache line from the owner
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+				while ( lockState != 0u )
+#else
+				while ( __atomic_load_n( &lockState, __ATOMIC_RELAXED ) != 0u )
+#endif
+				{
+					if ( ++spinCount >= YieldSpinCount )
+					{
+						engineallocator::yieldThread();
+						spinCount = 0u;
+					}
+				}
+			}
+		}
+
+		TIKI_FORCE_INLINE void	unlock( volatile uint32& lockState )
+		{
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+			_InterlockedExchange( (volatile long*)&lockState, 0 );
+#else
+			__atomic_store_n( &lockState, 0u, __ATOMIC_RELEASE );
+#endif
+		}
+	}
+}
+
+#endif // TIKI_SPINLOCK_INTERNAL_HPP_INCLUDED
@@ -0,0 +1,212 @@
+#include "tiki/base/stringid.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/basicstring.hpp"
+#include "tiki/base/crc32.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+#include "tiki/base/string.hpp"
+
+#include "engineallocator_internal.hpp"
+#include "spinlock_internal.hpp"
+
+namespace tiki
+{
+	enum
+	{
+		// entries are stored in chunks and the bucket array is allocated in multiples of this size
+		StringIdChunkSize	= 64u * 1024u
+	};
+
+	// the table lives for the whole program and uses system memory directly, so it doesn't show up as leak
+	struct StringIdTable
+	{
+		volatile uint32				lock;
+
+		const StringId::Entry**		ppBuckets;
+		uint						bucketCount;
+		uint						bucketsSize;
+		uint						entryCount;
+
+		uint8*						pChunk;
+		uint						chunkOffset;
+		uint						chunkSize;
+	};
+
+	static StringIdTable s_stringIdTable;
+
+	static TIKI_FORCE_INLINE const char* getStringIdEntryString( const StringId::Entry* pEntry )
+	{
+		return (const char*)( pEntry + 1u );
+	}
+
+	static const StringId::Entry* findStringIdEntry( const StringIdTable& table, const char* pString, uint length, crc32 crc )
+	{
+		if ( table.bucketCount == 0u )
+		{
+			return nullptr;
+		}
+
+		const StringId::Entry* pEntry = table.ppBuckets[ crc & ( table.bucketCount - 1u ) ];
+		while ( pEntry != nullptr )
+		{
+			if ( pEntry->crc == crc && pEntry->length == length && memory::compare( getStringIdEntryString( pEntry ), pString, length ) == 0 )
+			{
+				return pEntry;
+			}
+
+			pEntry = pEntry->pNext;
+		}
+
+		return nullptr;
+	}
+
+	static bool growStringIdBuckets( StringIdTable& table )
+	{
+		const uint newBucketCount	= ( table.bucketCount == 0u ? StringIdChunkSize / sizeof( StringId::Entry* ) : table.bucketCount * 2u );
+		const uint newBucketsSize	= newBucketCount * sizeof( StringId::Entry* );
+
+		const StringId::Entry** ppNewBuckets = (const StringId::Entry**)engineallocator::allocateSystemMemory( newBucketsSize, StringIdChunkSize );
+		if ( ppNewBuckets == nullptr )
+		{
+			return false;
+		}
+		memory::zero( ppNewBuckets, newBucketsSize );
+
+		for (uint i = 0u; i < table.bucketCount; ++i)
+		{
+			const StringId::Entry* pEntry = table.ppBuckets[ i ];
+			while ( pEntry != nullptr )
+			{
+				const StringId::Entry* pNext = pEntry->pNext;
+
+				StringId::Entry* pMutableEntry = const_cast< StringId::Entry* >( pEntry );
+				const StringId::Entry** ppBucket = &ppNewBuckets[ pEntry->crc & ( newBucketCount - 1u ) ];
+				pMutableEntry->pNext = *ppBucket;
+				*ppBucket = pEntry;
+
+				pEntry = pNext;
+			}
+		}
+
+		if ( table.ppBuckets != nullptr )
+		{
+			engineallocator::freeSystemMemory( table.ppBuckets, table.bucketsSize );
+		}
+
+		table.ppBuckets		= ppNewBuckets;
+		table.bucketCount	= newBucketCount;
+		table.bucketsSize	= newBucketsSize;
+		return true;
+	}
+
+	static StringId::Entry* allocateStringIdEntry( StringIdTable& table, uint length )
+	{
+		const uint entrySize = alignValue( uint( sizeof( StringId::Entry ) + length + 1u ), (uint)TIKI_ALIGNOF( StringId::Entry ) );
+		if ( table.pChunk == nullptr || table.chunkOffset + entrySize > table.chunkSize )
+		{
+			// the rest of the old chunk is wasted
+			const uint chunkSize = alignValue( entrySize, (uint)StringIdChunkSize );
+			uint8* pChunk = (uint8*)engineallocator::allocateSystemMemory( chunkSize, StringIdChunkSize );
+			if ( pChunk == nullptr )
+			{
+				return nullptr;
+			}
+
+			table.pChunk		= pChunk;
+			table.chunkOffset	= 0u;
+			table.chunkSize		= chunkSize;
+		}
+
+		StringId::Entry* pEntry = (StringId::Entry*)( table.pChunk + table.chunkOffset );
+		table.chunkOffset += entrySize;
+
+		return pEntry;
+	}
+
+	StringId::StringId( const char* pString )
+	{
+		TIKI_ASSERT( pString != nullptr );
+		intern( pString, getStringSize( pString ) );
+	}
+
+	StringId::StringId( const char* pString, uint length )
+	{
+		intern( pString, length );
+	}
+
+	StringId::StringId( const BasicString& string )
+	{
+		intern( string.cStr(), string.getLength() );
+	}
+
+	StringId StringId::find( const char* pString )
+	{
+		TIKI_ASSERT( pString != nullptr );
+
+		const uint length	= getStringSize( pString );
+		const crc32 crc		= crcBytes( pString, length );
+
+		StringIdTable& table = s_stringIdTable;
+		spinlock::lock( table.lock );
+		StringId result;
+		result.m_pEntry = findStringIdEntry( table, pString, length, crc );
+		spinlock::unlock( table.lock );
+
+		return result;
+	}
+
+	uint StringId::getInternedCount()
+	{
+		return s_stringIdTable.entryCount;
+	}
+
+	void StringId::intern( const char* pString, uint length )
+	{
+		m_pEntry = nullptr;
+		if ( length == 0u )
+		{
+			return;
+		}
+
+		// hash outside of the lock
+		const crc32 crc = crcBytes( pString, length );
+
+		StringIdTable& table = s_stringIdTable;
+		spinlock::lock( table.lock );
+
+		m_pEntry = findStringIdEntry( table, pString, length, crc );
+		if ( m_pEntry == nullptr )
+		{
+			if ( table.entryCount >= table.bucketCount && !growStringIdBuckets( table ) && table.bucketCount == 0u )
+			{
+				spinlock::unlock( table.lock );
+				TIKI_TRACE_ERROR( "[StringId] Could not allocate the string table.\n" );
+				return;
+			}
+
+			StringId::Entry* pEntry = allocateStringIdEntry( table, length );
+			if ( pEntry == nullptr )
+			{
+				spinlock::unlock( table.lock );
+				TIKI_TRACE_ERROR( "[StringId] Out of memory while interning '%s'.\n", pString );
+				return;
+			}
+
+			pEntry->crc		= crc;
+			pEntry->length	= uint32( length );
+			char* pTarget = (char*)( pEntry + 1u );
+			memory::copy( pTarget, pString, length );
+			pTarget[ length ] = '\0';
+
+			const StringId::Entry** ppBucket = &table.ppBuckets[ crc & ( table.bucketCount - 1u ) ];
+			pEntry->pNext	= *ppBucket;
+			*ppBucket		= pEntry;
+
+			table.entryCount++;
+			m_pEntry = pEntry;
+		}
+
+		spinlock::unlock( table.lock );
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+#ifndef TIKI_VIRTUALMEMORY_INTERNAL_HPP_INCLUDED
+#define TIKI_VIRTUALMEMORY_INTERNAL_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	namespace virtualmemory
+	{
+		uint	getPageSize();
+
+		// sizes and addresses must be multiples of the page size
+		void*	reserve( uint sizeInBytes );
+		void	release( void* pMemory, uint sizeInBytes );
+
+		bool	commit( void* pMemory, uint sizeInBytes );
+		void	decommit( void* pMemory, uint sizeInBytes );
+	}
+}
+
+#endif // TIKI_VIRTUALMEMORY_INTERNAL_HPP_INCLUDED
@@ -0,0 +1,120 @@
+#include "tiki/base/virtualmemoryallocator.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+
+#include "virtualmemory_internal.hpp"
+
+namespace tiki
+{
+	VirtualMemoryAllocator::VirtualMemoryAllocator()
+	{
+		m_pBase			= nullptr;
+		m_reservedSize	= 0u;
+		m_committedSize	= 0u;
+		m_pageSize		= 0u;
+
+		m_isAllocated	= false;
+	}
+
+	VirtualMemoryAllocator::~VirtualMemoryAllocator()
+	{
+		TIKI_ASSERT( m_pBase == nullptr );
+	}
+
+	bool VirtualMemoryAllocator::create( uint reservedSizeInBytes )
+	{
+		TIKI_ASSERT( m_pBase == nullptr );
+		TIKI_ASSERT( reservedSizeInBytes > 0u );
+
+		m_pageSize		= virtualmemory::getPageSize();
+		m_reservedSize	= alignValue( reservedSizeInBytes, m_pageSize );
+
+		m_pBase = static_cast< uint8* >( virtualmemory::reserve( m_reservedSize ) );
+		if ( m_pBase == nullptr )
+		{
+			TIKI_TRACE_ERROR( "[VirtualMemoryAllocator] Could not reserve %u bytes of address space.\n", m_reservedSize );
+			m_reservedSize = 0u;
+			return false;
+		}
+
+		return true;
+	}
+
+	void VirtualMemoryAllocator::dispose()
+	{
+		TIKI_ASSERT( !m_isAllocated );
+
+		if ( m_pBase != nullptr )
+		{
+			virtualmemory::release( m_pBase, m_reservedSize );
+			m_pBase = nullptr;
+		}
+
+		m_reservedSize	= 0u;
+		m_committedSize	= 0u;
+	}
+
+	void* VirtualMemoryAllocator::allocate( uint sizeInBytes, uint alignment /* = TIKI_DEFAULT_ALIGNMENT */ )
+	{
+		TIKI_ASSERT( m_pBase != nullptr );
+		TIKI_ASSERT( alignment <= m_pageSize );
+
+		if ( m_isAllocated )
+		{
+			TIKI_TRACE_ERROR( "[VirtualMemoryAllocator] Only one allocation at a time is supported.\n" );
+			return nullptr;
+		}
+
+		if ( !commitSize( sizeInBytes ) )
+		{
+			return nullptr;
+		}
+
+		m_isAllocated = true;
+		return m_pBase;
+	}
+
+	void VirtualMemoryAllocator::free( void* pMemory )
+	{
+		TIKI_ASSERT( m_isAllocated );
+		TIKI_ASSERT( pMemory == m_pBase );
+
+		m_isAllocated = false;
+		commitSize( 0u );
+	}
+
+	bool VirtualMemoryAllocator::resize( void* pMemory, uint newSizeInBytes )
+	{
+		TIKI_ASSERT( m_isAllocated );
+		TIKI_ASSERT( pMemory == m_pBase );
+
+		return commitSize( newSizeInBytes );
+	}
+
+	bool VirtualMemoryAllocator::commitSize( uint sizeInBytes )
+	{
+		const uint newCommittedSize = alignValue( sizeInBytes, m_pageSize );
+		if ( newCommittedSize > m_reservedSize )
+		{
+			TIKI_TRACE_ERROR( "[VirtualMemoryAllocator] Out of reserved Memory(want to commit: %u, reserved: %u).\n", newCommittedSize, m_reservedSize );
+			return false;
+		}
+
+		if ( newCommittedSize > m_committedSize )
+		{
+			if ( !virtualmemory::commit( m_pBase + m_committedSize, newCommittedSize - m_committedSize ) )
+			{
+				TIKI_TRACE_ERROR( "[VirtualMemoryAllocator] Could not commit %u bytes.\n", newCommittedSize - m_committedSize );
+				return false;
+			}
+		}
+		else if ( newCommittedSize < m_committedSize )
+		{
+			virtualmemory::decommit( m_pBase + newCommittedSize, m_committedSize - newCommittedSize );
+		}
+
+		m_committedSize = newCommittedSize;
+		return true;
+	}
+}
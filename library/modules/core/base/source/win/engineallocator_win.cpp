@@ -0,0 +1,45 @@
+
+#include "tiki/base/engineallocator.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+
+#include "../engineallocator_internal.hpp"
+
+#include <windows.h>
+
+namespace tiki
+{
+	void* engineallocator::allocateSystemMemory( uint sizeInBytes, uint alignment )
+	{
+		// VirtualAlloc only aligns to 64 kb. reserve a larger range to find an aligned address and map it. an other
+		// thread can take the range in between.
+		while ( true )
+		{
+			void* pReserved = VirtualAlloc( nullptr, sizeInBytes + alignment, MEM_RESERVE, PAGE_NOACCESS );
+			if ( pReserved == nullptr )
+			{
+				return nullptr;
+			}
+
+			uint8* pAligned = alignPointer( static_cast< uint8* >( pReserved ), alignment );
+			VirtualFree( pReserved, 0u, MEM_RELEASE );
+
+			void* pMemory = VirtualAlloc( pAligned, sizeInBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+			if ( pMemory != nullptr )
+			{
+				return pMemory;
+			}
+		}
+	}
+
+	void engineallocator::freeSystemMemory( void* pMemory, uint sizeInBytes )
+	{
+		VirtualFree( pMemory, 0u, MEM_RELEASE );
+	}
+
+	void engineallocator::yieldThread()
+	{
+		SwitchToThread();
+	}
+}
@@ -8,21 +8,21 @@ namespace tiki
 	// load
 
 	TIKI_SIMD_INLINE vf32	simd::set_f32( const float value )												{ return _mm_set_ps1( value ); }
-	TIKI_SIMD_INLINE vf32	simd::set_f32( const float x, const float y, const float z, const float w )		{ return _mm_set_ps( x, y, z, w ); }
+	TIKI_SIMD_INLINE vf32	simd::set_f32( const float x, const float y, const float z, const float w )		{ return _mm_setr_ps( x, y, z, w ); }
 	TIKI_SIMD_INLINE vf32	simd::set_f32( const float* pValues )											{ return _mm_load_ps( pValues ); }
 	TIKI_SIMD_INLINE vf32	simd::set_f32( const float* pValues, const size_t offset )						{ return _mm_load_ps( pValues + offset ); }
 	TIKI_SIMD_INLINE vf32	simd::set_f32u( const float* pValues )											{ return _mm_loadu_ps( pValues ); }
 	TIKI_SIMD_INLINE vf32	simd::set_f32u( const float* pValues, const size_t offset )						{ return _mm_loadu_ps( pValues + offset ); }
 
 	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32 value )												{ return _mm_set1_epi32( value ); }
-	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32 x, const sint32 y, const sint32 z, const sint32 w )	{ return _mm_set_epi32( x, y, z, w ); }
+	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32 x, const sint32 y, const sint32 z, const sint32 w )	{ return _mm_setr_epi32( x, y, z, w ); }
 	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32* pValues )											{ return _mm_load_si128( (vi32*)pValues ); }
 	TIKI_SIMD_INLINE vi32	simd::set_i32( const sint32* pValues, const size_t offset )						{ return _mm_load_si128( (vi32*)(pValues + offset) ); }
 	TIKI_SIMD_INLINE vi32	simd::set_i32u( const sint32* pValues )											{ return _mm_loadu_si128( (vi32*)pValues ); }
 	TIKI_SIMD_INLINE vi32	simd::set_i32u( const sint32* pValues, const size_t offset )					{ return _mm_loadu_si128( (vi32*)(pValues + offset) ); }
 
 	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16 value )												{ return _mm_set1_epi16( value ); }
-	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16 a, const sint16 b, const sint16 c, const sint16 d, const sint16 e, const sint16 f, const sint16 g, const sint16 h )	{ return _mm_set_epi16( a, b, c, d, e, f, g, h ); }
+	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16 a, const sint16 b, const sint16 c, const sint16 d, const sint16 e, const sint16 f, const sint16 g, const sint16 h )	{ return _mm_setr_epi16( a, b, c, d, e, f, g, h ); }
 	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16* pValues )											{ return _mm_load_si128( (vi16*)pValues ); }
 	TIKI_SIMD_INLINE vi16	simd::set_i16( const sint16* pValues, const size_t offset )						{ return _mm_load_si128( (vi16*)(pValues + offset) ); }
 	TIKI_SIMD_INLINE vi16	simd::set_i16u( const sint16* pValues )											{ return _mm_loadu_si128( (vi16*)pValues ); }
@@ -56,6 +56,9 @@ namespace tiki
 	TIKI_SIMD_INLINE vf32	simd::muladd_f32( const vf32 v1, const vf32 v2, const vf32 v3 )					{ return _mm_add_ps( _mm_mul_ps( v1, v2 ), v3 ); } // r = v1 * v2 + v3
 	TIKI_SIMD_INLINE vf32	simd::mulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 )					{ return _mm_sub_ps( _mm_mul_ps( v1, v2 ), v3 ); } // r = v1 * v2 - v3
 	TIKI_SIMD_INLINE vf32	simd::negmulsub_f32( const vf32 v1, const vf32 v2, const vf32 v3 )				{ return _mm_sub_ps( v3, _mm_mul_ps( v1, v2 ) ); } // r = v3 - v1 * v1
+	TIKI_SIMD_INLINE vf32	simd::min_f32( const vf32 v1, const vf32 v2 )									{ return _mm_min_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32	simd::max_f32( const vf32 v1, const vf32 v2 )									{ return _mm_max_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32	simd::sqrt_f32( const vf32 value )												{ return _mm_sqrt_ps( value ); }
 
 	TIKI_SIMD_INLINE vi32	simd::add_i32( const vi32 v1, const vi32 v2 )									{ return _mm_add_epi32( v1, v2 ); }
 	TIKI_SIMD_INLINE vi32	simd::sub_i32( const vi32 v1, const vi32 v2 )									{ return _mm_sub_epi32( v1, v2 ); }
@@ -65,6 +68,20 @@ namespace tiki
 	//TIKI_SIMD_INLINE vi32	simd::mulsub_i32( const vi32 v1, const vi32 v2, const vi32 v3 )					{ return _mm_sub_epi32( _mm_mul_epi32( v1, v2 ), v3 ); }
 
 
+	//////////////////////////////////////////////////////////////////////////
+	// compare
+
+	TIKI_SIMD_INLINE vf32	simd::cmplt_f32( const vf32 v1, const vf32 v2 )									{ return _mm_cmplt_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32	simd::cmple_f32( const vf32 v1, const vf32 v2 )									{ return _mm_cmple_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32	simd::cmpgt_f32( const vf32 v1, const vf32 v2 )									{ return _mm_cmpgt_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32	simd::cmpge_f32( const vf32 v1, const vf32 v2 )									{ return _mm_cmpge_ps( v1, v2 ); }
+
+	TIKI_SIMD_INLINE vf32	simd::and_f32( const vf32 v1, const vf32 v2 )									{ return _mm_and_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32	simd::or_f32( const vf32 v1, const vf32 v2 )									{ return _mm_or_ps( v1, v2 ); }
+	TIKI_SIMD_INLINE vf32	simd::select_f32( const vf32 mask, const vf32 v1, const vf32 v2 )				{ return _mm_or_ps( _mm_and_ps( mask, v1 ), _mm_andnot_ps( mask, v2 ) ); }
+	TIKI_SIMD_INLINE uint32	simd::mask_f32( const vf32 mask )												{ return (uint32)_mm_movemask_ps( mask ); }
+
+
 	//////////////////////////////////////////////////////////////////////////
 	// convert
 
@@ -84,6 +101,7 @@ namespace tiki
 
 	TIKI_SIMD_INLINE vf32	simd::rsqrt_f32( const vf32 value )												{ return _mm_rsqrt_ps( value ); } // r = 1.0f / sqrt( value )
 	TIKI_SIMD_INLINE vf32	simd::dot4_f32( const vf32 v1, const vf32 v2 )									{ const vf32 mul = mul_f32( v1, v2 ); return add_f32( mul, add_f32( _mm_shuffle_ps( mul, mul, _MM_SHUFFLE( 0u, 3u, 2u, 1u ) ), add_f32( _mm_shuffle_ps( mul, mul, _MM_SHUFFLE( 1u, 0u, 3u, 2u ) ), _mm_shuffle_ps( mul, mul, _MM_SHUFFLE( 2u, 1u, 0u, 3u ) ) ) ) ); }
+	TIKI_SIMD_INLINE void	simd::transpose_f32( vf32& x, vf32& y, vf32& z, vf32& w )					{ _MM_TRANSPOSE4_PS( x, y, z, w ); }
 
 }
 #endif // TIKI_SIMD_WIN_INL
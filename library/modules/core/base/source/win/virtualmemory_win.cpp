@@ -0,0 +1,34 @@
+#include "../virtualmemory_internal.hpp"
+
+#include <windows.h>
+
+namespace tiki
+{
+	uint virtualmemory::getPageSize()
+	{
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo( &systemInfo );
+
+		return systemInfo.dwPageSize;
+	}
+
+	void* virtualmemory::reserve( uint sizeInBytes )
+	{
+		return VirtualAlloc( nullptr, sizeInBytes, MEM_RESERVE, PAGE_NOACCESS );
+	}
+
+	void virtualmemory::release( void* pMemory, uint /*sizeInBytes*/ )
+	{
+		VirtualFree( pMemory, 0u, MEM_RELEASE );
+	}
+
+	bool virtualmemory::commit( void* pMemory, uint sizeInBytes )
+	{
+		return VirtualAlloc( pMemory, sizeInBytes, MEM_COMMIT, PAGE_READWRITE ) != nullptr;
+	}
+
+	void virtualmemory::decommit( void* pMemory, uint sizeInBytes )
+	{
+		VirtualFree( pMemory, sizeInBytes, MEM_DECOMMIT );
+	}
+}
@@ -7,45 +7,69 @@
 
 namespace tiki
 {
+	struct ZoneAllocatorPage
+	{
+		ZoneAllocatorPage*	pNext;
+		uint8*				pData;
+		uint				sizeInBytes;
+		uint				usedSize;
+	};
 
 	ZoneAllocator::ZoneAllocator()
 	{
-		m_pMemory	= nullptr;
-		m_size		= 0u;
+		m_pFirstPage	= nullptr;
+		m_pCurrentPage	= nullptr;
+		m_baseAlignment	= 0u;
 
-		m_pCurrent	= nullptr;
+		m_pPrev			= nullptr;
+		m_pPrevBase		= nullptr;
+
+		m_pCurrent		= nullptr;
+		m_pEnd			= nullptr;
 	}
 
 	ZoneAllocator::~ZoneAllocator()
 	{
-
+		TIKI_ASSERT( m_pFirstPage == nullptr );
 	}
 
-	bool ZoneAllocator::create( uint sizeInBytes, uint alignment /* = TIKI_MINIMUM_ALIGNMENT */ )
+	bool ZoneAllocator::create( uint pageSizeInBytes, uint alignment /* = TIKI_MINIMUM_ALIGNMENT */ )
 	{
-		m_pMemory = static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( sizeInBytes, alignment ) );
+		TIKI_ASSERT( m_pFirstPage == nullptr );
+		TIKI_ASSERT( isPowerOfTwo( alignment ) );
+
+		m_baseAlignment = alignment;
 
-		if ( m_pMemory == nullptr )
+		m_pFirstPage = allocatePage( pageSizeInBytes );
+		if ( m_pFirstPage == nullptr )
 		{
-			TIKI_TRACE_ERROR( "[ZoneAllocator] Could not allocator Memory.\n" );
+			m_baseAlignment = 0u;
 			return false;
 		}
 
-		m_pCurrent = m_pMemory;
-
-		m_size			= sizeInBytes;
-		m_baseAlignment	= alignment;
-
+		setCurrentPage( m_pFirstPage, m_pFirstPage->pData );
 		return true;
 	}
 
 	void ZoneAllocator::dispose()
 	{
-		TIKI_MEMORY_FREE( m_pMemory );
-		m_pMemory		= nullptr;
-		m_pCurrent		= nullptr;
-		m_size			= 0u;
+		ZoneAllocatorPage* pPage = m_pFirstPage;
+		while ( pPage != nullptr )
+		{
+			ZoneAllocatorPage* pNextPage = pPage->pNext;
+			freePage( pPage );
+			pPage = pNextPage;
+		}
+
+		m_pFirstPage	= nullptr;
+		m_pCurrentPage	= nullptr;
 		m_baseAlignment	= 0u;
+
+		m_pPrev			= nullptr;
+		m_pPrevBase		= nullptr;
+
+		m_pCurrent		= nullptr;
+		m_pEnd			= nullptr;
 	}
 
 	void* ZoneAllocator::allocate( uint sizeInBytes, uint alignment /*= TIKI_DEFAULT_ALIGNMENT */ )
@@ -56,22 +80,27 @@ namespace tiki
 		{
 			alignment = m_baseAlignment;
 		}
-		TIKI_ASSERT( m_baseAlignment >= alignment );
+		TIKI_ASSERT( isPowerOfTwo( alignment ) );
 
-		const uint currentSize = m_pCurrent - m_pMemory;
-		const uint alignedSize = alignValue( currentSize, alignment );
-		if ( alignedSize + sizeInBytes > m_size )
+		uint8* pMemory = alignPointer( m_pCurrent, alignment );
+		if ( pMemory > m_pEnd || sizeInBytes > uint( m_pEnd - pMemory ) )
 		{
-			TIKI_TRACE_ERROR( "[ZoneAllocator] Out of Memory(want to allocate: %u, free: %u, total size: %u).\n", sizeInBytes, ( m_size - ( m_pCurrent - m_pMemory ) ), m_size );
-			return nullptr;
+			if ( switchToNextPage( sizeInBytes, alignment ) == false )
+			{
+				TIKI_TRACE_ERROR( "[ZoneAllocator] Out of Memory(want to allocate: %u, capacity: %u).\n", sizeInBytes, getCapacity() );
+				return nullptr;
+			}
+
+			pMemory = alignPointer( m_pCurrent, alignment );
+			TIKI_ASSERT( pMemory + sizeInBytes <= m_pEnd );
 		}
 
-		m_pPrevBase = m_pCurrent;
-		m_pPrev		= m_pMemory + alignedSize;
+		m_pPrevBase	= m_pCurrent;
+		m_pPrev		= pMemory;
 
-		m_pCurrent	= m_pMemory + alignedSize + sizeInBytes;
+		m_pCurrent	= pMemory + sizeInBytes;
 
-		return m_pPrev;
+		return pMemory;
 	}
 
 	void ZoneAllocator::free( void* pMemory )
@@ -79,12 +108,39 @@ namespace tiki
 		TIKI_ASSERT( m_pCurrent != nullptr );
 		TIKI_ASSERT( pMemory != nullptr );
 
+		// only the last allocation can be undone
 		if ( pMemory == m_pPrev )
 		{
-			m_pCurrent = static_cast< uint8* >( m_pPrevBase );
+			m_pCurrent	= static_cast< uint8* >( m_pPrevBase );
+
+			m_pPrev		= nullptr;
+			m_pPrevBase	= nullptr;
 		}
 	}
 
+	ZoneAllocator::Marker ZoneAllocator::getMarker() const
+	{
+		TIKI_ASSERT( m_pCurrent != nullptr );
+
+		Marker marker;
+		marker.pPage	= m_pCurrentPage;
+		marker.pCurrent	= m_pCurrent;
+
+		return marker;
+	}
+
+	void ZoneAllocator::freeToMarker( const Marker& marker )
+	{
+		TIKI_ASSERT( marker.pPage != nullptr );
+		TIKI_ASSERT( marker.pCurrent >= marker.pPage->pData && marker.pCurrent <= marker.pPage->pData + marker.pPage->sizeInBytes );
+
+		// pages behind the marker stay in the chain and are used again by the next allocations
+		setCurrentPage( marker.pPage, marker.pCurrent );
+
+		m_pPrev		= nullptr;
+		m_pPrevBase	= nullptr;
+	}
+
 	void ZoneAllocator::clear()
 	{
 		TIKI_ASSERT( m_pCurrent != nullptr );
@@ -92,6 +148,164 @@ namespace tiki
 		m_pPrev		= nullptr;
 		m_pPrevBase	= nullptr;
 
-		m_pCurrent	= m_pMemory;
+		if ( m_pFirstPage->pNext != nullptr )
+		{
+			// the zone had to grow. replace the chain with one page which fits everything.
+			ZoneAllocatorPage* pMergedPage = allocatePage( getCapacity() );
+			if ( pMergedPage != nullptr )
+			{
+				const uint baseAlignment = m_baseAlignment;
+				dispose();
+
+				m_pFirstPage	= pMergedPage;
+				m_baseAlignment	= baseAlignment;
+			}
+		}
+
+		setCurrentPage( m_pFirstPage, m_pFirstPage->pData );
+	}
+
+	uint ZoneAllocator::getCurrentAllocationSize() const
+	{
+		if ( m_pCurrentPage == nullptr )
+		{
+			return 0u;
+		}
+
+		uint size = 0u;
+		for (const ZoneAllocatorPage* pPage = m_pFirstPage; pPage != m_pCurrentPage; pPage = pPage->pNext)
+		{
+			size += pPage->usedSize;
+		}
+
+		return size + uint( m_pCurrent - m_pCurrentPage->pData );
+	}
+
+	uint ZoneAllocator::getCapacity() const
+	{
+		uint capacity = 0u;
+		for (const ZoneAllocatorPage* pPage = m_pFirstPage; pPage != nullptr; pPage = pPage->pNext)
+		{
+			capacity += pPage->sizeInBytes;
+		}
+
+		return capacity;
+	}
+
+	uint ZoneAllocator::getPageCount() const
+	{
+		uint count = 0u;
+		for (const ZoneAllocatorPage* pPage = m_pFirstPage; pPage != nullptr; pPage = pPage->pNext)
+		{
+			count++;
+		}
+
+		return count;
+	}
+
+	ZoneAllocatorPage* ZoneAllocator::allocatePage( uint sizeInBytes )
+	{
+		const uint pageAlignment	= TIKI_MAX( m_baseAlignment, (uint)TIKI_MINIMUM_ALIGNMENT );
+		const uint headerSize		= alignValue( (uint)sizeof( ZoneAllocatorPage ), pageAlignment );
+
+		uint8* pMemory = static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( headerSize + sizeInBytes, pageAlignment ) );
+		if ( pMemory == nullptr )
+		{
+			TIKI_TRACE_ERROR( "[ZoneAllocator] Could not allocate a page with %u bytes.\n", sizeInBytes );
+			return nullptr;
+		}
+
+		ZoneAllocatorPage* pPage = reinterpret_cast< ZoneAllocatorPage* >( pMemory );
+		pPage->pNext		= nullptr;
+		pPage->pData		= pMemory + headerSize;
+		pPage->sizeInBytes	= sizeInBytes;
+		pPage->usedSize		= 0u;
+
+		return pPage;
+	}
+
+	void ZoneAllocator::freePage( ZoneAllocatorPage* pPage )
+	{
+		TIKI_MEMORY_FREE( pPage );
+	}
+
+	void ZoneAllocator::setCurrentPage( ZoneAllocatorPage* pPage, uint8* pCurrent )
+	{
+		m_pCurrentPage	= pPage;
+		m_pCurrent		= pCurrent;
+		m_pEnd			= pPage->pData + pPage->sizeInBytes;
+	}
+
+	bool ZoneAllocator::switchToNextPage( uint sizeInBytes, uint alignment )
+	{
+		const uint pageAlignment	= TIKI_MAX( m_baseAlignment, (uint)TIKI_MINIMUM_ALIGNMENT );
+		const uint requiredSize		= ( alignment > pageAlignment ? sizeInBytes + alignment : sizeInBytes );
+
+		// reuse the pages from before the last rewind when they are big enough
+		ZoneAllocatorPage* pNextPage = m_pCurrentPage->pNext;
+		while ( pNextPage != nullptr && pNextPage->sizeInBytes < requiredSize )
+		{
+			m_pCurrentPage->pNext = pNextPage->pNext;
+			freePage( pNextPage );
+
+			pNextPage = m_pCurrentPage->pNext;
+		}
+
+		if ( pNextPage == nullptr )
+		{
+			// grow geometrically to keep the number of pages small
+			const uint capacity = getCapacity();
+			pNextPage = allocatePage( TIKI_MAX( requiredSize, capacity ) );
+			if ( pNextPage == nullptr )
+			{
+				return false;
+			}
+
+			m_pCurrentPage->pNext = pNextPage;
+		}
+
+		m_pCurrentPage->usedSize = uint( m_pCurrent - m_pCurrentPage->pData );
+		setCurrentPage( pNextPage, pNextPage->pData );
+
+		return true;
+	}
+
+	DoubleBufferedZoneAllocator::DoubleBufferedZoneAllocator()
+	{
+		m_currentIndex = 0u;
+	}
+
+	DoubleBufferedZoneAllocator::~DoubleBufferedZoneAllocator()
+	{
+	}
+
+	bool DoubleBufferedZoneAllocator::create( uint pageSizeInBytes, uint alignment /* = TIKI_MINIMUM_ALIGNMENT */ )
+	{
+		m_currentIndex = 0u;
+
+		for (uint i = 0u; i < TIKI_COUNT( m_aZones ); ++i)
+		{
+			if ( m_aZones[ i ].create( pageSizeInBytes, alignment ) == false )
+			{
+				dispose();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void DoubleBufferedZoneAllocator::dispose()
+	{
+		for (uint i = 0u; i < TIKI_COUNT( m_aZones ); ++i)
+		{
+			m_aZones[ i ].dispose();
+		}
+	}
+
+	void DoubleBufferedZoneAllocator::swap()
+	{
+		m_currentIndex ^= 1u;
+		m_aZones[ m_currentIndex ].clear();
 	}
-}
\ No newline at end of file
+}
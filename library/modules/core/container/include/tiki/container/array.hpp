@@ -2,6 +2,7 @@
 #ifndef __TIKI_ARRAY_HPP_INCLUDED__
 #define __TIKI_ARRAY_HPP_INCLUDED__
 
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/assert.hpp"
 #include "tiki/base/functions.hpp"
 #include "tiki/base/memory.hpp"
@@ -25,12 +26,15 @@ namespace tiki
 		TIKI_FORCE_INLINE					Array();
 		TIKI_FORCE_INLINE					~Array();
 
-		TIKI_FORCE_INLINE bool				create( uint capacity, size_t aligment = TIKI_DEFAULT_ALIGNMENT, bool constructElements = true );
-		TIKI_FORCE_INLINE bool				create( ConstIterator pInitData, uint capacity, size_t aligment = TIKI_DEFAULT_ALIGNMENT, bool constructElements = true );
+		// pAllocator nullptr selects the global heap
+		TIKI_FORCE_INLINE bool				create( uint capacity, size_t aligment = TIKI_DEFAULT_ALIGNMENT, bool constructElements = true, Allocator* pAllocator = nullptr );
+		TIKI_FORCE_INLINE bool				create( ConstIterator pInitData, uint capacity, size_t aligment = TIKI_DEFAULT_ALIGNMENT, bool constructElements = true, Allocator* pAllocator = nullptr );
 		TIKI_FORCE_INLINE void				dispose();
 
 		TIKI_FORCE_INLINE void				swap( Array< T >& other );
 
+		TIKI_FORCE_INLINE Allocator*		getAllocator() const	{ return m_pAllocator; }
+
 		TIKI_FORCE_INLINE uint				getCount() const	{ return m_capacity; }
 		TIKI_FORCE_INLINE uint				getCapacity() const	{ return m_capacity; }
 
@@ -60,8 +64,9 @@ namespace tiki
 
 	private:
 
-		T*		m_pData;
-		uint	m_capacity;
+		Allocator*	m_pAllocator;
+		T*			m_pData;
+		uint		m_capacity;
 	};
 }
 
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef TIKI_CONCURRENTPOOLALLOCATOR_HPP_INCLUDED
+#define TIKI_CONCURRENTPOOLALLOCATOR_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+#include "tiki/threading/atomic.hpp"
+
+namespace tiki
+{
+	// pool allocator which can be used from any number of threads without a lock. the free slots form a lock-free
+	// stack. the head stores the slot index together with a tag which changes on every push and pop, so a thread which
+	// was suspended between reading and swapping the head can't corrupt the stack (ABA).
+	template<typename T>
+	class ConcurrentPoolAllocator
+	{
+		TIKI_NONCOPYABLE_CLASS( ConcurrentPoolAllocator );
+
+	public:
+
+				ConcurrentPoolAllocator();
+				~ConcurrentPoolAllocator();
+
+		bool	create( uint count, uint alignment = TIKI_DEFAULT_ALIGNMENT );
+		void	dispose();
+
+		bool	isCreated() const { return m_pPool != nullptr; }
+
+		uint	getCapacity() const { return m_count; }
+
+		// returns nullptr when the pool is full
+		T*		allocate();
+		void	free( T* pObject );
+
+	private:
+
+		enum
+		{
+			InvalidIndex = 0xffffffffu
+		};
+
+		uint8*				m_pPool;
+		uint				m_slotSize;
+		uint				m_count;
+
+		// next free slot for every slot. only meaningful while the slot is free. a thread can read it while an other
+		// thread pops the slot and reuses it, so it is atomic. the head publishes it, relaxed accesses are enough.
+		AtomicUInt32*		m_pNextIndices;
+		uint8				m_poolPadding[ TIKI_CACHE_LINE_SIZE - sizeof( uint8* ) - ( 2u * sizeof( uint ) ) - sizeof( AtomicUInt32* ) ];
+
+		// lower 32 bit: index of the first free slot, upper 32 bit: tag
+		AtomicUInt64		m_head;
+		uint8				m_headPadding[ TIKI_CACHE_LINE_SIZE - sizeof( AtomicUInt64 ) ];
+
+		static uint64		createHead( uint64 oldHead, uint32 index ) { return ( ( ( oldHead >> 32u ) + 1u ) << 32u ) | index; }
+
+	};
+}
+
+#include "../../../source/concurrentpoolallocator.inl"
+
+#endif // TIKI_CONCURRENTPOOLALLOCATOR_HPP_INCLUDED
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef TIKI_HASHMAP_HPP_INCLUDED
+#define TIKI_HASHMAP_HPP_INCLUDED
+
+#include "tiki/base/allocator.hpp"
+#include "tiki/base/basicstring.hpp"
+#include "tiki/base/stringid.hpp"
+#include "tiki/base/types.hpp"
+#include "tiki/container/keyvaluepair.hpp"
+
+namespace tiki
+{
+	// hash of a key. specialize it for own key types.
+	template<typename TKey>
+	struct HashMapKeyTraits
+	{
+		static TIKI_FORCE_INLINE uint64	getHash( const TKey& key );
+	};
+
+	template<typename T>
+	struct HashMapKeyTraits< T* >
+	{
+		static TIKI_FORCE_INLINE uint64	getHash( const T* pKey );
+	};
+
+	template<>
+	struct HashMapKeyTraits< BasicString >
+	{
+		static TIKI_FORCE_INLINE uint64	getHash( const BasicString& key );
+	};
+
+	template<>
+	struct HashMapKeyTraits< StringId >
+	{
+		static TIKI_FORCE_INLINE uint64	getHash( const StringId& key );
+	};
+
+	// open addressing hash map. every slot has a control byte with 7 bits of the hash, so a probe compares 16 slots
+	// with one SSE2 instruction and only touches the slots which could match. the load factor is kept below 7/8.
+	// element addresses change when the map grows.
+	template<typename TKey, typename TValue>
+	class HashMap
+	{
+		TIKI_NONCOPYABLE_CLASS( HashMap );
+
+	public:
+
+		typedef KeyValuePair< TKey, TValue > Pair;
+
+		TIKI_FORCE_INLINE				HashMap();
+		TIKI_FORCE_INLINE explicit		HashMap( Allocator& allocator );
+		TIKI_FORCE_INLINE				~HashMap();
+
+		// the map grows when needed. create only reserves space for the given count of elements.
+		TIKI_FORCE_INLINE bool			create( uint count, Allocator* pAllocator = nullptr );
+		TIKI_FORCE_INLINE void			dispose();
+
+		TIKI_FORCE_INLINE void			clear();
+		TIKI_FORCE_INLINE bool			reserve( uint count );
+
+		TIKI_FORCE_INLINE uint			getCount() const { return m_count; }
+		TIKI_FORCE_INLINE uint			getCapacity() const { return m_capacity; }
+		TIKI_FORCE_INLINE bool			isEmpty() const { return m_count == 0u; }
+
+		TIKI_FORCE_INLINE bool			hasKey( const TKey& key ) const;
+
+		TIKI_FORCE_INLINE TValue*		find( const TKey& key );
+		TIKI_FORCE_INLINE const TValue*	find( const TKey& key ) const;
+		TIKI_FORCE_INLINE bool			findValue( TValue* pTargetValue, const TKey& key ) const;
+
+		TIKI_FORCE_INLINE TValue&		set( const TKey& key, const TValue& value );
+		TIKI_FORCE_INLINE bool			remove( const TKey& key );
+
+	private:
+
+		enum
+		{
+			GroupSize		= 16u,
+			MinCapacity		= 16u
+		};
+
+		enum Control
+		{
+			Control_Empty	= 0x80,
+			Control_Deleted	= 0xfe
+		};
+
+		Allocator*				m_pAllocator;
+
+		// capacity + GroupSize control bytes. the last group mirrors the first one, so a group can be read at every
+		// position without wrapping.
+		uint8*					m_pControl;
+		Pair*					m_pSlots;
+
+		uint					m_count;
+		uint					m_deletedCount;
+		uint					m_capacity;
+
+		TIKI_FORCE_INLINE uint	findSlot( const TKey& key, uint64 hash ) const;
+		TIKI_FORCE_INLINE uint	findFreeSlot( uint64 hash ) const;
+
+		TIKI_FORCE_INLINE void	setControl( uint index, uint8 control );
+		TIKI_FORCE_INLINE bool	rehash( uint newCapacity );
+
+		static TIKI_FORCE_INLINE uint	getGrowthLimit( uint capacity ) { return capacity - ( capacity / 8u ); }
+
+		static TIKI_FORCE_INLINE uint32	matchGroup( const uint8* pControl, uint8 control );
+		static TIKI_FORCE_INLINE uint32	matchGroupEmpty( const uint8* pControl );
+		static TIKI_FORCE_INLINE uint32	matchGroupFree( const uint8* pControl );
+
+	};
+}
+
+#include "../../../source/hashmap.inl"
+
+#endif // TIKI_HASHMAP_HPP_INCLUDED
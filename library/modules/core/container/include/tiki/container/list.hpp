@@ -2,6 +2,7 @@
 #ifndef TIKI_LIST_HPP
 #define TIKI_LIST_HPP
 
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/assert.hpp"
 
 namespace tiki
@@ -18,15 +19,23 @@ namespace tiki
 		typedef const T*	ConstIterator;
 
 		TIKI_FORCE_INLINE					List();
+		TIKI_FORCE_INLINE explicit			List( Allocator& allocator );
+		// copies use the global heap, the allocator of the source can be a scope the copy doesn't own
 		TIKI_FORCE_INLINE					List( const List<T>& copy );
 		TIKI_FORCE_INLINE					List( const T* data, uint count, bool readOnly = false );
 		TIKI_FORCE_INLINE					~List();
 
 		TIKI_FORCE_INLINE void				clear();
 		TIKI_FORCE_INLINE void				dispose();
+
+		// nullptr selects the global heap. can only be changed while the list has no memory.
+		TIKI_FORCE_INLINE void				setAllocator( Allocator* pAllocator );
+		TIKI_FORCE_INLINE Allocator*		getAllocator() const { return m_pAllocator; }
 		
-		TIKI_FORCE_INLINE void				reserve( uint count );
-		TIKI_FORCE_INLINE void				resize( uint count );
+		// the functions that grow the list return false when the memory can't grow, e.g. when the reservation of a
+		// VirtualMemoryAllocator is exhausted. add() without an item has nothing to return and breaks.
+		TIKI_FORCE_INLINE bool				reserve( uint count );
+		TIKI_FORCE_INLINE bool				resize( uint count );
 
 		TIKI_FORCE_INLINE uint				getCount() const;
 		TIKI_FORCE_INLINE bool				isEmpty() const;
@@ -35,10 +44,10 @@ namespace tiki
 		TIKI_FORCE_INLINE bool				contains( const T& item ) const;
 
 		TIKI_FORCE_INLINE T&				add();
-		TIKI_FORCE_INLINE void				add( const T& item );
-		TIKI_FORCE_INLINE void				addRange( const List<T>& list );
-		TIKI_FORCE_INLINE void				addRange( const T* src, uint length );
-		TIKI_FORCE_INLINE void				insert( uint index, const T& item );
+		TIKI_FORCE_INLINE bool				add( const T& item );
+		TIKI_FORCE_INLINE bool				addRange( const List<T>& list );
+		TIKI_FORCE_INLINE bool				addRange( const T* src, uint length );
+		TIKI_FORCE_INLINE bool				insert( uint index, const T& item );
 
 		TIKI_FORCE_INLINE Iterator			getBegin();
 		TIKI_FORCE_INLINE ConstIterator		getBegin() const;
@@ -68,6 +77,8 @@ namespace tiki
 
 	private:
 
+		Allocator*							m_pAllocator;
+
 		T*									m_pData;
 		uint								m_count;
 		uint								m_capacity;
@@ -75,7 +86,7 @@ namespace tiki
 		bool								m_isReadOnly;
 
 		TIKI_FORCE_INLINE uint				getNextSize( uint targetSize );
-		TIKI_FORCE_INLINE void				checkArraySize( uint neddedSize );
+		TIKI_FORCE_INLINE bool				checkArraySize( uint neddedSize );
 
 	};
 }
@@ -2,8 +2,9 @@
 #ifndef TIKI_MAP_HPP_INCLUDED__
 #define TIKI_MAP_HPP_INCLUDED__
 
-#include "tiki/container/keyvaluepair.hpp"
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/types.hpp"
+#include "tiki/container/keyvaluepair.hpp"
 
 namespace tiki
 {
@@ -15,6 +16,8 @@ namespace tiki
 		typedef KeyValuePair<TKey, TValue> Pair;
 		
 		TIKI_FORCE_INLINE				Map();
+		TIKI_FORCE_INLINE explicit		Map( Allocator& allocator );
+		// copies use the global heap, the allocator of the source can be a scope the copy doesn't own
 		TIKI_FORCE_INLINE				Map( const Map< TKey, TValue >& copy );
 		TIKI_FORCE_INLINE				~Map();
 
@@ -22,6 +25,10 @@ namespace tiki
 
 		TIKI_FORCE_INLINE void			clear();
 
+		// nullptr selects the global heap. can only be changed while the map has no memory.
+		TIKI_FORCE_INLINE void			setAllocator( Allocator* pAllocator );
+		TIKI_FORCE_INLINE Allocator*	getAllocator() const { return m_pAllocator; }
+
 		TIKI_FORCE_INLINE uint			getCount() const;
 		TIKI_FORCE_INLINE bool			isEmpty() const;
 
@@ -34,6 +41,7 @@ namespace tiki
 
 		TIKI_FORCE_INLINE bool			findValue( TValue* pTargetValue, const TKey& key ) const;
 
+		// breaks when the map can't grow, e.g. when the reservation of a VirtualMemoryAllocator is exhausted
 		TIKI_FORCE_INLINE TValue&		set( const TKey& key, const TValue& value );
 		TIKI_FORCE_INLINE bool			remove( const TKey& key );
 
@@ -44,6 +52,8 @@ namespace tiki
 
 	private:
 
+		Allocator*				m_pAllocator;
+
 		Pair*					m_pData;
 		uint					m_count;
 		uint					m_capacity;
@@ -51,7 +61,7 @@ namespace tiki
 		TIKI_FORCE_INLINE uint	findIndex( const TKey& key ) const;
 
 		TIKI_FORCE_INLINE uint	getNextSize( uint targetSize );
-		TIKI_FORCE_INLINE void	checkArraySize( uint neddedSize );
+		TIKI_FORCE_INLINE bool	checkArraySize( uint neddedSize );
 
 	};
 }
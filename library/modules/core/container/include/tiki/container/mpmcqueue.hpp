@@ -0,0 +1,63 @@
+#pragma once
+#ifndef TIKI_MPMCQUEUE_HPP_INCLUDED
+#define TIKI_MPMCQUEUE_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+#include "tiki/threading/atomic.hpp"
+
+namespace tiki
+{
+	// bounded lock-free queue for any number of producer and consumer threads. every cell carries a sequence number, so
+	// producers and consumers only contend on their own position counter. T must be copyable.
+	template<typename T>
+	class MpmcQueue
+	{
+		TIKI_NONCOPYABLE_CLASS( MpmcQueue );
+
+	public:
+
+		typedef T			Type;
+
+		typedef T&			Reference;
+		typedef const T&	ConstReference;
+
+		MpmcQueue();
+		~MpmcQueue();
+
+		// capacity will be rounded up to the next power of two
+		bool			create( uint capacity );
+		void			dispose();
+
+		bool			tryPush( ConstReference value );
+		bool			tryPop( Reference target );
+
+		// only a snapshot while other threads use the queue
+		bool			isEmpty() const;
+		uint			getCount() const;
+		uint			getCapacity() const { return m_capacity; }
+
+	private:
+
+		struct Cell
+		{
+			AtomicUInt64	sequence;
+			T				value;
+		};
+
+		Cell*			m_pCells;
+		uint			m_capacity;
+		uint			m_mask;
+		uint8			m_cellsPadding[ TIKI_CACHE_LINE_SIZE - sizeof( Cell* ) - ( 2u * sizeof( uint ) ) ];
+
+		AtomicUInt64	m_pushPosition;
+		uint8			m_pushPadding[ TIKI_CACHE_LINE_SIZE - sizeof( AtomicUInt64 ) ];
+
+		AtomicUInt64	m_popPosition;
+		uint8			m_popPadding[ TIKI_CACHE_LINE_SIZE - sizeof( AtomicUInt64 ) ];
+
+	};
+}
+
+#include "../../../source/mpmcqueue.inl"
+
+#endif // TIKI_MPMCQUEUE_HPP_INCLUDED
@@ -2,6 +2,7 @@
 #ifndef __TIKI_QUEUE_HPP_INCLUDED__
 #define __TIKI_QUEUE_HPP_INCLUDED__
 
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/types.hpp"
 
 namespace tiki
@@ -24,7 +25,8 @@ namespace tiki
 		Queue();
 		~Queue();
 
-		bool			create( uint capacity, uint alignment = TIKI_DEFAULT_ALIGNMENT );
+		// pAllocator nullptr selects the global heap
+		bool			create( uint capacity, uint alignment = TIKI_DEFAULT_ALIGNMENT, Allocator* pAllocator = nullptr );
 		void			dispose();
 
 		bool			isEmpty() const;
@@ -43,12 +45,16 @@ namespace tiki
 		uint			getCount() const;
 		uint			getCapacity() const;
 
+		Allocator*		getAllocator() const { return m_pAllocator; }
+
 	private:
 
-		T*		m_pData;
-		uint	m_top;
-		uint	m_bottom;
-		uint	m_capacity;
+		Allocator*	m_pAllocator;
+
+		T*			m_pData;
+		uint		m_top;
+		uint		m_bottom;
+		uint		m_capacity;
 
 	};
 }
@@ -2,6 +2,7 @@
 #ifndef TIKI_SIZEDARRAY_HPP
 #define TIKI_SIZEDARRAY_HPP
 
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/types.hpp"
 
 namespace tiki
@@ -24,7 +25,8 @@ namespace tiki
 		TIKI_FORCE_INLINE					SizedArray();
 		TIKI_FORCE_INLINE					~SizedArray();
 
-		TIKI_FORCE_INLINE bool				create( uint capacity, size_t aligment = TIKI_DEFAULT_ALIGNMENT, bool constructElements = true );
+		// pAllocator nullptr selects the global heap
+		TIKI_FORCE_INLINE bool				create( uint capacity, size_t aligment = TIKI_DEFAULT_ALIGNMENT, bool constructElements = true, Allocator* pAllocator = nullptr );
 		TIKI_FORCE_INLINE void				dispose();
 
 		TIKI_FORCE_INLINE void				clear();
@@ -42,6 +44,8 @@ namespace tiki
 		TIKI_FORCE_INLINE void				removeUnsortedByIndex( uint index );
 		TIKI_FORCE_INLINE bool				removeUnsortedByValue( ConstReference value );
 
+		TIKI_FORCE_INLINE Allocator*		getAllocator() const	{ return m_pAllocator; }
+
 		TIKI_FORCE_INLINE uint				getCount() const	{ return m_count; }
 		TIKI_FORCE_INLINE uint				getCapacity() const	{ return m_capacity; }
 
@@ -71,9 +75,10 @@ namespace tiki
 
 	private:
 
-		uint	m_count;
-		uint	m_capacity;
-		Type*	m_pData;
+		uint		m_count;
+		uint		m_capacity;
+		Type*		m_pData;
+		Allocator*	m_pAllocator;
 
 	};
 }
@@ -0,0 +1,103 @@
+#pragma once
+#ifndef TIKI_SOAARRAY_HPP_INCLUDED
+#define TIKI_SOAARRAY_HPP_INCLUDED
+
+#include "tiki/base/allocator.hpp"
+#include "tiki/base/types.hpp"
+#include "tiki/container/staticarray.hpp"
+
+namespace tiki
+{
+	// placeholder for unused fields of a SoaArray
+	struct SoaArrayNoField
+	{
+	};
+
+	template<uint TIndex, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector;
+
+	// struct of arrays with up to 8 fields. every field is stored in an own array which is aligned to the simd width.
+	// the capacity is rounded up to a multiple of the simd lane count, so loops can always process full 4 or 8
+	// elements. like SizedArray all elements are constructed in create and the capacity doesn't grow.
+	//
+	// example:
+	// SoaArray< Vector3, Quaternion, Vector3 > joints;
+	// Vector3* pPositions = joints.getFieldData< 0u >();
+	template<typename T0, typename T1 = SoaArrayNoField, typename T2 = SoaArrayNoField, typename T3 = SoaArrayNoField, typename T4 = SoaArrayNoField, typename T5 = SoaArrayNoField, typename T6 = SoaArrayNoField, typename T7 = SoaArrayNoField>
+	class SoaArray
+	{
+		TIKI_NONCOPYABLE_CLASS( SoaArray );
+
+	public:
+
+		enum
+		{
+			MaxFieldCount	= 8u,
+			// 32 bytes for avx
+			FieldAlignment	= 32u,
+			// 8 floats per avx register
+			CapacityGranularity	= 8u
+		};
+
+		template<uint TIndex>
+		struct Field
+		{
+			typedef typename SoaArrayFieldSelector< TIndex, T0, T1, T2, T3, T4, T5, T6, T7 >::Type Type;
+		};
+
+		TIKI_FORCE_INLINE			SoaArray();
+		TIKI_FORCE_INLINE			~SoaArray();
+
+		// pAllocator nullptr selects the global heap
+		TIKI_FORCE_INLINE bool		create( uint capacity, Allocator* pAllocator = nullptr );
+		TIKI_FORCE_INLINE void		dispose();
+
+		TIKI_FORCE_INLINE void		clear()	{ m_count = 0u; }
+
+		TIKI_FORCE_INLINE bool		isEmpty() const	{ return m_count == 0u; }
+		TIKI_FORCE_INLINE bool		isFull() const	{ return m_count == m_capacity; }
+
+		TIKI_FORCE_INLINE uint		getCount() const	{ return m_count; }
+		TIKI_FORCE_INLINE uint		getCapacity() const	{ return m_capacity; }
+
+		TIKI_FORCE_INLINE Allocator*	getAllocator() const	{ return m_pAllocator; }
+
+		// returns the index of the new element
+		TIKI_FORCE_INLINE uint		push();
+		// moves the last element into the gap, so the order changes
+		TIKI_FORCE_INLINE void		removeUnsortedByIndex( uint index );
+
+		template<uint TIndex>
+		TIKI_FORCE_INLINE typename Field< TIndex >::Type*					getFieldData();
+		template<uint TIndex>
+		TIKI_FORCE_INLINE const typename Field< TIndex >::Type*				getFieldData() const;
+
+		// span over the used elements of one field. the caller has to dispose the target.
+		template<uint TIndex>
+		TIKI_FORCE_INLINE void		getField( StaticArray< typename Field< TIndex >::Type >& target );
+		template<uint TIndex>
+		TIKI_FORCE_INLINE void		getField( StaticArray< const typename Field< TIndex >::Type >& target ) const;
+
+		template<uint TIndex>
+		TIKI_FORCE_INLINE typename Field< TIndex >::Type&					get( uint index );
+		template<uint TIndex>
+		TIKI_FORCE_INLINE const typename Field< TIndex >::Type&				get( uint index ) const;
+
+	private:
+
+		Allocator*					m_pAllocator;
+		void*						m_pMemory;
+
+		void*						m_apFields[ MaxFieldCount ];
+
+		uint						m_count;
+		uint						m_capacity;
+
+		TIKI_FORCE_INLINE void		moveElement( uint targetIndex, uint sourceIndex );
+
+	};
+}
+
+#include "../../../source/soaarray.inl"
+
+#endif // TIKI_SOAARRAY_HPP_INCLUDED
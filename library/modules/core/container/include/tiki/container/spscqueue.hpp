@@ -0,0 +1,63 @@
+#pragma once
+#ifndef TIKI_SPSCQUEUE_HPP_INCLUDED
+#define TIKI_SPSCQUEUE_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+#include "tiki/threading/atomic.hpp"
+
+namespace tiki
+{
+	// bounded lock-free queue for exactly one producer and one consumer thread. T must be copyable.
+	template<typename T>
+	class SpscQueue
+	{
+		TIKI_NONCOPYABLE_CLASS( SpscQueue );
+
+	public:
+
+		typedef T			Type;
+
+		typedef T&			Reference;
+		typedef const T&	ConstReference;
+
+		SpscQueue();
+		~SpscQueue();
+
+		// capacity will be rounded up to the next power of two
+		bool			create( uint capacity );
+		void			dispose();
+
+		// producer thread only
+		bool			tryPush( ConstReference value );
+
+		// consumer thread only
+		bool			tryPop( Reference target );
+
+		// exact only when called from the producer or the consumer
+		bool			isEmpty() const;
+		uint			getCount() const;
+		uint			getCapacity() const { return m_capacity; }
+
+	private:
+
+		T*				m_pData;
+		uint			m_capacity;
+		uint			m_mask;
+		uint8			m_dataPadding[ TIKI_CACHE_LINE_SIZE - sizeof( T* ) - ( 2u * sizeof( uint ) ) ];
+
+		// written by the consumer
+		AtomicUInt64	m_head;
+		uint64			m_cachedTail;
+		uint8			m_headPadding[ TIKI_CACHE_LINE_SIZE - ( 2u * sizeof( uint64 ) ) ];
+
+		// written by the producer
+		AtomicUInt64	m_tail;
+		uint64			m_cachedHead;
+		uint8			m_tailPadding[ TIKI_CACHE_LINE_SIZE - ( 2u * sizeof( uint64 ) ) ];
+
+	};
+}
+
+#include "../../../source/spscqueue.inl"
+
+#endif // TIKI_SPSCQUEUE_HPP_INCLUDED
@@ -6,7 +6,7 @@ namespace tiki
 {
 	template< typename T >
 	TIKI_FORCE_INLINE Array< T >::Array()
-		: m_pData( nullptr ), m_capacity( 0u )
+		: m_pAllocator( nullptr ), m_pData( nullptr ), m_capacity( 0u )
 	{
 	}
 
@@ -17,20 +17,21 @@ namespace tiki
 	}
 
 	template< typename T >
-	TIKI_FORCE_INLINE bool Array< T >::create( uint capacity, size_t aligment /* = TIKI_DEFAULT_ALIGNMENT */, bool constructElements /* = true */ )
+	TIKI_FORCE_INLINE bool Array< T >::create( uint capacity, size_t aligment /* = TIKI_DEFAULT_ALIGNMENT */, bool constructElements /* = true */, Allocator* pAllocator /* = nullptr */ )
 	{
 		TIKI_ASSERT( m_pData == nullptr );
 
-		m_capacity	= capacity;
-		m_pData		= TIKI_MEMORY_NEW_ARRAY_ALIGNED( T, capacity, aligment, constructElements );
+		m_pAllocator	= pAllocator;
+		m_capacity		= capacity;
+		m_pData			= memory::newArray< T >( pAllocator, capacity, (uint)aligment, constructElements );
 
 		return m_pData != nullptr;
 	}
 
 	template< typename T >
-	TIKI_FORCE_INLINE bool Array< T >::create( ConstIterator pInitData, uint capacity, size_t aligment /*= TIKI_DEFAULT_ALIGNMENT*/, bool constructElements /* = true */ )
+	TIKI_FORCE_INLINE bool Array< T >::create( ConstIterator pInitData, uint capacity, size_t aligment /*= TIKI_DEFAULT_ALIGNMENT*/, bool constructElements /* = true */, Allocator* pAllocator /* = nullptr */ )
 	{
-		if ( !create( capacity, aligment, constructElements ) )
+		if ( !create( capacity, aligment, constructElements, pAllocator ) )
 		{
 			return false;
 		}
@@ -48,22 +49,26 @@ namespace tiki
 	{
 		if ( m_pData != nullptr )
 		{
-			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 		}
 
-		m_capacity	= 0u;
-		m_pData		= nullptr;
+		m_pAllocator	= nullptr;
+		m_capacity		= 0u;
+		m_pData			= nullptr;
 	}
 
 	template<typename T>
 	TIKI_FORCE_INLINE void Array<T>::swap( Array< T >& other )
 	{
+		Allocator* pAllocatorBackup = m_pAllocator;
 		T* pDataBackup = m_pData;
 		uint capacityBackup = m_capacity;
 
-		m_pData		= other.m_pData;
-		m_capacity	= other.m_capacity;
+		m_pAllocator	= other.m_pAllocator;
+		m_pData			= other.m_pData;
+		m_capacity		= other.m_capacity;
 
+		other.m_pAllocator	= pAllocatorBackup;
 		other.m_pData		= pDataBackup;
 		other.m_capacity	= capacityBackup;
 	}
@@ -0,0 +1,123 @@
+#pragma once
+#ifndef TIKI_CONCURRENTPOOLALLOCATOR_INL_INCLUDED
+#define TIKI_CONCURRENTPOOLALLOCATOR_INL_INCLUDED
+
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	template<typename T>
+	ConcurrentPoolAllocator<T>::ConcurrentPoolAllocator()
+	{
+		m_pPool			= nullptr;
+		m_slotSize		= 0u;
+		m_count			= 0u;
+		m_pNextIndices	= nullptr;
+	}
+
+	template<typename T>
+	ConcurrentPoolAllocator<T>::~ConcurrentPoolAllocator()
+	{
+		TIKI_ASSERT( m_pPool == nullptr );
+	}
+
+	template<typename T>
+	bool ConcurrentPoolAllocator<T>::create( uint count, uint alignment /* = TIKI_DEFAULT_ALIGNMENT */ )
+	{
+		TIKI_ASSERT( m_pPool == nullptr );
+		TIKI_ASSERT( count > 0u && count < InvalidIndex );
+
+		if ( alignment == TIKI_DEFAULT_ALIGNMENT )
+		{
+			alignment = TIKI_ALIGNOF( T );
+		}
+		TIKI_ASSERT( isPowerOfTwo( alignment ) );
+
+		m_slotSize	= alignValue( (uint)sizeof( T ), alignment );
+		m_count		= count;
+
+		m_pPool			= static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( count * m_slotSize, alignment ) );
+		m_pNextIndices	= TIKI_MEMORY_NEW_ARRAY( AtomicUInt32, count, true );
+		if ( m_pPool == nullptr || m_pNextIndices == nullptr )
+		{
+			dispose();
+			TIKI_TRACE_ERROR( "[ConcurrentPoolAllocator] Could not allocator Memory.\n" );
+			return false;
+		}
+
+		for (uint i = 0u; i < count; ++i)
+		{
+			m_pNextIndices[ i ].store( i + 1u < count ? uint32( i + 1u ) : (uint32)InvalidIndex, AtomicOrder_Relaxed );
+		}
+		m_head.store( 0u );
+
+		return true;
+	}
+
+	template<typename T>
+	void ConcurrentPoolAllocator<T>::dispose()
+	{
+		if ( m_pPool != nullptr )
+		{
+			TIKI_MEMORY_FREE( m_pPool );
+			m_pPool = nullptr;
+		}
+
+		if ( m_pNextIndices != nullptr )
+		{
+			TIKI_MEMORY_DELETE_ARRAY( m_pNextIndices, m_count );
+			m_pNextIndices = nullptr;
+		}
+
+		m_slotSize	= 0u;
+		m_count		= 0u;
+	}
+
+	template<typename T>
+	T* ConcurrentPoolAllocator<T>::allocate()
+	{
+		TIKI_ASSERT( m_pPool != nullptr );
+
+		uint64 head = m_head.load( AtomicOrder_Acquire );
+		while ( true )
+		{
+			const uint32 index = uint32( head );
+			if ( index == InvalidIndex )
+			{
+				return nullptr;
+			}
+
+			// the slot can be taken by an other thread in the meantime. then the tag has changed and the swap fails.
+			const uint32 nextIndex = m_pNextIndices[ index ].load( AtomicOrder_Relaxed );
+			if ( m_head.compareExchange( head, createHead( head, nextIndex ), AtomicOrder_AcquireRelease ) )
+			{
+				return ::new( m_pPool + ( index * m_slotSize ) ) T();
+			}
+		}
+	}
+
+	template<typename T>
+	void ConcurrentPoolAllocator<T>::free( T* pObject )
+	{
+		TIKI_ASSERT( m_pPool != nullptr );
+		TIKI_ASSERT( pObject != nullptr );
+
+		const uint offset = uint( reinterpret_cast< uint8* >( pObject ) - m_pPool );
+		TIKI_ASSERT( offset < m_count * m_slotSize );
+		TIKI_ASSERT( offset % m_slotSize == 0u );
+
+		pObject->~T();
+
+		const uint32 index = uint32( offset / m_slotSize );
+
+		uint64 head = m_head.load( AtomicOrder_Relaxed );
+		do
+		{
+			m_pNextIndices[ index ].store( uint32( head ), AtomicOrder_Relaxed );
+		}
+		while ( !m_head.compareExchange( head, createHead( head, index ), AtomicOrder_Release ) );
+	}
+}
+
+#endif // TIKI_CONCURRENTPOOLALLOCATOR_INL_INCLUDED
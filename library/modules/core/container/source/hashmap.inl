@@ -0,0 +1,428 @@
+#pragma once
+#ifndef TIKI_HASHMAP_INL_INCLUDED
+#define TIKI_HASHMAP_INL_INCLUDED
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+#if TIKI_ENABLED( TIKI_BUILD_MSVC ) || defined( __SSE2__ )
+#	define TIKI_HASHMAP_SSE2 TIKI_ON
+#	include <emmintrin.h>
+#else
+#	define TIKI_HASHMAP_SSE2 TIKI_OFF
+#endif
+
+namespace tiki
+{
+	namespace hashmap
+	{
+		// murmur3 finalizer. spreads keys which differ only in a few bits over the whole hash.
+		TIKI_FORCE_INLINE uint64 mixHash( uint64 value )
+		{
+			value ^= value >> 33u;
+			value *= 0xff51afd7ed558ccdull;
+			value ^= value >> 33u;
+			value *= 0xc4ceb9fe1a85ec53ull;
+			value ^= value >> 33u;
+
+			return value;
+		}
+	}
+
+	template<typename TKey>
+	TIKI_FORCE_INLINE uint64 HashMapKeyTraits< TKey >::getHash( const TKey& key )
+	{
+		return hashmap::mixHash( uint64( key ) );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE uint64 HashMapKeyTraits< T* >::getHash( const T* pKey )
+	{
+		return hashmap::mixHash( uint64( (uint)pKey ) );
+	}
+
+	TIKI_FORCE_INLINE uint64 HashMapKeyTraits< BasicString >::getHash( const BasicString& key )
+	{
+		// fnv-1a
+		uint64 hash = 0xcbf29ce484222325ull;
+
+		const char* pString = key.cStr();
+		const uint length = key.getLength();
+		for (uint i = 0u; i < length; ++i)
+		{
+			hash ^= uint8( pString[ i ] );
+			hash *= 0x100000001b3ull;
+		}
+
+		return hashmap::mixHash( hash );
+	}
+
+	TIKI_FORCE_INLINE uint64 HashMapKeyTraits< StringId >::getHash( const StringId& key )
+	{
+		// the crc is stored in the table entry, so there is nothing to hash
+		return hashmap::mixHash( key.getCrc() );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE HashMap<TKey, TValue>::HashMap()
+	{
+		m_pAllocator	= nullptr;
+		m_pControl		= nullptr;
+		m_pSlots		= nullptr;
+		m_count			= 0u;
+		m_deletedCount	= 0u;
+		m_capacity		= 0u;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE HashMap<TKey, TValue>::HashMap( Allocator& allocator )
+	{
+		m_pAllocator	= &allocator;
+		m_pControl		= nullptr;
+		m_pSlots		= nullptr;
+		m_count			= 0u;
+		m_deletedCount	= 0u;
+		m_capacity		= 0u;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE HashMap<TKey, TValue>::~HashMap()
+	{
+		dispose();
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE bool HashMap<TKey, TValue>::create( uint count, Allocator* pAllocator /* = nullptr */ )
+	{
+		TIKI_ASSERT( m_pSlots == nullptr );
+
+		m_pAllocator = pAllocator;
+		return reserve( count );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE void HashMap<TKey, TValue>::dispose()
+	{
+		if ( m_pSlots == nullptr )
+		{
+			return;
+		}
+
+		clear();
+
+		if ( m_pAllocator != nullptr )
+		{
+			m_pAllocator->free( m_pSlots );
+		}
+		else
+		{
+			TIKI_MEMORY_FREE( m_pSlots );
+		}
+
+		m_pControl		= nullptr;
+		m_pSlots		= nullptr;
+		m_capacity		= 0u;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE void HashMap<TKey, TValue>::clear()
+	{
+		if ( m_pSlots == nullptr )
+		{
+			return;
+		}
+
+		for (uint i = 0u; i < m_capacity; ++i)
+		{
+			if ( m_pControl[ i ] < Control_Empty )
+			{
+				m_pSlots[ i ].~Pair();
+			}
+		}
+		memory::set8( m_pControl, m_capacity + GroupSize, Control_Empty );
+
+		m_count			= 0u;
+		m_deletedCount	= 0u;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE bool HashMap<TKey, TValue>::reserve( uint count )
+	{
+		const uint minCapacity = count + ( count / 7u ) + 1u;
+		if ( getGrowthLimit( m_capacity ) >= count && m_capacity > 0u )
+		{
+			return true;
+		}
+
+		return rehash( TIKI_MAX( getNextPowerOfTwo( minCapacity ), (uint)MinCapacity ) );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE bool HashMap<TKey, TValue>::hasKey( const TKey& key ) const
+	{
+		return findSlot( key, HashMapKeyTraits< TKey >::getHash( key ) ) != TIKI_SIZE_T_MAX;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE TValue* HashMap<TKey, TValue>::find( const TKey& key )
+	{
+		const uint index = findSlot( key, HashMapKeyTraits< TKey >::getHash( key ) );
+		return ( index != TIKI_SIZE_T_MAX ? &m_pSlots[ index ].value : nullptr );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE const TValue* HashMap<TKey, TValue>::find( const TKey& key ) const
+	{
+		const uint index = findSlot( key, HashMapKeyTraits< TKey >::getHash( key ) );
+		return ( index != TIKI_SIZE_T_MAX ? &m_pSlots[ index ].value : nullptr );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE bool HashMap<TKey, TValue>::findValue( TValue* pTargetValue, const TKey& key ) const
+	{
+		TIKI_ASSERT( pTargetValue != nullptr );
+
+		const TValue* pValue = find( key );
+		if ( pValue == nullptr )
+		{
+			return false;
+		}
+
+		*pTargetValue = *pValue;
+		return true;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE TValue& HashMap<TKey, TValue>::set( const TKey& key, const TValue& value )
+	{
+		const uint64 hash = HashMapKeyTraits< TKey >::getHash( key );
+
+		uint index = findSlot( key, hash );
+		if ( index != TIKI_SIZE_T_MAX )
+		{
+			m_pSlots[ index ].value = value;
+			return m_pSlots[ index ].value;
+		}
+
+		if ( m_count + m_deletedCount >= getGrowthLimit( m_capacity ) )
+		{
+			// when mostly deleted slots fill the table a rehash at the same size is enough
+			const bool grow = ( m_count >= getGrowthLimit( m_capacity ) / 2u );
+			TIKI_VERIFY( rehash( grow ? TIKI_MAX( m_capacity * 2u, (uint)MinCapacity ) : m_capacity ) );
+		}
+
+		index = findFreeSlot( hash );
+		if ( m_pControl[ index ] == Control_Deleted )
+		{
+			m_deletedCount--;
+		}
+		setControl( index, uint8( hash & 0x7fu ) );
+		m_count++;
+
+		Pair* pPair = ::new( &m_pSlots[ index ] ) Pair();
+		pPair->key		= key;
+		pPair->value	= value;
+
+		return pPair->value;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE bool HashMap<TKey, TValue>::remove( const TKey& key )
+	{
+		const uint index = findSlot( key, HashMapKeyTraits< TKey >::getHash( key ) );
+		if ( index == TIKI_SIZE_T_MAX )
+		{
+			return false;
+		}
+
+		// the slot stays marked, so probes for other keys don't stop here
+		m_pSlots[ index ].~Pair();
+		setControl( index, Control_Deleted );
+
+		m_count--;
+		m_deletedCount++;
+
+		return true;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint HashMap<TKey, TValue>::findSlot( const TKey& key, uint64 hash ) const
+	{
+		if ( m_count == 0u )
+		{
+			return TIKI_SIZE_T_MAX;
+		}
+
+		const uint8 control	= uint8( hash & 0x7fu );
+		const uint mask		= m_capacity - 1u;
+
+		// triangular probing over groups reaches every group once
+		uint position = uint( hash >> 7u ) & mask;
+		for (uint step = GroupSize; ; step += GroupSize)
+		{
+			const uint8* pGroup = m_pControl + position;
+
+			uint32 matches = matchGroup( pGroup, control );
+			while ( matches != 0u )
+			{
+				const uint index = ( position + countTrailingZeros32( matches ) ) & mask;
+				if ( m_pSlots[ index ].key == key )
+				{
+					return index;
+				}
+
+				matches &= matches - 1u;
+			}
+
+			if ( matchGroupEmpty( pGroup ) != 0u )
+			{
+				return TIKI_SIZE_T_MAX;
+			}
+
+			position = ( position + step ) & mask;
+		}
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint HashMap<TKey, TValue>::findFreeSlot( uint64 hash ) const
+	{
+		const uint mask = m_capacity - 1u;
+
+		uint position = uint( hash >> 7u ) & mask;
+		for (uint step = GroupSize; ; step += GroupSize)
+		{
+			const uint32 matches = matchGroupFree( m_pControl + position );
+			if ( matches != 0u )
+			{
+				return ( position + countTrailingZeros32( matches ) ) & mask;
+			}
+
+			position = ( position + step ) & mask;
+		}
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE void HashMap<TKey, TValue>::setControl( uint index, uint8 control )
+	{
+		m_pControl[ index ] = control;
+		if ( index < GroupSize )
+		{
+			m_pControl[ m_capacity + index ] = control;
+		}
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE bool HashMap<TKey, TValue>::rehash( uint newCapacity )
+	{
+		TIKI_ASSERT( isPowerOfTwo( newCapacity ) );
+		TIKI_ASSERT( getGrowthLimit( newCapacity ) > m_count );
+
+		// slots and control bytes share one block
+		const uint slotsSize	= alignValue( uint( sizeof( Pair ) * newCapacity ), (uint)GroupSize );
+		const uint blockSize	= slotsSize + newCapacity + GroupSize;
+		const uint alignment	= TIKI_MAX( (uint)TIKI_ALIGNOF( Pair ), (uint)GroupSize );
+
+		void* pBlock = ( m_pAllocator != nullptr ? m_pAllocator->allocate( blockSize, alignment ) : TIKI_MEMORY_ALLOC_ALIGNED( blockSize, alignment ) );
+		if ( pBlock == nullptr )
+		{
+			return false;
+		}
+
+		Pair* pOldSlots			= m_pSlots;
+		uint8* pOldControl		= m_pControl;
+		const uint oldCapacity	= m_capacity;
+
+		m_pSlots		= static_cast< Pair* >( pBlock );
+		m_pControl		= static_cast< uint8* >( pBlock ) + slotsSize;
+		m_capacity		= newCapacity;
+		m_deletedCount	= 0u;
+		memory::set8( m_pControl, newCapacity + GroupSize, Control_Empty );
+
+		for (uint i = 0u; i < oldCapacity; ++i)
+		{
+			if ( pOldControl[ i ] >= Control_Empty )
+			{
+				continue;
+			}
+
+			Pair& oldPair = pOldSlots[ i ];
+			const uint64 hash = HashMapKeyTraits< TKey >::getHash( oldPair.key );
+
+			const uint index = findFreeSlot( hash );
+			setControl( index, uint8( hash & 0x7fu ) );
+			::new( &m_pSlots[ index ] ) Pair( oldPair );
+
+			oldPair.~Pair();
+		}
+
+		if ( pOldSlots != nullptr )
+		{
+			if ( m_pAllocator != nullptr )
+			{
+				m_pAllocator->free( pOldSlots );
+			}
+			else
+			{
+				TIKI_MEMORY_FREE( pOldSlots );
+			}
+		}
+
+		return true;
+	}
+
+#if TIKI_ENABLED( TIKI_HASHMAP_SSE2 )
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint32 HashMap<TKey, TValue>::matchGroup( const uint8* pControl, uint8 control )
+	{
+		const __m128i group = _mm_loadu_si128( reinterpret_cast< const __m128i* >( pControl ) );
+		return uint32( _mm_movemask_epi8( _mm_cmpeq_epi8( group, _mm_set1_epi8( char( control ) ) ) ) );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint32 HashMap<TKey, TValue>::matchGroupEmpty( const uint8* pControl )
+	{
+		return matchGroup( pControl, Control_Empty );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint32 HashMap<TKey, TValue>::matchGroupFree( const uint8* pControl )
+	{
+		// empty and deleted have the high bit set
+		const __m128i group = _mm_loadu_si128( reinterpret_cast< const __m128i* >( pControl ) );
+		return uint32( _mm_movemask_epi8( group ) );
+	}
+#else
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint32 HashMap<TKey, TValue>::matchGroup( const uint8* pControl, uint8 control )
+	{
+		uint32 result = 0u;
+		for (uint i = 0u; i < GroupSize; ++i)
+		{
+			result |= uint32( pControl[ i ] == control ) << i;
+		}
+
+		return result;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint32 HashMap<TKey, TValue>::matchGroupEmpty( const uint8* pControl )
+	{
+		return matchGroup( pControl, Control_Empty );
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE uint32 HashMap<TKey, TValue>::matchGroupFree( const uint8* pControl )
+	{
+		uint32 result = 0u;
+		for (uint i = 0u; i < GroupSize; ++i)
+		{
+			result |= uint32( pControl[ i ] >> 7u ) << i;
+		}
+
+		return result;
+	}
+#endif
+}
+
+#endif // TIKI_HASHMAP_INL_INCLUDED
@@ -2,6 +2,7 @@
 #ifndef TIKI_LIST_INL
 #define TIKI_LIST_INL
 
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/functions.hpp"
 #include "tiki/base/memory.hpp"
 
@@ -10,6 +11,7 @@ namespace tiki
 	template<typename T>
 	TIKI_FORCE_INLINE List< T >::List()
 	{
+		m_pAllocator	= nullptr;
 		m_pData			= nullptr;
 		m_count		= 0u;
 		m_capacity		= 0u;
@@ -17,11 +19,23 @@ namespace tiki
 		m_isReadOnly	= false;
 	}
 
+	template<typename T>
+	TIKI_FORCE_INLINE List< T >::List( Allocator& allocator )
+	{
+		m_pAllocator	= &allocator;
+		m_pData			= nullptr;
+		m_count			= 0u;
+		m_capacity		= 0u;
+
+		m_isReadOnly	= false;
+	}
+
 	template<typename T>
 	TIKI_FORCE_INLINE List< T >::List( const List<T>& copy )
 	{
-		m_pData		= nullptr;
-		m_capacity	= 0u;
+		m_pAllocator	= nullptr;
+		m_pData			= nullptr;
+		m_capacity		= 0u;
 
 		*this = copy;
 	}
@@ -29,15 +43,14 @@ namespace tiki
 	template<typename T>
 	TIKI_FORCE_INLINE List< T >::List( const T* pData, uint count, bool readOnly /*= false*/ )
 	{
-		m_capacity		= getNextSize( count );
-		m_count			= count;
-		m_isReadOnly	= readOnly;
-		m_pData			= TIKI_MEMORY_NEW_ARRAY( T, m_capacity, true );
+		m_pAllocator	= nullptr;
+		m_pData			= nullptr;
+		m_count			= 0u;
+		m_capacity		= 0u;
 
-		for (uint i = 0u; i < m_count; ++i)
-		{
-			m_pData[ i ] = pData[ i ];
-		}
+		m_isReadOnly	= false;
+		addRange( pData, count );
+		m_isReadOnly	= readOnly;
 	}
 
 	template<typename T>
@@ -57,7 +70,7 @@ namespace tiki
 	{
 		if ( m_pData != nullptr )
 		{
-			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 		}
 
 		m_pData		= nullptr;
@@ -66,16 +79,28 @@ namespace tiki
 	}
 
 	template<typename T>
-	TIKI_FORCE_INLINE void List< T >::reserve( const uint count )
+	TIKI_FORCE_INLINE void List< T >::setAllocator( Allocator* pAllocator )
 	{
-		checkArraySize( count );
+		TIKI_ASSERT( m_pData == nullptr );
+		m_pAllocator = pAllocator;
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE bool List< T >::reserve( const uint count )
+	{
+		return checkArraySize( count );
 	}
 	
 	template<typename T>
-	TIKI_FORCE_INLINE void List<T>::resize( uint count )
+	TIKI_FORCE_INLINE bool List<T>::resize( uint count )
 	{
-		checkArraySize( count );
+		if ( !checkArraySize( count ) )
+		{
+			return false;
+		}
+
 		m_count = count;
+		return true;
 	}
 
 	template<typename T>
@@ -116,48 +141,66 @@ namespace tiki
 	{
 		TIKI_ASSERT( m_isReadOnly == false );
 
-		checkArraySize( m_count + 1u );
+		if ( !checkArraySize( m_count + 1u ) )
+		{
+			// no element to return a reference to
+			TIKI_BREAK( "[List] Could not add an element.\n" );
+		}
+
 		return m_pData[ m_count++ ];
 	}
 
 	template<typename T>
-	TIKI_FORCE_INLINE void List< T >::add( const T& item)
+	TIKI_FORCE_INLINE bool List< T >::add( const T& item)
 	{
 		TIKI_ASSERT( m_isReadOnly == false );
 
-		checkArraySize( m_count + 1u );
+		if ( !checkArraySize( m_count + 1u ) )
+		{
+			return false;
+		}
+
 		m_pData[ m_count++ ] = item;
+		return true;
 	}
 
 	template<typename T>
-	TIKI_FORCE_INLINE void List< T >::addRange( const List<T>& list )
+	TIKI_FORCE_INLINE bool List< T >::addRange( const List<T>& list )
 	{
-		addRange( list.m_pData, list.m_count );
+		return addRange( list.m_pData, list.m_count );
 	}
 
 	template<typename T>
-	TIKI_FORCE_INLINE void List< T >::addRange( const T* pData, uint length )
+	TIKI_FORCE_INLINE bool List< T >::addRange( const T* pData, uint length )
 	{
 		TIKI_ASSERT( m_isReadOnly == false );
 
-		if(length == 0)	return;
-		checkArraySize( m_count + length );
+		if(length == 0)	return true;
+		if ( !checkArraySize( m_count + length ) )
+		{
+			return false;
+		}
 
 		for (uint i = 0u; i < length; ++i)
 		{
 			m_pData[ m_count++ ] = pData[ i ];
 		}
+
+		return true;
 	}
 
 	template<typename T>
-	TIKI_FORCE_INLINE void List< T >::insert( uint index, const T& item)
+	TIKI_FORCE_INLINE bool List< T >::insert( uint index, const T& item)
 	{
 		TIKI_ASSERT( m_isReadOnly == false );
 
-		uint i = m_count;
+		if ( !checkArraySize( m_count + 1u ) )
+		{
+			return false;
+		}
 
+		uint i = m_count;
 		m_count++;
-		checkArraySize( m_count );
 
 		while ( i > index )
 		{
@@ -165,6 +208,8 @@ namespace tiki
 			i--;
 		}
 		m_pData[ index ] = item;
+
+		return true;
 	}
 
 	template<typename T>
@@ -269,7 +314,7 @@ namespace tiki
 	{
 		if ( m_pData != nullptr )
 		{
-			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 		}
 
 		m_isReadOnly	= copy.m_isReadOnly;
@@ -278,7 +323,14 @@ namespace tiki
 		
 		if ( m_count > 0u )
 		{
-			m_pData = TIKI_MEMORY_NEW_ARRAY( T, m_capacity, true );
+			m_pData = memory::newArray< T >( m_pAllocator, m_capacity, TIKI_DEFAULT_ALIGNMENT, true );
+			if ( m_pData == nullptr )
+			{
+				TIKI_TRACE_ERROR( "[List] Could not allocate %u elements.\n", m_capacity );
+				TIKI_ASSERT( false );
+				m_count		= 0u;
+				m_capacity	= 0u;
+			}
 		}
 		else
 		{
@@ -306,12 +358,31 @@ namespace tiki
 	}
 
 	template<typename T>
-	TIKI_FORCE_INLINE void List< T >::checkArraySize( uint neddedSize )
+	TIKI_FORCE_INLINE bool List< T >::checkArraySize( uint neddedSize )
 	{
 		if ( m_capacity < neddedSize )
 		{
 			const uint capacity = getNextSize( neddedSize );
-			T* pNewData = TIKI_MEMORY_NEW_ARRAY( T, capacity, true );
+			if ( m_pData != nullptr && memory::growArray( m_pAllocator, m_pData, m_capacity, capacity, true ) )
+			{
+				// the allocator extended the memory in place. nothing to copy.
+				m_capacity = capacity;
+				return true;
+			}
+
+			if ( m_pData != nullptr && m_pAllocator != nullptr && m_pAllocator->isSingleAllocation() )
+			{
+				// the allocator can't hold a second array to move to
+				TIKI_TRACE_ERROR( "[List] Reservation of the allocator exhausted(needed: %u elements, capacity: %u).\n", neddedSize, m_capacity );
+				return false;
+			}
+
+			T* pNewData = memory::newArray< T >( m_pAllocator, capacity, TIKI_DEFAULT_ALIGNMENT, true );
+			if ( pNewData == nullptr )
+			{
+				TIKI_TRACE_ERROR( "[List] Could not allocate %u elements.\n", capacity );
+				return false;
+			}
 
 			for (uint i = 0u; i < m_count; ++i)
 			{
@@ -320,12 +391,14 @@ namespace tiki
 
 			if ( m_pData != nullptr )
 			{
-				TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+				memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 			}
 
 			m_pData		= pNewData;
 			m_capacity	= capacity;
 		}
+
+		return true;
 	}
 
 }
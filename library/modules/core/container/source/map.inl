@@ -2,6 +2,7 @@
 #ifndef TIKI_MAP_INL_INCLUDED__
 #define TIKI_MAP_INL_INCLUDED__
 
+#include "tiki/base/allocator.hpp"
 #include "tiki/base/assert.hpp"
 #include "tiki/base/memory.hpp"
 
@@ -10,16 +11,27 @@ namespace tiki
 	template<typename TKey, typename TValue>
 	TIKI_FORCE_INLINE Map<TKey, TValue>::Map()
 	{
-		m_pData		= nullptr;
-		m_count		= 0u;
-		m_capacity	= 0u;
+		m_pAllocator	= nullptr;
+		m_pData			= nullptr;
+		m_count			= 0u;
+		m_capacity		= 0u;
+	}
+
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE Map<TKey, TValue>::Map( Allocator& allocator )
+	{
+		m_pAllocator	= &allocator;
+		m_pData			= nullptr;
+		m_count			= 0u;
+		m_capacity		= 0u;
 	}
 
 	template<typename TKey, typename TValue>
 	TIKI_FORCE_INLINE Map<TKey, TValue>::Map( const Map< TKey, TValue >& copy )
 	{
-		m_pData = nullptr;
-		m_count = 0;
+		m_pAllocator	= nullptr;
+		m_pData			= nullptr;
+		m_count			= 0;
 
 		*this = copy;
 	}
@@ -35,7 +47,7 @@ namespace tiki
 	{
 		if ( m_pData != nullptr )
 		{
-			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 		}
 
 		m_pData		= nullptr;
@@ -49,6 +61,13 @@ namespace tiki
 		m_count = 0u;
 	}
 
+	template<typename TKey, typename TValue>
+	TIKI_FORCE_INLINE void Map<TKey, TValue>::setAllocator( Allocator* pAllocator )
+	{
+		TIKI_ASSERT( m_pData == nullptr );
+		m_pAllocator = pAllocator;
+	}
+
 	template<typename TKey, typename TValue>
 	TIKI_FORCE_INLINE uint Map<TKey, TValue>::getCount() const
 	{
@@ -133,7 +152,11 @@ namespace tiki
 			}
 		}
 
-		checkArraySize( m_count + 1 );
+		if ( !checkArraySize( m_count + 1 ) )
+		{
+			// no element to return a reference to
+			TIKI_BREAK( "[Map] Could not add an element.\n" );
+		}
 
 		for (uint i = m_count; i > pos; --i)
 		{
@@ -172,7 +195,7 @@ namespace tiki
 	{
 		if ( m_pData != nullptr )
 		{
-			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 		}
 
 		m_capacity		= copy.m_capacity;
@@ -180,7 +203,14 @@ namespace tiki
 
 		if ( m_count > 0u )
 		{
-			m_pData = TIKI_MEMORY_NEW_ARRAY( Pair, m_capacity, true );
+			m_pData = memory::newArray< Pair >( m_pAllocator, m_capacity, TIKI_DEFAULT_ALIGNMENT, true );
+			if ( m_pData == nullptr )
+			{
+				TIKI_TRACE_ERROR( "[Map] Could not allocate %u elements.\n", m_capacity );
+				TIKI_ASSERT( false );
+				m_count		= 0u;
+				m_capacity	= 0u;
+			}
 		}
 		else
 		{
@@ -264,12 +294,31 @@ namespace tiki
 	}
 
 	template<typename TKey, typename TValue>
-	TIKI_FORCE_INLINE void Map<TKey, TValue>::checkArraySize( uint neddedSize )
+	TIKI_FORCE_INLINE bool Map<TKey, TValue>::checkArraySize( uint neddedSize )
 	{
 		if ( m_capacity < neddedSize )
 		{
 			const uint capacity = getNextSize( neddedSize );
-			Pair* pNewData = TIKI_MEMORY_NEW_ARRAY( Pair, capacity, true );
+			if ( m_pData != nullptr && memory::growArray( m_pAllocator, m_pData, m_capacity, capacity, true ) )
+			{
+				// the allocator extended the memory in place. nothing to copy.
+				m_capacity = capacity;
+				return true;
+			}
+
+			if ( m_pData != nullptr && m_pAllocator != nullptr && m_pAllocator->isSingleAllocation() )
+			{
+				// the allocator can't hold a second array to move to
+				TIKI_TRACE_ERROR( "[Map] Reservation of the allocator exhausted(needed: %u elements, capacity: %u).\n", neddedSize, m_capacity );
+				return false;
+			}
+
+			Pair* pNewData = memory::newArray< Pair >( m_pAllocator, capacity, TIKI_DEFAULT_ALIGNMENT, true );
+			if ( pNewData == nullptr )
+			{
+				TIKI_TRACE_ERROR( "[Map] Could not allocate %u elements.\n", capacity );
+				return false;
+			}
 
 			for (uint i = 0u; i < m_count; ++i)
 			{
@@ -278,12 +327,14 @@ namespace tiki
 
 			if ( m_pData != nullptr )
 			{
-				TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+				memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 			}
 
 			m_pData		= pNewData;
 			m_capacity	= capacity;
 		}
+
+		return true;
 	}
 }
 
@@ -0,0 +1,145 @@
+#pragma once
+#ifndef TIKI_MPMCQUEUE_INL_INCLUDED
+#define TIKI_MPMCQUEUE_INL_INCLUDED
+
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	template<typename T>
+	MpmcQueue<T>::MpmcQueue()
+	{
+		m_pCells	= nullptr;
+		m_capacity	= 0u;
+		m_mask		= 0u;
+	}
+
+	template<typename T>
+	MpmcQueue<T>::~MpmcQueue()
+	{
+		TIKI_ASSERT( m_pCells == nullptr );
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::create( uint capacity )
+	{
+		TIKI_ASSERT( m_pCells == nullptr );
+		TIKI_ASSERT( capacity > 0u );
+
+		capacity = getNextPowerOfTwo( capacity );
+
+		m_pCells = TIKI_MEMORY_NEW_ARRAY_ALIGNED( Cell, capacity, TIKI_CACHE_LINE_SIZE, true );
+		if ( m_pCells == nullptr )
+		{
+			return false;
+		}
+
+		m_capacity	= capacity;
+		m_mask		= capacity - 1u;
+
+		for (uint i = 0u; i < capacity; ++i)
+		{
+			m_pCells[ i ].sequence.store( i, AtomicOrder_Relaxed );
+		}
+
+		m_pushPosition.store( 0u );
+		m_popPosition.store( 0u );
+
+		return true;
+	}
+
+	template<typename T>
+	void MpmcQueue<T>::dispose()
+	{
+		if ( m_pCells != nullptr )
+		{
+			TIKI_MEMORY_DELETE_ARRAY( m_pCells, m_capacity );
+			m_pCells = nullptr;
+		}
+
+		m_capacity	= 0u;
+		m_mask		= 0u;
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::tryPush( ConstReference value )
+	{
+		uint64 position = m_pushPosition.load( AtomicOrder_Relaxed );
+		while ( true )
+		{
+			Cell& cell = m_pCells[ position & m_mask ];
+			const uint64 sequence = cell.sequence.load( AtomicOrder_Acquire );
+			const sint64 difference = sint64( sequence - position );
+
+			if ( difference == 0 )
+			{
+				// the cell is free for this position
+				if ( m_pushPosition.compareExchange( position, position + 1u, AtomicOrder_Relaxed ) )
+				{
+					cell.value = value;
+					cell.sequence.store( position + 1u, AtomicOrder_Release );
+					return true;
+				}
+			}
+			else if ( difference < 0 )
+			{
+				// the cell from the last round wasn't popped yet
+				return false;
+			}
+			else
+			{
+				position = m_pushPosition.load( AtomicOrder_Relaxed );
+			}
+		}
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::tryPop( Reference target )
+	{
+		uint64 position = m_popPosition.load( AtomicOrder_Relaxed );
+		while ( true )
+		{
+			Cell& cell = m_pCells[ position & m_mask ];
+			const uint64 sequence = cell.sequence.load( AtomicOrder_Acquire );
+			const sint64 difference = sint64( sequence - ( position + 1u ) );
+
+			if ( difference == 0 )
+			{
+				if ( m_popPosition.compareExchange( position, position + 1u, AtomicOrder_Relaxed ) )
+				{
+					target = cell.value;
+
+					// free the cell for the push in the next round
+					cell.sequence.store( position + m_capacity, AtomicOrder_Release );
+					return true;
+				}
+			}
+			else if ( difference < 0 )
+			{
+				// nothing pushed at this position
+				return false;
+			}
+			else
+			{
+				position = m_popPosition.load( AtomicOrder_Relaxed );
+			}
+		}
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::isEmpty() const
+	{
+		return getCount() == 0u;
+	}
+
+	template<typename T>
+	uint MpmcQueue<T>::getCount() const
+	{
+		const uint64 popPosition	= m_popPosition.load( AtomicOrder_Acquire );
+		const uint64 pushPosition	= m_pushPosition.load( AtomicOrder_Acquire );
+		return ( pushPosition > popPosition ? uint( pushPosition - popPosition ) : 0u );
+	}
+}
+
+#endif // TIKI_MPMCQUEUE_INL_INCLUDED
@@ -9,7 +9,8 @@ namespace tiki
 	template<typename T>
 	Queue<T>::Queue()
 	{
-		m_pData		= nullptr;
+		m_pAllocator	= nullptr;
+		m_pData			= nullptr;
 
 		m_top		= 0u;
 		m_bottom	= 0u;
@@ -23,9 +24,10 @@ namespace tiki
 	}
 
 	template<typename T>
-	bool Queue<T>::create( uint capacity, uint alignment /*= TIKI_DEFAULT_ALIGNMENT */ )
+	bool Queue<T>::create( uint capacity, uint alignment /*= TIKI_DEFAULT_ALIGNMENT */, Allocator* pAllocator /*= nullptr */ )
 	{
-		m_pData = TIKI_MEMORY_NEW_ARRAY_ALIGNED( T, capacity, alignment, true );
+		m_pAllocator	= pAllocator;
+		m_pData			= memory::newArray< T >( pAllocator, capacity, alignment, true );
 		if ( m_pData == nullptr )
 		{
 			return false;
@@ -43,9 +45,10 @@ namespace tiki
 	{
 		if ( m_pData != nullptr )
 		{
-			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 			m_pData = nullptr;
 		}
+		m_pAllocator = nullptr;
 
 		m_top		= 0u;
 		m_bottom	= 0u;
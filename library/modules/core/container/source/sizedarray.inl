@@ -7,7 +7,7 @@ namespace tiki
 {
 	template< typename T >
 	TIKI_FORCE_INLINE SizedArray< T >::SizedArray()
-		: m_pData( nullptr ), m_count( 0u ), m_capacity( 0u )
+		: m_count( 0u ), m_capacity( 0u ), m_pData( nullptr ), m_pAllocator( nullptr )
 	{
 	}
 
@@ -18,15 +18,16 @@ namespace tiki
 	}
 
 	template< typename T >
-	TIKI_FORCE_INLINE bool SizedArray< T >::create( uint capacity, size_t aligment /* = TIKI_DEFAULT_ALIGNMENT */, bool constructElements /* = true */ )
+	TIKI_FORCE_INLINE bool SizedArray< T >::create( uint capacity, size_t aligment /* = TIKI_DEFAULT_ALIGNMENT */, bool constructElements /* = true */, Allocator* pAllocator /* = nullptr */ )
 	{
 		TIKI_ASSERT( capacity > 0u );
 		TIKI_ASSERT( m_pData == nullptr );
 		TIKI_ASSERT( m_count == 0u );
 		TIKI_ASSERT( m_capacity == 0u );
 
-		m_capacity	= capacity;
-		m_pData		= TIKI_MEMORY_NEW_ARRAY_ALIGNED( T, capacity, aligment, constructElements );
+		m_pAllocator	= pAllocator;
+		m_capacity		= capacity;
+		m_pData			= memory::newArray< T >( pAllocator, capacity, (uint)aligment, constructElements );
 		if ( m_pData == nullptr )
 		{
 			dispose();
@@ -41,12 +42,13 @@ namespace tiki
 	{
 		if ( m_pData != nullptr )
 		{
-			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			memory::deleteArray( m_pAllocator, m_pData, m_capacity );
 		}
 
-		m_pData		= nullptr;
-		m_count		= 0u;
-		m_capacity	= 0u;
+		m_pAllocator	= nullptr;
+		m_pData			= nullptr;
+		m_count			= 0u;
+		m_capacity		= 0u;
 	}
 
 	template< typename T >
@@ -0,0 +1,264 @@
+#pragma once
+#ifndef TIKI_SOAARRAY_INL_INCLUDED
+#define TIKI_SOAARRAY_INL_INCLUDED
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 0u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T0 Type; };
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 1u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T1 Type; };
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 2u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T2 Type; };
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 3u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T3 Type; };
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 4u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T4 Type; };
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 5u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T5 Type; };
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 6u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T6 Type; };
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	struct SoaArrayFieldSelector< 7u, T0, T1, T2, T3, T4, T5, T6, T7 > { typedef T7 Type; };
+
+	namespace soaarray
+	{
+		// per field operations. unused fields take no memory and do nothing.
+		template<typename T>
+		struct FieldOperations
+		{
+			static TIKI_FORCE_INLINE uint getSize( uint capacity, uint alignment )
+			{
+				return alignValue( uint( sizeof( T ) * capacity ), alignment );
+			}
+
+			static TIKI_FORCE_INLINE void construct( void* pField, uint capacity )
+			{
+				T* pData = static_cast< T* >( pField );
+				for (uint i = 0u; i < capacity; ++i)
+				{
+					::new( &pData[ i ] ) T();
+				}
+			}
+
+			static TIKI_FORCE_INLINE void destruct( void* pField, uint capacity )
+			{
+				T* pData = static_cast< T* >( pField );
+				for (uint i = 0u; i < capacity; ++i)
+				{
+					pData[ i ].~T();
+				}
+			}
+
+			static TIKI_FORCE_INLINE void move( void* pField, uint targetIndex, uint sourceIndex )
+			{
+				T* pData = static_cast< T* >( pField );
+				pData[ targetIndex ] = pData[ sourceIndex ];
+			}
+		};
+
+		template<>
+		struct FieldOperations< SoaArrayNoField >
+		{
+			static TIKI_FORCE_INLINE uint getSize( uint, uint ) { return 0u; }
+			static TIKI_FORCE_INLINE void construct( void*, uint ) { }
+			static TIKI_FORCE_INLINE void destruct( void*, uint ) { }
+			static TIKI_FORCE_INLINE void move( void*, uint, uint ) { }
+		};
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	TIKI_FORCE_INLINE SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::SoaArray()
+	{
+		m_pAllocator	= nullptr;
+		m_pMemory		= nullptr;
+		m_count			= 0u;
+		m_capacity		= 0u;
+
+		for (uint i = 0u; i < MaxFieldCount; ++i)
+		{
+			m_apFields[ i ] = nullptr;
+		}
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	TIKI_FORCE_INLINE SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::~SoaArray()
+	{
+		TIKI_ASSERT( m_pMemory == nullptr );
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	TIKI_FORCE_INLINE bool SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::create( uint capacity, Allocator* pAllocator /* = nullptr */ )
+	{
+		TIKI_ASSERT( m_pMemory == nullptr );
+		TIKI_ASSERT( capacity > 0u );
+
+		capacity = alignValue( capacity, (uint)CapacityGranularity );
+
+		const uint aFieldSizes[] =
+		{
+			soaarray::FieldOperations< T0 >::getSize( capacity, FieldAlignment ),
+			soaarray::FieldOperations< T1 >::getSize( capacity, FieldAlignment ),
+			soaarray::FieldOperations< T2 >::getSize( capacity, FieldAlignment ),
+			soaarray::FieldOperations< T3 >::getSize( capacity, FieldAlignment ),
+			soaarray::FieldOperations< T4 >::getSize( capacity, FieldAlignment ),
+			soaarray::FieldOperations< T5 >::getSize( capacity, FieldAlignment ),
+			soaarray::FieldOperations< T6 >::getSize( capacity, FieldAlignment ),
+			soaarray::FieldOperations< T7 >::getSize( capacity, FieldAlignment )
+		};
+
+		uint memorySize = 0u;
+		for (uint i = 0u; i < MaxFieldCount; ++i)
+		{
+			memorySize += aFieldSizes[ i ];
+		}
+
+		// all fields share one block
+		m_pMemory = ( pAllocator != nullptr ? pAllocator->allocate( memorySize, FieldAlignment ) : TIKI_MEMORY_ALLOC_ALIGNED( memorySize, FieldAlignment ) );
+		if ( m_pMemory == nullptr )
+		{
+			return false;
+		}
+
+		m_pAllocator	= pAllocator;
+		m_capacity		= capacity;
+		m_count			= 0u;
+
+		uint8* pField = static_cast< uint8* >( m_pMemory );
+		for (uint i = 0u; i < MaxFieldCount; ++i)
+		{
+			m_apFields[ i ] = ( aFieldSizes[ i ] != 0u ? pField : nullptr );
+			pField += aFieldSizes[ i ];
+		}
+
+		soaarray::FieldOperations< T0 >::construct( m_apFields[ 0u ], capacity );
+		soaarray::FieldOperations< T1 >::construct( m_apFields[ 1u ], capacity );
+		soaarray::FieldOperations< T2 >::construct( m_apFields[ 2u ], capacity );
+		soaarray::FieldOperations< T3 >::construct( m_apFields[ 3u ], capacity );
+		soaarray::FieldOperations< T4 >::construct( m_apFields[ 4u ], capacity );
+		soaarray::FieldOperations< T5 >::construct( m_apFields[ 5u ], capacity );
+		soaarray::FieldOperations< T6 >::construct( m_apFields[ 6u ], capacity );
+		soaarray::FieldOperations< T7 >::construct( m_apFields[ 7u ], capacity );
+
+		return true;
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	TIKI_FORCE_INLINE void SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::dispose()
+	{
+		if ( m_pMemory != nullptr )
+		{
+			soaarray::FieldOperations< T0 >::destruct( m_apFields[ 0u ], m_capacity );
+			soaarray::FieldOperations< T1 >::destruct( m_apFields[ 1u ], m_capacity );
+			soaarray::FieldOperations< T2 >::destruct( m_apFields[ 2u ], m_capacity );
+			soaarray::FieldOperations< T3 >::destruct( m_apFields[ 3u ], m_capacity );
+			soaarray::FieldOperations< T4 >::destruct( m_apFields[ 4u ], m_capacity );
+			soaarray::FieldOperations< T5 >::destruct( m_apFields[ 5u ], m_capacity );
+			soaarray::FieldOperations< T6 >::destruct( m_apFields[ 6u ], m_capacity );
+			soaarray::FieldOperations< T7 >::destruct( m_apFields[ 7u ], m_capacity );
+
+			if ( m_pAllocator != nullptr )
+			{
+				m_pAllocator->free( m_pMemory );
+			}
+			else
+			{
+				TIKI_MEMORY_FREE( m_pMemory );
+			}
+		}
+
+		m_pAllocator	= nullptr;
+		m_pMemory		= nullptr;
+		m_count			= 0u;
+		m_capacity		= 0u;
+
+		for (uint i = 0u; i < MaxFieldCount; ++i)
+		{
+			m_apFields[ i ] = nullptr;
+		}
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	TIKI_FORCE_INLINE uint SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::push()
+	{
+		TIKI_ASSERT( m_count < m_capacity );
+		return m_count++;
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	TIKI_FORCE_INLINE void SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::removeUnsortedByIndex( uint index )
+	{
+		TIKI_ASSERT( index < m_count );
+
+		m_count--;
+		if ( index != m_count )
+		{
+			moveElement( index, m_count );
+		}
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	template<uint TIndex>
+	TIKI_FORCE_INLINE typename SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::template Field< TIndex >::Type* SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::getFieldData()
+	{
+		TIKI_COMPILETIME_ASSERT( TIndex < MaxFieldCount );
+		return static_cast< typename Field< TIndex >::Type* >( m_apFields[ TIndex ] );
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	template<uint TIndex>
+	TIKI_FORCE_INLINE const typename SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::template Field< TIndex >::Type* SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::getFieldData() const
+	{
+		TIKI_COMPILETIME_ASSERT( TIndex < MaxFieldCount );
+		return static_cast< const typename Field< TIndex >::Type* >( m_apFields[ TIndex ] );
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	template<uint TIndex>
+	TIKI_FORCE_INLINE void SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::getField( StaticArray< typename Field< TIndex >::Type >& target )
+	{
+		target.create( getFieldData< TIndex >(), m_count );
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	template<uint TIndex>
+	TIKI_FORCE_INLINE void SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::getField( StaticArray< const typename Field< TIndex >::Type >& target ) const
+	{
+		target.create( getFieldData< TIndex >(), m_count );
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	template<uint TIndex>
+	TIKI_FORCE_INLINE typename SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::template Field< TIndex >::Type& SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::get( uint index )
+	{
+		TIKI_ASSERT( index < m_count );
+		return getFieldData< TIndex >()[ index ];
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	template<uint TIndex>
+	TIKI_FORCE_INLINE const typename SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::template Field< TIndex >::Type& SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::get( uint index ) const
+	{
+		TIKI_ASSERT( index < m_count );
+		return getFieldData< TIndex >()[ index ];
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	TIKI_FORCE_INLINE void SoaArray< T0, T1, T2, T3, T4, T5, T6, T7 >::moveElement( uint targetIndex, uint sourceIndex )
+	{
+		soaarray::FieldOperations< T0 >::move( m_apFields[ 0u ], targetIndex, sourceIndex );
+		soaarray::FieldOperations< T1 >::move( m_apFields[ 1u ], targetIndex, sourceIndex );
+		soaarray::FieldOperations< T2 >::move( m_apFields[ 2u ], targetIndex, sourceIndex );
+		soaarray::FieldOperations< T3 >::move( m_apFields[ 3u ], targetIndex, sourceIndex );
+		soaarray::FieldOperations< T4 >::move( m_apFields[ 4u ], targetIndex, sourceIndex );
+		soaarray::FieldOperations< T5 >::move( m_apFields[ 5u ], targetIndex, sourceIndex );
+		soaarray::FieldOperations< T6 >::move( m_apFields[ 6u ], targetIndex, sourceIndex );
+		soaarray::FieldOperations< T7 >::move( m_apFields[ 7u ], targetIndex, sourceIndex );
+	}
+}
+
+#endif // TIKI_SOAARRAY_INL_INCLUDED
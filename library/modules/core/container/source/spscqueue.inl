@@ -0,0 +1,118 @@
+#pragma once
+#ifndef TIKI_SPSCQUEUE_INL_INCLUDED
+#define TIKI_SPSCQUEUE_INL_INCLUDED
+
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	template<typename T>
+	SpscQueue<T>::SpscQueue()
+	{
+		m_pData			= nullptr;
+		m_capacity		= 0u;
+		m_mask			= 0u;
+		m_cachedTail	= 0u;
+		m_cachedHead	= 0u;
+	}
+
+	template<typename T>
+	SpscQueue<T>::~SpscQueue()
+	{
+		TIKI_ASSERT( m_pData == nullptr );
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::create( uint capacity )
+	{
+		TIKI_ASSERT( m_pData == nullptr );
+		TIKI_ASSERT( capacity > 0u );
+
+		capacity = getNextPowerOfTwo( capacity );
+
+		m_pData = TIKI_MEMORY_NEW_ARRAY_ALIGNED( T, capacity, TIKI_CACHE_LINE_SIZE, true );
+		if ( m_pData == nullptr )
+		{
+			return false;
+		}
+
+		m_capacity		= capacity;
+		m_mask			= capacity - 1u;
+		m_cachedTail	= 0u;
+		m_cachedHead	= 0u;
+
+		m_head.store( 0u );
+		m_tail.store( 0u );
+
+		return true;
+	}
+
+	template<typename T>
+	void SpscQueue<T>::dispose()
+	{
+		if ( m_pData != nullptr )
+		{
+			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			m_pData = nullptr;
+		}
+
+		m_capacity	= 0u;
+		m_mask		= 0u;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::tryPush( ConstReference value )
+	{
+		const uint64 tail = m_tail.load( AtomicOrder_Relaxed );
+		if ( tail - m_cachedHead >= m_capacity )
+		{
+			// only touch the consumer cache line when our copy says the queue is full
+			m_cachedHead = m_head.load( AtomicOrder_Acquire );
+			if ( tail - m_cachedHead >= m_capacity )
+			{
+				return false;
+			}
+		}
+
+		m_pData[ tail & m_mask ] = value;
+		m_tail.store( tail + 1u, AtomicOrder_Release );
+
+		return true;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::tryPop( Reference target )
+	{
+		const uint64 head = m_head.load( AtomicOrder_Relaxed );
+		if ( head == m_cachedTail )
+		{
+			m_cachedTail = m_tail.load( AtomicOrder_Acquire );
+			if ( head == m_cachedTail )
+			{
+				return false;
+			}
+		}
+
+		target = m_pData[ head & m_mask ];
+		m_head.store( head + 1u, AtomicOrder_Release );
+
+		return true;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::isEmpty() const
+	{
+		return getCount() == 0u;
+	}
+
+	template<typename T>
+	uint SpscQueue<T>::getCount() const
+	{
+		const uint64 head = m_head.load( AtomicOrder_Acquire );
+		const uint64 tail = m_tail.load( AtomicOrder_Acquire );
+		return ( tail > head ? uint( tail - head ) : 0u );
+	}
+}
+
+#endif // TIKI_SPSCQUEUE_INL_INCLUDED
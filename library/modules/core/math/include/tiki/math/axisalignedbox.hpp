@@ -6,6 +6,8 @@
 
 namespace tiki
 {
+	struct Matrix43;
+
 	enum AxisAlignedBoxVertices
 	{
 		//		   7-------6
@@ -38,11 +40,18 @@ namespace tiki
 		void		createFromCenterExtends( const Vector3& center, const Vector3& extents );
 		void		createFromMinMax( const Vector3& _min, const Vector3& _max );
 		void		createFromMinMax( float minX, float minY, float minZ, float maxX, float maxY, float maxZ );
+		// a box that is never culled. the size is finite because infinite bounds turn to nan in transform and culling.
+		void		createUnbounded();
 
 		void		getVertices( Vector3 aVertices[ AxisAlignedBoxVertices_Count ] ) const;
 
 		void		translate( const Vector3& translation );
 		void		extend( const Vector3& _extents );
+		void		extendByPoint( const Vector3& point );
+		void		extendByBox( const AxisAlignedBox& box );
+
+		// the box around the transformed box
+		void		transform( const Matrix43& mtx );
 
 		bool		contains( const Vector3& point ) const;
 
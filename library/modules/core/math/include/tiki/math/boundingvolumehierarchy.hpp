@@ -0,0 +1,95 @@
+#pragma once
+#ifndef TIKI_BOUNDINGVOLUMEHIERARCHY_HPP_INCLUDED
+#define TIKI_BOUNDINGVOLUMEHIERARCHY_HPP_INCLUDED
+
+#include "tiki/container/list.hpp"
+#include "tiki/math/axisalignedbox.hpp"
+
+namespace tiki
+{
+	class Frustum;
+	struct Ray;
+	struct Sphere;
+
+	enum
+	{
+		BoundingVolumeHierarchyInvalidProxyId	= 0xffffffffu
+	};
+
+	// dynamic aabb tree. the leaves store fat boxes which are extended by a margin, so small movements don't
+	// change the tree. inserting picks the sibling with the lowest surface area cost and the nodes on the path
+	// to the root are rebalanced with tree rotations, so the height stays logarithmic.
+	//
+	// the queries append the user data of all proxies whose fat box passes the test, the results are a
+	// conservative superset of the exact bounds.
+	class BoundingVolumeHierarchy
+	{
+		TIKI_NONCOPYABLE_CLASS( BoundingVolumeHierarchy );
+
+	public:
+
+						BoundingVolumeHierarchy();
+						~BoundingVolumeHierarchy();
+
+		// pAllocator nullptr selects the global heap
+		bool			create( float fatMargin = 0.1f, uint initialProxyCapacity = 256u, Allocator* pAllocator = nullptr );
+		void			dispose();
+
+		uint32			addProxy( const AxisAlignedBox& box, void* pUserData );
+		void			removeProxy( uint32 proxyId );
+		// refits the proxy. the leaf is only reinserted if the box left the fat box, returns true in this case.
+		bool			moveProxy( uint32 proxyId, const AxisAlignedBox& box );
+
+		void*			getUserData( uint32 proxyId ) const;
+		const AxisAlignedBox&	getFatBox( uint32 proxyId ) const;
+
+		uint			getProxyCount() const	{ return m_proxyCount; }
+		uint			getHeight() const;
+
+		void			queryBox( List< void* >& results, const AxisAlignedBox& box ) const;
+		void			querySphere( List< void* >& results, const Sphere& sphere ) const;
+		void			queryFrustum( List< void* >& results, const Frustum& frustum ) const;
+		void			queryRay( List< void* >& results, const Ray& ray, float maxDistance ) const;
+
+	private:
+
+		enum
+		{
+			InvalidNodeIndex	= 0xffffffffu,
+			MaxStackSize		= 256u
+		};
+
+		struct Node
+		{
+			AxisAlignedBox	box;
+			void*			pUserData;
+
+			uint32			parentIndex;	// next free node for unused nodes
+			uint32			childIndex1;
+			uint32			childIndex2;
+			sint32			height;			// 0 for leaves, -1 for unused nodes
+
+			bool			isLeaf() const	{ return childIndex1 == InvalidNodeIndex; }
+		};
+
+		List< Node >	m_nodes;
+		uint32			m_rootIndex;
+		uint32			m_firstFreeIndex;
+
+		uint			m_proxyCount;
+		float			m_fatMargin;
+
+		uint32			allocateNode();
+		void			freeNode( uint32 nodeIndex );
+
+		void			insertLeaf( uint32 leafIndex );
+		void			removeLeaf( uint32 leafIndex );
+		void			refitParents( uint32 nodeIndex );
+		uint32			balance( uint32 nodeIndex );
+
+		void			addSubtree( List< void* >& results, uint32 nodeIndex ) const;
+
+	};
+}
+
+#endif // TIKI_BOUNDINGVOLUMEHIERARCHY_HPP_INCLUDED
@@ -2,13 +2,15 @@
 #ifndef __TIKI_FRUSTUM_HPP_INCLUDED__
 #define __TIKI_FRUSTUM_HPP_INCLUDED__
 
+#include "tiki/math/intersection.hpp"
 #include "tiki/math/matrix.hpp"
 #include "tiki/math/plane.hpp"
 
 namespace tiki
 {
-	//struct BoundingBox;
-	//struct BoundingSphere;
+	struct AxisAlignedBox;
+	struct Box;
+	struct Sphere;
 
 	enum FrustumPlane
 	{
@@ -43,17 +45,29 @@ namespace tiki
 		void					create( const Matrix44& viewProjection );
 		void					create( const Vector3 aCorners[ FrustumCorner_Count ] );
 
-		//FrustumIntersectionType	testIntersectionPoint( const Vector3& point ) const;
-		//FrustumIntersectionType	testIntersectionBoundingBox( const BoundingBox& box ) const;
-		//FrustumIntersectionType	testIntersectionBoundingSphere( const BoundingSphere& sphere ) const;
-		
+		// the plane tests are conservative: bounds near the edges of the frustum can be reported as intersecting
+		// even if they are outside. precise also tests the frustum corners against the bounds and rejects most of
+		// them, the remaining false positives are only possible at the frustum edges.
+		IntersectionTypes		testIntersectionPoint( const Vector3& point ) const;
+		IntersectionTypes		testIntersectionAxisAlignedBox( const AxisAlignedBox& box, bool precise = false ) const;
+		IntersectionTypes		testIntersectionBox( const Box& box, bool precise = false ) const;
+		IntersectionTypes		testIntersectionSphere( const Sphere& sphere, bool precise = false ) const;
+
+		// conservative batch culling. bit i % 32 of pVisibilityMask[ i / 32 ] is set if bound i is not disjoint,
+		// so pVisibilityMask needs ( count + 31 ) / 32 words.
+		void					cullAxisAlignedBoxes( uint32* pVisibilityMask, const AxisAlignedBox* pBoxes, uint count ) const;
+		void					cullSpheres( uint32* pVisibilityMask, const Sphere* pSpheres, uint count ) const;
+		void					cullSpheres( uint32* pVisibilityMask, const float* pCenterX, const float* pCenterY, const float* pCenterZ, const float* pRadius, uint count ) const;
+
 		bool					getCorner( Vector3& targetVector, FrustumCorner corner ) const;
 		bool					getCorners( Vector3 aCorners[ FrustumCorner_Count ] ) const;
 		const Plane&			getPlane( FrustumPlane plane ) const;
 
 	private:
 				
+		// the inside of the frustum is on the positive side of all planes
 		Plane					m_planes[ FrustumPlane_Count ];
+		Vector3					m_corners[ FrustumCorner_Count ];
 
 		bool					getThreePlanesIntersectionPoint( Vector3& targetVector, const Plane& plane1, const Plane& plane2, const Plane& plane3 ) const;
 
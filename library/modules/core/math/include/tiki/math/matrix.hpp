@@ -94,6 +94,7 @@ namespace tiki
 		TIKI_FORCE_INLINE bool		invert( Matrix33& mtx, const Matrix33& source );	// try to invert. returns false if determinant is zero.
 		TIKI_FORCE_INLINE bool		invert( Matrix43& mtx, const Matrix43& source );	// try to invert. returns false if determinant is zero.
 		TIKI_FORCE_INLINE bool		invert( Matrix44& mtx, const Matrix44& source );	// try to invert. returns false if determinant is zero.
+		TIKI_FORCE_INLINE bool		invertTranspose( Matrix44& mtx, const Matrix43& source );	// same as set, invert and transpose. returns false if determinant is zero.
 
 		TIKI_FORCE_INLINE Matrix33&	lerp( Matrix33& mtx, const Matrix33& start, const Matrix33& end, const float amount );
 		TIKI_FORCE_INLINE Matrix43&	lerp( Matrix43& mtx, const Matrix43& start, const Matrix43& end, const float amount );
@@ -111,6 +112,12 @@ namespace tiki
 
 		void						compose( Matrix44& target, const Quaternion& rotation, const Vector3& translation, const Vector3& scale );
 		bool						decompose( Quaternion& rotation, Vector3& translation, Vector3& scale, const Matrix44& source );
+
+		// batched versions of transform, mul and compose. target can be the same array as a source.
+		void						transformBatch( Vector3* pTarget, const Vector3* pSource, uint count, const Matrix43& mtx );
+		void						mulBatch( Matrix44* pTarget, const Matrix44* pLhs, const Matrix44* pRhs, uint count );
+		// the sources of compose are read stride bytes apart, they can be members of an array of joints
+		void						composeBatch( Matrix44* pTarget, const Quaternion* pRotations, const Vector3* pTranslations, const Vector3* pScales, uint count, uint stride );
 	}
 }
 
@@ -1,5 +1,7 @@
 #include "tiki/math/axisalignedbox.hpp"
 
+#include "tiki/math/matrix.hpp"
+
 namespace tiki
 {
 	AxisAlignedBox::AxisAlignedBox()
@@ -27,6 +29,14 @@ namespace tiki
 		vector::set( max, maxX, maxY, maxZ );
 	}
 
+	void AxisAlignedBox::createUnbounded()
+	{
+		// the sum of three rotated extents and the plane distances still fit into a float
+		const float extent = 1.0e18f;
+		vector::set( min, -extent, -extent, -extent );
+		vector::set( max, extent, extent, extent );
+	}
+
 	void AxisAlignedBox::getVertices( Vector3 aVertices[ AxisAlignedBoxVertices_Count ] ) const
 	{
 		vector::set( aVertices[ AxisAlignedBoxVertices_XMinYMinZMin ], min.x, min.y, min.z );
@@ -51,6 +61,38 @@ namespace tiki
 		vector::add( max, _extents );
 	}
 
+	void AxisAlignedBox::extendByPoint( const Vector3& point )
+	{
+		vector::set( min, TIKI_MIN( min.x, point.x ), TIKI_MIN( min.y, point.y ), TIKI_MIN( min.z, point.z ) );
+		vector::set( max, TIKI_MAX( max.x, point.x ), TIKI_MAX( max.y, point.y ), TIKI_MAX( max.z, point.z ) );
+	}
+
+	void AxisAlignedBox::extendByBox( const AxisAlignedBox& box )
+	{
+		extendByPoint( box.min );
+		extendByPoint( box.max );
+	}
+
+	void AxisAlignedBox::transform( const Matrix43& mtx )
+	{
+		// projects the extents onto the rotated axes instead of transforming all eight vertices
+		Vector3 center = getCenter();
+		matrix::transform( center, mtx );
+
+		Vector3 extents = getSize();
+		vector::scale( extents, 0.5f );
+
+		const Vector3 newExtents =
+		{
+			f32::abs( mtx.rot.x.x ) * extents.x + f32::abs( mtx.rot.x.y ) * extents.y + f32::abs( mtx.rot.x.z ) * extents.z,
+			f32::abs( mtx.rot.y.x ) * extents.x + f32::abs( mtx.rot.y.y ) * extents.y + f32::abs( mtx.rot.y.z ) * extents.z,
+			f32::abs( mtx.rot.z.x ) * extents.x + f32::abs( mtx.rot.z.y ) * extents.y + f32::abs( mtx.rot.z.z ) * extents.z
+		};
+
+		vector::sub( min, center, newExtents );
+		vector::add( max, center, newExtents );
+	}
+
 	bool AxisAlignedBox::contains( const Vector3& point ) const
 	{
 		return min.x <= point.x && min.y <= point.y && min.z <= point.z &&
@@ -67,6 +109,7 @@ namespace tiki
 
 	Vector3 AxisAlignedBox::getSize() const
 	{
-		return vector::sub( Vector3(), max, min );
+		Vector3 size;
+		return vector::sub( size, max, min );
 	}
 }
@@ -0,0 +1,623 @@
+#include "tiki/math/boundingvolumehierarchy.hpp"
+
+#include "tiki/math/frustum.hpp"
+#include "tiki/math/ray.hpp"
+#include "tiki/math/sphere.hpp"
+
+namespace tiki
+{
+	static TIKI_FORCE_INLINE void combineBoundingVolumeBoxes( AxisAlignedBox& target, const AxisAlignedBox& box1, const AxisAlignedBox& box2 )
+	{
+		vector::set( target.min, TIKI_MIN( box1.min.x, box2.min.x ), TIKI_MIN( box1.min.y, box2.min.y ), TIKI_MIN( box1.min.z, box2.min.z ) );
+		vector::set( target.max, TIKI_MAX( box1.max.x, box2.max.x ), TIKI_MAX( box1.max.y, box2.max.y ), TIKI_MAX( box1.max.z, box2.max.z ) );
+	}
+
+	// half of the surface area, the factor doesn't matter for the cost comparison
+	static TIKI_FORCE_INLINE float getBoundingVolumeBoxArea( const AxisAlignedBox& box )
+	{
+		const float x = box.max.x - box.min.x;
+		const float y = box.max.y - box.min.y;
+		const float z = box.max.z - box.min.z;
+		return x * y + y * z + z * x;
+	}
+
+	static TIKI_FORCE_INLINE float getBoundingVolumeCombinedArea( const AxisAlignedBox& box1, const AxisAlignedBox& box2 )
+	{
+		AxisAlignedBox combined;
+		combineBoundingVolumeBoxes( combined, box1, box2 );
+		return getBoundingVolumeBoxArea( combined );
+	}
+
+	static TIKI_FORCE_INLINE bool isBoundingVolumeBoxOverlapping( const AxisAlignedBox& box1, const AxisAlignedBox& box2 )
+	{
+		return box1.min.x <= box2.max.x && box1.min.y <= box2.max.y && box1.min.z <= box2.max.z &&
+			box2.min.x <= box1.max.x && box2.min.y <= box1.max.y && box2.min.z <= box1.max.z;
+	}
+
+	static TIKI_FORCE_INLINE bool isBoundingVolumeBoxContaining( const AxisAlignedBox& outer, const AxisAlignedBox& inner )
+	{
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+			inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+	}
+
+	static TIKI_FORCE_INLINE bool isBoundingVolumeBoxOverlappingSphere( const AxisAlignedBox& box, const Sphere& sphere )
+	{
+		const float x = TIKI_MAX( TIKI_MAX( box.min.x - sphere.center.x, sphere.center.x - box.max.x ), 0.0f );
+		const float y = TIKI_MAX( TIKI_MAX( box.min.y - sphere.center.y, sphere.center.y - box.max.y ), 0.0f );
+		const float z = TIKI_MAX( TIKI_MAX( box.min.z - sphere.center.z, sphere.center.z - box.max.z ), 0.0f );
+		return x * x + y * y + z * z <= sphere.radius * sphere.radius;
+	}
+
+	// slab test. the inverse direction is infinite for axis parallel rays, which works with ieee floats as long
+	// as the origin is not exactly on a slab.
+	static TIKI_FORCE_INLINE bool isBoundingVolumeBoxHitByRay( const AxisAlignedBox& box, const Vector3& origin, const Vector3& inverseDirection, float maxDistance )
+	{
+		const float x1 = ( box.min.x - origin.x ) * inverseDirection.x;
+		const float x2 = ( box.max.x - origin.x ) * inverseDirection.x;
+		const float y1 = ( box.min.y - origin.y ) * inverseDirection.y;
+		const float y2 = ( box.max.y - origin.y ) * inverseDirection.y;
+		const float z1 = ( box.min.z - origin.z ) * inverseDirection.z;
+		const float z2 = ( box.max.z - origin.z ) * inverseDirection.z;
+
+		const float entry	= TIKI_MAX( TIKI_MAX( TIKI_MIN( x1, x2 ), TIKI_MIN( y1, y2 ) ), TIKI_MAX( TIKI_MIN( z1, z2 ), 0.0f ) );
+		const float exit	= TIKI_MIN( TIKI_MIN( TIKI_MAX( x1, x2 ), TIKI_MAX( y1, y2 ) ), TIKI_MIN( TIKI_MAX( z1, z2 ), maxDistance ) );
+		return entry <= exit;
+	}
+
+	BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+	{
+		m_rootIndex			= InvalidNodeIndex;
+		m_firstFreeIndex	= InvalidNodeIndex;
+		m_proxyCount		= 0u;
+		m_fatMargin			= 0.0f;
+	}
+
+	BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+	{
+		TIKI_ASSERT( m_nodes.getCount() == 0u );
+	}
+
+	bool BoundingVolumeHierarchy::create( float fatMargin /* = 0.1f */, uint initialProxyCapacity /* = 256u */, Allocator* pAllocator /* = nullptr */ )
+	{
+		TIKI_ASSERT( fatMargin >= 0.0f );
+
+		m_fatMargin = fatMargin;
+
+		// a tree with n leaves has n - 1 inner nodes
+		m_nodes.setAllocator( pAllocator );
+		m_nodes.reserve( initialProxyCapacity * 2u );
+
+		m_rootIndex			= InvalidNodeIndex;
+		m_firstFreeIndex	= InvalidNodeIndex;
+		m_proxyCount		= 0u;
+
+		return true;
+	}
+
+	void BoundingVolumeHierarchy::dispose()
+	{
+		m_nodes.dispose();
+
+		m_rootIndex			= InvalidNodeIndex;
+		m_firstFreeIndex	= InvalidNodeIndex;
+		m_proxyCount		= 0u;
+	}
+
+	uint32 BoundingVolumeHierarchy::addProxy( const AxisAlignedBox& box, void* pUserData )
+	{
+		const uint32 proxyId = allocateNode();
+
+		Node& node = m_nodes[ proxyId ];
+		node.box		= box;
+		node.pUserData	= pUserData;
+		node.height		= 0;
+
+		const Vector3 margin = { m_fatMargin, m_fatMargin, m_fatMargin };
+		node.box.extend( margin );
+
+		insertLeaf( proxyId );
+		m_proxyCount++;
+
+		return proxyId;
+	}
+
+	void BoundingVolumeHierarchy::removeProxy( uint32 proxyId )
+	{
+		TIKI_ASSERT( proxyId < m_nodes.getCount() );
+		TIKI_ASSERT( m_nodes[ proxyId ].isLeaf() && m_nodes[ proxyId ].height == 0 );
+
+		removeLeaf( proxyId );
+		freeNode( proxyId );
+		m_proxyCount--;
+	}
+
+	bool BoundingVolumeHierarchy::moveProxy( uint32 proxyId, const AxisAlignedBox& box )
+	{
+		TIKI_ASSERT( proxyId < m_nodes.getCount() );
+		TIKI_ASSERT( m_nodes[ proxyId ].isLeaf() && m_nodes[ proxyId ].height == 0 );
+
+		if( isBoundingVolumeBoxContaining( m_nodes[ proxyId ].box, box ) )
+		{
+			return false;
+		}
+
+		removeLeaf( proxyId );
+
+		const Vector3 margin = { m_fatMargin, m_fatMargin, m_fatMargin };
+		m_nodes[ proxyId ].box = box;
+		m_nodes[ proxyId ].box.extend( margin );
+
+		insertLeaf( proxyId );
+
+		return true;
+	}
+
+	void* BoundingVolumeHierarchy::getUserData( uint32 proxyId ) const
+	{
+		TIKI_ASSERT( proxyId < m_nodes.getCount() );
+		return m_nodes[ proxyId ].pUserData;
+	}
+
+	const AxisAlignedBox& BoundingVolumeHierarchy::getFatBox( uint32 proxyId ) const
+	{
+		TIKI_ASSERT( proxyId < m_nodes.getCount() );
+		return m_nodes[ proxyId ].box;
+	}
+
+	uint BoundingVolumeHierarchy::getHeight() const
+	{
+		if( m_rootIndex == InvalidNodeIndex )
+		{
+			return 0u;
+		}
+
+		return uint( m_nodes[ m_rootIndex ].height );
+	}
+
+	void BoundingVolumeHierarchy::queryBox( List< void* >& results, const AxisAlignedBox& box ) const
+	{
+		if( m_rootIndex == InvalidNodeIndex )
+		{
+			return;
+		}
+
+		uint32 aStack[ MaxStackSize ];
+		uint stackSize = 0u;
+		aStack[ stackSize++ ] = m_rootIndex;
+
+		while( stackSize > 0u )
+		{
+			const Node& node = m_nodes[ aStack[ --stackSize ] ];
+			if( !isBoundingVolumeBoxOverlapping( node.box, box ) )
+			{
+				continue;
+			}
+
+			if( node.isLeaf() )
+			{
+				results.add( node.pUserData );
+				continue;
+			}
+
+			TIKI_ASSERT( stackSize + 2u <= MaxStackSize );
+			aStack[ stackSize++ ] = node.childIndex1;
+			aStack[ stackSize++ ] = node.childIndex2;
+		}
+	}
+
+	void BoundingVolumeHierarchy::querySphere( List< void* >& results, const Sphere& sphere ) const
+	{
+		if( m_rootIndex == InvalidNodeIndex )
+		{
+			return;
+		}
+
+		uint32 aStack[ MaxStackSize ];
+		uint stackSize = 0u;
+		aStack[ stackSize++ ] = m_rootIndex;
+
+		while( stackSize > 0u )
+		{
+			const Node& node = m_nodes[ aStack[ --stackSize ] ];
+			if( !isBoundingVolumeBoxOverlappingSphere( node.box, sphere ) )
+			{
+				continue;
+			}
+
+			if( node.isLeaf() )
+			{
+				results.add( node.pUserData );
+				continue;
+			}
+
+			TIKI_ASSERT( stackSize + 2u <= MaxStackSize );
+			aStack[ stackSize++ ] = node.childIndex1;
+			aStack[ stackSize++ ] = node.childIndex2;
+		}
+	}
+
+	void BoundingVolumeHierarchy::queryFrustum( List< void* >& results, const Frustum& frustum ) const
+	{
+		if( m_rootIndex == InvalidNodeIndex )
+		{
+			return;
+		}
+
+		uint32 aStack[ MaxStackSize ];
+		uint stackSize = 0u;
+		aStack[ stackSize++ ] = m_rootIndex;
+
+		while( stackSize > 0u )
+		{
+			const uint32 nodeIndex = aStack[ --stackSize ];
+			const Node& node = m_nodes[ nodeIndex ];
+
+			const IntersectionTypes intersection = frustum.testIntersectionAxisAlignedBox( node.box );
+			if( intersection == IntersectionTypes_Disjoint )
+			{
+				continue;
+			}
+			else if( intersection == IntersectionTypes_Contains || node.isLeaf() )
+			{
+				// everything below is visible, no need to test it
+				addSubtree( results, nodeIndex );
+				continue;
+			}
+
+			TIKI_ASSERT( stackSize + 2u <= MaxStackSize );
+			aStack[ stackSize++ ] = node.childIndex1;
+			aStack[ stackSize++ ] = node.childIndex2;
+		}
+	}
+
+	void BoundingVolumeHierarchy::queryRay( List< void* >& results, const Ray& ray, float maxDistance ) const
+	{
+		if( m_rootIndex == InvalidNodeIndex )
+		{
+			return;
+		}
+
+		const Vector3 inverseDirection = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+
+		uint32 aStack[ MaxStackSize ];
+		uint stackSize = 0u;
+		aStack[ stackSize++ ] = m_rootIndex;
+
+		while( stackSize > 0u )
+		{
+			const Node& node = m_nodes[ aStack[ --stackSize ] ];
+			if( !isBoundingVolumeBoxHitByRay( node.box, ray.origin, inverseDirection, maxDistance ) )
+			{
+				continue;
+			}
+
+			if( node.isLeaf() )
+			{
+				results.add( node.pUserData );
+				continue;
+			}
+
+			TIKI_ASSERT( stackSize + 2u <= MaxStackSize );
+			aStack[ stackSize++ ] = node.childIndex1;
+			aStack[ stackSize++ ] = node.childIndex2;
+		}
+	}
+
+	uint32 BoundingVolumeHierarchy::allocateNode()
+	{
+		uint32 nodeIndex = m_firstFreeIndex;
+		if( nodeIndex != InvalidNodeIndex )
+		{
+			m_firstFreeIndex = m_nodes[ nodeIndex ].parentIndex;
+		}
+		else
+		{
+			nodeIndex = uint32( m_nodes.getCount() );
+			m_nodes.add();
+		}
+
+		Node& node = m_nodes[ nodeIndex ];
+		node.pUserData		= nullptr;
+		node.parentIndex	= InvalidNodeIndex;
+		node.childIndex1	= InvalidNodeIndex;
+		node.childIndex2	= InvalidNodeIndex;
+		node.height			= 0;
+
+		return nodeIndex;
+	}
+
+	void BoundingVolumeHierarchy::freeNode( uint32 nodeIndex )
+	{
+		Node& node = m_nodes[ nodeIndex ];
+		node.parentIndex	= m_firstFreeIndex;
+		node.height			= -1;
+
+		m_firstFreeIndex = nodeIndex;
+	}
+
+	void BoundingVolumeHierarchy::insertLeaf( uint32 leafIndex )
+	{
+		if( m_rootIndex == InvalidNodeIndex )
+		{
+			m_rootIndex = leafIndex;
+			m_nodes[ leafIndex ].parentIndex = InvalidNodeIndex;
+			return;
+		}
+
+		// walk down to the sibling with the lowest cost. the cost of a node is the area of the new parent plus the
+		// growth of all ancestors.
+		const AxisAlignedBox leafBox = m_nodes[ leafIndex ].box;
+
+		uint32 siblingIndex = m_rootIndex;
+		while( !m_nodes[ siblingIndex ].isLeaf() )
+		{
+			const Node& node	= m_nodes[ siblingIndex ];
+			const Node& child1	= m_nodes[ node.childIndex1 ];
+			const Node& child2	= m_nodes[ node.childIndex2 ];
+
+			const float area			= getBoundingVolumeBoxArea( node.box );
+			const float combinedArea	= getBoundingVolumeCombinedArea( node.box, leafBox );
+
+			// cost to make a new parent for this node and the leaf
+			const float cost			= 2.0f * combinedArea;
+			// the leaf increases the area of this node and all ancestors
+			const float inheritanceCost	= 2.0f * ( combinedArea - area );
+
+			float cost1 = getBoundingVolumeCombinedArea( child1.box, leafBox ) + inheritanceCost;
+			if( !child1.isLeaf() )
+			{
+				cost1 -= getBoundingVolumeBoxArea( child1.box );
+			}
+
+			float cost2 = getBoundingVolumeCombinedArea( child2.box, leafBox ) + inheritanceCost;
+			if( !child2.isLeaf() )
+			{
+				cost2 -= getBoundingVolumeBoxArea( child2.box );
+			}
+
+			if( cost < cost1 && cost < cost2 )
+			{
+				break;
+			}
+
+			siblingIndex = ( cost1 < cost2 ? node.childIndex1 : node.childIndex2 );
+		}
+
+		// the allocation can move the nodes, so no references are kept over it
+		const uint32 newParentIndex	= allocateNode();
+		const uint32 oldParentIndex	= m_nodes[ siblingIndex ].parentIndex;
+
+		Node& newParent = m_nodes[ newParentIndex ];
+		newParent.parentIndex	= oldParentIndex;
+		newParent.childIndex1	= siblingIndex;
+		newParent.childIndex2	= leafIndex;
+		newParent.height		= m_nodes[ siblingIndex ].height + 1;
+		combineBoundingVolumeBoxes( newParent.box, leafBox, m_nodes[ siblingIndex ].box );
+
+		if( oldParentIndex != InvalidNodeIndex )
+		{
+			Node& oldParent = m_nodes[ oldParentIndex ];
+			if( oldParent.childIndex1 == siblingIndex )
+			{
+				oldParent.childIndex1 = newParentIndex;
+			}
+			else
+			{
+				oldParent.childIndex2 = newParentIndex;
+			}
+		}
+		else
+		{
+			m_rootIndex = newParentIndex;
+		}
+
+		m_nodes[ siblingIndex ].parentIndex	= newParentIndex;
+		m_nodes[ leafIndex ].parentIndex	= newParentIndex;
+
+		refitParents( newParentIndex );
+	}
+
+	void BoundingVolumeHierarchy::removeLeaf( uint32 leafIndex )
+	{
+		if( leafIndex == m_rootIndex )
+		{
+			m_rootIndex = InvalidNodeIndex;
+			return;
+		}
+
+		const uint32 parentIndex		= m_nodes[ leafIndex ].parentIndex;
+		const uint32 grandParentIndex	= m_nodes[ parentIndex ].parentIndex;
+		const uint32 siblingIndex		= ( m_nodes[ parentIndex ].childIndex1 == leafIndex ? m_nodes[ parentIndex ].childIndex2 : m_nodes[ parentIndex ].childIndex1 );
+
+		// the sibling takes the place of the parent
+		if( grandParentIndex != InvalidNodeIndex )
+		{
+			Node& grandParent = m_nodes[ grandParentIndex ];
+			if( grandParent.childIndex1 == parentIndex )
+			{
+				grandParent.childIndex1 = siblingIndex;
+			}
+			else
+			{
+				grandParent.childIndex2 = siblingIndex;
+			}
+			m_nodes[ siblingIndex ].parentIndex = grandParentIndex;
+			freeNode( parentIndex );
+
+			refitParents( grandParentIndex );
+		}
+		else
+		{
+			m_rootIndex = siblingIndex;
+			m_nodes[ siblingIndex ].parentIndex = InvalidNodeIndex;
+			freeNode( parentIndex );
+		}
+	}
+
+	void BoundingVolumeHierarchy::refitParents( uint32 nodeIndex )
+	{
+		while( nodeIndex != InvalidNodeIndex )
+		{
+			nodeIndex = balance( nodeIndex );
+
+			Node& node = m_nodes[ nodeIndex ];
+			const Node& child1 = m_nodes[ node.childIndex1 ];
+			const Node& child2 = m_nodes[ node.childIndex2 ];
+
+			node.height = 1 + TIKI_MAX( child1.height, child2.height );
+			combineBoundingVolumeBoxes( node.box, child1.box, child2.box );
+
+			nodeIndex = node.parentIndex;
+		}
+	}
+
+	// rotates the higher child up if the heights of the children differ by more than one. returns the index of
+	// the node which is now at the position of nodeIndex.
+	uint32 BoundingVolumeHierarchy::balance( uint32 nodeIndexA )
+	{
+		Node& nodeA = m_nodes[ nodeIndexA ];
+		if( nodeA.isLeaf() || nodeA.height < 2 )
+		{
+			return nodeIndexA;
+		}
+
+		const uint32 nodeIndexB	= nodeA.childIndex1;
+		const uint32 nodeIndexC	= nodeA.childIndex2;
+		Node& nodeB				= m_nodes[ nodeIndexB ];
+		Node& nodeC				= m_nodes[ nodeIndexC ];
+
+		const sint32 difference = nodeC.height - nodeB.height;
+		if( difference > 1 )
+		{
+			// rotate c up
+			const uint32 nodeIndexF	= nodeC.childIndex1;
+			const uint32 nodeIndexG	= nodeC.childIndex2;
+			Node& nodeF				= m_nodes[ nodeIndexF ];
+			Node& nodeG				= m_nodes[ nodeIndexG ];
+
+			nodeC.childIndex1	= nodeIndexA;
+			nodeC.parentIndex	= nodeA.parentIndex;
+			nodeA.parentIndex	= nodeIndexC;
+
+			if( nodeC.parentIndex != InvalidNodeIndex )
+			{
+				Node& parent = m_nodes[ nodeC.parentIndex ];
+				if( parent.childIndex1 == nodeIndexA )
+				{
+					parent.childIndex1 = nodeIndexC;
+				}
+				else
+				{
+					parent.childIndex2 = nodeIndexC;
+				}
+			}
+			else
+			{
+				m_rootIndex = nodeIndexC;
+			}
+
+			// the higher grand child stays at c
+			if( nodeF.height > nodeG.height )
+			{
+				nodeC.childIndex2	= nodeIndexF;
+				nodeA.childIndex2	= nodeIndexG;
+				nodeG.parentIndex	= nodeIndexA;
+				combineBoundingVolumeBoxes( nodeA.box, nodeB.box, nodeG.box );
+				combineBoundingVolumeBoxes( nodeC.box, nodeA.box, nodeF.box );
+
+				nodeA.height = 1 + TIKI_MAX( nodeB.height, nodeG.height );
+				nodeC.height = 1 + TIKI_MAX( nodeA.height, nodeF.height );
+			}
+			else
+			{
+				nodeC.childIndex2	= nodeIndexG;
+				nodeA.childIndex2	= nodeIndexF;
+				nodeF.parentIndex	= nodeIndexA;
+				combineBoundingVolumeBoxes( nodeA.box, nodeB.box, nodeF.box );
+				combineBoundingVolumeBoxes( nodeC.box, nodeA.box, nodeG.box );
+
+				nodeA.height = 1 + TIKI_MAX( nodeB.height, nodeF.height );
+				nodeC.height = 1 + TIKI_MAX( nodeA.height, nodeG.height );
+			}
+
+			return nodeIndexC;
+		}
+		else if( difference < -1 )
+		{
+			// rotate b up
+			const uint32 nodeIndexD	= nodeB.childIndex1;
+			const uint32 nodeIndexE	= nodeB.childIndex2;
+			Node& nodeD				= m_nodes[ nodeIndexD ];
+			Node& nodeE				= m_nodes[ nodeIndexE ];
+
+			nodeB.childIndex1	= nodeIndexA;
+			nodeB.parentIndex	= nodeA.parentIndex;
+			nodeA.parentIndex	= nodeIndexB;
+
+			if( nodeB.parentIndex != InvalidNodeIndex )
+			{
+				Node& parent = m_nodes[ nodeB.parentIndex ];
+				if( parent.childIndex1 == nodeIndexA )
+				{
+					parent.childIndex1 = nodeIndexB;
+				}
+				else
+				{
+					parent.childIndex2 = nodeIndexB;
+				}
+			}
+			else
+			{
+				m_rootIndex = nodeIndexB;
+			}
+
+			if( nodeD.height > nodeE.height )
+			{
+				nodeB.childIndex2	= nodeIndexD;
+				nodeA.childIndex1	= nodeIndexE;
+				nodeE.parentIndex	= nodeIndexA;
+				combineBoundingVolumeBoxes( nodeA.box, nodeC.box, nodeE.box );
+				combineBoundingVolumeBoxes( nodeB.box, nodeA.box, nodeD.box );
+
+				nodeA.height = 1 + TIKI_MAX( nodeC.height, nodeE.height );
+				nodeB.height = 1 + TIKI_MAX( nodeA.height, nodeD.height );
+			}
+			else
+			{
+				nodeB.childIndex2	= nodeIndexE;
+				nodeA.childIndex1	= nodeIndexD;
+				nodeD.parentIndex	= nodeIndexA;
+				combineBoundingVolumeBoxes( nodeA.box, nodeC.box, nodeD.box );
+				combineBoundingVolumeBoxes( nodeB.box, nodeA.box, nodeE.box );
+
+				nodeA.height = 1 + TIKI_MAX( nodeC.height, nodeD.height );
+				nodeB.height = 1 + TIKI_MAX( nodeA.height, nodeE.height );
+			}
+
+			return nodeIndexB;
+		}
+
+		return nodeIndexA;
+	}
+
+	void BoundingVolumeHierarchy::addSubtree( List< void* >& results, uint32 nodeIndex ) const
+	{
+		uint32 aStack[ MaxStackSize ];
+		uint stackSize = 0u;
+		aStack[ stackSize++ ] = nodeIndex;
+
+		while( stackSize > 0u )
+		{
+			const Node& node = m_nodes[ aStack[ --stackSize ] ];
+			if( node.isLeaf() )
+			{
+				results.add( node.pUserData );
+				continue;
+			}
+
+			TIKI_ASSERT( stackSize + 2u <= MaxStackSize );
+			aStack[ stackSize++ ] = node.childIndex1;
+			aStack[ stackSize++ ] = node.childIndex2;
+		}
+	}
+}
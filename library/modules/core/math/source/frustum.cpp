@@ -1,13 +1,77 @@
 
 #include "tiki/math/frustum.hpp"
 
+#include "tiki/base/simd.hpp"
+#include "tiki/math/axisalignedbox.hpp"
+#include "tiki/math/box.hpp"
+#include "tiki/math/sphere.hpp"
+
 namespace tiki
 {
+	static TIKI_FORCE_INLINE IntersectionTypes classifyFrustumPlaneDistance( IntersectionTypes result, float distance, float radius )
+	{
+		if( distance + radius < 0.0f )
+		{
+			return IntersectionTypes_Disjoint;
+		}
+		else if( distance < radius )
+		{
+			return IntersectionTypes_Intersects;
+		}
+
+		return result;
+	}
+
+	// true if all frustum corners are on the same outer side of one slab. pAxes nullptr means world axes.
+	static bool isFrustumOutsideSlabs( const Vector3* pCorners, const Vector3& center, const Vector3* pAxes, const Vector3& extents )
+	{
+		const float* pExtents = &extents.x;
+		for( uint axisIndex = 0u; axisIndex < 3u; ++axisIndex )
+		{
+			uint aboveCount = 0u;
+			uint belowCount = 0u;
+			for( uint cornerIndex = 0u; cornerIndex < FrustumCorner_Count; ++cornerIndex )
+			{
+				Vector3 offset;
+				vector::sub( offset, pCorners[ cornerIndex ], center );
+
+				const float projection = ( pAxes == nullptr ? ( &offset.x )[ axisIndex ] : vector::dot( offset, pAxes[ axisIndex ] ) );
+				aboveCount += ( projection > pExtents[ axisIndex ] );
+				belowCount += ( projection < -pExtents[ axisIndex ] );
+			}
+
+			if( aboveCount == FrustumCorner_Count || belowCount == FrustumCorner_Count )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static TIKI_FORCE_INLINE void clearFrustumVisibilityMask( uint32* pVisibilityMask, uint count )
+	{
+		const uint wordCount = ( count + 31u ) / 32u;
+		for( uint i = 0u; i < wordCount; ++i )
+		{
+			pVisibilityMask[ i ] = 0u;
+		}
+	}
+
+	// the batches start at multiples of 4 or 8, so the bits never cross a word
+	static TIKI_FORCE_INLINE void setFrustumVisibilityBits( uint32* pVisibilityMask, uint index, uint32 bits )
+	{
+		pVisibilityMask[ index / 32u ] |= bits << ( index % 32u );
+	}
+
 	void Frustum::create( const Matrix44& viewProjection )
 	{
 		Matrix44 inverseViewProjection;
 		matrix::invert( inverseViewProjection, viewProjection );
 
+		// the view projection is built for row vectors (translation in w) but transform multiplies with the rows
+		matrix::transpose( inverseViewProjection );
+
 		const float x0 = -1.0f;
 		const float x1 = 1.0f;
 		const float y0 = -1.0f;
@@ -37,28 +101,295 @@ namespace tiki
 
 	void Frustum::create( const Vector3 aCorners[ FrustumCorner_Count ] )
 	{
+		Vector3 center = Vector3::zero;
+		for( uint i = 0u; i < FrustumCorner_Count; ++i )
+		{
+			m_corners[ i ] = aCorners[ i ];
+			vector::add( center, aCorners[ i ] );
+		}
+		vector::scale( center, 1.0f / float( FrustumCorner_Count ) );
+
 		m_planes[ FrustumPlane_Near ].create( aCorners[ FrustumCorner_NearRightTop ], aCorners[ FrustumCorner_NearRightBottom ], aCorners[ FrustumCorner_NearLeftTop ] );
 		m_planes[ FrustumPlane_Far ].create( aCorners[ FrustumCorner_FarLeftTop ], aCorners[ FrustumCorner_FarLeftBottom ], aCorners[ FrustumCorner_FarRightTop ] );
 		m_planes[ FrustumPlane_Left ].create( aCorners[ FrustumCorner_NearLeftTop ], aCorners[ FrustumCorner_NearLeftBottom ], aCorners[ FrustumCorner_FarLeftTop ] );
 		m_planes[ FrustumPlane_Right ].create( aCorners[ FrustumCorner_FarRightTop ], aCorners[ FrustumCorner_FarRightBottom ], aCorners[ FrustumCorner_NearRightTop ] );
-		m_planes[ FrustumPlane_Top ].create( aCorners[ FrustumCorner_NearRightBottom ], aCorners[ FrustumCorner_FarRightBottom ], aCorners[ FrustumCorner_NearLeftBottom ] );
-		m_planes[ FrustumPlane_Bottom ].create( aCorners[ FrustumCorner_FarRightTop ], aCorners[ FrustumCorner_NearRightTop ], aCorners[ FrustumCorner_FarLeftTop ] );
+		m_planes[ FrustumPlane_Bottom ].create( aCorners[ FrustumCorner_NearRightBottom ], aCorners[ FrustumCorner_FarRightBottom ], aCorners[ FrustumCorner_NearLeftBottom ] );
+		m_planes[ FrustumPlane_Top ].create( aCorners[ FrustumCorner_FarRightTop ], aCorners[ FrustumCorner_NearRightTop ], aCorners[ FrustumCorner_FarLeftTop ] );
+
+		// the winding of the corners depends on the handedness of the view projection
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			Plane& plane = m_planes[ i ];
+			if( plane.getDistanceTo( center ) < 0.0f )
+			{
+				const Vector4& data = plane.getData();
+				plane.create( -data.x, -data.y, -data.z, -data.w );
+			}
+		}
 	}
 
-	//FrustumIntersectionType Frustum::testIntersectionPoint( const Vector3& point ) const
-	//{
-	//	return FrustumIntersectionType_Disjoint;
-	//}
+	IntersectionTypes Frustum::testIntersectionPoint( const Vector3& point ) const
+	{
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			if( m_planes[ i ].getDistanceTo( point ) < 0.0f )
+			{
+				return IntersectionTypes_Disjoint;
+			}
+		}
+
+		return IntersectionTypes_Contains;
+	}
 
-	//FrustumIntersectionType Frustum::testIntersectionBoundingBox( const BoundingBox& box ) const
-	//{
-	//	return FrustumIntersectionType_Disjoint;
-	//}
+	IntersectionTypes Frustum::testIntersectionAxisAlignedBox( const AxisAlignedBox& box, bool precise /* = false */ ) const
+	{
+		const Vector3 center = box.getCenter();
+
+		Vector3 extents = box.getSize();
+		vector::scale( extents, 0.5f );
+
+		IntersectionTypes result = IntersectionTypes_Contains;
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			const Vector4& plane = m_planes[ i ].getData();
+			const float radius = f32::abs( plane.x ) * extents.x + f32::abs( plane.y ) * extents.y + f32::abs( plane.z ) * extents.z;
+
+			result = classifyFrustumPlaneDistance( result, m_planes[ i ].getDistanceTo( center ), radius );
+			if( result == IntersectionTypes_Disjoint )
+			{
+				return result;
+			}
+		}
+
+		if( precise && result == IntersectionTypes_Intersects && isFrustumOutsideSlabs( m_corners, center, nullptr, extents ) )
+		{
+			return IntersectionTypes_Disjoint;
+		}
+
+		return result;
+	}
+
+	IntersectionTypes Frustum::testIntersectionBox( const Box& box, bool precise /* = false */ ) const
+	{
+		IntersectionTypes result = IntersectionTypes_Contains;
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			Vector3 normal;
+			m_planes[ i ].getNormal( normal );
+
+			const float radius =
+				f32::abs( vector::dot( normal, box.axis[ 0u ] ) ) * box.extents.x +
+				f32::abs( vector::dot( normal, box.axis[ 1u ] ) ) * box.extents.y +
+				f32::abs( vector::dot( normal, box.axis[ 2u ] ) ) * box.extents.z;
+
+			result = classifyFrustumPlaneDistance( result, m_planes[ i ].getDistanceTo( box.center ), radius );
+			if( result == IntersectionTypes_Disjoint )
+			{
+				return result;
+			}
+		}
+
+		if( precise && result == IntersectionTypes_Intersects && isFrustumOutsideSlabs( m_corners, box.center, box.axis, box.extents ) )
+		{
+			return IntersectionTypes_Disjoint;
+		}
+
+		return result;
+	}
 
-	//FrustumIntersectionType Frustum::testIntersectionBoundingSphere( const BoundingSphere& sphere ) const
-	//{
-	//	return FrustumIntersectionType_Disjoint;
-	//}
+	IntersectionTypes Frustum::testIntersectionSphere( const Sphere& sphere, bool precise /* = false */ ) const
+	{
+		IntersectionTypes result = IntersectionTypes_Contains;
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			result = classifyFrustumPlaneDistance( result, m_planes[ i ].getDistanceTo( sphere.center ), sphere.radius );
+			if( result == IntersectionTypes_Disjoint )
+			{
+				return result;
+			}
+		}
+
+		// the box around the sphere is good enough to reject the spheres near the frustum corners
+		if( precise && result == IntersectionTypes_Intersects )
+		{
+			const Vector3 extents = { sphere.radius, sphere.radius, sphere.radius };
+			if( isFrustumOutsideSlabs( m_corners, sphere.center, nullptr, extents ) )
+			{
+				return IntersectionTypes_Disjoint;
+			}
+		}
+
+		return result;
+	}
+
+	void Frustum::cullAxisAlignedBoxes( uint32* pVisibilityMask, const AxisAlignedBox* pBoxes, uint count ) const
+	{
+		clearFrustumVisibilityMask( pVisibilityMask, count );
+
+		vf32 aPlaneX[ FrustumPlane_Count ];
+		vf32 aPlaneY[ FrustumPlane_Count ];
+		vf32 aPlaneZ[ FrustumPlane_Count ];
+		vf32 aPlaneD[ FrustumPlane_Count ];
+		vf32 aPlaneAbsX[ FrustumPlane_Count ];
+		vf32 aPlaneAbsY[ FrustumPlane_Count ];
+		vf32 aPlaneAbsZ[ FrustumPlane_Count ];
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			const Vector4& plane = m_planes[ i ].getData();
+			aPlaneX[ i ]	= simd::set_f32( plane.x );
+			aPlaneY[ i ]	= simd::set_f32( plane.y );
+			aPlaneZ[ i ]	= simd::set_f32( plane.z );
+			aPlaneD[ i ]	= simd::set_f32( plane.w );
+			aPlaneAbsX[ i ]	= simd::set_f32( f32::abs( plane.x ) );
+			aPlaneAbsY[ i ]	= simd::set_f32( f32::abs( plane.y ) );
+			aPlaneAbsZ[ i ]	= simd::set_f32( f32::abs( plane.z ) );
+		}
+
+		const vf32 zero	= simd::set_f32( 0.0f );
+		const vf32 half	= simd::set_f32( 0.5f );
+
+		const uint simdCount = count & ~uint( 3u );
+		for( uint i = 0u; i < simdCount; i += 4u )
+		{
+			// the w lane of Vector3 is padding
+			vf32 minX = simd::set_f32( &pBoxes[ i + 0u ].min.x );
+			vf32 minY = simd::set_f32( &pBoxes[ i + 1u ].min.x );
+			vf32 minZ = simd::set_f32( &pBoxes[ i + 2u ].min.x );
+			vf32 minW = simd::set_f32( &pBoxes[ i + 3u ].min.x );
+			simd::transpose_f32( minX, minY, minZ, minW );
+
+			vf32 maxX = simd::set_f32( &pBoxes[ i + 0u ].max.x );
+			vf32 maxY = simd::set_f32( &pBoxes[ i + 1u ].max.x );
+			vf32 maxZ = simd::set_f32( &pBoxes[ i + 2u ].max.x );
+			vf32 maxW = simd::set_f32( &pBoxes[ i + 3u ].max.x );
+			simd::transpose_f32( maxX, maxY, maxZ, maxW );
+
+			const vf32 centerX	= simd::mul_f32( simd::add_f32( minX, maxX ), half );
+			const vf32 centerY	= simd::mul_f32( simd::add_f32( minY, maxY ), half );
+			const vf32 centerZ	= simd::mul_f32( simd::add_f32( minZ, maxZ ), half );
+			const vf32 extentX	= simd::mul_f32( simd::sub_f32( maxX, minX ), half );
+			const vf32 extentY	= simd::mul_f32( simd::sub_f32( maxY, minY ), half );
+			const vf32 extentZ	= simd::mul_f32( simd::sub_f32( maxZ, minZ ), half );
+
+			vf32 visible = simd::cmpge_f32( zero, zero );
+			for( uint planeIndex = 0u; planeIndex < FrustumPlane_Count; ++planeIndex )
+			{
+				const vf32 distance	= simd::muladd_f32( aPlaneX[ planeIndex ], centerX, simd::muladd_f32( aPlaneY[ planeIndex ], centerY, simd::muladd_f32( aPlaneZ[ planeIndex ], centerZ, aPlaneD[ planeIndex ] ) ) );
+				const vf32 radius	= simd::muladd_f32( aPlaneAbsX[ planeIndex ], extentX, simd::muladd_f32( aPlaneAbsY[ planeIndex ], extentY, simd::mul_f32( aPlaneAbsZ[ planeIndex ], extentZ ) ) );
+
+				visible = simd::and_f32( visible, simd::cmpge_f32( simd::add_f32( distance, radius ), zero ) );
+			}
+
+			setFrustumVisibilityBits( pVisibilityMask, i, simd::mask_f32( visible ) );
+		}
+
+		for( uint i = simdCount; i < count; ++i )
+		{
+			if( testIntersectionAxisAlignedBox( pBoxes[ i ] ) != IntersectionTypes_Disjoint )
+			{
+				setFrustumVisibilityBits( pVisibilityMask, i, 1u );
+			}
+		}
+	}
+
+	void Frustum::cullSpheres( uint32* pVisibilityMask, const Sphere* pSpheres, uint count ) const
+	{
+		clearFrustumVisibilityMask( pVisibilityMask, count );
+
+		vf32 aPlaneX[ FrustumPlane_Count ];
+		vf32 aPlaneY[ FrustumPlane_Count ];
+		vf32 aPlaneZ[ FrustumPlane_Count ];
+		vf32 aPlaneD[ FrustumPlane_Count ];
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			const Vector4& plane = m_planes[ i ].getData();
+			aPlaneX[ i ]	= simd::set_f32( plane.x );
+			aPlaneY[ i ]	= simd::set_f32( plane.y );
+			aPlaneZ[ i ]	= simd::set_f32( plane.z );
+			aPlaneD[ i ]	= simd::set_f32( plane.w );
+		}
+
+		const vf32 zero = simd::set_f32( 0.0f );
+
+		const uint simdCount = count & ~uint( 3u );
+		for( uint i = 0u; i < simdCount; i += 4u )
+		{
+			vf32 centerX = simd::set_f32( &pSpheres[ i + 0u ].center.x );
+			vf32 centerY = simd::set_f32( &pSpheres[ i + 1u ].center.x );
+			vf32 centerZ = simd::set_f32( &pSpheres[ i + 2u ].center.x );
+			vf32 centerW = simd::set_f32( &pSpheres[ i + 3u ].center.x );
+			simd::transpose_f32( centerX, centerY, centerZ, centerW );
+
+			const vf32 radius = simd::set_f32( pSpheres[ i + 0u ].radius, pSpheres[ i + 1u ].radius, pSpheres[ i + 2u ].radius, pSpheres[ i + 3u ].radius );
+
+			vf32 visible = simd::cmpge_f32( zero, zero );
+			for( uint planeIndex = 0u; planeIndex < FrustumPlane_Count; ++planeIndex )
+			{
+				const vf32 distance = simd::muladd_f32( aPlaneX[ planeIndex ], centerX, simd::muladd_f32( aPlaneY[ planeIndex ], centerY, simd::muladd_f32( aPlaneZ[ planeIndex ], centerZ, aPlaneD[ planeIndex ] ) ) );
+				visible = simd::and_f32( visible, simd::cmpge_f32( simd::add_f32( distance, radius ), zero ) );
+			}
+
+			setFrustumVisibilityBits( pVisibilityMask, i, simd::mask_f32( visible ) );
+		}
+
+		for( uint i = simdCount; i < count; ++i )
+		{
+			if( testIntersectionSphere( pSpheres[ i ] ) != IntersectionTypes_Disjoint )
+			{
+				setFrustumVisibilityBits( pVisibilityMask, i, 1u );
+			}
+		}
+	}
+
+	void Frustum::cullSpheres( uint32* pVisibilityMask, const float* pCenterX, const float* pCenterY, const float* pCenterZ, const float* pRadius, uint count ) const
+	{
+		clearFrustumVisibilityMask( pVisibilityMask, count );
+
+		vf32x8 aPlaneX[ FrustumPlane_Count ];
+		vf32x8 aPlaneY[ FrustumPlane_Count ];
+		vf32x8 aPlaneZ[ FrustumPlane_Count ];
+		vf32x8 aPlaneD[ FrustumPlane_Count ];
+		for( uint i = 0u; i < FrustumPlane_Count; ++i )
+		{
+			const Vector4& plane = m_planes[ i ].getData();
+			aPlaneX[ i ]	= simd::set_f32x8( plane.x );
+			aPlaneY[ i ]	= simd::set_f32x8( plane.y );
+			aPlaneZ[ i ]	= simd::set_f32x8( plane.z );
+			aPlaneD[ i ]	= simd::set_f32x8( plane.w );
+		}
+
+		const vf32x8 zero = simd::set_f32x8( 0.0f );
+
+		const uint simdCount = count & ~uint( 7u );
+		for( uint i = 0u; i < simdCount; i += 8u )
+		{
+			const vf32x8 centerX	= simd::set_f32x8u( pCenterX + i );
+			const vf32x8 centerY	= simd::set_f32x8u( pCenterY + i );
+			const vf32x8 centerZ	= simd::set_f32x8u( pCenterZ + i );
+			const vf32x8 radius		= simd::set_f32x8u( pRadius + i );
+
+			vf32x8 visible = simd::cmpge_f32x8( zero, zero );
+			for( uint planeIndex = 0u; planeIndex < FrustumPlane_Count; ++planeIndex )
+			{
+				const vf32x8 distance = simd::muladd_f32x8( aPlaneX[ planeIndex ], centerX, simd::muladd_f32x8( aPlaneY[ planeIndex ], centerY, simd::muladd_f32x8( aPlaneZ[ planeIndex ], centerZ, aPlaneD[ planeIndex ] ) ) );
+				visible = simd::and_f32x8( visible, simd::cmpge_f32x8( simd::add_f32x8( distance, radius ), zero ) );
+			}
+
+			setFrustumVisibilityBits( pVisibilityMask, i, simd::mask_f32x8( visible ) );
+		}
+
+		for( uint i = simdCount; i < count; ++i )
+		{
+			Sphere sphere;
+			vector::set( sphere.center, pCenterX[ i ], pCenterY[ i ], pCenterZ[ i ] );
+			sphere.radius = pRadius[ i ];
+
+			if( testIntersectionSphere( sphere ) != IntersectionTypes_Disjoint )
+			{
+				setFrustumVisibilityBits( pVisibilityMask, i, 1u );
+			}
+		}
+	}
 
 	bool Frustum::getCorner( Vector3& targetVector, FrustumCorner corner ) const
 	{
@@ -107,16 +438,11 @@ namespace tiki
 		const Vector4& data2 = plane2.getData();
 		const Vector4& data3 = plane3.getData();
 
+		// transform multiplies with the rows, so the normals are the rows
 		Matrix33 mtx;
-		mtx.x.x = data1.x;
-		mtx.x.y = data2.x;
-		mtx.x.z = data3.x;
-		mtx.y.x = data1.y;
-		mtx.y.y = data2.y;
-		mtx.y.z = data3.y;
-		mtx.z.x = data1.z;
-		mtx.z.y = data2.z;
-		mtx.z.z = data3.z;
+		vector::set( mtx.x, data1.x, data1.y, data1.z );
+		vector::set( mtx.y, data2.x, data2.y, data2.z );
+		vector::set( mtx.z, data3.x, data3.y, data3.z );
 
 		Matrix33 inverseMtx;
 		if( !matrix::invert( inverseMtx, mtx ) )
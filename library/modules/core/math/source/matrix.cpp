@@ -1,6 +1,8 @@
 
 #include "tiki/math/matrix.hpp"
 
+#include "tiki/base/functions.hpp"
+#include "tiki/base/simd.hpp"
 #include "tiki/math/quaternion.hpp"
 
 namespace tiki
@@ -66,4 +68,171 @@ namespace tiki
 
 		return true;
 	}
+	void matrix::transformBatch( Vector3* pTarget, const Vector3* pSource, uint count, const Matrix43& mtx )
+	{
+		TIKI_ASSERT( pTarget != nullptr || count == 0u );
+		TIKI_ASSERT( pSource != nullptr || count == 0u );
+
+		// transform uses the rows as dot products, the columns allow to use a linear combination per point
+		vf32 columnX = simd::set_f32( &mtx.rot.x.x );
+		vf32 columnY = simd::set_f32( &mtx.rot.y.x );
+		vf32 columnZ = simd::set_f32( &mtx.rot.z.x );
+		vf32 columnW = simd::set_f32( 0.0f );
+		simd::transpose_f32( columnX, columnY, columnZ, columnW );
+
+		const vf32 position = simd::set_f32( &mtx.pos.x );
+		for (uint i = 0u; i < count; ++i)
+		{
+			const vf32 source = simd::set_f32( &pSource[ i ].x );
+
+			vf32 result = simd::muladd_f32( simd::splat_x_f32( source ), columnX, position );
+			result = simd::muladd_f32( simd::splat_y_f32( source ), columnY, result );
+			result = simd::muladd_f32( simd::splat_z_f32( source ), columnZ, result );
+
+			simd::get_f32( &pTarget[ i ].x, result );
+		}
+	}
+
+	void matrix::mulBatch( Matrix44* pTarget, const Matrix44* pLhs, const Matrix44* pRhs, uint count )
+	{
+		TIKI_ASSERT( pTarget != nullptr || count == 0u );
+		TIKI_ASSERT( pLhs != nullptr || count == 0u );
+		TIKI_ASSERT( pRhs != nullptr || count == 0u );
+
+		for (uint i = 0u; i < count; ++i)
+		{
+			// all rows are loaded before the first store, target can be lhs or rhs
+			const vf32 rightX	= simd::set_f32( &pRhs[ i ].x.x );
+			const vf32 rightY	= simd::set_f32( &pRhs[ i ].y.x );
+			const vf32 rightZ	= simd::set_f32( &pRhs[ i ].z.x );
+			const vf32 rightW	= simd::set_f32( &pRhs[ i ].w.x );
+
+			const vf32 leftX	= simd::set_f32( &pLhs[ i ].x.x );
+			const vf32 leftY	= simd::set_f32( &pLhs[ i ].y.x );
+			const vf32 leftZ	= simd::set_f32( &pLhs[ i ].z.x );
+			const vf32 leftW	= simd::set_f32( &pLhs[ i ].w.x );
+
+			simd::get_f32( &pTarget[ i ].x.x, mulMatrixRow( leftX, rightX, rightY, rightZ, rightW ) );
+			simd::get_f32( &pTarget[ i ].y.x, mulMatrixRow( leftY, rightX, rightY, rightZ, rightW ) );
+			simd::get_f32( &pTarget[ i ].z.x, mulMatrixRow( leftZ, rightX, rightY, rightZ, rightW ) );
+			simd::get_f32( &pTarget[ i ].w.x, mulMatrixRow( leftW, rightX, rightY, rightZ, rightW ) );
+		}
+	}
+
+	struct ComposeBatchSource
+	{
+		Quaternion	rotation;
+		Vector3		translation;
+		Vector3		scale;
+	};
+
+	static TIKI_FORCE_INLINE void composeBatch4( Matrix44* pTarget, const Quaternion* pRotations, const Vector3* pTranslations, const Vector3* pScales, uint stride )
+	{
+		const vf32 zero	= simd::set_f32( 0.0f );
+		const vf32 one	= simd::set_f32( 1.0f );
+
+		// the inputs are transposed, so every lane holds one transform
+		vf32 quatX = simd::set_f32( &addPointerCast< Quaternion >( pRotations, 0u * stride )->x );
+		vf32 quatY = simd::set_f32( &addPointerCast< Quaternion >( pRotations, 1u * stride )->x );
+		vf32 quatZ = simd::set_f32( &addPointerCast< Quaternion >( pRotations, 2u * stride )->x );
+		vf32 quatW = simd::set_f32( &addPointerCast< Quaternion >( pRotations, 3u * stride )->x );
+		simd::transpose_f32( quatX, quatY, quatZ, quatW );
+
+		vf32 scaleX = simd::set_f32( &addPointerCast< Vector3 >( pScales, 0u * stride )->x );
+		vf32 scaleY = simd::set_f32( &addPointerCast< Vector3 >( pScales, 1u * stride )->x );
+		vf32 scaleZ = simd::set_f32( &addPointerCast< Vector3 >( pScales, 2u * stride )->x );
+		vf32 scaleW = simd::set_f32( &addPointerCast< Vector3 >( pScales, 3u * stride )->x );
+		simd::transpose_f32( scaleX, scaleY, scaleZ, scaleW );
+
+		const vf32 x2 = simd::add_f32( quatX, quatX );
+		const vf32 y2 = simd::add_f32( quatY, quatY );
+		const vf32 z2 = simd::add_f32( quatZ, quatZ );
+
+		const vf32 xx = simd::mul_f32( quatX, x2 );
+		const vf32 yy = simd::mul_f32( quatY, y2 );
+		const vf32 zz = simd::mul_f32( quatZ, z2 );
+		const vf32 xy = simd::mul_f32( quatX, y2 );
+		const vf32 zx = simd::mul_f32( quatZ, x2 );
+		const vf32 yz = simd::mul_f32( quatY, z2 );
+		const vf32 xw = simd::mul_f32( quatW, x2 );
+		const vf32 yw = simd::mul_f32( quatW, y2 );
+		const vf32 zw = simd::mul_f32( quatW, z2 );
+
+		// same as quaternion::toMatrix with scaled rows. after the transpose every vector holds the row of one transform.
+		vf32 aRowsX[ 4u ];
+		aRowsX[ 0u ] = simd::mul_f32( simd::sub_f32( simd::sub_f32( one, yy ), zz ), scaleX );
+		aRowsX[ 1u ] = simd::mul_f32( simd::add_f32( xy, zw ), scaleX );
+		aRowsX[ 2u ] = simd::mul_f32( simd::sub_f32( zx, yw ), scaleX );
+		aRowsX[ 3u ] = zero;
+		simd::transpose_f32( aRowsX[ 0u ], aRowsX[ 1u ], aRowsX[ 2u ], aRowsX[ 3u ] );
+
+		vf32 aRowsY[ 4u ];
+		aRowsY[ 0u ] = simd::mul_f32( simd::sub_f32( xy, zw ), scaleY );
+		aRowsY[ 1u ] = simd::mul_f32( simd::sub_f32( simd::sub_f32( one, zz ), xx ), scaleY );
+		aRowsY[ 2u ] = simd::mul_f32( simd::add_f32( yz, xw ), scaleY );
+		aRowsY[ 3u ] = zero;
+		simd::transpose_f32( aRowsY[ 0u ], aRowsY[ 1u ], aRowsY[ 2u ], aRowsY[ 3u ] );
+
+		vf32 aRowsZ[ 4u ];
+		aRowsZ[ 0u ] = simd::mul_f32( simd::add_f32( zx, yw ), scaleZ );
+		aRowsZ[ 1u ] = simd::mul_f32( simd::sub_f32( yz, xw ), scaleZ );
+		aRowsZ[ 2u ] = simd::mul_f32( simd::sub_f32( simd::sub_f32( one, yy ), xx ), scaleZ );
+		aRowsZ[ 3u ] = zero;
+		simd::transpose_f32( aRowsZ[ 0u ], aRowsZ[ 1u ], aRowsZ[ 2u ], aRowsZ[ 3u ] );
+
+		for (uint j = 0u; j < 4u; ++j)
+		{
+			Matrix44& target = pTarget[ j ];
+			simd::get_f32( &target.x.x, aRowsX[ j ] );
+			simd::get_f32( &target.y.x, aRowsY[ j ] );
+			simd::get_f32( &target.z.x, aRowsZ[ j ] );
+			vector::set( target.w, *addPointerCast< Vector3 >( pTranslations, j * stride ), 1.0f );
+		}
+	}
+
+	void matrix::composeBatch( Matrix44* pTarget, const Quaternion* pRotations, const Vector3* pTranslations, const Vector3* pScales, uint count, uint stride )
+	{
+		TIKI_ASSERT( pTarget != nullptr || count == 0u );
+		TIKI_ASSERT( pRotations != nullptr || count == 0u );
+		TIKI_ASSERT( pTranslations != nullptr || count == 0u );
+		TIKI_ASSERT( pScales != nullptr || count == 0u );
+
+		uint i = 0u;
+		for ( ; i + 4u <= count; i += 4u )
+		{
+			const uint offset = i * stride;
+			composeBatch4( pTarget + i, addPointerCast< Quaternion >( pRotations, offset ), addPointerCast< Vector3 >( pTranslations, offset ), addPointerCast< Vector3 >( pScales, offset ), stride );
+		}
+
+		if ( i < count )
+		{
+			// the remaining transforms go through the same lanes, that way all results are equal to the batch
+			ComposeBatchSource aSources[ 4u ];
+			Matrix44 aTargets[ 4u ];
+			for (uint j = 0u; j < 4u; ++j)
+			{
+				ComposeBatchSource& source = aSources[ j ];
+				if ( i + j < count )
+				{
+					const uint offset = ( i + j ) * stride;
+					source.rotation		= *addPointerCast< Quaternion >( pRotations, offset );
+					source.translation	= *addPointerCast< Vector3 >( pTranslations, offset );
+					source.scale		= *addPointerCast< Vector3 >( pScales, offset );
+				}
+				else
+				{
+					source.rotation		= Quaternion::identity;
+					source.translation	= Vector3::zero;
+					source.scale		= Vector3::one;
+				}
+			}
+
+			composeBatch4( aTargets, &aSources[ 0u ].rotation, &aSources[ 0u ].translation, &aSources[ 0u ].scale, sizeof( ComposeBatchSource ) );
+
+			for (uint j = 0u; i + j < count; ++j)
+			{
+				pTarget[ i + j ] = aTargets[ j ];
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -3,12 +3,26 @@
 #define __TIKI_MATRIX_INL_INCLUDED__
 
 #include "tiki/base/float32.hpp"
+#include "tiki/base/simd.hpp"
 #include "tiki/base/types.hpp"
 
 #include "tiki/math/matrix.hpp"
 
 namespace tiki
 {
+	// row * matrix as linear combination of the matrix rows. the w lane of row is ignored for 3 rows.
+	static TIKI_FORCE_INLINE vf32 mulMatrixRow( const vf32 row, const vf32 x, const vf32 y, const vf32 z )
+	{
+		vf32 result = simd::mul_f32( simd::splat_x_f32( row ), x );
+		result = simd::muladd_f32( simd::splat_y_f32( row ), y, result );
+		return simd::muladd_f32( simd::splat_z_f32( row ), z, result );
+	}
+
+	static TIKI_FORCE_INLINE vf32 mulMatrixRow( const vf32 row, const vf32 x, const vf32 y, const vf32 z, const vf32 w )
+	{
+		return simd::muladd_f32( simd::splat_w_f32( row ), w, mulMatrixRow( row, x, y, z ) );
+	}
+
 	TIKI_FORCE_INLINE bool matrix::isEquals( const Matrix33& lhs, const Matrix33& rhs, float epsilon /*= f32::epsilon*/ )
 	{
 		return vector::isEquals( lhs.x, rhs.x, epsilon ) && vector::isEquals( lhs.y, rhs.y, epsilon ) && vector::isEquals( lhs.z, rhs.z, epsilon );
@@ -268,22 +282,17 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Matrix33& matrix::mul( Matrix33& mtx, const Matrix33& lhs, const Matrix33& rhs )
 	{
-		Matrix33 right = rhs;
-		transpose( right );
+		const vf32 rightX = simd::set_f32( &rhs.x.x );
+		const vf32 rightY = simd::set_f32( &rhs.y.x );
+		const vf32 rightZ = simd::set_f32( &rhs.z.x );
 
-		const Vector3 x = lhs.x;
-		const Vector3 y = lhs.y;
-		const Vector3 z = lhs.z;
+		const vf32 x = mulMatrixRow( simd::set_f32( &lhs.x.x ), rightX, rightY, rightZ );
+		const vf32 y = mulMatrixRow( simd::set_f32( &lhs.y.x ), rightX, rightY, rightZ );
+		const vf32 z = mulMatrixRow( simd::set_f32( &lhs.z.x ), rightX, rightY, rightZ );
 
-		mtx.x.x = vector::dot( x, right.x );
-		mtx.x.y = vector::dot( x, right.y );
-		mtx.x.z = vector::dot( x, right.z );
-		mtx.y.x = vector::dot( y, right.x );
-		mtx.y.y = vector::dot( y, right.y );
-		mtx.y.z = vector::dot( y, right.z );
-		mtx.z.x = vector::dot( z, right.x );
-		mtx.z.y = vector::dot( z, right.y );
-		mtx.z.z = vector::dot( z, right.z );
+		simd::get_f32( &mtx.x.x, x );
+		simd::get_f32( &mtx.y.x, y );
+		simd::get_f32( &mtx.z.x, z );
 
 		return mtx;
 	}
@@ -298,30 +307,20 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Matrix44& matrix::mul( Matrix44& mtx, const Matrix44& lhs, const Matrix44& rhs )
 	{
-		Matrix44 right = rhs;
-		transpose( right );
-
-		const Vector4 x = lhs.x;
-		const Vector4 y = lhs.y;
-		const Vector4 z = lhs.z;
-		const Vector4 w = lhs.w;
-
-		mtx.x.x = vector::dot( x, right.x );
-		mtx.x.y = vector::dot( x, right.y );
-		mtx.x.z = vector::dot( x, right.z );
-		mtx.x.w = vector::dot( x, right.w );
-		mtx.y.x = vector::dot( y, right.x );
-		mtx.y.y = vector::dot( y, right.y );
-		mtx.y.z = vector::dot( y, right.z );
-		mtx.y.w = vector::dot( y, right.w );
-		mtx.z.x = vector::dot( z, right.x );
-		mtx.z.y = vector::dot( z, right.y );
-		mtx.z.z = vector::dot( z, right.z );
-		mtx.z.w = vector::dot( z, right.w );
-		mtx.w.x = vector::dot( w, right.x );
-		mtx.w.y = vector::dot( w, right.y );
-		mtx.w.z = vector::dot( w, right.z );
-		mtx.w.w = vector::dot( w, right.w );
+		const vf32 rightX = simd::set_f32( &rhs.x.x );
+		const vf32 rightY = simd::set_f32( &rhs.y.x );
+		const vf32 rightZ = simd::set_f32( &rhs.z.x );
+		const vf32 rightW = simd::set_f32( &rhs.w.x );
+
+		const vf32 x = mulMatrixRow( simd::set_f32( &lhs.x.x ), rightX, rightY, rightZ, rightW );
+		const vf32 y = mulMatrixRow( simd::set_f32( &lhs.y.x ), rightX, rightY, rightZ, rightW );
+		const vf32 z = mulMatrixRow( simd::set_f32( &lhs.z.x ), rightX, rightY, rightZ, rightW );
+		const vf32 w = mulMatrixRow( simd::set_f32( &lhs.w.x ), rightX, rightY, rightZ, rightW );
+
+		simd::get_f32( &mtx.x.x, x );
+		simd::get_f32( &mtx.y.x, y );
+		simd::get_f32( &mtx.z.x, z );
+		simd::get_f32( &mtx.w.x, w );
 
 		return mtx;
 	}
@@ -444,6 +443,36 @@ namespace tiki
 		return true;
 	}
 
+	TIKI_FORCE_INLINE bool matrix::invertTranspose( Matrix44& mtx, const Matrix43& source )
+	{
+		// the transposed inverse of the rotation is the cofactor matrix divided by the determinant. the cofactor rows
+		// are the cross products of the other two rows.
+		Vector3 x;
+		Vector3 y;
+		Vector3 z;
+		vector::cross( x, source.rot.y, source.rot.z );
+		vector::cross( y, source.rot.z, source.rot.x );
+		vector::cross( z, source.rot.x, source.rot.y );
+
+		const float det = vector::dot( source.rot.x, x );
+		if( f32::isZero( det ) )
+		{
+			return false;
+		}
+
+		const float inverseDet = 1.0f / det;
+		vector::scale( x, inverseDet );
+		vector::scale( y, inverseDet );
+		vector::scale( z, inverseDet );
+
+		vector::set( mtx.x, x, -vector::dot( source.pos, x ) );
+		vector::set( mtx.y, y, -vector::dot( source.pos, y ) );
+		vector::set( mtx.z, z, -vector::dot( source.pos, z ) );
+		vector::set( mtx.w, 0.0f, 0.0f, 0.0f, 1.0f );
+
+		return true;
+	}
+
 	TIKI_FORCE_INLINE Matrix33& matrix::lerp( Matrix33& mtx, const Matrix33& start, const Matrix33& end, const float amount )
 	{
 		vector::lerp( mtx.x, start.x, end.x, amount );
@@ -502,27 +531,16 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Matrix44& matrix::transpose( Matrix44& mtx, const Matrix44& rhs )
 	{
-		const Vector4 x = rhs.x;
-		const Vector4 y = rhs.y;
-		const Vector4 z = rhs.z;
-		const Vector4 w = rhs.w;
+		vf32 x = simd::set_f32( &rhs.x.x );
+		vf32 y = simd::set_f32( &rhs.y.x );
+		vf32 z = simd::set_f32( &rhs.z.x );
+		vf32 w = simd::set_f32( &rhs.w.x );
+		simd::transpose_f32( x, y, z, w );
 
-		mtx.x.x = x.x;
-		mtx.x.y = y.x;
-		mtx.x.z = z.x;
-		mtx.x.w = w.x;
-		mtx.y.x = x.y;
-		mtx.y.y = y.y;
-		mtx.y.z = z.y;
-		mtx.y.w = w.y;
-		mtx.z.x = x.z;
-		mtx.z.y = y.z;
-		mtx.z.z = z.z;
-		mtx.z.w = w.z;
-		mtx.w.x = x.w;
-		mtx.w.y = y.w;
-		mtx.w.z = z.w;
-		mtx.w.w = w.w;
+		simd::get_f32( &mtx.x.x, x );
+		simd::get_f32( &mtx.y.x, y );
+		simd::get_f32( &mtx.z.x, z );
+		simd::get_f32( &mtx.w.x, w );
 
 		return mtx;
 	}
@@ -561,13 +579,13 @@ namespace tiki
 
 	TIKI_FORCE_INLINE void matrix::transform( Vector4& vec, const Matrix44& mtx )
 	{
-		vector::set(
-			vec,
-			vector::dot( vec, mtx.x ),
-			vector::dot( vec, mtx.y ),
-			vector::dot( vec, mtx.z ),
-			vector::dot( vec, mtx.w )
-		);
+		vf32 x = simd::set_f32( &mtx.x.x );
+		vf32 y = simd::set_f32( &mtx.y.x );
+		vf32 z = simd::set_f32( &mtx.z.x );
+		vf32 w = simd::set_f32( &mtx.w.x );
+		simd::transpose_f32( x, y, z, w );
+
+		simd::get_f32( &vec.x, mulMatrixRow( simd::set_f32( &vec.x ), x, y, z, w ) );
 	}
 }
 
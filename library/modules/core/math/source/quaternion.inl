@@ -1,7 +1,7 @@
 #ifndef TIKI_QUATERNION_INL
 #define TIKI_QUATERNION_INL
 
-
+#include "tiki/base/simd.hpp"
 
 namespace tiki
 {
@@ -61,19 +61,13 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Quaternion& quaternion::add( Quaternion& quat, const Quaternion& rhs )
 	{
-		quat.x += rhs.x;
-		quat.y += rhs.y;
-		quat.z += rhs.z;
-		quat.w += rhs.w;
+		simd::get_f32( &quat.x, simd::add_f32( simd::set_f32( &quat.x ), simd::set_f32( &rhs.x ) ) );
 		return quat;
 	}
 
 	TIKI_FORCE_INLINE Quaternion& quaternion::sub( Quaternion& quat, const Quaternion& rhs )
 	{
-		quat.x -= rhs.x;
-		quat.y -= rhs.y;
-		quat.z -= rhs.z;
-		quat.w -= rhs.w;
+		simd::get_f32( &quat.x, simd::sub_f32( simd::set_f32( &quat.x ), simd::set_f32( &rhs.x ) ) );
 		return quat;
 	}
 
@@ -123,11 +117,8 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Quaternion& quaternion::scale( Quaternion& quat, float val )
 	{
-		quat.x *= val;
-		quat.y *= val;
-		quat.z *= val;
-		quat.w *= val;
-		return quat;			 
+		simd::get_f32( &quat.x, simd::mul_f32( simd::set_f32( &quat.x ), simd::set_f32( val ) ) );
+		return quat;
 	}
 
 	TIKI_FORCE_INLINE float quaternion::length( const Quaternion& quat )
@@ -147,10 +138,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Quaternion& quaternion::negate( Quaternion& quat )	
 	{
-		quat.x = -quat.x;
-		quat.y = -quat.y;
-		quat.z = -quat.z;
-		quat.w = -quat.w;
+		simd::get_f32( &quat.x, simd::mul_f32( simd::set_f32( &quat.x ), simd::set_f32( -1.0f ) ) );
 		return quat;
 	}
 
@@ -174,15 +162,11 @@ namespace tiki
 	TIKI_FORCE_INLINE Quaternion& quaternion::nlerp( Quaternion& quat, const Quaternion& start, const Quaternion& end, const float amount )
 	{
 		const float delta = quaternion::dot( start, end );
-		Quaternion secound = end;
-		if ( delta < 0.0f )
-		{
-			quaternion::negate( secound );
-		}
-		quat.x = f32::lerp( start.x, secound.x, amount );
-		quat.y = f32::lerp( start.y, secound.y, amount );
-		quat.z = f32::lerp( start.z, secound.z, amount );
-		quat.w = f32::lerp( start.w, secound.w, amount );
+
+		// take the shorter way
+		const vf32 startVec	= simd::set_f32( &start.x );
+		const vf32 endVec	= simd::mul_f32( simd::set_f32( &end.x ), simd::set_f32( delta < 0.0f ? -1.0f : 1.0f ) );
+		simd::get_f32( &quat.x, simd::muladd_f32( simd::sub_f32( endVec, startVec ), simd::set_f32( amount ), startVec ) );
 		return normalize( quat );
 	}
 
@@ -342,17 +326,17 @@ namespace tiki
 
 	TIKI_FORCE_INLINE void quaternion::fromYawPitchRoll( Quaternion& quat, float yaw, float pitch, float roll )
 	{
-		const float halfroll	= roll * 0.5f;
-		const float sinroll		= sinf( halfroll );
-		const float cosroll		= cosf( halfroll );
+		float sinroll;
+		float cosroll;
+		f32::approximatedSinCos( sinroll, cosroll, roll * 0.5f );
 
-		const float halfpitch	= pitch * 0.5f;
-		const float sinpitch	= sinf( halfpitch );
-		const float cospitch	= cosf( halfpitch );
+		float sinpitch;
+		float cospitch;
+		f32::approximatedSinCos( sinpitch, cospitch, pitch * 0.5f );
 
-		const float halfyaw		= yaw * 0.5f;
-		const float sinyaw		= sinf( halfyaw );
-		const float cosyaw		= cosf( halfyaw );
+		float sinyaw;
+		float cosyaw;
+		f32::approximatedSinCos( sinyaw, cosyaw, yaw * 0.5f );
 
 		quat.x = cosroll * sinpitch * cosyaw + sinroll * cospitch * sinyaw;
 		quat.y = cosroll * cospitch * sinyaw - sinroll * sinpitch * cosyaw;
@@ -3,6 +3,7 @@
 #define __TIKI_VECTOR_INL_INCLUDED__
 
 #include "tiki/base/assert.hpp"
+#include "tiki/base/simd.hpp"
 #include "tiki/math/basetypes.hpp"
 
 namespace tiki
@@ -198,6 +199,7 @@ namespace tiki
 		return vec;
 	}
 
+	// Vector3 stays scalar. it is mostly written component wise and a vector load after that stalls on the store forwarding.
 	TIKI_FORCE_INLINE Vector3& vector::add( Vector3& vec, const Vector3& rhs )
 	{
 		vec.x += rhs.x;
@@ -208,10 +210,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::add( Vector4& vec, const Vector4& rhs )
 	{
-		vec.x += rhs.x;
-		vec.y += rhs.y;
-		vec.z += rhs.z;
-		vec.w += rhs.w;
+		simd::get_f32( &vec.x, simd::add_f32( simd::set_f32( &vec.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -232,10 +231,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::add( Vector4& vec, const Vector4& lhs, const Vector4& rhs )
 	{
-		vec.x = lhs.x + rhs.x;
-		vec.y = lhs.y + rhs.y;
-		vec.z = lhs.z + rhs.z;
-		vec.w = lhs.w + rhs.w;
+		simd::get_f32( &vec.x, simd::add_f32( simd::set_f32( &lhs.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -256,10 +252,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::sub( Vector4& vec, const Vector4& rhs )
 	{
-		vec.x -= rhs.x;
-		vec.y -= rhs.y;
-		vec.z -= rhs.z;
-		vec.w -= rhs.w;
+		simd::get_f32( &vec.x, simd::sub_f32( simd::set_f32( &vec.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -280,10 +273,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::sub( Vector4& vec, const Vector4& lhs, const Vector4& rhs )
 	{
-		vec.x = lhs.x - rhs.x;
-		vec.y = lhs.y - rhs.y;
-		vec.z = lhs.z - rhs.z;
-		vec.w = lhs.w - rhs.w;
+		simd::get_f32( &vec.x, simd::sub_f32( simd::set_f32( &lhs.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -304,10 +294,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::mul( Vector4& vec, const Vector4& rhs )
 	{
-		vec.x *= rhs.x;
-		vec.y *= rhs.y;
-		vec.z *= rhs.z;
-		vec.w *= rhs.w;
+		simd::get_f32( &vec.x, simd::mul_f32( simd::set_f32( &vec.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -328,10 +315,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::mul( Vector4& vec, const Vector4& lhs, const Vector4& rhs )
 	{
-		vec.x = lhs.x * rhs.x;
-		vec.y = lhs.y * rhs.y;
-		vec.z = lhs.z * rhs.z;
-		vec.w = lhs.w * rhs.w;
+		simd::get_f32( &vec.x, simd::mul_f32( simd::set_f32( &lhs.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -352,10 +336,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::div( Vector4& vec, const Vector4& rhs )
 	{
-		vec.x /= rhs.x;
-		vec.y /= rhs.y;
-		vec.z /= rhs.z;
-		vec.w /= rhs.w;
+		simd::get_f32( &vec.x, simd::div_f32( simd::set_f32( &vec.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -376,10 +357,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::div( Vector4& vec, const Vector4& lhs, const Vector4& rhs )
 	{
-		vec.x = lhs.x / rhs.x;
-		vec.y = lhs.y / rhs.y;
-		vec.z = lhs.z / rhs.z;
-		vec.w = lhs.w / rhs.w;
+		simd::get_f32( &vec.x, simd::div_f32( simd::set_f32( &lhs.x ), simd::set_f32( &rhs.x ) ) );
 		return vec;
 	}
 
@@ -400,10 +378,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::scale( Vector4& vec, float val )
 	{
-		vec.x *= val;
-		vec.y *= val;
-		vec.z *= val;
-		vec.w *= val;
+		simd::get_f32( &vec.x, simd::mul_f32( simd::set_f32( &vec.x ), simd::set_f32( val ) ) );
 		return vec;
 	}
 
@@ -645,10 +620,7 @@ namespace tiki
 
 	TIKI_FORCE_INLINE Vector4& vector::clamp( Vector4& vec, const Vector4& min, const Vector4& max )
 	{
-		vec.x = f32::clamp( vec.x, min.x, max.x );
-		vec.y = f32::clamp( vec.y, min.y, max.y );
-		vec.z = f32::clamp( vec.z, min.z, max.z );
-		vec.w = f32::clamp( vec.w, min.w, max.w );
+		simd::get_f32( &vec.x, simd::min_f32( simd::max_f32( simd::set_f32( &vec.x ), simd::set_f32( &min.x ) ), simd::set_f32( &max.x ) ) );
 		return vec;
 	}
 
@@ -720,10 +692,9 @@ namespace tiki
 	TIKI_FORCE_INLINE Vector4& vector::lerp( Vector4& vec, const Vector4& start, const Vector4& end, float amount )
 	{
 		TIKI_ASSERT( amount >= 0.0f && amount <= 1.0f );
-		vec.x = f32::lerp( start.x, end.x, amount );
-		vec.y = f32::lerp( start.y, end.y, amount );
-		vec.z = f32::lerp( start.z, end.z, amount );
-		vec.w = f32::lerp( start.w, end.w, amount );
+		const vf32 startVec = simd::set_f32( &start.x );
+		const vf32 delta = simd::sub_f32( simd::set_f32( &end.x ), startVec );
+		simd::get_f32( &vec.x, simd::muladd_f32( delta, simd::set_f32( amount ), startVec ) );
 		return vec;
 	}
 
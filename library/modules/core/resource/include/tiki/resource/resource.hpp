@@ -34,7 +34,7 @@ namespace tiki
 
 		crc32				getKey() const { return m_id.key; }
 #if TIKI_DISABLED( TIKI_BUILD_MASTER )
-		const char*			getFileName() const { return m_id.fileName.cStr(); }
+		const char*			getFileName() const { return m_id.fileName.getString(); }
 #else
 		const char*			getFileName() const { return ""; }
 #endif
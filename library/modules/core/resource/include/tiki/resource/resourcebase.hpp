@@ -2,6 +2,8 @@
 #ifndef __TIKI_RESOURCEBASE_HPP_INCLUDED__
 #define __TIKI_RESOURCEBASE_HPP_INCLUDED__
 
+#include "tiki/base/stringid.hpp"
+
 namespace tiki
 {
 	class Resource;
@@ -13,9 +15,10 @@ namespace tiki
 			key = TIKI_INVALID_CRC32;
 		}
 
-		crc32	key;
+		crc32		key;
 #if TIKI_DISABLED( TIKI_BUILD_MASTER )
-		string	fileName;
+		// interned, so every loaded resource doesn't carry an own copy of the name
+		StringId	fileName;
 #endif
 	};
 
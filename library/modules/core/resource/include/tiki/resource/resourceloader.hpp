@@ -2,9 +2,9 @@
 #ifndef __TIKI_RESOURCELOADER_HPP_INCLUDED__
 #define __TIKI_RESOURCELOADER_HPP_INCLUDED__
 
-#include "tiki/container/sortedsizedmap.hpp"
 #include "tiki/base/types.hpp"
 #include "tiki/base/zoneallocator.hpp"
+#include "tiki/container/hashmap.hpp"
 #include "tiki/resource/resourcedefinition.hpp"
 
 namespace tiki
@@ -56,11 +56,11 @@ namespace tiki
 		enum
 		{
 			MaxFactoryCount					= 32u,
-			InitializationDataBufferSize	= 1u * 1024u * 1024u
+			BufferAllocatorPageSize			= 64u * 1024u
 		};
 
 
-		typedef SortedSizedMap< fourcc, const FactoryContext* > FactoryMap;
+		typedef HashMap< fourcc, const FactoryContext* > FactoryMap;
 
 		FileSystem*				m_pFileSystem;
 		ResourceStorage*		m_pStorage;
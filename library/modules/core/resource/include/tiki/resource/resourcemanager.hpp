@@ -6,9 +6,10 @@
 #include "tiki/container/sizedarray.hpp"
 #include "tiki/base/types.hpp"
 #include "tiki/container/pool.hpp"
+#include "tiki/container/spscqueue.hpp"
 #include "tiki/resource/resourceloader.hpp"
 #include "tiki/resource/resourcestorage.hpp"
-#include "tiki/threading/mutex.hpp"
+#include "tiki/threading/semaphore.hpp"
 #include "tiki/threading/thread.hpp"
 
 #if TIKI_DISABLED( TIKI_BUILD_MASTER ) && TIKI_DISABLED( TIKI_BUILD_TOOLS )
@@ -77,10 +78,12 @@ namespace tiki
 		ResourceStorage						m_resourceStorage;
 
 		Pool< ResourceRequest >				m_resourceRequests;
-		LinkedList< ResourceRequest >		m_runningRequests;
+
+		// requests are queued by the main thread and processed by the loading thread
+		SpscQueue< ResourceRequest* >		m_runningRequests;
 
 		Thread								m_loadingThread;
-		Mutex								m_loadingMutex;
+		Semaphore							m_loadingSemaphore;		// one token per queued request
 
 #if TIKI_ENABLED( TIKI_ENABLE_ASSET_CONVERTER )
 		IAssetConverter*					m_pAssetConverter;
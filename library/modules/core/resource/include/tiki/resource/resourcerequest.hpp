@@ -2,7 +2,6 @@
 #ifndef TIKI_RESOURCEREQUEST_HPP_INCLUDED__
 #define TIKI_RESOURCEREQUEST_HPP_INCLUDED__
 
-#include "tiki/container/linkedlist.hpp"
 #include "tiki/container/sizedarray.hpp"
 #include "tiki/base/types.hpp"
 
@@ -10,11 +9,10 @@ namespace tiki
 {
 	class Resource;
 
-	class ResourceRequest : private LinkedItem< ResourceRequest >
+	class ResourceRequest
 	{
 		TIKI_NONCOPYABLE_CLASS( ResourceRequest );
 		friend class ResourceManager;
-		friend class LinkedList< ResourceRequest >;
 
 	public:
 
@@ -3,7 +3,7 @@
 #define __TIKI_RESOURCESTOREAGE_HPP_INCLUDED__
 
 #include "tiki/base/types.hpp"
-#include "tiki/container/sortedsizedmap.hpp"
+#include "tiki/container/hashmap.hpp"
 
 namespace tiki
 {
@@ -31,7 +31,7 @@ namespace tiki
 
 	private:
 
-		SortedSizedMap< crc32, Resource* >	m_resources;
+		HashMap< crc32, Resource* >	m_resources;
 
 	};
 }
@@ -58,7 +58,7 @@ namespace tiki
 		m_definition.applyHostValues();
 
 		m_factories.create( MaxFactoryCount );
-		m_bufferAllocator.create( InitializationDataBufferSize, 128u );
+		m_bufferAllocator.create( BufferAllocatorPageSize, 128u );
 	}
 
 	void ResourceLoader::dispose()
@@ -81,6 +81,8 @@ namespace tiki
 
 	ResourceLoaderResult ResourceLoader::loadResource( const Resource** ppTargetResource, crc32 crcFileName, crc32 resourceKey, fourcc resourceType, bool isMainResource )
 	{
+		MemoryTagScope memoryTag( MemoryTag_Resource );
+
 		TIKI_ASSERT( ppTargetResource != nullptr );
 		TIKI_ASSERT( resourceKey != TIKI_INVALID_CRC32 );
 
@@ -93,6 +95,9 @@ namespace tiki
 			return ResourceLoaderResult_Success;
 		}
 
+		// the buffers are only needed while the resource is loaded. linked resources release theirs before the parent continues.
+		ZoneAllocatorScope bufferScope( m_bufferAllocator );
+
 		ResourceLoaderContext context;
 		ResourceLoaderResult result = initializeLoaderContext( context, crcFileName, resourceKey, resourceType, isMainResource );
 		if ( result != ResourceLoaderResult_Success )
@@ -132,9 +137,13 @@ namespace tiki
 
 	ResourceLoaderResult ResourceLoader::reloadResource( Resource* pResource, crc32 crcFileName, crc32 resourceKey, fourcc resourceType )
 	{
+		MemoryTagScope memoryTag( MemoryTag_Resource );
+
 		TIKI_ASSERT( m_pFileSystem != nullptr );
 		TIKI_ASSERT( pResource != nullptr );
 
+		ZoneAllocatorScope bufferScope( m_bufferAllocator );
+
 		ResourceLoaderContext context;
 		ResourceLoaderResult result = initializeLoaderContext( context, crcFileName, resourceKey, resourceType, true );
 		if ( result != ResourceLoaderResult_Success )
@@ -192,7 +201,7 @@ namespace tiki
 		context.crcFileName			= crcFileName;
 		context.resourceId.key		= resourceKey;
 #if TIKI_DISABLED( TIKI_BUILD_MASTER )
-		context.resourceId.fileName	= pFileName;
+		context.resourceId.fileName	= StringId( pFileName );
 #endif
 
 		context.pFactory = findFactory( resourceType );
@@ -518,11 +527,6 @@ namespace tiki
 			context.pStream = nullptr;
 		}
 
-		if( context.mainResource )
-		{
-			m_bufferAllocator.clear();
-		}
-
 		context.pFactory = nullptr;
 	}
 
@@ -3,6 +3,7 @@
 
 #include "tiki/base/debugprop.hpp"
 #include "tiki/base/fourcc.hpp"
+#include "tiki/base/memory.hpp"
 #include "tiki/io/file.hpp"
 #include "tiki/io/path.hpp"
 #include "tiki/resource/factorybase.hpp"
@@ -27,19 +28,22 @@ namespace tiki
 
 	bool ResourceManager::create( const ResourceManagerParameters& params )
 	{
+		MemoryTagScope memoryTag( MemoryTag_Resource );
+
 		m_resourceStorage.create( params.maxResourceCount );
 		m_resourceLoader.create( params.pFileSystem, &m_resourceStorage );
 
-		if ( !m_resourceRequests.create( params.maxRequestCount ) )
+		if ( !m_resourceRequests.create( params.maxRequestCount ) ||
+			!m_runningRequests.create( params.maxRequestCount ) )
 		{
 			dispose();
 			return false;
 		}
 
-		m_loadingMutex.create();
 		if( params.enableMultiThreading )
 		{
-			if( !m_loadingThread.create( staticThreadEntry, this, 1024 * 1024, "ResourceManager" ) )
+			if( !m_loadingSemaphore.create() ||
+				!m_loadingThread.create( staticThreadEntry, this, 1024 * 1024, "ResourceManager" ) )
 			{
 				dispose();
 				return false;
@@ -87,10 +91,12 @@ namespace tiki
 		if( m_loadingThread.isCreated() )
 		{
 			m_loadingThread.requestExit();
+			m_loadingSemaphore.incement();
 			m_loadingThread.waitForExit();
 			m_loadingThread.dispose();
 		}
-		m_loadingMutex.dispose();
+		m_loadingSemaphore.dispose();
+		m_runningRequests.dispose();
 
 		m_resourceRequests.dispose();
 
@@ -134,12 +140,10 @@ namespace tiki
 
 		if( !m_loadingThread.isCreated() )
 		{
-			while( !m_runningRequests.isEmpty() )
+			ResourceRequest* pData = nullptr;
+			while( m_runningRequests.tryPop( pData ) )
 			{
-				ResourceRequest& data = *m_runningRequests.getBegin();
-				m_runningRequests.removeSortedByValue( data );
-
-				updateResourceLoading( &data );
+				updateResourceLoading( pData );
 			}
 		}
 	}
@@ -204,9 +208,12 @@ namespace tiki
 		request.m_pFileName		= pFileName;
 #endif
 
-		m_loadingMutex.lock();
-		m_runningRequests.push( request );
-		m_loadingMutex.unlock();
+		TIKI_VERIFY( m_runningRequests.tryPush( &request ) );
+
+		if( m_loadingThread.isCreated() )
+		{
+			m_loadingSemaphore.incement();
+		}
 
 		return request;
 	}
@@ -263,23 +270,13 @@ namespace tiki
 	{
 		while (!thread.isExitRequested())
 		{
-			ResourceRequest* pData = nullptr;
-
-			m_loadingMutex.lock();
-			if (!m_runningRequests.isEmpty())
-			{
-				pData = &*m_runningRequests.getBegin();
-				m_runningRequests.removeSortedByValue(*m_runningRequests.getBegin());
-			}
-			m_loadingMutex.unlock();
+			m_loadingSemaphore.decrement();
 
-			if ( pData == nullptr )
+			ResourceRequest* pData = nullptr;
+			while ( m_runningRequests.tryPop( pData ) )
 			{
-				Thread::sleepCurrentThread( 500 );
-				continue;
+				updateResourceLoading( pData );
 			}
-
-			updateResourceLoading( pData );
 		}
 	}
 
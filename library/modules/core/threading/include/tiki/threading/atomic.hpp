@@ -0,0 +1,62 @@
+#pragma once
+#ifndef TIKI_ATOMIC_HPP_INCLUDED
+#define TIKI_ATOMIC_HPP_INCLUDED
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	enum AtomicOrder
+	{
+		AtomicOrder_Relaxed,
+		AtomicOrder_Acquire,
+		AtomicOrder_Release,
+		AtomicOrder_AcquireRelease,
+		AtomicOrder_SequentialConsistent
+	};
+
+	// T must be a 32 or 64 bit integer or a pointer
+	template<typename T>
+	class Atomic
+	{
+		TIKI_NONCOPYABLE_CLASS( Atomic );
+
+	public:
+
+		TIKI_FORCE_INLINE			Atomic();
+		TIKI_FORCE_INLINE explicit	Atomic( T value );
+
+		TIKI_FORCE_INLINE T			load( AtomicOrder order = AtomicOrder_SequentialConsistent ) const;
+		TIKI_FORCE_INLINE void		store( T value, AtomicOrder order = AtomicOrder_SequentialConsistent );
+
+		TIKI_FORCE_INLINE T			exchange( T value, AtomicOrder order = AtomicOrder_SequentialConsistent );
+		TIKI_FORCE_INLINE bool		compareExchange( T& expected, T desired, AtomicOrder order = AtomicOrder_SequentialConsistent );
+
+		// only valid for integer types
+		TIKI_FORCE_INLINE T			fetchAdd( T value, AtomicOrder order = AtomicOrder_SequentialConsistent );
+		TIKI_FORCE_INLINE T			fetchSub( T value, AtomicOrder order = AtomicOrder_SequentialConsistent );
+
+	private:
+
+		volatile T					m_value;
+
+	};
+
+	typedef Atomic< uint32 >	AtomicUInt32;
+	typedef Atomic< uint64 >	AtomicUInt64;
+	typedef Atomic< sint32 >	AtomicSInt32;
+	typedef Atomic< sint64 >	AtomicSInt64;
+
+	namespace atomic
+	{
+		TIKI_FORCE_INLINE void	fence( AtomicOrder order = AtomicOrder_SequentialConsistent );
+
+		// hint for the processor that we are in a spin loop
+		TIKI_FORCE_INLINE void	pause();
+	}
+}
+
+#include "../../../source/atomic.inl"
+
+#endif // TIKI_ATOMIC_HPP_INCLUDED
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef TIKI_FIBER_HPP_INCLUDED
+#define TIKI_FIBER_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+#if TIKI_ENABLED( TIKI_PLATFORM_WIN )
+#	include "../../../source/win/platformdata_win.hpp"
+#elif TIKI_ENABLED( TIKI_PLATFORM_LINUX )
+#	include "../../../source/posix/platformdata_posix.hpp"
+#else
+#	error not supported
+#endif
+
+namespace tiki
+{
+	typedef void(*FiberEntryFunction)(void* pArgument);
+
+	// cooperative execution context with its own stack. a thread has to create a fiber from itself before it can
+	// switch to other fibers. the entry function must never return.
+	class Fiber
+	{
+		TIKI_NONCOPYABLE_CLASS( Fiber );
+
+	public:
+
+		Fiber();
+		~Fiber();
+
+		bool			create( FiberEntryFunction pEntryFunc, void* pArgument, uint stackSize );
+		bool			createFromCurrentThread();
+		void			dispose();
+
+		bool			isCreated() const;
+
+		// saves the current state in this fiber and continues the target fiber
+		void			switchTo( Fiber& targetFiber );
+
+	private:
+
+		FiberPlatformData	m_platformData;
+
+		FiberEntryFunction	m_pEntryFunction;
+		void*				m_pArgument;
+
+#if TIKI_ENABLED( TIKI_PLATFORM_WIN )
+		static VOID CALLBACK	fiberEntryPoint( void* pArgument );
+#elif TIKI_ENABLED( TIKI_PLATFORM_LINUX )
+		static void				fiberEntryPoint( uint32 argumentLow, uint32 argumentHigh );
+#endif
+
+	};
+}
+
+#endif // TIKI_FIBER_HPP_INCLUDED
@@ -0,0 +1,81 @@
+#pragma once
+#ifndef TIKI_SPINLOCK_HPP_INCLUDED
+#define TIKI_SPINLOCK_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+#include "tiki/threading/atomic.hpp"
+
+namespace tiki
+{
+	// exponential backoff for spin loops. pauses first and gives up the time slice when the wait takes longer.
+	class SpinBackoff
+	{
+	public:
+
+		TIKI_FORCE_INLINE	SpinBackoff();
+
+		TIKI_FORCE_INLINE void	reset();
+		void					wait();
+
+	private:
+
+		enum
+		{
+			MaxPauseCount	= 64u,
+			MaxSpinCount	= 16u
+		};
+
+		uint					m_pauseCount;
+		uint					m_spinCount;
+
+	};
+
+	// lock for very short critical sections. never blocks in the kernel and is not recursive.
+	class SpinLock
+	{
+		TIKI_NONCOPYABLE_CLASS( SpinLock );
+
+	public:
+
+		TIKI_FORCE_INLINE		SpinLock();
+
+		TIKI_FORCE_INLINE void	lock();
+		TIKI_FORCE_INLINE bool	tryLock();
+		TIKI_FORCE_INLINE void	unlock();
+
+		TIKI_FORCE_INLINE bool	isLocked() const;
+
+	private:
+
+		AtomicUInt32			m_state;
+
+		void					lockSlow();
+
+	};
+
+	class SpinLockStackLock
+	{
+		TIKI_NONCOPYABLE_CLASS( SpinLockStackLock );
+
+	public:
+
+		SpinLockStackLock( SpinLock& spinLock )
+			: m_spinLock( spinLock )
+		{
+			m_spinLock.lock();
+		}
+
+		~SpinLockStackLock()
+		{
+			m_spinLock.unlock();
+		}
+
+	private:
+
+		SpinLock& m_spinLock;
+	};
+}
+
+#include "../../../source/spinlock.inl"
+
+#endif // TIKI_SPINLOCK_HPP_INCLUDED
@@ -19,6 +19,17 @@ namespace tiki
 
 	typedef int(*ThreadEntryFunction)(const Thread&);
 
+	enum ThreadPriority
+	{
+		ThreadPriority_Lowest,
+		ThreadPriority_Low,
+		ThreadPriority_Normal,
+		ThreadPriority_High,
+		ThreadPriority_Highest,
+
+		ThreadPriority_Count
+	};
+
 	class Thread : public LinkedItem< Thread >
 	{
 		TIKI_NONCOPYABLE_CLASS( Thread );
@@ -47,6 +58,10 @@ namespace tiki
 
 		static void			sleepCurrentThread( timems time );
 
+		// higher priorities can fail without the required user rights. a affinity mask of 0 allows all processors.
+		static bool			setCurrentThreadPriority( ThreadPriority priority );
+		static bool			setCurrentThreadAffinityMask( uint64 affinityMask );
+
 		static void			shutdownSystem();
 
 	private:
@@ -0,0 +1,303 @@
+#pragma once
+#ifndef TIKI_ATOMIC_INL_INCLUDED
+#define TIKI_ATOMIC_INL_INCLUDED
+
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+#	include <intrin.h>
+#endif
+
+namespace tiki
+{
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+
+	template<uint TSize>
+	struct AtomicOperations;
+
+	template<>
+	struct AtomicOperations< 4u >
+	{
+		typedef long Type;
+
+		static TIKI_FORCE_INLINE Type load( const volatile void* pValue )
+		{
+			const Type value = *(const volatile Type*)pValue;
+			_ReadWriteBarrier();
+			return value;
+		}
+
+		static TIKI_FORCE_INLINE void store( volatile void* pValue, Type value )
+		{
+			_ReadWriteBarrier();
+			*(volatile Type*)pValue = value;
+		}
+
+		static TIKI_FORCE_INLINE Type exchange( volatile void* pValue, Type value )
+		{
+			return _InterlockedExchange( (volatile Type*)pValue, value );
+		}
+
+		static TIKI_FORCE_INLINE Type compareExchange( volatile void* pValue, Type desired, Type expected )
+		{
+			return _InterlockedCompareExchange( (volatile Type*)pValue, desired, expected );
+		}
+
+		static TIKI_FORCE_INLINE Type add( volatile void* pValue, Type value )
+		{
+			return _InterlockedExchangeAdd( (volatile Type*)pValue, value );
+		}
+	};
+
+	template<>
+	struct AtomicOperations< 8u >
+	{
+		typedef __int64 Type;
+
+		static TIKI_FORCE_INLINE Type load( const volatile void* pValue )
+		{
+#	if TIKI_ENABLED( TIKI_BUILD_64BIT )
+			const Type value = *(const volatile Type*)pValue;
+			_ReadWriteBarrier();
+			return value;
+#	else
+			return _InterlockedCompareExchange64( (volatile Type*)pValue, 0, 0 );
+#	endif
+		}
+
+		static TIKI_FORCE_INLINE void store( volatile void* pValue, Type value )
+		{
+#	if TIKI_ENABLED( TIKI_BUILD_64BIT )
+			_ReadWriteBarrier();
+			*(volatile Type*)pValue = value;
+#	else
+			exchange( pValue, value );
+#	endif
+		}
+
+		static TIKI_FORCE_INLINE Type exchange( volatile void* pValue, Type value )
+		{
+#	if TIKI_ENABLED( TIKI_BUILD_64BIT )
+			return _InterlockedExchange64( (volatile Type*)pValue, value );
+#	else
+			Type expected = load( pValue );
+			Type current;
+			while( ( current = _InterlockedCompareExchange64( (volatile Type*)pValue, value, expected ) ) != expected )
+			{
+				expected = current;
+			}
+			return expected;
+#	endif
+		}
+
+		static TIKI_FORCE_INLINE Type compareExchange( volatile void* pValue, Type desired, Type expected )
+		{
+			return _InterlockedCompareExchange64( (volatile Type*)pValue, desired, expected );
+		}
+
+		static TIKI_FORCE_INLINE Type add( volatile void* pValue, Type value )
+		{
+#	if TIKI_ENABLED( TIKI_BUILD_64BIT )
+			return _InterlockedExchangeAdd64( (volatile Type*)pValue, value );
+#	else
+			Type expected = load( pValue );
+			Type current;
+			while( ( current = _InterlockedCompareExchange64( (volatile Type*)pValue, expected + value, expected ) ) != expected )
+			{
+				expected = current;
+			}
+			return expected;
+#	endif
+		}
+	};
+
+#elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+
+	TIKI_FORCE_INLINE int getNativeAtomicOrder( AtomicOrder order )
+	{
+		switch( order )
+		{
+		case AtomicOrder_Relaxed:
+			return __ATOMIC_RELAXED;
+
+		case AtomicOrder_Acquire:
+			return __ATOMIC_ACQUIRE;
+
+		case AtomicOrder_Release:
+			return __ATOMIC_RELEASE;
+
+		case AtomicOrder_AcquireRelease:
+			return __ATOMIC_ACQ_REL;
+
+		default:
+			break;
+		}
+
+		return __ATOMIC_SEQ_CST;
+	}
+
+	TIKI_FORCE_INLINE int getNativeAtomicFailureOrder( AtomicOrder order )
+	{
+		switch( order )
+		{
+		case AtomicOrder_Relaxed:
+		case AtomicOrder_Release:
+			return __ATOMIC_RELAXED;
+
+		case AtomicOrder_Acquire:
+		case AtomicOrder_AcquireRelease:
+			return __ATOMIC_ACQUIRE;
+
+		default:
+			break;
+		}
+
+		return __ATOMIC_SEQ_CST;
+	}
+
+#endif
+
+	template<typename T>
+	TIKI_FORCE_INLINE Atomic< T >::Atomic()
+		: m_value( 0 )
+	{
+		TIKI_COMPILETIME_ASSERT( sizeof( T ) == 4u || sizeof( T ) == 8u );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE Atomic< T >::Atomic( T value )
+		: m_value( value )
+	{
+		TIKI_COMPILETIME_ASSERT( sizeof( T ) == 4u || sizeof( T ) == 8u );
+	}
+
+#if TIKI_ENABLED( TIKI_BUILD_MSVC )
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::load( AtomicOrder order /* = AtomicOrder_SequentialConsistent */ ) const
+	{
+		return (T)AtomicOperations< sizeof( T ) >::load( &m_value );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE void Atomic< T >::store( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		typedef AtomicOperations< sizeof( T ) > Operations;
+
+		if( order == AtomicOrder_SequentialConsistent )
+		{
+			Operations::exchange( &m_value, (typename Operations::Type)value );
+		}
+		else
+		{
+			Operations::store( &m_value, (typename Operations::Type)value );
+		}
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::exchange( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		typedef AtomicOperations< sizeof( T ) > Operations;
+		return (T)Operations::exchange( &m_value, (typename Operations::Type)value );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE bool Atomic< T >::compareExchange( T& expected, T desired, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		typedef AtomicOperations< sizeof( T ) > Operations;
+
+		const T current = (T)Operations::compareExchange( &m_value, (typename Operations::Type)desired, (typename Operations::Type)expected );
+		if( current == expected )
+		{
+			return true;
+		}
+
+		expected = current;
+		return false;
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::fetchAdd( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		typedef AtomicOperations< sizeof( T ) > Operations;
+		return (T)Operations::add( &m_value, (typename Operations::Type)value );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::fetchSub( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		typedef AtomicOperations< sizeof( T ) > Operations;
+		return (T)Operations::add( &m_value, -(typename Operations::Type)value );
+	}
+
+	TIKI_FORCE_INLINE void atomic::fence( AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		if( order == AtomicOrder_SequentialConsistent )
+		{
+			_mm_mfence();
+		}
+		else
+		{
+			_ReadWriteBarrier();
+		}
+	}
+
+	TIKI_FORCE_INLINE void atomic::pause()
+	{
+		_mm_pause();
+	}
+
+#elif TIKI_ENABLED( TIKI_BUILD_GCC ) || TIKI_ENABLED( TIKI_BUILD_CLANG )
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::load( AtomicOrder order /* = AtomicOrder_SequentialConsistent */ ) const
+	{
+		return __atomic_load_n( &m_value, getNativeAtomicOrder( order ) );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE void Atomic< T >::store( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		__atomic_store_n( &m_value, value, getNativeAtomicOrder( order ) );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::exchange( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		return __atomic_exchange_n( &m_value, value, getNativeAtomicOrder( order ) );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE bool Atomic< T >::compareExchange( T& expected, T desired, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		return __atomic_compare_exchange_n( &m_value, &expected, desired, false, getNativeAtomicOrder( order ), getNativeAtomicFailureOrder( order ) );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::fetchAdd( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		return __atomic_fetch_add( &m_value, value, getNativeAtomicOrder( order ) );
+	}
+
+	template<typename T>
+	TIKI_FORCE_INLINE T Atomic< T >::fetchSub( T value, AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		return __atomic_fetch_sub( &m_value, value, getNativeAtomicOrder( order ) );
+	}
+
+	TIKI_FORCE_INLINE void atomic::fence( AtomicOrder order /* = AtomicOrder_SequentialConsistent */ )
+	{
+		__atomic_thread_fence( getNativeAtomicOrder( order ) );
+	}
+
+	TIKI_FORCE_INLINE void atomic::pause()
+	{
+#	if defined( __i386__ ) || defined( __x86_64__ )
+		__builtin_ia32_pause();
+#	elif defined( __arm__ ) || defined( __aarch64__ )
+		__asm__ __volatile__( "yield" );
+#	endif
+	}
+
+#endif
+}
+
+#endif // TIKI_ATOMIC_INL_INCLUDED
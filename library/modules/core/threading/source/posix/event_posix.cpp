@@ -2,8 +2,62 @@
 
 #include "tiki/base/assert.hpp"
 
+#include "futex_posix.hpp"
+
 namespace tiki
 {
+	enum
+	{
+		EventState_Reset	= 0u,
+		EventState_Signaled	= 1u
+	};
+
+	static bool tryConsumeSignal( EventPlatformData& data )
+	{
+		if ( data.manualReset )
+		{
+			return __atomic_load_n( &data.state, __ATOMIC_ACQUIRE ) == EventState_Signaled;
+		}
+
+		// auto reset events release only one waiting thread per signal
+		uint32 expected = EventState_Signaled;
+		return __atomic_compare_exchange_n( &data.state, &expected, (uint32)EventState_Reset, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED );
+	}
+
+	static bool waitForSignalSlow( EventPlatformData& data, timems timeOut )
+	{
+		const uint32 maxSpinCount = futex::getMaxSpinCount( &data.spinCount );
+		for (uint32 spinCount = 0u; spinCount < maxSpinCount; ++spinCount)
+		{
+			atomic::pause();
+			if ( tryConsumeSignal( data ) )
+			{
+				futex::updateSpinCount( &data.spinCount, spinCount );
+				return true;
+			}
+		}
+		futex::updateSpinCount( &data.spinCount, maxSpinCount );
+
+		__atomic_fetch_add( &data.waitingThreadCount, 1u, __ATOMIC_SEQ_CST );
+
+		bool result = true;
+		const timems endTime = futex::getEndTime( timeOut );
+		while ( !tryConsumeSignal( data ) )
+		{
+			const timems remainingTime = futex::getRemainingTime( endTime );
+			if ( remainingTime <= 0 )
+			{
+				result = false;
+				break;
+			}
+
+			futex::wait( &data.state, EventState_Reset, remainingTime );
+		}
+
+		__atomic_fetch_sub( &data.waitingThreadCount, 1u, __ATOMIC_RELAXED );
+		return result;
+	}
+
 	Event::Event()
 	{
 		m_platformData.isInitialized = false;
@@ -16,17 +70,14 @@ namespace tiki
 
 	bool Event::create( bool initialState /*= false*/, bool manualReset /*= false */, const char* pName /*= nullptr*/ )
 	{
-		m_platformData.isInitialized			= true;
-		m_platformData.isSignaled			= initialState;
+		TIKI_ASSERT( m_platformData.isInitialized == false );
+
+		m_platformData.manualReset			= manualReset;
+		m_platformData.state				= ( initialState ? EventState_Signaled : EventState_Reset );
 		m_platformData.waitingThreadCount	= 0u;
-		
-		if ( pthread_mutex_init( &m_platformData.signalMutex, nullptr ) < 0 ||
-			 pthread_cond_init( &m_platformData.condition, nullptr ) < 0 )
-		{
-			dispose();
-			return false;
-		}
-		
+		m_platformData.spinCount			= 0u;
+		m_platformData.isInitialized		= true;
+
 		return true;
 	}
 
@@ -36,36 +87,46 @@ namespace tiki
 		{
 			return;
 		}
-		
+
 		TIKI_ASSERT( m_platformData.waitingThreadCount == 0u );
-		
-		pthread_cond_destroy( &m_platformData.condition );
-		pthread_mutex_destroy( &m_platformData.signalMutex );
-		
 		m_platformData.isInitialized = false;
 	}
 
 	void Event::signal()
 	{
 		TIKI_ASSERT( m_platformData.isInitialized );
-		
-		TIKI_VERIFY( pthread_mutex_lock( &m_platformData.signalMutex ) >= 0 );
-		if ( !m_platformData.isSignaled )
+
+		// a signal on a signaled event has no effect and waiting threads are already on their way
+		if ( __atomic_exchange_n( &m_platformData.state, (uint32)EventState_Signaled, __ATOMIC_SEQ_CST ) == EventState_Signaled )
 		{
-			m_platformData.isSignaled = true;
-			if ( m_platformData.waitingThreadCount > 0u )
-			{
-				TIKI_VERIFY( pthread_cond_signal( &m_platformData.condition ) );			
-			}
+			return;
+		}
+
+		if ( __atomic_load_n( &m_platformData.waitingThreadCount, __ATOMIC_SEQ_CST ) > 0u )
+		{
+			futex::wake( &m_platformData.state, m_platformData.manualReset ? (uint32)futex::WakeAll : 1u );
 		}
-		TIKI_VERIFY( pthread_mutex_unlock( &m_platformData.signalMutex ) >= 0 );
 	}
 
 	void Event::reset()
 	{
+		TIKI_ASSERT( m_platformData.isInitialized );
+		__atomic_store_n( &m_platformData.state, (uint32)EventState_Reset, __ATOMIC_RELEASE );
 	}
 
 	bool Event::waitForSignal( timems timeOut /*= TIKI_TIME_OUT_INFINITY*/ )
 	{
+		TIKI_ASSERT( m_platformData.isInitialized );
+
+		if ( tryConsumeSignal( m_platformData ) )
+		{
+			return true;
+		}
+		else if ( timeOut <= 0 )
+		{
+			return false;
+		}
+
+		return waitForSignalSlow( m_platformData, timeOut );
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,101 @@
+
+#include "tiki/threading/fiber.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/memory.hpp"
+
+#include <ucontext.h>
+
+namespace tiki
+{
+	Fiber::Fiber()
+	{
+		m_platformData.isInitialized	= false;
+		m_platformData.pStack			= nullptr;
+
+		m_pEntryFunction	= nullptr;
+		m_pArgument			= nullptr;
+	}
+
+	Fiber::~Fiber()
+	{
+		TIKI_ASSERT( !m_platformData.isInitialized );
+	}
+
+	bool Fiber::create( FiberEntryFunction pEntryFunc, void* pArgument, uint stackSize )
+	{
+		TIKI_ASSERT( pEntryFunc != nullptr );
+		TIKI_ASSERT( !m_platformData.isInitialized );
+
+		m_pEntryFunction	= pEntryFunc;
+		m_pArgument			= pArgument;
+
+		if ( getcontext( &m_platformData.context ) != 0 )
+		{
+			return false;
+		}
+
+		m_platformData.pStack = TIKI_MEMORY_ALLOC_ALIGNED( stackSize, 16u );
+		if ( m_platformData.pStack == nullptr )
+		{
+			return false;
+		}
+
+		m_platformData.context.uc_stack.ss_sp	= m_platformData.pStack;
+		m_platformData.context.uc_stack.ss_size	= stackSize;
+		m_platformData.context.uc_link			= nullptr;
+
+		// makecontext only passes int arguments
+		const uint64 argument = uint64( uint( this ) );
+		makecontext( &m_platformData.context, (void(*)())&fiberEntryPoint, 2, uint32( argument ), uint32( argument >> 32u ) );
+
+		m_platformData.isInitialized = true;
+		return true;
+	}
+
+	bool Fiber::createFromCurrentThread()
+	{
+		TIKI_ASSERT( !m_platformData.isInitialized );
+
+		// the context is filled by the first switch
+		m_platformData.isInitialized = true;
+		return true;
+	}
+
+	void Fiber::dispose()
+	{
+		if ( m_platformData.pStack != nullptr )
+		{
+			TIKI_MEMORY_FREE( m_platformData.pStack );
+			m_platformData.pStack = nullptr;
+		}
+
+		m_platformData.isInitialized = false;
+
+		m_pEntryFunction	= nullptr;
+		m_pArgument			= nullptr;
+	}
+
+	bool Fiber::isCreated() const
+	{
+		return m_platformData.isInitialized;
+	}
+
+	void Fiber::switchTo( Fiber& targetFiber )
+	{
+		TIKI_ASSERT( m_platformData.isInitialized );
+		TIKI_ASSERT( targetFiber.m_platformData.isInitialized );
+
+		swapcontext( &m_platformData.context, &targetFiber.m_platformData.context );
+	}
+
+	/*static*/ void Fiber::fiberEntryPoint( uint32 argumentLow, uint32 argumentHigh )
+	{
+		const uint64 argument = uint64( argumentLow ) | ( uint64( argumentHigh ) << 32u );
+
+		Fiber& fiber = *(Fiber*)uint( argument );
+		fiber.m_pEntryFunction( fiber.m_pArgument );
+
+		TIKI_BREAK( "[threading] fiber entry function must not return.\n" );
+	}
+}
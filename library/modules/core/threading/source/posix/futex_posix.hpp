@@ -0,0 +1,89 @@
+#pragma once
+#ifndef TIKI_FUTEX_POSIX_HPP_INCLUDED
+#define TIKI_FUTEX_POSIX_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+#include "tiki/threading/atomic.hpp"
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace tiki
+{
+	namespace futex
+	{
+		enum
+		{
+			MaxSpinCount	= 200u,
+			WakeAll			= INT_MAX
+		};
+
+		// blocks while *pAddress == expectedValue. returns false only when the time out elapsed.
+		static inline bool wait( uint32* pAddress, uint32 expectedValue, timems timeOut )
+		{
+			timespec time;
+			timespec* pTime = nullptr;
+			if ( timeOut != TIKI_TIME_OUT_INFINITY )
+			{
+				time.tv_sec		= timeOut / 1000;
+				time.tv_nsec	= ( timeOut % 1000 ) * 1000000;
+				pTime			= &time;
+			}
+
+			const long result = syscall( SYS_futex, pAddress, FUTEX_WAIT_PRIVATE, expectedValue, pTime, nullptr, 0 );
+			return result == 0 || errno != ETIMEDOUT;
+		}
+
+		static inline void wake( uint32* pAddress, uint32 count )
+		{
+			syscall( SYS_futex, pAddress, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0 );
+		}
+
+		static inline timems getTime()
+		{
+			timespec time;
+			clock_gettime( CLOCK_MONOTONIC, &time );
+			return ( timems( time.tv_sec ) * 1000 ) + ( time.tv_nsec / 1000000 );
+		}
+
+		static inline timems getEndTime( timems timeOut )
+		{
+			return ( timeOut == TIKI_TIME_OUT_INFINITY ? TIKI_TIME_OUT_INFINITY : getTime() + timeOut );
+		}
+
+		// returns a negative value when the end time has passed
+		static inline timems getRemainingTime( timems endTime )
+		{
+			return ( endTime == TIKI_TIME_OUT_INFINITY ? TIKI_TIME_OUT_INFINITY : endTime - getTime() );
+		}
+
+		// spinning is useless when the owner can't run at the same time
+		static inline uint32 getSpinLimit()
+		{
+			static const uint32 s_spinLimit = ( sysconf( _SC_NPROCESSORS_ONLN ) > 1 ? (uint32)MaxSpinCount : 0u );
+			return s_spinLimit;
+		}
+
+		// adaptive spinning: try a bit longer than the successful spins of the past and park early when spinning never
+		// paid off. pSpinCount is the running average of the spin count and is only a hint.
+		static inline uint32 getMaxSpinCount( const uint32* pSpinCount )
+		{
+			const uint32 spinCount = __atomic_load_n( pSpinCount, __ATOMIC_RELAXED );
+			const uint32 spinLimit = getSpinLimit();
+			return ( spinCount * 2u + 10u < spinLimit ? spinCount * 2u + 10u : spinLimit );
+		}
+
+		static inline void updateSpinCount( uint32* pSpinCount, uint32 spinCount )
+		{
+			const sint32 oldSpinCount = (sint32)__atomic_load_n( pSpinCount, __ATOMIC_RELAXED );
+			const sint32 newSpinCount = oldSpinCount + ( ( (sint32)spinCount - oldSpinCount ) / 8 );
+			__atomic_store_n( pSpinCount, (uint32)newSpinCount, __ATOMIC_RELAXED );
+		}
+	}
+}
+
+#endif // TIKI_FUTEX_POSIX_HPP_INCLUDED
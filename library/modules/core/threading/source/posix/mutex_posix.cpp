@@ -3,10 +3,53 @@
 
 #include "tiki/base/assert.hpp"
 
-#include <pthread.h>
+#include "futex_posix.hpp"
 
 namespace tiki
 {
+	enum
+	{
+		MutexState_Unlocked	= 0u,
+		MutexState_Locked	= 1u,
+		MutexState_Waiting	= 2u
+	};
+
+	static TIKI_FORCE_INLINE bool tryLockMutex( MutexPlatformData& data )
+	{
+		uint32 expected = MutexState_Unlocked;
+		return __atomic_compare_exchange_n( &data.state, &expected, (uint32)MutexState_Locked, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED );
+	}
+
+	static bool lockMutexSlow( MutexPlatformData& data, timems timeOut )
+	{
+		const uint32 maxSpinCount = futex::getMaxSpinCount( &data.spinCount );
+		for (uint32 spinCount = 0u; spinCount < maxSpinCount; ++spinCount)
+		{
+			atomic::pause();
+			if ( __atomic_load_n( &data.state, __ATOMIC_RELAXED ) == MutexState_Unlocked && tryLockMutex( data ) )
+			{
+				futex::updateSpinCount( &data.spinCount, spinCount );
+				return true;
+			}
+		}
+		futex::updateSpinCount( &data.spinCount, maxSpinCount );
+
+		// mark the mutex as contended, so unlock knows that it has to wake somebody
+		const timems endTime = futex::getEndTime( timeOut );
+		while ( __atomic_exchange_n( &data.state, (uint32)MutexState_Waiting, __ATOMIC_ACQUIRE ) != MutexState_Unlocked )
+		{
+			const timems remainingTime = futex::getRemainingTime( endTime );
+			if ( remainingTime <= 0 )
+			{
+				return false;
+			}
+
+			futex::wait( &data.state, MutexState_Waiting, remainingTime );
+		}
+
+		return true;
+	}
+
 	Mutex::Mutex()
 	{
 		m_platformData.isInitialized = false;
@@ -21,15 +64,10 @@ namespace tiki
 	{
 		TIKI_ASSERT( !m_platformData.isInitialized );
 
-		const int result = pthread_mutex_init( &m_platformData.mutexData, nullptr );
-		if ( result < 0 )
-		{
-			TIKI_TRACE_ERROR( "[threading] Unable to initialize Mutex.\n" );
-			return false;
-		}
+		m_platformData.state			= MutexState_Unlocked;
+		m_platformData.spinCount		= 0u;
+		m_platformData.isInitialized	= true;
 
-		m_platformData.isInitialized = true;
-		
 		return true;
 	}
 
@@ -37,31 +75,44 @@ namespace tiki
 	{
 		if ( m_platformData.isInitialized )
 		{
+			TIKI_ASSERT( m_platformData.state == MutexState_Unlocked );
 			m_platformData.isInitialized = false;
-			TIKI_VERIFY( pthread_mutex_destroy( &m_platformData.mutexData ) >= 0 );
 		}
 	}
 
 	void Mutex::lock()
 	{
 		TIKI_ASSERT( m_platformData.isInitialized );
-		TIKI_VERIFY( pthread_mutex_lock( &m_platformData.mutexData ) >= 0 );
+		if ( !tryLockMutex( m_platformData ) )
+		{
+			lockMutexSlow( m_platformData, TIKI_TIME_OUT_INFINITY );
+		}
 	}
 
 	bool Mutex::tryLock( timems timeOut /*= TIKI_TIME_OUT_INFINITY*/ )
 	{
 		TIKI_ASSERT( m_platformData.isInitialized );
 
-		timespec time;
-		time.tv_sec	= timeOut / 1000;
-		time.tv_nsec	= (timeOut - (time.tv_sec * 1000)) * 1000000;
-		
-		return pthread_mutex_timedlock( &m_platformData.mutexData, &time ) == 0;
+		if ( tryLockMutex( m_platformData ) )
+		{
+			return true;
+		}
+		else if ( timeOut <= 0 )
+		{
+			return false;
+		}
+
+		return lockMutexSlow( m_platformData, timeOut );
 	}
 
 	void Mutex::unlock()
 	{
 		TIKI_ASSERT( m_platformData.isInitialized );
-		TIKI_VERIFY( pthread_mutex_unlock( &m_platformData.mutexData ) >= 0 );
+
+		// uncontended unlock doesn't need a syscall
+		if ( __atomic_exchange_n( &m_platformData.state, (uint32)MutexState_Unlocked, __ATOMIC_RELEASE ) == MutexState_Waiting )
+		{
+			futex::wake( &m_platformData.state, 1u );
+		}
 	}
-}
\ No newline at end of file
+}
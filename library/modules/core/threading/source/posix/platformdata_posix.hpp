@@ -3,7 +3,7 @@
 #define __TIKI_THREADING_POSIX_HPP_INCLUDED__
 
 #include <pthread.h>
-#include <semaphore.h>
+#include <ucontext.h>
 
 namespace tiki
 {
@@ -11,31 +11,46 @@ namespace tiki
 	{
 		pthread_t		threadHandle;
 		uint64			threadId;
+		bool			isJoined;
 		
 		char			name[ 16u ];
 	};
 
+	// mutex, semaphore and event are futex words. spinCount is the adaptive spin estimate.
 	struct MutexPlatformData
 	{
-		bool				isInitialized;
-		pthread_mutex_t	mutexData;
+		bool		isInitialized;
+
+		uint32		state;			// 0 = unlocked, 1 = locked, 2 = locked with waiting threads
+		uint32		spinCount;
 	};
 
 	struct SemaphorePlatformData
 	{
 		bool		isInitialized;
-		sem_t		semaphoreData;
+
+		uint32		count;
+		uint32		maxCount;
+		uint32		waitingThreadCount;
+		uint32		spinCount;
 	};
 
 	struct EventPlatformData
 	{
-		bool				isInitialized;
+		bool		isInitialized;
+		bool		manualReset;
 
-		pthread_mutex_t	signalMutex;
-		pthread_cond_t		condition;
-		
-		volatile bool		isSignaled;
-		volatile uint32	waitingThreadCount;
+		uint32		state;			// 0 = reset, 1 = signaled
+		uint32		waitingThreadCount;
+		uint32		spinCount;
+	};
+
+	struct FiberPlatformData
+	{
+		bool			isInitialized;
+		ucontext_t		context;
+
+		void*			pStack;
 	};
 }
 
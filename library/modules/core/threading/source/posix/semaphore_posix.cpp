@@ -3,10 +3,59 @@
 
 #include "tiki/base/assert.hpp"
 
-#include <semaphore.h>
+#include "futex_posix.hpp"
 
 namespace tiki
 {
+	static bool tryDecrementSemaphore( SemaphorePlatformData& data )
+	{
+		uint32 count = __atomic_load_n( &data.count, __ATOMIC_RELAXED );
+		while ( count > 0u )
+		{
+			if ( __atomic_compare_exchange_n( &data.count, &count, count - 1u, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static bool decrementSemaphoreSlow( SemaphorePlatformData& data, timems timeOut )
+	{
+		const uint32 maxSpinCount = futex::getMaxSpinCount( &data.spinCount );
+		for (uint32 spinCount = 0u; spinCount < maxSpinCount; ++spinCount)
+		{
+			atomic::pause();
+			if ( tryDecrementSemaphore( data ) )
+			{
+				futex::updateSpinCount( &data.spinCount, spinCount );
+				return true;
+			}
+		}
+		futex::updateSpinCount( &data.spinCount, maxSpinCount );
+
+		// incement only calls into the kernel while somebody waits
+		__atomic_fetch_add( &data.waitingThreadCount, 1u, __ATOMIC_SEQ_CST );
+
+		bool result = true;
+		const timems endTime = futex::getEndTime( timeOut );
+		while ( !tryDecrementSemaphore( data ) )
+		{
+			const timems remainingTime = futex::getRemainingTime( endTime );
+			if ( remainingTime <= 0 )
+			{
+				result = false;
+				break;
+			}
+
+			futex::wait( &data.count, 0u, remainingTime );
+		}
+
+		__atomic_fetch_sub( &data.waitingThreadCount, 1u, __ATOMIC_RELAXED );
+		return result;
+	}
+
 	Semaphore::Semaphore()
 	{
 		m_platformData.isInitialized = false;
@@ -19,45 +68,63 @@ namespace tiki
 
 	bool Semaphore::create( uint initialCount /*= 0*/, uint maxCount /*= 0x7fffffff*/, const char* pName /*= nullptr*/ )
 	{
-		TIKI_ASSERT( m_platformData.isInitialized == false );		
-		return sem_init( &m_platformData.semaphoreData, 0, initialCount );
+		TIKI_ASSERT( m_platformData.isInitialized == false );
+		TIKI_ASSERT( initialCount <= maxCount );
+
+		m_platformData.count				= uint32( initialCount );
+		m_platformData.maxCount				= uint32( maxCount );
+		m_platformData.waitingThreadCount	= 0u;
+		m_platformData.spinCount			= 0u;
+		m_platformData.isInitialized		= true;
+
+		return true;
 	}
 
 	void Semaphore::dispose()
 	{
 		if ( m_platformData.isInitialized )
 		{
-			sem_destroy( &m_platformData.semaphoreData );
-			m_platformData.isInitialized = false;;
+			TIKI_ASSERT( m_platformData.waitingThreadCount == 0u );
+			m_platformData.isInitialized = false;
 		}
 	}
 
 	void Semaphore::incement()
 	{
 		TIKI_ASSERT( m_platformData.isInitialized );
-		TIKI_VERIFY( sem_post( &m_platformData.semaphoreData ) >= 0 );
+
+		TIKI_ASSERT( __atomic_load_n( &m_platformData.count, __ATOMIC_RELAXED ) < m_platformData.maxCount );
+
+		__atomic_fetch_add( &m_platformData.count, 1u, __ATOMIC_SEQ_CST );
+
+		if ( __atomic_load_n( &m_platformData.waitingThreadCount, __ATOMIC_SEQ_CST ) > 0u )
+		{
+			futex::wake( &m_platformData.count, 1u );
+		}
 	}
 
 	void Semaphore::decrement()
 	{
 		TIKI_ASSERT( m_platformData.isInitialized );
-		TIKI_VERIFY( sem_wait( &m_platformData.semaphoreData ) >= 0 );
+		if ( !tryDecrementSemaphore( m_platformData ) )
+		{
+			decrementSemaphoreSlow( m_platformData, TIKI_TIME_OUT_INFINITY );
+		}
 	}
 
 	bool Semaphore::tryDecrement( timems timeOut /*= TIKI_TIME_OUT_INFINITY*/ )
 	{
 		TIKI_ASSERT( m_platformData.isInitialized );
-		if ( timeOut == TIKI_TIME_OUT_INFINITY )
+
+		if ( tryDecrementSemaphore( m_platformData ) )
 		{
-			return sem_trywait( &m_platformData.semaphoreData ) >= 0;
+			return true;
 		}
-		else
+		else if ( timeOut <= 0 )
 		{
-			timespec time;
-			time.tv_sec	= timeOut / 1000;
-			time.tv_nsec	= (timeOut - (time.tv_sec * 1000)) * 1000000;
-			
-			return sem_timedwait( &m_platformData.semaphoreData, &time ) >= 0;
+			return false;
 		}
+
+		return decrementSemaphoreSlow( m_platformData, timeOut );
 	}
-}
\ No newline at end of file
+}
@@ -2,13 +2,17 @@
 #include "tiki/threading/thread.hpp"
 
 #include "tiki/base/assert.hpp"
+#include "tiki/base/engineallocator.hpp"
 #include "tiki/base/memory.hpp"
 #include "tiki/base/string.hpp"
 #include "tiki/base/functions.hpp"
 
 #include <pthread.h>
 #include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
 #include <sys/syscall.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace tiki
@@ -19,6 +23,7 @@ namespace tiki
 	{
 		m_platformData.threadHandle	= 0u;
 		m_platformData.threadId		= 0u;
+		m_platformData.isJoined		= false;
 		m_platformData.name[ 0u ]	= '\0';
 
 		m_pEntryFunction				= nullptr;
@@ -43,6 +48,7 @@ namespace tiki
 		m_pEntryFunction	= pEntryFunc;
 		m_pArgument		= pArgument;
 		m_isExitRequested	= false;
+		m_platformData.isJoined = false;
 		copyString( m_platformData.name, TIKI_COUNT( m_platformData.name ), pName );
 		
 		pthread_attr_t threadAttributes;
@@ -87,7 +93,7 @@ namespace tiki
 
 	void Thread::dispose()
 	{
-		if ( m_platformData.threadHandle != 0u )
+		if ( m_platformData.threadHandle != 0u && !m_platformData.isJoined )
 		{
 			void* pExitCode = 0u;
 			TIKI_VERIFY0( pthread_join( m_platformData.threadHandle, &pExitCode ) );
@@ -95,6 +101,7 @@ namespace tiki
 		
 		m_platformData.threadHandle	= 0u;
 		m_platformData.threadId		= 0u;
+		m_platformData.isJoined		= false;
 
 		m_pEntryFunction				= nullptr;
 		m_pArgument					= nullptr;
@@ -111,17 +118,27 @@ namespace tiki
 		TIKI_ASSERT( m_platformData.threadHandle != 0u );
 		TIKI_ASSERT( m_platformData.threadId != getCurrentThreadId() );
 
-		timespec time;
-		time.tv_sec	= timeOut / 1000000u;
-		time.tv_nsec	= ( timeOut - ( time.tv_sec * 1000000u ) ) * 1000u;
+		if ( m_platformData.isJoined )
+		{
+			return true;
+		}
 
 		void* pExitCode = 0u;
-		if ( pthread_timedjoin_np( m_platformData.threadHandle, &pExitCode, &time ) != 0 )
+		if ( timeOut == TIKI_TIME_OUT_INFINITY )
 		{
-			return false;
+			m_platformData.isJoined = ( pthread_join( m_platformData.threadHandle, &pExitCode ) == 0 );
+			return m_platformData.isJoined;
 		}
-		
-		return true;
+
+		// pthread_timedjoin_np expects an absolute time
+		timespec time;
+		clock_gettime( CLOCK_REALTIME, &time );
+		const sint64 endTime = ( sint64( time.tv_sec ) * 1000000000 ) + time.tv_nsec + ( timeOut * 1000000 );
+		time.tv_sec		= endTime / 1000000000;
+		time.tv_nsec	= endTime % 1000000000;
+
+		m_platformData.isJoined = ( pthread_timedjoin_np( m_platformData.threadHandle, &pExitCode, &time ) == 0 );
+		return m_platformData.isJoined;
 	}
 
 	uint64 Thread::getThreadId() const
@@ -194,6 +211,41 @@ namespace tiki
 		}
 	}
 
+	/*static*/ bool Thread::setCurrentThreadPriority( ThreadPriority priority )
+	{
+		// nice values. negative values need CAP_SYS_NICE.
+		static const int s_aNiceValues[] =
+		{
+			15,
+			5,
+			0,
+			-5,
+			-10
+		};
+		TIKI_COMPILETIME_ASSERT( TIKI_COUNT( s_aNiceValues ) == ThreadPriority_Count );
+		TIKI_ASSERT( priority < ThreadPriority_Count );
+
+		// on linux the nice value belongs to the thread and not to the process
+		return setpriority( PRIO_PROCESS, (id_t)getCurrentThreadId(), s_aNiceValues[ priority ] ) == 0;
+	}
+
+	/*static*/ bool Thread::setCurrentThreadAffinityMask( uint64 affinityMask )
+	{
+		cpu_set_t cpuSet;
+		CPU_ZERO( &cpuSet );
+
+		const uint processorCount = TIKI_MIN( (uint)sysconf( _SC_NPROCESSORS_CONF ), (uint)CPU_SETSIZE );
+		for (uint i = 0u; i < processorCount; ++i)
+		{
+			if ( affinityMask == 0u || ( i < 64u && isBitSet64( affinityMask, uint64( 1u ) << i ) ) )
+			{
+				CPU_SET( i, &cpuSet );
+			}
+		}
+
+		return pthread_setaffinity_np( pthread_self(), sizeof( cpuSet ), &cpuSet ) == 0;
+	}
+
 	void Thread::shutdownSystem()
 	{
 		while ( !s_threadList.isEmpty() )
@@ -215,6 +267,7 @@ namespace tiki
 		
 		ThreadEntryFunction pEntryFunc = pThread->m_pEntryFunction;
 		const uint result = pEntryFunc( *pThread );
+		engineallocator::flushThreadCache();
 		
 		pthread_exit( (void*)result );
 		
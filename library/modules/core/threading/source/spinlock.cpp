@@ -0,0 +1,43 @@
+
+#include "tiki/threading/spinlock.hpp"
+
+#include "tiki/threading/thread.hpp"
+
+namespace tiki
+{
+	void SpinBackoff::wait()
+	{
+		if ( m_spinCount < MaxSpinCount )
+		{
+			for (uint i = 0u; i < m_pauseCount; ++i)
+			{
+				atomic::pause();
+			}
+
+			m_pauseCount = TIKI_MIN( m_pauseCount * 2u, (uint)MaxPauseCount );
+			m_spinCount++;
+		}
+		else
+		{
+			Thread::sleepCurrentThread( 0 );
+		}
+	}
+
+	void SpinLock::lockSlow()
+	{
+		SpinBackoff backoff;
+		while ( true )
+		{
+			// only read while the lock is taken. a failed exchange would steal the cache line from the owner.
+			while ( isLocked() )
+			{
+				backoff.wait();
+			}
+
+			if ( tryLock() )
+			{
+				return;
+			}
+		}
+	}
+}
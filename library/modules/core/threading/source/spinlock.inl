@@ -0,0 +1,49 @@
+#pragma once
+#ifndef TIKI_SPINLOCK_INL_INCLUDED
+#define TIKI_SPINLOCK_INL_INCLUDED
+
+namespace tiki
+{
+	TIKI_FORCE_INLINE SpinBackoff::SpinBackoff()
+	{
+		reset();
+	}
+
+	TIKI_FORCE_INLINE void SpinBackoff::reset()
+	{
+		m_pauseCount	= 1u;
+		m_spinCount		= 0u;
+	}
+
+	TIKI_FORCE_INLINE SpinLock::SpinLock()
+		: m_state( 0u )
+	{
+	}
+
+	TIKI_FORCE_INLINE void SpinLock::lock()
+	{
+		if ( !tryLock() )
+		{
+			lockSlow();
+		}
+	}
+
+	TIKI_FORCE_INLINE bool SpinLock::tryLock()
+	{
+		uint32 expected = 0u;
+		return m_state.compareExchange( expected, 1u, AtomicOrder_Acquire );
+	}
+
+	TIKI_FORCE_INLINE void SpinLock::unlock()
+	{
+		TIKI_ASSERT( isLocked() );
+		m_state.store( 0u, AtomicOrder_Release );
+	}
+
+	TIKI_FORCE_INLINE bool SpinLock::isLocked() const
+	{
+		return m_state.load( AtomicOrder_Relaxed ) != 0u;
+	}
+}
+
+#endif // TIKI_SPINLOCK_INL_INCLUDED
@@ -0,0 +1,96 @@
+
+#include "tiki/threading/fiber.hpp"
+
+#include "tiki/base/assert.hpp"
+
+#include <windows.h>
+
+namespace tiki
+{
+	Fiber::Fiber()
+	{
+		m_platformData.pFiber			= nullptr;
+		m_platformData.isThreadFiber	= false;
+
+		m_pEntryFunction	= nullptr;
+		m_pArgument			= nullptr;
+	}
+
+	Fiber::~Fiber()
+	{
+		TIKI_ASSERT( m_platformData.pFiber == nullptr );
+	}
+
+	bool Fiber::create( FiberEntryFunction pEntryFunc, void* pArgument, uint stackSize )
+	{
+		TIKI_ASSERT( pEntryFunc != nullptr );
+		TIKI_ASSERT( m_platformData.pFiber == nullptr );
+
+		m_pEntryFunction	= pEntryFunc;
+		m_pArgument			= pArgument;
+
+		m_platformData.pFiber = CreateFiber( SIZE_T( stackSize ), fiberEntryPoint, this );
+		if ( m_platformData.pFiber == nullptr )
+		{
+			return false;
+		}
+
+		m_platformData.isThreadFiber = false;
+		return true;
+	}
+
+	bool Fiber::createFromCurrentThread()
+	{
+		TIKI_ASSERT( m_platformData.pFiber == nullptr );
+
+		m_platformData.pFiber = ConvertThreadToFiber( nullptr );
+		if ( m_platformData.pFiber == nullptr )
+		{
+			return false;
+		}
+
+		m_platformData.isThreadFiber = true;
+		return true;
+	}
+
+	void Fiber::dispose()
+	{
+		if ( m_platformData.pFiber != nullptr )
+		{
+			if ( m_platformData.isThreadFiber )
+			{
+				ConvertFiberToThread();
+			}
+			else
+			{
+				DeleteFiber( m_platformData.pFiber );
+			}
+
+			m_platformData.pFiber = nullptr;
+		}
+
+		m_pEntryFunction	= nullptr;
+		m_pArgument			= nullptr;
+	}
+
+	bool Fiber::isCreated() const
+	{
+		return m_platformData.pFiber != nullptr;
+	}
+
+	void Fiber::switchTo( Fiber& targetFiber )
+	{
+		TIKI_ASSERT( m_platformData.pFiber == GetCurrentFiber() );
+		TIKI_ASSERT( targetFiber.m_platformData.pFiber != nullptr );
+
+		SwitchToFiber( targetFiber.m_platformData.pFiber );
+	}
+
+	/*static*/ VOID CALLBACK Fiber::fiberEntryPoint( void* pArgument )
+	{
+		Fiber& fiber = *static_cast< Fiber* >( pArgument );
+		fiber.m_pEntryFunction( fiber.m_pArgument );
+
+		TIKI_BREAK( "[threading] fiber entry function must not return.\n" );
+	}
+}
@@ -34,6 +34,12 @@ namespace tiki
 	{
 		HANDLE	eventHandle;
 	};
+
+	struct FiberPlatformData
+	{
+		void*	pFiber;
+		bool	isThreadFiber;
+	};
 }
 
 #endif // __TIKI_THREADING_WIN_HPP_INCLUDED__
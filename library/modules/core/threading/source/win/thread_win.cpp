@@ -2,6 +2,7 @@
 #include "tiki/threading/thread.hpp"
 
 #include "tiki/base/assert.hpp"
+#include "tiki/base/engineallocator.hpp"
 #include "tiki/base/memory.hpp"
 #include "tiki/base/string.hpp"
 
@@ -169,6 +170,35 @@ namespace tiki
 		Sleep( DWORD( time / 1000 ) );
 	}
 
+	/*static*/ bool Thread::setCurrentThreadPriority( ThreadPriority priority )
+	{
+		static const int s_aPriorities[] =
+		{
+			THREAD_PRIORITY_LOWEST,
+			THREAD_PRIORITY_BELOW_NORMAL,
+			THREAD_PRIORITY_NORMAL,
+			THREAD_PRIORITY_ABOVE_NORMAL,
+			THREAD_PRIORITY_HIGHEST
+		};
+		TIKI_COMPILETIME_ASSERT( TIKI_COUNT( s_aPriorities ) == ThreadPriority_Count );
+		TIKI_ASSERT( priority < ThreadPriority_Count );
+
+		return SetThreadPriority( GetCurrentThread(), s_aPriorities[ priority ] ) != FALSE;
+	}
+
+	/*static*/ bool Thread::setCurrentThreadAffinityMask( uint64 affinityMask )
+	{
+		DWORD_PTR processMask = 0u;
+		DWORD_PTR systemMask = 0u;
+		if ( affinityMask == 0u && !GetProcessAffinityMask( GetCurrentProcess(), &processMask, &systemMask ) )
+		{
+			return false;
+		}
+
+		const DWORD_PTR threadMask = ( affinityMask != 0u ? DWORD_PTR( affinityMask ) : processMask );
+		return SetThreadAffinityMask( GetCurrentThread(), threadMask ) != 0u;
+	}
+
 	void Thread::shutdownSystem()
 	{
 		while ( !s_threadList.isEmpty() )
@@ -188,6 +218,9 @@ namespace tiki
 		const Thread* pThread = static_cast<const Thread*>(pArgument);
 
 		ThreadEntryFunction pEntryFunc = pThread->m_pEntryFunction;
-		return pEntryFunc( *pThread );
+		const DWORD result = pEntryFunc( *pThread );
+		engineallocator::flushThreadCache();
+
+		return result;
 	}
 }
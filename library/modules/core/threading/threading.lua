@@ -2,6 +2,7 @@
 
 local module = Module:new( "threading" );
 
+module:add_files( "source/*.*" );
 module:add_files( "include/**/*.hpp" );
 module:add_files( "threading.lua" );
 module:add_include_dir( "include" );
@@ -9,3 +9,4 @@ module:add_include_dir( "include" );
 
 module:add_dependency( "base" );
 module:add_dependency( "math" );
+module:add_dependency( "tasksystem" );
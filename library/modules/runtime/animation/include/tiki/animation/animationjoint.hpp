@@ -7,6 +7,7 @@
 
 namespace tiki
 {
+	class TaskSystem;
 	struct Matrix44;
 	struct ModelHierarchy;
 
@@ -16,7 +17,7 @@ namespace tiki
 		Vector3			position;
 		Vector3			scale;
 
-		static void		buildPoseMatrices( Matrix44* pTargetMatrix, uint targetCapacity, const AnimationJoint* pJoints, const ModelHierarchy& hierarchy );
+		static void		buildPoseMatrices( Matrix44* pTargetMatrix, uint targetCapacity, const AnimationJoint* pJoints, const ModelHierarchy& hierarchy, TaskSystem* pTaskSystem = nullptr );
 		static void		fillJointArrayFromHierarchy( AnimationJoint* pTargetJoints, size_t jointCount, const ModelHierarchy& hierarchy );
 
 		static void		blendAnimationJoints( AnimationJoint* pTargetJoints, const AnimationJoint* pLeftJoints, const AnimationJoint* pRightJoints, size_t jointCount, float weight );
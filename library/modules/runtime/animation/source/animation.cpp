@@ -3,6 +3,7 @@
 
 #include "tiki/animation/animationjoint.hpp"
 #include "tiki/base/simd.hpp"
+#include "tiki/base/simdkernels.hpp"
 #include "tiki/graphics/modelhierarchy.hpp"
 #include "tiki/resource/resourcemanager.hpp"
 
@@ -70,320 +71,259 @@ namespace tiki
 		return (uint)countPopulation64( andMask ) + 1u;
 	}
 
-	static TIKI_FORCE_INLINE void decompressRotation( Quaternion& target, const sint16* pData, const vf32 factor )
+	enum
 	{
-		const vf32 values = simd::convert_i32_to_f32( simd::convert_i16l_to_i32( simd::set_i16u( pData ) ) );
-		const vf32 result = simd::mul_f32( values, factor );
-
-		simd::get_f32( &target.x, result );
-	}
+		AnimationSampleBatchSize	= 64u,	// joints per kernel call
+		AnimationMaxComponentCount	= 4u
+	};
 
-	static TIKI_FORCE_INLINE void decompressPosition( Vector3& target, const sint16* pData, const vf32 factor )
+	// the rotation, position or scale keys of a chunk. a key stores the value and the tangent.
+	struct AnimationSampleChannel
 	{
-		const vf32 values = simd::convert_i32_to_f32( simd::convert_i16l_to_i32( simd::set_i16u( pData ) ) );
-		const vf32 result = simd::mul_f32( values, factor );
-
-		simd::get_f32( &target.x, result );
-	}
+		uint	componentCount;
+		uint	targetOffset;		// offset of the quaternion or vector in AnimationJoint
+		float	factor;
+		float	tangentFactor;
+		bool	isRotation;
+	};
 
-	static TIKI_FORCE_INLINE void decompressScale( Vector3& target, const sint16* pData, const vf32 factor )
+	// the keys of a batch are decompressed while they are gathered and interpolated by one kernel call. every joint
+	// takes four floats, positions and scales interpolate an unused fourth component.
+	struct AnimationSampleBatch
 	{
-		const vf32 values = simd::convert_i32_to_f32( simd::convert_i16l_to_i32( simd::set_i16u( pData ) ) );
-		const vf32 result = simd::mul_f32( values, factor );
+		TIKI_ALIGN_PREFIX( 16 ) float	aP0[ AnimationSampleBatchSize * 4u ] TIKI_ALIGN_POSTFIX( 16 );
+		TIKI_ALIGN_PREFIX( 16 ) float	aT0[ AnimationSampleBatchSize * 4u ] TIKI_ALIGN_POSTFIX( 16 );
+		TIKI_ALIGN_PREFIX( 16 ) float	aP1[ AnimationSampleBatchSize * 4u ] TIKI_ALIGN_POSTFIX( 16 );
+		TIKI_ALIGN_PREFIX( 16 ) float	aT1[ AnimationSampleBatchSize * 4u ] TIKI_ALIGN_POSTFIX( 16 );
+		TIKI_ALIGN_PREFIX( 16 ) float	aTime[ AnimationSampleBatchSize * 4u ] TIKI_ALIGN_POSTFIX( 16 );
+		TIKI_ALIGN_PREFIX( 16 ) float	aResult[ AnimationSampleBatchSize * 4u ] TIKI_ALIGN_POSTFIX( 16 );
+
+		uint							aJointIndices[ AnimationSampleBatchSize ];
+		uint							jointCount;
+	};
 
-		simd::get_f32( &target.x, result );
+	static TIKI_FORCE_INLINE void writeJointChannel( AnimationJoint* pTargetJoints, uint jointIndex, const AnimationSampleChannel& channel, const vf32 value )
+	{
+		// Vector3 is padded to four floats, all channels are written with one store
+		float* pTarget = addPointerCast< float >( &pTargetJoints[ jointIndex ], channel.targetOffset );
+		simd::get_f32( pTarget, value );
 	}
 
-	enum KeySize
+	static TIKI_FORCE_INLINE void decompressKey( vf32& value, vf32& tangent, const sint16* pKey, uint componentCount, const vf32 factor, const vf32 tangentFactor )
 	{
-		KeySize_Rotation		= 8u,
-		KeySize_ConstRotation	= 4u,
+		const vi16 key				= simd::set_i16u( pKey );
+		const vi32 tangentSource	= ( componentCount == 4u ? simd::convert_i16h_to_i32( key ) : simd::convert_i16l_to_i32( simd::set_i16u( pKey + componentCount ) ) );
 
-		KeySize_Position		= 6u,
-		KeySize_ConstPosition	= 3u,
-
-		KeySize_Scale			= 6u,
-		KeySize_ConstScale		= 3u
-	};
+		value	= simd::mul_f32( simd::convert_i32_to_f32( simd::convert_i16l_to_i32( key ) ), factor );
+		tangent	= simd::mul_f32( simd::convert_i32_to_f32( tangentSource ), tangentFactor );
+	}
 
-	void Animation::sample( AnimationJoint* pTargetJoints, uint jointCount, const ModelHierarchy& hierarchy, float time ) const
+	static void sampleInterpolatedBatch( AnimationJoint* pTargetJoints, const AnimationSampleChannel& channel, AnimationSampleBatch& batch, const SimdKernels& kernels )
 	{
-		TIKI_ASSERT( pTargetJoints != nullptr );
-
-		const float fullFrame	= time * 60.0f;
-		const uint fullExFrame	= (uint)( fullFrame );
-		const float frameDiff	= fullFrame - (float)fullExFrame;
-		const uint exactFrame	= fullExFrame % m_pData->frameCount;
-		const float frame		= (float)exactFrame + frameDiff;
+		kernels.pHermite( batch.aResult, batch.aP0, batch.aT0, batch.aP1, batch.aT1, batch.aTime, batch.jointCount * 4u );
 
-		uint headerIndex = 0;
-		const AnimationChunkHeader* pHeader = addPointerCast< AnimationChunkHeader >( m_pData, m_pData->headerOffset );
-		while ( pHeader[ headerIndex ].endTime <= exactFrame )
+		for (uint i = 0u; i < batch.jointCount; ++i)
 		{
-			TIKI_ASSERT( headerIndex < m_pData->headerCount );
-			headerIndex++;
-		}
-		pHeader += headerIndex;
+			vf32 result = simd::set_f32( batch.aResult, i * 4u );
+			if ( channel.isRotation )
+			{
+				// the interpolated rotations are normalized again
+				result = simd::mul_f32( result, simd::set_f32( f32::rsqrt( simd::get_f32_x( simd::dot4_f32( result, result ) ) ) ) );
+			}
 
-		const uint localTime		= TIKI_MIN( (exactFrame - pHeader->startTime) + 1u, TIKI_MIN( 63u, m_pData->frameCount - 1u ) );
+			writeJointChannel( pTargetJoints, batch.aJointIndices[ i ], channel, result );
+		}
 
-		const vf32 simdFrame	= simd::set_f32( frame );
-		const vf32 all1			= simd::set_f32( 1.0f );
-		const vf32 all2			= simd::set_f32( 2.0f );
-		const vf32 all3			= simd::set_f32( 3.0f );
-		const vf32 allneg2		= simd::set_f32( -2.0f );
+		batch.jointCount = 0u;
+	}
 
-		const vf32 rotationFactor			= simd::set_f32( 3.0518513e-005f );
-		const vf32 rotationTangentFactor	= simd::set_f32( 7.6293945e-006f );
-		const vf32 positionFactor			= simd::set_f32( m_pData->positionFactor );
-		const vf32 positionTangentFactor	= simd::set_f32( m_pData->positionTangentFactor );
-		const vf32 scaleFactor				= simd::set_f32( m_pData->scaleFactor );
-		const vf32 scaleTangentFactor		= simd::set_f32( m_pData->scaleTangentFactor );
+	static const sint16* sampleInterpolatedKeys( AnimationJoint* pTargetJoints, uint jointCount, const AnimationSampleChannel& channel, const SimdKernels& kernels, const uint64* pMask, const sint16* pData, uint keyCount, uint startTime, uint localTime, float frame )
+	{
+		const uint componentCount	= channel.componentCount;
+		const uint keySize			= componentCount * 2u;
+		const vf32 factor			= simd::set_f32( channel.factor );
 
-		//////////////////////////////////////////////////////////////////////////
-		// rotation
-		const uint8* pBaseData	= m_pData->data.getData() + pHeader->dataOffset;
-		const sint16* pData		= (sint16*)(pBaseData + (sizeof(uint64) * pHeader->interpolatedRotationJointCount));
-		const uint64* pMask		= (uint64*)pBaseData;
+		AnimationSampleBatch batch;
+		batch.jointCount = 0u;
 
+		for (uint i = 0u; i < keyCount; ++i)
 		{
-			uint io = 0;
-			for (; io < pHeader->interpolatedRotationJointCount; ++io)
+			const uint jointIndex = (uint)pData[ 0u ];
+			TIKI_ASSERT( jointIndex < jointCount );
+			pData++;
+
+			uint keyIndexLeft = 0;
+			uint keyIndexRight = 0;
+			const uint keyLeftCount = getCountLeftBit( &keyIndexLeft, *pMask, localTime );
+			const uint keyRightCount = getCountRightBit( &keyIndexRight, *pMask, localTime );
+			TIKI_ASSERT( keyLeftCount < 64u || keyRightCount < 64u );
+			TIKI_ASSERT( keyIndexLeft < 64u || keyIndexRight < 64u );
+
+			const float time1		= (float)(sint32)(startTime + keyIndexLeft);
+			const float time2		= (float)(sint32)(startTime + keyIndexRight);
+			const float timeScale	= time2 - time1;
+
+			pData += keyLeftCount * keySize;
+
+			// the tangents are scaled by the distance of the keys
+			const vf32 tangentFactor = simd::set_f32( channel.tangentFactor * timeScale );
+
+			vf32 p0;
+			vf32 t0;
+			vf32 p1;
+			vf32 t1;
+			decompressKey( p0, t0, pData, componentCount, factor, tangentFactor );
+			decompressKey( p1, t1, pData + keySize, componentCount, factor, tangentFactor );
+
+			// interpolate rotations along the shorter arc
+			if ( channel.isRotation && simd::get_f32_x( simd::dot4_f32( p0, p1 ) ) < 0.0f )
 			{
-				const uint jointIndex = (uint)pData[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pData++;
-
-				uint keyIndexLeft = 0;
-				uint keyIndexRight = 0;
-				const uint keyLeftCount = getCountLeftBit( &keyIndexLeft, *pMask, localTime );
-				const uint keyRightCount = getCountRightBit( &keyIndexRight, *pMask, localTime );
-				TIKI_ASSERT( keyLeftCount < 64u || keyRightCount < 64u );
-				TIKI_ASSERT( keyIndexLeft < 64u || keyIndexRight < 64u );
-
-				const sint32 time1 = (sint32)(pHeader->startTime + keyIndexLeft);
-				const sint32 time2 = (sint32)(pHeader->startTime + keyIndexRight);
-
-				pData += keyLeftCount * KeySize_Rotation;
-
-				const vf32 simdTime1	= simd::convert_i32_to_f32( simd::set_i32( time1 ) );
-				const vf32 simdTime2	= simd::convert_i32_to_f32( simd::set_i32( time2 ) );
-				const vf32 simdTimeT	= simd::div_f32( simd::sub_f32( simdFrame, simdTime1 ), simd::sub_f32( simdTime2, simdTime1 ) );
-				const vf32 simdTimeTT	= simd::mul_f32( simdTimeT, simdTimeT );
-				const vf32 simdTimeTTT	= simd::mul_f32( simdTimeTT, simdTimeT );
-				const vf32 simdScale	= simd::sub_f32( simdTime2, simdTime1 );
-
-				const vi16 sourcePT0 = simd::set_i16u( pData );
-				const vi16 sourcePT1 = simd::set_i16u( pData + KeySize_Rotation );
-
-				const vi32 sourceP0 = simd::convert_i16l_to_i32( sourcePT0 );
-				const vi32 sourceT0 = simd::convert_i16h_to_i32( sourcePT0 );
-				const vi32 sourceP1 = simd::convert_i16l_to_i32( sourcePT1 );
-				const vi32 sourceT1 = simd::convert_i16h_to_i32( sourcePT1 );
-
-				const vf32 simdP0 = simd::mul_f32( simd::convert_i32_to_f32( sourceP0 ), rotationFactor );
-				vf32 simdP1 = simd::mul_f32( simd::convert_i32_to_f32( sourceP1 ), rotationFactor );
-
-				const vf32 simdDot = simd::dot4_f32( simdP0, simdP1 );
-				if ( simd::get_f32_x( simdDot ) < 0.0f )
-				{
-					simdP1 = simd::sub_f32( simd::set_f32( 0.0f ), simdP1 );
-				}
-
-				const vf32 simdT0 = simd::mul_f32( simd::mul_f32( simd::convert_i32_to_f32( sourceT0 ), rotationTangentFactor ), simdScale );
-				const vf32 simdT1 = simd::mul_f32( simd::mul_f32( simd::convert_i32_to_f32( sourceT1 ), rotationTangentFactor ), simdScale );
-
-				const vf32 simdResult1 = simd::muladd_f32( simd::add_f32( simd::mulsub_f32( all2, simdTimeTTT, simd::mul_f32( all3, simdTimeTT ) ), all1 ), simdP0, simd::muladd_f32( simd::add_f32( simd::negmulsub_f32( all2, simdTimeTT, simdTimeTTT ), simdTimeT ), simdT0, simd::muladd_f32( simd::muladd_f32( allneg2, simdTimeTTT, simd::mul_f32( all3, simdTimeTT ) ), simdP1, simd::mul_f32( simd::sub_f32( simdTimeTTT, simdTimeTT ), simdT1 ) ) ) );
-				const vf32 simdResult2 = simd::mul_f32( simdResult1, simd::rsqrt_f32( simd::dot4_f32( simdResult1, simdResult1 ) ) );
-
-				simd::get_f32( &pTargetJoints[ jointIndex ].rotation.x, simdResult2 );
-
-				pData += keyRightCount * KeySize_Rotation;
-				pMask++;
+				p1 = simd::sub_f32( simd::set_f32( 0.0f ), p1 );
 			}
 
-			// const rotation
-			for (; io < pHeader->usedRotationJointCount; ++io)
-			{
-				const uint jointIndex = (uint)pData[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pData++;
-
-				decompressRotation( pTargetJoints[ jointIndex ].rotation, pData, rotationFactor );
-				pData += KeySize_ConstRotation;
-			}
+			const uint batchOffset = batch.jointCount * 4u;
+			simd::get_f32( batch.aP0, batchOffset, p0 );
+			simd::get_f32( batch.aT0, batchOffset, t0 );
+			simd::get_f32( batch.aP1, batchOffset, p1 );
+			simd::get_f32( batch.aT1, batchOffset, t1 );
+			simd::get_f32( batch.aTime, batchOffset, simd::set_f32( ( frame - time1 ) / timeScale ) );
+			batch.aJointIndices[ batch.jointCount++ ] = jointIndex;
 
-			// unused rotation
-			const uint16* pUnused = (uint16*)pData;				
-			const vf32* pDefaultPoseRotation = hierarchy.getDefaultPoseRotation();
-			for (uint i = 0; i < pHeader->defaultPoseRotationJointCount; ++i)
+			if ( batch.jointCount == AnimationSampleBatchSize )
 			{
-				const uint jointIndex = pUnused[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pUnused++;
-
-				simd::get_f32( &pTargetJoints[ jointIndex ].rotation.x, pDefaultPoseRotation[ jointIndex ] );
+				sampleInterpolatedBatch( pTargetJoints, channel, batch, kernels );
 			}
 
-			pData = (sint16*)pUnused;
+			pData += keyRightCount * keySize;
+			pMask++;
 		}
 
-
-		//////////////////////////////////////////////////////////////////////////
-		// position
-		pBaseData = (uint8*)alignPointer( pData, 8u );
-		pData = (sint16*)(pBaseData + (sizeof(uint64) * pHeader->interpolatedPositionJointCount));
-		pMask = (uint64*)pBaseData;
-
+		if ( batch.jointCount > 0u )
 		{
-			uint ip = 0;
-			for (; ip < pHeader->interpolatedPositionJointCount; ++ip)
-			{
-				const uint jointIndex = (uint)pData[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pData++;
-
-				uint keyIndexLeft = 0;
-				uint keyIndexRight = 0;
-				const uint keyLeftCount = getCountLeftBit( &keyIndexLeft, *pMask, localTime );
-				const uint keyRightCount = getCountRightBit( &keyIndexRight, *pMask, localTime );
-				TIKI_ASSERT( keyLeftCount < 64u || keyRightCount < 64u );
-				TIKI_ASSERT( keyIndexLeft < 64u || keyIndexRight < 64u );
-
-				const sint32 time1 = (sint32)(pHeader->startTime + keyIndexLeft);
-				const sint32 time2 = (sint32)(pHeader->startTime + keyIndexRight);
-
-				pData += keyLeftCount * KeySize_Position;
-
-				const vf32 simdTime1	= simd::convert_i32_to_f32( simd::set_i32( time1 ) );
-				const vf32 simdTime2	= simd::convert_i32_to_f32( simd::set_i32( time2 ) );
-				const vf32 simdTimeT	= simd::div_f32( simd::sub_f32( simdFrame, simdTime1 ), simd::sub_f32( simdTime2, simdTime1 ) );
-				const vf32 simdTimeTT	= simd::mul_f32( simdTimeT, simdTimeT );
-				const vf32 simdTimeTTT	= simd::mul_f32( simdTimeTT, simdTimeT );
-				const vf32 simdScale	= simd::sub_f32( simdTime2, simdTime1 );
-
-				const vi32 sourceP0 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 0u ] ) );
-				const vi32 sourceT0 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 3u ] ) );
-				const vi32 sourceP1 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 6u ] ) );
-				const vi32 sourceT1 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 9u ] ) );
-
-				const vf32 simdP0 = simd::mul_f32( simd::convert_i32_to_f32( sourceP0 ), positionFactor );
-				const vf32 simdP1 = simd::mul_f32( simd::convert_i32_to_f32( sourceP1 ), positionFactor );
-
-				const vf32 simdT0 = simd::mul_f32( simd::mul_f32( simd::convert_i32_to_f32( sourceT0 ), positionTangentFactor ), simdScale );
-				const vf32 simdT1 = simd::mul_f32( simd::mul_f32( simd::convert_i32_to_f32( sourceT1 ), positionTangentFactor ), simdScale );
-
-				const vf32 simdResult = simd::muladd_f32( simd::add_f32( simd::mulsub_f32( all2, simdTimeTTT, simd::mul_f32( all3, simdTimeTT ) ), all1 ), simdP0, simd::muladd_f32( simd::add_f32( simd::negmulsub_f32( all2, simdTimeTT, simdTimeTTT ), simdTimeT ), simdT0, simd::muladd_f32( simd::muladd_f32( allneg2, simdTimeTTT, simd::mul_f32( all3, simdTimeTT ) ), simdP1, simd::mul_f32( simd::sub_f32( simdTimeTTT, simdTimeTT ), simdT1 ) ) ) );
+			sampleInterpolatedBatch( pTargetJoints, channel, batch, kernels );
+		}
 
-				simd::get_f32( &pTargetJoints[ jointIndex ].position.x, simdResult );
+		return pData;
+	}
 
-				pData += keyRightCount * KeySize_Position;
-				pMask++;
-			}
+	static const sint16* sampleConstKeys( AnimationJoint* pTargetJoints, uint jointCount, const AnimationSampleChannel& channel, const SimdKernels& kernels, const sint16* pData, uint keyCount )
+	{
+		// a const key is the joint index followed by the value. the indices are converted with the values, that way
+		// the keys don't need to be gathered.
+		const uint keySize = channel.componentCount + 1u;
 
-			// const position
-			for (; ip < pHeader->usedPositionJointCount; ++ip)
-			{
-				const uint jointIndex = (uint)pData[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pData++;
+		// one more float for the fourth component of the last key
+		float aValues[ ( AnimationSampleBatchSize * ( AnimationMaxComponentCount + 1u ) ) + 1u ];
 
-				decompressPosition( pTargetJoints[ jointIndex ].position, pData, positionFactor );
-				pData += KeySize_ConstPosition;
-			}
+		uint keyIndex = 0u;
+		while ( keyIndex < keyCount )
+		{
+			const uint batchCount = TIKI_MIN( keyCount - keyIndex, uint( AnimationSampleBatchSize ) );
+			kernels.pConvertInt16ToFloat( aValues, pData, channel.factor, batchCount * keySize );
+			aValues[ batchCount * keySize ] = 0.0f;
 
-			// unused position
-			const uint16* pUnused = (uint16*)pData;				
-			const vf32* pDefaultPosePosition = hierarchy.getDefaultPosePosition();
-			for (uint i = 0; i < pHeader->defaultPosePositionJointCount; ++i)
+			for (uint i = 0u; i < batchCount; ++i)
 			{
-				const uint jointIndex = pUnused[ 0u ];
+				const uint jointIndex = (uint)pData[ i * keySize ];
 				TIKI_ASSERT( jointIndex < jointCount );
-				pUnused++;
 
-				simd::get_f32( &pTargetJoints[ jointIndex ].position.x, pDefaultPosePosition[ jointIndex ] );
+				writeJointChannel( pTargetJoints, jointIndex, channel, simd::set_f32u( &aValues[ ( i * keySize ) + 1u ] ) );
 			}
 
-			pData = (sint16*)pUnused;
+			pData		+= batchCount * keySize;
+			keyIndex	+= batchCount;
 		}
 
-		//////////////////////////////////////////////////////////////////////////
-		// scale
-		//////////////////////////////////////////////////////////////////////////
-		pBaseData = (uint8*)alignPointer( pData, 8u );
-		pData = (sint16*)(pBaseData + (sizeof(uint64) * pHeader->interpolatedScaleJointCount));
-		pMask = (uint64*)pBaseData;
+		return pData;
+	}
 
+	static const sint16* sampleDefaultPoseKeys( AnimationJoint* pTargetJoints, uint jointCount, const AnimationSampleChannel& channel, const vf32* pDefaultPose, const sint16* pData, uint keyCount )
+	{
+		const uint16* pUnused = (const uint16*)pData;
+		for (uint i = 0; i < keyCount; ++i)
 		{
-			uint is = 0;
-			for (; is < pHeader->interpolatedScaleJointCount; ++is)
-			{
-				const uint jointIndex = (uint)pData[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pData++;
+			const uint jointIndex = pUnused[ 0u ];
+			TIKI_ASSERT( jointIndex < jointCount );
+			pUnused++;
 
-				uint keyIndexLeft = 0;
-				uint keyIndexRight = 0;
-				const uint keyLeftCount = getCountLeftBit( &keyIndexLeft, *pMask, localTime );
-				const uint keyRightCount = getCountRightBit( &keyIndexRight, *pMask, localTime );
-				TIKI_ASSERT( keyLeftCount < 64u || keyRightCount < 64u );
-				TIKI_ASSERT( keyIndexLeft < 64u || keyIndexRight < 64u );
-
-				const sint32 time1 = (sint32)(pHeader->startTime + keyIndexLeft);
-				const sint32 time2 = (sint32)(pHeader->startTime + keyIndexRight);
-
-				pData += keyLeftCount * KeySize_Scale;
+			writeJointChannel( pTargetJoints, jointIndex, channel, pDefaultPose[ jointIndex ] );
+		}
 
-				const vf32 simdTime1	= simd::convert_i32_to_f32( simd::set_i32( time1 ) );
-				const vf32 simdTime2	= simd::convert_i32_to_f32( simd::set_i32( time2 ) );
-				const vf32 simdTimeT	= simd::div_f32( simd::sub_f32( simdFrame, simdTime1 ), simd::sub_f32( simdTime2, simdTime1 ) );
-				const vf32 simdTimeTT	= simd::mul_f32( simdTimeT, simdTimeT );
-				const vf32 simdTimeTTT	= simd::mul_f32( simdTimeTT, simdTimeT );
-				const vf32 simdScale	= simd::sub_f32( simdTime2, simdTime1 );
+		return (const sint16*)pUnused;
+	}
 
-				const vi32 sourceP0 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 0u ] ) );
-				const vi32 sourceT0 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 3u ] ) );
-				const vi32 sourceP1 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 6u ] ) );
-				const vi32 sourceT1 = simd::convert_i16l_to_i32( simd::set_i16u( &pData[ 9u ] ) );
+	void Animation::sample( AnimationJoint* pTargetJoints, uint jointCount, const ModelHierarchy& hierarchy, float time ) const
+	{
+		TIKI_ASSERT( pTargetJoints != nullptr );
 
-				const vf32 simdP0 = simd::mul_f32( simd::convert_i32_to_f32( sourceP0 ), scaleFactor );
-				const vf32 simdP1 = simd::mul_f32( simd::convert_i32_to_f32( sourceP1 ), scaleFactor );
+		const float fullFrame	= time * 60.0f;
+		const uint fullExFrame	= (uint)( fullFrame );
+		const float frameDiff	= fullFrame - (float)fullExFrame;
+		const uint exactFrame	= fullExFrame % m_pData->frameCount;
+		const float frame		= (float)exactFrame + frameDiff;
 
-				const vf32 simdT0 = simd::mul_f32( simd::mul_f32( simd::convert_i32_to_f32( sourceT0 ), scaleTangentFactor ), simdScale );
-				const vf32 simdT1 = simd::mul_f32( simd::mul_f32( simd::convert_i32_to_f32( sourceT1 ), scaleTangentFactor ), simdScale );
+		uint headerIndex = 0;
+		const AnimationChunkHeader* pHeader = addPointerCast< AnimationChunkHeader >( m_pData, m_pData->headerOffset );
+		while ( pHeader[ headerIndex ].endTime <= exactFrame )
+		{
+			TIKI_ASSERT( headerIndex < m_pData->headerCount );
+			headerIndex++;
+		}
+		pHeader += headerIndex;
 
-				const vf32 simdResult = simd::muladd_f32( simd::add_f32( simd::mulsub_f32( all2, simdTimeTTT, simd::mul_f32( all3, simdTimeTT ) ), all1 ), simdP0, simd::muladd_f32( simd::add_f32( simd::negmulsub_f32( all2, simdTimeTT, simdTimeTTT ), simdTimeT ), simdT0, simd::muladd_f32( simd::muladd_f32( allneg2, simdTimeTTT, simd::mul_f32( all3, simdTimeTT ) ), simdP1, simd::mul_f32( simd::sub_f32( simdTimeTTT, simdTimeTT ), simdT1 ) ) ) );
+		const uint localTime		= TIKI_MIN( (exactFrame - pHeader->startTime) + 1u, TIKI_MIN( 63u, m_pData->frameCount - 1u ) );
 
-				simd::get_f32( &pTargetJoints[ jointIndex ].scale.x, simdResult );
+		const SimdKernels& kernels = simd::getKernels();
+
+		AnimationSampleChannel rotationChannel;
+		rotationChannel.componentCount	= 4u;
+		rotationChannel.targetOffset	= TIKI_OFFSETOF( AnimationJoint, rotation );
+		rotationChannel.factor			= 3.0518513e-005f;
+		rotationChannel.tangentFactor	= 7.6293945e-006f;
+		rotationChannel.isRotation		= true;
+
+		AnimationSampleChannel positionChannel;
+		positionChannel.componentCount	= 3u;
+		positionChannel.targetOffset	= TIKI_OFFSETOF( AnimationJoint, position );
+		positionChannel.factor			= m_pData->positionFactor;
+		positionChannel.tangentFactor	= m_pData->positionTangentFactor;
+		positionChannel.isRotation		= false;
+
+		AnimationSampleChannel scaleChannel;
+		scaleChannel.componentCount		= 3u;
+		scaleChannel.targetOffset		= TIKI_OFFSETOF( AnimationJoint, scale );
+		scaleChannel.factor				= m_pData->scaleFactor;
+		scaleChannel.tangentFactor		= m_pData->scaleTangentFactor;
+		scaleChannel.isRotation			= false;
 
-				pData += keyRightCount * KeySize_Scale;
-				pMask++;
-			}
+		//////////////////////////////////////////////////////////////////////////
+		// rotation
+		const uint8* pBaseData	= m_pData->data.getData() + pHeader->dataOffset;
+		const sint16* pData		= (const sint16*)(pBaseData + (sizeof(uint64) * pHeader->interpolatedRotationJointCount));
+		const uint64* pMask		= (const uint64*)pBaseData;
 
-			// const scale
-			for (; is < pHeader->usedScaleJointCount; ++is)
-			{
-				const uint jointIndex = (uint)pData[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pData++;
+		pData = sampleInterpolatedKeys( pTargetJoints, jointCount, rotationChannel, kernels, pMask, pData, pHeader->interpolatedRotationJointCount, pHeader->startTime, localTime, frame );
+		pData = sampleConstKeys( pTargetJoints, jointCount, rotationChannel, kernels, pData, pHeader->usedRotationJointCount - pHeader->interpolatedRotationJointCount );
+		pData = sampleDefaultPoseKeys( pTargetJoints, jointCount, rotationChannel, hierarchy.getDefaultPoseRotation(), pData, pHeader->defaultPoseRotationJointCount );
 
-				decompressScale( pTargetJoints[ jointIndex ].scale, pData, scaleFactor );
-				pData += KeySize_ConstScale;
-			}
+		//////////////////////////////////////////////////////////////////////////
+		// position
+		pBaseData	= (const uint8*)alignPointer( pData, 8u );
+		pData		= (const sint16*)(pBaseData + (sizeof(uint64) * pHeader->interpolatedPositionJointCount));
+		pMask		= (const uint64*)pBaseData;
 
-			// unused scale
-			const uint16* pUnused = (uint16*)pData;				
-			const vf32* pDefaultPoseScale = hierarchy.getDefaultPoseScale();
-			for (uint i = 0; i < pHeader->defaultPoseScaleJointCount; ++i)
-			{
-				const uint jointIndex = pUnused[ 0u ];
-				TIKI_ASSERT( jointIndex < jointCount );
-				pUnused++;
+		pData = sampleInterpolatedKeys( pTargetJoints, jointCount, positionChannel, kernels, pMask, pData, pHeader->interpolatedPositionJointCount, pHeader->startTime, localTime, frame );
+		pData = sampleConstKeys( pTargetJoints, jointCount, positionChannel, kernels, pData, pHeader->usedPositionJointCount - pHeader->interpolatedPositionJointCount );
+		pData = sampleDefaultPoseKeys( pTargetJoints, jointCount, positionChannel, hierarchy.getDefaultPosePosition(), pData, pHeader->defaultPosePositionJointCount );
 
-				simd::get_f32( &pTargetJoints[ jointIndex ].scale.x, pDefaultPoseScale[ jointIndex ] );
-			}
+		//////////////////////////////////////////////////////////////////////////
+		// scale
+		pBaseData	= (const uint8*)alignPointer( pData, 8u );
+		pData		= (const sint16*)(pBaseData + (sizeof(uint64) * pHeader->interpolatedScaleJointCount));
+		pMask		= (const uint64*)pBaseData;
 
-			pData = (sint16*)pUnused;
-		}
+		pData = sampleInterpolatedKeys( pTargetJoints, jointCount, scaleChannel, kernels, pMask, pData, pHeader->interpolatedScaleJointCount, pHeader->startTime, localTime, frame );
+		pData = sampleConstKeys( pTargetJoints, jointCount, scaleChannel, kernels, pData, pHeader->usedScaleJointCount - pHeader->interpolatedScaleJointCount );
+		sampleDefaultPoseKeys( pTargetJoints, jointCount, scaleChannel, hierarchy.getDefaultPoseScale(), pData, pHeader->defaultPoseScaleJointCount );
 	}
 }
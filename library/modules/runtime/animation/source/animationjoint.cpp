@@ -4,21 +4,40 @@
 #include "tiki/base/functions.hpp"
 #include "tiki/graphics/modelhierarchy.hpp"
 #include "tiki/math/matrix.hpp"
+#include "tiki/tasksystem/taskcontext.hpp"
+#include "tiki/tasksystem/tasksystem.hpp"
+#include "tiki/threading/thread.hpp"
 
 namespace tiki
 {
-	void AnimationJoint::buildPoseMatrices( Matrix44* pTargetMatrix, uint targetCapacity, const AnimationJoint* pJoints, const ModelHierarchy& hierarchy )
+	struct AnimationJointSkinData
+	{
+		Matrix44*				pTargetMatrix;
+		const ModelHierarchy*	pHierarchy;
+	};
+
+	static void applySkinToBoneMatrices( const TaskContext& context, uint begin, uint end )
+	{
+		const AnimationJointSkinData& data = *static_cast< const AnimationJointSkinData* >( context.pTaskData );
+
+		if ( begin < end )
+		{
+			// skin to bone * pose, the skin matrices are stored continuously
+			matrix::mulBatch( data.pTargetMatrix + begin, &data.pHierarchy->getSkinToBoneMatrix( begin ), data.pTargetMatrix + begin, end - begin );
+		}
+	}
+
+	void AnimationJoint::buildPoseMatrices( Matrix44* pTargetMatrix, uint targetCapacity, const AnimationJoint* pJoints, const ModelHierarchy& hierarchy, TaskSystem* pTaskSystem /*= nullptr*/ )
 	{
 		TIKI_ASSERT( pTargetMatrix != nullptr );
 		TIKI_ASSERT( pJoints != nullptr );
 
 		const uint jointCount = TIKI_MIN( targetCapacity, hierarchy.getJointCount() );
+		matrix::composeBatch( pTargetMatrix, &pJoints[ 0u ].rotation, &pJoints[ 0u ].position, &pJoints[ 0u ].scale, jointCount, sizeof( AnimationJoint ) );
+
 		for (uint i = 0u; i < jointCount; ++i)
 		{
-			const AnimationJoint& joint = pJoints[ i ];
-
-			matrix::compose( pTargetMatrix[ i ], joint.rotation, joint.position, joint.scale );
-
+			// parents have a lower index, their matrices are complete at this point
 			const uint parentIndex = hierarchy.getParentByIndex( i );
 			if ( parentIndex != ModelHierarchy::InvalidBoneIndex )
 			{
@@ -27,12 +46,19 @@ namespace tiki
 			}
 		}
 
-		for (uint i = 0u; i < jointCount; ++i)
+		// joints depend on their parents, only the skin matrices can be applied in parallel
+		AnimationJointSkinData skinData;
+		skinData.pTargetMatrix	= pTargetMatrix;
+		skinData.pHierarchy		= &hierarchy;
+
+		if ( pTaskSystem != nullptr )
+		{
+			pTaskSystem->parallelFor( 0u, jointCount, 32u, applySkinToBoneMatrices, &skinData );
+		}
+		else
 		{
-			Matrix44 mtx = pTargetMatrix[ i ];
-			pTargetMatrix[ i ] = hierarchy.getSkinToBoneMatrix( i );
-			matrix::mul( pTargetMatrix[ i ], mtx );
-			//matrix::transpose( pTargetMatrix[ i ] );
+			const TaskContext context( Thread::getCurrentThread(), &skinData );
+			applySkinToBoneMatrices( context, 0u, jointCount );
 		}
 	}
 
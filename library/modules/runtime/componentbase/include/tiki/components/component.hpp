@@ -2,6 +2,7 @@
 #ifndef __TIKI_COMPONENTBASE_HPP_INCLUDED__
 #define __TIKI_COMPONENTBASE_HPP_INCLUDED__
 
+#include "tiki/base/stringid.hpp"
 #include "tiki/base/types.hpp"
 #include "tiki/components/componentiterator.hpp"
 
@@ -22,10 +23,13 @@ namespace tiki
 		virtual bool			initializeState( ComponentEntityIterator& componentIterator, ComponentState* pComponentState, const void* pComponentInitData ) = 0;
 		virtual void			disposeState( ComponentState* pComponentState ) = 0;
 
+		// the crc of the interned type name
 		virtual crc32			getTypeCrc() const;
 		virtual uint32			getStateSize() const = 0;
 		virtual const char*		getTypeName() const = 0;
 
+		StringId				getTypeNameId() const;
+
 #if TIKI_ENABLED( TIKI_BUILD_DEBUG )
 		virtual bool			checkIntegrity() const = 0;
 #endif
@@ -38,6 +42,10 @@ namespace tiki
 
 		ComponentTypeId			m_registedTypeId;
 
+	private:
+
+		mutable StringId		m_typeNameId;
+
 	};
 
 	template< typename TState, typename TInitData >
@@ -1,7 +1,5 @@
 #include "tiki/components/component.hpp"
 
-#include "tiki/base/crc32.hpp"
-
 namespace tiki
 {
 	ComponentBase::ComponentBase()
@@ -31,6 +29,16 @@ namespace tiki
 
 	crc32 ComponentBase::getTypeCrc() const
 	{
-		return crcString( getTypeName() );
+		return getTypeNameId().getCrc();
+	}
+
+	StringId ComponentBase::getTypeNameId() const
+	{
+		if ( m_typeNameId.isEmpty() )
+		{
+			m_typeNameId = StringId( getTypeName() );
+		}
+
+		return m_typeNameId;
 	}
 }
\ No newline at end of file
@@ -10,3 +10,4 @@ module:add_include_dir( "include" );
 module:add_dependency( "componentbase" );
 module:add_dependency( "entitysystem" );
 module:add_dependency( "physics" );
+module:add_dependency( "tasksystem" );
@@ -24,7 +24,6 @@ namespace tiki
 
 		void				update( EntitySystem& entitySystem, timems timeMs );
 
-		virtual crc32		getTypeCrc() const;
 		virtual uint32		getStateSize() const;
 		virtual const char*	getTypeName() const;
 
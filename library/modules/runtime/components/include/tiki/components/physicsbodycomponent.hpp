@@ -35,7 +35,6 @@ namespace tiki
 
 		const PhysicsCollisionObject&	getPhysicsObject( const PhysicsBodyComponentState* pState ) const;
 
-		virtual crc32					getTypeCrc() const;
 		virtual uint32					getStateSize() const;
 		virtual const char*				getTypeName() const;
 
@@ -38,7 +38,6 @@ namespace tiki
 
 		void							setRotation( PhysicsCharacterControllerComponentState* pState, const Quaternion& rotation ) const;
 
-		virtual crc32					getTypeCrc() const;
 		virtual uint32					getStateSize() const;
 		virtual const char*				getTypeName() const;
 
@@ -25,7 +25,6 @@ namespace tiki
 
 		const PhysicsCollisionObject&	getPhysicsObject( const PhysicsColliderComponentState* pState ) const;
 
-		virtual crc32					getTypeCrc() const;
 		virtual uint32					getStateSize() const;
 		virtual const char*				getTypeName() const;
 
@@ -3,11 +3,14 @@
 #define __TIKI_TRANSFORMCOMPONENT_HPP_INCLUDED__
 
 #include "tiki/components/component.hpp"
+#include "tiki/container/list.hpp"
+#include "tiki/math/boundingvolumehierarchy.hpp"
 
 namespace tiki
 {
 	struct Matrix43;
 	struct Quaternion;
+	class TaskSystem;
 	struct TransformComponentInitData;
 	struct TransformComponentState;
 	struct Vector3;
@@ -24,7 +27,7 @@ namespace tiki
 		bool				create();
 		void				dispose();
 
-		void				update();
+		void				update( TaskSystem* pTaskSystem = nullptr );
 
 		void				getPosition( Vector3& targetPosition, const TransformComponentState* pState ) const;
 		void				getRotation( Quaternion& targetRotation, const TransformComponentState* pState ) const;
@@ -33,7 +36,10 @@ namespace tiki
 		void				setPosition( TransformComponentState* pState, const Vector3& position ) const;
 		void				setRotation( TransformComponentState* pState, const Quaternion& rotation ) const;
 
-		virtual crc32		getTypeCrc() const;
+		// all transforms are registered with their position, the user data of the proxies is the
+		// TransformComponentState. the proxies are moved in update.
+		const BoundingVolumeHierarchy&	getBoundingVolumeHierarchy() const	{ return m_boundingVolumeHierarchy; }
+
 		virtual uint32		getStateSize() const;
 		virtual const char*	getTypeName() const;
 
@@ -42,6 +48,14 @@ namespace tiki
 		virtual bool		internalInitializeState( ComponentEntityIterator& componentIterator, TransformComponentState* pComponentState, const TransformComponentInitData* pComponentInitData );
 		virtual void		internalDisposeState( TransformComponentState* pComponentState );
 
+	private:
+
+		List< State* >		m_updateStates;
+
+		BoundingVolumeHierarchy	m_boundingVolumeHierarchy;
+
+		void				updateProxy( State* pState );
+
 	};
 }
 
@@ -1,7 +1,6 @@
 
 #include "tiki/components/lifetimecomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/entitysystem/entitysystem.hpp"
 
@@ -47,11 +46,6 @@ namespace tiki
 		}
 	}
 
-	crc32 LifeTimeComponent::getTypeCrc() const
-	{
-		return crcString( "LifeTimeComponent" );
-	}
-
 	uint32 LifeTimeComponent::getStateSize() const
 	{
 		return sizeof( LifeTimeComponentState );
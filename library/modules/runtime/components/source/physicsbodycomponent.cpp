@@ -1,7 +1,6 @@
 
 #include "tiki/components/physicsbodycomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/components/transformcomponent.hpp"
 #include "tiki/math/quaternion.hpp"
@@ -101,11 +100,6 @@ namespace tiki
 		return pState->body;
 	}
 
-	crc32 PhysicsBodyComponent::getTypeCrc() const
-	{
-		return crcString( "PhysicsBodyComponent" );
-	}
-
 	uint32 PhysicsBodyComponent::getStateSize() const
 	{
 		return sizeof( PhysicsBodyComponentState );
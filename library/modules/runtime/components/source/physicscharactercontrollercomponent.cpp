@@ -1,7 +1,6 @@
 
 #include "tiki/components/physicscharactercontrollercomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/components/transformcomponent.hpp"
 #include "tiki/math/quaternion.hpp"
@@ -115,11 +114,6 @@ namespace tiki
 		return pState->controller;
 	}
 
-	crc32 PhysicsCharacterControllerComponent::getTypeCrc() const
-	{
-		return crcString( "PhysicsCharacterControllerComponent" );
-	}
-
 	uint32 PhysicsCharacterControllerComponent::getStateSize() const
 	{
 		return sizeof( PhysicsCharacterControllerComponentState );
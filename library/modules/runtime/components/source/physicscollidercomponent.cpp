@@ -1,7 +1,6 @@
 
 #include "tiki/components/physicscollidercomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/physics/physicsboxshape.hpp"
 #include "tiki/physics/physicscapsuleshape.hpp"
@@ -51,11 +50,6 @@ namespace tiki
 		return pState->collider;
 	}
 
-	crc32 PhysicsColliderComponent::getTypeCrc() const
-	{
-		return crcString( "PhysicsColliderComponent" );
-	}
-
 	uint32 PhysicsColliderComponent::getStateSize() const
 	{
 		return sizeof( PhysicsColliderComponentState );
@@ -1,7 +1,6 @@
 
 #include "tiki/components/skinnedmodelcomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/components/transformcomponent.hpp"
 #include "tiki/graphics/model.hpp"
@@ -49,11 +48,6 @@ namespace tiki
 	{
 	}
 
-	crc32 SkinnedModelComponent::getTypeCrc() const
-	{
-		return crcString( "SkinnedModelComponent" );
-	}
-
 	uint32 SkinnedModelComponent::getStateSize() const
 	{
 		return sizeof( SkinnedModelComponentState );
@@ -1,7 +1,6 @@
 
 #include "tiki/components/staticmodelcomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/components/transformcomponent.hpp"
 #include "tiki/renderer/renderscene.hpp"
@@ -12,6 +11,11 @@ namespace tiki
 {
 	struct TransformComponentState;
 
+	enum
+	{
+		StaticModelComponentRenderBatchSize	= 64u
+	};
+
 	struct StaticModelComponentState : public ComponentState
 	{
 		const TransformComponentState*	pTransform;
@@ -42,21 +46,28 @@ namespace tiki
 
 	void StaticModelComponent::render( RenderScene& scene ) const
 	{
+		// collects the models in batches, so the scene can cull several bounds at once
+		const Model* apModels[ StaticModelComponentRenderBatchSize ];
+		Matrix43 aWorldTransforms[ StaticModelComponentRenderBatchSize ];
+		uint count = 0u;
+
 		ConstIterator componentStates = getConstIterator();
 
 		const State* pState = nullptr;
 		while ( pState = componentStates.getNext() )
 		{
-			Matrix43 worldTransform;
-			m_pTransformComponent->getWorldTransform( worldTransform, pState->pTransform );
-
-			scene.queueModel( pState->pModel, &worldTransform, nullptr );
+			m_pTransformComponent->getWorldTransform( aWorldTransforms[ count ], pState->pTransform );
+			apModels[ count ] = pState->pModel;
+			count++;
+
+			if ( count == StaticModelComponentRenderBatchSize )
+			{
+				scene.queueVisibleModels( apModels, aWorldTransforms, count );
+				count = 0u;
+			}
 		}
-	}
 
-	crc32 StaticModelComponent::getTypeCrc() const
-	{
-		return crcString( "StaticModelComponent" );
+		scene.queueVisibleModels( apModels, aWorldTransforms, count );
 	}
 
 	uint32 StaticModelComponent::getStateSize() const
@@ -11,6 +11,11 @@ namespace tiki
 {
 	struct TransformComponentState;
 
+	enum
+	{
+		TerrainComponentRenderBatchSize	= 64u
+	};
+
 	struct TerrainComponentState : public ComponentState
 	{
 		const TransformComponentState*	pTransform;
@@ -41,16 +46,28 @@ namespace tiki
 
 	void TerrainComponent::render( RenderScene& scene ) const
 	{
+		// collects the models in batches, so the scene can cull several bounds at once
+		const Model* apModels[ TerrainComponentRenderBatchSize ];
+		Matrix43 aWorldTransforms[ TerrainComponentRenderBatchSize ];
+		uint count = 0u;
+
 		ConstIterator componentStates = getConstIterator();
 
 		const State* pState = nullptr;
 		while ( pState = componentStates.getNext() )
 		{
-			Matrix43 worldTransform;
-			m_pTransformComponent->getWorldTransform( worldTransform, pState->pTransform );
-
-			scene.queueModel( pState->pModel, &worldTransform, nullptr );
+			m_pTransformComponent->getWorldTransform( aWorldTransforms[ count ], pState->pTransform );
+			apModels[ count ] = pState->pModel;
+			count++;
+
+			if ( count == TerrainComponentRenderBatchSize )
+			{
+				scene.queueVisibleModels( apModels, aWorldTransforms, count );
+				count = 0u;
+			}
 		}
+
+		scene.queueVisibleModels( apModels, aWorldTransforms, count );
 	}
 
 	float TerrainComponent::getHeightAtPosition( const TerrainComponentState* pComponentState, const Vector2& position ) const
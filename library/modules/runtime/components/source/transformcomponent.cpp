@@ -1,16 +1,21 @@
 
 #include "tiki/components/transformcomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
+#include "tiki/math/axisalignedbox.hpp"
 #include "tiki/math/matrix.hpp"
 #include "tiki/math/quaternion.hpp"
 #include "tiki/math/vector.hpp"
+#include "tiki/tasksystem/taskcontext.hpp"
+#include "tiki/tasksystem/tasksystem.hpp"
 
 #include "components.hpp"
 
 namespace tiki
 {
+	// the positions are points, so the margin is all the space a transform can move without a reinsert
+	static const float s_transformProxyMargin = 1.0f;
+
 	struct TransformComponentState : public ComponentState
 	{
 		Vector3		position;
@@ -19,6 +24,8 @@ namespace tiki
 
 		bool		needUpdate;
 		Matrix43	worldTransform;
+
+		uint32		proxyId;
 	};
 
 	static void checkAndUpdateWorldTransform( TransformComponentState* pState )
@@ -34,6 +41,15 @@ namespace tiki
 		}
 	}
 
+	static void updateWorldTransforms( const TaskContext& context, uint begin, uint end )
+	{
+		TransformComponentState** ppStates = static_cast< TransformComponentState** >( context.pTaskData );
+		for (uint i = begin; i < end; ++i)
+		{
+			checkAndUpdateWorldTransform( ppStates[ i ] );
+		}
+	}
+
 	TransformComponent::TransformComponent()
 	{
 	}
@@ -44,23 +60,59 @@ namespace tiki
 
 	bool TransformComponent::create()
 	{
-		return true;
+		return m_boundingVolumeHierarchy.create( s_transformProxyMargin );
 	}
 
 	void TransformComponent::dispose()
 	{
-
+		m_updateStates.dispose();
+		m_boundingVolumeHierarchy.dispose();
 	}
 
-	void TransformComponent::update()
+	void TransformComponent::update( TaskSystem* pTaskSystem /*= nullptr*/ )
 	{
 		Iterator componentStates = getIterator();
 
 		State* pState = nullptr;
+		if ( pTaskSystem == nullptr )
+		{
+			while ( pState = componentStates.getNext() )
+			{
+				checkAndUpdateWorldTransform( pState );
+				updateProxy( pState );
+			}
+
+			return;
+		}
+
+		// gather the states to split them over all threads
+		m_updateStates.clear();
 		while ( pState = componentStates.getNext() )
 		{
-			checkAndUpdateWorldTransform( pState );
+			m_updateStates.add( pState );
 		}
+
+		pTaskSystem->parallelFor( 0u, m_updateStates.getCount(), 256u, updateWorldTransforms, m_updateStates.getBegin() );
+
+		// the tree is not thread safe
+		for (uint i = 0u; i < m_updateStates.getCount(); ++i)
+		{
+			updateProxy( m_updateStates[ i ] );
+		}
+	}
+
+	void TransformComponent::updateProxy( State* pState )
+	{
+		if ( !pState->needUpdate )
+		{
+			return;
+		}
+
+		AxisAlignedBox box;
+		box.createFromMinMax( pState->position, pState->position );
+		m_boundingVolumeHierarchy.moveProxy( pState->proxyId, box );
+
+		pState->needUpdate = false;
 	}
 
 	void TransformComponent::getPosition( Vector3& targetPosition, const TransformComponentState* pState ) const
@@ -100,11 +152,6 @@ namespace tiki
 		pState->needUpdate	= true;
 	}
 
-	crc32 TransformComponent::getTypeCrc() const
-	{
-		return crcString( "TransformComponent" );
-	}
-
 	uint32 TransformComponent::getStateSize() const
 	{
 		return sizeof( TransformComponentState );
@@ -124,11 +171,18 @@ namespace tiki
 
 		checkAndUpdateWorldTransform( pState );
 
+		AxisAlignedBox box;
+		box.createFromMinMax( pState->position, pState->position );
+		pState->proxyId = m_boundingVolumeHierarchy.addProxy( box, pState );
+
 		return true;
 	}
 
 	void TransformComponent::internalDisposeState( TransformComponentState* pState )
 	{
+		m_boundingVolumeHierarchy.removeProxy( pState->proxyId );
+		pState->proxyId = BoundingVolumeHierarchyInvalidProxyId;
+
 		vector::clear( pState->position );
 		quaternion::clear( pState->rotation );
 		vector::clear( pState->scale );
@@ -97,7 +97,7 @@ namespace tiki
 
 	void DebugRenderer::create( ResourceManager& resourceManager )
 	{
-		m_data.create( 1u * 1024u * 1024u );
+		m_data.create( 64u * 1024u );
 
 		m_list2D.clear();
 		m_list3D.clear();
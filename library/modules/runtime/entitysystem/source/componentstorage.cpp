@@ -34,6 +34,8 @@ namespace tiki
 
 	bool ComponentStorage::create( uint chunkSize, uint chunkCount, const ComponentTypeRegister& typeRegister )
 	{
+		MemoryTagScope memoryTag( MemoryTag_Entity );
+
 		if ( chunkSize < MinChunkSize || chunkSize > MaxChunkSize || !isValueAligned( chunkSize, (uint)ChunkAlignment ) )
 		{
 			return false;
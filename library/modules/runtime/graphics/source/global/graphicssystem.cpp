@@ -2,6 +2,7 @@
 #include "tiki/graphics/graphicssystem.hpp"
 
 #include "tiki/base/crc32.hpp"
+#include "tiki/base/memory.hpp"
 
 namespace tiki
 {
@@ -21,6 +22,8 @@ namespace tiki
 
 	bool GraphicsSystem::create( const GraphicsSystemParameters& params )
 	{
+		MemoryTagScope memoryTag( MemoryTag_Graphics );
+
 		bool result = createPlatform( params );
 
 		if ( result )
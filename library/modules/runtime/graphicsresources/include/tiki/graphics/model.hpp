@@ -28,6 +28,9 @@ namespace tiki
 		const ModelGeometry&				getGeometryByIndex( size_t index ) const { return m_geometries[ index ]; }
 		size_t								getGeometryCount() const { return m_geometries.getCount(); }
 
+		// in model space, contains all geometries
+		const AxisAlignedBox&				getBoundingBox() const { return m_boundingBox; }
+
 	protected:
 
 		virtual bool						createInternal( const ResourceInitData& initData, const FactoryContext& factoryContext );
@@ -42,6 +45,7 @@ namespace tiki
 		ModelHierarchy*						m_pHierarchy;
 
 		Array< ModelGeometry >				m_geometries;
+		AxisAlignedBox						m_boundingBox;
 
 	};
 }
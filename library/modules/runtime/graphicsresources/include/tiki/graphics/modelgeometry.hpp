@@ -5,6 +5,7 @@
 #include "tiki/graphics/indexbuffer.hpp"
 #include "tiki/graphics/vertexbuffer.hpp"
 #include "tiki/graphics/vertexattribute.hpp"
+#include "tiki/math/axisalignedbox.hpp"
 #include "tiki/math/matrix.hpp"
 #include "tiki/resource/resourcefile.hpp"
 
@@ -45,7 +46,7 @@ namespace tiki
 
 		bool						isSkinned() const		{ return m_desc.isSkinned; }
 		const ModelGeometryDesc&	getDescription() const	{ return m_desc; }
-		//void						getBoundingBox( Vector3& min, Vector3& max ) const;
+		const AxisAlignedBox&		getBoundingBox() const	{ return m_boundingBox; }
 
 		const VertexFormat*			getVertexFormat() const	{ return m_pVertexFormat; }
 
@@ -62,6 +63,7 @@ namespace tiki
 		const VertexFormat*			m_pVertexFormat;
 
 		ModelGeometryDesc			m_desc;
+		AxisAlignedBox				m_boundingBox;
 
 		StaticArray< const uint8 >	m_vertexData;
 		StaticArray< const uint8 >	m_indexData;
@@ -70,6 +72,7 @@ namespace tiki
 		VertexBuffer				m_vertexBuffer;
 
 		bool						initialize( GraphicsSystem& graphicsSystem, const ModelGeometryInitData& initData, const Material* pMaterial );
+		void						createBoundingBox( const ModelGeometryInitData& initData );
 		void						dispose( GraphicsSystem& graphicsSystem );
 
 	};
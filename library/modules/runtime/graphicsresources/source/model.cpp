@@ -44,6 +44,7 @@ namespace tiki
 	{
 		m_pHierarchy = nullptr;
 		m_pMaterial = nullptr;
+		m_boundingBox.createFromMinMax( Vector3::zero, Vector3::zero );
 	}
 
 	Model::~Model()
@@ -69,6 +70,15 @@ namespace tiki
 		{
 			const ModelGeometryInitData* pGeometryInitData = modelInitData.geometries[ i ].getData();
 			m_geometries[ i ].initialize( factory.graphicsSystem, *pGeometryInitData, m_pMaterial );
+
+			if ( i == 0u )
+			{
+				m_boundingBox = m_geometries[ i ].getBoundingBox();
+			}
+			else
+			{
+				m_boundingBox.extendByBox( m_geometries[ i ].getBoundingBox() );
+			}
 		}
 
 		return true;
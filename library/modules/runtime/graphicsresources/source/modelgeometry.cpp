@@ -29,6 +29,8 @@ namespace tiki
 		m_indexBuffer.create( graphicsSystem, m_desc.indexCount, (IndexType)m_desc.indexType, false, initData.indexData.getData() );
 		m_indexData.create( initData.indexData.getData(), m_desc.indexCount * m_desc.indexType );
 
+		createBoundingBox( initData );
+
 		return true;
 	}
 
@@ -55,19 +57,57 @@ namespace tiki
 		graphicsContext.drawIndexedGeometry( m_desc.indexCount );
 	}
 
-	//void ModelGeometry::getMinMax( Vector3& min, Vector3& max ) const
-	//{
-	//	const void* pData = (uint8*)m_vertexData.getData();
+	void ModelGeometry::createBoundingBox( const ModelGeometryInitData& initData )
+	{
+		// without float positions the geometry is never culled
+		m_boundingBox.createUnbounded();
 
-	//	for( uint i = 0; i < m_desc.vertexCount; ++i )
-	//	{
-	//		Vector3 tmp( (float*)pData );
+		const VertexAttribute* pAttributes = initData.vertexAttributes.getData();
+		const uint8* pVertexData = initData.vertexData.getData();
+		if ( pAttributes == nullptr || pVertexData == nullptr || m_desc.vertexCount == 0u )
+		{
+			return;
+		}
 
-	//		min.min( tmp );
-	//		max.max( tmp );
+		uint offset = 0u;
+		const VertexAttribute* pPositionAttribute = nullptr;
+		for (uint i = 0u; i < m_desc.vertexAttributeCount; ++i)
+		{
+			const VertexAttribute& attribute = pAttributes[ i ];
+			if ( attribute.streamIndex != 0u )
+			{
+				continue;
+			}
+
+			if ( attribute.semantic == VertexSementic_Position && attribute.semanticIndex == 0u )
+			{
+				pPositionAttribute = &attribute;
+				break;
+			}
+
+			offset += getVertexAttributeFormatSize( attribute.format );
+		}
 
-	//		pData = addPtr( pData, m_desc.vertexStride );
-	//	}
-	//}
+		if ( pPositionAttribute == nullptr || ( pPositionAttribute->format != VertexAttributeFormat_x32y32z32_float && pPositionAttribute->format != VertexAttributeFormat_x32y32z32w32_float ) )
+		{
+			return;
+		}
 
+		for (uint i = 0u; i < m_desc.vertexCount; ++i)
+		{
+			// the vertex data is packed, so the positions are not aligned
+			float3 position;
+			memory::copy( &position, pVertexData + ( i * m_desc.vertexStride ) + offset, sizeof( position ) );
+
+			const Vector3 point = vector::create( position );
+			if ( i == 0u )
+			{
+				m_boundingBox.createFromMinMax( point, point );
+			}
+			else
+			{
+				m_boundingBox.extendByPoint( point );
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -7,34 +7,52 @@ namespace tiki
 	struct TaskContext;
 
 	typedef void (*TaskFunc)(const TaskContext& context);
+	typedef void (*TaskRangeFunc)(const TaskContext& context, uint begin, uint end);
 
 	typedef uint32 TaskId;
 
 	enum
 	{
-		InvalidTaskId = 0xffffffffu
+		InvalidTaskId			= 0xffffffffu,
+		MaxTaskDependencyCount	= 8u
+	};
+
+	// workers always take the most important queued task first
+	enum TaskPriority
+	{
+		TaskPriority_High,		// frame critical
+		TaskPriority_Normal,
+		TaskPriority_Low,		// background work like streaming or conversion
+
+		TaskPriority_Count
+	};
+
+	enum TaskPriorityMask
+	{
+		TaskPriorityMask_High		= 1u << TaskPriority_High,
+		TaskPriorityMask_Normal		= 1u << TaskPriority_Normal,
+		TaskPriorityMask_Low		= 1u << TaskPriority_Low,
+
+		TaskPriorityMask_All		= TaskPriorityMask_High | TaskPriorityMask_Normal | TaskPriorityMask_Low
 	};
 
 	struct Task
 	{
 		Task()
 		{
-			id				= InvalidTaskId;
-			dependingTaskId	= InvalidTaskId;
-			pFunc			= nullptr;
-			pData			= nullptr;
+			id		= InvalidTaskId;
+			pFunc	= nullptr;
+			pData	= nullptr;
 		}
 
-		Task(TaskId _id, TaskId _dependingTaskId, TaskFunc _pFunc, void* _pData)
+		Task(TaskId _id, TaskFunc _pFunc, void* _pData)
 		{
-			id				= id;
-			dependingTaskId	= _dependingTaskId;
-			pFunc			= _pFunc;
-			pData			= _pData;
+			id		= _id;
+			pFunc	= _pFunc;
+			pData	= _pData;
 		}
 
 		TaskId		id;
-		TaskId		dependingTaskId;
 		TaskFunc	pFunc;
 		void*		pData;
 	};
@@ -0,0 +1,117 @@
+#pragma once
+#ifndef TIKI_TASKALLOCATOR_HPP_INCLUDED__
+#define TIKI_TASKALLOCATOR_HPP_INCLUDED__
+
+#include "tiki/base/allocator.hpp"
+#include "tiki/base/types.hpp"
+#include "tiki/threading/atomic.hpp"
+#include "tiki/threading/spinlock.hpp"
+
+namespace tiki
+{
+	struct TaskAllocatorStatistics
+	{
+		TaskAllocatorStatistics()
+		{
+			sizeInBytes			= 0u;
+			highWaterMark		= 0u;
+			overflowCount		= 0u;
+		}
+
+		uint	sizeInBytes;
+
+		// highest number of requested bytes including heap fallbacks. a high water mark above the size means the
+		// allocator is too small.
+		uint	highWaterMark;
+		uint	overflowCount;
+	};
+
+	// linear allocator for temporary memory of a single thread. when the buffer is exhausted allocations fall back to
+	// the heap. everything allocated after a marker is released with freeToMarker.
+	class TaskScratchAllocator : public Allocator
+	{
+		TIKI_NONCOPYABLE_CLASS( TaskScratchAllocator );
+
+	public:
+
+		struct Marker
+		{
+			uint	offset;
+			void*	pOverflow;
+		};
+
+						TaskScratchAllocator();
+		virtual			~TaskScratchAllocator();
+
+		bool			create( uint sizeInBytes );
+		void			dispose();
+
+		virtual void*	allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT ) TIKI_OVERRIDE;
+		// does nothing. the memory is released with freeToMarker.
+		virtual void	free( void* pMemory ) TIKI_OVERRIDE;
+
+		template< typename T >
+		T*				allocateArray( uint count ) { return static_cast< T* >( allocate( sizeof( T ) * count, TIKI_ALIGNOF( T ) ) ); }
+
+		Marker			getMarker() const;
+		void			freeToMarker( const Marker& marker );
+
+		// only a snapshot when read from an other thread
+		void			getStatistics( TaskAllocatorStatistics& statistics ) const;
+
+	private:
+
+		uint8*	m_pMemory;
+		uint	m_size;
+		uint	m_offset;
+
+		void*	m_pOverflow;
+		uint	m_overflowSize;
+
+		uint	m_highWaterMark;
+		uint	m_overflowCount;
+
+	};
+
+	// bump allocator shared by all threads. the memory stays valid until the allocator is reset at the end of the frame.
+	class TaskFrameAllocator : public Allocator
+	{
+		TIKI_NONCOPYABLE_CLASS( TaskFrameAllocator );
+
+	public:
+
+						TaskFrameAllocator();
+		virtual			~TaskFrameAllocator();
+
+		bool			create( uint sizeInBytes );
+		void			dispose();
+
+		virtual void*	allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT ) TIKI_OVERRIDE;
+		// does nothing. the memory is released with reset.
+		virtual void	free( void* pMemory ) TIKI_OVERRIDE;
+
+		template< typename T >
+		T*				allocateArray( uint count ) { return static_cast< T* >( allocate( sizeof( T ) * count, TIKI_ALIGNOF( T ) ) ); }
+
+		// no other thread may use the allocator or its memory during reset
+		void			reset();
+
+		void			getStatistics( TaskAllocatorStatistics& statistics ) const;
+
+	private:
+
+		uint8*			m_pMemory;
+		uint			m_size;
+		AtomicUInt64	m_offset;
+
+		SpinLock		m_overflowLock;
+		void*			m_pOverflow;
+		uint			m_overflowSize;
+		uint			m_overflowCount;
+
+		uint			m_highWaterMark;
+
+	};
+}
+
+#endif // TIKI_TASKALLOCATOR_HPP_INCLUDED__
@@ -4,18 +4,27 @@
 
 namespace tiki
 {
+	class TaskFrameAllocator;
+	class TaskScratchAllocator;
 	class Thread;
 
 	struct TaskContext
 	{
-		TaskContext( const Thread& _thread, void* _pTaskData )
+		TaskContext( const Thread& _thread, void* _pTaskData, TaskScratchAllocator* _pScratchAllocator = nullptr, TaskFrameAllocator* _pFrameAllocator = nullptr )
 			: thread( _thread )
 		{
-			pTaskData = _pTaskData;
+			pTaskData			= _pTaskData;
+			pScratchAllocator	= _pScratchAllocator;
+			pFrameAllocator		= _pFrameAllocator;
 		}
 
-		const Thread&	thread;
-		void*			pTaskData;
+		const Thread&			thread;
+		void*					pTaskData;
+
+		// scratch memory is released when the task returns. frame memory is released by TaskSystem::endFrame. both are
+		// nullptr when the function doesn't run in a TaskSystem.
+		TaskScratchAllocator*	pScratchAllocator;
+		TaskFrameAllocator*		pFrameAllocator;
 	};
 }
 
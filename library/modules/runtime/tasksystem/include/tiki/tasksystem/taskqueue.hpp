@@ -0,0 +1,46 @@
+#pragma once
+#ifndef TIKI_TASKQUEUE_HPP_INCLUDED__
+#define TIKI_TASKQUEUE_HPP_INCLUDED__
+
+#include "tiki/base/types.hpp"
+#include "tiki/threading/atomic.hpp"
+
+namespace tiki
+{
+	// bounded work-stealing deque (Chase-Lev). push and pop are only allowed from the owning thread, steal from any thread.
+	class TaskQueue
+	{
+		TIKI_NONCOPYABLE_CLASS( TaskQueue );
+
+	public:
+
+		TaskQueue();
+		~TaskQueue();
+
+		bool			create( uint capacity );
+		void			dispose();
+
+		bool			push( uint32 value );
+		bool			pop( uint32& targetValue );
+		bool			steal( uint32& targetValue );
+
+		bool			isEmpty() const;
+		uint			getCount() const;
+		uint			getCapacity() const { return m_capacity; }
+
+	private:
+
+		AtomicSInt64	m_top;
+		uint8			m_topPadding[ TIKI_CACHE_LINE_SIZE - sizeof( AtomicSInt64 ) ];
+
+		AtomicSInt64	m_bottom;
+		uint8			m_bottomPadding[ TIKI_CACHE_LINE_SIZE - sizeof( AtomicSInt64 ) ];
+
+		AtomicUInt32*	m_pData;
+		uint			m_capacity;
+		uint			m_mask;
+
+	};
+}
+
+#endif // TIKI_TASKQUEUE_HPP_INCLUDED__
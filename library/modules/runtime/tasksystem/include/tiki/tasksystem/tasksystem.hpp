@@ -5,17 +5,47 @@
 #include "tiki/base/platform.hpp"
 #include "tiki/base/types.hpp"
 #include "tiki/container/array.hpp"
-#include "tiki/container/queue.hpp"
+#include "tiki/container/mpmcqueue.hpp"
+#include "tiki/tasksystem/taskallocator.hpp"
+#include "tiki/tasksystem/taskcontext.hpp"
 #include "tiki/tasksystem/task.hpp"
-#include "tiki/threading/event.hpp"
-#include "tiki/threading/mutex.hpp"
+#include "tiki/tasksystem/taskqueue.hpp"
+#include "tiki/threading/atomic.hpp"
+#include "tiki/threading/fiber.hpp"
 #include "tiki/threading/semaphore.hpp"
 #include "tiki/threading/thread.hpp"
 
 namespace tiki
 {
-	struct Task;
-	class TaskQueue;
+	enum
+	{
+		MaxTaskWorkerPoolCount	= 4u
+	};
+
+	struct TaskWorkerPoolParameters
+	{
+		TaskWorkerPoolParameters()
+		{
+			pName			= "TaskSystem";
+			threadCount		= 0u;
+			priorityMask	= TaskPriorityMask_All;
+
+			threadPriority	= ThreadPriority_Normal;
+			affinityMask	= 0u;
+		}
+
+		// used for the thread names. linux cuts thread names after 15 characters.
+		const char*		pName;
+
+		// 0 takes an even share of the threads which are not claimed by other pools
+		uint			threadCount;
+
+		// TaskPriorityMask flags. workers of this pool only take tasks with one of these priorities.
+		uint32			priorityMask;
+
+		ThreadPriority	threadPriority;
+		uint64			affinityMask;	// 0 = all processors
+	};
 
 	struct TaskSystemParameters
 	{
@@ -25,12 +55,44 @@ namespace tiki
 
 			threadCount		= platform::getProcessorCount();
 			threadStackSize	= 1u * 1024u * 1024u;
+			threadSpinCount	= 1024u;
+
+			poolCount		= 1u;
+
+			scratchAllocatorSize		= 256u * 1024u;
+			fiberScratchAllocatorSize	= 32u * 1024u;
+			frameAllocatorSize			= 1024u * 1024u;
+
+			useFibers		= false;
+			fiberCount		= 64u;
+			fiberStackSize	= 256u * 1024u;
 		}
 
+		// maximum number of queued and running tasks. will be rounded up to the next power of two.
 		uint	maxTaskCount;
 
+		// thread budget shared by all pools
 		uint	threadCount;
 		uint	threadStackSize;
+
+		// number of empty polls before a idle worker goes to sleep
+		uint	threadSpinCount;
+
+		// e.g. a frame critical pool for high and normal priority and a background pool with lower thread priority for
+		// low priority tasks. together the pools must take tasks of all priorities.
+		TaskWorkerPoolParameters	pools[ MaxTaskWorkerPoolCount ];
+		uint						poolCount;
+
+		// every worker and every fiber has an own scratch allocator. allocations above the size fall back to the heap.
+		uint	scratchAllocatorSize;
+		uint	fiberScratchAllocatorSize;
+		uint	frameAllocatorSize;
+
+		// tasks run on fibers. a task which waits for an other task suspends its fiber and the worker continues with
+		// other tasks. when all fibers are in use, tasks run on the worker stack.
+		bool	useFibers;
+		uint	fiberCount;
+		uint	fiberStackSize;
 	};
 
 	class TaskSystem
@@ -45,34 +107,214 @@ namespace tiki
 		bool	create( const TaskSystemParameters& parameters );
 		void	dispose();
 
-		TaskId	queueTask( TaskFunc pFunc, void* pData, TaskId dependingTaskId = InvalidTaskId );
+		// the task starts when all depending tasks are finished. pFunc can be nullptr to create a join for a group of tasks.
+		TaskId	queueTask( TaskFunc pFunc, void* pData, TaskId dependingTaskId = InvalidTaskId, TaskPriority priority = TaskPriority_Normal );
+		TaskId	queueTask( TaskFunc pFunc, void* pData, const TaskId* pDependingTaskIds, uint dependingTaskCount, TaskPriority priority = TaskPriority_Normal );
+
+		// while waiting the calling thread helps with tasks of the same or a higher priority
+		bool	isTaskFinished( TaskId taskId ) const;
 		void	waitForTask( TaskId taskId );
+		void	waitForTasks( const TaskId* pTaskIds, uint taskCount );
 		void	waitForAllTasks();
 
+		// splits [begin, end) in ranges of at least grainSize elements. ranges are only split when other threads run out
+		// of work. the calling thread takes part and the function returns when all ranges are finished.
+		void	parallelFor( uint begin, uint end, uint grainSize, TaskRangeFunc pFunc, void* pData, TaskPriority priority = TaskPriority_Normal );
+
+		// T must be copyable with memcpy. pFunc accumulates a range into result and pCombineFunc appends the result of
+		// the following range to target.
+		template< typename T >
+		T		parallelReduce( uint begin, uint end, uint grainSize, const T& identity, void (*pFunc)( const TaskContext& context, T& result, uint begin, uint end ), void (*pCombineFunc)( T& target, const T& source ), void* pData, TaskPriority priority = TaskPriority_Normal );
+
+		// releases all frame allocations. no task may use frame memory any more.
+		void	endFrame();
+
+		TaskFrameAllocator&	getFrameAllocator() { return m_frameAllocator; }
+
+		uint	getThreadCount() const { return m_threads.getCount(); }
+		uint	getPoolCount() const { return m_pools.getCount(); }
+		uint	getPoolThreadCount( uint poolIndex ) const;
+
+		// the high water mark of a pool is the maximum of its workers
+		void	getPoolScratchStatistics( uint poolIndex, TaskAllocatorStatistics& statistics ) const;
+		void	getFiberScratchStatistics( TaskAllocatorStatistics& statistics ) const;
+		void	getFrameStatistics( TaskAllocatorStatistics& statistics ) const;
+
 	private:
 
+		enum
+		{
+			MaxParallelResultSize	= 64u,
+			MaxParallelSplitCount	= 32u
+		};
+
+		typedef void (*ParallelReduceFunc)( const TaskContext& context, void* pResult, uint begin, uint end );
+		typedef void (*ParallelCombineFunc)( void* pTarget, const void* pSource, void* pData );
+
+		struct TaskSlot
+		{
+			Task				task;
+			TaskPriority		priority;
+			AtomicUInt32		usedByTaskId;
+			AtomicUInt32		finishedTaskId;
+
+			// unfinished depending tasks + 1 while the task is queued
+			AtomicUInt32		dependencyCount;
+
+			// task id in the upper and first continuation in the lower 32 bits
+			AtomicUInt64		continuations;
+			uint32				nextContinuations[ MaxTaskDependencyCount ];
+		};
+
+		struct ParallelData
+		{
+			TaskSystem*				pTaskSystem;
+			TaskRangeFunc			pRangeFunc;
+			ParallelReduceFunc		pReduceFunc;
+			ParallelCombineFunc		pCombineFunc;
+			void*					pData;
+
+			const void*				pIdentity;
+			uint					resultSize;
+			uint					grainSize;
+			TaskPriority			priority;
+		};
+
+		struct ParallelRange
+		{
+			const ParallelData*		pParallelData;
+			uint					begin;
+			uint					end;
+
+			TIKI_ALIGN_PREFIX( 16 ) uint8	result[ MaxParallelResultSize ] TIKI_ALIGN_POSTFIX( 16 );
+		};
+
+		template< typename T >
+		struct ParallelReduceData
+		{
+			void					(*pFunc)( const TaskContext& context, T& result, uint begin, uint end );
+			void					(*pCombineFunc)( T& target, const T& source );
+			void*					pData;
+		};
+
+		enum TaskFiberState
+		{
+			TaskFiberState_Running,
+			TaskFiberState_Waiting,
+			TaskFiberState_Yielded,
+			TaskFiberState_Finished
+		};
+
+		struct TaskFiber;
+
+		struct WorkerPool
+		{
+			char				name[ 32u ];
+			uint32				priorityMask;
+			uint				threadCount;
+
+			ThreadPriority		threadPriority;
+			uint64				affinityMask;
+
+			// idle workers only wake up for tasks they can take
+			Semaphore			sleepSemaphore;
+			AtomicUInt32		sleepingThreadCount;
+		};
+
 		struct ThreadContext
 		{
-			TaskSystem*	pTaskSystem;
+			TaskSystem*			pTaskSystem;
+			WorkerPool*			pPool;
+			uint32				randomState;
+
+			Thread				thread;
+			TaskQueue			queues[ TaskPriority_Count ];
+			TaskScratchAllocator	scratchAllocator;
 
-			Thread		thread;
-			Event		workingEvent;
+			Fiber				schedulerFiber;
+			TaskFiber*			pCurrentFiber;
 		};
 
-		Mutex					m_globalMutex;
-		Semaphore				m_taskCountSemaphore;
+		struct TaskFiber
+		{
+			TaskSystem*			pTaskSystem;
+			ThreadContext*		pThreadContext;
 
-		TaskId					m_nextTaskId;
+			TaskFiberState		state;
+			uint32				slotIndex;
+			TaskId				waitTaskId;
+
+			Fiber				fiber;
+			TaskScratchAllocator	scratchAllocator;
+		};
 
+		Array< TaskSlot >		m_tasks;
+		uint32					m_taskMask;
+		AtomicUInt32			m_nextTaskId;
+		AtomicUInt32			m_pendingTaskCount;
+
+		// tasks queued from threads outside of the task system or from workers which don't take the priority
+		MpmcQueue< uint32 >		m_injectionQueues[ TaskPriority_Count ];
+
+		uint					m_spinCount;
+
+		Array< WorkerPool >		m_pools;
 		Array< ThreadContext >	m_threads;
-		Queue< Task >			m_tasks;
+
+		Array< TaskFiber >		m_fibers;
+		MpmcQueue< TaskFiber* >	m_freeFibers;
+		MpmcQueue< TaskFiber* >	m_readyFibers[ TaskPriority_Count ];
+
+		TaskFrameAllocator		m_frameAllocator;
+
+		static TIKI_THREAD_LOCAL ThreadContext*	s_pCurrentThreadContext;
 
 		static int				staticThreadEntryPoint( const Thread& thread );
 		void					threadEntryPoint( const Thread& thread, ThreadContext& context );
-		void					threadExecuteTask( const Thread& thread, const Task& task );
-		bool					threadDispatchTask( Task& targetTask );
+		void					threadSleep( const Thread& thread, WorkerPool& pool );
+		void					threadWake( TaskPriority priority );
+
+		bool					createPools( const TaskSystemParameters& parameters );
+		ThreadContext*			getCurrentThreadContext() const;
+		TaskScratchAllocator*	getCurrentScratchAllocator( ThreadContext* pContext ) const;
+		uint32					getPriorityMask( const ThreadContext* pContext ) const;
+		bool					hasQueuedTasks( uint32 priorityMask ) const;
+		bool					tryAllocateTaskSlot( TaskSlot& slot, TaskId taskId );
+		bool					tryAddContinuation( TaskId taskId, uint32 continuationSlotIndex, uint dependencyIndex );
+		void					releaseDependency( uint32 slotIndex );
+		void					scheduleTask( uint32 slotIndex );
+
+		bool					findTask( uint32& targetSlotIndex, ThreadContext* pContext, uint32 priorityMask );
+		bool					dispatchInjectedTask( uint32& targetSlotIndex, ThreadContext* pContext, TaskPriority priority );
+		bool					stealTask( uint32& targetSlotIndex, ThreadContext* pContext, TaskPriority priority );
+		void					executeTask( const Thread& thread, uint32 slotIndex, TaskScratchAllocator* pScratchAllocator );
+		void					executeOrIdle( uint& idleCount, uint32 priorityMask );
+
+		bool					createFibers( const TaskSystemParameters& parameters );
+		void					runTask( ThreadContext& context, uint32 slotIndex );
+		void					resumeFiber( ThreadContext& context, TaskFiber* pFiber );
+		void					suspendFiber( ThreadContext& context, TaskFiberState state );
+		TaskFiber*				allocateFiber();
+		void					freeFiber( TaskFiber* pFiber );
+		void					pushReadyFiber( TaskFiber* pFiber );
+		TaskFiber*				popReadyFiber( uint32 priorityMask );
+		static void				resumeFiberTask( const TaskContext& context );
+		static void				fiberEntryPoint( void* pArgument );
+
+		void					parallelRun( const ParallelData& data, uint begin, uint end, void* pResult );
+		void					executeParallelRange( const TaskContext& context, ParallelRange& range );
+		void					initializeParallelRange( ParallelRange& range, const ParallelData& data, uint begin, uint end ) const;
+		bool					shouldSplitParallelRange( TaskPriority priority ) const;
+		static void				parallelRangeTask( const TaskContext& context );
+
+		template< typename T >
+		static void				parallelReduceRange( const TaskContext& context, void* pResult, uint begin, uint end );
+		template< typename T >
+		static void				parallelReduceCombine( void* pTarget, const void* pSource, void* pData );
 
 	};
 }
 
+#include "../../../source/tasksystem.inl"
+
 #endif // TIKI_TASKSYSTEM_HPP_INCLUDED__
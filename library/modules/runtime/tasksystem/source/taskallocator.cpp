@@ -0,0 +1,278 @@
+#include "tiki/tasksystem/taskallocator.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	// heap fallback. the header sits in front of the allocation.
+	struct TaskAllocatorOverflow
+	{
+		TaskAllocatorOverflow*	pNext;
+		uint					sizeInBytes;
+	};
+
+	static TIKI_FORCE_INLINE uint getTaskAllocatorAlignment( uint alignment )
+	{
+		return ( alignment == TIKI_DEFAULT_ALIGNMENT ? TIKI_MINIMUM_ALIGNMENT : alignment );
+	}
+
+	static TIKI_FORCE_INLINE uint64 getTaskAllocatorAlignedOffset( const uint8* pMemory, uint64 offset, uint alignment )
+	{
+		// align the address. the buffer itself isn't aligned on every platform.
+		const uint64 address = uint64( uint( pMemory ) );
+		return alignValue< uint64 >( address + offset, alignment ) - address;
+	}
+
+	static void* allocateTaskAllocatorOverflow( void*& pOverflowList, uint sizeInBytes, uint alignment )
+	{
+		alignment = TIKI_MAX( alignment, (uint)TIKI_MINIMUM_ALIGNMENT );
+
+		const uint headerSize = alignValue( (uint)sizeof( TaskAllocatorOverflow ), alignment );
+		uint8* pBlock = static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( headerSize + sizeInBytes, alignment ) );
+		if ( pBlock == nullptr )
+		{
+			return nullptr;
+		}
+
+		TaskAllocatorOverflow* pOverflow = reinterpret_cast< TaskAllocatorOverflow* >( pBlock );
+		pOverflow->pNext		= static_cast< TaskAllocatorOverflow* >( pOverflowList );
+		pOverflow->sizeInBytes	= sizeInBytes;
+		pOverflowList = pOverflow;
+
+		return pBlock + headerSize;
+	}
+
+	static uint freeTaskAllocatorOverflows( void*& pOverflowList, const void* pEnd )
+	{
+		uint freedSize = 0u;
+		while ( pOverflowList != pEnd )
+		{
+			TaskAllocatorOverflow* pOverflow = static_cast< TaskAllocatorOverflow* >( pOverflowList );
+			pOverflowList = pOverflow->pNext;
+
+			freedSize += pOverflow->sizeInBytes;
+			TIKI_MEMORY_FREE( pOverflow );
+		}
+
+		return freedSize;
+	}
+
+	TaskScratchAllocator::TaskScratchAllocator()
+	{
+		m_pMemory		= nullptr;
+		m_size			= 0u;
+		m_offset		= 0u;
+
+		m_pOverflow		= nullptr;
+		m_overflowSize	= 0u;
+
+		m_highWaterMark	= 0u;
+		m_overflowCount	= 0u;
+	}
+
+	TaskScratchAllocator::~TaskScratchAllocator()
+	{
+		TIKI_ASSERT( m_pMemory == nullptr );
+		TIKI_ASSERT( m_pOverflow == nullptr );
+	}
+
+	bool TaskScratchAllocator::create( uint sizeInBytes )
+	{
+		TIKI_ASSERT( m_pMemory == nullptr );
+
+		if ( sizeInBytes > 0u )
+		{
+			m_pMemory = static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( sizeInBytes, TIKI_CACHE_LINE_SIZE ) );
+			if ( m_pMemory == nullptr )
+			{
+				return false;
+			}
+		}
+
+		m_size			= sizeInBytes;
+		m_offset		= 0u;
+		m_highWaterMark	= 0u;
+		m_overflowCount	= 0u;
+
+		return true;
+	}
+
+	void TaskScratchAllocator::dispose()
+	{
+		m_overflowSize -= freeTaskAllocatorOverflows( m_pOverflow, nullptr );
+
+		if ( m_pMemory != nullptr )
+		{
+			TIKI_MEMORY_FREE( m_pMemory );
+			m_pMemory = nullptr;
+		}
+
+		m_size		= 0u;
+		m_offset	= 0u;
+	}
+
+	void* TaskScratchAllocator::allocate( uint sizeInBytes, uint alignment /*= TIKI_DEFAULT_ALIGNMENT*/ )
+	{
+		alignment = getTaskAllocatorAlignment( alignment );
+
+		void* pMemory = nullptr;
+
+		const uint64 alignedOffset = getTaskAllocatorAlignedOffset( m_pMemory, m_offset, alignment );
+		if ( m_pMemory != nullptr && alignedOffset + sizeInBytes <= m_size )
+		{
+			pMemory		= m_pMemory + alignedOffset;
+			m_offset	= uint( alignedOffset + sizeInBytes );
+		}
+		else
+		{
+			pMemory = allocateTaskAllocatorOverflow( m_pOverflow, sizeInBytes, alignment );
+			if ( pMemory == nullptr )
+			{
+				return nullptr;
+			}
+
+			m_overflowSize += sizeInBytes;
+			m_overflowCount++;
+		}
+
+		m_highWaterMark = TIKI_MAX( m_highWaterMark, m_offset + m_overflowSize );
+		return pMemory;
+	}
+
+	void TaskScratchAllocator::free( void* /*pMemory*/ )
+	{
+	}
+
+	TaskScratchAllocator::Marker TaskScratchAllocator::getMarker() const
+	{
+		Marker marker;
+		marker.offset		= m_offset;
+		marker.pOverflow	= m_pOverflow;
+
+		return marker;
+	}
+
+	void TaskScratchAllocator::freeToMarker( const Marker& marker )
+	{
+		TIKI_ASSERT( marker.offset <= m_offset );
+
+		m_overflowSize -= freeTaskAllocatorOverflows( m_pOverflow, marker.pOverflow );
+		m_offset = marker.offset;
+	}
+
+	void TaskScratchAllocator::getStatistics( TaskAllocatorStatistics& statistics ) const
+	{
+		statistics.sizeInBytes		= m_size;
+		statistics.highWaterMark	= m_highWaterMark;
+		statistics.overflowCount	= m_overflowCount;
+	}
+
+	TaskFrameAllocator::TaskFrameAllocator()
+	{
+		m_pMemory		= nullptr;
+		m_size			= 0u;
+
+		m_pOverflow		= nullptr;
+		m_overflowSize	= 0u;
+		m_overflowCount	= 0u;
+
+		m_highWaterMark	= 0u;
+	}
+
+	TaskFrameAllocator::~TaskFrameAllocator()
+	{
+		TIKI_ASSERT( m_pMemory == nullptr );
+		TIKI_ASSERT( m_pOverflow == nullptr );
+	}
+
+	bool TaskFrameAllocator::create( uint sizeInBytes )
+	{
+		TIKI_ASSERT( m_pMemory == nullptr );
+
+		if ( sizeInBytes > 0u )
+		{
+			m_pMemory = static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( sizeInBytes, TIKI_CACHE_LINE_SIZE ) );
+			if ( m_pMemory == nullptr )
+			{
+				return false;
+			}
+		}
+
+		m_size			= sizeInBytes;
+		m_overflowCount	= 0u;
+		m_highWaterMark	= 0u;
+		m_offset.store( 0u );
+
+		return true;
+	}
+
+	void TaskFrameAllocator::dispose()
+	{
+		m_overflowSize -= freeTaskAllocatorOverflows( m_pOverflow, nullptr );
+
+		if ( m_pMemory != nullptr )
+		{
+			TIKI_MEMORY_FREE( m_pMemory );
+			m_pMemory = nullptr;
+		}
+
+		m_size = 0u;
+	}
+
+	void* TaskFrameAllocator::allocate( uint sizeInBytes, uint alignment /*= TIKI_DEFAULT_ALIGNMENT*/ )
+	{
+		alignment = getTaskAllocatorAlignment( alignment );
+
+		if ( m_pMemory != nullptr )
+		{
+			uint64 offset = m_offset.load( AtomicOrder_Relaxed );
+			while ( offset < m_size )
+			{
+				const uint64 alignedOffset = getTaskAllocatorAlignedOffset( m_pMemory, offset, alignment );
+				if ( m_offset.compareExchange( offset, alignedOffset + sizeInBytes, AtomicOrder_Relaxed ) )
+				{
+					if ( alignedOffset + sizeInBytes <= m_size )
+					{
+						return m_pMemory + alignedOffset;
+					}
+
+					// the rest of the buffer is lost until the next reset
+					break;
+				}
+			}
+		}
+
+		SpinLockStackLock lock( m_overflowLock );
+
+		void* pMemory = allocateTaskAllocatorOverflow( m_pOverflow, sizeInBytes, alignment );
+		if ( pMemory != nullptr )
+		{
+			m_overflowSize += sizeInBytes;
+			m_overflowCount++;
+		}
+
+		return pMemory;
+	}
+
+	void TaskFrameAllocator::free( void* /*pMemory*/ )
+	{
+	}
+
+	void TaskFrameAllocator::reset()
+	{
+		const uint usedSize = uint( TIKI_MIN( m_offset.load(), uint64( m_size ) ) ) + m_overflowSize;
+		m_highWaterMark = TIKI_MAX( m_highWaterMark, usedSize );
+
+		m_overflowSize -= freeTaskAllocatorOverflows( m_pOverflow, nullptr );
+		m_offset.store( 0u );
+	}
+
+	void TaskFrameAllocator::getStatistics( TaskAllocatorStatistics& statistics ) const
+	{
+		statistics.sizeInBytes		= m_size;
+		statistics.highWaterMark	= m_highWaterMark;
+		statistics.overflowCount	= m_overflowCount;
+	}
+}
@@ -0,0 +1,129 @@
+
+#include "tiki/tasksystem/taskqueue.hpp"
+
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	TaskQueue::TaskQueue()
+	{
+		m_pData		= nullptr;
+		m_capacity	= 0u;
+		m_mask		= 0u;
+	}
+
+	TaskQueue::~TaskQueue()
+	{
+		TIKI_ASSERT( m_pData == nullptr );
+	}
+
+	bool TaskQueue::create( uint capacity )
+	{
+		TIKI_ASSERT( m_pData == nullptr );
+		TIKI_ASSERT( isPowerOfTwo( capacity ) );
+
+		m_pData = TIKI_MEMORY_NEW_ARRAY_ALIGNED( AtomicUInt32, capacity, TIKI_CACHE_LINE_SIZE, true );
+		if( m_pData == nullptr )
+		{
+			return false;
+		}
+
+		m_capacity	= capacity;
+		m_mask		= capacity - 1u;
+
+		m_top.store( 0 );
+		m_bottom.store( 0 );
+
+		return true;
+	}
+
+	void TaskQueue::dispose()
+	{
+		if( m_pData != nullptr )
+		{
+			TIKI_MEMORY_DELETE_ARRAY( m_pData, m_capacity );
+			m_pData = nullptr;
+		}
+
+		m_capacity	= 0u;
+		m_mask		= 0u;
+	}
+
+	bool TaskQueue::push( uint32 value )
+	{
+		const sint64 bottom	= m_bottom.load( AtomicOrder_Relaxed );
+		const sint64 top	= m_top.load( AtomicOrder_Acquire );
+		if( bottom - top >= (sint64)m_capacity )
+		{
+			return false;
+		}
+
+		m_pData[ bottom & m_mask ].store( value, AtomicOrder_Relaxed );
+		atomic::fence( AtomicOrder_Release );
+		m_bottom.store( bottom + 1, AtomicOrder_Relaxed );
+
+		return true;
+	}
+
+	bool TaskQueue::pop( uint32& targetValue )
+	{
+		const sint64 bottom = m_bottom.load( AtomicOrder_Relaxed ) - 1;
+		m_bottom.store( bottom, AtomicOrder_Relaxed );
+		atomic::fence( AtomicOrder_SequentialConsistent );
+		sint64 top = m_top.load( AtomicOrder_Relaxed );
+
+		if( top > bottom )
+		{
+			// empty
+			m_bottom.store( bottom + 1, AtomicOrder_Relaxed );
+			return false;
+		}
+
+		targetValue = m_pData[ bottom & m_mask ].load( AtomicOrder_Relaxed );
+		if( top != bottom )
+		{
+			return true;
+		}
+
+		// last element - race against thieves
+		const bool result = m_top.compareExchange( top, top + 1, AtomicOrder_SequentialConsistent );
+		m_bottom.store( bottom + 1, AtomicOrder_Relaxed );
+
+		return result;
+	}
+
+	bool TaskQueue::steal( uint32& targetValue )
+	{
+		sint64 top = m_top.load( AtomicOrder_Acquire );
+		atomic::fence( AtomicOrder_SequentialConsistent );
+		const sint64 bottom = m_bottom.load( AtomicOrder_Acquire );
+
+		if( top >= bottom )
+		{
+			return false;
+		}
+
+		const uint32 value = m_pData[ top & m_mask ].load( AtomicOrder_Relaxed );
+		if( !m_top.compareExchange( top, top + 1, AtomicOrder_SequentialConsistent ) )
+		{
+			return false;
+		}
+
+		targetValue = value;
+		return true;
+	}
+
+	bool TaskQueue::isEmpty() const
+	{
+		return getCount() == 0u;
+	}
+
+	uint TaskQueue::getCount() const
+	{
+		const sint64 bottom	= m_bottom.load( AtomicOrder_Relaxed );
+		const sint64 top	= m_top.load( AtomicOrder_Relaxed );
+
+		return ( bottom > top ? uint( bottom - top ) : 0u );
+	}
+}
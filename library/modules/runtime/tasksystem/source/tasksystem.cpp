@@ -2,13 +2,34 @@
 #include "tiki/tasksystem/tasksystem.hpp"
 
 #include "tiki/base/basicstring.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
 #include "tiki/tasksystem/taskcontext.hpp"
 
 namespace tiki
 {
+	enum
+	{
+		TaskContinuationEmpty	= 0xffffffffu,
+		TaskContinuationClosed	= 0xfffffffeu
+	};
+
+	static TIKI_FORCE_INLINE uint64 createTaskContinuations( TaskId taskId, uint32 firstContinuation )
+	{
+		return ( uint64( taskId ) << 32u ) | firstContinuation;
+	}
+
+	static TIKI_FORCE_INLINE bool isPriorityInMask( uint32 priorityMask, uint priority )
+	{
+		return ( priorityMask & ( 1u << priority ) ) != 0u;
+	}
+
+	TIKI_THREAD_LOCAL TaskSystem::ThreadContext* TaskSystem::s_pCurrentThreadContext = nullptr;
+
 	TaskSystem::TaskSystem()
 	{
-		m_nextTaskId = 0u;
+		m_taskMask	= 0u;
+		m_spinCount	= 0u;
 	}
 
 	TaskSystem::~TaskSystem()
@@ -17,35 +38,102 @@ namespace tiki
 
 	bool TaskSystem::create( const TaskSystemParameters& parameters )
 	{
-		m_nextTaskId = 0u;
+		MemoryTagScope memoryTag( MemoryTag_TaskSystem );
+
+		TIKI_ASSERT( parameters.maxTaskCount > 0u );
+		const uint taskCapacity = getNextPowerOfTwo( parameters.maxTaskCount );
+
+		m_taskMask	= uint32( taskCapacity - 1u );
+		m_spinCount	= parameters.threadSpinCount;
+
+		m_nextTaskId.store( 0u );
+		m_pendingTaskCount.store( 0u );
 
-		m_globalMutex.create();
-		
-		if ( !m_taskCountSemaphore.create() )
+		if ( !m_tasks.create( taskCapacity ) )
 		{
 			dispose();
 			return false;
 		}
 
-		if ( !m_tasks.create( parameters.maxTaskCount ) )
+		for (uint i = 0u; i < m_tasks.getCount(); ++i)
+		{
+			TaskSlot& slot = m_tasks[ i ];
+			slot.usedByTaskId.store( InvalidTaskId );
+			slot.finishedTaskId.store( InvalidTaskId );
+		}
+
+		for (uint i = 0u; i < TaskPriority_Count; ++i)
+		{
+			if ( !m_injectionQueues[ i ].create( taskCapacity ) )
+			{
+				dispose();
+				return false;
+			}
+		}
+
+		if ( !createPools( parameters ) || !m_frameAllocator.create( parameters.frameAllocatorSize ) )
 		{
 			dispose();
 			return false;
 		}
 
-		if ( !m_threads.create( parameters.threadCount ) )
+		uint threadCount = 0u;
+		for (uint i = 0u; i < m_pools.getCount(); ++i)
+		{
+			threadCount += m_pools[ i ].threadCount;
+		}
+
+		if ( !m_threads.create( threadCount ) )
 		{
 			dispose();
 			return false;
 		}
 
+		uint threadIndex = 0u;
+		for (uint poolIndex = 0u; poolIndex < m_pools.getCount(); ++poolIndex)
+		{
+			WorkerPool& pool = m_pools[ poolIndex ];
+			for (uint i = 0u; i < pool.threadCount; ++i, ++threadIndex)
+			{
+				ThreadContext& context = m_threads[ threadIndex ];
+				context.pTaskSystem		= this;
+				context.pPool			= &pool;
+				context.randomState		= uint32( threadIndex + 1u ) * 2654435761u;
+				context.pCurrentFiber	= nullptr;
+
+				for (uint priority = 0u; priority < TaskPriority_Count; ++priority)
+				{
+					if ( !context.queues[ priority ].create( taskCapacity ) )
+					{
+						dispose();
+						return false;
+					}
+				}
+
+				if ( !context.scratchAllocator.create( parameters.scratchAllocatorSize ) )
+				{
+					dispose();
+					return false;
+				}
+			}
+		}
+
+		if ( parameters.useFibers && !createFibers( parameters ) )
+		{
+			dispose();
+			return false;
+		}
+
+		uint poolThreadIndex = 0u;
 		for (uint i = 0u; i < m_threads.getCount(); ++i)
 		{
 			ThreadContext& context = m_threads[ i ];
-			context.pTaskSystem	= this;
-			context.workingEvent.create();
+			if ( i > 0u && context.pPool != m_threads[ i - 1u ].pPool )
+			{
+				poolThreadIndex = 0u;
+			}
 
-			const string threadName = formatString( "TaskSystem_%u", i );
+			const string threadName = formatString( "%s_%u", context.pPool->name, poolThreadIndex++ );
 			if ( !context.thread.create( staticThreadEntryPoint, &context, parameters.threadStackSize, threadName.cStr() ) )
 			{
 				dispose();
@@ -60,82 +148,274 @@ namespace tiki
 	{
 		for (uint i = 0u; i < m_threads.getCount(); ++i)
 		{
-			m_threads[ i ].thread.requestExit();
+			ThreadContext& context = m_threads[ i ];
+			if ( context.thread.isCreated() )
+			{
+				context.thread.requestExit();
+			}
+		}
+
+		// all exit requests must be visible before we wake the threads. otherwise a thread can take the token of an
+		// other thread and go to sleep again.
+		for (uint i = 0u; i < m_threads.getCount(); ++i)
+		{
+			ThreadContext& context = m_threads[ i ];
+			if ( context.thread.isCreated() )
+			{
+				context.pPool->sleepSemaphore.incement();
+			}
 		}
 
 		for (uint i = 0u; i < m_threads.getCount(); ++i)
 		{
 			ThreadContext& context = m_threads[ i ];
 
-			context.thread.waitForExit();
-			context.thread.dispose();
+			if ( context.thread.isCreated() )
+			{
+				context.thread.waitForExit();
+				context.thread.dispose();
+			}
 
-			context.workingEvent.dispose();
+			for (uint priority = 0u; priority < TaskPriority_Count; ++priority)
+			{
+				context.queues[ priority ].dispose();
+			}
+			context.scratchAllocator.dispose();
 		}
 
 		m_threads.dispose();
-		m_tasks.dispose();	
 
-		m_taskCountSemaphore.dispose();
-		m_globalMutex.dispose();
+		for (uint i = 0u; i < m_pools.getCount(); ++i)
+		{
+			m_pools[ i ].sleepSemaphore.dispose();
+		}
+		m_pools.dispose();
+
+		for (uint i = 0u; i < m_fibers.getCount(); ++i)
+		{
+			m_fibers[ i ].fiber.dispose();
+			m_fibers[ i ].scratchAllocator.dispose();
+		}
+		m_fibers.dispose();
+		m_freeFibers.dispose();
+
+		for (uint i = 0u; i < TaskPriority_Count; ++i)
+		{
+			m_readyFibers[ i ].dispose();
+			m_injectionQueues[ i ].dispose();
+		}
+
+		m_frameAllocator.dispose();
+		m_tasks.dispose();
+	}
+
+	TaskId TaskSystem::queueTask( TaskFunc pFunc, void* pData, TaskId dependingTaskId /* = InvalidTaskId */, TaskPriority priority /* = TaskPriority_Normal */ )
+	{
+		return queueTask( pFunc, pData, &dependingTaskId, ( dependingTaskId != InvalidTaskId ? 1u : 0u ), priority );
 	}
 
-	TaskId TaskSystem::queueTask( TaskFunc pFunc, void* pData, TaskId dependingTaskId /* = InvalidTaskId */ )
+	TaskId TaskSystem::queueTask( TaskFunc pFunc, void* pData, const TaskId* pDependingTaskIds, uint dependingTaskCount, TaskPriority priority /* = TaskPriority_Normal */ )
 	{
-		Task task(
-			m_nextTaskId++,
-			dependingTaskId,
-			pFunc,
-			pData
-		);
+		TIKI_ASSERT( pFunc != nullptr || dependingTaskCount > 0u );
+		TIKI_ASSERT( dependingTaskCount <= MaxTaskDependencyCount );
+		TIKI_ASSERT( priority < TaskPriority_Count );
+
+		// ids map directly to slots. when the slot is still in use we skip the id, so a task can queue new tasks
+		// while it is blocking its own slot.
+		TaskId taskId		= InvalidTaskId;
+		uint32 slotIndex	= 0u;
+		uint attemptCount	= 0u;
+		uint idleCount		= 0u;
+		while ( true )
+		{
+			taskId		= m_nextTaskId.fetchAdd( 1u, AtomicOrder_Relaxed );
+			slotIndex	= taskId & m_taskMask;
+
+			if ( taskId != InvalidTaskId && tryAllocateTaskSlot( m_tasks[ slotIndex ], taskId ) )
+			{
+				break;
+			}
+
+			attemptCount++;
+			if ( attemptCount >= m_tasks.getCount() )
+			{
+				// all slots are in use. help to finish tasks. a fiber gives its worker back instead of growing its stack.
+				ThreadContext* pContext = getCurrentThreadContext();
+				if ( pContext != nullptr && pContext->pCurrentFiber != nullptr )
+				{
+					suspendFiber( *pContext, TaskFiberState_Yielded );
+				}
+				else
+				{
+					executeOrIdle( idleCount, getPriorityMask( pContext ) );
+				}
+				attemptCount = 0u;
+			}
+		}
 
-		m_globalMutex.lock();
-		m_tasks.push( task );
-		m_taskCountSemaphore.incement();
-		m_globalMutex.unlock();
+		TaskSlot& slot = m_tasks[ slotIndex ];
+		slot.task		= Task( taskId, pFunc, pData );
+		slot.priority	= priority;
+		slot.continuations.store( createTaskContinuations( taskId, TaskContinuationEmpty ), AtomicOrder_Relaxed );
+		slot.dependencyCount.store( uint32( dependingTaskCount + 1u ), AtomicOrder_Relaxed );
+		m_pendingTaskCount.fetchAdd( 1u, AtomicOrder_Relaxed );
 
-		return task.id;
+		for (uint i = 0u; i < dependingTaskCount; ++i)
+		{
+			if ( !tryAddContinuation( pDependingTaskIds[ i ], slotIndex, i ) )
+			{
+				// already finished
+				slot.dependencyCount.fetchSub( 1u, AtomicOrder_Relaxed );
+			}
+		}
+
+		releaseDependency( slotIndex );
+
+		return taskId;
+	}
+
+	bool TaskSystem::isTaskFinished( TaskId taskId ) const
+	{
+		if ( taskId == InvalidTaskId )
+		{
+			return true;
+		}
+
+		const TaskSlot& slot = m_tasks[ taskId & m_taskMask ];
+		if ( slot.usedByTaskId.load( AtomicOrder_Acquire ) != taskId )
+		{
+			// slot can only be reused after the task has finished
+			return true;
+		}
+
+		return slot.finishedTaskId.load( AtomicOrder_Acquire ) == taskId;
 	}
 
 	void TaskSystem::waitForTask( TaskId taskId )
 	{
-		const Thread& thread = Thread::getCurrentThread();
+		if ( isTaskFinished( taskId ) )
+		{
+			return;
+		}
+
+		// the slot priority can only change after the task has finished
+		const TaskPriority priority = m_tasks[ taskId & m_taskMask ].priority;
 
-		Task task;
-		do
+		ThreadContext* pContext = getCurrentThreadContext();
+		if ( pContext != nullptr && pContext->pCurrentFiber != nullptr )
 		{
-			task = Task();
+			pContext->pCurrentFiber->waitTaskId = taskId;
+			suspendFiber( *pContext, TaskFiberState_Waiting );
 
-			if ( threadDispatchTask( task ) )
+			// the task resumes us while it releases its continuations
+			while ( !isTaskFinished( taskId ) )
 			{
-				threadExecuteTask( thread, task );
+				atomic::pause();
 			}
+
+			return;
+		}
+
+		// helping with less important tasks could delay the task we are waiting for. when nothing more important is
+		// queued the task can still depend on a less important one and without worker threads nobody else runs it.
+		const uint32 poolMask		= getPriorityMask( pContext );
+		const uint32 priorityMask	= poolMask & ( ( 2u << priority ) - 1u );
+
+		uint idleCount = 0u;
+		while ( !isTaskFinished( taskId ) )
+		{
+			executeOrIdle( idleCount, hasQueuedTasks( priorityMask ) ? priorityMask : poolMask );
 		}
-		while ( task.id <= taskId );
 	}
-	
+
+	void TaskSystem::waitForTasks( const TaskId* pTaskIds, uint taskCount )
+	{
+		for (uint i = 0u; i < taskCount; ++i)
+		{
+			waitForTask( pTaskIds[ i ] );
+		}
+	}
+
 	void TaskSystem::waitForAllTasks()
 	{
-		const Thread& thread = Thread::getCurrentThread();
+		const uint32 priorityMask = getPriorityMask( getCurrentThreadContext() );
 
-		Task task;
-		do
+		uint idleCount = 0u;
+		while ( m_pendingTaskCount.load( AtomicOrder_Acquire ) > 0u )
 		{
-			task = Task();
+			executeOrIdle( idleCount, priorityMask );
+		}
+	}
+
+	void TaskSystem::parallelFor( uint begin, uint end, uint grainSize, TaskRangeFunc pFunc, void* pData, TaskPriority priority /* = TaskPriority_Normal */ )
+	{
+		TIKI_ASSERT( pFunc != nullptr );
 
-			if ( threadDispatchTask( task ) )
+		ParallelData data;
+		data.pTaskSystem	= this;
+		data.pRangeFunc		= pFunc;
+		data.pReduceFunc	= nullptr;
+		data.pCombineFunc	= nullptr;
+		data.pData			= pData;
+		data.pIdentity		= nullptr;
+		data.resultSize		= 0u;
+		data.grainSize		= grainSize;
+		data.priority		= priority;
+
+		parallelRun( data, begin, end, nullptr );
+	}
+
+	void TaskSystem::endFrame()
+	{
+		m_frameAllocator.reset();
+	}
+
+	uint TaskSystem::getPoolThreadCount( uint poolIndex ) const
+	{
+		return m_pools[ poolIndex ].threadCount;
+	}
+
+	void TaskSystem::getPoolScratchStatistics( uint poolIndex, TaskAllocatorStatistics& statistics ) const
+	{
+		const WorkerPool* pPool = &m_pools[ poolIndex ];
+
+		statistics = TaskAllocatorStatistics();
+		for (uint i = 0u; i < m_threads.getCount(); ++i)
+		{
+			const ThreadContext& context = m_threads[ i ];
+			if ( context.pPool != pPool )
 			{
-				threadExecuteTask( thread, task );
+				continue;
 			}
+
+			TaskAllocatorStatistics threadStatistics;
+			context.scratchAllocator.getStatistics( threadStatistics );
+
+			statistics.sizeInBytes		= threadStatistics.sizeInBytes;
+			statistics.highWaterMark	= TIKI_MAX( statistics.highWaterMark, threadStatistics.highWaterMark );
+			statistics.overflowCount	+= threadStatistics.overflowCount;
 		}
-		while ( task.id != InvalidTaskId );
+	}
 
-		for (uint i = 0u; i < m_threads.getCount(); ++i)
+	void TaskSystem::getFiberScratchStatistics( TaskAllocatorStatistics& statistics ) const
+	{
+		statistics = TaskAllocatorStatistics();
+		for (uint i = 0u; i < m_fibers.getCount(); ++i)
 		{
-			m_threads[ i ].workingEvent.waitForSignal();
+			TaskAllocatorStatistics fiberStatistics;
+			m_fibers[ i ].scratchAllocator.getStatistics( fiberStatistics );
+
+			statistics.sizeInBytes		= fiberStatistics.sizeInBytes;
+			statistics.highWaterMark	= TIKI_MAX( statistics.highWaterMark, fiberStatistics.highWaterMark );
+			statistics.overflowCount	+= fiberStatistics.overflowCount;
 		}
 	}
 
+	void TaskSystem::getFrameStatistics( TaskAllocatorStatistics& statistics ) const
+	{
+		m_frameAllocator.getStatistics( statistics );
+	}
+
 	/*static*/ int TaskSystem::staticThreadEntryPoint( const Thread& thread )
 	{
 		void* pArgument = thread.getArgument();
@@ -154,44 +434,773 @@ namespace tiki
 
 	void TaskSystem::threadEntryPoint( const Thread& thread, ThreadContext& context )
 	{
-		Task task;
+		s_pCurrentThreadContext = &context;
+
+		WorkerPool& pool = *context.pPool;
+		if ( pool.threadPriority != ThreadPriority_Normal && !Thread::setCurrentThreadPriority( pool.threadPriority ) )
+		{
+			TIKI_TRACE_WARNING( "[tasksystem] Unable to set thread priority of pool '%s'.\n", pool.name );
+		}
+
+		if ( pool.affinityMask != 0u && !Thread::setCurrentThreadAffinityMask( pool.affinityMask ) )
+		{
+			TIKI_TRACE_WARNING( "[tasksystem] Unable to set thread affinity of pool '%s'.\n", pool.name );
+		}
+
+		const bool useFibers = ( m_fibers.getCount() > 0u && context.schedulerFiber.createFromCurrentThread() );
+
+		uint idleCount = 0u;
 		while ( !thread.isExitRequested() )
 		{
-			context.workingEvent.reset();
+			TaskFiber* pFiber = ( useFibers ? popReadyFiber( pool.priorityMask ) : nullptr );
+			if ( pFiber != nullptr )
+			{
+				resumeFiber( context, pFiber );
+				idleCount = 0u;
+				continue;
+			}
+
+			uint32 slotIndex;
+			if ( findTask( slotIndex, &context, pool.priorityMask ) )
+			{
+				runTask( context, slotIndex );
+				idleCount = 0u;
+			}
+			else if ( idleCount < m_spinCount )
+			{
+				atomic::pause();
+				idleCount++;
+			}
+			else
+			{
+				threadSleep( thread, pool );
+				idleCount = 0u;
+			}
+		}
+
+		if ( useFibers )
+		{
+			context.schedulerFiber.dispose();
+		}
+
+		s_pCurrentThreadContext = nullptr;
+	}
+
+	void TaskSystem::threadSleep( const Thread& thread, WorkerPool& pool )
+	{
+		pool.sleepingThreadCount.fetchAdd( 1u );
+
+		// pairs with the fence in threadWake. either we see the new task or the waker sees us.
+		atomic::fence( AtomicOrder_SequentialConsistent );
+
+		if ( hasQueuedTasks( pool.priorityMask ) || thread.isExitRequested() )
+		{
+			// take back our sleep request. when a waker has already taken it, the semaphore is signaled for us.
+			uint32 sleepingCount = pool.sleepingThreadCount.load();
+			while ( sleepingCount > 0u )
+			{
+				if ( pool.sleepingThreadCount.compareExchange( sleepingCount, sleepingCount - 1u ) )
+				{
+					return;
+				}
+			}
+		}
+
+		pool.sleepSemaphore.decrement();
+	}
+
+	void TaskSystem::threadWake( TaskPriority priority )
+	{
+		// make the new task visible before we look for sleeping threads
+		atomic::fence( AtomicOrder_SequentialConsistent );
+
+		// wake one thread of the first pool which takes the task
+		for (uint i = 0u; i < m_pools.getCount(); ++i)
+		{
+			WorkerPool& pool = m_pools[ i ];
+			if ( !isPriorityInMask( pool.priorityMask, priority ) )
+			{
+				continue;
+			}
+
+			uint32 sleepingCount = pool.sleepingThreadCount.load( AtomicOrder_Relaxed );
+			while ( sleepingCount > 0u )
+			{
+				if ( pool.sleepingThreadCount.compareExchange( sleepingCount, sleepingCount - 1u ) )
+				{
+					pool.sleepSemaphore.incement();
+					return;
+				}
+			}
+		}
+	}
+
+	bool TaskSystem::createPools( const TaskSystemParameters& parameters )
+	{
+		TIKI_ASSERT( parameters.poolCount > 0u && parameters.poolCount <= MaxTaskWorkerPoolCount );
+
+		uint claimedThreadCount	= 0u;
+		uint sharingPoolCount	= 0u;
+		for (uint i = 0u; i < parameters.poolCount; ++i)
+		{
+			const TaskWorkerPoolParameters& poolParameters = parameters.pools[ i ];
+			if ( poolParameters.threadCount > 0u )
+			{
+				claimedThreadCount += poolParameters.threadCount;
+			}
+			else
+			{
+				sharingPoolCount++;
+			}
+		}
+
+		if ( claimedThreadCount > parameters.threadCount )
+		{
+			TIKI_TRACE_ERROR( "[tasksystem] Pools need %u threads but the budget is %u threads.\n", claimedThreadCount, parameters.threadCount );
+			return false;
+		}
+
+		if ( !m_pools.create( parameters.poolCount ) )
+		{
+			return false;
+		}
+
+		const uint remainingThreadCount = parameters.threadCount - claimedThreadCount;
+
+		uint sharingPoolIndex	= 0u;
+		uint32 coveredMask		= 0u;
+		for (uint i = 0u; i < m_pools.getCount(); ++i)
+		{
+			const TaskWorkerPoolParameters& poolParameters = parameters.pools[ i ];
+			WorkerPool& pool = m_pools[ i ];
+
+			copyString( pool.name, TIKI_COUNT( pool.name ), poolParameters.pName != nullptr ? poolParameters.pName : "TaskSystem" );
+			pool.priorityMask	= poolParameters.priorityMask & TaskPriorityMask_All;
+			pool.threadCount	= poolParameters.threadCount;
+			pool.threadPriority	= poolParameters.threadPriority;
+			pool.affinityMask	= poolParameters.affinityMask;
+			pool.sleepingThreadCount.store( 0u );
+
+			if ( pool.threadCount == 0u )
+			{
+				pool.threadCount = remainingThreadCount / sharingPoolCount;
+				if ( sharingPoolIndex < remainingThreadCount % sharingPoolCount )
+				{
+					pool.threadCount++;
+				}
+				sharingPoolIndex++;
+			}
+
+			if ( pool.threadCount > 0u )
+			{
+				coveredMask |= pool.priorityMask;
+			}
+
+			if ( !pool.sleepSemaphore.create() )
+			{
+				return false;
+			}
+		}
+
+		// without threads everything runs on the threads which wait for tasks
+		if ( parameters.threadCount > 0u && coveredMask != TaskPriorityMask_All )
+		{
+			TIKI_TRACE_ERROR( "[tasksystem] Not every task priority is taken by a pool with threads.\n" );
+			return false;
+		}
+
+		return true;
+	}
+
+	TaskSystem::ThreadContext* TaskSystem::getCurrentThreadContext() const
+	{
+		ThreadContext* pContext = s_pCurrentThreadContext;
+		if ( pContext != nullptr && pContext->pTaskSystem == this )
+		{
+			return pContext;
+		}
+
+		return nullptr;
+	}
+
+	TaskScratchAllocator* TaskSystem::getCurrentScratchAllocator( ThreadContext* pContext ) const
+	{
+		// fibers can move between threads. a task on a fiber uses the allocator of the fiber.
+		if ( pContext == nullptr )
+		{
+			return nullptr;
+		}
+		else if ( pContext->pCurrentFiber != nullptr )
+		{
+			return &pContext->pCurrentFiber->scratchAllocator;
+		}
+
+		return &pContext->scratchAllocator;
+	}
+
+	uint32 TaskSystem::getPriorityMask( const ThreadContext* pContext ) const
+	{
+		// other threads help with everything while they wait
+		return ( pContext != nullptr ? pContext->pPool->priorityMask : uint32( TaskPriorityMask_All ) );
+	}
+
+	bool TaskSystem::hasQueuedTasks( uint32 priorityMask ) const
+	{
+		for (uint priority = 0u; priority < TaskPriority_Count; ++priority)
+		{
+			if ( !isPriorityInMask( priorityMask, priority ) )
+			{
+				continue;
+			}
+
+			if ( !m_injectionQueues[ priority ].isEmpty() || !m_readyFibers[ priority ].isEmpty() )
+			{
+				return true;
+			}
+
+			for (uint i = 0u; i < m_threads.getCount(); ++i)
+			{
+				if ( !m_threads[ i ].queues[ priority ].isEmpty() )
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool TaskSystem::tryAllocateTaskSlot( TaskSlot& slot, TaskId taskId )
+	{
+		TaskId usedByTaskId = slot.usedByTaskId.load( AtomicOrder_Acquire );
+		if ( slot.finishedTaskId.load( AtomicOrder_Acquire ) != usedByTaskId )
+		{
+			return false;
+		}
+
+		return slot.usedByTaskId.compareExchange( usedByTaskId, taskId, AtomicOrder_AcquireRelease );
+	}
+
+	bool TaskSystem::tryAddContinuation( TaskId taskId, uint32 continuationSlotIndex, uint dependencyIndex )
+	{
+		if ( taskId == InvalidTaskId )
+		{
+			return false;
+		}
+
+		TaskSlot& slot = m_tasks[ taskId & m_taskMask ];
+		TaskSlot& continuationSlot = m_tasks[ continuationSlotIndex ];
+		const uint32 continuation = uint32( continuationSlotIndex * MaxTaskDependencyCount + dependencyIndex );
 
-			if ( threadDispatchTask( task ) )
+		uint64 continuations = slot.continuations.load( AtomicOrder_Acquire );
+		while ( true )
+		{
+			// the task id doesn't match when the slot was already reused
+			const uint32 firstContinuation = uint32( continuations );
+			if ( uint32( continuations >> 32u ) != taskId || firstContinuation == TaskContinuationClosed )
 			{
-				threadExecuteTask( thread, task );
+				return false;
 			}
 
-			context.workingEvent.signal();
+			continuationSlot.nextContinuations[ dependencyIndex ] = firstContinuation;
+			if ( slot.continuations.compareExchange( continuations, createTaskContinuations( taskId, continuation ), AtomicOrder_AcquireRelease ) )
+			{
+				return true;
+			}
+		}
+	}
+
+	void TaskSystem::releaseDependency( uint32 slotIndex )
+	{
+		if ( m_tasks[ slotIndex ].dependencyCount.fetchSub( 1u, AtomicOrder_AcquireRelease ) == 1u )
+		{
+			scheduleTask( slotIndex );
 		}
 	}
 
-	void TaskSystem::threadExecuteTask( const Thread& thread, const Task& task )
+	void TaskSystem::scheduleTask( uint32 slotIndex )
 	{
-		if ( task.dependingTaskId != InvalidTaskId )
+		const TaskPriority priority = m_tasks[ slotIndex ].priority;
+
+		// tasks our pool doesn't take go to the shared queue
+		ThreadContext* pContext = getCurrentThreadContext();
+		if ( pContext == nullptr || !isPriorityInMask( pContext->pPool->priorityMask, priority ) || !pContext->queues[ priority ].push( slotIndex ) )
 		{
-			waitForTask( task.dependingTaskId );
+			// can't fail. the queue has room for all task slots.
+			TIKI_VERIFY( m_injectionQueues[ priority ].tryPush( slotIndex ) );
 		}
 
-		TaskContext context( thread, task.pData );
-		task.pFunc( context );
+		threadWake( priority );
 	}
 
-	bool TaskSystem::threadDispatchTask( Task& targetTask )
+	bool TaskSystem::findTask( uint32& targetSlotIndex, ThreadContext* pContext, uint32 priorityMask )
 	{
-		if ( m_taskCountSemaphore.tryDecrement( 10u ) )
+		for (uint i = 0u; i < TaskPriority_Count; ++i)
+		{
+			if ( !isPriorityInMask( priorityMask, i ) )
+			{
+				continue;
+			}
+
+			const TaskPriority priority = (TaskPriority)i;
+			if ( pContext != nullptr && pContext->queues[ priority ].pop( targetSlotIndex ) )
+			{
+				return true;
+			}
+
+			if ( dispatchInjectedTask( targetSlotIndex, pContext, priority ) )
+			{
+				return true;
+			}
+
+			if ( stealTask( targetSlotIndex, pContext, priority ) )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool TaskSystem::dispatchInjectedTask( uint32& targetSlotIndex, ThreadContext* pContext, TaskPriority priority )
+	{
+		MpmcQueue< uint32 >& injectionQueue = m_injectionQueues[ priority ];
+		if ( !injectionQueue.tryPop( targetSlotIndex ) )
+		{
+			return false;
+		}
+
+		if ( pContext == nullptr || !isPriorityInMask( pContext->pPool->priorityMask, priority ) )
+		{
+			return true;
+		}
+
+		// move a fair share to our own queue. other threads can steal from there without touching the shared queue.
+		const uint shareCount = injectionQueue.getCount() / m_threads.getCount();
+
+		uint dispatchCount = 0u;
+		uint32 slotIndex;
+		while ( dispatchCount < shareCount && injectionQueue.tryPop( slotIndex ) )
+		{
+			TIKI_VERIFY( pContext->queues[ priority ].push( slotIndex ) );
+			dispatchCount++;
+		}
+
+		if ( dispatchCount > 0u )
+		{
+			threadWake( priority );
+		}
+
+		return true;
+	}
+
+	bool TaskSystem::stealTask( uint32& targetSlotIndex, ThreadContext* pContext, TaskPriority priority )
+	{
+		const uint threadCount = m_threads.getCount();
+		if ( threadCount == 0u )
+		{
+			return false;
+		}
+
+		uint startIndex = 0u;
+		if ( pContext != nullptr )
 		{
-			bool result = false;
+			// xorshift to spread thieves over all victims
+			uint32 state = pContext->randomState;
+			state ^= state << 13u;
+			state ^= state >> 17u;
+			state ^= state << 5u;
+			pContext->randomState = state;
+
+			startIndex = state % threadCount;
+		}
 
-			m_globalMutex.lock();
-			TIKI_VERIFY( result = m_tasks.pop( targetTask ) );
-			m_globalMutex.unlock();
+		for (uint i = 0u; i < threadCount; ++i)
+		{
+			ThreadContext& victim = m_threads[ ( startIndex + i ) % threadCount ];
+			if ( &victim == pContext )
+			{
+				continue;
+			}
 
-			return result;
+			if ( victim.queues[ priority ].steal( targetSlotIndex ) )
+			{
+				return true;
+			}
 		}
 
 		return false;
 	}
-}
\ No newline at end of file
+
+	void TaskSystem::executeTask( const Thread& thread, uint32 slotIndex, TaskScratchAllocator* pScratchAllocator )
+	{
+		TaskSlot& slot = m_tasks[ slotIndex ];
+
+		// the slot can be reused as soon as the task is marked as finished
+		const Task task = slot.task;
+
+		if ( task.pFunc != nullptr )
+		{
+			// threads outside of the task system only have the heap fallback
+			TaskScratchAllocator heapScratchAllocator;
+			TaskScratchAllocator& scratchAllocator = ( pScratchAllocator != nullptr ? *pScratchAllocator : heapScratchAllocator );
+
+			// tasks which run while an other task waits on the same allocator are nested
+			const TaskScratchAllocator::Marker marker = scratchAllocator.getMarker();
+
+			TaskContext context( thread, task.pData, &scratchAllocator, &m_frameAllocator );
+			task.pFunc( context );
+
+			scratchAllocator.freeToMarker( marker );
+		}
+
+		// close the list first. no continuation can be added after this point.
+		const uint64 continuations = slot.continuations.exchange( createTaskContinuations( task.id, TaskContinuationClosed ), AtomicOrder_AcquireRelease );
+
+		uint32 continuation = uint32( continuations );
+		while ( continuation != TaskContinuationEmpty )
+		{
+			const uint32 continuationSlotIndex	= continuation / MaxTaskDependencyCount;
+			const uint32 nextContinuation		= m_tasks[ continuationSlotIndex ].nextContinuations[ continuation % MaxTaskDependencyCount ];
+
+			releaseDependency( continuationSlotIndex );
+			continuation = nextContinuation;
+		}
+
+		slot.finishedTaskId.store( task.id, AtomicOrder_Release );
+		m_pendingTaskCount.fetchSub( 1u, AtomicOrder_Release );
+	}
+
+	void TaskSystem::executeOrIdle( uint& idleCount, uint32 priorityMask )
+	{
+		// a suspended fiber can continue on an other thread. don't keep the context.
+		ThreadContext* pContext = getCurrentThreadContext();
+
+		if ( pContext != nullptr && pContext->pCurrentFiber == nullptr && pContext->schedulerFiber.isCreated() )
+		{
+			// we are on the worker stack and can continue fibers from here
+			TaskFiber* pFiber = popReadyFiber( priorityMask );
+			if ( pFiber != nullptr )
+			{
+				resumeFiber( *pContext, pFiber );
+				idleCount = 0u;
+				return;
+			}
+
+			uint32 slotIndex;
+			if ( findTask( slotIndex, pContext, priorityMask ) )
+			{
+				runTask( *pContext, slotIndex );
+				idleCount = 0u;
+				return;
+			}
+		}
+
+		uint32 slotIndex;
+		if ( findTask( slotIndex, pContext, priorityMask ) )
+		{
+			const Thread& thread = ( pContext != nullptr ? pContext->thread : Thread::getCurrentThread() );
+			executeTask( thread, slotIndex, getCurrentScratchAllocator( pContext ) );
+			idleCount = 0u;
+		}
+		else if ( idleCount < m_spinCount )
+		{
+			atomic::pause();
+			idleCount++;
+		}
+		else
+		{
+			Thread::sleepCurrentThread( 0 );
+		}
+	}
+
+	bool TaskSystem::createFibers( const TaskSystemParameters& parameters )
+	{
+		if ( !m_fibers.create( parameters.fiberCount ) ||
+			!m_freeFibers.create( parameters.fiberCount ) )
+		{
+			return false;
+		}
+
+		for (uint i = 0u; i < TaskPriority_Count; ++i)
+		{
+			if ( !m_readyFibers[ i ].create( parameters.fiberCount ) )
+			{
+				return false;
+			}
+		}
+
+		for (uint i = 0u; i < m_fibers.getCount(); ++i)
+		{
+			TaskFiber& fiber = m_fibers[ i ];
+			fiber.pTaskSystem		= this;
+			fiber.pThreadContext	= nullptr;
+			fiber.state				= TaskFiberState_Finished;
+			fiber.slotIndex			= 0u;
+			fiber.waitTaskId		= InvalidTaskId;
+
+			if ( !fiber.fiber.create( fiberEntryPoint, &fiber, parameters.fiberStackSize ) ||
+				!fiber.scratchAllocator.create( parameters.fiberScratchAllocatorSize ) )
+			{
+				return false;
+			}
+
+			TIKI_VERIFY( m_freeFibers.tryPush( &fiber ) );
+		}
+
+		return true;
+	}
+
+	void TaskSystem::runTask( ThreadContext& context, uint32 slotIndex )
+	{
+		TaskFiber* pFiber = ( context.schedulerFiber.isCreated() ? allocateFiber() : nullptr );
+		if ( pFiber == nullptr )
+		{
+			executeTask( context.thread, slotIndex, getCurrentScratchAllocator( &context ) );
+			return;
+		}
+
+		pFiber->slotIndex = slotIndex;
+		resumeFiber( context, pFiber );
+	}
+
+	void TaskSystem::resumeFiber( ThreadContext& context, TaskFiber* pFiber )
+	{
+		TIKI_ASSERT( context.pCurrentFiber == nullptr );
+
+		pFiber->pThreadContext	= &context;
+		pFiber->state			= TaskFiberState_Running;
+		context.pCurrentFiber	= pFiber;
+
+		context.schedulerFiber.switchTo( pFiber->fiber );
+
+		context.pCurrentFiber = nullptr;
+
+		// the fiber is suspended now and can be continued by any thread
+		switch ( pFiber->state )
+		{
+		case TaskFiberState_Waiting:
+			queueTask( resumeFiberTask, pFiber, pFiber->waitTaskId, m_tasks[ pFiber->slotIndex ].priority );
+			break;
+
+		case TaskFiberState_Yielded:
+			{
+				// the fiber waits for a free task slot. run an other task first.
+				uint32 slotIndex;
+				if ( findTask( slotIndex, &context, context.pPool->priorityMask ) )
+				{
+					runTask( context, slotIndex );
+				}
+
+				pushReadyFiber( pFiber );
+			}
+			break;
+
+		case TaskFiberState_Finished:
+			freeFiber( pFiber );
+			break;
+
+		default:
+			TIKI_BREAK( "[tasksystem] invalid fiber state.\n" );
+			break;
+		}
+	}
+
+	void TaskSystem::suspendFiber( ThreadContext& context, TaskFiberState state )
+	{
+		TaskFiber* pFiber = context.pCurrentFiber;
+		TIKI_ASSERT( pFiber != nullptr );
+		TIKI_ASSERT( pFiber->pThreadContext == &context );
+
+		pFiber->state = state;
+		pFiber->fiber.switchTo( context.schedulerFiber );
+
+		// we can continue on an other thread
+		pFiber->waitTaskId = InvalidTaskId;
+	}
+
+	TaskSystem::TaskFiber* TaskSystem::allocateFiber()
+	{
+		TaskFiber* pFiber = nullptr;
+		if ( !m_freeFibers.tryPop( pFiber ) )
+		{
+			return nullptr;
+		}
+
+		return pFiber;
+	}
+
+	void TaskSystem::freeFiber( TaskFiber* pFiber )
+	{
+		TIKI_VERIFY( m_freeFibers.tryPush( pFiber ) );
+	}
+
+	void TaskSystem::pushReadyFiber( TaskFiber* pFiber )
+	{
+		// the slot of a suspended task can't be reused
+		const TaskPriority priority = m_tasks[ pFiber->slotIndex ].priority;
+
+		// every fiber is at most once in the queue
+		TIKI_VERIFY( m_readyFibers[ priority ].tryPush( pFiber ) );
+		threadWake( priority );
+	}
+
+	TaskSystem::TaskFiber* TaskSystem::popReadyFiber( uint32 priorityMask )
+	{
+		for (uint priority = 0u; priority < TaskPriority_Count; ++priority)
+		{
+			TaskFiber* pFiber = nullptr;
+			if ( isPriorityInMask( priorityMask, priority ) && m_readyFibers[ priority ].tryPop( pFiber ) )
+			{
+				return pFiber;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/*static*/ void TaskSystem::resumeFiberTask( const TaskContext& context )
+	{
+		TaskFiber* pFiber = static_cast< TaskFiber* >( context.pTaskData );
+		pFiber->pTaskSystem->pushReadyFiber( pFiber );
+	}
+
+	/*static*/ void TaskSystem::fiberEntryPoint( void* pArgument )
+	{
+		TaskFiber& fiber = *static_cast< TaskFiber* >( pArgument );
+
+		while ( true )
+		{
+			fiber.pTaskSystem->executeTask( fiber.pThreadContext->thread, fiber.slotIndex, &fiber.scratchAllocator );
+
+			// the task can be finished by an other thread than it was started
+			fiber.state = TaskFiberState_Finished;
+			fiber.fiber.switchTo( fiber.pThreadContext->schedulerFiber );
+		}
+	}
+
+	void TaskSystem::parallelRun( const ParallelData& data, uint begin, uint end, void* pResult )
+	{
+		if ( begin >= end )
+		{
+			return;
+		}
+
+		ParallelData runData = data;
+		runData.grainSize = TIKI_MAX( data.grainSize, 1u );
+
+		ParallelRange range;
+		initializeParallelRange( range, runData, begin, end );
+
+		// the calling thread works on the first range like a task
+		ThreadContext* pContext = getCurrentThreadContext();
+		const Thread& thread = ( pContext != nullptr ? pContext->thread : Thread::getCurrentThread() );
+
+		TaskScratchAllocator heapScratchAllocator;
+		TaskScratchAllocator* pScratchAllocator = getCurrentScratchAllocator( pContext );
+		if ( pScratchAllocator == nullptr )
+		{
+			pScratchAllocator = &heapScratchAllocator;
+		}
+
+		const TaskScratchAllocator::Marker marker = pScratchAllocator->getMarker();
+		const TaskContext context( thread, nullptr, pScratchAllocator, &m_frameAllocator );
+		executeParallelRange( context, range );
+		pScratchAllocator->freeToMarker( marker );
+
+		if ( runData.resultSize > 0u )
+		{
+			memory::copy( pResult, range.result, runData.resultSize );
+		}
+	}
+
+	void TaskSystem::executeParallelRange( const TaskContext& taskContext, ParallelRange& range )
+	{
+		const ParallelData& data = *range.pParallelData;
+
+		ParallelRange splitRanges[ MaxParallelSplitCount ];
+		TaskId splitTaskIds[ MaxParallelSplitCount ];
+		uint splitCount = 0u;
+
+		const TaskContext context( taskContext.thread, data.pData, taskContext.pScratchAllocator, taskContext.pFrameAllocator );
+
+		uint begin	= range.begin;
+		uint end	= range.end;
+		while ( begin < end )
+		{
+			const uint count = end - begin;
+			if ( count >= 2u * data.grainSize && splitCount < MaxParallelSplitCount && shouldSplitParallelRange( data.priority ) )
+			{
+				// give the upper half away and continue with the lower half
+				const uint middle = begin + ( count / 2u );
+
+				ParallelRange& splitRange = splitRanges[ splitCount ];
+				initializeParallelRange( splitRange, data, middle, end );
+
+				splitTaskIds[ splitCount ] = queueTask( parallelRangeTask, &splitRange, InvalidTaskId, data.priority );
+				splitCount++;
+
+				end = middle;
+				continue;
+			}
+
+			const uint chunkEnd = begin + TIKI_MIN( count, data.grainSize );
+			if ( data.pRangeFunc != nullptr )
+			{
+				data.pRangeFunc( context, begin, chunkEnd );
+			}
+			else
+			{
+				data.pReduceFunc( context, range.result, begin, chunkEnd );
+			}
+
+			begin = chunkEnd;
+		}
+
+		waitForTasks( splitTaskIds, splitCount );
+
+		if ( data.pCombineFunc != nullptr )
+		{
+			// the last split range directly follows our own range
+			for (uint i = splitCount; i > 0u; --i)
+			{
+				data.pCombineFunc( range.result, splitRanges[ i - 1u ].result, data.pData );
+			}
+		}
+	}
+
+	void TaskSystem::initializeParallelRange( ParallelRange& range, const ParallelData& data, uint begin, uint end ) const
+	{
+		range.pParallelData	= &data;
+		range.begin			= begin;
+		range.end			= end;
+
+		if ( data.resultSize > 0u )
+		{
+			memory::copy( range.result, data.pIdentity, data.resultSize );
+		}
+	}
+
+	bool TaskSystem::shouldSplitParallelRange( TaskPriority priority ) const
+	{
+		if ( m_threads.getCount() == 0u )
+		{
+			return false;
+		}
+
+		// lazy splitting. only split when the last split range was taken by an other thread.
+		ThreadContext* pContext = getCurrentThreadContext();
+		if ( pContext != nullptr && isPriorityInMask( pContext->pPool->priorityMask, priority ) )
+		{
+			return pContext->queues[ priority ].isEmpty();
+		}
+
+		return m_injectionQueues[ priority ].isEmpty();
+	}
+
+	/*static*/ void TaskSystem::parallelRangeTask( const TaskContext& context )
+	{
+		ParallelRange& range = *static_cast< ParallelRange* >( context.pTaskData );
+		range.pParallelData->pTaskSystem->executeParallelRange( context, range );
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+#ifndef TIKI_TASKSYSTEM_INL_INCLUDED__
+#define TIKI_TASKSYSTEM_INL_INCLUDED__
+
+namespace tiki
+{
+	template< typename T >
+	TIKI_FORCE_INLINE T TaskSystem::parallelReduce( uint begin, uint end, uint grainSize, const T& identity, void (*pFunc)( const TaskContext& context, T& result, uint begin, uint end ), void (*pCombineFunc)( T& target, const T& source ), void* pData, TaskPriority priority /* = TaskPriority_Normal */ )
+	{
+		TIKI_COMPILETIME_ASSERT( sizeof( T ) <= MaxParallelResultSize );
+		TIKI_COMPILETIME_ASSERT( TIKI_ALIGNOF( T ) <= 16u );
+		TIKI_ASSERT( pFunc != nullptr );
+		TIKI_ASSERT( pCombineFunc != nullptr );
+
+		ParallelReduceData< T > reduceData;
+		reduceData.pFunc		= pFunc;
+		reduceData.pCombineFunc	= pCombineFunc;
+		reduceData.pData		= pData;
+
+		ParallelData data;
+		data.pTaskSystem	= this;
+		data.pRangeFunc		= nullptr;
+		data.pReduceFunc	= &parallelReduceRange< T >;
+		data.pCombineFunc	= &parallelReduceCombine< T >;
+		data.pData			= &reduceData;
+		data.pIdentity		= &identity;
+		data.resultSize		= sizeof( T );
+		data.grainSize		= grainSize;
+		data.priority		= priority;
+
+		T result = identity;
+		parallelRun( data, begin, end, &result );
+
+		return result;
+	}
+
+	template< typename T >
+	/*static*/ void TaskSystem::parallelReduceRange( const TaskContext& context, void* pResult, uint begin, uint end )
+	{
+		const ParallelReduceData< T >& reduceData = *static_cast< const ParallelReduceData< T >* >( context.pTaskData );
+
+		const TaskContext reduceContext( context.thread, reduceData.pData, context.pScratchAllocator, context.pFrameAllocator );
+		reduceData.pFunc( reduceContext, *static_cast< T* >( pResult ), begin, end );
+	}
+
+	template< typename T >
+	/*static*/ void TaskSystem::parallelReduceCombine( void* pTarget, const void* pSource, void* pData )
+	{
+		const ParallelReduceData< T >& reduceData = *static_cast< const ParallelReduceData< T >* >( pData );
+		reduceData.pCombineFunc( *static_cast< T* >( pTarget ), *static_cast< const T* >( pSource ) );
+	}
+}
+
+#endif // TIKI_TASKSYSTEM_INL_INCLUDED__
@@ -0,0 +1,11 @@
+-- library/modules/tool/benchmark
+
+local module = Module:new( "benchmark" );
+
+module:add_files( "include/**/*.*" );
+module:add_files( "source/*.*" );
+module:add_files( "benchmark.lua" );
+module:add_include_dir( "include" );
+
+module:add_dependency( "base" );
+module:add_dependency( "toolbase" );
@@ -0,0 +1,43 @@
+#pragma once
+#ifndef TIKI_BENCHMARK_HPP_INCLUDED
+#define TIKI_BENCHMARK_HPP_INCLUDED
+
+#include "tiki/base/types.hpp"
+
+namespace tiki
+{
+	typedef void(*BenchmarkFunction)();
+
+	namespace benchmark
+	{
+		void	beginBenchmark( const char* pName );
+		void	addBenchmark( const char* pTitle, BenchmarkFunction pFunc );
+
+		// monotonic high resolution time in seconds
+		double	getTime();
+
+		void	addResult( const char* pName, uint64 itemCount, double seconds );
+
+		// keeps the optimizer from removing the measured work
+		void	useValue( uint64 value );
+
+		int		run();
+	}
+}
+
+#define TIKI_BENCHMARK_PREMAINCODE( name, code ) static struct TIKI_CONCAT( BenchmarkCode, name ) { TIKI_CONCAT( BenchmarkCode, name )() { code } } TIKI_CONCAT( s_benchmarkVar, name )
+
+#define TIKI_BEGIN_BENCHMARK( name ) TIKI_BENCHMARK_PREMAINCODE( name, benchmark::beginBenchmark( #name ); )
+
+#define TIKI_ADD_BENCHMARK( func_name )	\
+	void func_name();					\
+	TIKI_BENCHMARK_PREMAINCODE(			\
+		func_name,						\
+		benchmark::addBenchmark(		\
+			#func_name,					\
+			func_name					\
+		);								\
+	);									\
+	void func_name()
+
+#endif // TIKI_BENCHMARK_HPP_INCLUDED
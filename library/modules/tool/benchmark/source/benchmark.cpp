@@ -0,0 +1,110 @@
+
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/assert.hpp"
+#include "tiki/container/list.hpp"
+
+#if TIKI_ENABLED( TIKI_PLATFORM_WIN )
+#	include <windows.h>
+#elif TIKI_ENABLED( TIKI_PLATFORM_LINUX )
+#	include <time.h>
+#endif
+
+namespace tiki
+{
+	struct Benchmark
+	{
+		const char*			pTitle;
+		BenchmarkFunction	pFunc;
+	};
+
+	struct BenchmarkGroup
+	{
+		const char*			pName;
+		List< Benchmark >	benchmarks;
+	};
+
+	struct BenchmarkSystem
+	{
+		List< BenchmarkGroup >	groups;
+		volatile uint64			valueSink;
+	};
+
+	BenchmarkSystem& getBenchmarkSystem()
+	{
+		static BenchmarkSystem system;
+		return system;
+	}
+
+	void benchmark::beginBenchmark( const char* pName )
+	{
+		BenchmarkGroup& group = getBenchmarkSystem().groups.add();
+		group.pName = pName;
+	}
+
+	void benchmark::addBenchmark( const char* pTitle, BenchmarkFunction pFunc )
+	{
+		Benchmark& benchmark = getBenchmarkSystem().groups.getLast().benchmarks.add();
+		benchmark.pTitle	= pTitle;
+		benchmark.pFunc		= pFunc;
+	}
+
+	double benchmark::getTime()
+	{
+#if TIKI_ENABLED( TIKI_PLATFORM_WIN )
+		LARGE_INTEGER frequency;
+		LARGE_INTEGER counter;
+		QueryPerformanceFrequency( &frequency );
+		QueryPerformanceCounter( &counter );
+
+		return double( counter.QuadPart ) / double( frequency.QuadPart );
+#elif TIKI_ENABLED( TIKI_PLATFORM_LINUX )
+		timespec time;
+		clock_gettime( CLOCK_MONOTONIC, &time );
+
+		return double( time.tv_sec ) + ( double( time.tv_nsec ) * 1e-9 );
+#endif
+	}
+
+	void benchmark::addResult( const char* pName, uint64 itemCount, double seconds )
+	{
+		const double nanoSecondsPerItem	= ( itemCount > 0u ? ( seconds * 1e9 ) / double( itemCount ) : 0.0 );
+		const double itemsPerSecond		= ( seconds > 0.0 ? double( itemCount ) / seconds : 0.0 );
+
+		debug::trace( "\t\t%-48s %12.3f ms %12.2f ns/item %16.0f items/s\n", pName, seconds * 1000.0, nanoSecondsPerItem, itemsPerSecond );
+	}
+
+	void benchmark::useValue( uint64 value )
+	{
+		getBenchmarkSystem().valueSink += value;
+	}
+
+	int benchmark::run()
+	{
+		debug::trace( "Start Benchmarks...\n" );
+
+		BenchmarkSystem& system = getBenchmarkSystem();
+		List< BenchmarkGroup >& groups = system.groups;
+		for (uint i = 0u; i < groups.getCount(); ++i)
+		{
+			const BenchmarkGroup& group = groups[ i ];
+
+			debug::trace( "Run Benchmark: %s\n", group.pName );
+			for (uint j = 0u; j < group.benchmarks.getCount(); ++j)
+			{
+				const Benchmark& currentBenchmark = group.benchmarks[ j ];
+				debug::trace( "\t%s:\n", currentBenchmark.pTitle );
+
+				const double startTime = getTime();
+				currentBenchmark.pFunc();
+				debug::trace( "\tfinished in %.3f s\n", getTime() - startTime );
+			}
+		}
+
+		groups.dispose();
+
+		debug::trace( "\nBenchmarks finished.\n" );
+		debug::trace( "=====================================\n" );
+		return 0;
+	}
+}
@@ -39,7 +39,10 @@ namespace tiki
 		void						closeResourceWriter( ResourceWriter& writer ) const;
 
 		TaskId						queueTask( TaskFunc pFunc, void* pData, TaskId dependingTaskId = InvalidTaskId ) const;
+		TaskId						queueTask( TaskFunc pFunc, void* pData, const TaskId* pDependingTaskIds, uint dependingTaskCount ) const;
 		void						waitForTask( TaskId taskId ) const;
+		void						waitForTasks( const TaskId* pTaskIds, uint taskCount ) const;
+		TaskSystem*					getTaskSystem() const;
 
 		List< ResourceDefinition >	getResourceDefinitions() const;
 
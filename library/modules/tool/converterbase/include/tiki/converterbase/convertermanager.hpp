@@ -3,7 +3,11 @@
 #define TIKI_CONVERTERMANAGER_HPP
 
 #include "tiki/base/string.hpp"
+#include "tiki/base/stringid.hpp"
 #include "tiki/base/types.hpp"
+#include "tiki/base/virtualmemoryallocator.hpp"
+#include "tiki/base/zoneallocator.hpp"
+#include "tiki/container/hashmap.hpp"
 #include "tiki/container/list.hpp"
 #include "tiki/container/map.hpp"
 #include "tiki/container/staticarray.hpp"
@@ -27,6 +31,7 @@ namespace tiki
 		ConverterManagerParameter()
 		{
 			pChangedFilesList	= nullptr;
+			pTaskSystem			= nullptr;
 
 			forceRebuild		= false;
 		}
@@ -36,6 +41,9 @@ namespace tiki
 
 		List< string >*	pChangedFilesList;
 
+		// conversion runs with low priority on this task system. nullptr creates an own task system.
+		TaskSystem*		pTaskSystem;
+
 		bool			forceRebuild;
 	};
 
@@ -61,7 +69,10 @@ namespace tiki
 
 		// task system
 		TaskId					queueTask( TaskFunc pFunc, void* pData, TaskId dependingTaskId = InvalidTaskId );
+		TaskId					queueTask( TaskFunc pFunc, void* pData, const TaskId* pDependingTaskIds, uint dependingTaskCount );
 		void					waitForTask( TaskId taskId );
+		void					waitForTasks( const TaskId* pTaskIds, uint taskCount );
+		TaskSystem&				getTaskSystem() { return *m_pTaskSystem; }
 
 		// misc
 		const string&			getSourcePath() const { return m_sourcePath; }
@@ -82,11 +93,11 @@ namespace tiki
 		struct TemplateDescription
 		{
 			string					fullFileName;
-			string					name;
+			StringId				name;
 
 			Map< string, string >	arguments;
 		};
-		typedef Map< string, TemplateDescription > TemplateMap;
+		typedef HashMap< StringId, TemplateDescription > TemplateMap;
 
 		struct ConversionTask
 		{
@@ -99,7 +110,7 @@ namespace tiki
 			TaskId					taskId;
 		};
 
-		typedef Map< uint64, ConversionResult* > ThreadResultMap;
+		typedef HashMap< uint64, ConversionResult* > ThreadResultMap;
 
 		string						m_sourcePath;
 		string						m_outputPath;
@@ -116,10 +127,17 @@ namespace tiki
 		ConverterList				m_converters;
 
 		List< string >				m_files;
+		VirtualMemoryAllocator		m_filesMemory;
 		List< string >*				m_pChangedFilesList;
 
 		TaskSystem					m_taskSystem;
+		TaskSystem*					m_pTaskSystem;
 		List< ConversionTask >		m_tasks;
+		VirtualMemoryAllocator		m_tasksMemory;
+
+		// temporary lists of prepareTasks and generateTaskFromFiles. released in one step after each conversion.
+		ZoneAllocator				m_buildAllocator;
+		VirtualMemoryAllocator		m_filesToBuildMemory;
 
 		void						traceCallback( const char* message, TraceLevel level ) const;
 		void						parseParams( const XmlReader& xmlFile, const _XmlElement* pRoot, Map< string, string >& arguments ) const;
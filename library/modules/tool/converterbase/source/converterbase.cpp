@@ -73,6 +73,13 @@ namespace tiki
 		return m_pManager->queueTask( pFunc, pData, dependingTaskId );
 	}
 
+	TaskId ConverterBase::queueTask( TaskFunc pFunc, void* pData, const TaskId* pDependingTaskIds, uint dependingTaskCount ) const
+	{
+		TIKI_ASSERT( m_pManager != nullptr );
+
+		return m_pManager->queueTask( pFunc, pData, pDependingTaskIds, dependingTaskCount );
+	}
+
 	void ConverterBase::waitForTask( TaskId taskId ) const
 	{
 		TIKI_ASSERT( m_pManager != nullptr );
@@ -80,6 +87,20 @@ namespace tiki
 		m_pManager->waitForTask( taskId );
 	}
 
+	void ConverterBase::waitForTasks( const TaskId* pTaskIds, uint taskCount ) const
+	{
+		TIKI_ASSERT( m_pManager != nullptr );
+
+		m_pManager->waitForTasks( pTaskIds, taskCount );
+	}
+
+	TaskSystem* ConverterBase::getTaskSystem() const
+	{
+		TIKI_ASSERT( m_pManager != nullptr );
+
+		return &m_pManager->getTaskSystem();
+	}
+
 	List< ResourceDefinition > ConverterBase::getResourceDefinitions() const
 	{
 		List< ResourceDefinition > definitions;
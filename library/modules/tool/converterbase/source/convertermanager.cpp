@@ -3,6 +3,7 @@
 
 #include "tiki/base/autodispose.hpp"
 #include "tiki/base/crc32.hpp"
+#include "tiki/base/memory.hpp"
 #include "tiki/io/directory.hpp"
 #include "tiki/io/file.hpp"
 #include "tiki/io/path.hpp"
@@ -23,6 +24,10 @@ namespace tiki
 		s_pInstance->traceCallback( message, level );
 	}
 
+	// address space for the lists which grow with the size of the content tree. only used pages take memory.
+	static const uint s_fileListReservedSize	= 32u * 1024u * 1024u;
+	static const uint s_taskListReservedSize	= 256u * 1024u * 1024u;
+
 	static string escapeString( const string& text )
 	{
 		return text.replace( "'", "''" ).replace( "\"", "\"\"" );
@@ -35,13 +40,42 @@ namespace tiki
 
 	void ConverterManager::create( const ConverterManagerParameter& parameters )
 	{
+		MemoryTagScope memoryTag( MemoryTag_Converter );
+
 		m_sourcePath		= parameters.sourcePath;
 		m_outputPath		= parameters.outputPath;
 		m_pChangedFilesList	= parameters.pChangedFilesList;
 		m_rebuildForced		= parameters.forceRebuild;
 
-		TaskSystemParameters taskParameters;
-		m_taskSystem.create( taskParameters );
+		m_pTaskSystem = parameters.pTaskSystem;
+		if ( m_pTaskSystem == nullptr )
+		{
+			TaskSystemParameters taskParameters;
+			taskParameters.pools[ 0u ].pName			= "Converter";
+			taskParameters.pools[ 0u ].threadPriority	= ThreadPriority_Low;
+
+			m_taskSystem.create( taskParameters );
+			m_pTaskSystem = &m_taskSystem;
+		}
+
+		if ( !m_buildAllocator.create( 64u * 1024u ) )
+		{
+			TIKI_TRACE_ERROR( "[convertermanager] Could not create build allocator.\n" );
+		}
+
+		// the lists grow without moving, so running tasks can point into m_tasks. without a reserved range the lists
+		// fall back to the heap.
+		if ( m_filesMemory.create( s_fileListReservedSize ) )
+		{
+			m_files.setAllocator( &m_filesMemory );
+		}
+
+		if ( m_tasksMemory.create( s_taskListReservedSize ) )
+		{
+			m_tasks.setAllocator( &m_tasksMemory );
+		}
+
+		m_filesToBuildMemory.create( s_fileListReservedSize );
 
 		if ( !directory::exists( m_outputPath.cStr() ) )
 		{
@@ -109,11 +143,22 @@ namespace tiki
 		debug::setTraceCallback( nullptr );
 
 		m_taskSystem.dispose();
+		m_pTaskSystem = nullptr;
 
 		m_loggingStream.dispose();
 		m_loggingMutex.dispose();
 
 		m_dataBase.dispose();
+
+		m_files.dispose();
+		m_tasks.dispose();
+		m_files.setAllocator( nullptr );
+		m_tasks.setAllocator( nullptr );
+
+		m_filesMemory.dispose();
+		m_tasksMemory.dispose();
+		m_filesToBuildMemory.dispose();
+		m_buildAllocator.dispose();
 	}
 
 	void ConverterManager::addTemplate( const string& fileName )
@@ -132,7 +177,7 @@ namespace tiki
 
 		TemplateDescription desc;
 		desc.fullFileName	= path::getAbsolutePath( fileName );
-		desc.name			= pAttName->content;
+		desc.name			= StringId( pAttName->content );
 
 		// parse arguments
 		parseParams( xmlFile, pRoot, desc.arguments );
@@ -149,6 +194,12 @@ namespace tiki
 
 	bool ConverterManager::startConversion( Mutex* pConversionMutex /* = nullptr */ )
 	{
+		if ( !m_buildAllocator.isCreated() )
+		{
+			TIKI_TRACE_ERROR( "[convertermanager] Conversion failed because the build allocator could not be created.\n" );
+			return false;
+		}
+
 		if ( !prepareTasks() )
 		{
 			return false;
@@ -160,7 +211,11 @@ namespace tiki
 			task.taskId = queueTask( taskConvertFile, &task );
 		}
 
-		m_taskSystem.waitForAllTasks();
+		// a shared task system can have other tasks in flight
+		for (uint i = 0u; i < m_tasks.getCount(); ++i)
+		{
+			waitForTask( m_tasks[ i ].taskId );
+		}
 
 		return finalizeTasks();
 	}
@@ -177,12 +232,22 @@ namespace tiki
 
 	TaskId ConverterManager::queueTask( TaskFunc pFunc, void* pData, TaskId dependingTaskId /*= InvalidTaskId */ )
 	{
-		return m_taskSystem.queueTask( pFunc, pData, dependingTaskId );
+		return m_pTaskSystem->queueTask( pFunc, pData, dependingTaskId, TaskPriority_Low );
+	}
+
+	TaskId ConverterManager::queueTask( TaskFunc pFunc, void* pData, const TaskId* pDependingTaskIds, uint dependingTaskCount )
+	{
+		return m_pTaskSystem->queueTask( pFunc, pData, pDependingTaskIds, dependingTaskCount, TaskPriority_Low );
 	}
 
 	void ConverterManager::waitForTask( TaskId taskId )
 	{
-		m_taskSystem.waitForTask( taskId );
+		m_pTaskSystem->waitForTask( taskId );
+	}
+
+	void ConverterManager::waitForTasks( const TaskId* pTaskIds, uint taskCount )
+	{
+		m_pTaskSystem->waitForTasks( pTaskIds, taskCount );
 	}
 
 	void ConverterManager::traceCallback( const char* message, TraceLevel level ) const
@@ -239,8 +304,10 @@ namespace tiki
 
 	bool ConverterManager::prepareTasks()
 	{
+		ZoneAllocatorScope allocatorScope( m_buildAllocator );
 		List< FileDescription > filesToBuild;
-		List< string > filesFromDependencies;
+		filesToBuild.setAllocator( m_filesToBuildMemory.isCreated() ? &m_filesToBuildMemory : nullptr );
+		List< string > filesFromDependencies( m_buildAllocator );
 
 		for (uint i = 0u; i < m_files.getCount(); ++i)
 		{
@@ -321,7 +388,9 @@ namespace tiki
 
 	bool ConverterManager::generateTaskFromFiles( const List< FileDescription >& filesToBuild )
 	{
-		List< ConversionTask > tasks;
+		ZoneAllocatorScope allocatorScope( m_buildAllocator );
+		List< ConversionTask > tasks( m_buildAllocator );
+		tasks.reserve( filesToBuild.getCount() );
 
 		bool result = true;
 		for (uint fileIndex = 0u; fileIndex < filesToBuild.getCount(); ++fileIndex )
@@ -477,12 +546,13 @@ namespace tiki
 		const XmlAttribute* pTemplate = xmlFile.findAttributeByName( "template", pRoot );
 		if ( pTemplate != nullptr )
 		{
-			TemplateDescription desc;
-			if ( m_templates.findValue( &desc, pTemplate->content ) )
+			// doesn't intern unknown names
+			const TemplateDescription* pDesc = m_templates.find( StringId::find( pTemplate->content ) );
+			if ( pDesc != nullptr )
 			{
-				for (uint i = 0u; i < desc.arguments.getCount(); ++i)
+				for (uint i = 0u; i < pDesc->arguments.getCount(); ++i)
 				{
-					KeyValuePair< string, string >& kvp = desc.arguments.getPairAt( i );
+					const KeyValuePair< string, string >& kvp = pDesc->arguments.getPairAt( i );
 
 					task.parameters.arguments.getMap().set( kvp.key, kvp.value );
 				}
@@ -503,7 +573,8 @@ namespace tiki
 		bool result = true;
 
 		string whereFileName;
-		Map< string, ConversionTask* > tasksByFileName;
+		HashMap< string, ConversionTask* > tasksByFileName;
+		tasksByFileName.reserve( tasks.getCount() );
 		for (uint i = 0u; i < tasks.getCount(); ++i)
 		{
 			ConversionTask& task = tasks[ i ];
@@ -628,7 +699,8 @@ namespace tiki
 		}
 
 		string whereAssetId;
-		Map< uint, ConversionTask* > tasksByAssetId;
+		HashMap< uint, ConversionTask* > tasksByAssetId;
+		tasksByAssetId.reserve( tasks.getCount() );
 		for (uint i = 0u; i < tasks.getCount(); ++i)
 		{
 			ConversionTask& task = tasks[ i ];
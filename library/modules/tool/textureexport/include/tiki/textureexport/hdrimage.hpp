@@ -8,7 +8,7 @@
 
 namespace tiki
 {
-
+	class TaskSystem;
 	struct uint2;
 	struct uint4;
 
@@ -47,8 +47,8 @@ namespace tiki
 
 		float*			getData() { return m_data.getBegin(); }
 
-		void			resizeImage( uint width, uint height );
-		void			resizeImage( const uint2& size );
+		void			resizeImage( uint width, uint height, TaskSystem* pTaskSystem = nullptr );
+		void			resizeImage( const uint2& size, TaskSystem* pTaskSystem = nullptr );
 		void			cropImage( const uint4& rect );
 		void			covertGamma( GammaType gammaType );
 		void			flipImage( FlipDirection direction );
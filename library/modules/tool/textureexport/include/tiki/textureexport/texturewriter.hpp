@@ -10,6 +10,7 @@ namespace tiki
 {
 	class HdrImage;
 	class ResourceWriter;
+	class TaskSystem;
 
 	struct TextureWriterParameters
 	{
@@ -38,6 +39,8 @@ namespace tiki
 			targetApi		= GraphicsApi_Invalid;
 
 			mipMapCount		= 0u;
+
+			pTaskSystem		= nullptr;
 		}
 
 		TextureType	targetType;
@@ -46,6 +49,9 @@ namespace tiki
 		
 		uint		mipMapCount;
 
+		// optional, mip levels are converted in parallel
+		TaskSystem*	pTaskSystem;
+
 		union
 		{
 			Texture1dData	texture1d;
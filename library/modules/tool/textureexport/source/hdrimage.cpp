@@ -3,8 +3,12 @@
 
 #include "tiki/base/assert.hpp"
 #include "tiki/base/float32.hpp"
+#include "tiki/base/simdkernels.hpp"
 #include "tiki/container/sizedarray.hpp"
 #include "tiki/graphics/color.hpp"
+#include "tiki/tasksystem/taskcontext.hpp"
+#include "tiki/tasksystem/tasksystem.hpp"
+#include "tiki/threading/thread.hpp"
 
 #include "libpsd.h"
 
@@ -12,109 +16,50 @@
 
 namespace tiki
 {
-	void HdrImage::create( const size_t width, const size_t height, GammaType gamma /*= GammaType_Linear */ )
-	{
-		m_gammaType	= gamma;
-
-		m_width		= width;
-		m_height	= height;
-
-		m_data.create( width * height * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
-		memory::zero( m_data.getBegin(), m_data.getCount() * sizeof( float ) );
-	}
-
-	void HdrImage::createFromImage( const HdrImage& imageToCopy )
-	{
-		m_gammaType	= imageToCopy.m_gammaType;
-
-		m_width		= imageToCopy.m_width;
-		m_height	= imageToCopy.m_height;
-
-		m_data.create( imageToCopy.m_data.getBegin(), imageToCopy.m_data.getCount(), TIKI_DEFAULT_ALIGNMENT, false );
-	}
-
-	bool HdrImage::createFromFile( const char* pFileName )
+	enum
 	{
-		psd_context* pContext	= nullptr;
-		psd_status status		= psd_image_load( &pContext, (psd_char*)pFileName );
-
-		if ( status != psd_status_done )
-		{
-			TIKI_TRACE_ERROR( "input file can't parse: %s\n", pFileName );
-			return false;
-		}
-
-		status = psd_image_blend( pContext, 0, 0, pContext->width, pContext->height );
-
-		if ( status != psd_status_done )
-		{
-			TIKI_TRACE_ERROR( "psd blending failed\n" );
-			return false;
-		}
-
-		m_gammaType = ( pContext->color_mode == psd_color_mode_rgb ? GammaType_SRGB : GammaType_Linear );
-		m_width		= pContext->width;
-		m_height	= pContext->height;
+		HdrImageConvertChunkPixelCount	= 1024u
+	};
 
-		m_data.create( m_width * m_height * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
-
-		const uint8* pPixelData = (const uint8*)pContext->blending_image_data;
-		for (size_t i = 0u; i < m_data.getCount(); ++i)
-		{
-			m_data[ i ] = (float)pPixelData[ i ] / 255.0f;
-		}
-
-		psd_image_free( pContext );
-
-		return true;
-	}
-
-	void HdrImage::dispose()
+	struct HdrImageResizeData
 	{
-		m_data.dispose();
-	}
+		const HdrColor*	pSourceData;
+		HdrColor*		pTargetData;
 
-	void HdrImage::resizeImage( const uint2& scale )
-	{
-		resizeImage( scale.x, scale.y );
-	}
+		uint			sourceWidth;
+		uint			sourceHeight;
+		uint			targetWidth;
+		uint			targetHeight;
+	};
 
-	void HdrImage::resizeImage( uint targetWidth, uint targetHeight )
+	static void resizeImageRows( const TaskContext& context, uint beginY, uint endY )
 	{
-		if ( targetWidth == m_width && targetHeight == m_height )
-		{
-			return;
-		}
-
-		Array< float > tempImage;
-		tempImage.create( targetWidth * targetHeight * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
+		const HdrImageResizeData& data = *static_cast< const HdrImageResizeData* >( context.pTaskData );
 
 		// source: http://paint-mono.googlecode.com/svn/trunk/src/PdnLib/Surface.cs
-		HdrColor* pSourceData = static_cast< HdrColor* >( static_cast< void* >( m_data.getBegin() ) );
-
-		for (uint dstY = 0u; dstY < targetHeight; ++dstY)
+		for (uint dstY = beginY; dstY < endY; ++dstY)
 		{
-			double srcTop = (double)( dstY * m_height ) / (double)targetHeight;
+			double srcTop = (double)( dstY * data.sourceHeight ) / (double)data.targetHeight;
 			double srcTopFloor = floor( srcTop );
 			double srcTopWeight = 1 - (srcTop - srcTopFloor);
 			int srcTopInt = (int)srcTopFloor;
 
-			double srcBottom = (double)((dstY + 1) * m_height) / (double)targetHeight;
+			double srcBottom = (double)((dstY + 1) * data.sourceHeight) / (double)data.targetHeight;
 			double srcBottomFloor = floor( srcBottom - 0.00001 );
 			double srcBottomWeight = srcBottom - srcBottomFloor;
 			int srcBottomInt = (int)srcBottomFloor;
 
-			const uint destRowIndex = ( dstY * targetWidth );
-			HdrColor* pDest = (HdrColor*)&tempImage[ destRowIndex * ChannelCount ];
+			const uint destRowIndex = ( dstY * data.targetWidth );
+			HdrColor* pDest = &data.pTargetData[ destRowIndex ];
 
-			for (uint dstX = 0u; dstX < targetWidth; ++dstX)
+			for (uint dstX = 0u; dstX < data.targetWidth; ++dstX)
 			{
-				double srcLeft = (double)(dstX * m_width) / (double)targetWidth;
+				double srcLeft = (double)(dstX * data.sourceWidth) / (double)data.targetWidth;
 				double srcLeftFloor = floor( srcLeft );
 				double srcLeftWeight = 1.0 - ( srcLeft - srcLeftFloor );
 				int srcLeftInt = (int)srcLeftFloor;
 
-				double srcRight = (double)((dstX + 1) * m_width) / (double)targetWidth;
+				double srcRight = (double)((dstX + 1) * data.sourceWidth) / (double)data.targetWidth;
 				double srcRightFloor = floor( srcRight - 0.00001 );
 				double srcRightWeight = srcRight - srcRightFloor;
 				int srcRightInt = (int)srcRightFloor;
@@ -125,8 +70,8 @@ namespace tiki
 				double alphaSum = 0;
 
 				// left fractional edge
-				const uint sourceLeftIndex = ( ( srcTopInt + 1u ) * m_width ) + srcLeftInt;
-				HdrColor* pSourceLeft = &pSourceData[ sourceLeftIndex ];
+				const uint sourceLeftIndex = ( ( srcTopInt + 1u ) * data.sourceWidth ) + srcLeftInt;
+				const HdrColor* pSourceLeft = &data.pSourceData[ sourceLeftIndex ];
 
 				for (int srcY = srcTopInt + 1; srcY < srcBottomInt; ++srcY)
 				{
@@ -135,12 +80,12 @@ namespace tiki
 					greenSum	+= pSourceLeft->g * srcLeftWeight * a;
 					redSum		+= pSourceLeft->r * srcLeftWeight * a;
 					alphaSum	+= pSourceLeft->a * srcLeftWeight;
-					pSourceLeft  += m_width;
+					pSourceLeft  += data.sourceWidth;
 				}
 
 				// right fractional edge
-				const uint sourceRightIndex = ( ( srcTopInt + 1u ) * m_width ) + srcRightInt;
-				HdrColor* pSourceRight = &pSourceData[ sourceRightIndex ];
+				const uint sourceRightIndex = ( ( srcTopInt + 1u ) * data.sourceWidth ) + srcRightInt;
+				const HdrColor* pSourceRight = &data.pSourceData[ sourceRightIndex ];
 				for (int srcY = srcTopInt + 1; srcY < srcBottomInt; ++srcY)
 				{
 					double a		 = pSourceRight->a;
@@ -148,12 +93,12 @@ namespace tiki
 					greenSum		+= pSourceRight->g * srcRightWeight * a;
 					redSum			+= pSourceRight->r * srcRightWeight * a;
 					alphaSum		+= pSourceRight->a * srcRightWeight;
-					pSourceRight	+= m_width;
+					pSourceRight	+= data.sourceWidth;
 				}
 
 				// top fractional edge
-				const uint sourceTopIndex = ( srcTopInt * m_width ) + ( srcLeftInt + 1u );
-				HdrColor* pSourceTop = &pSourceData[ sourceTopIndex ];
+				const uint sourceTopIndex = ( srcTopInt * data.sourceWidth ) + ( srcLeftInt + 1u );
+				const HdrColor* pSourceTop = &data.pSourceData[ sourceTopIndex ];
 				for (int srcX = srcLeftInt + 1; srcX < srcRightInt; ++srcX)
 				{
 					double a	 = pSourceTop->a;
@@ -165,8 +110,8 @@ namespace tiki
 				}
 
 				// bottom fractional edge
-				const uint sourceBottomIndex = ( srcBottomInt * m_width ) + ( srcLeftInt + 1u );
-				HdrColor* pSourceBottom = &pSourceData[ sourceBottomIndex ];
+				const uint sourceBottomIndex = ( srcBottomInt * data.sourceWidth ) + ( srcLeftInt + 1u );
+				const HdrColor* pSourceBottom = &data.pSourceData[ sourceBottomIndex ];
 				for (int srcX = srcLeftInt + 1; srcX < srcRightInt; ++srcX)
 				{
 					double a	 = pSourceBottom->a;
@@ -180,8 +125,8 @@ namespace tiki
 				// center area
 				for (int srcY = srcTopInt + 1; srcY < srcBottomInt; ++srcY)
 				{
-					const uint sourceIndex = ( srcY * m_width ) + ( srcLeftInt + 1u );
-					HdrColor* pSource = &pSourceData[ sourceIndex ];
+					const uint sourceIndex = ( srcY * data.sourceWidth ) + ( srcLeftInt + 1u );
+					const HdrColor* pSource = &data.pSourceData[ sourceIndex ];
 
 					for (int srcX = srcLeftInt + 1; srcX < srcRightInt; ++srcX)
 					{
@@ -195,28 +140,28 @@ namespace tiki
 				}
 
 				// four corner pixels
-				HdrColor srcTL = pSourceData[ (srcTopInt * m_width ) + srcLeftInt ];
+				HdrColor srcTL = data.pSourceData[ (srcTopInt * data.sourceWidth ) + srcLeftInt ];
 				double srcTLA	 = srcTL.a;
 				blueSum			+= srcTL.b * (srcTopWeight * srcLeftWeight) * srcTLA;
 				greenSum		+= srcTL.g * (srcTopWeight * srcLeftWeight) * srcTLA;
 				redSum			+= srcTL.r * (srcTopWeight * srcLeftWeight) * srcTLA;
 				alphaSum		+= srcTL.a * (srcTopWeight * srcLeftWeight);
 
-				HdrColor srcTR = pSourceData[ (srcTopInt * m_width ) + srcRightInt ];
+				HdrColor srcTR = data.pSourceData[ (srcTopInt * data.sourceWidth ) + srcRightInt ];
 				double srcTRA	 = srcTR.a;
 				blueSum			+= srcTR.b * (srcTopWeight * srcRightWeight) * srcTRA;
 				greenSum		+= srcTR.g * (srcTopWeight * srcRightWeight) * srcTRA;
 				redSum			+= srcTR.r * (srcTopWeight * srcRightWeight) * srcTRA;
 				alphaSum		+= srcTR.a * (srcTopWeight * srcRightWeight);
 
-				HdrColor srcBL = pSourceData[ (srcBottomInt * m_width ) + srcLeftInt ];
+				HdrColor srcBL = data.pSourceData[ (srcBottomInt * data.sourceWidth ) + srcLeftInt ];
 				double srcBLA	 = srcBL.a;
 				blueSum			+= srcBL.b * (srcBottomWeight * srcLeftWeight) * srcBLA;
 				greenSum		+= srcBL.g * (srcBottomWeight * srcLeftWeight) * srcBLA;
 				redSum			+= srcBL.r * (srcBottomWeight * srcLeftWeight) * srcBLA;
 				alphaSum		+= srcBL.a * (srcBottomWeight * srcLeftWeight);
 
-				HdrColor srcBR = pSourceData[ (srcBottomInt * m_width ) + srcRightInt ];
+				HdrColor srcBR = data.pSourceData[ (srcBottomInt * data.sourceWidth ) + srcRightInt ];
 				double srcBRA	 = srcBR.a;
 				blueSum			+= srcBR.b * (srcBottomWeight * srcRightWeight) * srcBRA;
 				greenSum		+= srcBR.g * (srcBottomWeight * srcRightWeight) * srcBRA;
@@ -256,6 +201,102 @@ namespace tiki
 				++pDest;
 			}
 		}
+	}
+
+	void HdrImage::create( const size_t width, const size_t height, GammaType gamma /*= GammaType_Linear */ )
+	{
+		m_gammaType	= gamma;
+
+		m_width		= width;
+		m_height	= height;
+
+		m_data.create( width * height * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
+		memory::zero( m_data.getBegin(), m_data.getCount() * sizeof( float ) );
+	}
+
+	void HdrImage::createFromImage( const HdrImage& imageToCopy )
+	{
+		m_gammaType	= imageToCopy.m_gammaType;
+
+		m_width		= imageToCopy.m_width;
+		m_height	= imageToCopy.m_height;
+
+		m_data.create( imageToCopy.m_data.getBegin(), imageToCopy.m_data.getCount(), TIKI_DEFAULT_ALIGNMENT, false );
+	}
+
+	bool HdrImage::createFromFile( const char* pFileName )
+	{
+		psd_context* pContext	= nullptr;
+		psd_status status		= psd_image_load( &pContext, (psd_char*)pFileName );
+
+		if ( status != psd_status_done )
+		{
+			TIKI_TRACE_ERROR( "input file can't parse: %s\n", pFileName );
+			return false;
+		}
+
+		status = psd_image_blend( pContext, 0, 0, pContext->width, pContext->height );
+
+		if ( status != psd_status_done )
+		{
+			TIKI_TRACE_ERROR( "psd blending failed\n" );
+			return false;
+		}
+
+		m_gammaType = ( pContext->color_mode == psd_color_mode_rgb ? GammaType_SRGB : GammaType_Linear );
+		m_width		= pContext->width;
+		m_height	= pContext->height;
+
+		m_data.create( m_width * m_height * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
+
+		const uint8* pPixelData = (const uint8*)pContext->blending_image_data;
+		for (size_t i = 0u; i < m_data.getCount(); ++i)
+		{
+			m_data[ i ] = (float)pPixelData[ i ] / 255.0f;
+		}
+
+		psd_image_free( pContext );
+
+		return true;
+	}
+
+	void HdrImage::dispose()
+	{
+		m_data.dispose();
+	}
+
+	void HdrImage::resizeImage( const uint2& scale, TaskSystem* pTaskSystem /*= nullptr*/ )
+	{
+		resizeImage( scale.x, scale.y, pTaskSystem );
+	}
+
+	void HdrImage::resizeImage( uint targetWidth, uint targetHeight, TaskSystem* pTaskSystem /*= nullptr*/ )
+	{
+		if ( targetWidth == m_width && targetHeight == m_height )
+		{
+			return;
+		}
+
+		Array< float > tempImage;
+		tempImage.create( targetWidth * targetHeight * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
+
+		HdrImageResizeData data;
+		data.pSourceData	= static_cast< const HdrColor* >( static_cast< const void* >( m_data.getBegin() ) );
+		data.pTargetData	= static_cast< HdrColor* >( static_cast< void* >( tempImage.getBegin() ) );
+		data.sourceWidth	= uint( m_width );
+		data.sourceHeight	= uint( m_height );
+		data.targetWidth	= targetWidth;
+		data.targetHeight	= targetHeight;
+
+		if ( pTaskSystem != nullptr )
+		{
+			pTaskSystem->parallelFor( 0u, targetHeight, 4u, resizeImageRows, &data );
+		}
+		else
+		{
+			const TaskContext context( Thread::getCurrentThread(), &data );
+			resizeImageRows( context, 0u, targetHeight );
+		}
 
 		m_data.swap( tempImage );
 		tempImage.dispose();
@@ -358,33 +399,68 @@ namespace tiki
 		tempImage.dispose();
 	}
 
+	// red and blue are swapped in the target formats. the kernels convert the swizzled chunk while it is in the cache.
+	static void swizzleHdrImageChunk( float* pTarget, const float* pSource, uint pixelCount )
+	{
+		for (uint i = 0u; i < pixelCount * HdrImage::ChannelCount; i += HdrImage::ChannelCount)
+		{
+			pTarget[ i + 0u ] = pSource[ i + 2u ];
+			pTarget[ i + 1u ] = pSource[ i + 1u ];
+			pTarget[ i + 2u ] = pSource[ i + 0u ];
+			pTarget[ i + 3u ] = pSource[ i + 3u ];
+		}
+	}
+
 	void HdrImage::convertTo( Array< uint8 >& target, const PixelFormat targetFormat ) const
 	{
+		const SimdKernels& kernels	= simd::getKernels();
+		const uint pixelCount		= m_width * m_height;
+
+		float aChunk[ HdrImageConvertChunkPixelCount * ChannelCount ];
+
 		switch ( targetFormat )
 		{
 		case PixelFormat_R8:
 			{
-				target.create( m_width * m_height, TIKI_DEFAULT_ALIGNMENT, false );
+				target.create( pixelCount, TIKI_DEFAULT_ALIGNMENT, false );
 				uint8* pTargetData = (uint8*)target.getBegin();
 
-				for (size_t i = 0u; i < m_data.getCount(); i += ChannelCount)
+				for (uint pixelIndex = 0u; pixelIndex < pixelCount; pixelIndex += HdrImageConvertChunkPixelCount)
 				{
-					pTargetData[ i / ChannelCount ] = (uint8)(m_data[ i ] * 255.0f);
+					const uint chunkPixelCount = ( pixelCount - pixelIndex < HdrImageConvertChunkPixelCount ? pixelCount - pixelIndex : HdrImageConvertChunkPixelCount );
+					for (uint i = 0u; i < chunkPixelCount; ++i)
+					{
+						aChunk[ i ] = m_data[ ( pixelIndex + i ) * ChannelCount ];
+					}
+
+					kernels.pPackUnorm8( pTargetData + pixelIndex, aChunk, chunkPixelCount );
 				}
 			}
 			break;
 		case PixelFormat_R8G8B8A8:
 		case PixelFormat_R8G8B8A8_Gamma:
 			{
-				target.create( m_width * m_height * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
+				target.create( pixelCount * ChannelCount, TIKI_DEFAULT_ALIGNMENT, false );
 				uint8* pTargetData = (uint8*)target.getBegin();
 
-				for (size_t i = 0u; i < m_data.getCount(); i += ChannelCount)
+				for (uint pixelIndex = 0u; pixelIndex < pixelCount; pixelIndex += HdrImageConvertChunkPixelCount)
+				{
+					const uint chunkPixelCount = ( pixelCount - pixelIndex < HdrImageConvertChunkPixelCount ? pixelCount - pixelIndex : HdrImageConvertChunkPixelCount );
+					swizzleHdrImageChunk( aChunk, &m_data[ pixelIndex * ChannelCount ], chunkPixelCount );
+					kernels.pPackUnorm8( pTargetData + pixelIndex * ChannelCount, aChunk, chunkPixelCount * ChannelCount );
+				}
+			}
+			break;
+		case PixelFormat_R16G16B16A16_Float:
+			{
+				target.create( pixelCount * ChannelCount * sizeof( float16 ), TIKI_DEFAULT_ALIGNMENT, false );
+				float16* pTargetData = (float16*)target.getBegin();
+
+				for (uint pixelIndex = 0u; pixelIndex < pixelCount; pixelIndex += HdrImageConvertChunkPixelCount)
 				{
-					pTargetData[ i + 0u ] = (uint8)(m_data[ i + 2u ] * 255.0f);
-					pTargetData[ i + 1u ] = (uint8)(m_data[ i + 1u ] * 255.0f);
-					pTargetData[ i + 2u ] = (uint8)(m_data[ i + 0u ] * 255.0f);
-					pTargetData[ i + 3u ] = (uint8)(m_data[ i + 3u ] * 255.0f);
+					const uint chunkPixelCount = ( pixelCount - pixelIndex < HdrImageConvertChunkPixelCount ? pixelCount - pixelIndex : HdrImageConvertChunkPixelCount );
+					swizzleHdrImageChunk( aChunk, &m_data[ pixelIndex * ChannelCount ], chunkPixelCount );
+					kernels.pConvertFloat32ToFloat16( pTargetData + pixelIndex * ChannelCount, aChunk, chunkPixelCount * ChannelCount );
 				}
 			}
 			break;
@@ -4,12 +4,50 @@
 #include "tiki/converterbase/resourcewriter.hpp"
 #include "tiki/graphics/texturedescription.hpp"
 #include "tiki/math/basetypes.hpp"
+#include "tiki/tasksystem/taskcontext.hpp"
+#include "tiki/tasksystem/tasksystem.hpp"
 #include "tiki/textureexport/hdrimage.hpp"
+#include "tiki/threading/thread.hpp"
 
 #include "base.hpp"
 
 namespace tiki
 {
+	struct TextureWriterMipLevel
+	{
+		uint4			sourceRect;
+		uint			width;
+		uint			height;
+	};
+
+	struct TextureWriterMipData
+	{
+		const HdrImage*					pImage;
+		TaskSystem*						pTaskSystem;
+		const TextureWriterMipLevel*	pLevels;
+		Array< uint8 >*					pBitmaps;
+		PixelFormat						format;
+	};
+
+	static void convertMipLevels( const TaskContext& context, uint begin, uint end )
+	{
+		const TextureWriterMipData& data = *static_cast< const TextureWriterMipData* >( context.pTaskData );
+
+		for (uint i = begin; i < end; ++i)
+		{
+			const TextureWriterMipLevel& level = data.pLevels[ i ];
+
+			HdrImage mipImage;
+			mipImage.createFromImage( *data.pImage );
+			mipImage.cropImage( level.sourceRect );
+			mipImage.resizeImage( level.width, level.height, data.pTaskSystem );
+			//mipImage.flipImage( HdrImage::FlipDirection_Vertical );
+
+			mipImage.convertTo( data.pBitmaps[ i ], data.format );
+			mipImage.dispose();
+		}
+	}
+
 	TextureWriter::TextureWriter()
 	{
 		m_pImage = nullptr;
@@ -130,20 +168,60 @@ namespace tiki
 			createUint4( sourceRects.add(), sliceWidth * 3, sliceHeight * 1, sliceWidth, sliceHeight );	// z-
 		}
 
+		// convert the mip levels in parallel and write them in order. only one batch of bitmaps is alive at a time.
+		List< TextureWriterMipLevel > mipLevels;
+
 		uint width	= m_description.width;
 		uint height	= m_description.height;
 		for (uint mipLevel = 0u; mipLevel < m_description.mipCount; ++mipLevel)
 		{
 			for (uint sourceRectIndex = 0u; sourceRectIndex < sourceRects.getCount(); ++sourceRectIndex)
 			{
-				HdrImage mipImage;
-				mipImage.createFromImage( *m_pImage );
-				mipImage.cropImage( sourceRects[ sourceRectIndex ] );
-				mipImage.resizeImage( width, height );
-				//mipImage.flipImage( HdrImage::FlipDirection_Vertical );
+				TextureWriterMipLevel& level = mipLevels.add();
+				level.sourceRect	= sourceRects[ sourceRectIndex ];
+				level.width			= width;
+				level.height		= height;
 
-				Array< uint8 > bitmap;
-				mipImage.convertTo( bitmap, format );
+				if ( m_parameters.targetType == TextureType_3d )
+				{
+					sourceRectIndex += mipLevel;
+				}
+			}
+
+			width	= TIKI_MAX( width / 2u, 1u );
+			height	= TIKI_MAX( height / 2u, 1u );
+		}
+
+		const uint batchSize = ( m_parameters.pTaskSystem != nullptr ? m_parameters.pTaskSystem->getThreadCount() + 1u : 1u );
+
+		Array< Array< uint8 > > bitmaps;
+		bitmaps.create( TIKI_MIN( batchSize, mipLevels.getCount() ) );
+
+		TextureWriterMipData mipData;
+		mipData.pImage			= m_pImage;
+		mipData.pTaskSystem		= m_parameters.pTaskSystem;
+		mipData.pBitmaps		= bitmaps.getBegin();
+		mipData.format			= format;
+
+		for (uint batchBegin = 0u; batchBegin < mipLevels.getCount(); batchBegin += bitmaps.getCount())
+		{
+			const uint batchCount = TIKI_MIN( bitmaps.getCount(), mipLevels.getCount() - batchBegin );
+			mipData.pLevels = mipLevels.getBegin() + batchBegin;
+
+			if ( m_parameters.pTaskSystem != nullptr )
+			{
+				m_parameters.pTaskSystem->parallelFor( 0u, batchCount, 1u, convertMipLevels, &mipData );
+			}
+			else
+			{
+				const TaskContext context( Thread::getCurrentThread(), &mipData );
+				convertMipLevels( context, 0u, batchCount );
+			}
+
+			for (uint batchIndex = 0u; batchIndex < batchCount; ++batchIndex)
+			{
+				const TextureWriterMipLevel& level = mipData.pLevels[ batchIndex ];
+				Array< uint8 >& bitmap = bitmaps[ batchIndex ];
 
 				switch ( m_parameters.targetApi )
 				{
@@ -155,9 +233,9 @@ namespace tiki
 				case GraphicsApi_Vulkan:
 					{
 						const uint bytesPerPixel = getBitsPerPixel( format ) / 8u;
-						const uint bytesPerLine = bytesPerPixel * width;
+						const uint bytesPerLine = bytesPerPixel * level.width;
 
-						for (uint y = height - 1u; y < height; --y)
+						for (uint y = level.height - 1u; y < level.height; --y)
 						{
 							const uint8* pSourceData = bitmap.getBegin() + (bytesPerLine * y);
 							writer.writeData( pSourceData, bytesPerLine );
@@ -169,19 +247,11 @@ namespace tiki
 					TIKI_TRACE_ERROR( "[TextureWriter] Graphics API not supported.\n" );
 					break;
 				}
-				
-				bitmap.dispose();
-				mipImage.dispose();
 
-				if ( m_parameters.targetType == TextureType_3d )
-				{
-					sourceRectIndex += mipLevel;
-				}
+				bitmap.dispose();
 			}
-
-			width	= TIKI_MAX( width / 2u, 1u );
-			height	= TIKI_MAX( height / 2u, 1u );
 		}
+		bitmaps.dispose();
 
 		writer.closeDataSection();
 
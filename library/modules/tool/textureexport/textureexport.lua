@@ -8,3 +8,4 @@ module:add_files( "textureexport.lua" );
 module:add_include_dir( "include" );
 
 module:add_dependency( "libpsd" );
+module:add_dependency( "tasksystem" );
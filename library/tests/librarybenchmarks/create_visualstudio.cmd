@@ -0,0 +1,5 @@
+@echo off
+cd project
+..\..\..\buildtools\premake\premake5.exe /outpath=../build vs2015
+cd ..
+pause
\ No newline at end of file
@@ -0,0 +1,23 @@
+-- library/tests/librarybenchmarks
+
+local module = Module:new( "librarybenchmarks" );
+
+module:add_files( "source/*.*" );
+module:add_files( "librarybenchmarks.lua" );
+
+module:add_dependency( "config" );
+module:add_dependency( "base" );
+module:add_dependency( "container" );
+module:add_dependency( "math" );
+module:add_dependency( "threading" );
+module:add_dependency( "tasksystem" );
+module:add_dependency( "benchmark" );
+
+local project = Project:new(
+	"librarybenchmarks",
+	"3f0c5a2e-8d4b-4b1e-9a67-2c1d7e5b9f04",
+	{ "x32", "x64" },
+	{ "Debug", "Release" },
+	module,
+	ProjectTypes.consoleApplication
+);
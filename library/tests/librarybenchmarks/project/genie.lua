@@ -0,0 +1,5 @@
+-- library/tests/librarybenchmarks/project
+
+include "../../../buildtools/genie_scripts"
+
+finalize( "benchmarks", { find_project( "librarybenchmarks" ) } );
@@ -0,0 +1,158 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/container/list.hpp"
+#include "tiki/math/boundingvolumehierarchy.hpp"
+#include "tiki/math/camera.hpp"
+#include "tiki/math/quaternion.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( BoundingVolumeHierarchy );
+
+	enum
+	{
+		BoundingVolumeHierarchyBenchmarkQueryCount	= 64u
+	};
+
+	static float getBoundingVolumeHierarchyBenchmarkValue( uint32& state )
+	{
+		state = state * 1664525u + 1013904223u;
+		return float( state >> 8u ) / float( 1u << 24u ) * 2.0f - 1.0f;
+	}
+
+	static bool isBoundingVolumeHierarchyBenchmarkOverlapping( const AxisAlignedBox& box1, const AxisAlignedBox& box2 )
+	{
+		return box1.min.x <= box2.max.x && box1.min.y <= box2.max.y && box1.min.z <= box2.max.z &&
+			box2.min.x <= box1.max.x && box2.min.y <= box1.max.y && box2.min.z <= box1.max.z;
+	}
+
+	TIKI_ADD_BENCHMARK( BoundingVolumeHierarchyScene )
+	{
+		// the world grows with the object count, so the density and the size of the query results stay the same
+		const uint counts[]		= { 10000u, 100000u, 1000000u };
+		const float ranges[]	= { 100.0f, 215.0f, 464.0f };
+
+		char resultName[ 128u ];
+		for (uint countIndex = 0u; countIndex < TIKI_COUNT( counts ); ++countIndex)
+		{
+			const uint count	= counts[ countIndex ];
+			const float range	= ranges[ countIndex ];
+
+			AxisAlignedBox* pBoxes	= TIKI_MEMORY_NEW_ARRAY( AxisAlignedBox, count, false );
+			uint32* pProxyIds		= TIKI_MEMORY_NEW_ARRAY( uint32, count, false );
+
+			uint32 state = 9u;
+			for (uint i = 0u; i < count; ++i)
+			{
+				const Vector3 center = vector::create( getBoundingVolumeHierarchyBenchmarkValue( state ) * range, getBoundingVolumeHierarchyBenchmarkValue( state ) * range, getBoundingVolumeHierarchyBenchmarkValue( state ) * range );
+				pBoxes[ i ].createFromCenterExtends( center, Vector3::one );
+			}
+
+			BoundingVolumeHierarchy hierarchy;
+			TIKI_VERIFY( hierarchy.create( 0.5f, count ) );
+
+			double startTime = benchmark::getTime();
+			for (uint i = 0u; i < count; ++i)
+			{
+				pProxyIds[ i ] = hierarchy.addProxy( pBoxes[ i ], &pBoxes[ i ] );
+			}
+			double time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "bvh insert, %u objects", count );
+			benchmark::addResult( resultName, count, time );
+			benchmark::useValue( hierarchy.getHeight() );
+
+			// most objects move a little and stay in their fat box, a few jump further
+			uint movedCount = 0u;
+			startTime = benchmark::getTime();
+			for (uint i = 0u; i < count; ++i)
+			{
+				const float distance = ( i % 16u == 0u ? 4.0f : 0.2f );
+				const Vector3 offset = vector::create( getBoundingVolumeHierarchyBenchmarkValue( state ) * distance, getBoundingVolumeHierarchyBenchmarkValue( state ) * distance, getBoundingVolumeHierarchyBenchmarkValue( state ) * distance );
+				pBoxes[ i ].translate( offset );
+
+				movedCount += hierarchy.moveProxy( pProxyIds[ i ], pBoxes[ i ] );
+			}
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "bvh move, %u objects", count );
+			benchmark::addResult( resultName, count, time );
+			benchmark::useValue( movedCount );
+
+			AxisAlignedBox aQueryBoxes[ BoundingVolumeHierarchyBenchmarkQueryCount ];
+			for (uint i = 0u; i < TIKI_COUNT( aQueryBoxes ); ++i)
+			{
+				const Vector3 center = vector::create( getBoundingVolumeHierarchyBenchmarkValue( state ) * range, getBoundingVolumeHierarchyBenchmarkValue( state ) * range, getBoundingVolumeHierarchyBenchmarkValue( state ) * range );
+				aQueryBoxes[ i ].createFromCenterExtends( center, vector::create( 10.0f, 10.0f, 10.0f ) );
+			}
+
+			List< void* > results;
+			results.reserve( count );
+
+			startTime = benchmark::getTime();
+			for (uint i = 0u; i < TIKI_COUNT( aQueryBoxes ); ++i)
+			{
+				results.clear();
+				hierarchy.queryBox( results, aQueryBoxes[ i ] );
+				benchmark::useValue( results.getCount() );
+			}
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "bvh box query, %u objects", count );
+			benchmark::addResult( resultName, TIKI_COUNT( aQueryBoxes ), time );
+
+			startTime = benchmark::getTime();
+			for (uint i = 0u; i < TIKI_COUNT( aQueryBoxes ); ++i)
+			{
+				results.clear();
+				for (uint j = 0u; j < count; ++j)
+				{
+					if( isBoundingVolumeHierarchyBenchmarkOverlapping( pBoxes[ j ], aQueryBoxes[ i ] ) )
+					{
+						results.add( &pBoxes[ j ] );
+					}
+				}
+				benchmark::useValue( results.getCount() );
+			}
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "linear box query, %u objects", count );
+			benchmark::addResult( resultName, TIKI_COUNT( aQueryBoxes ), time );
+
+			// a camera in the middle of the world with a view distance of a quarter of the world size. the linear
+			// batch wins if a large part of the world is visible, the tree wins if only a small part is.
+			Projection projection;
+			projection.createPerspective( 16.0f, 9.0f, f32::piOver4, 1.0f, range * 0.25f );
+
+			Camera camera;
+			camera.create( Vector3::zero, Quaternion::identity, &projection );
+			const Frustum& frustum = camera.getFrustum();
+
+			startTime = benchmark::getTime();
+			results.clear();
+			hierarchy.queryFrustum( results, frustum );
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "bvh frustum query, %u objects", count );
+			benchmark::addResult( resultName, 1u, time );
+			benchmark::useValue( results.getCount() );
+
+			uint32* pMask = TIKI_MEMORY_NEW_ARRAY( uint32, ( count + 31u ) / 32u, false );
+			startTime = benchmark::getTime();
+			frustum.cullAxisAlignedBoxes( pMask, pBoxes, count );
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "linear frustum cull batch, %u objects", count );
+			benchmark::addResult( resultName, 1u, time );
+			benchmark::useValue( pMask[ 0u ] );
+			TIKI_MEMORY_DELETE_ARRAY( pMask, ( count + 31u ) / 32u );
+
+			for (uint i = 0u; i < count; ++i)
+			{
+				hierarchy.removeProxy( pProxyIds[ i ] );
+			}
+
+			results.dispose();
+			hierarchy.dispose();
+
+			TIKI_MEMORY_DELETE_ARRAY( pProxyIds, count );
+			TIKI_MEMORY_DELETE_ARRAY( pBoxes, count );
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/crc32.hpp"
+#include "tiki/base/memory.hpp"
+#include "tiki/base/string.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( Crc32 );
+
+	typedef crc32 (*Crc32BenchmarkFunction)( crc32 currentValue, const void* pBytes, uint length );
+
+	struct Crc32BenchmarkImplementation
+	{
+		const char*				pName;
+		Crc32BenchmarkFunction	pFunction;
+	};
+
+	static const Crc32BenchmarkImplementation s_aCrc32BenchmarkImplementations[] =
+	{
+		{ "bytewise",	crc::addBytesBytewise },
+		{ "sliced",		crc::addBytesSliced },
+		{ "pclmul",		crc::addBytesPclmul },
+		{ "dispatch",	crcAddBytes }
+	};
+
+	static uint8* createCrc32BenchmarkBuffer( uint size )
+	{
+		uint8* pBuffer = TIKI_MEMORY_NEW_ARRAY( uint8, size, false );
+
+		uint32 state = 0x9e3779b9u;
+		for (uint i = 0u; i < size; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			pBuffer[ i ] = uint8( state >> 24u );
+		}
+
+		return pBuffer;
+	}
+
+	// file names, resource keys and component names are between 8 and 64 characters long
+	TIKI_ADD_BENCHMARK( Crc32SmallKeys )
+	{
+		const uint keyCount = 4096u;
+		const uint keyLengths[] = { 8u, 16u, 32u, 64u };
+
+		uint8* pBuffer = createCrc32BenchmarkBuffer( keyCount + 64u );
+
+		char resultName[ 128u ];
+		for (uint lengthIndex = 0u; lengthIndex < TIKI_COUNT( keyLengths ); ++lengthIndex)
+		{
+			const uint length = keyLengths[ lengthIndex ];
+			for (uint i = 0u; i < TIKI_COUNT( s_aCrc32BenchmarkImplementations ); ++i)
+			{
+				const Crc32BenchmarkImplementation& implementation = s_aCrc32BenchmarkImplementations[ i ];
+
+				crc32 result = 0u;
+				const double startTime = benchmark::getTime();
+				for (uint round = 0u; round < 16u; ++round)
+				{
+					for (uint key = 0u; key < keyCount; ++key)
+					{
+						result ^= implementation.pFunction( 0u, pBuffer + key, length );
+					}
+				}
+				const double time = benchmark::getTime() - startTime;
+				benchmark::useValue( result );
+
+				formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, %u byte keys", implementation.pName, length );
+				benchmark::addResult( resultName, keyCount * 16u, time );
+			}
+		}
+
+		TIKI_MEMORY_DELETE_ARRAY( pBuffer, keyCount + 64u );
+	}
+
+	TIKI_ADD_BENCHMARK( Crc32LargeBuffer )
+	{
+		const uint bufferSize = 16u * 1024u * 1024u;
+		uint8* pBuffer = createCrc32BenchmarkBuffer( bufferSize );
+
+		char resultName[ 128u ];
+		for (uint i = 0u; i < TIKI_COUNT( s_aCrc32BenchmarkImplementations ); ++i)
+		{
+			const Crc32BenchmarkImplementation& implementation = s_aCrc32BenchmarkImplementations[ i ];
+
+			const double startTime = benchmark::getTime();
+			const crc32 result = implementation.pFunction( 0u, pBuffer, bufferSize );
+			const double time = benchmark::getTime() - startTime;
+			benchmark::useValue( result );
+
+			// one item is one megabyte, so items/s is the throughput in mb/s
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, 16 mb buffer", implementation.pName );
+			benchmark::addResult( resultName, bufferSize / ( 1024u * 1024u ), time );
+		}
+
+		TIKI_MEMORY_DELETE_ARRAY( pBuffer, bufferSize );
+	}
+}
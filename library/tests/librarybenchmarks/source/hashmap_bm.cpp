@@ -0,0 +1,112 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/container/hashmap.hpp"
+#include "tiki/container/map.hpp"
+#include "tiki/container/sortedsizedmap.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( HashMap );
+
+	enum
+	{
+		// the sorted maps insert in O(n) per key, so they are only measured up to this size
+		HashMapBenchmarkMaxSortedCount	= 10000u
+	};
+
+	static TIKI_FORCE_INLINE uint32 getHashMapBenchmarkRandom( uint32& state )
+	{
+		state ^= state << 13u;
+		state ^= state >> 17u;
+		state ^= state << 5u;
+		return state;
+	}
+
+	// random crc like keys. the second half of the array are keys which are not in the map.
+	static uint32* createHashMapBenchmarkKeys( uint count )
+	{
+		uint32* pKeys = TIKI_MEMORY_NEW_ARRAY( uint32, count * 2u, false );
+
+		uint32 state = 0x9e3779b9u;
+		for (uint i = 0u; i < count * 2u; ++i)
+		{
+			pKeys[ i ] = getHashMapBenchmarkRandom( state );
+		}
+
+		return pKeys;
+	}
+
+	template<typename TMap>
+	static void addHashMapBenchmarkResults( TMap& map, const char* pName, const uint32* pKeys, uint count )
+	{
+		char resultName[ 128u ];
+
+		double startTime = benchmark::getTime();
+		for (uint i = 0u; i < count; ++i)
+		{
+			map.set( pKeys[ i ], i );
+		}
+		double time = benchmark::getTime() - startTime;
+
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s insert, %u keys", pName, count );
+		benchmark::addResult( resultName, count, time );
+
+		uint64 result = 0u;
+		startTime = benchmark::getTime();
+		for (uint i = 0u; i < count; ++i)
+		{
+			uint value = 0u;
+			map.findValue( &value, pKeys[ i ] );
+			result += value;
+		}
+		time = benchmark::getTime() - startTime;
+
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s lookup hit, %u keys", pName, count );
+		benchmark::addResult( resultName, count, time );
+
+		startTime = benchmark::getTime();
+		for (uint i = 0u; i < count; ++i)
+		{
+			uint value = 0u;
+			result += map.findValue( &value, pKeys[ count + i ] );
+		}
+		time = benchmark::getTime() - startTime;
+
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s lookup miss, %u keys", pName, count );
+		benchmark::addResult( resultName, count, time );
+
+		benchmark::useValue( result );
+	}
+
+	TIKI_ADD_BENCHMARK( HashMapKeyCounts )
+	{
+		const uint counts[] = { 1000u, 100000u, 1000000u };
+		for (uint i = 0u; i < TIKI_COUNT( counts ); ++i)
+		{
+			const uint count = counts[ i ];
+			uint32* pKeys = createHashMapBenchmarkKeys( count );
+
+			{
+				HashMap< uint32, uint > hashMap;
+				addHashMapBenchmarkResults( hashMap, "HashMap", pKeys, count );
+				hashMap.dispose();
+			}
+
+			if ( count <= HashMapBenchmarkMaxSortedCount )
+			{
+				Map< uint32, uint > map;
+				addHashMapBenchmarkResults( map, "Map", pKeys, count );
+				map.dispose();
+
+				SortedSizedMap< uint32, uint > sortedSizedMap;
+				sortedSizedMap.create( count );
+				addHashMapBenchmarkResults( sortedSizedMap, "SortedSizedMap", pKeys, count );
+				sortedSizedMap.dispose();
+			}
+
+			TIKI_MEMORY_DELETE_ARRAY( pKeys, count * 2u );
+		}
+	}
+}
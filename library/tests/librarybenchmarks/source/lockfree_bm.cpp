@@ -0,0 +1,284 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/base/platform.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/container/mpmcqueue.hpp"
+#include "tiki/container/queue.hpp"
+#include "tiki/container/spscqueue.hpp"
+#include "tiki/threading/atomic.hpp"
+#include "tiki/threading/mutex.hpp"
+#include "tiki/threading/spinlock.hpp"
+#include "tiki/threading/thread.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( LockFree );
+
+	enum
+	{
+		LockFreeBenchmarkMaxThreadCount	= 16u,
+		LockFreeBenchmarkLockCount		= 200000u,
+		LockFreeBenchmarkItemCount		= 200000u,
+		LockFreeBenchmarkQueueCapacity	= 1024u
+	};
+
+	struct LockFreeBenchmarkData
+	{
+		Mutex					mutex;
+		SpinLock				spinLock;
+		uint64					counter;
+
+		Queue< uint32 >			mutexQueue;
+		SpscQueue< uint32 >		spscQueue;
+		MpmcQueue< uint32 >		mpmcQueue;
+
+		uint					itemsPerThread;
+		AtomicUInt32			consumedCount;
+		uint32					totalCount;
+		AtomicUInt64			result;
+	};
+
+	static int lockFreeBenchmarkMutexThread( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < data.itemsPerThread; ++i)
+		{
+			MutexStackLock lock( data.mutex );
+			data.counter++;
+		}
+
+		return 0;
+	}
+
+	static int lockFreeBenchmarkSpinLockThread( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < data.itemsPerThread; ++i)
+		{
+			SpinLockStackLock lock( data.spinLock );
+			data.counter++;
+		}
+
+		return 0;
+	}
+
+	static int lockFreeBenchmarkMutexQueueProducer( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < data.itemsPerThread; ++i)
+		{
+			SpinBackoff backoff;
+			while ( true )
+			{
+				{
+					MutexStackLock lock( data.mutex );
+					if ( !data.mutexQueue.isFull() )
+					{
+						data.mutexQueue.push( uint32( i ) );
+						break;
+					}
+				}
+
+				backoff.wait();
+			}
+		}
+
+		return 0;
+	}
+
+	static int lockFreeBenchmarkMutexQueueConsumer( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+
+		uint64 sum = 0u;
+		SpinBackoff backoff;
+		while ( data.consumedCount.load( AtomicOrder_Relaxed ) < data.totalCount )
+		{
+			uint32 value;
+			bool popped;
+			{
+				MutexStackLock lock( data.mutex );
+				popped = data.mutexQueue.pop( value );
+			}
+
+			if ( popped )
+			{
+				sum += value;
+				data.consumedCount.fetchAdd( 1u, AtomicOrder_Relaxed );
+				backoff.reset();
+			}
+			else
+			{
+				backoff.wait();
+			}
+		}
+		data.result.fetchAdd( sum );
+
+		return 0;
+	}
+
+	static int lockFreeBenchmarkSpscQueueProducer( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < data.itemsPerThread; ++i)
+		{
+			SpinBackoff backoff;
+			while ( !data.spscQueue.tryPush( uint32( i ) ) )
+			{
+				backoff.wait();
+			}
+		}
+
+		return 0;
+	}
+
+	static int lockFreeBenchmarkSpscQueueConsumer( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+
+		uint64 sum = 0u;
+		SpinBackoff backoff;
+		for (uint i = 0u; i < data.totalCount; )
+		{
+			uint32 value;
+			if ( data.spscQueue.tryPop( value ) )
+			{
+				sum += value;
+				i++;
+				backoff.reset();
+			}
+			else
+			{
+				backoff.wait();
+			}
+		}
+		data.result.fetchAdd( sum );
+
+		return 0;
+	}
+
+	static int lockFreeBenchmarkMpmcQueueProducer( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < data.itemsPerThread; ++i)
+		{
+			SpinBackoff backoff;
+			while ( !data.mpmcQueue.tryPush( uint32( i ) ) )
+			{
+				backoff.wait();
+			}
+		}
+
+		return 0;
+	}
+
+	static int lockFreeBenchmarkMpmcQueueConsumer( const Thread& thread )
+	{
+		LockFreeBenchmarkData& data = *static_cast< LockFreeBenchmarkData* >( thread.getArgument() );
+
+		uint64 sum = 0u;
+		SpinBackoff backoff;
+		while ( data.consumedCount.load( AtomicOrder_Relaxed ) < data.totalCount )
+		{
+			uint32 value;
+			if ( data.mpmcQueue.tryPop( value ) )
+			{
+				sum += value;
+				data.consumedCount.fetchAdd( 1u, AtomicOrder_Relaxed );
+				backoff.reset();
+			}
+			else
+			{
+				backoff.wait();
+			}
+		}
+		data.result.fetchAdd( sum );
+
+		return 0;
+	}
+
+	static double runLockFreeBenchmarkThreads( LockFreeBenchmarkData& data, ThreadEntryFunction pProducerFunc, uint producerCount, ThreadEntryFunction pConsumerFunc, uint consumerCount )
+	{
+		data.counter = 0u;
+		data.consumedCount.store( 0u );
+		data.totalCount = uint32( data.itemsPerThread * producerCount );
+
+		Thread threads[ LockFreeBenchmarkMaxThreadCount * 2u ];
+		const uint threadCount = producerCount + consumerCount;
+		TIKI_ASSERT( threadCount <= TIKI_COUNT( threads ) );
+
+		const double startTime = benchmark::getTime();
+		for (uint i = 0u; i < threadCount; ++i)
+		{
+			const bool isProducer = ( i < producerCount );
+			TIKI_VERIFY( threads[ i ].create( isProducer ? pProducerFunc : pConsumerFunc, &data, 0u, "LockFreeBenchmark" ) );
+		}
+
+		for (uint i = 0u; i < threadCount; ++i)
+		{
+			threads[ i ].waitForExit();
+			threads[ i ].dispose();
+		}
+
+		return benchmark::getTime() - startTime;
+	}
+
+	static void runLockFreeBenchmarkScaling( const char* pName, ThreadEntryFunction pProducerFunc, ThreadEntryFunction pConsumerFunc, bool singleProducer, uint itemCount )
+	{
+		LockFreeBenchmarkData* pData = TIKI_MEMORY_NEW_OBJECT( LockFreeBenchmarkData );
+		LockFreeBenchmarkData& data = *pData;
+		data.mutex.create();
+		data.mutexQueue.create( LockFreeBenchmarkQueueCapacity );
+		data.spscQueue.create( LockFreeBenchmarkQueueCapacity );
+		data.mpmcQueue.create( LockFreeBenchmarkQueueCapacity );
+
+		const uint processorCount = TIKI_MIN( platform::getProcessorCount(), (uint)LockFreeBenchmarkMaxThreadCount );
+		uint threadCount = 1u;
+		while ( true )
+		{
+			const uint producerCount = ( singleProducer ? 1u : threadCount );
+			const uint consumerCount = ( pConsumerFunc != nullptr ? producerCount : 0u );
+			data.itemsPerThread = itemCount / producerCount;
+
+			const double time = runLockFreeBenchmarkThreads( data, pProducerFunc, producerCount, pConsumerFunc, consumerCount );
+
+			char resultName[ 128u ];
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, %u threads", pName, producerCount + consumerCount );
+			benchmark::addResult( resultName, data.itemsPerThread * producerCount, time );
+
+			if ( singleProducer || threadCount == processorCount )
+			{
+				break;
+			}
+			threadCount = TIKI_MIN( threadCount * 2u, processorCount );
+		}
+
+		benchmark::useValue( data.counter + data.result.load() );
+
+		data.mpmcQueue.dispose();
+		data.spscQueue.dispose();
+		data.mutexQueue.dispose();
+		data.mutex.dispose();
+		TIKI_MEMORY_DELETE_OBJECT( pData );
+	}
+
+	TIKI_ADD_BENCHMARK( LockContention )
+	{
+		runLockFreeBenchmarkScaling( "Mutex", lockFreeBenchmarkMutexThread, nullptr, false, LockFreeBenchmarkLockCount );
+		runLockFreeBenchmarkScaling( "SpinLock", lockFreeBenchmarkSpinLockThread, nullptr, false, LockFreeBenchmarkLockCount );
+	}
+
+	TIKI_ADD_BENCHMARK( QueueSingleProducer )
+	{
+		runLockFreeBenchmarkScaling( "Mutex + Queue", lockFreeBenchmarkMutexQueueProducer, lockFreeBenchmarkMutexQueueConsumer, true, LockFreeBenchmarkItemCount );
+		runLockFreeBenchmarkScaling( "SpscQueue", lockFreeBenchmarkSpscQueueProducer, lockFreeBenchmarkSpscQueueConsumer, true, LockFreeBenchmarkItemCount );
+		runLockFreeBenchmarkScaling( "MpmcQueue", lockFreeBenchmarkMpmcQueueProducer, lockFreeBenchmarkMpmcQueueConsumer, true, LockFreeBenchmarkItemCount );
+	}
+
+	TIKI_ADD_BENCHMARK( QueueContention )
+	{
+		runLockFreeBenchmarkScaling( "Mutex + Queue", lockFreeBenchmarkMutexQueueProducer, lockFreeBenchmarkMutexQueueConsumer, false, LockFreeBenchmarkItemCount );
+		runLockFreeBenchmarkScaling( "MpmcQueue", lockFreeBenchmarkMpmcQueueProducer, lockFreeBenchmarkMpmcQueueConsumer, false, LockFreeBenchmarkItemCount );
+	}
+}
@@ -0,0 +1,11 @@
+#include "tiki/base/platform.hpp"
+
+#include "tiki/benchmark/benchmark.hpp"
+
+namespace tiki
+{
+	int mainEntryPoint()
+	{
+		return benchmark::run();
+	}
+}
@@ -0,0 +1,334 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/math/axisalignedbox.hpp"
+#include "tiki/math/camera.hpp"
+#include "tiki/math/matrix.hpp"
+#include "tiki/math/quaternion.hpp"
+#include "tiki/math/sphere.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( Math );
+
+	enum
+	{
+		// about a skeleton pose or a chunk of vertices, everything stays in the l2 cache
+		MathBenchmarkElementCount	= 4096u,
+		MathBenchmarkRoundCount		= 256u
+	};
+
+	static float getMathBenchmarkValue( uint32& state )
+	{
+		state = state * 1664525u + 1013904223u;
+		return float( state >> 8u ) / float( 1u << 24u ) * 2.0f - 1.0f;
+	}
+
+	static void createMathBenchmarkMatrix( Matrix43& mtx, uint32& state )
+	{
+		Quaternion rotation;
+		quaternion::fromYawPitchRoll( rotation, getMathBenchmarkValue( state ), getMathBenchmarkValue( state ), getMathBenchmarkValue( state ) );
+		quaternion::toMatrix( mtx.rot, rotation );
+		vector::set( mtx.pos, getMathBenchmarkValue( state ), getMathBenchmarkValue( state ), getMathBenchmarkValue( state ) );
+	}
+
+	static void addMathBenchmarkResult( const char* pName, double time )
+	{
+		char resultName[ 128u ];
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, %u elements", pName, MathBenchmarkElementCount );
+		benchmark::addResult( resultName, MathBenchmarkElementCount * MathBenchmarkRoundCount, time );
+	}
+
+	// the scalar versions are the implementations before the math library used the simd layer
+	static void transformMathBenchmarkScalar( Vector3& vec, const Matrix43& mtx )
+	{
+		const float x = vec.x * mtx.rot.x.x + vec.y * mtx.rot.x.y + vec.z * mtx.rot.x.z;
+		const float y = vec.x * mtx.rot.y.x + vec.y * mtx.rot.y.y + vec.z * mtx.rot.y.z;
+		const float z = vec.x * mtx.rot.z.x + vec.y * mtx.rot.z.y + vec.z * mtx.rot.z.z;
+		vec.x = x + mtx.pos.x;
+		vec.y = y + mtx.pos.y;
+		vec.z = z + mtx.pos.z;
+	}
+
+	static void mulMathBenchmarkScalar( Matrix44& mtx, const Matrix44& lhs, const Matrix44& rhs )
+	{
+		const float* pLhs	= &lhs.x.x;
+		const float* pRhs	= &rhs.x.x;
+		float aResult[ 16u ];
+		for (uint row = 0u; row < 4u; ++row)
+		{
+			for (uint column = 0u; column < 4u; ++column)
+			{
+				aResult[ row * 4u + column ] = pLhs[ row * 4u + 0u ] * pRhs[ 0u + column ] + pLhs[ row * 4u + 1u ] * pRhs[ 4u + column ] + pLhs[ row * 4u + 2u ] * pRhs[ 8u + column ] + pLhs[ row * 4u + 3u ] * pRhs[ 12u + column ];
+			}
+		}
+
+		float* pTarget = &mtx.x.x;
+		for (uint i = 0u; i < 16u; ++i)
+		{
+			pTarget[ i ] = aResult[ i ];
+		}
+	}
+
+	TIKI_ADD_BENCHMARK( MathTransformPoints )
+	{
+		const uint count = MathBenchmarkElementCount;
+
+		uint32 state = 1u;
+		Matrix43 mtx;
+		createMathBenchmarkMatrix( mtx, state );
+
+		Vector3* pSource = TIKI_MEMORY_NEW_ARRAY( Vector3, count, false );
+		Vector3* pTarget = TIKI_MEMORY_NEW_ARRAY( Vector3, count, false );
+		for (uint i = 0u; i < count; ++i)
+		{
+			vector::set( pSource[ i ], getMathBenchmarkValue( state ), getMathBenchmarkValue( state ), getMathBenchmarkValue( state ) );
+		}
+
+		double startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pTarget[ i ] = pSource[ i ];
+				transformMathBenchmarkScalar( pTarget[ i ], mtx );
+			}
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].x ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "transform scalar", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pTarget[ i ] = pSource[ i ];
+				matrix::transform( pTarget[ i ], mtx );
+			}
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].x ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "transform single", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			matrix::transformBatch( pTarget, pSource, count, mtx );
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].x ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "transform batch", benchmark::getTime() - startTime );
+
+		TIKI_MEMORY_DELETE_ARRAY( pSource, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTarget, count );
+	}
+
+	TIKI_ADD_BENCHMARK( MathMultiplyMatrices )
+	{
+		const uint count = MathBenchmarkElementCount;
+
+		Matrix44* pLhs		= TIKI_MEMORY_NEW_ARRAY( Matrix44, count, false );
+		Matrix44* pRhs		= TIKI_MEMORY_NEW_ARRAY( Matrix44, count, false );
+		Matrix44* pTarget	= TIKI_MEMORY_NEW_ARRAY( Matrix44, count, false );
+
+		uint32 state = 2u;
+		for (uint i = 0u; i < count; ++i)
+		{
+			Matrix43 mtx;
+			createMathBenchmarkMatrix( mtx, state );
+			matrix::set( pLhs[ i ], mtx );
+
+			createMathBenchmarkMatrix( mtx, state );
+			matrix::set( pRhs[ i ], mtx );
+		}
+
+		double startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				mulMathBenchmarkScalar( pTarget[ i ], pLhs[ i ], pRhs[ i ] );
+			}
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].w.x ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "mul scalar", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			matrix::mulBatch( pTarget, pLhs, pRhs, count );
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].w.x ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "mul batch", benchmark::getTime() - startTime );
+
+		// normal matrix like in the scene render effect
+		Matrix43* pTransforms = TIKI_MEMORY_NEW_ARRAY( Matrix43, count, false );
+		for (uint i = 0u; i < count; ++i)
+		{
+			createMathBenchmarkMatrix( pTransforms[ i ], state );
+		}
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				matrix::set( pTarget[ i ], pTransforms[ i ] );
+				matrix::invert( pTarget[ i ], pTarget[ i ] );
+				matrix::transpose( pTarget[ i ] );
+			}
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].x.w ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "set, invert and transpose", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				matrix::invertTranspose( pTarget[ i ], pTransforms[ i ] );
+			}
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].x.w ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "invert transpose", benchmark::getTime() - startTime );
+
+		TIKI_MEMORY_DELETE_ARRAY( pTransforms, count );
+		TIKI_MEMORY_DELETE_ARRAY( pLhs, count );
+		TIKI_MEMORY_DELETE_ARRAY( pRhs, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTarget, count );
+	}
+
+	struct MathBenchmarkJoint
+	{
+		Quaternion	rotation;
+		Vector3		translation;
+		Vector3		scale;
+	};
+
+	TIKI_ADD_BENCHMARK( MathComposeTransforms )
+	{
+		const uint count = MathBenchmarkElementCount;
+
+		MathBenchmarkJoint* pJoints	= TIKI_MEMORY_NEW_ARRAY( MathBenchmarkJoint, count, false );
+		Matrix44* pTarget			= TIKI_MEMORY_NEW_ARRAY( Matrix44, count, false );
+
+		uint32 state = 3u;
+		for (uint i = 0u; i < count; ++i)
+		{
+			quaternion::fromYawPitchRoll( pJoints[ i ].rotation, getMathBenchmarkValue( state ), getMathBenchmarkValue( state ), getMathBenchmarkValue( state ) );
+			vector::set( pJoints[ i ].translation, getMathBenchmarkValue( state ), getMathBenchmarkValue( state ), getMathBenchmarkValue( state ) );
+			vector::set( pJoints[ i ].scale, 1.0f, 1.0f, 1.0f );
+		}
+
+		double startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				matrix::compose( pTarget[ i ], pJoints[ i ].rotation, pJoints[ i ].translation, pJoints[ i ].scale );
+			}
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].w.x ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "compose single", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			matrix::composeBatch( pTarget, &pJoints[ 0u ].rotation, &pJoints[ 0u ].translation, &pJoints[ 0u ].scale, count, sizeof( MathBenchmarkJoint ) );
+			benchmark::useValue( uint64( f32::abs( pTarget[ round ].w.x ) * 1000.0f ) );
+		}
+		addMathBenchmarkResult( "compose batch", benchmark::getTime() - startTime );
+
+		TIKI_MEMORY_DELETE_ARRAY( pJoints, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTarget, count );
+	}
+
+	TIKI_ADD_BENCHMARK( MathCullBounds )
+	{
+		const uint count = MathBenchmarkElementCount;
+
+		Projection projection;
+		projection.createPerspective( 16.0f, 9.0f, f32::piOver4, 1.0f, 100.0f );
+
+		Camera camera;
+		camera.create( Vector3::zero, Quaternion::identity, &projection );
+		const Frustum& frustum = camera.getFrustum();
+
+		AxisAlignedBox* pBoxes	= TIKI_MEMORY_NEW_ARRAY( AxisAlignedBox, count, false );
+		Sphere* pSpheres		= TIKI_MEMORY_NEW_ARRAY( Sphere, count, false );
+		float* pCenterX			= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float* pCenterY			= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float* pCenterZ			= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float* pRadius			= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		uint32* pMask			= TIKI_MEMORY_NEW_ARRAY( uint32, count / 32u, false );
+
+		// about half of the bounds are visible
+		uint32 state = 4u;
+		for (uint i = 0u; i < count; ++i)
+		{
+			const Vector3 center = vector::create( getMathBenchmarkValue( state ) * 100.0f, getMathBenchmarkValue( state ) * 50.0f, getMathBenchmarkValue( state ) * 100.0f );
+			pBoxes[ i ].createFromCenterExtends( center, Vector3::one );
+			pSpheres[ i ] = Sphere( center, 1.0f );
+
+			pCenterX[ i ]	= center.x;
+			pCenterY[ i ]	= center.y;
+			pCenterZ[ i ]	= center.z;
+			pRadius[ i ]	= 1.0f;
+		}
+
+		double startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			uint visibleCount = 0u;
+			for (uint i = 0u; i < count; ++i)
+			{
+				visibleCount += ( frustum.testIntersectionAxisAlignedBox( pBoxes[ i ] ) != IntersectionTypes_Disjoint );
+			}
+			benchmark::useValue( visibleCount );
+		}
+		addMathBenchmarkResult( "cull boxes single", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			frustum.cullAxisAlignedBoxes( pMask, pBoxes, count );
+			benchmark::useValue( pMask[ round % ( count / 32u ) ] );
+		}
+		addMathBenchmarkResult( "cull boxes batch", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			uint visibleCount = 0u;
+			for (uint i = 0u; i < count; ++i)
+			{
+				visibleCount += ( frustum.testIntersectionSphere( pSpheres[ i ] ) != IntersectionTypes_Disjoint );
+			}
+			benchmark::useValue( visibleCount );
+		}
+		addMathBenchmarkResult( "cull spheres single", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			frustum.cullSpheres( pMask, pSpheres, count );
+			benchmark::useValue( pMask[ round % ( count / 32u ) ] );
+		}
+		addMathBenchmarkResult( "cull spheres batch", benchmark::getTime() - startTime );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < MathBenchmarkRoundCount; ++round)
+		{
+			frustum.cullSpheres( pMask, pCenterX, pCenterY, pCenterZ, pRadius, count );
+			benchmark::useValue( pMask[ round % ( count / 32u ) ] );
+		}
+		addMathBenchmarkResult( "cull spheres soa batch", benchmark::getTime() - startTime );
+
+		TIKI_MEMORY_DELETE_ARRAY( pMask, count / 32u );
+		TIKI_MEMORY_DELETE_ARRAY( pRadius, count );
+		TIKI_MEMORY_DELETE_ARRAY( pCenterZ, count );
+		TIKI_MEMORY_DELETE_ARRAY( pCenterY, count );
+		TIKI_MEMORY_DELETE_ARRAY( pCenterX, count );
+		TIKI_MEMORY_DELETE_ARRAY( pSpheres, count );
+		TIKI_MEMORY_DELETE_ARRAY( pBoxes, count );
+	}
+}
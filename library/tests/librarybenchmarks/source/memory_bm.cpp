@@ -0,0 +1,268 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/engineallocator.hpp"
+#include "tiki/base/memory.hpp"
+#include "tiki/base/platform.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/threading/thread.hpp"
+
+#include <stdlib.h>
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( Memory );
+
+	enum
+	{
+		MemoryBenchmarkMaxThreadCount		= 16u,
+		MemoryBenchmarkFrameCount			= 200u,
+		MemoryBenchmarkFrameBlockCount		= 2000u,
+		MemoryBenchmarkPersistentCount		= 512u,
+		MemoryBenchmarkConverterFileCount	= 200u,
+		MemoryBenchmarkConverterTempCount	= 16u
+	};
+
+	typedef void*( *MemoryBenchmarkAllocFunction )( uint sizeInBytes );
+	typedef void( *MemoryBenchmarkFreeFunction )( void* pMemory );
+
+	struct MemoryBenchmarkAllocator
+	{
+		const char*						pName;
+		MemoryBenchmarkAllocFunction	pAlloc;
+		MemoryBenchmarkFreeFunction		pFree;
+	};
+
+	struct MemoryBenchmarkThreadData
+	{
+		const MemoryBenchmarkAllocator*	pAllocator;
+		uint							frameCount;
+		uint32							seed;
+		uint64							result;
+	};
+
+	static void* memoryBenchmarkSystemAlloc( uint sizeInBytes )
+	{
+		return malloc( sizeInBytes );
+	}
+
+	static void memoryBenchmarkSystemFree( void* pMemory )
+	{
+		free( pMemory );
+	}
+
+	static void* memoryBenchmarkEngineAlloc( uint sizeInBytes )
+	{
+		return engineallocator::allocate( sizeInBytes, TIKI_MINIMUM_ALIGNMENT );
+	}
+
+	static void memoryBenchmarkEngineFree( void* pMemory )
+	{
+		engineallocator::free( pMemory );
+	}
+
+	static const MemoryBenchmarkAllocator s_aMemoryBenchmarkAllocators[] =
+	{
+		{ "system",	memoryBenchmarkSystemAlloc, memoryBenchmarkSystemFree },
+		{ "engine",	memoryBenchmarkEngineAlloc, memoryBenchmarkEngineFree }
+	};
+
+	static TIKI_FORCE_INLINE uint32 getMemoryBenchmarkRandom( uint32& state )
+	{
+		state ^= state << 13u;
+		state ^= state >> 17u;
+		state ^= state << 5u;
+		return state;
+	}
+
+	// mostly small blocks like strings, list nodes and commands with a few larger buffers
+	static TIKI_FORCE_INLINE uint getMemoryBenchmarkGameSize( uint32& state )
+	{
+		const uint32 value = getMemoryBenchmarkRandom( state );
+		if ( ( value & 0xffu ) < 200u )
+		{
+			return 8u + ( ( value >> 8u ) & 0x7fu );
+		}
+		else if ( ( value & 0xffu ) < 250u )
+		{
+			return 128u + ( ( value >> 8u ) & 0x3ffu );
+		}
+
+		return 1024u + ( ( value >> 8u ) & 0x3fffu );
+	}
+
+	// blocks of a frame are freed in random order at the end of the frame. some blocks live over many frames.
+	static uint64 runMemoryBenchmarkGameLoop( const MemoryBenchmarkAllocator& allocator, uint frameCount, uint32 seed )
+	{
+		void* apFrameBlocks[ MemoryBenchmarkFrameBlockCount ];
+		void* apPersistentBlocks[ MemoryBenchmarkPersistentCount ] = { nullptr };
+
+		uint32 state = seed;
+		uint64 result = 0u;
+		for (uint frameIndex = 0u; frameIndex < frameCount; ++frameIndex)
+		{
+			for (uint i = 0u; i < MemoryBenchmarkFrameBlockCount; ++i)
+			{
+				const uint size = getMemoryBenchmarkGameSize( state );
+				uint8* pBlock = static_cast< uint8* >( allocator.pAlloc( size ) );
+				pBlock[ 0u ] = uint8( i );
+
+				apFrameBlocks[ i ] = pBlock;
+			}
+
+			for (uint i = 0u; i < MemoryBenchmarkPersistentCount / 16u; ++i)
+			{
+				const uint index = getMemoryBenchmarkRandom( state ) % MemoryBenchmarkPersistentCount;
+				allocator.pFree( apPersistentBlocks[ index ] );
+				apPersistentBlocks[ index ] = allocator.pAlloc( getMemoryBenchmarkGameSize( state ) );
+			}
+
+			for (uint i = MemoryBenchmarkFrameBlockCount - 1u; i > 0u; --i)
+			{
+				const uint index = getMemoryBenchmarkRandom( state ) % ( i + 1u );
+				void* pBlock = apFrameBlocks[ index ];
+				apFrameBlocks[ index ] = apFrameBlocks[ i ];
+
+				result += *static_cast< const uint8* >( pBlock );
+				allocator.pFree( pBlock );
+			}
+			allocator.pFree( apFrameBlocks[ 0u ] );
+		}
+
+		for (uint i = 0u; i < MemoryBenchmarkPersistentCount; ++i)
+		{
+			allocator.pFree( apPersistentBlocks[ i ] );
+		}
+
+		return result;
+	}
+
+	// growing output buffers like strings and lists plus temporary buffers which are released in reverse order
+	static uint64 runMemoryBenchmarkConverter( const MemoryBenchmarkAllocator& allocator, uint32 seed )
+	{
+		uint32 state = seed;
+		uint64 result = 0u;
+		for (uint fileIndex = 0u; fileIndex < MemoryBenchmarkConverterFileCount; ++fileIndex)
+		{
+			void* apTempBlocks[ MemoryBenchmarkConverterTempCount ];
+			for (uint i = 0u; i < MemoryBenchmarkConverterTempCount; ++i)
+			{
+				apTempBlocks[ i ] = allocator.pAlloc( 256u + getMemoryBenchmarkRandom( state ) % ( 64u * 1024u ) );
+			}
+
+			const uint finalSize = 4096u + getMemoryBenchmarkRandom( state ) % ( 512u * 1024u );
+			uint capacity = 16u;
+			uint8* pBuffer = static_cast< uint8* >( allocator.pAlloc( capacity ) );
+			pBuffer[ 0u ] = 1u;
+			while ( capacity < finalSize )
+			{
+				uint8* pNewBuffer = static_cast< uint8* >( allocator.pAlloc( capacity * 2u ) );
+				memory::copy( pNewBuffer, pBuffer, capacity );
+				allocator.pFree( pBuffer );
+
+				pBuffer = pNewBuffer;
+				capacity *= 2u;
+			}
+			result += pBuffer[ 0u ];
+			allocator.pFree( pBuffer );
+
+			for (uint i = MemoryBenchmarkConverterTempCount; i > 0u; --i)
+			{
+				allocator.pFree( apTempBlocks[ i - 1u ] );
+			}
+		}
+
+		return result;
+	}
+
+	static int memoryBenchmarkGameLoopThread( const Thread& thread )
+	{
+		MemoryBenchmarkThreadData& data = *static_cast< MemoryBenchmarkThreadData* >( thread.getArgument() );
+		data.result = runMemoryBenchmarkGameLoop( *data.pAllocator, data.frameCount, data.seed );
+
+		return 0;
+	}
+
+	TIKI_ADD_BENCHMARK( GameLoopAllocations )
+	{
+		const uint itemCount = MemoryBenchmarkFrameCount * ( MemoryBenchmarkFrameBlockCount + MemoryBenchmarkPersistentCount / 16u );
+		for (uint i = 0u; i < TIKI_COUNT( s_aMemoryBenchmarkAllocators ); ++i)
+		{
+			const MemoryBenchmarkAllocator& allocator = s_aMemoryBenchmarkAllocators[ i ];
+
+			const double startTime = benchmark::getTime();
+			const uint64 result = runMemoryBenchmarkGameLoop( allocator, MemoryBenchmarkFrameCount, 0x1234567u );
+			const double time = benchmark::getTime() - startTime;
+
+			char resultName[ 128u ];
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "Game loop alloc/free, %s", allocator.pName );
+			benchmark::addResult( resultName, itemCount, time );
+			benchmark::useValue( result );
+		}
+	}
+
+	TIKI_ADD_BENCHMARK( ConverterAllocations )
+	{
+		for (uint i = 0u; i < TIKI_COUNT( s_aMemoryBenchmarkAllocators ); ++i)
+		{
+			const MemoryBenchmarkAllocator& allocator = s_aMemoryBenchmarkAllocators[ i ];
+
+			const double startTime = benchmark::getTime();
+			const uint64 result = runMemoryBenchmarkConverter( allocator, 0x7654321u );
+			const double time = benchmark::getTime() - startTime;
+
+			char resultName[ 128u ];
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "Converter files, %s", allocator.pName );
+			benchmark::addResult( resultName, MemoryBenchmarkConverterFileCount, time );
+			benchmark::useValue( result );
+		}
+	}
+
+	TIKI_ADD_BENCHMARK( GameLoopThreadScaling )
+	{
+		const uint processorCount = TIKI_MIN( platform::getProcessorCount(), (uint)MemoryBenchmarkMaxThreadCount );
+		const uint frameCount = MemoryBenchmarkFrameCount / 4u;
+		const uint itemCount = frameCount * ( MemoryBenchmarkFrameBlockCount + MemoryBenchmarkPersistentCount / 16u );
+
+		for (uint allocatorIndex = 0u; allocatorIndex < TIKI_COUNT( s_aMemoryBenchmarkAllocators ); ++allocatorIndex)
+		{
+			const MemoryBenchmarkAllocator& allocator = s_aMemoryBenchmarkAllocators[ allocatorIndex ];
+
+			uint threadCount = 2u;
+			while ( true )
+			{
+				MemoryBenchmarkThreadData data[ MemoryBenchmarkMaxThreadCount ];
+				Thread threads[ MemoryBenchmarkMaxThreadCount ];
+
+				const double startTime = benchmark::getTime();
+				for (uint i = 0u; i < threadCount; ++i)
+				{
+					data[ i ].pAllocator	= &allocator;
+					data[ i ].frameCount	= frameCount;
+					data[ i ].seed			= 0x1234567u + uint32( i );
+					data[ i ].result		= 0u;
+					TIKI_VERIFY( threads[ i ].create( memoryBenchmarkGameLoopThread, &data[ i ], 0u, "MemoryBenchmark" ) );
+				}
+
+				uint64 result = 0u;
+				for (uint i = 0u; i < threadCount; ++i)
+				{
+					threads[ i ].waitForExit();
+					threads[ i ].dispose();
+					result += data[ i ].result;
+				}
+				const double time = benchmark::getTime() - startTime;
+
+				char resultName[ 128u ];
+				formatStringBuffer( resultName, TIKI_COUNT( resultName ), "Game loop, %u threads, %s", threadCount, allocator.pName );
+				benchmark::addResult( resultName, itemCount * threadCount, time );
+				benchmark::useValue( result );
+
+				if ( threadCount >= processorCount )
+				{
+					break;
+				}
+				threadCount = TIKI_MIN( threadCount * 2u, processorCount );
+			}
+		}
+	}
+}
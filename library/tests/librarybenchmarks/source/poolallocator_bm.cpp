@@ -0,0 +1,201 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/platform.hpp"
+#include "tiki/base/poolallocator.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/container/concurrentpoolallocator.hpp"
+#include "tiki/threading/spinlock.hpp"
+#include "tiki/threading/thread.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( PoolAllocator );
+
+	enum
+	{
+		PoolAllocatorBenchmarkCapacity			= 16384u,
+		PoolAllocatorBenchmarkBatchSize			= 16u,
+		PoolAllocatorBenchmarkIterationCount	= 20000u,
+		PoolAllocatorBenchmarkMaxThreadCount	= 16u
+	};
+
+	struct PoolAllocatorBenchmarkObject
+	{
+		uint64	aValues[ 4u ];
+	};
+
+	struct PoolAllocatorBenchmarkThreadData
+	{
+		ConcurrentPoolAllocator< PoolAllocatorBenchmarkObject >*	pConcurrentPool;
+		PoolAllocator< PoolAllocatorBenchmarkObject >*				pLockedPool;
+		SpinLock*													pLock;
+		uint														iterationCount;
+		uint64														result;
+	};
+
+	template<typename TPool>
+	static uint64 runPoolAllocatorBenchmark( TPool& pool, uint iterationCount )
+	{
+		uint64 result = 0u;
+
+		PoolAllocatorBenchmarkObject* apObjects[ PoolAllocatorBenchmarkBatchSize ];
+		for (uint iteration = 0u; iteration < iterationCount; ++iteration)
+		{
+			for (uint i = 0u; i < PoolAllocatorBenchmarkBatchSize; ++i)
+			{
+				apObjects[ i ] = pool.allocate();
+				apObjects[ i ]->aValues[ 0u ] = iteration;
+			}
+
+			for (uint i = PoolAllocatorBenchmarkBatchSize; i > 0u; --i)
+			{
+				result += apObjects[ i - 1u ]->aValues[ 0u ];
+				pool.free( apObjects[ i - 1u ] );
+			}
+		}
+
+		return result;
+	}
+
+	// the pool is filled up to the given percentage before the allocations are measured
+	template<typename TPool>
+	static void addPoolAllocatorBenchmarkResult( TPool& pool, const char* pName, uint fillPercentage )
+	{
+		const uint fillCount = ( PoolAllocatorBenchmarkCapacity * fillPercentage ) / 100u;
+		TIKI_ASSERT( fillCount + PoolAllocatorBenchmarkBatchSize <= PoolAllocatorBenchmarkCapacity );
+
+		PoolAllocatorBenchmarkObject** ppFillObjects = TIKI_MEMORY_NEW_ARRAY( PoolAllocatorBenchmarkObject*, fillCount, false );
+		for (uint i = 0u; i < fillCount; ++i)
+		{
+			ppFillObjects[ i ] = pool.allocate();
+		}
+
+		const double startTime = benchmark::getTime();
+		const uint64 result = runPoolAllocatorBenchmark( pool, PoolAllocatorBenchmarkIterationCount );
+		const double time = benchmark::getTime() - startTime;
+
+		for (uint i = 0u; i < fillCount; ++i)
+		{
+			pool.free( ppFillObjects[ i ] );
+		}
+		TIKI_MEMORY_DELETE_ARRAY( ppFillObjects, fillCount );
+
+		char resultName[ 128u ];
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, %u percent full", pName, fillPercentage );
+		benchmark::addResult( resultName, PoolAllocatorBenchmarkIterationCount * PoolAllocatorBenchmarkBatchSize, time );
+		benchmark::useValue( result );
+	}
+
+	static int poolAllocatorBenchmarkConcurrentThread( const Thread& thread )
+	{
+		PoolAllocatorBenchmarkThreadData& data = *static_cast< PoolAllocatorBenchmarkThreadData* >( thread.getArgument() );
+		data.result = runPoolAllocatorBenchmark( *data.pConcurrentPool, data.iterationCount );
+
+		return 0;
+	}
+
+	static int poolAllocatorBenchmarkLockedThread( const Thread& thread )
+	{
+		PoolAllocatorBenchmarkThreadData& data = *static_cast< PoolAllocatorBenchmarkThreadData* >( thread.getArgument() );
+
+		uint64 result = 0u;
+		PoolAllocatorBenchmarkObject* apObjects[ PoolAllocatorBenchmarkBatchSize ];
+		for (uint iteration = 0u; iteration < data.iterationCount; ++iteration)
+		{
+			for (uint i = 0u; i < PoolAllocatorBenchmarkBatchSize; ++i)
+			{
+				SpinLockStackLock lock( *data.pLock );
+				apObjects[ i ] = data.pLockedPool->allocate();
+			}
+
+			for (uint i = PoolAllocatorBenchmarkBatchSize; i > 0u; --i)
+			{
+				result += uint64( apObjects[ i - 1u ] != nullptr );
+
+				SpinLockStackLock lock( *data.pLock );
+				data.pLockedPool->free( apObjects[ i - 1u ] );
+			}
+		}
+		data.result = result;
+
+		return 0;
+	}
+
+	TIKI_ADD_BENCHMARK( PoolAllocatorOccupancy )
+	{
+		const uint fillPercentages[] = { 10u, 50u, 99u };
+		for (uint i = 0u; i < TIKI_COUNT( fillPercentages ); ++i)
+		{
+			PoolAllocator< PoolAllocatorBenchmarkObject > bitmaskPool;
+			TIKI_VERIFY( bitmaskPool.create( PoolAllocatorBenchmarkCapacity, TIKI_DEFAULT_ALIGNMENT, PoolAllocatorType_Bitmask ) );
+			addPoolAllocatorBenchmarkResult( bitmaskPool, "Bitmask pool", fillPercentages[ i ] );
+			bitmaskPool.dispose();
+
+			PoolAllocator< PoolAllocatorBenchmarkObject > freeListPool;
+			TIKI_VERIFY( freeListPool.create( PoolAllocatorBenchmarkCapacity, TIKI_DEFAULT_ALIGNMENT, PoolAllocatorType_FreeList ) );
+			addPoolAllocatorBenchmarkResult( freeListPool, "Free list pool", fillPercentages[ i ] );
+			freeListPool.dispose();
+
+			ConcurrentPoolAllocator< PoolAllocatorBenchmarkObject > concurrentPool;
+			TIKI_VERIFY( concurrentPool.create( PoolAllocatorBenchmarkCapacity ) );
+			addPoolAllocatorBenchmarkResult( concurrentPool, "Concurrent pool", fillPercentages[ i ] );
+			concurrentPool.dispose();
+		}
+	}
+
+	TIKI_ADD_BENCHMARK( PoolAllocatorThreadScaling )
+	{
+		const uint processorCount = TIKI_MIN( platform::getProcessorCount(), (uint)PoolAllocatorBenchmarkMaxThreadCount );
+		const uint iterationCount = PoolAllocatorBenchmarkIterationCount / 4u;
+
+		ConcurrentPoolAllocator< PoolAllocatorBenchmarkObject > concurrentPool;
+		PoolAllocator< PoolAllocatorBenchmarkObject > lockedPool;
+		SpinLock lock;
+		TIKI_VERIFY( concurrentPool.create( PoolAllocatorBenchmarkCapacity ) );
+		TIKI_VERIFY( lockedPool.create( PoolAllocatorBenchmarkCapacity ) );
+
+		for (uint locked = 0u; locked < 2u; ++locked)
+		{
+			uint threadCount = 2u;
+			while ( true )
+			{
+				PoolAllocatorBenchmarkThreadData data[ PoolAllocatorBenchmarkMaxThreadCount ];
+				Thread threads[ PoolAllocatorBenchmarkMaxThreadCount ];
+
+				const double startTime = benchmark::getTime();
+				for (uint i = 0u; i < threadCount; ++i)
+				{
+					data[ i ].pConcurrentPool	= &concurrentPool;
+					data[ i ].pLockedPool		= &lockedPool;
+					data[ i ].pLock				= &lock;
+					data[ i ].iterationCount	= iterationCount;
+					data[ i ].result			= 0u;
+					TIKI_VERIFY( threads[ i ].create( locked ? poolAllocatorBenchmarkLockedThread : poolAllocatorBenchmarkConcurrentThread, &data[ i ], 0u, "PoolAllocatorBenchmark" ) );
+				}
+
+				uint64 result = 0u;
+				for (uint i = 0u; i < threadCount; ++i)
+				{
+					threads[ i ].waitForExit();
+					threads[ i ].dispose();
+					result += data[ i ].result;
+				}
+				const double time = benchmark::getTime() - startTime;
+
+				char resultName[ 128u ];
+				formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, %u threads", ( locked ? "Free list pool with spin lock" : "Concurrent pool" ), threadCount );
+				benchmark::addResult( resultName, iterationCount * PoolAllocatorBenchmarkBatchSize * threadCount, time );
+				benchmark::useValue( result );
+
+				if ( threadCount >= processorCount )
+				{
+					break;
+				}
+				threadCount = TIKI_MIN( threadCount * 2u, processorCount );
+			}
+		}
+
+		concurrentPool.dispose();
+		lockedPool.dispose();
+	}
+}
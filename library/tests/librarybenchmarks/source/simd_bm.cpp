@@ -0,0 +1,455 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/float16.hpp"
+#include "tiki/base/float32.hpp"
+#include "tiki/base/memory.hpp"
+#include "tiki/base/simd.hpp"
+#include "tiki/base/simdkernels.hpp"
+#include "tiki/base/string.hpp"
+
+#include <math.h>
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( Simd );
+
+	enum
+	{
+		// 6 streams of 64k floats fit into the l2 cache of most cpus
+		SimdBenchmarkElementCount	= 64u * 1024u,
+		SimdBenchmarkRoundCount		= 64u,
+
+		// a 2048x2048 rgba image is much larger than the caches
+		SimdBenchmarkImageCount			= 2048u * 2048u * 4u,
+		SimdBenchmarkImageRoundCount	= 4u
+	};
+
+	static float* createSimdBenchmarkStream( uint count, uint32 seed )
+	{
+		float* pStream = TIKI_MEMORY_NEW_ARRAY( float, count, false );
+
+		uint32 state = seed;
+		for (uint i = 0u; i < count; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			pStream[ i ] = float( state >> 8u ) / float( 1u << 24u );
+		}
+
+		return pStream;
+	}
+
+	TIKI_ADD_BENCHMARK( SimdKernelStreams )
+	{
+		const uint count = SimdBenchmarkElementCount;
+
+		float* pP0		= createSimdBenchmarkStream( count, 1u );
+		float* pT0		= createSimdBenchmarkStream( count, 2u );
+		float* pP1		= createSimdBenchmarkStream( count, 3u );
+		float* pT1		= createSimdBenchmarkStream( count, 4u );
+		float* pTime	= createSimdBenchmarkStream( count, 5u );
+		float* pTarget	= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+
+		sint16* pShorts = TIKI_MEMORY_NEW_ARRAY( sint16, count, false );
+		for (uint i = 0u; i < count; ++i)
+		{
+			pShorts[ i ] = sint16( pP0[ i ] * 65535.0f - 32768.0f );
+		}
+
+		char resultName[ 128u ];
+		for (uint level = 0u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if ( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			const char* pLevelName = simd::getKernelLevelName( (SimdKernelLevel)level );
+
+			double startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+			{
+				pKernels->pConvertInt16ToFloat( pTarget, pShorts, 3.0518513e-005f, count );
+			}
+			double time = benchmark::getTime() - startTime;
+			benchmark::useValue( pTarget[ count - 1u ] );
+
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "convert int16 %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+			{
+				pKernels->pMultiplyAdd( pTarget, pP0, pT0, pP1, count );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( pTarget[ count - 1u ] );
+
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "multiply add %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+			{
+				pKernels->pHermite( pTarget, pP0, pT0, pP1, pT1, pTime, count );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( pTarget[ count - 1u ] );
+
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "hermite %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+		}
+
+		TIKI_MEMORY_DELETE_ARRAY( pShorts, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTarget, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTime, count );
+		TIKI_MEMORY_DELETE_ARRAY( pT1, count );
+		TIKI_MEMORY_DELETE_ARRAY( pP1, count );
+		TIKI_MEMORY_DELETE_ARRAY( pT0, count );
+		TIKI_MEMORY_DELETE_ARRAY( pP0, count );
+	}
+
+	// the per joint hermite of the animation sampling. once with the simd backend of this build and once lane by
+	// lane like the float emulation backend does it.
+	TIKI_ADD_BENCHMARK( SimdAnimationSampling )
+	{
+		const uint jointCount	= SimdBenchmarkElementCount / 4u;
+		const uint count		= jointCount * 4u;
+
+		float* pP0		= createSimdBenchmarkStream( count, 1u );
+		float* pT0		= createSimdBenchmarkStream( count, 2u );
+		float* pP1		= createSimdBenchmarkStream( count, 3u );
+		float* pT1		= createSimdBenchmarkStream( count, 4u );
+		float* pTime	= createSimdBenchmarkStream( count, 5u );
+		float* pTarget	= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+
+		char resultName[ 128u ];
+
+		double startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			for (uint joint = 0u; joint < jointCount; ++joint)
+			{
+				const uint offset = joint * 4u;
+				const float time = pTime[ joint ];
+				for (uint component = 0u; component < 4u; ++component)
+				{
+					const uint i = offset + component;
+					const float delta	= pP1[ i ] - pP0[ i ];
+					const float c2		= 3.0f * delta - 2.0f * pT0[ i ] - pT1[ i ];
+					const float c3		= pT0[ i ] + pT1[ i ] - 2.0f * delta;
+
+					pTarget[ i ] = pP0[ i ] + time * ( pT0[ i ] + time * ( c2 + time * c3 ) );
+				}
+			}
+		}
+		double time = benchmark::getTime() - startTime;
+		benchmark::useValue( pTarget[ count - 1u ] );
+
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "emulation per joint, %u joints", jointCount );
+		benchmark::addResult( resultName, jointCount * SimdBenchmarkRoundCount, time );
+
+		const vf32 two		= simd::set_f32( 2.0f );
+		const vf32 three	= simd::set_f32( 3.0f );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			for (uint joint = 0u; joint < jointCount; ++joint)
+			{
+				const uint offset = joint * 4u;
+				const vf32 simdTime	= simd::set_f32( pTime[ joint ] );
+				const vf32 p0		= simd::set_f32u( pP0, offset );
+				const vf32 t0		= simd::set_f32u( pT0, offset );
+				const vf32 t1		= simd::set_f32u( pT1, offset );
+				const vf32 delta	= simd::sub_f32( simd::set_f32u( pP1, offset ), p0 );
+
+				const vf32 c2 = simd::sub_f32( simd::mulsub_f32( three, delta, simd::mul_f32( two, t0 ) ), t1 );
+				const vf32 c3 = simd::negmulsub_f32( two, delta, simd::add_f32( t0, t1 ) );
+
+				vf32 result = simd::muladd_f32( simdTime, c3, c2 );
+				result = simd::muladd_f32( simdTime, result, t0 );
+				result = simd::muladd_f32( simdTime, result, p0 );
+
+				simd::get_f32( pTarget, offset, result );
+			}
+		}
+		time = benchmark::getTime() - startTime;
+		benchmark::useValue( pTarget[ count - 1u ] );
+
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "simd backend per joint, %u joints", jointCount );
+		benchmark::addResult( resultName, jointCount * SimdBenchmarkRoundCount, time );
+
+		TIKI_MEMORY_DELETE_ARRAY( pTarget, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTime, count );
+		TIKI_MEMORY_DELETE_ARRAY( pT1, count );
+		TIKI_MEMORY_DELETE_ARRAY( pP1, count );
+		TIKI_MEMORY_DELETE_ARRAY( pT0, count );
+		TIKI_MEMORY_DELETE_ARRAY( pP0, count );
+	}
+
+	struct SimdBenchmarkCrtSin		{ float operator()( float x ) const { return sinf( x ); } };
+	struct SimdBenchmarkCrtExp		{ float operator()( float x ) const { return expf( x ); } };
+	struct SimdBenchmarkCrtLog		{ float operator()( float x ) const { return logf( x ); } };
+	struct SimdBenchmarkCrtRsqrt	{ float operator()( float x ) const { return 1.0f / sqrtf( x ); } };
+	struct SimdBenchmarkApproximatedSin		{ float operator()( float x ) const { return f32::approximatedSin( x ); } };
+	struct SimdBenchmarkApproximatedExp		{ float operator()( float x ) const { return f32::approximatedExp( x ); } };
+	struct SimdBenchmarkApproximatedLog		{ float operator()( float x ) const { return f32::approximatedLog( x ); } };
+	struct SimdBenchmarkApproximatedRsqrt	{ float operator()( float x ) const { return f32::approximatedInverseSquareRoot( x ); } };
+
+	template< typename TFunction >
+	static void runSimdBenchmarkFunction( const char* pName, float* pTarget, const float* pSource, uint count, TFunction function )
+	{
+		const double startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pTarget[ i ] = function( pSource[ i ] );
+			}
+		}
+		const double time = benchmark::getTime() - startTime;
+		benchmark::useValue( f32::abs( pTarget[ count - 1u ] ) );
+
+		char resultName[ 128u ];
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, %u elements", pName, count );
+		benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+	}
+
+	static void runSimdBenchmarkKernel( const char* pName, const char* pLevelName, void (*pKernel)( float*, const float*, uint ), float* pTarget, const float* pSource, uint count )
+	{
+		const double startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			pKernel( pTarget, pSource, count );
+		}
+		const double time = benchmark::getTime() - startTime;
+		benchmark::useValue( f32::abs( pTarget[ count - 1u ] ) );
+
+		char resultName[ 128u ];
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s %s, %u elements", pName, pLevelName, count );
+		benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+	}
+
+	// the crt against the scalar approximations in f32 and the kernel levels
+	TIKI_ADD_BENCHMARK( SimdApproximations )
+	{
+		const uint count = SimdBenchmarkElementCount;
+
+		float* pAngles		= createSimdBenchmarkStream( count, 6u );
+		float* pPositive	= createSimdBenchmarkStream( count, 7u );
+		float* pExponents	= createSimdBenchmarkStream( count, 8u );
+		float* pTarget		= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float* pTarget2		= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		for (uint i = 0u; i < count; ++i)
+		{
+			pAngles[ i ]	= ( pAngles[ i ] - 0.5f ) * 8.0f * f32::pi;
+			pPositive[ i ]	= 0.001f + pPositive[ i ] * 1000.0f;
+			pExponents[ i ]	= ( pExponents[ i ] - 0.5f ) * 40.0f;
+		}
+
+		runSimdBenchmarkFunction( "sin crt", pTarget, pAngles, count, SimdBenchmarkCrtSin() );
+		runSimdBenchmarkFunction( "sin approximated", pTarget, pAngles, count, SimdBenchmarkApproximatedSin() );
+		runSimdBenchmarkFunction( "exp crt", pTarget, pExponents, count, SimdBenchmarkCrtExp() );
+		runSimdBenchmarkFunction( "exp approximated", pTarget, pExponents, count, SimdBenchmarkApproximatedExp() );
+		runSimdBenchmarkFunction( "log crt", pTarget, pPositive, count, SimdBenchmarkCrtLog() );
+		runSimdBenchmarkFunction( "log approximated", pTarget, pPositive, count, SimdBenchmarkApproximatedLog() );
+		runSimdBenchmarkFunction( "rsqrt crt", pTarget, pPositive, count, SimdBenchmarkCrtRsqrt() );
+		runSimdBenchmarkFunction( "rsqrt approximated", pTarget, pPositive, count, SimdBenchmarkApproximatedRsqrt() );
+
+		char resultName[ 128u ];
+
+		double startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pTarget[ i ] = atan2f( pAngles[ i ], pExponents[ i ] );
+			}
+		}
+		double time = benchmark::getTime() - startTime;
+		benchmark::useValue( f32::abs( pTarget[ count - 1u ] ) );
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "atan2 crt, %u elements", count );
+		benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pTarget[ i ] = f32::approximatedAtan2( pAngles[ i ], pExponents[ i ] );
+			}
+		}
+		time = benchmark::getTime() - startTime;
+		benchmark::useValue( f32::abs( pTarget[ count - 1u ] ) );
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "atan2 approximated, %u elements", count );
+		benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+
+		// sin and cos of the same angle like quaternion::fromYawPitchRoll
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pTarget[ i ]	= sinf( pAngles[ i ] );
+				pTarget2[ i ]	= cosf( pAngles[ i ] );
+			}
+		}
+		time = benchmark::getTime() - startTime;
+		benchmark::useValue( f32::abs( pTarget[ count - 1u ] + pTarget2[ count - 1u ] ) );
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "sincos crt, %u elements", count );
+		benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				f32::approximatedSinCos( pTarget[ i ], pTarget2[ i ], pAngles[ i ] );
+			}
+		}
+		time = benchmark::getTime() - startTime;
+		benchmark::useValue( f32::abs( pTarget[ count - 1u ] + pTarget2[ count - 1u ] ) );
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "sincos approximated, %u elements", count );
+		benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+
+		for (uint level = 0u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if ( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			const char* pLevelName = simd::getKernelLevelName( (SimdKernelLevel)level );
+			runSimdBenchmarkKernel( "sin", pLevelName, pKernels->pSin, pTarget, pAngles, count );
+			runSimdBenchmarkKernel( "exp", pLevelName, pKernels->pExp, pTarget, pExponents, count );
+			runSimdBenchmarkKernel( "log", pLevelName, pKernels->pLog, pTarget, pPositive, count );
+			runSimdBenchmarkKernel( "rsqrt", pLevelName, pKernels->pInverseSquareRoot, pTarget, pPositive, count );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+			{
+				pKernels->pAtan2( pTarget, pAngles, pExponents, count );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( f32::abs( pTarget[ count - 1u ] ) );
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "atan2 %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkRoundCount; ++round)
+			{
+				pKernels->pSinCos( pTarget, pTarget2, pAngles, count );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( f32::abs( pTarget[ count - 1u ] + pTarget2[ count - 1u ] ) );
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "sincos %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkRoundCount, time );
+		}
+
+		TIKI_MEMORY_DELETE_ARRAY( pTarget2, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTarget, count );
+		TIKI_MEMORY_DELETE_ARRAY( pExponents, count );
+		TIKI_MEMORY_DELETE_ARRAY( pPositive, count );
+		TIKI_MEMORY_DELETE_ARRAY( pAngles, count );
+	}
+
+	// the copy of the source is the limit of the memory bandwidth
+	TIKI_ADD_BENCHMARK( SimdImagePacking )
+	{
+		const uint count = SimdBenchmarkImageCount;
+
+		float* pSource		= createSimdBenchmarkStream( count, 9u );
+		float* pTarget		= TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float16* pHalfs		= TIKI_MEMORY_NEW_ARRAY( float16, count, false );
+		uint8* pBytes		= TIKI_MEMORY_NEW_ARRAY( uint8, count, false );
+		uint32* pPacked		= TIKI_MEMORY_NEW_ARRAY( uint32, count / 4u, false );
+		for (uint i = 0u; i < count; ++i)
+		{
+			pSource[ i ] = pSource[ i ] * 1.5f - 0.25f;
+		}
+
+		char resultName[ 128u ];
+
+		double startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkImageRoundCount; ++round)
+		{
+			memory::copy( pTarget, pSource, count * sizeof( float ) );
+		}
+		double time = benchmark::getTime() - startTime;
+		benchmark::useValue( f32::abs( pTarget[ count - 1u ] ) );
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "copy float32, %u elements", count );
+		benchmark::addResult( resultName, count * SimdBenchmarkImageRoundCount, time );
+
+		startTime = benchmark::getTime();
+		for (uint round = 0u; round < SimdBenchmarkImageRoundCount; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				pHalfs[ i ] = f16::convertFloat32to16( pSource[ i ] );
+			}
+		}
+		time = benchmark::getTime() - startTime;
+		benchmark::useValue( pHalfs[ count - 1u ] );
+		formatStringBuffer( resultName, TIKI_COUNT( resultName ), "float32 to float16 per element, %u elements", count );
+		benchmark::addResult( resultName, count * SimdBenchmarkImageRoundCount, time );
+
+		for (uint level = 0u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if ( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			const char* pLevelName = simd::getKernelLevelName( (SimdKernelLevel)level );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkImageRoundCount; ++round)
+			{
+				pKernels->pConvertFloat32ToFloat16( pHalfs, pSource, count );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( pHalfs[ count - 1u ] );
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "float32 to float16 %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkImageRoundCount, time );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkImageRoundCount; ++round)
+			{
+				pKernels->pConvertFloat16ToFloat32( pTarget, pHalfs, count );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( f32::abs( pTarget[ count - 1u ] ) );
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "float16 to float32 %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkImageRoundCount, time );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkImageRoundCount; ++round)
+			{
+				pKernels->pPackUnorm8( pBytes, pSource, count );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( pBytes[ count - 1u ] );
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "pack unorm8 %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkImageRoundCount, time );
+
+			startTime = benchmark::getTime();
+			for (uint round = 0u; round < SimdBenchmarkImageRoundCount; ++round)
+			{
+				pKernels->pPackUnorm1010102( pPacked, pSource, count / 4u );
+			}
+			time = benchmark::getTime() - startTime;
+			benchmark::useValue( pPacked[ count / 4u - 1u ] );
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "pack unorm 10:10:10:2 %s, %u elements", pLevelName, count );
+			benchmark::addResult( resultName, count * SimdBenchmarkImageRoundCount, time );
+		}
+
+		TIKI_MEMORY_DELETE_ARRAY( pPacked, count / 4u );
+		TIKI_MEMORY_DELETE_ARRAY( pBytes, count );
+		TIKI_MEMORY_DELETE_ARRAY( pHalfs, count );
+		TIKI_MEMORY_DELETE_ARRAY( pTarget, count );
+		TIKI_MEMORY_DELETE_ARRAY( pSource, count );
+	}
+}
@@ -0,0 +1,91 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/base/sort.hpp"
+#include "tiki/base/string.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( Sort );
+
+	// like a render command: a 64 bit sort key and a payload
+	struct SortBenchmarkCommand
+	{
+		uint64	key;
+		uint32	aPayload[ 2u ];
+
+		bool operator<( const SortBenchmarkCommand& rhs ) const { return key < rhs.key; }
+	};
+
+	struct SortBenchmarkKeyExtractor
+	{
+		uint64 operator()( const SortBenchmarkCommand& command ) const { return command.key; }
+	};
+
+	// depth sorted particles only need 32 bits
+	struct SortBenchmarkDepthKeyExtractor
+	{
+		uint32 operator()( const SortBenchmarkCommand& command ) const { return uint32( command.key ); }
+	};
+
+	static void fillSortBenchmarkCommands( SortBenchmarkCommand* pCommands, uint count, uint64 keyMask )
+	{
+		uint64 state = 0x9e3779b97f4a7c15ull;
+		for (uint i = 0u; i < count; ++i)
+		{
+			state ^= state << 13u;
+			state ^= state >> 7u;
+			state ^= state << 17u;
+
+			pCommands[ i ].key			= state & keyMask;
+			pCommands[ i ].aPayload[ 0u ]	= uint32( i );
+			pCommands[ i ].aPayload[ 1u ]	= 0u;
+		}
+	}
+
+	TIKI_ADD_BENCHMARK( SortCommands )
+	{
+		const uint counts[] = { 1000u, 10000u, 100000u };
+
+		char resultName[ 128u ];
+		for (uint countIndex = 0u; countIndex < TIKI_COUNT( counts ); ++countIndex)
+		{
+			const uint count = counts[ countIndex ];
+			SortBenchmarkCommand* pCommands	= TIKI_MEMORY_NEW_ARRAY( SortBenchmarkCommand, count, false );
+			SortBenchmarkCommand* pScratch	= TIKI_MEMORY_NEW_ARRAY( SortBenchmarkCommand, count, false );
+
+			fillSortBenchmarkCommands( pCommands, count, 0xffffffffffffffffull );
+			double startTime = benchmark::getTime();
+			quickSort( pCommands, count );
+			double time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "introsort, 64 bit keys, %u elements", count );
+			benchmark::addResult( resultName, count, time );
+
+			// already sorted input was the worst case of the old quicksort
+			startTime = benchmark::getTime();
+			quickSort( pCommands, count );
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "introsort, sorted input, %u elements", count );
+			benchmark::addResult( resultName, count, time );
+
+			fillSortBenchmarkCommands( pCommands, count, 0xffffffffffffffffull );
+			startTime = benchmark::getTime();
+			radixSort( pCommands, pScratch, count, SortBenchmarkKeyExtractor() );
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "radix sort, 64 bit keys, %u elements", count );
+			benchmark::addResult( resultName, count, time );
+
+			fillSortBenchmarkCommands( pCommands, count, 0xffffffffull );
+			startTime = benchmark::getTime();
+			radixSort( pCommands, pScratch, count, SortBenchmarkDepthKeyExtractor() );
+			time = benchmark::getTime() - startTime;
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "radix sort, 32 bit keys, %u elements", count );
+			benchmark::addResult( resultName, count, time );
+
+			benchmark::useValue( pCommands[ count / 2u ].key );
+
+			TIKI_MEMORY_DELETE_ARRAY( pCommands, count );
+			TIKI_MEMORY_DELETE_ARRAY( pScratch, count );
+		}
+	}
+}
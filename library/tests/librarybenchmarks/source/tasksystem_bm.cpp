@@ -0,0 +1,136 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/platform.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/tasksystem/taskcontext.hpp"
+#include "tiki/tasksystem/tasksystem.hpp"
+#include "tiki/threading/atomic.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( TaskSystem );
+
+	struct TaskSystemBenchmarkData
+	{
+		TaskSystem*		pTaskSystem;
+		uint			iterationCount;
+		uint			childTaskCount;
+		AtomicUInt64	result;
+	};
+
+	static uint64 doTaskSystemBenchmarkWork( uint iterationCount )
+	{
+		uint64 value = 0x9e3779b97f4a7c15ull;
+		for (uint i = 0u; i < iterationCount; ++i)
+		{
+			value ^= value << 13u;
+			value ^= value >> 7u;
+			value ^= value << 17u;
+		}
+
+		return value;
+	}
+
+	static uint calibrateTaskSystemBenchmarkWork( double taskDuration )
+	{
+		const uint calibrationIterationCount = 1000000u;
+
+		const double startTime = benchmark::getTime();
+		benchmark::useValue( doTaskSystemBenchmarkWork( calibrationIterationCount ) );
+		const double iterationTime = ( benchmark::getTime() - startTime ) / double( calibrationIterationCount );
+
+		const uint iterationCount = uint( taskDuration / iterationTime );
+		return TIKI_MAX( iterationCount, 1u );
+	}
+
+	static void taskSystemBenchmarkWorkTask( const TaskContext& context )
+	{
+		TaskSystemBenchmarkData& data = *static_cast< TaskSystemBenchmarkData* >( context.pTaskData );
+		data.result.fetchAdd( doTaskSystemBenchmarkWork( data.iterationCount ) & 1u, AtomicOrder_Relaxed );
+	}
+
+	static void taskSystemBenchmarkSpawnTask( const TaskContext& context )
+	{
+		TaskSystemBenchmarkData& data = *static_cast< TaskSystemBenchmarkData* >( context.pTaskData );
+		for (uint i = 0u; i < data.childTaskCount; ++i)
+		{
+			data.pTaskSystem->queueTask( taskSystemBenchmarkWorkTask, &data );
+		}
+	}
+
+	static void runTaskSystemScaling( const char* pName, double taskDuration, uint taskCount, bool spawnFromTasks )
+	{
+		TaskSystemBenchmarkData data;
+		data.pTaskSystem	= nullptr;
+		data.iterationCount	= calibrateTaskSystemBenchmarkWork( taskDuration );
+		data.childTaskCount	= 0u;
+
+		const uint processorCount = platform::getProcessorCount();
+		uint threadCount = 1u;
+		while ( true )
+		{
+			TaskSystemParameters parameters;
+			parameters.threadCount	= threadCount;
+			parameters.maxTaskCount	= 4096u;
+
+			TaskSystem taskSystem;
+			if ( !taskSystem.create( parameters ) )
+			{
+				debug::trace( "\t\tunable to create TaskSystem with %u threads\n", threadCount );
+				return;
+			}
+			data.pTaskSystem = &taskSystem;
+
+			uint queuedTaskCount = taskCount;
+			const double startTime = benchmark::getTime();
+			if ( spawnFromTasks )
+			{
+				// every worker fills its own queue, the other workers have to steal
+				data.childTaskCount	= taskCount / threadCount;
+				queuedTaskCount		= data.childTaskCount * threadCount;
+				for (uint i = 0u; i < threadCount; ++i)
+				{
+					taskSystem.queueTask( taskSystemBenchmarkSpawnTask, &data );
+				}
+			}
+			else
+			{
+				for (uint i = 0u; i < taskCount; ++i)
+				{
+					taskSystem.queueTask( taskSystemBenchmarkWorkTask, &data );
+				}
+			}
+			taskSystem.waitForAllTasks();
+			const double time = benchmark::getTime() - startTime;
+
+			taskSystem.dispose();
+
+			char resultName[ 128u ];
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "%s, %u threads", pName, threadCount );
+			benchmark::addResult( resultName, queuedTaskCount, time );
+
+			if ( threadCount == processorCount )
+			{
+				break;
+			}
+			threadCount = TIKI_MIN( threadCount * 2u, processorCount );
+		}
+
+		benchmark::useValue( data.result.load() );
+	}
+
+	TIKI_ADD_BENCHMARK( TaskSystemTinyTasks )
+	{
+		runTaskSystemScaling( "1us tasks", 0.000001, 200000u, false );
+	}
+
+	TIKI_ADD_BENCHMARK( TaskSystemTinyTasksSpawnedFromTasks )
+	{
+		runTaskSystemScaling( "1us tasks spawned from tasks", 0.000001, 200000u, true );
+	}
+
+	TIKI_ADD_BENCHMARK( TaskSystemMediumTasks )
+	{
+		runTaskSystemScaling( "100us tasks", 0.0001, 10000u, false );
+	}
+}
@@ -0,0 +1,181 @@
+#include "tiki/benchmark/benchmark.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/base/platform.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/threading/event.hpp"
+#include "tiki/threading/mutex.hpp"
+#include "tiki/threading/semaphore.hpp"
+#include "tiki/threading/thread.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_BENCHMARK( Threading );
+
+	enum
+	{
+		ThreadingBenchmarkMaxThreadCount	= 16u,
+		ThreadingBenchmarkLockCount			= 1000000u,
+		ThreadingBenchmarkRoundTripCount	= 20000u
+	};
+
+	struct ThreadingBenchmarkData
+	{
+		Mutex		mutex;
+		uint64		counter;
+		uint		lockCount;
+
+		Semaphore	pingSemaphore;
+		Semaphore	pongSemaphore;
+		Event		pingEvent;
+		Event		pongEvent;
+	};
+
+	static int threadingBenchmarkMutexThread( const Thread& thread )
+	{
+		ThreadingBenchmarkData& data = *static_cast< ThreadingBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < data.lockCount; ++i)
+		{
+			MutexStackLock lock( data.mutex );
+			data.counter++;
+		}
+
+		return 0;
+	}
+
+	static int threadingBenchmarkSemaphoreThread( const Thread& thread )
+	{
+		ThreadingBenchmarkData& data = *static_cast< ThreadingBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < ThreadingBenchmarkRoundTripCount; ++i)
+		{
+			data.pingSemaphore.decrement();
+			data.pongSemaphore.incement();
+		}
+
+		return 0;
+	}
+
+	static int threadingBenchmarkEventThread( const Thread& thread )
+	{
+		ThreadingBenchmarkData& data = *static_cast< ThreadingBenchmarkData* >( thread.getArgument() );
+		for (uint i = 0u; i < ThreadingBenchmarkRoundTripCount; ++i)
+		{
+			data.pingEvent.waitForSignal();
+			data.pongEvent.signal();
+		}
+
+		return 0;
+	}
+
+	TIKI_ADD_BENCHMARK( MutexUncontended )
+	{
+		Mutex mutex;
+		mutex.create();
+
+		uint64 counter = 0u;
+		const double startTime = benchmark::getTime();
+		for (uint i = 0u; i < ThreadingBenchmarkLockCount; ++i)
+		{
+			mutex.lock();
+			counter++;
+			mutex.unlock();
+		}
+		benchmark::addResult( "Mutex lock/unlock", ThreadingBenchmarkLockCount, benchmark::getTime() - startTime );
+		benchmark::useValue( counter );
+
+		mutex.dispose();
+	}
+
+	TIKI_ADD_BENCHMARK( MutexContention )
+	{
+		ThreadingBenchmarkData* pData = TIKI_MEMORY_NEW_OBJECT( ThreadingBenchmarkData );
+		ThreadingBenchmarkData& data = *pData;
+		data.mutex.create();
+
+		const uint processorCount = TIKI_MIN( platform::getProcessorCount(), (uint)ThreadingBenchmarkMaxThreadCount );
+		uint threadCount = 2u;
+		while ( true )
+		{
+			data.counter	= 0u;
+			data.lockCount	= ThreadingBenchmarkLockCount / threadCount;
+
+			Thread threads[ ThreadingBenchmarkMaxThreadCount ];
+			const double startTime = benchmark::getTime();
+			for (uint i = 0u; i < threadCount; ++i)
+			{
+				TIKI_VERIFY( threads[ i ].create( threadingBenchmarkMutexThread, &data, 0u, "ThreadingBenchmark" ) );
+			}
+
+			for (uint i = 0u; i < threadCount; ++i)
+			{
+				threads[ i ].waitForExit();
+				threads[ i ].dispose();
+			}
+			const double time = benchmark::getTime() - startTime;
+
+			char resultName[ 128u ];
+			formatStringBuffer( resultName, TIKI_COUNT( resultName ), "Mutex, %u threads", threadCount );
+			benchmark::addResult( resultName, data.lockCount * threadCount, time );
+
+			if ( threadCount >= processorCount )
+			{
+				break;
+			}
+			threadCount = TIKI_MIN( threadCount * 2u, processorCount );
+		}
+
+		benchmark::useValue( data.counter );
+
+		data.mutex.dispose();
+		TIKI_MEMORY_DELETE_OBJECT( pData );
+	}
+
+	// signal/wait round trips between two threads. measures how fast a waiting thread wakes up.
+	TIKI_ADD_BENCHMARK( WakeLatency )
+	{
+		ThreadingBenchmarkData* pData = TIKI_MEMORY_NEW_OBJECT( ThreadingBenchmarkData );
+		ThreadingBenchmarkData& data = *pData;
+		data.pingSemaphore.create();
+		data.pongSemaphore.create();
+		data.pingEvent.create();
+		data.pongEvent.create();
+
+		{
+			Thread thread;
+			TIKI_VERIFY( thread.create( threadingBenchmarkSemaphoreThread, &data, 0u, "ThreadingBenchmark" ) );
+
+			const double startTime = benchmark::getTime();
+			for (uint i = 0u; i < ThreadingBenchmarkRoundTripCount; ++i)
+			{
+				data.pingSemaphore.incement();
+				data.pongSemaphore.decrement();
+			}
+			benchmark::addResult( "Semaphore round trip", ThreadingBenchmarkRoundTripCount, benchmark::getTime() - startTime );
+
+			thread.waitForExit();
+			thread.dispose();
+		}
+
+		{
+			Thread thread;
+			TIKI_VERIFY( thread.create( threadingBenchmarkEventThread, &data, 0u, "ThreadingBenchmark" ) );
+
+			const double startTime = benchmark::getTime();
+			for (uint i = 0u; i < ThreadingBenchmarkRoundTripCount; ++i)
+			{
+				data.pingEvent.signal();
+				data.pongEvent.waitForSignal();
+			}
+			benchmark::addResult( "Event round trip", ThreadingBenchmarkRoundTripCount, benchmark::getTime() - startTime );
+
+			thread.waitForExit();
+			thread.dispose();
+		}
+
+		data.pongEvent.dispose();
+		data.pingEvent.dispose();
+		data.pongSemaphore.dispose();
+		data.pingSemaphore.dispose();
+		TIKI_MEMORY_DELETE_OBJECT( pData );
+	}
+}
@@ -7,7 +7,10 @@ module:add_files( "libraryunittests.lua" );
 
 module:add_dependency( "config" );
 module:add_dependency( "base" );
+module:add_dependency( "container" );
 module:add_dependency( "math" );
+module:add_dependency( "tasksystem" );
+module:add_dependency( "threading" );
 module:add_dependency( "webserver" );
 module:add_dependency( "unittest" );
 
@@ -0,0 +1,267 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/container/list.hpp"
+#include "tiki/math/boundingvolumehierarchy.hpp"
+#include "tiki/math/camera.hpp"
+#include "tiki/math/ray.hpp"
+#include "tiki/math/sphere.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( BoundingVolumeHierarchy );
+
+	enum
+	{
+		BoundingVolumeHierarchyTestCount	= 2000u
+	};
+
+	static float getBoundingVolumeHierarchyTestValue( uint32& state )
+	{
+		state = state * 1664525u + 1013904223u;
+		return float( state >> 8u ) / float( 1u << 24u ) * 2.0f - 1.0f;
+	}
+
+	static void createBoundingVolumeHierarchyTestBox( AxisAlignedBox& box, uint32& state, float range )
+	{
+		const Vector3 center	= vector::create( getBoundingVolumeHierarchyTestValue( state ) * range, getBoundingVolumeHierarchyTestValue( state ) * range, getBoundingVolumeHierarchyTestValue( state ) * range );
+		const Vector3 size		= vector::create( 0.1f + f32::abs( getBoundingVolumeHierarchyTestValue( state ) ) * 4.0f, 0.1f + f32::abs( getBoundingVolumeHierarchyTestValue( state ) ) * 4.0f, 0.1f + f32::abs( getBoundingVolumeHierarchyTestValue( state ) ) * 4.0f );
+		box.createFromCenterExtends( center, size );
+	}
+
+	static bool isBoundingVolumeHierarchyTestOverlapping( const AxisAlignedBox& box1, const AxisAlignedBox& box2 )
+	{
+		return box1.min.x <= box2.max.x && box1.min.y <= box2.max.y && box1.min.z <= box2.max.z &&
+			box2.min.x <= box1.max.x && box2.min.y <= box1.max.y && box2.min.z <= box1.max.z;
+	}
+
+	// the user data is the index + 1 of the proxy, every index has to be found exactly once
+	static bool checkBoundingVolumeHierarchyResults( const List< void* >& results, const bool* pExpected, uint count )
+	{
+		uint aFoundCounts[ BoundingVolumeHierarchyTestCount ] = { 0u };
+		for (uint i = 0u; i < results.getCount(); ++i)
+		{
+			const uint index = (uint)results[ i ] - 1u;
+			if( index >= count )
+			{
+				return false;
+			}
+			aFoundCounts[ index ]++;
+		}
+
+		for (uint i = 0u; i < count; ++i)
+		{
+			if( aFoundCounts[ i ] != ( pExpected[ i ] ? 1u : 0u ) )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	TIKI_ADD_TEST( BoundingVolumeHierarchyInsertRemoveMove )
+	{
+		const uint count = BoundingVolumeHierarchyTestCount;
+
+		BoundingVolumeHierarchy hierarchy;
+		TIKI_UT_CHECK( hierarchy.create( 0.5f, 16u ) );
+
+		uint32 state = 3u;
+		uint32 aProxyIds[ BoundingVolumeHierarchyTestCount ];
+		bool aAlive[ BoundingVolumeHierarchyTestCount ];
+		for (uint i = 0u; i < count; ++i)
+		{
+			AxisAlignedBox box;
+			createBoundingVolumeHierarchyTestBox( box, state, 100.0f );
+
+			aProxyIds[ i ]	= hierarchy.addProxy( box, (void*)uint( i + 1u ) );
+			aAlive[ i ]		= true;
+
+			// the fat box contains the box
+			const AxisAlignedBox& fatBox = hierarchy.getFatBox( aProxyIds[ i ] );
+			TIKI_UT_CHECK( fatBox.contains( box.min ) && fatBox.contains( box.max ) );
+			TIKI_UT_CHECK( fatBox.min.x < box.min.x );
+		}
+		TIKI_UT_CHECK( hierarchy.getProxyCount() == count );
+
+		// log2( 2000 ) is about 11, the rotations keep the height close to it
+		TIKI_UT_CHECK( hierarchy.getHeight() >= 11u && hierarchy.getHeight() <= 22u );
+
+		// small movements stay in the fat box
+		{
+			AxisAlignedBox box = hierarchy.getFatBox( aProxyIds[ 0u ] );
+			box.extend( vector::create( -0.5f, -0.5f, -0.5f ) );
+			box.translate( vector::create( 0.25f, 0.0f, 0.0f ) );
+			TIKI_UT_CHECK( !hierarchy.moveProxy( aProxyIds[ 0u ], box ) );
+		}
+
+		// remove every third and move the rest
+		for (uint i = 0u; i < count; ++i)
+		{
+			if( i % 3u == 0u )
+			{
+				hierarchy.removeProxy( aProxyIds[ i ] );
+				aAlive[ i ] = false;
+			}
+			else
+			{
+				AxisAlignedBox box;
+				createBoundingVolumeHierarchyTestBox( box, state, 100.0f );
+				const bool inside = hierarchy.getFatBox( aProxyIds[ i ] ).contains( box.min ) && hierarchy.getFatBox( aProxyIds[ i ] ).contains( box.max );
+				TIKI_UT_CHECK( hierarchy.moveProxy( aProxyIds[ i ], box ) == !inside );
+
+				const AxisAlignedBox& fatBox = hierarchy.getFatBox( aProxyIds[ i ] );
+				TIKI_UT_CHECK( fatBox.contains( box.min ) && fatBox.contains( box.max ) );
+			}
+		}
+		TIKI_UT_CHECK( hierarchy.getProxyCount() == count - ( count + 2u ) / 3u );
+
+		// freed nodes are reused
+		for (uint i = 0u; i < count; i += 3u)
+		{
+			AxisAlignedBox box;
+			createBoundingVolumeHierarchyTestBox( box, state, 100.0f );
+
+			aProxyIds[ i ]	= hierarchy.addProxy( box, (void*)uint( i + 1u ) );
+			aAlive[ i ]		= true;
+		}
+		TIKI_UT_CHECK( hierarchy.getProxyCount() == count );
+		TIKI_UT_CHECK( hierarchy.getHeight() <= 22u );
+
+		for (uint i = 0u; i < count; ++i)
+		{
+			TIKI_UT_CHECK( hierarchy.getUserData( aProxyIds[ i ] ) == (void*)uint( i + 1u ) );
+		}
+
+		// an infinite query finds everything once
+		List< void* > results;
+		AxisAlignedBox everything;
+		everything.createFromMinMax( -1000.0f, -1000.0f, -1000.0f, 1000.0f, 1000.0f, 1000.0f );
+		hierarchy.queryBox( results, everything );
+		TIKI_UT_CHECK( checkBoundingVolumeHierarchyResults( results, aAlive, count ) );
+
+		for (uint i = 0u; i < count; ++i)
+		{
+			hierarchy.removeProxy( aProxyIds[ i ] );
+		}
+		TIKI_UT_CHECK( hierarchy.getProxyCount() == 0u );
+		TIKI_UT_CHECK( hierarchy.getHeight() == 0u );
+
+		results.clear();
+		hierarchy.queryBox( results, everything );
+		TIKI_UT_CHECK( results.isEmpty() );
+
+		results.dispose();
+		hierarchy.dispose();
+	}
+
+	TIKI_ADD_TEST( BoundingVolumeHierarchyQueries )
+	{
+		const uint count = BoundingVolumeHierarchyTestCount;
+
+		BoundingVolumeHierarchy hierarchy;
+		TIKI_UT_CHECK( hierarchy.create( 0.25f ) );
+
+		uint32 state = 5u;
+		uint32 aProxyIds[ BoundingVolumeHierarchyTestCount ];
+		for (uint i = 0u; i < count; ++i)
+		{
+			AxisAlignedBox box;
+			createBoundingVolumeHierarchyTestBox( box, state, 50.0f );
+			aProxyIds[ i ] = hierarchy.addProxy( box, (void*)uint( i + 1u ) );
+		}
+
+		List< void* > results;
+		bool aExpected[ BoundingVolumeHierarchyTestCount ];
+
+		// the queries are compared with a linear loop over the fat boxes
+		for (uint query = 0u; query < 16u; ++query)
+		{
+			AxisAlignedBox queryBox;
+			createBoundingVolumeHierarchyTestBox( queryBox, state, 50.0f );
+			queryBox.extend( vector::create( 5.0f, 5.0f, 5.0f ) );
+
+			uint expectedCount = 0u;
+			for (uint i = 0u; i < count; ++i)
+			{
+				aExpected[ i ] = isBoundingVolumeHierarchyTestOverlapping( hierarchy.getFatBox( aProxyIds[ i ] ), queryBox );
+				expectedCount += aExpected[ i ];
+			}
+
+			results.clear();
+			hierarchy.queryBox( results, queryBox );
+			TIKI_UT_CHECK( results.getCount() == expectedCount );
+			TIKI_UT_CHECK( checkBoundingVolumeHierarchyResults( results, aExpected, count ) );
+
+			const Sphere sphere( queryBox.getCenter(), 10.0f );
+			for (uint i = 0u; i < count; ++i)
+			{
+				const AxisAlignedBox& fatBox = hierarchy.getFatBox( aProxyIds[ i ] );
+				Vector3 closest = sphere.center;
+				vector::clamp( closest, fatBox.min, fatBox.max );
+				aExpected[ i ] = vector::distanceSquared( closest, sphere.center ) <= sphere.radius * sphere.radius;
+			}
+
+			results.clear();
+			hierarchy.querySphere( results, sphere );
+			TIKI_UT_CHECK( checkBoundingVolumeHierarchyResults( results, aExpected, count ) );
+
+			// ray through the center of the query box
+			Vector3 direction = vector::create( getBoundingVolumeHierarchyTestValue( state ), getBoundingVolumeHierarchyTestValue( state ), getBoundingVolumeHierarchyTestValue( state ) );
+			vector::normalize( direction );
+			Vector3 origin = direction;
+			vector::scale( origin, -60.0f );
+			vector::add( origin, sphere.center );
+			// the constructor asserts an exactly normalized direction, which rounding doesn't always give
+			Ray ray;
+			ray.origin		= origin;
+			ray.direction	= direction;
+			const float maxDistance = 60.0f;
+
+			for (uint i = 0u; i < count; ++i)
+			{
+				// marching along the ray is good enough as reference for boxes of this size
+				const AxisAlignedBox& fatBox = hierarchy.getFatBox( aProxyIds[ i ] );
+				aExpected[ i ] = false;
+				for (uint step = 0u; step <= 6000u && !aExpected[ i ]; ++step)
+				{
+					Vector3 point = direction;
+					vector::scale( point, maxDistance * float( step ) / 6000.0f );
+					vector::add( point, origin );
+					aExpected[ i ] = fatBox.contains( point );
+				}
+			}
+
+			results.clear();
+			hierarchy.queryRay( results, ray, maxDistance );
+			TIKI_UT_CHECK( checkBoundingVolumeHierarchyResults( results, aExpected, count ) );
+		}
+
+		Projection projection;
+		projection.createPerspective( 16.0f, 9.0f, f32::piOver4, 1.0f, 40.0f );
+
+		Camera camera;
+		camera.create( vector::create( 0.0f, 0.0f, -30.0f ), Quaternion::identity, &projection );
+		const Frustum& frustum = camera.getFrustum();
+
+		uint expectedCount = 0u;
+		for (uint i = 0u; i < count; ++i)
+		{
+			aExpected[ i ] = frustum.testIntersectionAxisAlignedBox( hierarchy.getFatBox( aProxyIds[ i ] ) ) != IntersectionTypes_Disjoint;
+			expectedCount += aExpected[ i ];
+		}
+		TIKI_UT_CHECK( expectedCount > 0u && expectedCount < count );
+
+		results.clear();
+		hierarchy.queryFrustum( results, frustum );
+		TIKI_UT_CHECK( checkBoundingVolumeHierarchyResults( results, aExpected, count ) );
+
+		for (uint i = 0u; i < count; ++i)
+		{
+			hierarchy.removeProxy( aProxyIds[ i ] );
+		}
+
+		results.dispose();
+		hierarchy.dispose();
+	}
+}
@@ -0,0 +1,379 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/allocator.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/base/virtualmemoryallocator.hpp"
+#include "tiki/base/zoneallocator.hpp"
+#include "tiki/container/array.hpp"
+#include "tiki/container/hashmap.hpp"
+#include "tiki/container/list.hpp"
+#include "tiki/container/map.hpp"
+#include "tiki/container/queue.hpp"
+#include "tiki/container/sizedarray.hpp"
+#include "tiki/container/soaarray.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Container );
+
+	class CountingTestAllocator : public Allocator
+	{
+	public:
+
+		uint	allocationCount;
+		uint	freeCount;
+
+		CountingTestAllocator()
+			: allocationCount( 0u ), freeCount( 0u )
+		{
+		}
+
+		virtual void* allocate( uint sizeInBytes, uint alignment = TIKI_DEFAULT_ALIGNMENT ) TIKI_OVERRIDE
+		{
+			allocationCount++;
+			return TIKI_MEMORY_ALLOC_ALIGNED( sizeInBytes, alignment );
+		}
+
+		virtual void free( void* pMemory ) TIKI_OVERRIDE
+		{
+			freeCount++;
+			TIKI_MEMORY_FREE( pMemory );
+		}
+	};
+
+	struct ContainerTestElement
+	{
+		uint	value;
+
+		ContainerTestElement() : value( 42u ) { }
+	};
+
+	TIKI_ADD_TEST( ContainerListAllocator )
+	{
+		CountingTestAllocator allocator;
+		{
+			List< uint > list( allocator );
+			for (uint i = 0u; i < 100u; ++i)
+			{
+				list.add( i );
+			}
+			TIKI_UT_CHECK( list.getCount() == 100u );
+			TIKI_UT_CHECK( list.getAllocator() == &allocator );
+
+			// copies don't share the allocator of the source
+			const uint allocationCount = allocator.allocationCount;
+			List< uint > copy( list );
+			TIKI_UT_CHECK( copy.getAllocator() == nullptr );
+			TIKI_UT_CHECK( copy[ 99u ] == 99u );
+			TIKI_UT_CHECK( allocator.allocationCount == allocationCount );
+		}
+
+		TIKI_UT_CHECK( allocator.allocationCount > 0u );
+		TIKI_UT_CHECK( allocator.allocationCount == allocator.freeCount );
+	}
+
+	TIKI_ADD_TEST( ContainerMapAllocator )
+	{
+		CountingTestAllocator allocator;
+		{
+			Map< uint, uint > map( allocator );
+			for (uint i = 0u; i < 64u; ++i)
+			{
+				map.set( 63u - i, i );
+			}
+
+			uint value = 0u;
+			TIKI_UT_CHECK( map.findValue( &value, 0u ) );
+			TIKI_UT_CHECK( value == 63u );
+
+			const uint allocationCount = allocator.allocationCount;
+			Map< uint, uint > copy( map );
+			TIKI_UT_CHECK( copy.findValue( &value, 63u ) && value == 0u );
+			TIKI_UT_CHECK( allocator.allocationCount == allocationCount );
+		}
+
+		TIKI_UT_CHECK( allocator.allocationCount > 0u );
+		TIKI_UT_CHECK( allocator.allocationCount == allocator.freeCount );
+	}
+
+	TIKI_ADD_TEST( ContainerFixedSizeAllocator )
+	{
+		CountingTestAllocator allocator;
+
+		Array< ContainerTestElement > array;
+		TIKI_UT_CHECK( array.create( 16u, TIKI_DEFAULT_ALIGNMENT, true, &allocator ) );
+		TIKI_UT_CHECK( array[ 15u ].value == 42u );
+
+		SizedArray< ContainerTestElement > sizedArray;
+		TIKI_UT_CHECK( sizedArray.create( 16u, 64u, true, &allocator ) );
+		TIKI_UT_CHECK( isPointerAligned( sizedArray.getBegin(), 64u ) );
+
+		Queue< uint > queue;
+		TIKI_UT_CHECK( queue.create( 16u, TIKI_DEFAULT_ALIGNMENT, &allocator ) );
+		queue.push( 7u );
+
+		uint value = 0u;
+		TIKI_UT_CHECK( queue.pop( value ) && value == 7u );
+		TIKI_UT_CHECK( allocator.allocationCount == 3u );
+
+		array.dispose();
+		sizedArray.dispose();
+		queue.dispose();
+		TIKI_UT_CHECK( allocator.freeCount == 3u );
+	}
+
+	TIKI_ADD_TEST( ContainerZoneAllocator )
+	{
+		ZoneAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 1024u ) );
+
+		{
+			ZoneAllocatorScope scope( allocator );
+
+			List< uint > list( allocator );
+			list.reserve( 64u );
+			for (uint i = 0u; i < 1024u; ++i)
+			{
+				list.add( i );
+			}
+			TIKI_UT_CHECK( list[ 1023u ] == 1023u );
+			TIKI_UT_CHECK( allocator.getCurrentAllocationSize() >= 1024u * sizeof( uint ) );
+		}
+
+		// the scope releases all buffers of the list at once
+		TIKI_UT_CHECK( allocator.getCurrentAllocationSize() == 0u );
+
+		allocator.dispose();
+	}
+
+	TIKI_ADD_TEST( ContainerVirtualMemoryList )
+	{
+		VirtualMemoryAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 64u * 1024u * 1024u ) );
+		TIKI_UT_CHECK( allocator.getCommittedSize() == 0u );
+
+		{
+			List< uint > list( allocator );
+			list.add( 0u );
+			const uint* pFirst = &list[ 0u ];
+
+			for (uint i = 1u; i < 1024u * 1024u; ++i)
+			{
+				list.add( i );
+			}
+
+			// the list grew in place
+			TIKI_UT_CHECK( &list[ 0u ] == pFirst );
+			TIKI_UT_CHECK( list[ 1024u * 1024u - 1u ] == 1024u * 1024u - 1u );
+			TIKI_UT_CHECK( allocator.getCommittedSize() >= list.getCount() * sizeof( uint ) );
+			TIKI_UT_CHECK( allocator.getCommittedSize() < allocator.getReservedSize() );
+		}
+
+		// the memory is decommitted with the list
+		TIKI_UT_CHECK( allocator.getCommittedSize() == 0u );
+
+		{
+			Map< uint, uint > map( allocator );
+			for (uint i = 0u; i < 4096u; ++i)
+			{
+				map.set( i, i * 2u );
+			}
+
+			uint value = 0u;
+			TIKI_UT_CHECK( map.findValue( &value, 4095u ) && value == 8190u );
+		}
+
+		// more than reserved can't be committed
+		void* pMemory = allocator.allocate( 1024u );
+		TIKI_UT_CHECK( pMemory != nullptr );
+		TIKI_UT_CHECK( allocator.resize( pMemory, 32u * 1024u * 1024u ) );
+		TIKI_UT_CHECK( !allocator.resize( pMemory, 128u * 1024u * 1024u ) );
+		allocator.free( pMemory );
+
+		allocator.dispose();
+	}
+
+	TIKI_ADD_TEST( ContainerVirtualMemoryListExhausted )
+	{
+		VirtualMemoryAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 4096u ) );
+
+		{
+			List< uint32 > list( allocator );
+
+			uint count = 0u;
+			while ( count < 4096u && list.add( count ) )
+			{
+				count++;
+			}
+
+			// the list stops at the reservation and keeps its elements
+			TIKI_UT_CHECK( count < 4096u );
+			TIKI_UT_CHECK( list.getCount() == count );
+			TIKI_UT_CHECK( count * sizeof( uint32 ) <= allocator.getReservedSize() );
+			for (uint i = 0u; i < count; ++i)
+			{
+				TIKI_UT_CHECK( list[ i ] == i );
+			}
+
+			const uint32 aValues[] = { 1u, 2u, 3u };
+			TIKI_UT_CHECK( !list.addRange( aValues, TIKI_COUNT( aValues ) ) );
+			TIKI_UT_CHECK( !list.insert( 0u, 42u ) );
+			TIKI_UT_CHECK( !list.resize( 4096u ) );
+			TIKI_UT_CHECK( !list.reserve( 4096u ) );
+			TIKI_UT_CHECK( list.getCount() == count );
+			TIKI_UT_CHECK( list[ 0u ] == 0u );
+			TIKI_UT_CHECK( list.getLast() == count - 1u );
+		}
+
+		allocator.dispose();
+	}
+
+	TIKI_ADD_TEST( ContainerHashMapInsertFindRemove )
+	{
+		HashMap< uint32, uint32 > map;
+		Map< uint32, uint32 > reference;
+
+		// keys with equal low bits must not end in the same probe chain
+		for (uint32 i = 0u; i < 10000u; ++i)
+		{
+			const uint32 key = i * 4096u;
+			map.set( key, i );
+			reference.set( key, i );
+		}
+		TIKI_UT_CHECK( map.getCount() == 10000u );
+		TIKI_UT_CHECK( map.getCount() * 8u <= map.getCapacity() * 7u );
+
+		for (uint32 i = 0u; i < 10000u; i += 2u)
+		{
+			TIKI_UT_CHECK( map.remove( i * 4096u ) );
+			reference.remove( i * 4096u );
+		}
+		TIKI_UT_CHECK( !map.remove( 0u ) );
+		TIKI_UT_CHECK( map.getCount() == reference.getCount() );
+
+		for (uint32 i = 0u; i < 10000u; ++i)
+		{
+			uint32 value = 0u;
+			const bool found = map.findValue( &value, i * 4096u );
+			TIKI_UT_CHECK( found == reference.hasKey( i * 4096u ) );
+			TIKI_UT_CHECK( !found || value == i );
+		}
+
+		// overwrite
+		map.set( 4096u, 7u );
+		TIKI_UT_CHECK( *map.find( 4096u ) == 7u );
+		TIKI_UT_CHECK( map.find( 1u ) == nullptr );
+
+		map.clear();
+		TIKI_UT_CHECK( map.isEmpty() && !map.hasKey( 4096u ) );
+
+		map.dispose();
+		reference.dispose();
+	}
+
+	TIKI_ADD_TEST( ContainerHashMapDeletedSlots )
+	{
+		HashMap< uint, uint > map;
+		TIKI_UT_CHECK( map.create( 100u ) );
+		const uint capacity = map.getCapacity();
+
+		// insert and remove over and over. the deleted slots are purged without growing.
+		for (uint i = 0u; i < 100000u; ++i)
+		{
+			map.set( i, i );
+			if ( i >= 50u )
+			{
+				TIKI_UT_CHECK( map.remove( i - 50u ) );
+			}
+		}
+		TIKI_UT_CHECK( map.getCount() == 50u );
+		TIKI_UT_CHECK( map.getCapacity() == capacity );
+
+		for (uint i = 100000u - 50u; i < 100000u; ++i)
+		{
+			TIKI_UT_CHECK( map.hasKey( i ) );
+		}
+	}
+
+	TIKI_ADD_TEST( ContainerHashMapStringKeys )
+	{
+		CountingTestAllocator allocator;
+		{
+			HashMap< string, uint > map( allocator );
+			for (uint i = 0u; i < 1000u; ++i)
+			{
+				map.set( formatString( "file_%u.xasset", i ), i );
+			}
+
+			uint value = 0u;
+			TIKI_UT_CHECK( map.findValue( &value, "file_999.xasset" ) && value == 999u );
+			TIKI_UT_CHECK( !map.hasKey( "file_1000.xasset" ) );
+		}
+
+		TIKI_UT_CHECK( allocator.allocationCount > 0u );
+		TIKI_UT_CHECK( allocator.allocationCount == allocator.freeCount );
+	}
+
+	TIKI_ADD_TEST( ContainerSoaArrayFields )
+	{
+		CountingTestAllocator allocator;
+
+		SoaArray< float, uint8, ContainerTestElement > array;
+		TIKI_UT_CHECK( array.create( 13u, &allocator ) );
+		TIKI_UT_CHECK( array.getCapacity() == 16u );
+		TIKI_UT_CHECK( allocator.allocationCount == 1u );
+
+		// every field starts at a simd aligned address
+		TIKI_UT_CHECK( isPointerAligned( array.getFieldData< 0u >(), 32u ) );
+		TIKI_UT_CHECK( isPointerAligned( array.getFieldData< 1u >(), 32u ) );
+		TIKI_UT_CHECK( isPointerAligned( array.getFieldData< 2u >(), 32u ) );
+		TIKI_UT_CHECK( array.getFieldData< 2u >()[ 15u ].value == 42u );
+
+		for (uint i = 0u; i < 10u; ++i)
+		{
+			const uint index = array.push();
+			TIKI_UT_CHECK( index == i );
+
+			array.get< 0u >( index )		= float( i );
+			array.get< 1u >( index )		= uint8( i );
+			array.get< 2u >( index ).value	= i;
+		}
+		TIKI_UT_CHECK( array.getCount() == 10u );
+
+		// the last element fills the gap in all fields
+		array.removeUnsortedByIndex( 3u );
+		TIKI_UT_CHECK( array.getCount() == 9u );
+		TIKI_UT_CHECK( array.get< 0u >( 3u ) == 9.0f );
+		TIKI_UT_CHECK( array.get< 1u >( 3u ) == 9u );
+		TIKI_UT_CHECK( array.get< 2u >( 3u ).value == 9u );
+
+		array.removeUnsortedByIndex( 8u );
+		TIKI_UT_CHECK( array.getCount() == 8u );
+
+		StaticArray< float > positions;
+		array.getField< 0u >( positions );
+		TIKI_UT_CHECK( positions.getCount() == 8u );
+		TIKI_UT_CHECK( positions.getBegin() == array.getFieldData< 0u >() );
+
+		float sum = 0.0f;
+		for (uint i = 0u; i < positions.getCount(); ++i)
+		{
+			sum += positions[ i ];
+		}
+		TIKI_UT_CHECK( sum == 0.0f + 1.0f + 2.0f + 9.0f + 4.0f + 5.0f + 6.0f + 7.0f );
+		positions.dispose();
+
+		const SoaArray< float, uint8, ContainerTestElement >& constArray = array;
+		StaticArray< const uint8 > flags;
+		constArray.getField< 1u >( flags );
+		TIKI_UT_CHECK( flags.getCount() == 8u && flags[ 7u ] == 7u );
+		flags.dispose();
+
+		array.clear();
+		TIKI_UT_CHECK( array.isEmpty() );
+
+		array.dispose();
+		TIKI_UT_CHECK( allocator.freeCount == 1u );
+	}
+}
@@ -0,0 +1,54 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/crc32.hpp"
+#include "tiki/base/memory.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Crc32 );
+
+	TIKI_ADD_TEST( Crc32KnownValues )
+	{
+		TIKI_UT_CHECK( crcString( "" ) == 0u );
+		TIKI_UT_CHECK( crcString( "123456789" ) == 0xcbf43926u );
+
+		// evaluated by the compiler
+		enum { LiteralCrc = crcLiteral( "123456789" ) };
+		TIKI_UT_CHECK( uint32( LiteralCrc ) == 0xcbf43926u );
+		TIKI_UT_CHECK( crcLiteral( "TransformComponent" ) == crcString( "TransformComponent" ) );
+	}
+
+	TIKI_ADD_TEST( Crc32Implementations )
+	{
+		const uint bufferSize = 4096u;
+		uint8* pBuffer = TIKI_MEMORY_NEW_ARRAY( uint8, bufferSize, false );
+
+		uint32 state = 0x12345678u;
+		for (uint i = 0u; i < bufferSize; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			pBuffer[ i ] = uint8( state >> 24u );
+		}
+
+		// every length around the block sizes and every alignment must give the same crc
+		bool isEqual = true;
+		for (uint offset = 0u; offset < 16u; ++offset)
+		{
+			for (uint length = 0u; length < 300u; ++length)
+			{
+				const crc32 expected = crc::addBytesBytewise( 0x1234u, pBuffer + offset, length );
+
+				isEqual &= ( crc::addBytesSliced( 0x1234u, pBuffer + offset, length ) == expected );
+				isEqual &= ( crc::addBytesPclmul( 0x1234u, pBuffer + offset, length ) == expected );
+				isEqual &= ( crcAddBytes( 0x1234u, pBuffer + offset, length ) == expected );
+			}
+		}
+		TIKI_UT_CHECK( isEqual );
+
+		// continuing a crc is the same as one pass
+		const crc32 firstPart = crcBytes( pBuffer, 1000u );
+		TIKI_UT_CHECK( crcAddBytes( firstPart, pBuffer + 1000u, bufferSize - 1000u ) == crcBytes( pBuffer, bufferSize ) );
+
+		TIKI_MEMORY_DELETE_ARRAY( pBuffer, bufferSize );
+	}
+}
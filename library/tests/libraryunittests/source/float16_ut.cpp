@@ -0,0 +1,328 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/float16.hpp"
+#include "tiki/base/simdkernels.hpp"
+
+#include <math.h>
+#include <string.h>
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Float16 );
+
+	enum
+	{
+		Float16TestChunkSize	= 4096u,
+		Float16TestPackCount	= 1037u		// an odd count for the scalar tail of the kernels
+	};
+
+	static float getFloat16TestValue( uint32 bits )
+	{
+		float value;
+		memcpy( &value, &bits, sizeof( value ) );
+		return value;
+	}
+
+	static uint32 getFloat16TestBits( float value )
+	{
+		uint32 bits;
+		memcpy( &bits, &value, sizeof( bits ) );
+		return bits;
+	}
+
+	// rounded to nearest even in double precision
+	static uint16 getFloat16TestReference( float value )
+	{
+		const uint32 bits	= getFloat16TestBits( value );
+		const uint16 sign	= uint16( ( bits >> 16u ) & 0x8000u );
+		if( value != value )
+		{
+			return uint16( sign | 0x7e00u | ( ( bits >> 13u ) & 0x3ffu ) );
+		}
+
+		const double absValue = fabs( double( value ) );
+		if( absValue >= 65520.0 )
+		{
+			return uint16( sign | 0x7c00u );
+		}
+
+		if( absValue < ldexp( 1.0, -14 ) )
+		{
+			// rounding up to the min normal gives the right bits too
+			return uint16( sign | uint16( nearbyint( ldexp( absValue, 24 ) ) ) );
+		}
+
+		// a mantissa of 2048 carries into the exponent
+		int exponent;
+		frexp( absValue, &exponent );
+		const uint32 mantissa = uint32( nearbyint( ldexp( absValue, 11 - exponent ) ) );
+		return uint16( sign | ( ( uint32( exponent + 14 ) << 10u ) + mantissa - 1024u ) );
+	}
+
+	static uint32 getFloat32TestReference( uint16 value )
+	{
+		const uint32 sign		= uint32( value & 0x8000u ) << 16u;
+		const uint32 exponent	= ( value >> 10u ) & 0x1fu;
+		const uint32 mantissa	= value & 0x3ffu;
+		if( exponent == 0x1fu )
+		{
+			return sign | 0x7f800000u | ( mantissa != 0u ? 0x00400000u | ( mantissa << 13u ) : 0u );
+		}
+
+		const double absValue = ( exponent == 0u ? ldexp( double( mantissa ), -24 ) : ldexp( double( 1024u + mantissa ), int( exponent ) - 25 ) );
+		return sign | getFloat16TestBits( float( absValue ) );
+	}
+
+	// compares the function in f16 and all kernel levels with the reference
+	static bool checkFloat16TestChunk( const float* pInputs, uint count )
+	{
+		float16 aResults[ Float16TestChunkSize ];
+
+		bool ok = true;
+		for (uint level = 0u; level <= SimdKernelLevel_Count; ++level)
+		{
+			if( level == 0u )
+			{
+				for (uint i = 0u; i < count; ++i)
+				{
+					aResults[ i ] = f16::convertFloat32to16( pInputs[ i ] );
+				}
+			}
+			else
+			{
+				const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)( level - 1u ) );
+				if( pKernels == nullptr )
+				{
+					continue;
+				}
+
+				pKernels->pConvertFloat32ToFloat16( aResults, pInputs, count );
+			}
+
+			for (uint i = 0u; i < count; ++i)
+			{
+				ok &= ( aResults[ i ] == getFloat16TestReference( pInputs[ i ] ) );
+			}
+		}
+
+		return ok;
+	}
+
+	TIKI_ADD_TEST( Float16ConvertToFloat16 )
+	{
+		float aInputs[ Float16TestChunkSize ];
+		uint count = 0u;
+
+		// every 4099th float bit pattern with both signs, infinity and nan
+		const uint32 stride = 4099u;
+		for (uint64 bits = 0u; bits <= 0xffffffffu; bits += stride)
+		{
+			aInputs[ count++ ] = getFloat16TestValue( uint32( bits ) );
+			if( count == Float16TestChunkSize )
+			{
+				TIKI_UT_CHECK( checkFloat16TestChunk( aInputs, count ) );
+				count = 0u;
+			}
+		}
+
+		// the ties between two neighboring float16 values and the floats next to them
+		for (uint32 value = 0u; value < 0x7bffu; ++value)
+		{
+			const uint32 lowBits	= getFloat32TestReference( uint16( value ) );
+			const uint32 highBits	= getFloat32TestReference( uint16( value + 1u ) );
+			const float tie			= ( getFloat16TestValue( lowBits ) + getFloat16TestValue( highBits ) ) * 0.5f;
+
+			aInputs[ count++ ] = tie;
+			aInputs[ count++ ] = -tie;
+			aInputs[ count++ ] = getFloat16TestValue( getFloat16TestBits( tie ) - 1u );
+			aInputs[ count++ ] = getFloat16TestValue( getFloat16TestBits( tie ) + 1u );
+			if( count + 4u > Float16TestChunkSize )
+			{
+				TIKI_UT_CHECK( checkFloat16TestChunk( aInputs, count ) );
+				count = 0u;
+			}
+		}
+		TIKI_UT_CHECK( checkFloat16TestChunk( aInputs, count ) );
+
+		// ties to even and overflow
+		TIKI_UT_CHECK( f16::convertFloat32to16( 1.0f + 1.0f / 2048.0f ) == 0x3c00u );
+		TIKI_UT_CHECK( f16::convertFloat32to16( 1.0f + 3.0f / 2048.0f ) == 0x3c02u );
+		TIKI_UT_CHECK( f16::convertFloat32to16( 65504.0f ) == 0x7bffu );
+		TIKI_UT_CHECK( f16::convertFloat32to16( 65519.0f ) == 0x7bffu );
+		TIKI_UT_CHECK( f16::convertFloat32to16( 65520.0f ) == 0x7c00u );
+		TIKI_UT_CHECK( f16::convertFloat32to16( -0.0f ) == 0x8000u );
+	}
+
+	TIKI_ADD_TEST( Float16ConvertToFloat32 )
+	{
+		float16 aInputs[ 0x10000u ];
+		for (uint i = 0u; i < TIKI_COUNT( aInputs ); ++i)
+		{
+			aInputs[ i ] = float16( i );
+		}
+
+		float aResults[ 0x10000u ];
+		for (uint level = 0u; level <= SimdKernelLevel_Count; ++level)
+		{
+			if( level == 0u )
+			{
+				for (uint i = 0u; i < TIKI_COUNT( aInputs ); ++i)
+				{
+					aResults[ i ] = f16::convertFloat16to32( aInputs[ i ] );
+				}
+			}
+			else
+			{
+				const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)( level - 1u ) );
+				if( pKernels == nullptr )
+				{
+					continue;
+				}
+
+				// the offset makes an odd count for the scalar tail
+				pKernels->pConvertFloat16ToFloat32( aResults, aInputs, 3u );
+				pKernels->pConvertFloat16ToFloat32( aResults + 3u, aInputs + 3u, TIKI_COUNT( aInputs ) - 3u );
+			}
+
+			bool ok = true;
+			for (uint i = 0u; i < TIKI_COUNT( aInputs ); ++i)
+			{
+				ok &= ( getFloat16TestBits( aResults[ i ] ) == getFloat32TestReference( aInputs[ i ] ) );
+
+				// every float16 survives the round trip, nan gets quiet
+				const uint16 quietBit = ( ( aInputs[ i ] & 0x7fffu ) > 0x7c00u ? 0x0200u : 0u );
+				ok &= ( f16::convertFloat32to16( aResults[ i ] ) == ( aInputs[ i ] | quietBit ) );
+			}
+			TIKI_UT_CHECK( ok );
+		}
+	}
+
+	TIKI_ADD_TEST( Float16PackNormalized )
+	{
+		float aInputs[ Float16TestPackCount ];
+		uint32 state = 7u;
+		for (uint i = 0u; i < TIKI_COUNT( aInputs ); ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			aInputs[ i ] = ( float( state >> 8u ) / float( 1u << 24u ) ) * 2.4f - 1.2f;
+		}
+
+		// the clamp borders, nan and the ties to even of 0.5 and -0.5
+		const float nan = getFloat16TestValue( 0x7fc00000u );
+		aInputs[ 0u ] = 0.0f;
+		aInputs[ 1u ] = 1.0f;
+		aInputs[ 2u ] = -1.0f;
+		aInputs[ 3u ] = nan;
+		aInputs[ 4u ] = 0.5f;
+		aInputs[ 5u ] = -0.5f;
+		aInputs[ 6u ] = 1000.0f;
+		aInputs[ 7u ] = -1000.0f;
+
+		uint8 aUnorm8[ Float16TestPackCount ];
+		sint8 aSnorm8[ Float16TestPackCount ];
+		uint16 aUnorm16[ Float16TestPackCount ];
+		sint16 aSnorm16[ Float16TestPackCount ];
+
+		const SimdKernels* pScalarKernels = simd::getKernels( SimdKernelLevel_Scalar );
+		pScalarKernels->pPackUnorm8( aUnorm8, aInputs, TIKI_COUNT( aInputs ) );
+		pScalarKernels->pPackSnorm8( aSnorm8, aInputs, TIKI_COUNT( aInputs ) );
+		pScalarKernels->pPackUnorm16( aUnorm16, aInputs, TIKI_COUNT( aInputs ) );
+		pScalarKernels->pPackSnorm16( aSnorm16, aInputs, TIKI_COUNT( aInputs ) );
+
+		TIKI_UT_CHECK( aUnorm8[ 0u ] == 0u && aUnorm8[ 1u ] == 255u && aUnorm8[ 2u ] == 0u && aUnorm8[ 3u ] == 0u );
+		TIKI_UT_CHECK( aUnorm8[ 4u ] == 128u && aUnorm8[ 6u ] == 255u && aUnorm8[ 7u ] == 0u );
+		TIKI_UT_CHECK( aSnorm8[ 0u ] == 0 && aSnorm8[ 1u ] == 127 && aSnorm8[ 2u ] == -127 && aSnorm8[ 3u ] == 0 );
+		TIKI_UT_CHECK( aSnorm8[ 4u ] == 64 && aSnorm8[ 5u ] == -64 && aSnorm8[ 6u ] == 127 && aSnorm8[ 7u ] == -127 );
+		TIKI_UT_CHECK( aUnorm16[ 1u ] == 65535u && aUnorm16[ 3u ] == 0u && aUnorm16[ 4u ] == 32768u );
+		TIKI_UT_CHECK( aSnorm16[ 2u ] == -32767 && aSnorm16[ 3u ] == 0 && aSnorm16[ 4u ] == 16384 && aSnorm16[ 5u ] == -16384 );
+
+		// round to nearest of the clamped values, the float product can be off by an ulp
+		bool ok = true;
+		for (uint i = 8u; i < TIKI_COUNT( aInputs ); ++i)
+		{
+			const double unorm	= ( aInputs[ i ] < 0.0f ? 0.0 : ( aInputs[ i ] > 1.0f ? 1.0 : double( aInputs[ i ] ) ) );
+			const double snorm	= ( aInputs[ i ] < -1.0f ? -1.0 : ( aInputs[ i ] > 1.0f ? 1.0 : double( aInputs[ i ] ) ) );
+
+			ok &= fabs( double( aUnorm8[ i ] ) - unorm * 255.0 ) <= 0.51;
+			ok &= fabs( double( aSnorm8[ i ] ) - snorm * 127.0 ) <= 0.51;
+			ok &= fabs( double( aUnorm16[ i ] ) - unorm * 65535.0 ) <= 0.51;
+			ok &= fabs( double( aSnorm16[ i ] ) - snorm * 32767.0 ) <= 0.51;
+		}
+		TIKI_UT_CHECK( ok );
+
+		// the vector levels return the same values
+		for (uint level = SimdKernelLevel_Scalar + 1u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			uint8 aLevelUnorm8[ Float16TestPackCount ];
+			sint8 aLevelSnorm8[ Float16TestPackCount ];
+			uint16 aLevelUnorm16[ Float16TestPackCount ];
+			sint16 aLevelSnorm16[ Float16TestPackCount ];
+			pKernels->pPackUnorm8( aLevelUnorm8, aInputs, TIKI_COUNT( aInputs ) );
+			pKernels->pPackSnorm8( aLevelSnorm8, aInputs, TIKI_COUNT( aInputs ) );
+			pKernels->pPackUnorm16( aLevelUnorm16, aInputs, TIKI_COUNT( aInputs ) );
+			pKernels->pPackSnorm16( aLevelSnorm16, aInputs, TIKI_COUNT( aInputs ) );
+
+			TIKI_UT_CHECK( memcmp( aLevelUnorm8, aUnorm8, sizeof( aUnorm8 ) ) == 0 );
+			TIKI_UT_CHECK( memcmp( aLevelSnorm8, aSnorm8, sizeof( aSnorm8 ) ) == 0 );
+			TIKI_UT_CHECK( memcmp( aLevelUnorm16, aUnorm16, sizeof( aUnorm16 ) ) == 0 );
+			TIKI_UT_CHECK( memcmp( aLevelSnorm16, aSnorm16, sizeof( aSnorm16 ) ) == 0 );
+		}
+	}
+
+	TIKI_ADD_TEST( Float16PackUnorm1010102 )
+	{
+		const uint count = Float16TestPackCount / 4u;
+
+		float aInputs[ Float16TestPackCount ];
+		uint32 state = 11u;
+		for (uint i = 0u; i < TIKI_COUNT( aInputs ); ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			aInputs[ i ] = ( float( state >> 8u ) / float( 1u << 24u ) ) * 1.2f - 0.1f;
+		}
+
+		aInputs[ 0u ] = 1.0f;
+		aInputs[ 1u ] = 0.0f;
+		aInputs[ 2u ] = 0.5f;
+		aInputs[ 3u ] = 1.0f;
+
+		uint32 aPacked[ Float16TestPackCount / 4u ];
+		simd::getKernels( SimdKernelLevel_Scalar )->pPackUnorm1010102( aPacked, aInputs, count );
+
+		// 511.5 is a tie to even
+		TIKI_UT_CHECK( aPacked[ 0u ] == ( 1023u | ( 0u << 10u ) | ( 512u << 20u ) | ( 3u << 30u ) ) );
+
+		bool ok = true;
+		for (uint i = 1u; i < count; ++i)
+		{
+			const uint32 aComponents[] = { aPacked[ i ] & 0x3ffu, ( aPacked[ i ] >> 10u ) & 0x3ffu, ( aPacked[ i ] >> 20u ) & 0x3ffu, aPacked[ i ] >> 30u };
+			for (uint component = 0u; component < 4u; ++component)
+			{
+				const float value	= aInputs[ i * 4u + component ];
+				const double unorm	= ( value < 0.0f ? 0.0 : ( value > 1.0f ? 1.0 : double( value ) ) );
+				const double scale	= ( component == 3u ? 3.0 : 1023.0 );
+				ok &= fabs( double( aComponents[ component ] ) - unorm * scale ) <= 0.51;
+			}
+		}
+		TIKI_UT_CHECK( ok );
+
+		for (uint level = SimdKernelLevel_Scalar + 1u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			uint32 aLevelPacked[ Float16TestPackCount / 4u ];
+			pKernels->pPackUnorm1010102( aLevelPacked, aInputs, count );
+			TIKI_UT_CHECK( memcmp( aLevelPacked, aPacked, sizeof( aPacked ) ) == 0 );
+		}
+	}
+}
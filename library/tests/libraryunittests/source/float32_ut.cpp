@@ -0,0 +1,337 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/float32.hpp"
+#include "tiki/base/simdkernels.hpp"
+
+#include <math.h>
+#include <string.h>
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Float32 );
+
+	enum Float32TestErrorType
+	{
+		Float32TestErrorType_Absolute,
+		Float32TestErrorType_Relative,
+		Float32TestErrorType_Log		// absolute in [0.5, 2], relative elsewhere
+	};
+
+	enum
+	{
+		Float32TestChunkSize	= 1024u,
+		Float32TestLevelCount	= SimdKernelLevel_Count + 1u	// the scalar function and all kernel levels
+	};
+
+	typedef float	(*Float32TestScalarFunction)( float x );
+	typedef double	(*Float32TestReferenceFunction)( double x );
+	typedef void	(*SimdKernels::*Float32TestKernel)( float* pTarget, const float* pSource, uint count );
+
+	static double referenceSin( double x )	{ return sin( x ); }
+	static double referenceCos( double x )	{ return cos( x ); }
+	static double referenceExp( double x )	{ return exp( x ); }
+	static double referenceLog( double x )	{ return log( x ); }
+	static double referenceInverseSquareRoot( double x )	{ return 1.0 / sqrt( x ); }
+
+	static float getFloat32TestValue( uint32 bits )
+	{
+		float value;
+		memcpy( &value, &bits, sizeof( value ) );
+		return value;
+	}
+
+	static uint32 getFloat32TestBits( float value )
+	{
+		uint32 bits;
+		memcpy( &bits, &value, sizeof( bits ) );
+		return bits;
+	}
+
+	static double getFloat32TestError( float value, double expected, float input, Float32TestErrorType type )
+	{
+		const double error = fabs( double( value ) - expected );
+		if( type == Float32TestErrorType_Absolute || ( type == Float32TestErrorType_Log && input >= 0.5f && input <= 2.0f ) )
+		{
+			return error;
+		}
+
+		return error / fabs( expected );
+	}
+
+	// max error of the scalar function at index 0 and of the kernel levels at 1 + level
+	static void measureFloat32TestChunk( double* pMaxErrors, const float* pInputs, uint count, Float32TestScalarFunction pScalarFunction, Float32TestKernel pKernel, Float32TestReferenceFunction pReferenceFunction, Float32TestErrorType type )
+	{
+		float aResults[ Float32TestChunkSize ];
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			if( level == 0u )
+			{
+				for (uint i = 0u; i < count; ++i)
+				{
+					aResults[ i ] = pScalarFunction( pInputs[ i ] );
+				}
+			}
+			else
+			{
+				const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)( level - 1u ) );
+				if( pKernels == nullptr )
+				{
+					continue;
+				}
+
+				( pKernels->*pKernel )( aResults, pInputs, count );
+			}
+
+			for (uint i = 0u; i < count; ++i)
+			{
+				const double error = getFloat32TestError( aResults[ i ], pReferenceFunction( pInputs[ i ] ), pInputs[ i ], type );
+				pMaxErrors[ level ] = ( error > pMaxErrors[ level ] ? error : pMaxErrors[ level ] );
+			}
+		}
+	}
+
+	// every stride-th float between the bit patterns, with both signs if requested
+	static void measureFloat32TestRange( double* pMaxErrors, float start, float end, bool mirror, Float32TestScalarFunction pScalarFunction, Float32TestKernel pKernel, Float32TestReferenceFunction pReferenceFunction, Float32TestErrorType type )
+	{
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			pMaxErrors[ level ] = 0.0;
+		}
+
+		const uint32 endBits = getFloat32TestBits( end );
+		const uint32 stride = 4099u;
+
+		float aInputs[ Float32TestChunkSize ];
+		uint count = 0u;
+		for (uint64 bits = getFloat32TestBits( start ); bits <= endBits; bits += stride)
+		{
+			aInputs[ count++ ] = getFloat32TestValue( uint32( bits ) );
+			if( mirror )
+			{
+				aInputs[ count++ ] = -getFloat32TestValue( uint32( bits ) );
+			}
+
+			if( count + 2u > Float32TestChunkSize )
+			{
+				measureFloat32TestChunk( pMaxErrors, aInputs, count, pScalarFunction, pKernel, pReferenceFunction, type );
+				count = 0u;
+			}
+		}
+
+		// the last value and an odd count for the scalar tail of the kernels
+		aInputs[ count++ ] = end;
+		measureFloat32TestChunk( pMaxErrors, aInputs, count, pScalarFunction, pKernel, pReferenceFunction, type );
+	}
+
+	TIKI_ADD_TEST( Float32SinCos )
+	{
+		double aMaxErrors[ Float32TestLevelCount ];
+		measureFloat32TestRange( aMaxErrors, 0.0f, 8192.0f, true, f32::approximatedSin, &SimdKernels::pSin, referenceSin, Float32TestErrorType_Absolute );
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			TIKI_UT_CHECK( aMaxErrors[ level ] <= 1e-7 );
+		}
+
+		measureFloat32TestRange( aMaxErrors, 0.0f, 8192.0f, true, f32::approximatedCos, &SimdKernels::pCos, referenceCos, Float32TestErrorType_Absolute );
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			TIKI_UT_CHECK( aMaxErrors[ level ] <= 1e-7 );
+		}
+
+		// exact values and symmetry
+		TIKI_UT_CHECK( f32::approximatedSin( 0.0f ) == 0.0f );
+		TIKI_UT_CHECK( f32::approximatedCos( 0.0f ) == 1.0f );
+		TIKI_UT_CHECK( f32::approximatedSin( -1.0f ) == -f32::approximatedSin( 1.0f ) );
+		TIKI_UT_CHECK( f32::approximatedCos( -1.0f ) == f32::approximatedCos( 1.0f ) );
+
+		float aInputs[ 13u ];
+		float aSin[ 13u ];
+		float aCos[ 13u ];
+		float aSinCosSin[ 13u ];
+		float aSinCosCos[ 13u ];
+		for (uint i = 0u; i < TIKI_COUNT( aInputs ); ++i)
+		{
+			aInputs[ i ] = float( i ) * 0.7f - 4.0f;
+		}
+
+		for (uint level = 0u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			pKernels->pSin( aSin, aInputs, TIKI_COUNT( aInputs ) );
+			pKernels->pCos( aCos, aInputs, TIKI_COUNT( aInputs ) );
+			pKernels->pSinCos( aSinCosSin, aSinCosCos, aInputs, TIKI_COUNT( aInputs ) );
+			for (uint i = 0u; i < TIKI_COUNT( aInputs ); ++i)
+			{
+				TIKI_UT_CHECK( aSinCosSin[ i ] == aSin[ i ] );
+				TIKI_UT_CHECK( aSinCosCos[ i ] == aCos[ i ] );
+
+				float sinValue;
+				float cosValue;
+				f32::approximatedSinCos( sinValue, cosValue, aInputs[ i ] );
+				TIKI_UT_CHECK( fabsf( sinValue - aSin[ i ] ) <= 1e-7f );
+				TIKI_UT_CHECK( fabsf( cosValue - aCos[ i ] ) <= 1e-7f );
+			}
+		}
+
+		// only the reduction up to 8192 is exact, but larger values, inf and nan must not overflow the octant.
+		// inf and nan give nan.
+		float aInvalidInputs[ 9u ];
+		for (uint i = 0u; i < TIKI_COUNT( aInvalidInputs ); ++i)
+		{
+			const float sign = ( i & 1u ? -1.0f : 1.0f );
+			aInvalidInputs[ i ] = sign * ( i % 3u == 0u ? HUGE_VALF : ( i % 3u == 1u ? nanf( "" ) : 1.0e30f ) );
+		}
+
+		for (uint i = 0u; i < TIKI_COUNT( aInvalidInputs ); ++i)
+		{
+			float sinValue;
+			float cosValue;
+			f32::approximatedSinCos( sinValue, cosValue, aInvalidInputs[ i ] );
+			if( i % 3u != 2u )
+			{
+				TIKI_UT_CHECK( sinValue != sinValue );
+				TIKI_UT_CHECK( cosValue != cosValue );
+			}
+		}
+
+		for (uint level = 0u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			pKernels->pSinCos( aSinCosSin, aSinCosCos, aInvalidInputs, TIKI_COUNT( aInvalidInputs ) );
+			for (uint i = 0u; i < TIKI_COUNT( aInvalidInputs ); ++i)
+			{
+				if( i % 3u != 2u )
+				{
+					TIKI_UT_CHECK( aSinCosSin[ i ] != aSinCosSin[ i ] );
+					TIKI_UT_CHECK( aSinCosCos[ i ] != aSinCosCos[ i ] );
+				}
+			}
+		}
+	}
+
+	TIKI_ADD_TEST( Float32Atan2 )
+	{
+		const uint count = Float32TestChunkSize - 1u;
+
+		float aY[ Float32TestChunkSize ];
+		float aX[ Float32TestChunkSize ];
+		float aResult[ Float32TestChunkSize ];
+
+		double aMaxErrors[ Float32TestLevelCount ] = { 0.0 };
+
+		// random finite bit patterns cover all magnitudes, the grid covers the octant borders and the axes
+		uint32 state = 1u;
+		for (uint round = 0u; round < 256u; ++round)
+		{
+			for (uint i = 0u; i < count; ++i)
+			{
+				if( round < 128u )
+				{
+					do
+					{
+						state = state * 1664525u + 1013904223u;
+						aY[ i ] = getFloat32TestValue( state );
+						state = state * 1664525u + 1013904223u;
+						aX[ i ] = getFloat32TestValue( state );
+					}
+					while( !isfinite( aY[ i ] ) || !isfinite( aX[ i ] ) );
+				}
+				else
+				{
+					const uint index = ( round - 128u ) * count + i;
+					aY[ i ] = float( sint32( index % 361u ) - 180 ) * 0.05f;
+					aX[ i ] = float( sint32( index / 361u ) - 180 ) * 0.05f;
+				}
+			}
+
+			for (uint level = 0u; level < Float32TestLevelCount; ++level)
+			{
+				if( level == 0u )
+				{
+					for (uint i = 0u; i < count; ++i)
+					{
+						aResult[ i ] = f32::approximatedAtan2( aY[ i ], aX[ i ] );
+					}
+				}
+				else
+				{
+					const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)( level - 1u ) );
+					if( pKernels == nullptr )
+					{
+						continue;
+					}
+					pKernels->pAtan2( aResult, aY, aX, count );
+				}
+
+				for (uint i = 0u; i < count; ++i)
+				{
+					if( aY[ i ] == 0.0f && aX[ i ] == 0.0f )
+					{
+						TIKI_UT_CHECK( aResult[ i ] == 0.0f );
+						continue;
+					}
+
+					const double error = fabs( aResult[ i ] - atan2( double( aY[ i ] ), double( aX[ i ] ) ) );
+					aMaxErrors[ level ] = ( error > aMaxErrors[ level ] ? error : aMaxErrors[ level ] );
+				}
+			}
+		}
+
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			TIKI_UT_CHECK( aMaxErrors[ level ] <= 3e-7 );
+		}
+	}
+
+	TIKI_ADD_TEST( Float32ExpLog )
+	{
+		double aMaxErrors[ Float32TestLevelCount ];
+		measureFloat32TestRange( aMaxErrors, 0.0f, 87.33654f, true, f32::approximatedExp, &SimdKernels::pExp, referenceExp, Float32TestErrorType_Relative );
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			TIKI_UT_CHECK( aMaxErrors[ level ] <= 1.5e-7 );
+		}
+
+		measureFloat32TestRange( aMaxErrors, 87.33654f, 88.37626f, false, f32::approximatedExp, &SimdKernels::pExp, referenceExp, Float32TestErrorType_Relative );
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			TIKI_UT_CHECK( aMaxErrors[ level ] <= 1.5e-7 );
+		}
+
+		// clamped to normalized floats
+		TIKI_UT_CHECK( f32::approximatedExp( 1000.0f ) > 2.0e38f && f32::approximatedExp( 1000.0f ) < f32::maxValue );
+		TIKI_UT_CHECK( f32::approximatedExp( -1000.0f ) >= f32::minValue );
+		TIKI_UT_CHECK( f32::approximatedExp( 0.0f ) == 1.0f );
+
+		// all positive normalized floats
+		measureFloat32TestRange( aMaxErrors, f32::minValue, f32::maxValue, false, f32::approximatedLog, &SimdKernels::pLog, referenceLog, Float32TestErrorType_Log );
+		for (uint level = 0u; level < Float32TestLevelCount; ++level)
+		{
+			TIKI_UT_CHECK( aMaxErrors[ level ] <= 1e-7 );
+		}
+
+		TIKI_UT_CHECK( f32::approximatedLog( 1.0f ) == 0.0f );
+	}
+
+	TIKI_ADD_TEST( Float32InverseSquareRoot )
+	{
+		double aMaxErrors[ Float32TestLevelCount ];
+		measureFloat32TestRange( aMaxErrors, f32::minValue, f32::maxValue, false, f32::approximatedInverseSquareRoot, &SimdKernels::pInverseSquareRoot, referenceInverseSquareRoot, Float32TestErrorType_Relative );
+
+		TIKI_UT_CHECK( aMaxErrors[ 0u ] <= 5e-6 );
+		for (uint level = 1u; level < Float32TestLevelCount; ++level)
+		{
+			TIKI_UT_CHECK( aMaxErrors[ level ] <= 5e-7 );
+		}
+	}
+}
@@ -0,0 +1,274 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/math/axisalignedbox.hpp"
+#include "tiki/math/box.hpp"
+#include "tiki/math/camera.hpp"
+#include "tiki/math/frustum.hpp"
+#include "tiki/math/quaternion.hpp"
+#include "tiki/math/sphere.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Frustum );
+
+	static float getFrustumTestValue( uint32& state )
+	{
+		state = state * 1664525u + 1013904223u;
+		return float( state >> 8u ) / float( 1u << 24u ) * 2.0f - 1.0f;
+	}
+
+	static void createFrustumTestCamera( Camera& camera )
+	{
+		Projection projection;
+		projection.createPerspective( 16.0f, 9.0f, f32::piOver4, 1.0f, 100.0f );
+
+		Quaternion rotation;
+		quaternion::fromYawPitchRoll( rotation, 0.5f, 0.25f, 0.0f );
+
+		camera.create( vector::create( 10.0f, 5.0f, -20.0f ), rotation, &projection );
+	}
+
+	static void getFrustumTestCenter( Vector3& center, const Frustum& frustum )
+	{
+		Vector3 aCorners[ FrustumCorner_Count ];
+		TIKI_VERIFY( frustum.getCorners( aCorners ) );
+
+		vector::clear( center );
+		for (uint i = 0u; i < FrustumCorner_Count; ++i)
+		{
+			vector::add( center, aCorners[ i ] );
+		}
+		vector::scale( center, 1.0f / float( FrustumCorner_Count ) );
+	}
+
+	static void createFrustumTestBox( AxisAlignedBox& box, uint32& state )
+	{
+		// the camera looks at the range around the origin
+		const Vector3 center	= vector::create( getFrustumTestValue( state ) * 150.0f, getFrustumTestValue( state ) * 150.0f, getFrustumTestValue( state ) * 150.0f );
+		const Vector3 size		= vector::create( 1.0f + f32::abs( getFrustumTestValue( state ) ) * 40.0f, 1.0f + f32::abs( getFrustumTestValue( state ) ) * 40.0f, 1.0f + f32::abs( getFrustumTestValue( state ) ) * 40.0f );
+		box.createFromCenterExtends( center, size );
+	}
+
+	static bool isFrustumTestFinite( const Vector3& value )
+	{
+		// false for infinity and nan
+		return f32::abs( value.x ) <= f32::maxValue && f32::abs( value.y ) <= f32::maxValue && f32::abs( value.z ) <= f32::maxValue;
+	}
+
+	TIKI_ADD_TEST( FrustumPointAndBounds )
+	{
+		Camera camera;
+		createFrustumTestCamera( camera );
+		const Frustum& frustum = camera.getFrustum();
+
+		Vector3 center;
+		getFrustumTestCenter( center, frustum );
+
+		// behind the camera and far behind the far plane
+		Vector3 cameraPosition = camera.getPosition();
+		Vector3 behind;
+		vector::sub( behind, cameraPosition, center );
+		vector::add( behind, cameraPosition );
+
+		Vector3 beyond;
+		vector::sub( beyond, center, cameraPosition );
+		vector::scale( beyond, 4.0f );
+		vector::add( beyond, cameraPosition );
+
+		TIKI_UT_CHECK( frustum.testIntersectionPoint( center ) == IntersectionTypes_Contains );
+		TIKI_UT_CHECK( frustum.testIntersectionPoint( behind ) == IntersectionTypes_Disjoint );
+		TIKI_UT_CHECK( frustum.testIntersectionPoint( beyond ) == IntersectionTypes_Disjoint );
+
+		AxisAlignedBox box;
+		box.createFromCenterExtends( center, Vector3::one );
+		TIKI_UT_CHECK( frustum.testIntersectionAxisAlignedBox( box ) == IntersectionTypes_Contains );
+		TIKI_UT_CHECK( frustum.testIntersectionAxisAlignedBox( box, true ) == IntersectionTypes_Contains );
+
+		box.createFromCenterExtends( center, vector::create( 1000.0f, 1000.0f, 1000.0f ) );
+		TIKI_UT_CHECK( frustum.testIntersectionAxisAlignedBox( box ) == IntersectionTypes_Intersects );
+		TIKI_UT_CHECK( frustum.testIntersectionAxisAlignedBox( box, true ) == IntersectionTypes_Intersects );
+
+		box.createFromCenterExtends( behind, Vector3::one );
+		TIKI_UT_CHECK( frustum.testIntersectionAxisAlignedBox( box ) == IntersectionTypes_Disjoint );
+
+		Box orientedBox( center, Vector3::one );
+		orientedBox.rotate( camera.getRotation() );
+		orientedBox.center = center;
+		TIKI_UT_CHECK( frustum.testIntersectionBox( orientedBox ) == IntersectionTypes_Contains );
+
+		orientedBox.center = beyond;
+		TIKI_UT_CHECK( frustum.testIntersectionBox( orientedBox, true ) == IntersectionTypes_Disjoint );
+
+		const Sphere sphere( center, 2.0f );
+		TIKI_UT_CHECK( frustum.testIntersectionSphere( sphere ) == IntersectionTypes_Contains );
+		TIKI_UT_CHECK( frustum.testIntersectionSphere( Sphere( cameraPosition, 2.0f ) ) == IntersectionTypes_Intersects );
+		TIKI_UT_CHECK( frustum.testIntersectionSphere( Sphere( behind, 2.0f ), true ) == IntersectionTypes_Disjoint );
+	}
+
+	TIKI_ADD_TEST( FrustumPreciseBoxes )
+	{
+		Camera camera;
+		createFrustumTestCamera( camera );
+		const Frustum& frustum = camera.getFrustum();
+
+		uint32 state = 7u;
+		uint preciseRejectCount = 0u;
+		for (uint i = 0u; i < 4096u; ++i)
+		{
+			AxisAlignedBox box;
+			createFrustumTestBox( box, state );
+
+			const IntersectionTypes conservative	= frustum.testIntersectionAxisAlignedBox( box );
+			const IntersectionTypes precise			= frustum.testIntersectionAxisAlignedBox( box, true );
+			if( conservative == precise )
+			{
+				continue;
+			}
+
+			// precise can only reject more
+			TIKI_UT_CHECK( conservative == IntersectionTypes_Intersects && precise == IntersectionTypes_Disjoint );
+			preciseRejectCount++;
+
+			// no sample of the rejected box is inside
+			Vector3 aVertices[ AxisAlignedBoxVertices_Count ];
+			box.getVertices( aVertices );
+			for (uint j = 0u; j < AxisAlignedBoxVertices_Count; ++j)
+			{
+				TIKI_UT_CHECK( frustum.testIntersectionPoint( aVertices[ j ] ) == IntersectionTypes_Disjoint );
+			}
+			TIKI_UT_CHECK( frustum.testIntersectionPoint( box.getCenter() ) == IntersectionTypes_Disjoint );
+
+			// the same box as oriented box
+			Box orientedBox;
+			orientedBox.create( box.min, box.max );
+			TIKI_UT_CHECK( frustum.testIntersectionBox( orientedBox ) == IntersectionTypes_Intersects );
+			TIKI_UT_CHECK( frustum.testIntersectionBox( orientedBox, true ) == IntersectionTypes_Disjoint );
+		}
+		TIKI_UT_CHECK( preciseRejectCount > 0u );
+	}
+
+	TIKI_ADD_TEST( FrustumCullBatches )
+	{
+		Camera camera;
+		createFrustumTestCamera( camera );
+		const Frustum& frustum = camera.getFrustum();
+
+		// not a multiple of the simd width
+		const uint count = 1003u;
+
+		AxisAlignedBox* pBoxes = TIKI_MEMORY_NEW_ARRAY( AxisAlignedBox, count, false );
+		Sphere* pSpheres = TIKI_MEMORY_NEW_ARRAY( Sphere, count, false );
+		float* pCenterX = TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float* pCenterY = TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float* pCenterZ = TIKI_MEMORY_NEW_ARRAY( float, count, false );
+		float* pRadius = TIKI_MEMORY_NEW_ARRAY( float, count, false );
+
+		uint32 state = 13u;
+		for (uint i = 0u; i < count; ++i)
+		{
+			createFrustumTestBox( pBoxes[ i ], state );
+
+			pSpheres[ i ].center = pBoxes[ i ].getCenter();
+			pSpheres[ i ].radius = 1.0f + f32::abs( getFrustumTestValue( state ) ) * 20.0f;
+
+			pCenterX[ i ]	= pSpheres[ i ].center.x;
+			pCenterY[ i ]	= pSpheres[ i ].center.y;
+			pCenterZ[ i ]	= pSpheres[ i ].center.z;
+			pRadius[ i ]	= pSpheres[ i ].radius;
+		}
+
+		uint32 aBoxMask[ ( count + 31u ) / 32u ];
+		uint32 aSphereMask[ ( count + 31u ) / 32u ];
+		uint32 aSoaSphereMask[ ( count + 31u ) / 32u ];
+		frustum.cullAxisAlignedBoxes( aBoxMask, pBoxes, count );
+		frustum.cullSpheres( aSphereMask, pSpheres, count );
+		frustum.cullSpheres( aSoaSphereMask, pCenterX, pCenterY, pCenterZ, pRadius, count );
+
+		uint visibleCount = 0u;
+		for (uint i = 0u; i < count; ++i)
+		{
+			const uint32 bit = 1u << ( i % 32u );
+
+			const bool boxVisible = ( aBoxMask[ i / 32u ] & bit ) != 0u;
+			TIKI_UT_CHECK( boxVisible == ( frustum.testIntersectionAxisAlignedBox( pBoxes[ i ] ) != IntersectionTypes_Disjoint ) );
+
+			const bool sphereVisible = ( aSphereMask[ i / 32u ] & bit ) != 0u;
+			TIKI_UT_CHECK( sphereVisible == ( frustum.testIntersectionSphere( pSpheres[ i ] ) != IntersectionTypes_Disjoint ) );
+			TIKI_UT_CHECK( sphereVisible == ( ( aSoaSphereMask[ i / 32u ] & bit ) != 0u ) );
+
+			visibleCount += boxVisible;
+		}
+
+		// both cases are covered
+		TIKI_UT_CHECK( visibleCount > 0u && visibleCount < count );
+
+		// unused bits of the last word are cleared
+		TIKI_UT_CHECK( ( aBoxMask[ count / 32u ] >> ( count % 32u ) ) == 0u );
+
+		TIKI_MEMORY_DELETE_ARRAY( pRadius, count );
+		TIKI_MEMORY_DELETE_ARRAY( pCenterZ, count );
+		TIKI_MEMORY_DELETE_ARRAY( pCenterY, count );
+		TIKI_MEMORY_DELETE_ARRAY( pCenterX, count );
+		TIKI_MEMORY_DELETE_ARRAY( pSpheres, count );
+		TIKI_MEMORY_DELETE_ARRAY( pBoxes, count );
+	}
+
+	TIKI_ADD_TEST( FrustumTransformBoundingBox )
+	{
+		Matrix43 mtx;
+		Quaternion rotation;
+		quaternion::fromYawPitchRoll( rotation, 0.3f, -1.1f, 0.7f );
+		quaternion::toMatrix( mtx.rot, rotation );
+		vector::set( mtx.pos, 3.0f, -2.0f, 5.0f );
+
+		AxisAlignedBox box;
+		box.createFromMinMax( -1.0f, -2.0f, 0.5f, 2.0f, 1.0f, 3.0f );
+
+		Vector3 aVertices[ AxisAlignedBoxVertices_Count ];
+		box.getVertices( aVertices );
+
+		AxisAlignedBox reference;
+		matrix::transform( aVertices[ 0u ], mtx );
+		reference.createFromMinMax( aVertices[ 0u ], aVertices[ 0u ] );
+		for (uint i = 1u; i < AxisAlignedBoxVertices_Count; ++i)
+		{
+			matrix::transform( aVertices[ i ], mtx );
+			reference.extendByPoint( aVertices[ i ] );
+		}
+
+		box.transform( mtx );
+		TIKI_UT_CHECK( vector::isEquals( box.min, reference.min, 0.0001f ) );
+		TIKI_UT_CHECK( vector::isEquals( box.max, reference.max, 0.0001f ) );
+	}
+
+	TIKI_ADD_TEST( FrustumUnboundedBox )
+	{
+		Camera camera;
+		createFrustumTestCamera( camera );
+		const Frustum& frustum = camera.getFrustum();
+
+		Matrix43 mtx;
+		Quaternion rotation;
+		quaternion::fromYawPitchRoll( rotation, 0.3f, -1.1f, 0.7f );
+		quaternion::toMatrix( mtx.rot, rotation );
+		vector::set( mtx.pos, 300.0f, -200.0f, 500.0f );
+
+		// the simd path and the remaining box
+		const uint count = 5u;
+
+		AxisAlignedBox aBoxes[ count ];
+		for (uint i = 0u; i < count; ++i)
+		{
+			aBoxes[ i ].createUnbounded();
+			aBoxes[ i ].transform( mtx );
+
+			TIKI_UT_CHECK( isFrustumTestFinite( aBoxes[ i ].min ) && isFrustumTestFinite( aBoxes[ i ].max ) );
+			TIKI_UT_CHECK( frustum.testIntersectionAxisAlignedBox( aBoxes[ i ] ) != IntersectionTypes_Disjoint );
+		}
+
+		uint32 visibilityMask = 0u;
+		frustum.cullAxisAlignedBoxes( &visibilityMask, aBoxes, count );
+		TIKI_UT_CHECK( visibilityMask == ( 1u << count ) - 1u );
+	}
+}
@@ -0,0 +1,318 @@
+
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/container/concurrentpoolallocator.hpp"
+#include "tiki/container/mpmcqueue.hpp"
+#include "tiki/container/spscqueue.hpp"
+#include "tiki/threading/atomic.hpp"
+#include "tiki/threading/spinlock.hpp"
+#include "tiki/threading/thread.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( LockFree );
+
+	enum
+	{
+		LockFreeTestThreadCount	= 4u,
+		LockFreeTestValueCount	= 100000u
+	};
+
+	struct SpinLockTestData
+	{
+		SpinLock		spinLock;
+		uint64			counter;
+	};
+
+	struct SpscQueueTestData
+	{
+		SpscQueue< uint32 >	queue;
+		uint				failureCount;
+	};
+
+	struct MpmcQueueTestData
+	{
+		MpmcQueue< uint32 >	queue;
+		AtomicUInt32		producerIndex;
+		AtomicUInt32		poppedCount;
+		AtomicUInt32		popCounts[ LockFreeTestThreadCount * LockFreeTestValueCount ];
+	};
+
+	struct ConcurrentPoolTestObject
+	{
+		uint32			owner;
+		uint32			value;
+	};
+
+	struct ConcurrentPoolTestData
+	{
+		ConcurrentPoolAllocator< ConcurrentPoolTestObject >	pool;
+		AtomicUInt32										threadIndex;
+		AtomicUInt32										failureCount;
+	};
+
+	static int spinLockTestThread( const Thread& thread )
+	{
+		SpinLockTestData& data = *static_cast< SpinLockTestData* >( thread.getArgument() );
+		for (uint i = 0u; i < LockFreeTestValueCount; ++i)
+		{
+			SpinLockStackLock lock( data.spinLock );
+			data.counter++;
+		}
+
+		return 0;
+	}
+
+	static int spscQueueTestProducerThread( const Thread& thread )
+	{
+		SpscQueueTestData& data = *static_cast< SpscQueueTestData* >( thread.getArgument() );
+		for (uint32 i = 0u; i < LockFreeTestValueCount; ++i)
+		{
+			SpinBackoff backoff;
+			while ( !data.queue.tryPush( i ) )
+			{
+				backoff.wait();
+			}
+		}
+
+		return 0;
+	}
+
+	static int mpmcQueueTestProducerThread( const Thread& thread )
+	{
+		MpmcQueueTestData& data = *static_cast< MpmcQueueTestData* >( thread.getArgument() );
+
+		const uint32 firstValue = data.producerIndex.fetchAdd( 1u ) * LockFreeTestValueCount;
+		for (uint32 i = 0u; i < LockFreeTestValueCount; ++i)
+		{
+			SpinBackoff backoff;
+			while ( !data.queue.tryPush( firstValue + i ) )
+			{
+				backoff.wait();
+			}
+		}
+
+		return 0;
+	}
+
+	static int mpmcQueueTestConsumerThread( const Thread& thread )
+	{
+		MpmcQueueTestData& data = *static_cast< MpmcQueueTestData* >( thread.getArgument() );
+
+		const uint32 totalCount = LockFreeTestThreadCount * LockFreeTestValueCount;
+		SpinBackoff backoff;
+		while ( data.poppedCount.load() < totalCount )
+		{
+			uint32 value;
+			if ( data.queue.tryPop( value ) )
+			{
+				data.popCounts[ value ].fetchAdd( 1u, AtomicOrder_Relaxed );
+				data.poppedCount.fetchAdd( 1u );
+				backoff.reset();
+			}
+			else
+			{
+				backoff.wait();
+			}
+		}
+
+		return 0;
+	}
+
+	static int concurrentPoolTestThread( const Thread& thread )
+	{
+		ConcurrentPoolTestData& data = *static_cast< ConcurrentPoolTestData* >( thread.getArgument() );
+
+		const uint32 threadIndex = data.threadIndex.fetchAdd( 1u );
+
+		// every thread keeps a few objects alive, so no slot may be handed out twice
+		ConcurrentPoolTestObject* apObjects[ 8u ];
+		for (uint32 i = 0u; i < LockFreeTestValueCount / 8u; ++i)
+		{
+			for (uint j = 0u; j < TIKI_COUNT( apObjects ); ++j)
+			{
+				apObjects[ j ] = data.pool.allocate();
+				if ( apObjects[ j ] == nullptr )
+				{
+					data.failureCount.fetchAdd( 1u );
+					return 0;
+				}
+
+				apObjects[ j ]->owner = threadIndex;
+				apObjects[ j ]->value = i;
+			}
+
+			for (uint j = 0u; j < TIKI_COUNT( apObjects ); ++j)
+			{
+				if ( apObjects[ j ]->owner != threadIndex || apObjects[ j ]->value != i )
+				{
+					data.failureCount.fetchAdd( 1u );
+				}
+				data.pool.free( apObjects[ j ] );
+			}
+		}
+
+		return 0;
+	}
+
+	TIKI_ADD_TEST( ConcurrentPoolAllocatorStress )
+	{
+		ConcurrentPoolTestData data;
+		TIKI_UT_CHECK( data.pool.create( LockFreeTestThreadCount * 8u ) );
+
+		Thread threads[ LockFreeTestThreadCount ];
+		for (uint i = 0u; i < TIKI_COUNT( threads ); ++i)
+		{
+			TIKI_UT_CHECK( threads[ i ].create( concurrentPoolTestThread, &data, 0u, "ConcurrentPoolTest" ) );
+		}
+
+		for (uint i = 0u; i < TIKI_COUNT( threads ); ++i)
+		{
+			threads[ i ].waitForExit();
+			threads[ i ].dispose();
+		}
+		TIKI_UT_CHECK( data.failureCount.load() == 0u );
+
+		// all slots are free again
+		ConcurrentPoolTestObject* apObjects[ LockFreeTestThreadCount * 8u ];
+		for (uint i = 0u; i < TIKI_COUNT( apObjects ); ++i)
+		{
+			apObjects[ i ] = data.pool.allocate();
+			TIKI_UT_CHECK( apObjects[ i ] != nullptr );
+		}
+		TIKI_UT_CHECK( data.pool.allocate() == nullptr );
+
+		for (uint i = 0u; i < TIKI_COUNT( apObjects ); ++i)
+		{
+			data.pool.free( apObjects[ i ] );
+		}
+
+		data.pool.dispose();
+	}
+
+	TIKI_ADD_TEST( SpinLockStress )
+	{
+		SpinLockTestData data;
+		data.counter = 0u;
+
+		Thread threads[ LockFreeTestThreadCount ];
+		for (uint i = 0u; i < TIKI_COUNT( threads ); ++i)
+		{
+			TIKI_UT_CHECK( threads[ i ].create( spinLockTestThread, &data, 0u, "SpinLockTest" ) );
+		}
+
+		for (uint i = 0u; i < TIKI_COUNT( threads ); ++i)
+		{
+			threads[ i ].waitForExit();
+			threads[ i ].dispose();
+		}
+
+		TIKI_UT_CHECK( !data.spinLock.isLocked() );
+		TIKI_UT_CHECK( data.counter == LockFreeTestThreadCount * LockFreeTestValueCount );
+	}
+
+	TIKI_ADD_TEST( SpscQueueStress )
+	{
+		SpscQueueTestData data;
+		data.failureCount = 0u;
+		TIKI_UT_CHECK( data.queue.create( 100u ) );
+		TIKI_UT_CHECK( data.queue.getCapacity() == 128u );
+
+		Thread producerThread;
+		TIKI_UT_CHECK( producerThread.create( spscQueueTestProducerThread, &data, 0u, "SpscQueueTest" ) );
+
+		// values must arrive complete and in order
+		uint32 expectedValue = 0u;
+		SpinBackoff backoff;
+		while ( expectedValue < LockFreeTestValueCount )
+		{
+			uint32 value;
+			if ( !data.queue.tryPop( value ) )
+			{
+				backoff.wait();
+				continue;
+			}
+			backoff.reset();
+
+			if ( value != expectedValue )
+			{
+				data.failureCount++;
+			}
+			expectedValue++;
+		}
+
+		producerThread.waitForExit();
+		producerThread.dispose();
+
+		uint32 value;
+		TIKI_UT_CHECK( !data.queue.tryPop( value ) );
+		TIKI_UT_CHECK( data.queue.isEmpty() );
+		TIKI_UT_CHECK( data.failureCount == 0u );
+
+		data.queue.dispose();
+	}
+
+	TIKI_ADD_TEST( MpmcQueueFull )
+	{
+		MpmcQueue< uint32 > queue;
+		TIKI_UT_CHECK( queue.create( 8u ) );
+
+		for (uint32 i = 0u; i < 8u; ++i)
+		{
+			TIKI_UT_CHECK( queue.tryPush( i ) );
+		}
+		TIKI_UT_CHECK( !queue.tryPush( 8u ) );
+		TIKI_UT_CHECK( queue.getCount() == 8u );
+
+		for (uint32 i = 0u; i < 8u; ++i)
+		{
+			uint32 value = 0xffffffffu;
+			TIKI_UT_CHECK( queue.tryPop( value ) );
+			TIKI_UT_CHECK( value == i );
+		}
+
+		uint32 value;
+		TIKI_UT_CHECK( !queue.tryPop( value ) );
+
+		queue.dispose();
+	}
+
+	TIKI_ADD_TEST( MpmcQueueStress )
+	{
+		MpmcQueueTestData* pData = TIKI_MEMORY_NEW_OBJECT( MpmcQueueTestData );
+		MpmcQueueTestData& data = *pData;
+		TIKI_UT_CHECK( data.queue.create( 64u ) );
+
+		Thread producerThreads[ LockFreeTestThreadCount ];
+		Thread consumerThreads[ LockFreeTestThreadCount ];
+		for (uint i = 0u; i < LockFreeTestThreadCount; ++i)
+		{
+			TIKI_UT_CHECK( producerThreads[ i ].create( mpmcQueueTestProducerThread, &data, 0u, "MpmcQueueProducer" ) );
+			TIKI_UT_CHECK( consumerThreads[ i ].create( mpmcQueueTestConsumerThread, &data, 0u, "MpmcQueueConsumer" ) );
+		}
+
+		for (uint i = 0u; i < LockFreeTestThreadCount; ++i)
+		{
+			producerThreads[ i ].waitForExit();
+			producerThreads[ i ].dispose();
+			consumerThreads[ i ].waitForExit();
+			consumerThreads[ i ].dispose();
+		}
+
+		// every value must be popped exactly once
+		uint failureCount = 0u;
+		for (uint i = 0u; i < TIKI_COUNT( data.popCounts ); ++i)
+		{
+			if ( data.popCounts[ i ].load() != 1u )
+			{
+				failureCount++;
+			}
+		}
+		TIKI_UT_CHECK( failureCount == 0u );
+		TIKI_UT_CHECK( data.queue.isEmpty() );
+
+		data.queue.dispose();
+		TIKI_MEMORY_DELETE_OBJECT( pData );
+	}
+}
@@ -0,0 +1,94 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/math/matrix.hpp"
+#include "tiki/math/quaternion.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Matrix43 );
+
+	static float getMatrix43TestValue( uint32& state )
+	{
+		state = state * 1664525u + 1013904223u;
+		return float( state >> 8u ) / float( 1u << 24u ) * 4.0f - 2.0f;
+	}
+
+	static void createMatrix43TestMatrix( Matrix43& mtx, uint32& state )
+	{
+		Quaternion rotation;
+		quaternion::fromYawPitchRoll( rotation, getMatrix43TestValue( state ), getMatrix43TestValue( state ), getMatrix43TestValue( state ) );
+		quaternion::toMatrix( mtx.rot, rotation );
+
+		vector::scale( mtx.rot.x, 0.5f + f32::abs( getMatrix43TestValue( state ) ) );
+		vector::scale( mtx.rot.y, 0.5f + f32::abs( getMatrix43TestValue( state ) ) );
+		vector::scale( mtx.rot.z, 0.5f + f32::abs( getMatrix43TestValue( state ) ) );
+		vector::set( mtx.pos, getMatrix43TestValue( state ), getMatrix43TestValue( state ), getMatrix43TestValue( state ) );
+	}
+
+	TIKI_ADD_TEST( Matrix43TransformBatch )
+	{
+		uint32 state = 42u;
+
+		Matrix43 mtx;
+		createMatrix43TestMatrix( mtx, state );
+
+		Vector3 aPoints[ 37u ];
+		Vector3 aResults[ 37u ];
+		for (uint i = 0u; i < TIKI_COUNT( aPoints ); ++i)
+		{
+			vector::set( aPoints[ i ], getMatrix43TestValue( state ), getMatrix43TestValue( state ), getMatrix43TestValue( state ) );
+		}
+
+		matrix::transformBatch( aResults, aPoints, TIKI_COUNT( aPoints ), mtx );
+
+		for (uint i = 0u; i < TIKI_COUNT( aPoints ); ++i)
+		{
+			// scalar reference
+			const Vector3& point = aPoints[ i ];
+			const float x = point.x * mtx.rot.x.x + point.y * mtx.rot.x.y + point.z * mtx.rot.x.z + mtx.pos.x;
+			const float y = point.x * mtx.rot.y.x + point.y * mtx.rot.y.y + point.z * mtx.rot.y.z + mtx.pos.y;
+			const float z = point.x * mtx.rot.z.x + point.y * mtx.rot.z.y + point.z * mtx.rot.z.z + mtx.pos.z;
+
+			TIKI_UT_CHECK( f32::isEquals( aResults[ i ].x, x, 0.0001f ) );
+			TIKI_UT_CHECK( f32::isEquals( aResults[ i ].y, y, 0.0001f ) );
+			TIKI_UT_CHECK( f32::isEquals( aResults[ i ].z, z, 0.0001f ) );
+
+			Vector3 single = point;
+			matrix::transform( single, mtx );
+			TIKI_UT_CHECK( vector::isEquals( single, aResults[ i ], 0.0001f ) );
+		}
+
+		// in place
+		matrix::transformBatch( aPoints, aPoints, TIKI_COUNT( aPoints ), mtx );
+		for (uint i = 0u; i < TIKI_COUNT( aPoints ); ++i)
+		{
+			TIKI_UT_CHECK( vector::isEquals( aPoints[ i ], aResults[ i ], 0.0001f ) );
+		}
+	}
+
+	TIKI_ADD_TEST( Matrix43InvertTranspose )
+	{
+		uint32 state = 7u;
+
+		for (uint i = 0u; i < 16u; ++i)
+		{
+			Matrix43 mtx;
+			createMatrix43TestMatrix( mtx, state );
+
+			Matrix44 expected;
+			matrix::set( expected, mtx );
+			TIKI_UT_CHECK( matrix::invert( expected, expected ) );
+			matrix::transpose( expected );
+
+			Matrix44 test;
+			TIKI_UT_CHECK( matrix::invertTranspose( test, mtx ) );
+			TIKI_UT_CHECK( matrix::isEquals( test, expected, 0.001f ) );
+		}
+
+		Matrix43 singular = Matrix43::identity;
+		vector::clear( singular.rot.z );
+
+		Matrix44 test;
+		TIKI_UT_CHECK( !matrix::invertTranspose( test, singular ) );
+	}
+}
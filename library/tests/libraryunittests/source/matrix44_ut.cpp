@@ -1,11 +1,18 @@
 #include "tiki/unittest/unittest.hpp"
 
 #include "tiki/math/matrix.hpp"
+#include "tiki/math/quaternion.hpp"
 
 namespace tiki
 {
 	TIKI_BEGIN_UNITTEST( Matrix44 );
 
+	static float getMatrix44TestValue( uint32& state )
+	{
+		state = state * 1664525u + 1013904223u;
+		return float( state >> 8u ) / float( 1u << 24u ) * 4.0f - 2.0f;
+	}
+
 	TIKI_ADD_TEST( Matrix44CreateScale )
 	{
 		const Vector3 scale = { 5.0f, 5.0f, 5.0f };
@@ -258,4 +265,98 @@ namespace tiki
 		TIKI_UT_CHECK( f32::isEquals( test.z, 11.0f, 0.001f ) );
 		TIKI_UT_CHECK( f32::isEquals( test.w, 11.0f, 0.001f ) );
 	}
-}
\ No newline at end of file
+
+	TIKI_ADD_TEST( Matrix44MulBatch )
+	{
+		uint32 state = 1234u;
+
+		Matrix44 aLhs[ 11u ];
+		Matrix44 aRhs[ 11u ];
+		Matrix44 aResults[ 11u ];
+		for (uint i = 0u; i < TIKI_COUNT( aLhs ); ++i)
+		{
+			float* pLhs = &aLhs[ i ].x.x;
+			float* pRhs = &aRhs[ i ].x.x;
+			for (uint j = 0u; j < 16u; ++j)
+			{
+				pLhs[ j ] = getMatrix44TestValue( state );
+				pRhs[ j ] = getMatrix44TestValue( state );
+			}
+		}
+
+		matrix::mulBatch( aResults, aLhs, aRhs, TIKI_COUNT( aLhs ) );
+
+		for (uint i = 0u; i < TIKI_COUNT( aLhs ); ++i)
+		{
+			// scalar reference
+			const float* pLhs		= &aLhs[ i ].x.x;
+			const float* pRhs		= &aRhs[ i ].x.x;
+			const float* pResult	= &aResults[ i ].x.x;
+			for (uint row = 0u; row < 4u; ++row)
+			{
+				for (uint column = 0u; column < 4u; ++column)
+				{
+					float value = 0.0f;
+					for (uint k = 0u; k < 4u; ++k)
+					{
+						value += pLhs[ row * 4u + k ] * pRhs[ k * 4u + column ];
+					}
+
+					TIKI_UT_CHECK( f32::isEquals( pResult[ row * 4u + column ], value, 0.0001f ) );
+				}
+			}
+		}
+
+		// target is the right side like in the skinning
+		matrix::mulBatch( aRhs, aLhs, aRhs, TIKI_COUNT( aLhs ) );
+		for (uint i = 0u; i < TIKI_COUNT( aLhs ); ++i)
+		{
+			TIKI_UT_CHECK( matrix::isEquals( aRhs[ i ], aResults[ i ], 0.0001f ) );
+		}
+	}
+
+	struct Matrix44TestJoint
+	{
+		Quaternion	rotation;
+		Vector3		translation;
+		Vector3		scale;
+	};
+
+	TIKI_ADD_TEST( Matrix44ComposeBatch )
+	{
+		uint32 state = 99u;
+
+		// interleaved like the animation joints and not a multiple of four
+		Matrix44TestJoint aJoints[ 13u ];
+		Matrix44 aResults[ 13u ];
+		for (uint i = 0u; i < TIKI_COUNT( aJoints ); ++i)
+		{
+			quaternion::fromYawPitchRoll( aJoints[ i ].rotation, getMatrix44TestValue( state ), getMatrix44TestValue( state ), getMatrix44TestValue( state ) );
+			vector::set( aJoints[ i ].translation, getMatrix44TestValue( state ), getMatrix44TestValue( state ), getMatrix44TestValue( state ) );
+			vector::set( aJoints[ i ].scale, getMatrix44TestValue( state ), getMatrix44TestValue( state ), getMatrix44TestValue( state ) );
+		}
+
+		matrix::composeBatch( aResults, &aJoints[ 0u ].rotation, &aJoints[ 0u ].translation, &aJoints[ 0u ].scale, TIKI_COUNT( aJoints ), sizeof( Matrix44TestJoint ) );
+
+		for (uint i = 0u; i < TIKI_COUNT( aJoints ); ++i)
+		{
+			const Matrix44TestJoint& joint = aJoints[ i ];
+
+			Matrix44 expected;
+			matrix::compose( expected, joint.rotation, joint.translation, joint.scale );
+			TIKI_UT_CHECK( matrix::isEquals( aResults[ i ], expected, 0.0001f ) );
+
+			Quaternion rotation;
+			Vector3 translation;
+			Vector3 scale;
+			TIKI_UT_CHECK( matrix::decompose( rotation, translation, scale, aResults[ i ] ) );
+			TIKI_UT_CHECK( vector::isEquals( translation, joint.translation, 0.0001f ) );
+			TIKI_UT_CHECK( f32::isEquals( scale.x, f32::abs( joint.scale.x ), 0.001f ) );
+		}
+
+		// the first transform again, only the remaining lanes
+		Matrix44 single;
+		matrix::composeBatch( &single, &aJoints[ 0u ].rotation, &aJoints[ 0u ].translation, &aJoints[ 0u ].scale, 1u, sizeof( Matrix44TestJoint ) );
+		TIKI_UT_CHECK( matrix::isEquals( single, aResults[ 0u ], f32::epsilon ) );
+	}
+}
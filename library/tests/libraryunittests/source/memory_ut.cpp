@@ -0,0 +1,210 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/engineallocator.hpp"
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+#include "tiki/base/poolallocator.hpp"
+#include "tiki/threading/thread.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Memory );
+
+	enum
+	{
+		EngineAllocatorTestCount	= 4096u
+	};
+
+	struct PoolAllocatorTestObject
+	{
+		PoolAllocatorTestObject()
+		{
+			value = 42u;
+		}
+
+		uint64	value;
+		uint8	padding[ 40u ];
+	};
+
+	static int engineAllocatorTestFreeThread( const Thread& thread )
+	{
+		void** ppBlocks = static_cast< void** >( thread.getArgument() );
+		for (uint i = 0u; i < EngineAllocatorTestCount; ++i)
+		{
+			engineallocator::free( ppBlocks[ i ] );
+		}
+
+		return 0;
+	}
+
+	TIKI_ADD_TEST( MemoryAlignedAllocation )
+	{
+		for (uint alignment = TIKI_MINIMUM_ALIGNMENT; alignment <= 4096u; alignment *= 2u)
+		{
+			const uint sizes[] = { 1u, 13u, alignment, 3u * alignment + 1u };
+			for (uint i = 0u; i < TIKI_COUNT( sizes ); ++i)
+			{
+				uint8* pMemory = static_cast< uint8* >( TIKI_MEMORY_ALLOC_ALIGNED( sizes[ i ], alignment ) );
+				TIKI_UT_CHECK( pMemory != nullptr );
+				TIKI_UT_CHECK( isPointerAligned( pMemory, alignment ) );
+
+				memory::set8( pMemory, sizes[ i ], 0xcdu );
+				TIKI_MEMORY_FREE( pMemory );
+			}
+		}
+
+		TIKI_MEMORY_FREE( nullptr );
+	}
+
+	TIKI_ADD_TEST( MemoryTags )
+	{
+		TIKI_UT_CHECK( memory::getCurrentTag() == MemoryTag_Default );
+
+		MemoryTagStatistics startStatistics;
+		memory::getTagStatistics( MemoryTag_Converter, startStatistics );
+
+		void* pSmall	= nullptr;
+		void* pAligned	= nullptr;
+		{
+			MemoryTagScope memoryTag( MemoryTag_Converter );
+			TIKI_UT_CHECK( memory::getCurrentTag() == MemoryTag_Converter );
+
+			pSmall		= TIKI_MEMORY_ALLOC( 100u );
+			pAligned	= TIKI_MEMORY_ALLOC_ALIGNED( 200u, 128u );
+		}
+		TIKI_UT_CHECK( memory::getCurrentTag() == MemoryTag_Default );
+
+		MemoryTagStatistics statistics;
+		memory::getTagStatistics( MemoryTag_Converter, statistics );
+
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+		TIKI_UT_CHECK( statistics.liveSizeInBytes == startStatistics.liveSizeInBytes + 300u );
+		TIKI_UT_CHECK( statistics.liveAllocationCount == startStatistics.liveAllocationCount + 2u );
+		TIKI_UT_CHECK( statistics.totalAllocationCount == startStatistics.totalAllocationCount + 2u );
+		TIKI_UT_CHECK( statistics.overAlignedAllocationCount == startStatistics.overAlignedAllocationCount + 1u );
+		TIKI_UT_CHECK( statistics.peakSizeInBytes >= statistics.liveSizeInBytes );
+#endif
+
+		// the tag is stored with the allocation. freeing in an other scope doesn't matter.
+		TIKI_MEMORY_FREE( pSmall );
+		TIKI_MEMORY_FREE( pAligned );
+
+		memory::getTagStatistics( MemoryTag_Converter, statistics );
+		TIKI_UT_CHECK( statistics.liveSizeInBytes == startStatistics.liveSizeInBytes );
+		TIKI_UT_CHECK( statistics.liveAllocationCount == startStatistics.liveAllocationCount );
+	}
+
+	TIKI_ADD_TEST( MemoryBudget )
+	{
+		MemoryTagScope memoryTag( MemoryTag_Converter );
+
+		MemoryTagStatistics statistics;
+		memory::getTagStatistics( MemoryTag_Converter, statistics );
+		memory::setTagBudget( MemoryTag_Converter, statistics.liveSizeInBytes + 1024u );
+
+		void* pFirst = TIKI_MEMORY_ALLOC( 1000u );
+		void* pSecond = TIKI_MEMORY_ALLOC( 1000u );
+		TIKI_UT_CHECK( pFirst != nullptr );
+		TIKI_UT_CHECK( pSecond != nullptr );
+
+		memory::getTagStatistics( MemoryTag_Converter, statistics );
+#if TIKI_ENABLED( TIKI_USE_MEMORY_TRACKING )
+		TIKI_UT_CHECK( statistics.liveSizeInBytes > statistics.budgetInBytes );
+#endif
+
+		TIKI_MEMORY_FREE( pSecond );
+		TIKI_MEMORY_FREE( pFirst );
+		memory::setTagBudget( MemoryTag_Converter, 0u );
+	}
+
+	TIKI_ADD_TEST( EngineAllocator )
+	{
+		// every size class, aligned requests and large blocks
+		for (uint size = 1u; size <= 80u * 1024u; size += ( size < 512u ? 7u : 1531u ))
+		{
+			for (uint alignment = 8u; alignment <= 256u; alignment *= 4u)
+			{
+				uint8* pFirst = static_cast< uint8* >( engineallocator::allocate( size, alignment ) );
+				uint8* pSecond = static_cast< uint8* >( engineallocator::allocate( size, alignment ) );
+				TIKI_UT_CHECK( pFirst != nullptr && pSecond != nullptr );
+				TIKI_UT_CHECK( isPointerAligned( pFirst, alignment ) && isPointerAligned( pSecond, alignment ) );
+				TIKI_UT_CHECK( pFirst + size <= pSecond || pSecond + size <= pFirst );
+
+				memory::set8( pFirst, size, 0x11u );
+				memory::set8( pSecond, size, 0x22u );
+				TIKI_UT_CHECK( pFirst[ size - 1u ] == 0x11u && pSecond[ 0u ] == 0x22u );
+
+				engineallocator::free( pSecond );
+				engineallocator::free( pFirst );
+			}
+		}
+
+		// blocks freed by an other thread go back to the shared slabs
+		void** ppBlocks = static_cast< void** >( engineallocator::allocate( sizeof( void* ) * EngineAllocatorTestCount, TIKI_MINIMUM_ALIGNMENT ) );
+		for (uint i = 0u; i < EngineAllocatorTestCount; ++i)
+		{
+			ppBlocks[ i ] = engineallocator::allocate( 48u, TIKI_MINIMUM_ALIGNMENT );
+			TIKI_UT_CHECK( ppBlocks[ i ] != nullptr );
+		}
+
+		Thread thread;
+		TIKI_UT_CHECK( thread.create( engineAllocatorTestFreeThread, ppBlocks, 0u, "EngineAllocatorTest" ) );
+		thread.waitForExit();
+		thread.dispose();
+
+		for (uint i = 0u; i < EngineAllocatorTestCount; ++i)
+		{
+			ppBlocks[ i ] = engineallocator::allocate( 48u, TIKI_MINIMUM_ALIGNMENT );
+			TIKI_UT_CHECK( ppBlocks[ i ] != nullptr );
+		}
+
+		for (uint i = 0u; i < EngineAllocatorTestCount; ++i)
+		{
+			engineallocator::free( ppBlocks[ i ] );
+		}
+		engineallocator::free( ppBlocks );
+		engineallocator::flushThreadCache();
+	}
+
+	TIKI_ADD_TEST( PoolAllocatorTypes )
+	{
+		const PoolAllocatorType types[] = { PoolAllocatorType_FreeList, PoolAllocatorType_Bitmask };
+		for (uint typeIndex = 0u; typeIndex < TIKI_COUNT( types ); ++typeIndex)
+		{
+			PoolAllocator< PoolAllocatorTestObject > pool;
+			TIKI_UT_CHECK( pool.create( 100u, 64u, types[ typeIndex ] ) );
+
+			PoolAllocatorTestObject* apObjects[ 100u ];
+			for (uint i = 0u; i < TIKI_COUNT( apObjects ); ++i)
+			{
+				apObjects[ i ] = pool.allocate();
+				TIKI_UT_CHECK( apObjects[ i ] != nullptr );
+				TIKI_UT_CHECK( isPointerAligned( apObjects[ i ], 64u ) );
+				TIKI_UT_CHECK( apObjects[ i ]->value == 42u );
+
+				apObjects[ i ]->value = i;
+			}
+			TIKI_UT_CHECK( pool.allocate() == nullptr );
+			TIKI_UT_CHECK( pool.getCount() == 100u );
+
+			for (uint i = 0u; i < TIKI_COUNT( apObjects ); ++i)
+			{
+				TIKI_UT_CHECK( apObjects[ i ]->value == i );
+			}
+
+			// a released slot is handed out again
+			pool.free( apObjects[ 37u ] );
+			PoolAllocatorTestObject* pObject = pool.allocate();
+			TIKI_UT_CHECK( pObject == apObjects[ 37u ] );
+			TIKI_UT_CHECK( pool.allocate() == nullptr );
+
+			for (uint i = 0u; i < TIKI_COUNT( apObjects ); ++i)
+			{
+				pool.free( apObjects[ i ] );
+			}
+			TIKI_UT_CHECK( pool.getCount() == 0u );
+
+			pool.dispose();
+		}
+	}
+}
@@ -0,0 +1,147 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/simd.hpp"
+#include "tiki/base/simdkernels.hpp"
+
+#include <math.h>
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Simd );
+
+	static bool isSimdTestEqual( float value, float expected, float epsilon )
+	{
+		return fabsf( value - expected ) <= epsilon * ( 1.0f + fabsf( expected ) );
+	}
+
+	TIKI_ADD_TEST( SimdVectorOperations )
+	{
+		const vf32 v1 = simd::set_f32( 1.0f, 2.0f, 3.0f, 4.0f );
+		const vf32 v2 = simd::set_f32( 4.0f, 3.0f, 2.0f, 1.0f );
+
+		// x is the first lane
+		TIKI_UT_CHECK( simd::get_f32_x( v1 ) == 1.0f && simd::get_f32_w( v1 ) == 4.0f );
+
+		TIKI_ALIGN_PREFIX( 16 ) float aValues[ 4u ] TIKI_ALIGN_POSTFIX( 16 );
+		simd::get_f32( aValues, simd::muladd_f32( v1, v2, simd::set_f32( 1.0f ) ) );
+		TIKI_UT_CHECK( aValues[ 0u ] == 5.0f && aValues[ 1u ] == 7.0f && aValues[ 2u ] == 7.0f && aValues[ 3u ] == 5.0f );
+
+		TIKI_UT_CHECK( simd::get_f32_x( simd::dot4_f32( v1, v2 ) ) == 20.0f );
+		TIKI_UT_CHECK( simd::get_f32_z( simd::min_f32( v1, v2 ) ) == 2.0f );
+		TIKI_UT_CHECK( simd::get_f32_y( simd::max_f32( v1, v2 ) ) == 3.0f );
+		TIKI_UT_CHECK( simd::mask_f32( simd::cmplt_f32( v1, v2 ) ) == 0x3u );
+		TIKI_UT_CHECK( simd::mask_f32( simd::cmpge_f32( v1, v2 ) ) == 0xcu );
+		TIKI_UT_CHECK( simd::get_f32_w( simd::select_f32( simd::cmplt_f32( v1, v2 ), v1, v2 ) ) == 1.0f );
+
+		const sint16 aShorts[ 8u ] = { -1, 2, -3, 4, 5, -6, 7, -32768 };
+		const vi16 shorts = simd::set_i16u( aShorts );
+		TIKI_UT_CHECK( simd::get_i32_x( simd::convert_i16l_to_i32( shorts ) ) == -1 );
+		TIKI_UT_CHECK( simd::get_i32_w( simd::convert_i16l_to_i32( shorts ) ) == 4 );
+		TIKI_UT_CHECK( simd::get_i32_y( simd::convert_i16h_to_i32( shorts ) ) == -6 );
+		TIKI_UT_CHECK( simd::get_f32_w( simd::convert_i32_to_f32( simd::convert_i16h_to_i32( shorts ) ) ) == -32768.0f );
+	}
+
+	TIKI_ADD_TEST( SimdVector8Operations )
+	{
+		TIKI_ALIGN_PREFIX( 32 ) float aValues1[ 8u ] TIKI_ALIGN_POSTFIX( 32 );
+		TIKI_ALIGN_PREFIX( 32 ) float aValues2[ 8u ] TIKI_ALIGN_POSTFIX( 32 );
+		for (uint i = 0u; i < 8u; ++i)
+		{
+			aValues1[ i ] = float( i );
+			aValues2[ i ] = float( 8u - i );
+		}
+
+		const vf32x8 v1 = simd::set_f32x8( aValues1 );
+		const vf32x8 v2 = simd::set_f32x8u( aValues2 );
+
+		TIKI_ALIGN_PREFIX( 32 ) float aResult[ 8u ] TIKI_ALIGN_POSTFIX( 32 );
+		simd::get_f32x8( aResult, simd::muladd_f32x8( v1, v2, simd::set_f32x8( 0.5f ) ) );
+		for (uint i = 0u; i < 8u; ++i)
+		{
+			TIKI_UT_CHECK( aResult[ i ] == aValues1[ i ] * aValues2[ i ] + 0.5f );
+		}
+
+		simd::get_f32x8u( aResult, simd::sqrt_f32x8( simd::mul_f32x8( v1, v1 ) ) );
+		TIKI_UT_CHECK( aResult[ 7u ] == 7.0f );
+
+		// 0..3 are less than 8..5, 4 equals 4
+		TIKI_UT_CHECK( simd::mask_f32x8( simd::cmplt_f32x8( v1, v2 ) ) == 0x0fu );
+		TIKI_UT_CHECK( simd::mask_f32x8( simd::cmple_f32x8( v1, v2 ) ) == 0x1fu );
+		TIKI_UT_CHECK( simd::mask_f32x8( simd::cmpgt_f32x8( v1, v2 ) ) == 0xe0u );
+
+		simd::get_f32x8( aResult, simd::select_f32x8( simd::cmplt_f32x8( v1, v2 ), v1, v2 ) );
+		TIKI_UT_CHECK( aResult[ 0u ] == 0.0f && aResult[ 3u ] == 3.0f && aResult[ 5u ] == 3.0f && aResult[ 7u ] == 1.0f );
+	}
+
+	TIKI_ADD_TEST( SimdKernelLevels )
+	{
+		const uint count = 1003u;
+
+		sint16 aShorts[ count ];
+		float aA[ count ];
+		float aB[ count ];
+		float aC[ count ];
+		float aD[ count ];
+		float aTime[ count ];
+		for (uint i = 0u; i < count; ++i)
+		{
+			aShorts[ i ]	= sint16( ( i * 7919u ) & 0xffffu );
+			aA[ i ]			= float( i ) * 0.25f - 100.0f;
+			aB[ i ]			= float( count - i ) * 0.125f;
+			aC[ i ]			= float( i % 17u ) - 8.0f;
+			aD[ i ]			= float( i % 5u ) * 0.5f;
+			aTime[ i ]		= float( i % 101u ) / 100.0f;
+		}
+
+		const SimdKernels* pScalar = simd::getKernels( SimdKernelLevel_Scalar );
+		TIKI_UT_CHECK( pScalar != nullptr );
+		TIKI_UT_CHECK( simd::getKernels( simd::getKernelLevel() ) == &simd::getKernels() );
+
+		float aExpected[ count ];
+		float aResult[ count ];
+		for (uint level = 0u; level < SimdKernelLevel_Count; ++level)
+		{
+			const SimdKernels* pKernels = simd::getKernels( (SimdKernelLevel)level );
+			if ( pKernels == nullptr )
+			{
+				continue;
+			}
+
+			// unaligned pointers and odd counts go through the scalar tail
+			pScalar->pConvertInt16ToFloat( aExpected, aShorts + 1u, 0.5f, count - 1u );
+			pKernels->pConvertInt16ToFloat( aResult, aShorts + 1u, 0.5f, count - 1u );
+			for (uint i = 0u; i < count - 1u; ++i)
+			{
+				TIKI_UT_CHECK( aResult[ i ] == aExpected[ i ] );
+			}
+
+			pScalar->pMultiplyAdd( aExpected, aA, aB, aC + 1u, count - 1u );
+			pKernels->pMultiplyAdd( aResult, aA, aB, aC + 1u, count - 1u );
+			for (uint i = 0u; i < count - 1u; ++i)
+			{
+				TIKI_UT_CHECK( isSimdTestEqual( aResult[ i ], aExpected[ i ], 1e-6f ) );
+			}
+
+			pScalar->pHermite( aExpected, aA, aB, aC, aD, aTime, count );
+			pKernels->pHermite( aResult, aA, aB, aC, aD, aTime, count );
+			for (uint i = 0u; i < count; ++i)
+			{
+				TIKI_UT_CHECK( isSimdTestEqual( aResult[ i ], aExpected[ i ], 1e-5f ) );
+			}
+		}
+
+		// the curve starts at p0 and ends at p1
+		const float p0 = 1.0f;
+		const float t0 = 4.0f;
+		const float p1 = -2.0f;
+		const float t1 = 0.5f;
+		const float aTimes[ 2u ] = { 0.0f, 1.0f };
+		const float aP0[ 2u ] = { p0, p0 };
+		const float aT0[ 2u ] = { t0, t0 };
+		const float aP1[ 2u ] = { p1, p1 };
+		const float aT1[ 2u ] = { t1, t1 };
+		simd::getKernels().pHermite( aResult, aP0, aT0, aP1, aT1, aTimes, 2u );
+		TIKI_UT_CHECK( isSimdTestEqual( aResult[ 0u ], p0, 1e-6f ) );
+		TIKI_UT_CHECK( isSimdTestEqual( aResult[ 1u ], p1, 1e-6f ) );
+	}
+}
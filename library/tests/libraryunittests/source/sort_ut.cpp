@@ -0,0 +1,155 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/memory.hpp"
+#include "tiki/base/sort.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Sort );
+
+	struct SortTestElement
+	{
+		uint32	key;
+		uint32	index;
+	};
+
+	struct SortTestKeyExtractor
+	{
+		uint32 operator()( const SortTestElement& element ) const { return element.key; }
+	};
+
+	struct SortTestKey64Extractor
+	{
+		uint64 operator()( const SortTestElement& element ) const { return ( uint64( element.key ) << 32u ) | ( element.index & 0xfu ); }
+	};
+
+	enum SortTestPattern
+	{
+		SortTestPattern_Random,
+		SortTestPattern_Sorted,
+		SortTestPattern_Reversed,
+		SortTestPattern_Equal,
+		SortTestPattern_FewValues,
+
+		SortTestPattern_Count
+	};
+
+	static void fillSortTestData( uint32* pData, uint count, SortTestPattern pattern )
+	{
+		uint32 state = 0x2545f491u;
+		for (uint i = 0u; i < count; ++i)
+		{
+			state ^= state << 13u;
+			state ^= state >> 17u;
+			state ^= state << 5u;
+
+			switch ( pattern )
+			{
+			case SortTestPattern_Random:	pData[ i ] = state; break;
+			case SortTestPattern_Sorted:	pData[ i ] = uint32( i ); break;
+			case SortTestPattern_Reversed:	pData[ i ] = uint32( count - i ); break;
+			case SortTestPattern_Equal:		pData[ i ] = 42u; break;
+			case SortTestPattern_FewValues:	pData[ i ] = state % 4u; break;
+			default: break;
+			}
+		}
+	}
+
+	static bool isSortTestDataSorted( const uint32* pData, uint count )
+	{
+		for (uint i = 1u; i < count; ++i)
+		{
+			if ( pData[ i ] < pData[ i - 1u ] )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	TIKI_ADD_TEST( SortIntroSortPatterns )
+	{
+		const uint counts[] = { 0u, 1u, 2u, 15u, 16u, 17u, 1000u, 50000u };
+
+		uint32* pData = TIKI_MEMORY_NEW_ARRAY( uint32, 50000u, false );
+		for (uint pattern = 0u; pattern < SortTestPattern_Count; ++pattern)
+		{
+			for (uint i = 0u; i < TIKI_COUNT( counts ); ++i)
+			{
+				fillSortTestData( pData, counts[ i ], (SortTestPattern)pattern );
+				quickSort( pData, counts[ i ] );
+				TIKI_UT_CHECK( isSortTestDataSorted( pData, counts[ i ] ) );
+
+				fillSortTestData( pData, counts[ i ], (SortTestPattern)pattern );
+				heapSort( pData, counts[ i ], SortLess< uint32 >() );
+				TIKI_UT_CHECK( isSortTestDataSorted( pData, counts[ i ] ) );
+			}
+		}
+		TIKI_MEMORY_DELETE_ARRAY( pData, 50000u );
+
+		// quickSortRange only touches the given range
+		uint32 aValues[] = { 9u, 5u, 4u, 3u, 2u, 0u };
+		quickSortRange( aValues, 1u, 4u );
+		TIKI_UT_CHECK( aValues[ 0u ] == 9u && aValues[ 1u ] == 2u && aValues[ 4u ] == 5u && aValues[ 5u ] == 0u );
+	}
+
+	TIKI_ADD_TEST( SortRadixSortStable )
+	{
+		const uint count = 20000u;
+		SortTestElement* pElements	= TIKI_MEMORY_NEW_ARRAY( SortTestElement, count, false );
+		SortTestElement* pScratch	= TIKI_MEMORY_NEW_ARRAY( SortTestElement, count, false );
+		uint32* pKeys				= TIKI_MEMORY_NEW_ARRAY( uint32, count, false );
+
+		for (uint pattern = 0u; pattern < SortTestPattern_Count; ++pattern)
+		{
+			fillSortTestData( pKeys, count, (SortTestPattern)pattern );
+			for (uint i = 0u; i < count; ++i)
+			{
+				pElements[ i ].key		= pKeys[ i ];
+				pElements[ i ].index	= uint32( i );
+			}
+
+			radixSort( pElements, pScratch, count, SortTestKeyExtractor() );
+
+			bool isSorted = true;
+			for (uint i = 1u; i < count; ++i)
+			{
+				const SortTestElement& previous = pElements[ i - 1u ];
+				const SortTestElement& current = pElements[ i ];
+
+				// equal keys keep their order
+				isSorted &= ( previous.key < current.key || ( previous.key == current.key && previous.index < current.index ) );
+			}
+			TIKI_UT_CHECK( isSorted );
+
+			radixSort( pElements, pScratch, count, SortTestKey64Extractor() );
+
+			bool isSorted64 = true;
+			for (uint i = 1u; i < count; ++i)
+			{
+				isSorted64 &= ( SortTestKey64Extractor()( pElements[ i - 1u ] ) <= SortTestKey64Extractor()( pElements[ i ] ) );
+			}
+			TIKI_UT_CHECK( isSorted64 );
+		}
+
+		TIKI_MEMORY_DELETE_ARRAY( pElements, count );
+		TIKI_MEMORY_DELETE_ARRAY( pScratch, count );
+		TIKI_MEMORY_DELETE_ARRAY( pKeys, count );
+	}
+
+	TIKI_ADD_TEST( SortRadixSortKeys )
+	{
+		const float floatValues[] = { -1000.0f, -2.5f, -0.0f, 0.0f, 0.5f, 3.0f, 1e20f };
+		for (uint i = 1u; i < TIKI_COUNT( floatValues ); ++i)
+		{
+			TIKI_UT_CHECK( getRadixSortKey( floatValues[ i - 1u ] ) <= getRadixSortKey( floatValues[ i ] ) );
+		}
+
+		const sint32 intValues[] = { -2147483647 - 1, -5, -1, 0, 1, 2147483647 };
+		for (uint i = 1u; i < TIKI_COUNT( intValues ); ++i)
+		{
+			TIKI_UT_CHECK( getRadixSortKey( intValues[ i - 1u ] ) < getRadixSortKey( intValues[ i ] ) );
+		}
+	}
+}
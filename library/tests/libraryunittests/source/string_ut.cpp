@@ -0,0 +1,95 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/crc32.hpp"
+#include "tiki/base/string.hpp"
+#include "tiki/base/stringid.hpp"
+#include "tiki/container/hashmap.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( String );
+
+	TIKI_ADD_TEST( StringSmallBuffer )
+	{
+		string empty;
+		TIKI_UT_CHECK( empty.isEmpty() );
+		TIKI_UT_CHECK( isStringEquals( empty.cStr(), "" ) );
+
+		string str = "short";
+		TIKI_UT_CHECK( str.getLength() == 5u );
+		TIKI_UT_CHECK( str == "short" );
+
+		// grows from the local buffer to the heap
+		for (uint i = 0u; i < 10u; ++i)
+		{
+			str += "_suffix";
+		}
+		TIKI_UT_CHECK( str.getLength() == 75u );
+		TIKI_UT_CHECK( str.startsWith( "short_suffix" ) && str.endsWith( "_suffix_suffix" ) );
+
+		// assignment of short strings reuses the buffer
+		const char* pData = str.cStr();
+		str = string( "tiny" );
+		TIKI_UT_CHECK( str.cStr() == pData );
+		TIKI_UT_CHECK( str == "tiny" );
+
+		str = str;
+		TIKI_UT_CHECK( str == "tiny" );
+
+		const string longString = formatString( "%s/%s/%s", "directory", "subdirectory", "filename.extension" );
+		const string copy = longString;
+		TIKI_UT_CHECK( copy == longString );
+		TIKI_UT_CHECK( copy.cStr() != longString.cStr() );
+		TIKI_UT_CHECK( copy.subString( 10u, 12 ) == "subdirectory" );
+
+		const string partial( "abcdef", 3 );
+		TIKI_UT_CHECK( partial.getLength() == 3u && partial == "abc" );
+	}
+
+	TIKI_ADD_TEST( StringIdInterning )
+	{
+		const StringId id1( "TransformComponent" );
+		const string name = "Transform" + string( "Component" );
+		const StringId id2( name );
+
+		TIKI_UT_CHECK( id1 == id2 );
+		TIKI_UT_CHECK( id1.getString() == id2.getString() );
+		TIKI_UT_CHECK( id1.getCrc() == crcString( "TransformComponent" ) );
+		TIKI_UT_CHECK( id1.getLength() == 18u );
+		TIKI_UT_CHECK( id1 != StringId( "Transform", 9u ) );
+
+		TIKI_UT_CHECK( StringId::find( "TransformComponent" ) == id1 );
+		TIKI_UT_CHECK( StringId::find( "StringIdNeverInterned" ).isEmpty() );
+
+		const StringId empty( "" );
+		TIKI_UT_CHECK( empty.isEmpty() && empty == StringId() );
+		TIKI_UT_CHECK( isStringEquals( empty.getString(), "" ) );
+	}
+
+	TIKI_ADD_TEST( StringIdTableGrowth )
+	{
+		const uint count = 20000u;
+		const uint internedCount = StringId::getInternedCount();
+
+		HashMap< StringId, uint > map;
+		for (uint i = 0u; i < count; ++i)
+		{
+			map.set( StringId( formatString( "string_id_%u", i ) ), i );
+		}
+		TIKI_UT_CHECK( StringId::getInternedCount() == internedCount + count );
+
+		// the same strings are found after the table grew
+		for (uint i = 0u; i < count; ++i)
+		{
+			const string str = formatString( "string_id_%u", i );
+			const StringId id = StringId::find( str.cStr() );
+			TIKI_UT_CHECK( !id.isEmpty() && isStringEquals( id.getString(), str.cStr() ) );
+
+			uint value = 0u;
+			TIKI_UT_CHECK( map.findValue( &value, id ) && value == i );
+		}
+
+		StringId( "string_id_0" );
+		TIKI_UT_CHECK( StringId::getInternedCount() == internedCount + count );
+	}
+}
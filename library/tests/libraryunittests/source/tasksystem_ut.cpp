@@ -0,0 +1,449 @@
+
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/functions.hpp"
+#include "tiki/base/memory.hpp"
+#include "tiki/tasksystem/taskcontext.hpp"
+#include "tiki/tasksystem/tasksystem.hpp"
+#include "tiki/threading/atomic.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( TaskSystem );
+
+	struct TaskSystemTestData
+	{
+		TaskSystem*		pTaskSystem;
+		AtomicUInt32	counter;
+		AtomicUInt32	failureCount;
+		uint32			expectedCounter;
+	};
+
+	static void taskSystemTestCountTask( const TaskContext& context )
+	{
+		TaskSystemTestData& data = *static_cast< TaskSystemTestData* >( context.pTaskData );
+		data.counter.fetchAdd( 1u );
+	}
+
+	static void taskSystemTestCheckTask( const TaskContext& context )
+	{
+		TaskSystemTestData& data = *static_cast< TaskSystemTestData* >( context.pTaskData );
+		if ( data.counter.load() != data.expectedCounter )
+		{
+			data.failureCount.fetchAdd( 1u );
+		}
+	}
+
+	static void taskSystemTestSpawnTask( const TaskContext& context )
+	{
+		TaskSystemTestData& data = *static_cast< TaskSystemTestData* >( context.pTaskData );
+
+		TaskId taskIds[ MaxTaskDependencyCount ];
+		for (uint i = 0u; i < TIKI_COUNT( taskIds ); ++i)
+		{
+			taskIds[ i ] = data.pTaskSystem->queueTask( taskSystemTestCountTask, &data );
+		}
+
+		data.pTaskSystem->queueTask( taskSystemTestCheckTask, &data, taskIds, TIKI_COUNT( taskIds ) );
+	}
+
+	static void taskSystemTestWaitTask( const TaskContext& context )
+	{
+		TaskSystemTestData& data = *static_cast< TaskSystemTestData* >( context.pTaskData );
+
+		TaskId taskIds[ MaxTaskDependencyCount ];
+		for (uint i = 0u; i < TIKI_COUNT( taskIds ); ++i)
+		{
+			taskIds[ i ] = data.pTaskSystem->queueTask( taskSystemTestCountTask, &data );
+		}
+
+		// waits inside of a task. with fibers the worker continues with other tasks
+		data.pTaskSystem->waitForTasks( taskIds, TIKI_COUNT( taskIds ) );
+		if ( data.counter.load() != data.expectedCounter )
+		{
+			data.failureCount.fetchAdd( 1u );
+		}
+	}
+
+	static void taskSystemTestFillRange( const TaskContext& context, uint begin, uint end )
+	{
+		uint32* pValues = static_cast< uint32* >( context.pTaskData );
+		for (uint i = begin; i < end; ++i)
+		{
+			pValues[ i ]++;
+		}
+	}
+
+	static void taskSystemTestSumRange( const TaskContext& context, uint64& result, uint begin, uint end )
+	{
+		const uint32* pValues = static_cast< const uint32* >( context.pTaskData );
+		for (uint i = begin; i < end; ++i)
+		{
+			result += pValues[ i ];
+		}
+	}
+
+	static void taskSystemTestSumCombine( uint64& target, const uint64& source )
+	{
+		target += source;
+	}
+
+	static void taskSystemTestFirstRange( const TaskContext& context, uint& result, uint begin, uint end )
+	{
+		if ( result == TIKI_SIZE_T_MAX )
+		{
+			result = begin;
+		}
+	}
+
+	static void taskSystemTestFirstCombine( uint& target, const uint& source )
+	{
+		if ( target == TIKI_SIZE_T_MAX )
+		{
+			target = source;
+		}
+	}
+
+	TIKI_ADD_TEST( TaskSystemFanInJoin )
+	{
+		TaskSystemParameters parameters;
+		parameters.maxTaskCount = 64u;
+
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( parameters ) );
+
+		for (uint j = 0u; j < 100u; ++j)
+		{
+			TaskSystemTestData data;
+			data.pTaskSystem		= &taskSystem;
+			data.expectedCounter	= MaxTaskDependencyCount;
+
+			TaskId taskIds[ MaxTaskDependencyCount ];
+			for (uint i = 0u; i < TIKI_COUNT( taskIds ); ++i)
+			{
+				taskIds[ i ] = taskSystem.queueTask( taskSystemTestCountTask, &data );
+			}
+
+			const TaskId joinTaskId = taskSystem.queueTask( taskSystemTestCheckTask, &data, taskIds, TIKI_COUNT( taskIds ) );
+			taskSystem.waitForTask( joinTaskId );
+
+			TIKI_UT_CHECK( data.counter.load() == MaxTaskDependencyCount );
+			TIKI_UT_CHECK( data.failureCount.load() == 0u );
+		}
+
+		taskSystem.dispose();
+	}
+
+	TIKI_ADD_TEST( TaskSystemContinuationChain )
+	{
+		TaskSystemParameters parameters;
+		parameters.maxTaskCount = 256u;
+
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( parameters ) );
+
+		const uint chainLength = 1000u;
+
+		TaskSystemTestData data;
+		data.pTaskSystem = &taskSystem;
+
+		TaskId lastTaskId = InvalidTaskId;
+		for (uint i = 0u; i < chainLength; ++i)
+		{
+			lastTaskId = taskSystem.queueTask( taskSystemTestCountTask, &data, lastTaskId );
+		}
+
+		// an empty task joins the chain
+		data.expectedCounter = chainLength;
+		const TaskId checkTaskId = taskSystem.queueTask( taskSystemTestCheckTask, &data, lastTaskId );
+		const TaskId joinTaskId = taskSystem.queueTask( nullptr, nullptr, checkTaskId );
+		taskSystem.waitForTask( joinTaskId );
+
+		TIKI_UT_CHECK( taskSystem.isTaskFinished( lastTaskId ) );
+		TIKI_UT_CHECK( data.counter.load() == chainLength );
+		TIKI_UT_CHECK( data.failureCount.load() == 0u );
+
+		taskSystem.dispose();
+	}
+
+	TIKI_ADD_TEST( TaskSystemSpawnFromTask )
+	{
+		TaskSystemParameters parameters;
+		parameters.maxTaskCount = 512u;
+
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( parameters ) );
+
+		TaskSystemTestData data[ 32u ];
+		TaskId taskIds[ TIKI_COUNT( data ) ];
+		for (uint i = 0u; i < TIKI_COUNT( data ); ++i)
+		{
+			data[ i ].pTaskSystem		= &taskSystem;
+			data[ i ].expectedCounter	= MaxTaskDependencyCount;
+
+			taskIds[ i ] = taskSystem.queueTask( taskSystemTestSpawnTask, &data[ i ] );
+		}
+
+		taskSystem.waitForTasks( taskIds, TIKI_COUNT( taskIds ) );
+		taskSystem.waitForAllTasks();
+
+		for (uint i = 0u; i < TIKI_COUNT( data ); ++i)
+		{
+			TIKI_UT_CHECK( data[ i ].counter.load() == MaxTaskDependencyCount );
+			TIKI_UT_CHECK( data[ i ].failureCount.load() == 0u );
+		}
+
+		taskSystem.dispose();
+	}
+
+	static void taskSystemTestThreadIdTask( const TaskContext& context )
+	{
+		uint64& threadId = *static_cast< uint64* >( context.pTaskData );
+		threadId = Thread::getCurrentThreadId();
+	}
+
+	TIKI_ADD_TEST( TaskSystemWorkerPools )
+	{
+		TaskSystemParameters parameters;
+		parameters.threadCount	= 3u;
+		parameters.poolCount	= 2u;
+
+		parameters.pools[ 0u ].pName			= "Frame";
+		parameters.pools[ 0u ].priorityMask		= TaskPriorityMask_High | TaskPriorityMask_Normal;
+
+		parameters.pools[ 1u ].pName			= "Background";
+		parameters.pools[ 1u ].threadCount		= 1u;
+		parameters.pools[ 1u ].priorityMask		= TaskPriorityMask_Low;
+		parameters.pools[ 1u ].threadPriority	= ThreadPriority_Low;
+
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( parameters ) );
+		TIKI_UT_CHECK( taskSystem.getThreadCount() == 3u );
+		TIKI_UT_CHECK( taskSystem.getPoolThreadCount( 0u ) == 2u );
+		TIKI_UT_CHECK( taskSystem.getPoolThreadCount( 1u ) == 1u );
+
+		uint64 lowThreadIds[ 16u ];
+		uint64 highThreadIds[ 16u ];
+		TaskId taskIds[ TIKI_COUNT( lowThreadIds ) + TIKI_COUNT( highThreadIds ) ];
+		for (uint i = 0u; i < TIKI_COUNT( lowThreadIds ); ++i)
+		{
+			taskIds[ i * 2u ]		= taskSystem.queueTask( taskSystemTestThreadIdTask, &lowThreadIds[ i ], InvalidTaskId, TaskPriority_Low );
+			taskIds[ i * 2u + 1u ]	= taskSystem.queueTask( taskSystemTestThreadIdTask, &highThreadIds[ i ], InvalidTaskId, TaskPriority_High );
+		}
+
+		// don't help. the tasks must run on the workers of their pools.
+		for (uint i = 0u; i < TIKI_COUNT( taskIds ); ++i)
+		{
+			while ( !taskSystem.isTaskFinished( taskIds[ i ] ) )
+			{
+				Thread::sleepCurrentThread( 100 );
+			}
+		}
+
+		const uint64 backgroundThreadId = lowThreadIds[ 0u ];
+		TIKI_UT_CHECK( backgroundThreadId != Thread::getCurrentThreadId() );
+		for (uint i = 0u; i < TIKI_COUNT( lowThreadIds ); ++i)
+		{
+			TIKI_UT_CHECK( lowThreadIds[ i ] == backgroundThreadId );
+			TIKI_UT_CHECK( highThreadIds[ i ] != backgroundThreadId );
+			TIKI_UT_CHECK( highThreadIds[ i ] != Thread::getCurrentThreadId() );
+		}
+
+		taskSystem.dispose();
+
+		// every priority needs a pool and the pools must fit in the budget
+		parameters.pools[ 1u ].priorityMask = TaskPriorityMask_Normal;
+		TIKI_UT_CHECK( !taskSystem.create( parameters ) );
+
+		parameters.pools[ 1u ].priorityMask	= TaskPriorityMask_Low;
+		parameters.pools[ 1u ].threadCount	= 4u;
+		TIKI_UT_CHECK( !taskSystem.create( parameters ) );
+	}
+
+	TIKI_ADD_TEST( TaskSystemWaitWithoutThreads )
+	{
+		TaskSystemParameters parameters;
+		parameters.threadCount	= 0u;
+		parameters.maxTaskCount	= 64u;
+
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( parameters ) );
+
+		// the waiting thread is the only one and has to run the less important dependency too
+		TaskSystemTestData data;
+		data.pTaskSystem		= &taskSystem;
+		data.expectedCounter	= 1u;
+
+		const TaskId lowTaskId	= taskSystem.queueTask( taskSystemTestCountTask, &data, InvalidTaskId, TaskPriority_Low );
+		const TaskId highTaskId	= taskSystem.queueTask( taskSystemTestCheckTask, &data, lowTaskId, TaskPriority_High );
+		taskSystem.waitForTask( highTaskId );
+
+		TIKI_UT_CHECK( data.counter.load() == 1u );
+		TIKI_UT_CHECK( data.failureCount.load() == 0u );
+
+		taskSystem.dispose();
+	}
+
+	TIKI_ADD_TEST( TaskSystemWaitInFiber )
+	{
+		TaskSystemParameters parameters;
+		parameters.maxTaskCount	= 512u;
+		parameters.useFibers	= true;
+		parameters.fiberCount	= 16u;
+
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( parameters ) );
+
+		// more waiting tasks than fibers. the remaining tasks wait on the worker stack.
+		TaskSystemTestData data[ 32u ];
+		TaskId taskIds[ TIKI_COUNT( data ) ];
+		for (uint i = 0u; i < TIKI_COUNT( data ); ++i)
+		{
+			data[ i ].pTaskSystem		= &taskSystem;
+			data[ i ].expectedCounter	= MaxTaskDependencyCount;
+
+			taskIds[ i ] = taskSystem.queueTask( taskSystemTestWaitTask, &data[ i ] );
+		}
+
+		taskSystem.waitForTasks( taskIds, TIKI_COUNT( taskIds ) );
+
+		for (uint i = 0u; i < TIKI_COUNT( data ); ++i)
+		{
+			TIKI_UT_CHECK( data[ i ].counter.load() == MaxTaskDependencyCount );
+			TIKI_UT_CHECK( data[ i ].failureCount.load() == 0u );
+		}
+
+		taskSystem.dispose();
+	}
+
+	TIKI_ADD_TEST( TaskSystemParallelFor )
+	{
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( TaskSystemParameters() ) );
+
+		const uint valueCount = 100003u;
+		uint32* pValues = TIKI_MEMORY_NEW_ARRAY( uint32, valueCount, false );
+		for (uint i = 0u; i < valueCount; ++i)
+		{
+			pValues[ i ] = 0u;
+		}
+
+		taskSystem.parallelFor( 0u, valueCount, 64u, taskSystemTestFillRange, pValues );
+		taskSystem.parallelFor( 7u, valueCount, 1u, taskSystemTestFillRange, pValues );
+
+		for (uint i = 0u; i < valueCount; ++i)
+		{
+			TIKI_UT_CHECK( pValues[ i ] == ( i < 7u ? 1u : 2u ) );
+		}
+
+		const uint64 sum = taskSystem.parallelReduce< uint64 >( 0u, valueCount, 128u, 0u, taskSystemTestSumRange, taskSystemTestSumCombine, pValues );
+		TIKI_UT_CHECK( sum == ( 2u * valueCount ) - 7u );
+
+		// combine order has to match the range order
+		const uint first = taskSystem.parallelReduce< uint >( 13u, valueCount, 16u, TIKI_SIZE_T_MAX, taskSystemTestFirstRange, taskSystemTestFirstCombine, nullptr );
+		TIKI_UT_CHECK( first == 13u );
+
+		TIKI_MEMORY_DELETE_ARRAY( pValues, valueCount );
+		taskSystem.dispose();
+	}
+
+	static void taskSystemTestScratchTask( const TaskContext& context )
+	{
+		TaskSystemTestData& data = *static_cast< TaskSystemTestData* >( context.pTaskData );
+
+		const uint valueCount = data.expectedCounter;
+		uint32* pValues = context.pScratchAllocator->allocateArray< uint32 >( valueCount );
+		uint32* pFrameValue = context.pFrameAllocator->allocateArray< uint32 >( 1u );
+		if ( pValues == nullptr || pFrameValue == nullptr )
+		{
+			data.failureCount.fetchAdd( 1u );
+			return;
+		}
+
+		for (uint i = 0u; i < valueCount; ++i)
+		{
+			pValues[ i ] = uint32( i );
+		}
+
+		for (uint i = 0u; i < valueCount; ++i)
+		{
+			if ( pValues[ i ] != i )
+			{
+				data.failureCount.fetchAdd( 1u );
+			}
+		}
+
+		*pFrameValue = valueCount;
+		data.counter.fetchAdd( 1u );
+	}
+
+	TIKI_ADD_TEST( TaskScratchAllocatorMarker )
+	{
+		TaskScratchAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 256u ) );
+
+		const TaskScratchAllocator::Marker marker = allocator.getMarker();
+		void* pFirst = allocator.allocate( 100u );
+		TIKI_UT_CHECK( pFirst != nullptr );
+		TIKI_UT_CHECK( isPointerAligned( allocator.allocate( 4u, 64u ), 64u ) );
+
+		// doesn't fit into the buffer any more
+		void* pOverflow = allocator.allocate( 200u );
+		TIKI_UT_CHECK( pOverflow != nullptr );
+
+		allocator.freeToMarker( marker );
+		TIKI_UT_CHECK( allocator.allocate( 100u ) == pFirst );
+
+		TaskAllocatorStatistics statistics;
+		allocator.getStatistics( statistics );
+		TIKI_UT_CHECK( statistics.sizeInBytes == 256u );
+		TIKI_UT_CHECK( statistics.highWaterMark >= 104u + 200u );
+		TIKI_UT_CHECK( statistics.overflowCount == 1u );
+
+		allocator.freeToMarker( marker );
+		allocator.dispose();
+	}
+
+	TIKI_ADD_TEST( TaskSystemScratchAllocator )
+	{
+		TaskSystemParameters parameters;
+		parameters.scratchAllocatorSize	= 4096u;
+		parameters.frameAllocatorSize	= 1024u;
+
+		TaskSystem taskSystem;
+		TIKI_UT_CHECK( taskSystem.create( parameters ) );
+
+		TaskSystemTestData data[ 64u ];
+		TaskId taskIds[ TIKI_COUNT( data ) ];
+		for (uint i = 0u; i < TIKI_COUNT( data ); ++i)
+		{
+			// the last task doesn't fit into the scratch allocator
+			data[ i ].expectedCounter = ( i == TIKI_COUNT( data ) - 1u ? 2048u : 256u );
+			taskIds[ i ] = taskSystem.queueTask( taskSystemTestScratchTask, &data[ i ] );
+		}
+		taskSystem.waitForTasks( taskIds, TIKI_COUNT( taskIds ) );
+		taskSystem.endFrame();
+
+		for (uint i = 0u; i < TIKI_COUNT( data ); ++i)
+		{
+			TIKI_UT_CHECK( data[ i ].counter.load() == 1u );
+			TIKI_UT_CHECK( data[ i ].failureCount.load() == 0u );
+		}
+
+		// scratch memory is released after every task
+		TaskAllocatorStatistics statistics;
+		taskSystem.getPoolScratchStatistics( 0u, statistics );
+		if ( taskSystem.getPoolThreadCount( 0u ) > 0u )
+		{
+			TIKI_UT_CHECK( statistics.sizeInBytes == 4096u );
+			TIKI_UT_CHECK( statistics.highWaterMark <= 2048u * sizeof( uint32 ) );
+		}
+
+		// 64 * 4 bytes fit into the frame allocator
+		taskSystem.getFrameStatistics( statistics );
+		TIKI_UT_CHECK( statistics.highWaterMark >= 64u * sizeof( uint32 ) );
+		TIKI_UT_CHECK( statistics.overflowCount == 0u );
+
+		taskSystem.dispose();
+	}
+}
@@ -0,0 +1,192 @@
+
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/threading/event.hpp"
+#include "tiki/threading/mutex.hpp"
+#include "tiki/threading/semaphore.hpp"
+#include "tiki/threading/thread.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( Threading );
+
+	enum
+	{
+		ThreadingTestThreadCount	= 4u,
+		ThreadingTestLockCount		= 100000u,
+		ThreadingTestPingPongCount	= 10000u
+	};
+
+	struct MutexTestData
+	{
+		Mutex		mutex;
+		uint64		counter;
+	};
+
+	struct PingPongTestData
+	{
+		Semaphore	pingSemaphore;
+		Semaphore	pongSemaphore;
+		Event		pingEvent;
+		Event		pongEvent;
+		uint		failureCount;
+	};
+
+	static int mutexTestThread( const Thread& thread )
+	{
+		MutexTestData& data = *static_cast< MutexTestData* >( thread.getArgument() );
+		for (uint i = 0u; i < ThreadingTestLockCount; ++i)
+		{
+			MutexStackLock lock( data.mutex );
+			data.counter++;
+		}
+
+		return 0;
+	}
+
+	static int semaphorePingPongThread( const Thread& thread )
+	{
+		PingPongTestData& data = *static_cast< PingPongTestData* >( thread.getArgument() );
+		for (uint i = 0u; i < ThreadingTestPingPongCount; ++i)
+		{
+			data.pingSemaphore.decrement();
+			data.pongSemaphore.incement();
+		}
+
+		return 0;
+	}
+
+	static int eventPingPongThread( const Thread& thread )
+	{
+		PingPongTestData& data = *static_cast< PingPongTestData* >( thread.getArgument() );
+		for (uint i = 0u; i < ThreadingTestPingPongCount; ++i)
+		{
+			if ( !data.pingEvent.waitForSignal() )
+			{
+				data.failureCount++;
+			}
+			data.pongEvent.signal();
+		}
+
+		return 0;
+	}
+
+	TIKI_ADD_TEST( MutexStress )
+	{
+		MutexTestData data;
+		TIKI_UT_CHECK( data.mutex.create() );
+		data.counter = 0u;
+
+		Thread threads[ ThreadingTestThreadCount ];
+		for (uint i = 0u; i < TIKI_COUNT( threads ); ++i)
+		{
+			TIKI_UT_CHECK( threads[ i ].create( mutexTestThread, &data, 0u, "MutexTest" ) );
+		}
+
+		for (uint i = 0u; i < TIKI_COUNT( threads ); ++i)
+		{
+			threads[ i ].waitForExit();
+			threads[ i ].dispose();
+		}
+
+		TIKI_UT_CHECK( data.counter == ThreadingTestThreadCount * ThreadingTestLockCount );
+		TIKI_UT_CHECK( data.mutex.tryLock( 0 ) );
+		data.mutex.unlock();
+
+		data.mutex.dispose();
+	}
+
+	TIKI_ADD_TEST( SemaphoreTimeOut )
+	{
+		Semaphore semaphore;
+		TIKI_UT_CHECK( semaphore.create( 1u ) );
+
+		TIKI_UT_CHECK( semaphore.tryDecrement( 0 ) );
+		TIKI_UT_CHECK( !semaphore.tryDecrement( 0 ) );
+		TIKI_UT_CHECK( !semaphore.tryDecrement( 10 ) );
+
+		semaphore.incement();
+		semaphore.incement();
+		TIKI_UT_CHECK( semaphore.tryDecrement( 10 ) );
+		TIKI_UT_CHECK( semaphore.tryDecrement() );
+		TIKI_UT_CHECK( !semaphore.tryDecrement( 0 ) );
+
+		semaphore.dispose();
+	}
+
+	TIKI_ADD_TEST( EventReset )
+	{
+		Event autoEvent;
+		TIKI_UT_CHECK( autoEvent.create( true, false ) );
+		TIKI_UT_CHECK( autoEvent.waitForSignal( 0 ) );
+		TIKI_UT_CHECK( !autoEvent.waitForSignal( 10 ) );
+		autoEvent.signal();
+		autoEvent.signal();
+		TIKI_UT_CHECK( autoEvent.waitForSignal( 0 ) );
+		TIKI_UT_CHECK( !autoEvent.waitForSignal( 0 ) );
+		autoEvent.dispose();
+
+		Event manualEvent;
+		TIKI_UT_CHECK( manualEvent.create( false, true ) );
+		TIKI_UT_CHECK( !manualEvent.waitForSignal( 0 ) );
+		manualEvent.signal();
+		TIKI_UT_CHECK( manualEvent.waitForSignal( 0 ) );
+		TIKI_UT_CHECK( manualEvent.waitForSignal( 10 ) );
+		manualEvent.reset();
+		TIKI_UT_CHECK( !manualEvent.waitForSignal( 10 ) );
+		manualEvent.dispose();
+	}
+
+	TIKI_ADD_TEST( SemaphorePingPong )
+	{
+		PingPongTestData data;
+		TIKI_UT_CHECK( data.pingSemaphore.create() );
+		TIKI_UT_CHECK( data.pongSemaphore.create() );
+
+		Thread thread;
+		TIKI_UT_CHECK( thread.create( semaphorePingPongThread, &data, 0u, "PingPongTest" ) );
+
+		for (uint i = 0u; i < ThreadingTestPingPongCount; ++i)
+		{
+			data.pingSemaphore.incement();
+			data.pongSemaphore.decrement();
+		}
+
+		TIKI_UT_CHECK( thread.waitForExit() );
+		thread.dispose();
+
+		TIKI_UT_CHECK( !data.pingSemaphore.tryDecrement( 0 ) );
+		TIKI_UT_CHECK( !data.pongSemaphore.tryDecrement( 0 ) );
+
+		data.pongSemaphore.dispose();
+		data.pingSemaphore.dispose();
+	}
+
+	TIKI_ADD_TEST( EventPingPong )
+	{
+		PingPongTestData data;
+		data.failureCount = 0u;
+		TIKI_UT_CHECK( data.pingEvent.create() );
+		TIKI_UT_CHECK( data.pongEvent.create() );
+
+		Thread thread;
+		TIKI_UT_CHECK( thread.create( eventPingPongThread, &data, 0u, "PingPongTest" ) );
+
+		for (uint i = 0u; i < ThreadingTestPingPongCount; ++i)
+		{
+			data.pingEvent.signal();
+			if ( !data.pongEvent.waitForSignal() )
+			{
+				data.failureCount++;
+			}
+		}
+
+		TIKI_UT_CHECK( thread.waitForExit() );
+		thread.dispose();
+
+		TIKI_UT_CHECK( data.failureCount == 0u );
+
+		data.pongEvent.dispose();
+		data.pingEvent.dispose();
+	}
+}
@@ -0,0 +1,126 @@
+#include "tiki/unittest/unittest.hpp"
+
+#include "tiki/base/functions.hpp"
+#include "tiki/base/zoneallocator.hpp"
+
+namespace tiki
+{
+	TIKI_BEGIN_UNITTEST( ZoneAllocator );
+
+	TIKI_ADD_TEST( ZoneAllocatorGrow )
+	{
+		ZoneAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 256u, 16u ) );
+		TIKI_UT_CHECK( allocator.getPageCount() == 1u );
+
+		uint8* apBlocks[ 64u ];
+		for (uint i = 0u; i < TIKI_COUNT( apBlocks ); ++i)
+		{
+			apBlocks[ i ] = static_cast< uint8* >( allocator.allocate( 48u ) );
+			TIKI_UT_CHECK( apBlocks[ i ] != nullptr );
+			TIKI_UT_CHECK( isPointerAligned( apBlocks[ i ], 16u ) );
+
+			memory::set8( apBlocks[ i ], 48u, uint8( i ) );
+		}
+
+		TIKI_UT_CHECK( allocator.getPageCount() > 1u );
+		TIKI_UT_CHECK( allocator.getCurrentAllocationSize() >= TIKI_COUNT( apBlocks ) * 48u );
+
+		// older pages must stay untouched
+		for (uint i = 0u; i < TIKI_COUNT( apBlocks ); ++i)
+		{
+			TIKI_UT_CHECK( apBlocks[ i ][ 0u ] == uint8( i ) && apBlocks[ i ][ 47u ] == uint8( i ) );
+		}
+
+		// requests bigger than a page get a page of their own
+		void* pLargeBlock = allocator.allocate( 64u * 1024u, 256u );
+		TIKI_UT_CHECK( pLargeBlock != nullptr );
+		TIKI_UT_CHECK( isPointerAligned( pLargeBlock, 256u ) );
+
+		// clear merges the pages
+		const uint capacity = allocator.getCapacity();
+		allocator.clear();
+		TIKI_UT_CHECK( allocator.getPageCount() == 1u );
+		TIKI_UT_CHECK( allocator.getCapacity() == capacity );
+		TIKI_UT_CHECK( allocator.getCurrentAllocationSize() == 0u );
+
+		allocator.dispose();
+	}
+
+	TIKI_ADD_TEST( ZoneAllocatorFreeLast )
+	{
+		ZoneAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 128u ) );
+
+		void* pFirst = allocator.allocate( 32u );
+		void* pSecond = allocator.allocate( 32u );
+		allocator.free( pSecond );
+		TIKI_UT_CHECK( allocator.allocate( 32u ) == pSecond );
+
+		// only the last allocation can be released
+		allocator.free( pFirst );
+		TIKI_UT_CHECK( allocator.getCurrentAllocationSize() == 64u );
+
+		allocator.dispose();
+	}
+
+	TIKI_ADD_TEST( ZoneAllocatorMarkers )
+	{
+		ZoneAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 1024u ) );
+
+		allocator.allocate( 100u );
+		const uint sizeBeforeScope = allocator.getCurrentAllocationSize();
+		const ZoneAllocator::Marker marker = allocator.getMarker();
+
+		void* pScopeBlock = nullptr;
+		{
+			ZoneAllocatorScope scope( allocator );
+			pScopeBlock = allocator.allocate( 200u );
+			for (uint i = 0u; i < 32u; ++i)
+			{
+				TIKI_UT_CHECK( allocator.allocate( 512u ) != nullptr );
+			}
+			TIKI_UT_CHECK( allocator.getPageCount() > 1u );
+		}
+		TIKI_UT_CHECK( allocator.getCurrentAllocationSize() == sizeBeforeScope );
+
+		// the space is used again and the grown pages are kept
+		const uint pageCount = allocator.getPageCount();
+		TIKI_UT_CHECK( allocator.allocate( 200u ) == pScopeBlock );
+		for (uint i = 0u; i < 32u; ++i)
+		{
+			TIKI_UT_CHECK( allocator.allocate( 512u ) != nullptr );
+		}
+		TIKI_UT_CHECK( allocator.getPageCount() == pageCount );
+
+		allocator.freeToMarker( marker );
+		TIKI_UT_CHECK( allocator.getCurrentAllocationSize() == sizeBeforeScope );
+
+		allocator.dispose();
+	}
+
+	TIKI_ADD_TEST( ZoneAllocatorDoubleBuffered )
+	{
+		DoubleBufferedZoneAllocator allocator;
+		TIKI_UT_CHECK( allocator.create( 1024u ) );
+
+		uint32* pFrame0 = allocator.allocateArray< uint32 >( 64u );
+		pFrame0[ 63u ] = 0u;
+
+		allocator.swap();
+		uint32* pFrame1 = allocator.allocateArray< uint32 >( 64u );
+		pFrame1[ 63u ] = 1u;
+		TIKI_UT_CHECK( pFrame0 != pFrame1 );
+		TIKI_UT_CHECK( pFrame0[ 63u ] == 0u );
+		TIKI_UT_CHECK( allocator.getPreviousZone().getCurrentAllocationSize() == 64u * sizeof( uint32 ) );
+
+		// frame 2 reuses the memory of frame 0
+		allocator.swap();
+		TIKI_UT_CHECK( allocator.getCurrentZone().getCurrentAllocationSize() == 0u );
+		TIKI_UT_CHECK( allocator.allocateArray< uint32 >( 64u ) == pFrame0 );
+		TIKI_UT_CHECK( pFrame1[ 63u ] == 1u );
+
+		allocator.dispose();
+	}
+}
@@ -32,7 +32,6 @@ namespace tiki
 
 		void				update( const PhysicsCollisionObject* pPlayerCollider, CollectedCoinIdArray& collectedCoins, float totalGameTime );
 
-		virtual crc32		getTypeCrc() const;
 		virtual uint32		getStateSize() const;
 		virtual const char*	getTypeName() const;
 
@@ -40,7 +40,6 @@ namespace tiki
 
 		void				getPlayerViewState( PlayerViewState& rTargetState, const PlayerControlComponentState* pState ) const;
 
-		virtual crc32		getTypeCrc() const;
 		virtual uint32		getStateSize() const;
 		virtual const char*	getTypeName() const;
 
@@ -1,7 +1,6 @@
 
 #include "tiki/gamecomponents/coincomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/components/lifetimecomponent.hpp"
 #include "tiki/components/physicsbodycomponent.hpp"
@@ -80,11 +79,6 @@ namespace tiki
 		}
 	}
 
-	crc32 CoinComponent::getTypeCrc() const
-	{
-		return crcString( "CoinComponent" );
-	}
-
 	uint32 CoinComponent::getStateSize() const
 	{
 		return sizeof( CoinComponentState );
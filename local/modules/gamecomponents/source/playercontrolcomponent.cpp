@@ -1,7 +1,6 @@
 
 #include "tiki/gamecomponents/playercontrolcomponent.hpp"
 
-#include "tiki/base/crc32.hpp"
 #include "tiki/base/debugprop.hpp"
 #include "tiki/components/componentstate.hpp"
 #include "tiki/components/physicsbodycomponent.hpp"
@@ -163,11 +162,6 @@ namespace tiki
 		return false;
 	}
 
-	crc32 PlayerControlComponent::getTypeCrc() const
-	{
-		return crcString( "PlayerControlComponent" );
-	}
-
 	uint32 PlayerControlComponent::getStateSize() const
 	{
 		return sizeof( PlayerControlComponentState );
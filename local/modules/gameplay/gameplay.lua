@@ -10,6 +10,7 @@ module:add_include_dir( "include" );
 module:add_dependency( "entitysystem" );
 module:add_dependency( "components" );
 module:add_dependency( "gamecomponents" );
+module:add_dependency( "tasksystem" );
 module:add_dependency( "debugrenderer" );
 module:add_dependency( "voxelworld" );
 module:add_dependency( "voxelmesh" );
@@ -17,6 +17,7 @@
 #include "tiki/physics/physicsworld.hpp"
 #include "tiki/renderer/renderscene.hpp"
 #include "tiki/runtimeshared/freecamera.hpp"
+#include "tiki/tasksystem/tasksystem.hpp"
 
 namespace tiki
 {
@@ -80,15 +81,21 @@ namespace tiki
 		const TransformComponent&					getTransformComponent() const { return m_transformComponent; }
 		const TerrainComponent&						getTerrainComponent() const { return m_terrainComponent; }
 
+		TaskSystem&									getTaskSystem() { return m_taskSystem; }
+
 	private:
 
 		enum 
 		{
-			MaxTypeCount	= 16u,
-			ChunkCount		= 128u,
-			ChunkSize		= 4096u
+			MaxTypeCount		= 16u,
+			ChunkCount			= 128u,
+			ChunkSize			= 4096u,
+			MaxTaskThreadCount	= 2u
 		};
 
+		// the framework has no task system to share. the client only splits the transform update, a few workers are enough.
+		TaskSystem							m_taskSystem;
+
 		EntitySystem						m_entitySystem;
 
 		PhysicsWorld						m_physicsWorld;
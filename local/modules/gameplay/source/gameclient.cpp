@@ -2,6 +2,7 @@
 #include "tiki/gameplay/gameclient.hpp"
 
 #include "tiki/base/debugprop.hpp"
+#include "tiki/base/platform.hpp"
 #include "tiki/components/entitytemplate.hpp"
 #include "tiki/graphics/graphicscontext.hpp"
 #include "tiki/math/basetypes.hpp"
@@ -29,6 +30,20 @@ namespace tiki
 
 	bool GameClient::create()
 	{
+		// the main thread helps while it waits and the renderer and the resource loader need cores too. a task system
+		// with a thread per core would oversubscribe the machine.
+		const uint processorCount = platform::getProcessorCount();
+
+		TaskSystemParameters taskSystemParams;
+		taskSystemParams.threadCount		= TIKI_MIN( ( processorCount > 1u ? processorCount - 1u : 0u ), uint( MaxTaskThreadCount ) );
+		taskSystemParams.pools[ 0u ].pName	= "GameClient";
+
+		if ( !m_taskSystem.create( taskSystemParams ) )
+		{
+			dispose();
+			return false;
+		}
+
 		EntitySystemParameters entitySystemParams;
 		entitySystemParams.typeRegisterMaxCount		= MaxTypeCount;
 		entitySystemParams.storageChunkSize			= ChunkSize;
@@ -139,6 +154,8 @@ namespace tiki
 		m_physicsWorld.dispose();
 
 		m_entitySystem.dispose();
+
+		m_taskSystem.dispose();
 	}
 	
 	EntityId GameClient::createPlayerEntity( const Model* pModel, const Vector3& position )
@@ -341,7 +358,9 @@ namespace tiki
 		m_lifeTimeComponent.update( m_entitySystem, timeMs );
 		m_coinComponent.update( updateContext.pPlayerCollider, updateContext.collectedCoins, updateContext.totalGameTime );
 
-		m_transformComponent.update();
+		m_transformComponent.update( &m_taskSystem );
+
+		m_taskSystem.endFrame();
 	}
 
 	void GameClient::render( GameRenderer& gameRenderer, GraphicsContext& graphicsContext )
@@ -58,7 +58,12 @@ namespace tiki
 		bool						endSequence();
 
 	private:
-		
+
+		enum
+		{
+			MaxCommandsPerSequence = 255u
+		};
+
 		RenderSequence*			m_pFirstSequence;
 		RenderSequence*			m_pEndSequence;
 
@@ -68,6 +73,9 @@ namespace tiki
 		ZoneAllocator			m_sequences;
 		ZoneAllocator			m_commands;
 
+		RenderSequence*			allocateSequence();
+		RenderCommand*			allocateCommand();
+
 	};
 }
 
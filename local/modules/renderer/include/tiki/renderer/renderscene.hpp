@@ -7,6 +7,7 @@
 
 namespace tiki
 {
+	struct AxisAlignedBox;
 	struct RenderViewParameters;
 	class RenderView;
 
@@ -85,6 +86,13 @@ namespace tiki
 		SpotLightData&						addSpotLight();
 
 		void								queueModel( const Model* pModel, const Matrix43* pWorldTransform = nullptr, const SkinningData** ppSkinningData = nullptr );
+		// culls the models against all views and queues the visible ones
+		void								queueVisibleModels( const Model* const* ppModels, const Matrix43* pWorldTransforms, uint count );
+
+		// conservative test against the frustums of all views, see Frustum::cullAxisAlignedBoxes for the mask layout.
+		// without views everything is visible.
+		bool								isVisible( const AxisAlignedBox& worldBox ) const;
+		void								cullAxisAlignedBoxes( uint32* pVisibilityMask, const AxisAlignedBox* pWorldBoxes, uint count ) const;
 
 		void								clearState();
 
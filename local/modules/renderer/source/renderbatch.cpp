@@ -67,20 +67,12 @@ namespace tiki
 	{
 		TIKI_ASSERT( m_pCurrentSequence == nullptr );
 
-		m_pCurrentSequence = static_cast< RenderSequence* >( m_sequences.allocate( sizeof( RenderSequence ), 1u ) );
-		
+		m_pCurrentSequence = allocateSequence();
 		if ( m_pCurrentSequence == nullptr )
 		{
 			return;
 		}
 
-		if ( m_pFirstSequence == nullptr )
-		{
-			m_pFirstSequence	= m_pCurrentSequence;
-			m_pEndSequence		= m_pCurrentSequence;
-		}
-
-		m_pEndSequence++;
 		m_currentSequenceFailed = false;
 
 		m_pCurrentSequence->renderEffectId	= renderEffectId;
@@ -109,7 +101,20 @@ namespace tiki
 			return;
 		}
 
-		RenderCommand* pCommand = static_cast< RenderCommand* >( m_commands.allocate( sizeof( RenderCommand ), 1u ) );
+		if ( m_pCurrentSequence->commandCount == MaxCommandsPerSequence )
+		{
+			// continue in a new sequence with the same state
+			const RenderSequence sequence = *m_pCurrentSequence;
+
+			endSequence();
+			beginSequence( (RenderPassMask)sequence.renderPassMask, (RenderEffectId)sequence.renderEffectId, sequence.renderFlags );
+			if ( m_pCurrentSequence == nullptr )
+			{
+				return;
+			}
+		}
+
+		RenderCommand* pCommand = allocateCommand();
 		if ( pCommand == nullptr )
 		{
 			return;
@@ -137,10 +142,6 @@ namespace tiki
 			pCommand->worldTransform = *pWorldTransform;
 		}
 
-		if ( m_pCurrentSequence->pCommands == nullptr )
-		{
-			m_pCurrentSequence->pCommands = pCommand;
-		}
 		TIKI_ASSERT( pCommand == m_pCurrentSequence->pCommands + m_pCurrentSequence->commandCount );
 		m_pCurrentSequence->commandCount++;
 	}
@@ -158,6 +159,75 @@ namespace tiki
 		return true;
 	}
 
+	RenderSequence* RenderBatch::allocateSequence()
+	{
+		RenderSequence* pSequence = m_sequences.allocateArray< RenderSequence >( 1u );
+		if ( pSequence == nullptr )
+		{
+			return nullptr;
+		}
+
+		if ( m_pFirstSequence == nullptr )
+		{
+			m_pFirstSequence	= pSequence;
+			m_pEndSequence		= pSequence;
+		}
+		else if ( pSequence != m_pEndSequence )
+		{
+			// the zone continued on a new page. the enumerator needs all sequences in one block, so move them.
+			m_sequences.free( pSequence );
+
+			const uint sequenceCount = uint( m_pEndSequence - m_pFirstSequence );
+			RenderSequence* pNewSequences = m_sequences.allocateArray< RenderSequence >( sequenceCount + 1u );
+			if ( pNewSequences == nullptr )
+			{
+				return nullptr;
+			}
+
+			memory::copy( pNewSequences, m_pFirstSequence, sizeof( RenderSequence ) * sequenceCount );
+
+			m_pFirstSequence	= pNewSequences;
+			m_pEndSequence		= pNewSequences + sequenceCount;
+			pSequence			= m_pEndSequence;
+		}
+
+		m_pEndSequence++;
+		return pSequence;
+	}
+
+	RenderCommand* RenderBatch::allocateCommand()
+	{
+		RenderCommand* pCommand = m_commands.allocateArray< RenderCommand >( 1u );
+		if ( pCommand == nullptr )
+		{
+			return nullptr;
+		}
+
+		const uint commandCount = m_pCurrentSequence->commandCount;
+		if ( m_pCurrentSequence->pCommands == nullptr )
+		{
+			m_pCurrentSequence->pCommands = pCommand;
+		}
+		else if ( pCommand != m_pCurrentSequence->pCommands + commandCount )
+		{
+			// the commands of a sequence must be contiguous. move them to the new page.
+			m_commands.free( pCommand );
+
+			RenderCommand* pNewCommands = m_commands.allocateArray< RenderCommand >( commandCount + 1u );
+			if ( pNewCommands == nullptr )
+			{
+				return nullptr;
+			}
+
+			memory::copy( pNewCommands, m_pCurrentSequence->pCommands, sizeof( RenderCommand ) * commandCount );
+
+			m_pCurrentSequence->pCommands	= pNewCommands;
+			pCommand						= pNewCommands + commandCount;
+		}
+
+		return pCommand;
+	}
+
 	RenderSequenceEnumerator RenderBatch::createEnumerator( RenderPass pass ) const
 	{
 		return RenderSequenceEnumerator( m_pFirstSequence, m_pEndSequence, pass );
@@ -1,9 +1,17 @@
 #include "tiki/renderer/renderscene.hpp"
 
+#include "tiki/graphics/model.hpp"
+#include "tiki/math/axisalignedbox.hpp"
 #include "tiki/renderer/renderview.hpp"
 
 namespace tiki
 {
+	enum
+	{
+		// bounds per call of the frustum culler, the masks of the chunk stay on the stack
+		RenderSceneCullChunkSize	= 64u
+	};
+
 	RenderScene::RenderScene()
 	{
 	}
@@ -87,6 +95,89 @@ namespace tiki
 		m_batch.queueModel( pModel, pWorldTransform, ppSkinningData );
 	}
 
+	void RenderScene::queueVisibleModels( const Model* const* ppModels, const Matrix43* pWorldTransforms, uint count )
+	{
+		AxisAlignedBox aWorldBoxes[ RenderSceneCullChunkSize ];
+		uint32 aVisibilityMask[ RenderSceneCullChunkSize / 32u ];
+
+		for( uint chunkStart = 0u; chunkStart < count; chunkStart += RenderSceneCullChunkSize )
+		{
+			const uint chunkCount = TIKI_MIN( count - chunkStart, RenderSceneCullChunkSize );
+			for( uint i = 0u; i < chunkCount; ++i )
+			{
+				aWorldBoxes[ i ] = ppModels[ chunkStart + i ]->getBoundingBox();
+				aWorldBoxes[ i ].transform( pWorldTransforms[ chunkStart + i ] );
+			}
+
+			cullAxisAlignedBoxes( aVisibilityMask, aWorldBoxes, chunkCount );
+
+			for( uint i = 0u; i < chunkCount; ++i )
+			{
+				if( aVisibilityMask[ i / 32u ] & ( 1u << ( i % 32u ) ) )
+				{
+					m_batch.queueModel( ppModels[ chunkStart + i ], &pWorldTransforms[ chunkStart + i ], nullptr );
+				}
+			}
+		}
+	}
+
+	bool RenderScene::isVisible( const AxisAlignedBox& worldBox ) const
+	{
+		uint32 visibilityMask;
+		cullAxisAlignedBoxes( &visibilityMask, &worldBox, 1u );
+
+		return visibilityMask != 0u;
+	}
+
+	void RenderScene::cullAxisAlignedBoxes( uint32* pVisibilityMask, const AxisAlignedBox* pWorldBoxes, uint count ) const
+	{
+		const uint wordCount = ( count + 31u ) / 32u;
+
+		bool hasView = false;
+		for( uint viewIndex = 0u; viewIndex < m_views.getCount(); ++viewIndex )
+		{
+			const RenderView& view = m_views[ viewIndex ];
+			if( !view.isCreated() )
+			{
+				continue;
+			}
+
+			const Frustum& frustum = view.getCamera().getFrustum();
+			if( !hasView )
+			{
+				frustum.cullAxisAlignedBoxes( pVisibilityMask, pWorldBoxes, count );
+				hasView = true;
+				continue;
+			}
+
+			// visible in any view
+			uint32 aChunkMask[ RenderSceneCullChunkSize / 32u ];
+			for( uint chunkStart = 0u; chunkStart < count; chunkStart += RenderSceneCullChunkSize )
+			{
+				const uint chunkCount = TIKI_MIN( count - chunkStart, RenderSceneCullChunkSize );
+				frustum.cullAxisAlignedBoxes( aChunkMask, pWorldBoxes + chunkStart, chunkCount );
+
+				for( uint i = 0u; i < ( chunkCount + 31u ) / 32u; ++i )
+				{
+					pVisibilityMask[ ( chunkStart / 32u ) + i ] |= aChunkMask[ i ];
+				}
+			}
+		}
+
+		if( !hasView )
+		{
+			for( uint i = 0u; i < wordCount; ++i )
+			{
+				pVisibilityMask[ i ] = 0xffffffffu;
+			}
+
+			if( count % 32u )
+			{
+				pVisibilityMask[ wordCount - 1u ] = ( 1u << ( count % 32u ) ) - 1u;
+			}
+		}
+	}
+
 	void RenderScene::clearState()
 	{
 		m_batch.reset();
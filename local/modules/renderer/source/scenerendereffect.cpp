@@ -193,9 +193,10 @@ namespace tiki
 				//matrix::mul( modelView, frameData.mainCamera.getViewMatrix() );
 
 				Matrix44 modelInverseTranspose;
-				matrix::set( modelInverseTranspose, modelView );
-				matrix::invert( modelInverseTranspose, modelInverseTranspose );
-				matrix::transpose( modelInverseTranspose );
+				if ( !matrix::invertTranspose( modelInverseTranspose, modelView ) )
+				{
+					matrix::createIdentity( modelInverseTranspose );
+				}
 
 				//Matrix33 modelInverseTranspose;
 				//modelInverseTranspose = modelView.rot;